@@ -0,0 +1,189 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikBench.c
+ * 
+ * @brief Class ikBench implementation
+ */
+
+/* @cond */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "ikBench.h"
+
+#define IKBENCH_NOVERHEAD 101
+
+/**
+ * (Private) compare two samples, for qsort
+ */
+int ikBench_compare(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *) a;
+    uint64_t y = *(const uint64_t *) b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * (Private) nearest-rank percentile of sorted samples
+ */
+uint64_t ikBench_percentile(const uint64_t *sorted, int n, int percent) {
+    int rank = (int) (((long) n * percent + 99) / 100);
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+void ikBench_initParams(ikBenchParams *params) {
+    params->maxSamples = 10000;
+}
+
+int ikBench_init(ikBench *self, const ikBenchParams *params) {
+    uint64_t overheads[IKBENCH_NOVERHEAD];
+    uint64_t start;
+    int i;
+
+    /*check parameters */
+    if (0 >= params->maxSamples) return -1;
+
+    /*allocate the samples */
+    self->samples = (uint64_t *) malloc(sizeof(uint64_t) * params->maxSamples);
+    if (NULL == self->samples) return -2;
+    self->maxSamples = params->maxSamples;
+
+    /*measure the timing overhead, as the median of empty samples */
+    for (i = 0; i < IKBENCH_NOVERHEAD; i++) {
+        start = ikBench_now();
+        overheads[i] = ikBench_now() - start;
+    }
+    qsort(overheads, IKBENCH_NOVERHEAD, sizeof(uint64_t), ikBench_compare);
+    self->overhead = overheads[IKBENCH_NOVERHEAD / 2];
+
+    ikBench_reset(self);
+    return 0;
+}
+
+uint64_t ikBench_now(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    uint64_t t;
+    _mm_lfence();
+    t = __rdtsc();
+    _mm_lfence();
+    return t;
+#elif defined(__aarch64__)
+    uint64_t t;
+    __asm__ __volatile__("isb; mrs %0, cntvct_el0" : "=r" (t) : : "memory");
+    return t;
+#else
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t) t.tv_sec * 1000000000u + (uint64_t) t.tv_nsec;
+#endif
+}
+
+const char *ikBench_getUnit(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return "cycles";
+#elif defined(__aarch64__)
+    return "ticks";
+#else
+    return "ns";
+#endif
+}
+
+void ikBench_start(ikBench *self) {
+    self->start = ikBench_now();
+}
+
+int ikBench_stop(ikBench *self) {
+    uint64_t t = ikBench_now() - self->start;
+
+    if (self->maxSamples <= self->nSamples) return -1;
+    self->samples[self->nSamples++] = t > self->overhead ? t - self->overhead : 0;
+
+    return 0;
+}
+
+void ikBench_summarise(ikBench *self) {
+    double sum = 0.0;
+    int i;
+
+    if (0 >= self->nSamples) {
+        self->min = self->median = self->p99 = self->max = self->mean = 0.0;
+        return;
+    }
+
+    /*sort the samples */
+    qsort(self->samples, self->nSamples, sizeof(uint64_t), ikBench_compare);
+    for (i = 0; i < self->nSamples; i++) sum += (double) self->samples[i];
+
+    self->min = (double) self->samples[0];
+    self->median = (double) ikBench_percentile(self->samples, self->nSamples, 50);
+    self->p99 = (double) ikBench_percentile(self->samples, self->nSamples, 99);
+    self->max = (double) self->samples[self->nSamples - 1];
+    self->mean = sum / self->nSamples;
+}
+
+int ikBench_getOutput(const ikBench *self, double *output, const char *name) {
+
+    /* pick up the signals */
+    if (!strcmp(name, "samples")) {
+        *output = self->nSamples;
+        return 0;
+    }
+    if (!strcmp(name, "min")) {
+        *output = self->min;
+        return 0;
+    }
+    if (!strcmp(name, "median")) {
+        *output = self->median;
+        return 0;
+    }
+    if (!strcmp(name, "p99")) {
+        *output = self->p99;
+        return 0;
+    }
+    if (!strcmp(name, "max")) {
+        *output = self->max;
+        return 0;
+    }
+    if (!strcmp(name, "mean")) {
+        *output = self->mean;
+        return 0;
+    }
+    if (!strcmp(name, "overhead")) {
+        *output = (double) self->overhead;
+        return 0;
+    }
+
+    return -1;
+}
+
+void ikBench_reset(ikBench *self) {
+    self->nSamples = 0;
+    self->min = self->median = self->p99 = self->max = self->mean = 0.0;
+}
+
+void ikBench_delete(ikBench *self) {
+    free(self->samples);
+}
+
+/* @endcond */
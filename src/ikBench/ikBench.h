@@ -0,0 +1,186 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikBench.h
+ * 
+ * @brief Class ikBench interface
+ */
+
+#ifndef IKBENCH_H
+#define IKBENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+    /**
+     * @struct ikBench
+     * @brief Execution time statistics
+     * 
+     * Instances of this type time a piece of code a number of times, and
+     * summarise the execution times as minimum, median, 99th percentile,
+     * maximum and mean. The code is timed by calling
+     * @link ikBench_start @endlink before it and @link ikBench_stop @endlink
+     * after it, and the overhead of the timing itself, measured by
+     * @link ikBench_init @endlink, is subtracted from each sample.
+     * 
+     * The times are read from the fastest counter available, as given by
+     * @link ikBench_getUnit @endlink:
+     * @li "cycles": time stamp counter cycles, on x86 processors
+     * @li "ticks": virtual counter ticks, on 64-bit ARM processors
+     * @li "ns": monotonic clock nanoseconds, elsewhere
+     * 
+     * The samples are kept in an array allocated once by
+     * @link ikBench_init @endlink, so that timing does not allocate memory.
+     * 
+     * @par Outputs
+     * @li samples: number of samples, get via @link ikBench_getOutput @endlink
+     * @li min: minimum, get via @link ikBench_getOutput @endlink
+     * @li median: median, get via @link ikBench_getOutput @endlink
+     * @li p99: 99th percentile, get via @link ikBench_getOutput @endlink
+     * @li max: maximum, get via @link ikBench_getOutput @endlink
+     * @li mean: mean, get via @link ikBench_getOutput @endlink
+     * @li overhead: timing overhead subtracted from each sample, get via @link ikBench_getOutput @endlink
+     * 
+     * The percentiles are nearest-rank percentiles, so they are always
+     * values of actual samples, and the median of an even number of samples
+     * is the lower of the two middle ones.
+     * 
+     * @par Methods
+     * @li @link ikBench_initParams @endlink initialise initialisation parameter structure
+     * @li @link ikBench_init @endlink initialise an instance
+     * @li @link ikBench_now @endlink read the counter
+     * @li @link ikBench_getUnit @endlink get the unit of the counter
+     * @li @link ikBench_start @endlink start timing a sample
+     * @li @link ikBench_stop @endlink finish timing a sample
+     * @li @link ikBench_summarise @endlink compute statistics
+     * @li @link ikBench_getOutput @endlink get output value
+     * @li @link ikBench_reset @endlink discard samples
+     * @li @link ikBench_delete @endlink delete instance
+     */
+    typedef struct ikBench {
+        /**
+         * Private members
+         */
+        /* @cond */
+        uint64_t *samples; /*samples */
+        int maxSamples; /*size of the samples array */
+        int nSamples; /*number of samples */
+        uint64_t start; /*counter value at the start of the current sample */
+        uint64_t overhead; /*timing overhead */
+        double min; /*minimum */
+        double median; /*median */
+        double p99; /*99th percentile */
+        double max; /*maximum */
+        double mean; /*mean */
+        /* @endcond */
+    } ikBench;
+
+    /**
+     * @struct ikBenchParams
+     * @brief Execution time statistics initialisation parameters
+     */
+    typedef struct ikBenchParams {
+        int maxSamples; /**<maximum number of samples. The default value is 10000.*/
+    } ikBenchParams;
+
+    /**
+     * Initialise an instance
+     * @param self instance
+     * @param params initialisation parameters
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid maximum number of samples, must be positive
+     * @li -2: could not allocate memory
+     */
+    int ikBench_init(ikBench *self, const ikBenchParams *params);
+
+    /**
+     * Initialise initialisation parameter structure
+     * @param params initialisation parameter structure
+     */
+    void ikBench_initParams(ikBenchParams *params);
+
+    /**
+     * Read the counter
+     * @return counter value
+     */
+    uint64_t ikBench_now(void);
+
+    /**
+     * Get the unit of the counter
+     * @return "cycles", "ticks" or "ns"
+     */
+    const char *ikBench_getUnit(void);
+
+    /**
+     * Start timing a sample
+     * @param self instance
+     */
+    void ikBench_start(ikBench *self);
+
+    /**
+     * Finish timing a sample
+     * @param self instance
+     * @return error code:
+     * @li 0: no error
+     * @li -1: the maximum number of samples has been reached, the sample has been dropped
+     */
+    int ikBench_stop(ikBench *self);
+
+    /**
+     * Compute the statistics of the samples so far, for
+     * @link ikBench_getOutput @endlink
+     * @param self instance
+     */
+    void ikBench_summarise(ikBench *self);
+
+    /**
+     * Get output value by name. All signals named in the class description
+     * are available, the statistics as computed by the last call to
+     * @link ikBench_summarise @endlink, or 0 if there were no samples.
+     * @param self instance
+     * @param output output value
+     * @param name output name, NULL terminated string
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid signal name
+     */
+    int ikBench_getOutput(const ikBench *self, double *output, const char *name);
+
+    /**
+     * Discard the samples so far
+     * @param self instance
+     */
+    void ikBench_reset(ikBench *self);
+
+    /**
+     * Delete instance
+     * @param self instance
+     */
+    void ikBench_delete(ikBench *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKBENCH_H */
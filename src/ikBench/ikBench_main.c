@@ -0,0 +1,442 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikBench_main.c
+ * 
+ * @brief Controller microbenchmark executable
+ * 
+ * Times the periodic methods of the controller classes, one call per sample,
+ * with @link ikBench @endlink, and reports the execution time statistics of
+ * each, as CSV on the standard output. Each method is timed in two
+ * conditions:
+ * @li warm: called back to back, after as many untimed calls
+ * @li cold: called right after writing a buffer larger than the caches, so
+ * that the instance and the code have to be fetched from memory
+ * 
+ * The inputs follow slow sinusoids, precomputed so that they do not add to
+ * the times. The output has a header line and one line per method and
+ * condition, with the following fields:
+ * @li name: method name
+ * @li caches: "warm" or "cold"
+ * @li samples: number of samples
+ * @li unit: unit of the statistics, as in @link ikBench_getUnit @endlink
+ * @li min, median, p99, max: execution time statistics
+ * @li max us: maximum in microseconds
+ * @li budget %: maximum as a percentage of the control cycle budget
+ * 
+ * The counter frequency, used for the conversion to microseconds, is
+ * measured against the monotonic clock, and reported on the standard error.
+ * 
+ * Usage: ikBench_main [warm samples [cold samples [buffer MB [budget us]]]]
+ * 
+ * The defaults are 100000 warm samples, 200 cold samples, a buffer of 64 MB
+ * and a budget of 10000 us, i.e. a 10 ms control cycle.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "ikBench.h"
+#include "ikSlti.h"
+#include "ikVfnotch.h"
+#include "ikTfList.h"
+#include "ikNotchList.h"
+#include "ikLutbl.h"
+#include "ikSurf.h"
+#include "ikLinCon.h"
+#include "ikStpgen.h"
+#include "ikConLoop.h"
+#include "ikRegionSelector.h"
+#include "ikTsrEst.h"
+#include "ikThrustLim.h"
+#include "ikIpc.h"
+#include "ikTestUtil.h"
+
+#define NINPUTS 4096
+
+/*
+ * Instances under test, and their inputs
+ */
+ikSlti slti;
+ikVfnotch vfnotch;
+ikTfList tfList;
+ikNotchList notchList;
+ikLutbl lutbl;
+ikSurf *surf;
+ikLinCon linCon;
+ikStpgen stpgen;
+ikConLoop conLoop;
+ikRegionSelector regionSelector;
+double regionSelectorBuffer[1024];
+ikTsrEst tsrEst;
+ikThrustLim thrustLim;
+ikIpc ipc;
+double gainScheduleInput;
+double inputs[NINPUTS];
+volatile double sink;
+
+/*
+ * Set a second order low-pass transfer function, with the given natural
+ * frequency in rad/s, discretised with a sampling time of 0.01 s.
+ */
+void setLowPass(ikTfParams *tf, double w) {
+    const double T = 0.01;
+    double k = 2.0 / T;
+    tf->enable = 1;
+    tf->a[0] = k*k + 1.4*w*k + w*w;
+    tf->a[1] = 2.0*w*w - 2.0*k*k;
+    tf->a[2] = k*k - 1.4*w*k + w*w;
+    tf->b[0] = w*w;
+    tf->b[1] = 2.0*w*w;
+    tf->b[2] = w*w;
+}
+
+/*
+ * Initialise the instances under test. Returns the name of the class which
+ * could not be initialised, or NULL.
+ */
+const char *setUp() {
+    const double sltiA[3] = {1.0, -1.8, 0.81};
+    const double sltiB[3] = {0.0025, 0.005, 0.0025};
+    double lutblX[32];
+    double lutblY[32];
+    ikRegionSelectorPoint corners[5][5];
+    ikRegionSelectorPoint points[16][4];
+    ikRegionSelectorPolygon polygons[16];
+    ikTfListParams tfListParams;
+    ikNotchListParams notchListParams;
+    ikLinConParams linConParams;
+    ikStpgenParams stpgenParams;
+    ikConLoopParams conLoopParams;
+    ikRegionSelectorParams regionSelectorParams;
+    ikTsrEstParams tsrEstParams;
+    ikThrustLimParams thrustLimParams;
+    ikIpcParams ipcParams;
+    int i, j;
+
+    /*inputs */
+    for (i = 0; i < NINPUTS; i++) inputs[i] = sin(2.0 * 3.14159265358979 * i / NINPUTS);
+
+    ikSlti_init(&slti);
+    if (ikSlti_setParam(&slti, sltiA, sltiB)) return "ikSlti";
+    if (ikSlti_setOutSat(&slti, 2, -0.5, 0.5)) return "ikSlti";
+
+    if (ikVfnotch_init(&vfnotch, 0.01, 10.0, 0.5, 0.01)) return "ikVfnotch";
+
+    ikTfList_initParams(&tfListParams);
+    for (i = 0; i < 4; i++) setLowPass(&(tfListParams.tfParams[i]), 5.0 * (i + 1));
+    if (ikTfList_init(&tfList, &tfListParams)) return "ikTfList";
+
+    ikNotchList_initParams(&notchListParams);
+    notchListParams.dT = 0.01;
+    for (i = 0; i < 2; i++) {
+        notchListParams.notchParams[i].enable = 1;
+        notchListParams.notchParams[i].freq = 10.0 * (i + 1);
+        notchListParams.notchParams[i].dampDen = 0.5;
+        notchListParams.notchParams[i].dampNum = 0.01;
+    }
+    if (ikNotchList_init(&notchList, &notchListParams)) return "ikNotchList";
+
+    ikLutbl_init(&lutbl);
+    for (i = 0; i < 32; i++) {
+        lutblX[i] = -1.0 + 2.0 * i / 31;
+        lutblY[i] = lutblX[i] * lutblX[i];
+    }
+    if (ikLutbl_setPoints(&lutbl, 32, lutblX, lutblY)) return "ikLutbl";
+
+    if (strlen(ikSurf_newf(&surf, "ikBench_main_cp.bin"))) return "ikSurf";
+
+    ikLinCon_initParams(&linConParams);
+    setLowPass(&(linConParams.measurementTfs.tfParams[0]), 10.0);
+    linConParams.errorTfs.tfParams[0].enable = 1;
+    linConParams.errorTfs.tfParams[0].a[0] = 1.0;
+    linConParams.errorTfs.tfParams[0].a[1] = -1.0;
+    linConParams.errorTfs.tfParams[0].b[0] = 0.5;
+    linConParams.errorTfs.tfParams[0].b[1] = -0.49;
+    linConParams.gainShedXVal = &gainScheduleInput;
+    linConParams.gainSchedN = 4;
+    for (i = 0; i < 4; i++) {
+        linConParams.gainSchedX[i] = -1.0 + 2.0 * i / 3;
+        linConParams.gainSchedY[i] = 1.0 + 0.5 * i;
+    }
+    if (ikLinCon_init(&linCon, &linConParams)) return "ikLinCon";
+
+    ikStpgen_initParams(&stpgenParams);
+    stpgenParams.nzones = 2;
+    stpgenParams.setpoints[0][0] = -0.5;
+    stpgenParams.setpoints[1][0] = 0.0;
+    stpgenParams.setpoints[0][1] = 0.5;
+    stpgenParams.setpoints[1][1] = 1.0;
+    stpgenParams.zoneTransitionHysteresis[0] = 0.1;
+    if (ikStpgen_init(&stpgen, &stpgenParams)) return "ikStpgen";
+
+    ikConLoop_initParams(&conLoopParams);
+    conLoopParams.linearController.errorTfs.tfParams[0] = linConParams.errorTfs.tfParams[0];
+    setLowPass(&(conLoopParams.linearController.measurementTfs.tfParams[0]), 10.0);
+    conLoopParams.setpointGenerator = stpgenParams;
+    if (ikConLoop_init(&conLoop, &conLoopParams)) return "ikConLoop";
+
+    ikRegionSelector_initParams(&regionSelectorParams);
+    for (i = 0; i < 5; i++) {
+        for (j = 0; j < 5; j++) {
+            corners[i][j].x = -1.0 + 0.5 * j;
+            corners[i][j].y = -1.0 + 0.5 * i;
+        }
+    }
+    for (i = 0; i < 4; i++) {
+        for (j = 0; j < 4; j++) {
+            points[4*i + j][0] = corners[i][j];
+            points[4*i + j][1] = corners[i][j + 1];
+            points[4*i + j][2] = corners[i + 1][j + 1];
+            points[4*i + j][3] = corners[i + 1][j];
+            polygons[4*i + j].nPoints = 4;
+            polygons[4*i + j].points = points[4*i + j];
+        }
+    }
+    regionSelectorParams.nRegions = 16;
+    regionSelectorParams.polygons = polygons;
+    regionSelectorParams.buffer = regionSelectorBuffer;
+    regionSelectorParams.bufferSize = sizeof(regionSelectorBuffer);
+    if (ikRegionSelector_init(&regionSelector, &regionSelectorParams)) return "ikRegionSelector";
+
+    ikTsrEst_initParams(&tsrEstParams);
+    tsrEstParams.b = 97.0;
+    tsrEstParams.J = 4.0e6;
+    tsrEstParams.rho = 1.225;
+    tsrEstParams.R = 63.0;
+    tsrEstParams.cplambda3SurfaceFileName = "ikBench_main_cp.bin";
+    if (ikTsrEst_init(&tsrEst, &tsrEstParams)) return "ikTsrEst";
+
+    ikThrustLim_initParams(&thrustLimParams);
+    thrustLimParams.rho = 1.225;
+    thrustLimParams.R = 63.0;
+    thrustLimParams.ctlambda2SurfaceFileName = "ikBench_main_ct.bin";
+    if (ikThrustLim_init(&thrustLim, &thrustLimParams)) return "ikThrustLim";
+
+    ikIpc_initParams(&ipcParams);
+    if (ikIpc_init(&ipc, &ipcParams)) return "ikIpc";
+
+    return NULL;
+}
+
+/*
+ * Delete the instances under test.
+ */
+void tearDown() {
+    ikSurf_delete(surf);
+    ikTsrEst_delete(&tsrEst);
+    ikThrustLim_delete(&thrustLim);
+}
+
+/*
+ * Calls under test, for sample k
+ */
+void stepSlti(int k) {
+    sink = ikSlti_step(&slti, inputs[k % NINPUTS]);
+}
+
+void stepVfnotch(int k) {
+    sink = ikVfnotch_step(&vfnotch, inputs[k % NINPUTS]);
+}
+
+void stepTfList(int k) {
+    sink = ikTfList_step(&tfList, inputs[k % NINPUTS]);
+}
+
+void stepNotchList(int k) {
+    sink = ikNotchList_step(&notchList, inputs[k % NINPUTS]);
+}
+
+void evalLutbl(int k) {
+    sink = ikLutbl_eval(&lutbl, inputs[k % NINPUTS]);
+}
+
+void evalSurf(int k) {
+    double x[2];
+    x[0] = 15.0 + 15.0 * inputs[k % NINPUTS];
+    x[1] = 0.002 + 0.001 * inputs[(k + NINPUTS/4) % NINPUTS];
+    sink = ikSurf_eval(surf, 0, x, 1);
+}
+
+void stepLinCon(int k) {
+    gainScheduleInput = inputs[(k + NINPUTS/4) % NINPUTS];
+    sink = ikLinCon_step(&linCon, 0.0, inputs[k % NINPUTS]);
+}
+
+void stepStpgen(int k) {
+    sink = ikStpgen_step(&stpgen, 1.0, inputs[k % NINPUTS], inputs[(k + NINPUTS/4) % NINPUTS], -1.0, 1.0);
+}
+
+void stepConLoop(int k) {
+    sink = ikConLoop_step(&conLoop, 1.0, inputs[k % NINPUTS], -1.0, 1.0);
+}
+
+void getRegion(int k) {
+    sink = ikRegionSelector_getRegion(&regionSelector, inputs[k % NINPUTS], inputs[(k * 7) % NINPUTS]);
+}
+
+void stepTsrEst(int k) {
+    sink = ikTsrEst_step(&tsrEst, 120.0 + 10.0 * inputs[k % NINPUTS], 40.0 + 5.0 * inputs[(3 * k) % NINPUTS], 2.0 + inputs[(2 * k) % NINPUTS]);
+}
+
+void stepThrustLim(int k) {
+    sink = ikThrustLim_step(&thrustLim, 8.0 + inputs[k % NINPUTS], 1.2 + 0.1 * inputs[(2 * k) % NINPUTS], 500.0);
+}
+
+void stepIpc(int k) {
+    int i, j;
+    ipc.in.azimuth = 180.0 + 180.0 * inputs[(7 * k) % NINPUTS];
+    ipc.in.collectivePitch = 2.0 + inputs[k % NINPUTS];
+    ipc.in.maximumPitch = 90.0;
+    ipc.in.minimumPitch = 0.0;
+    ipc.in.maximumIndividualPitch = 5.0;
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++) ipc.in.bladeRootMoments[i].c[j] = 100.0 * inputs[(k + 300 * (3*i + j)) % NINPUTS];
+    }
+    ikIpc_step(&ipc);
+    sink = ipc.out.pitch[0];
+}
+
+typedef struct benchCase {
+    const char *name;
+    void (*call)(int k);
+} benchCase;
+
+const benchCase cases[] = {
+    {"ikSlti_step", stepSlti},
+    {"ikVfnotch_step", stepVfnotch},
+    {"ikTfList_step", stepTfList},
+    {"ikNotchList_step", stepNotchList},
+    {"ikLutbl_eval", evalLutbl},
+    {"ikSurf_eval", evalSurf},
+    {"ikLinCon_step", stepLinCon},
+    {"ikStpgen_step", stepStpgen},
+    {"ikConLoop_step", stepConLoop},
+    {"ikRegionSelector_getRegion", getRegion},
+    {"ikTsrEst_step", stepTsrEst},
+    {"ikThrustLim_step", stepThrustLim},
+    {"ikIpc_step", stepIpc},
+};
+
+/*
+ * Measure the counter frequency, in counts per microsecond.
+ */
+double countsPerMicrosecond() {
+    struct timespec start, now;
+    uint64_t c0, c1;
+    double t;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    c0 = ikBench_now();
+    do {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        t = 1e6 * (now.tv_sec - start.tv_sec) + 1e-3 * (now.tv_nsec - start.tv_nsec);
+    } while (t < 100000.0);
+    c1 = ikBench_now();
+
+    return (c1 - c0) / t;
+}
+
+/*
+ * Report the statistics of a case.
+ */
+void report(ikBench *bench, const char *name, const char *caches, double perUs, double budget) {
+    double samples, min, median, p99, max;
+
+    ikBench_summarise(bench);
+    ikBench_getOutput(bench, &samples, "samples");
+    ikBench_getOutput(bench, &min, "min");
+    ikBench_getOutput(bench, &median, "median");
+    ikBench_getOutput(bench, &p99, "p99");
+    ikBench_getOutput(bench, &max, "max");
+    printf("%s,%s,%.0f,%s,%.0f,%.0f,%.0f,%.0f,%.3f,%.4f\n", name, caches, samples, ikBench_getUnit(), min, median, p99, max, max / perUs, 100.0 * max / perUs / budget);
+}
+
+int main(int argc, char** argv) {
+    int nWarm = argc > 1 ? atoi(argv[1]) : 100000;
+    int nCold = argc > 2 ? atoi(argv[2]) : 200;
+    size_t bufferSize = (size_t) (argc > 3 ? atoi(argv[3]) : 64) << 20;
+    double budget = argc > 4 ? atof(argv[4]) : 10000.0;
+    const int nCases = sizeof(cases) / sizeof(cases[0]);
+    volatile char *buffer;
+    ikBench bench;
+    ikBenchParams params;
+    const char *failed;
+    double perUs;
+    size_t j;
+    int c, k;
+
+    if ((0 >= nWarm) || (0 >= nCold) || (0 >= bufferSize) || (0.0 >= budget)) {
+        fprintf(stderr, "usage: %s [warm samples [cold samples [buffer MB [budget us]]]]\n", argv[0]);
+        return (EXIT_FAILURE);
+    }
+
+    /*set up */
+    if (ikTestUtil_writeSurfaces("ikBench_main_cp.bin", "ikBench_main_ct.bin")) {
+        fprintf(stderr, "could not write surface files\n");
+        return (EXIT_FAILURE);
+    }
+    failed = setUp();
+    if (NULL != failed) {
+        fprintf(stderr, "could not initialise %s\n", failed);
+        return (EXIT_FAILURE);
+    }
+    buffer = (volatile char *) malloc(bufferSize);
+    ikBench_initParams(&params);
+    params.maxSamples = nWarm > nCold ? nWarm : nCold;
+    if ((NULL == buffer) || ikBench_init(&bench, &params)) return (EXIT_FAILURE);
+    perUs = countsPerMicrosecond();
+    fprintf(stderr, "%.1f %s per us\n", perUs, ikBench_getUnit());
+
+    printf("name,caches,samples,unit,min,median,p99,max,max us,budget %%\n");
+    for (c = 0; c < nCases; c++) {
+
+        /*warm caches */
+        for (k = 0; k < nWarm; k++) cases[c].call(k);
+        ikBench_reset(&bench);
+        for (k = 0; k < nWarm; k++) {
+            ikBench_start(&bench);
+            cases[c].call(k);
+            ikBench_stop(&bench);
+        }
+        report(&bench, cases[c].name, "warm", perUs, budget);
+
+        /*cold caches */
+        ikBench_reset(&bench);
+        for (k = 0; k < nCold; k++) {
+            for (j = 0; j < bufferSize; j += 64) buffer[j] = (char) k;
+            ikBench_start(&bench);
+            cases[c].call(k);
+            ikBench_stop(&bench);
+        }
+        report(&bench, cases[c].name, "cold", perUs, budget);
+    }
+
+    /*clean up */
+    ikBench_delete(&bench);
+    free((void *) buffer);
+    tearDown();
+    remove("ikBench_main_cp.bin");
+    remove("ikBench_main_ct.bin");
+
+    return (EXIT_SUCCESS);
+}
@@ -0,0 +1,176 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikBench_test.c
+ * 
+ * @brief Class ikBench unit tests
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ikBench.h"
+
+/*
+ * Simple C Test Suite for class ikBench
+ */
+
+/**
+ * Busy loop, which the compiler cannot remove.
+ */
+void spin(long n) {
+    volatile long i;
+    for (i = 0; i < n; i++);
+}
+
+/**
+ * Time nSamples samples, with the samples at the positions in longs
+ * spinning for long, and the rest doing nothing.
+ */
+void timeSamples(ikBench *bench, int nSamples, int nLongs, const int longs[]) {
+    int i, j;
+    for (i = 0; i < nSamples; i++) {
+        long n = 0;
+        for (j = 0; j < nLongs; j++) {
+            if (longs[j] == i) n = 10000000;
+        }
+        ikBench_start(bench);
+        spin(n);
+        ikBench_stop(bench);
+    }
+}
+
+void testStatistics() {
+    printf("ikBench_test testStatistics\n");
+    ikBench bench;
+    ikBenchParams params;
+    const int longs[2] = {50, 80};
+    double samples, min, median, p99, max, mean;
+    int err;
+
+    ikBench_initParams(&params);
+    err = ikBench_init(&bench, &params);
+    if (err) {
+        printf("%%TEST_FAILED%% time=0 testname=testStatistics (ikBench_test) message=init returned %d\n", err);
+        return;
+    }
+
+    /*with 1 long sample in 100, the 99th percentile is short */
+    timeSamples(&bench, 100, 1, longs);
+    ikBench_summarise(&bench);
+    ikBench_getOutput(&bench, &samples, "samples");
+    ikBench_getOutput(&bench, &min, "min");
+    ikBench_getOutput(&bench, &median, "median");
+    ikBench_getOutput(&bench, &p99, "p99");
+    ikBench_getOutput(&bench, &max, "max");
+    ikBench_getOutput(&bench, &mean, "mean");
+    if (100 != samples) printf("%%TEST_FAILED%% time=0 testname=testStatistics (ikBench_test) message=samples is %f\n", samples);
+    if (!((min <= median) && (median <= p99) && (p99 <= max) && (min <= mean) && (mean <= max))) {
+        printf("%%TEST_FAILED%% time=0 testname=testStatistics (ikBench_test) message=inconsistent statistics min=%f median=%f p99=%f max=%f mean=%f\n", min, median, p99, max, mean);
+    }
+    if (p99 > max / 10.0) printf("%%TEST_FAILED%% time=0 testname=testStatistics (ikBench_test) message=p99 is %f, with max %f\n", p99, max);
+    if ((mean < max / 100.0) || (mean > max / 10.0)) printf("%%TEST_FAILED%% time=0 testname=testStatistics (ikBench_test) message=mean is %f, with max %f\n", mean, max);
+
+    /*with 2, it is long */
+    ikBench_reset(&bench);
+    ikBench_summarise(&bench);
+    ikBench_getOutput(&bench, &samples, "samples");
+    ikBench_getOutput(&bench, &max, "max");
+    if ((0 != samples) || (0 != max)) printf("%%TEST_FAILED%% time=0 testname=testStatistics (ikBench_test) message=samples is %f and max %f after reset\n", samples, max);
+    timeSamples(&bench, 100, 2, longs);
+    ikBench_summarise(&bench);
+    ikBench_getOutput(&bench, &median, "median");
+    ikBench_getOutput(&bench, &p99, "p99");
+    ikBench_getOutput(&bench, &max, "max");
+    if (p99 < max / 10.0) printf("%%TEST_FAILED%% time=0 testname=testStatistics (ikBench_test) message=p99 is %f, with max %f\n", p99, max);
+    if (median > max / 10.0) printf("%%TEST_FAILED%% time=0 testname=testStatistics (ikBench_test) message=median is %f, with max %f\n", median, max);
+
+    ikBench_delete(&bench);
+}
+
+void testLimit() {
+    printf("ikBench_test testLimit\n");
+    ikBench bench;
+    ikBenchParams params;
+    double output;
+    int err, i;
+
+    ikBench_initParams(&params);
+    params.maxSamples = 10;
+    err = ikBench_init(&bench, &params);
+    if (err) {
+        printf("%%TEST_FAILED%% time=0 testname=testLimit (ikBench_test) message=init returned %d\n", err);
+        return;
+    }
+    for (i = 0; i < 12; i++) {
+        ikBench_start(&bench);
+        err = ikBench_stop(&bench);
+        if ((10 > i) && err) printf("%%TEST_FAILED%% time=0 testname=testLimit (ikBench_test) message=stop returned %d at sample %d\n", err, i);
+        if ((10 <= i) && (-1 != err)) printf("%%TEST_FAILED%% time=0 testname=testLimit (ikBench_test) message=stop returned %d at sample %d, expected -1\n", err, i);
+    }
+    ikBench_getOutput(&bench, &output, "samples");
+    if (10 != output) printf("%%TEST_FAILED%% time=0 testname=testLimit (ikBench_test) message=samples is %f\n", output);
+    if (ikBench_getOutput(&bench, &output, "overhead")) printf("%%TEST_FAILED%% time=0 testname=testLimit (ikBench_test) message=no overhead output\n");
+    if (-1 != ikBench_getOutput(&bench, &output, "p50")) printf("%%TEST_FAILED%% time=0 testname=testLimit (ikBench_test) message=getOutput accepted a bad name\n");
+    if (strcmp("cycles", ikBench_getUnit()) && strcmp("ticks", ikBench_getUnit()) && strcmp("ns", ikBench_getUnit())) {
+        printf("%%TEST_FAILED%% time=0 testname=testLimit (ikBench_test) message=unknown unit %s\n", ikBench_getUnit());
+    }
+
+    ikBench_delete(&bench);
+}
+
+void testInitErrors() {
+    printf("ikBench_test testInitErrors\n");
+    ikBench bench;
+    ikBenchParams params;
+    int err;
+
+    /* -1 for bad maximum number of samples */
+    ikBench_initParams(&params);
+    params.maxSamples = 0;
+    err = ikBench_init(&bench, &params);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikBench_test) message=init expected to return -1, but returned %d\n", err);
+
+    params.maxSamples = 1;
+    err = ikBench_init(&bench, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikBench_test) message=init expected to return 0, but returned %d\n", err);
+    else ikBench_delete(&bench);
+}
+
+int main(int argc, char** argv) {
+    printf("%%SUITE_STARTING%% ikBench_test\n");
+    printf("%%SUITE_STARTED%%\n");
+
+    printf("%%TEST_STARTED%% testStatistics (ikBench_test)\n");
+    testStatistics();
+    printf("%%TEST_FINISHED%% time=0 testStatistics (ikBench_test) \n");
+
+    printf("%%TEST_STARTED%% testLimit (ikBench_test)\n");
+    testLimit();
+    printf("%%TEST_FINISHED%% time=0 testLimit (ikBench_test) \n");
+
+    printf("%%TEST_STARTED%% testInitErrors (ikBench_test)\n");
+    testInitErrors();
+    printf("%%TEST_FINISHED%% time=0 testInitErrors (ikBench_test) \n");
+
+    printf("%%SUITE_FINISHED%% time=0\n");
+
+    return (EXIT_SUCCESS);
+}
@@ -0,0 +1,509 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikBench_wcet_main.c
+ * 
+ * @brief Worst-case execution time search executable
+ * 
+ * Searches the inputs of the periodic methods whose execution time depends
+ * on them for those which take longest, and reports the worst cases found,
+ * as CSV on the standard output. Each input is timed a number of times with
+ * @link ikBench @endlink, and its execution time is taken as the median,
+ * so that interrupts do not drive the search.
+ * 
+ * @link ikSurf_eval @endlink searches for the brackets of the point of
+ * evaluation starting from those of the previous evaluation, so each of its
+ * inputs is a pair of points, the previous one and the current one. The
+ * number of search iterations, as counted by
+ * @link ikSurf_getIterations @endlink, is maximised first, and the execution
+ * time second. The search is seeded with points on and around the extrema
+ * of the surface along each line of data points, and with points beyond
+ * the range of the data, and it goes on by random perturbation of the worst
+ * case so far, with steps shrinking from a quarter of the range to a
+ * millionth of it, and by random restarts. The surface is evaluated for
+ * each of its coordinates, with both sides. When IKSURF_MAXITER is defined,
+ * the number of searches stopped by it is reported too.
+ * 
+ * @link ikStpgen_step @endlink has no loops, and takes one zone transition
+ * at most per step, so its execution time depends on the state only. Its
+ * state space is walked by random inputs drawn mostly from the zone limits
+ * and the transition thresholds, so that all zone transitions, locks and
+ * limit rates are exercised, and each step is timed from the same state.
+ * 
+ * The output has a header line and one line per case, with the following
+ * fields:
+ * @li name: method and case name
+ * @li evaluations: number of inputs tried
+ * @li unit: unit of the times, as in @link ikBench_getUnit @endlink
+ * @li iterations: search iterations of the worst case, 0 for methods with no
+ * searches
+ * @li worst: execution time of the worst case
+ * @li worst us: execution time of the worst case in microseconds
+ * @li capped: number of searches stopped at IKSURF_MAXITER in the worst case
+ * @li input: inputs of the worst case, separated by spaces, the previous
+ * point of evaluation first for @link ikSurf_eval @endlink
+ * 
+ * Usage: ikBench_wcet_main [evaluations [repeats [seed [surface file]]]]
+ * 
+ * The defaults are 20000 evaluations per case, 15 repeats per evaluation,
+ * a seed of 1, and a generated 3-dimensional surface of 129 by 33 points
+ * shaped like a power coefficient surface, with a maximum along each line.
+ * Surface files must be 3-dimensional, in the format of
+ * @link ikSurf_newf @endlink.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "ikBench.h"
+#include "ikSurf.h"
+#include "ikStpgen.h"
+
+#define NSEEDS 8
+
+/*
+ * Instances under test, and the timer
+ */
+ikSurf *surf;
+ikStpgen stpgen;
+ikBench bench;
+int repeats;
+volatile double sink;
+
+/*
+ * Surface data, as in the surface file
+ */
+int ndata[2];
+double *coords[2];
+double *values;
+double lo[3];
+double hi[3];
+
+/*
+ * Worst case of a search
+ */
+typedef struct worstCase {
+    double input[6]; /*inputs */
+    int nInputs; /*number of inputs */
+    long iterations; /*search iterations */
+    long capped; /*searches stopped at IKSURF_MAXITER */
+    double time; /*execution time */
+} worstCase;
+
+/*
+ * Uniform random number between a and b.
+ */
+double uniform(double a, double b) {
+    return a + (b - a) * rand() / RAND_MAX;
+}
+
+/*
+ * Random number of roughly normal distribution, with standard deviation s.
+ */
+double normal(double s) {
+    return s * (uniform(-1.0, 1.0) + uniform(-1.0, 1.0) + uniform(-1.0, 1.0));
+}
+
+/*
+ * Write the default surface file, Cp(lambda, theta) with a maximum along
+ * each line of constant pitch angle theta.
+ */
+int writeSurface(const char *fileName) {
+    const int nl = 129;
+    const int np = 33;
+    int dims = 3;
+    int n[2] = {nl, np};
+    double *data;
+    double l, p;
+    int i, j;
+    FILE *f;
+
+    data = (double *) malloc(sizeof(double) * (nl + np + nl*np));
+    if (NULL == data) return -1;
+    for (i = 0; i < nl; i++) data[i] = 1.0 + 0.125 * i;
+    for (j = 0; j < np; j++) data[nl + j] = -2.0 + 1.0 * j;
+    for (i = 0; i < nl; i++) {
+        for (j = 0; j < np; j++) {
+            l = data[i];
+            p = data[nl + j];
+            data[nl + np + np*i + j] = 0.5 * (116.0 / l - 0.4 * p - 5.0) * exp(-21.0 / l) + 0.0068 * l;
+        }
+    }
+    f = fopen(fileName, "wb");
+    if (NULL == f) {
+        free(data);
+        return -1;
+    }
+    fwrite(&dims, sizeof(int), 1, f);
+    fwrite(n, sizeof(int), 2, f);
+    fwrite(data, sizeof(double), nl + np + nl*np, f);
+    fclose(f);
+    free(data);
+
+    return 0;
+}
+
+/*
+ * Read the data of a 3-dimensional surface file, and work out the bounds
+ * of the inputs, a quarter of the range beyond the data on each side.
+ */
+int readSurface(const char *fileName) {
+    int dims;
+    int n, i, k;
+    double *data;
+    double r;
+    FILE *f;
+
+    f = fopen(fileName, "rb");
+    if (NULL == f) return -1;
+    if ((1 != fread(&dims, sizeof(int), 1, f)) || (3 != dims) || (2 != fread(ndata, sizeof(int), 2, f))
+            || (2 > ndata[0]) || (2 > ndata[1])) {
+        fclose(f);
+        return -2;
+    }
+    n = ndata[0] + ndata[1] + ndata[0]*ndata[1];
+    data = (double *) malloc(sizeof(double) * n);
+    if ((NULL == data) || ((size_t) n != fread(data, sizeof(double), n, f))) {
+        free(data);
+        fclose(f);
+        return -2;
+    }
+    fclose(f);
+    coords[0] = data;
+    coords[1] = data + ndata[0];
+    values = data + ndata[0] + ndata[1];
+
+    for (k = 0; k < 2; k++) {
+        lo[k] = coords[k][0];
+        hi[k] = coords[k][ndata[k] - 1];
+    }
+    lo[2] = hi[2] = values[0];
+    for (i = 0; i < ndata[0]*ndata[1]; i++) {
+        if (values[i] < lo[2]) lo[2] = values[i];
+        if (values[i] > hi[2]) hi[2] = values[i];
+    }
+    for (k = 0; k < 3; k++) {
+        r = hi[k] - lo[k];
+        lo[k] -= 0.25 * r;
+        hi[k] += 0.25 * r;
+    }
+
+    return 0;
+}
+
+/*
+ * Value of the data at point i along coordinate dim, on line j of the other
+ * coordinate.
+ */
+double value(int dim, int i, int j) {
+    return dim ? values[ndata[1]*j + i] : values[ndata[1]*i + j];
+}
+
+/*
+ * Time an evaluation of the surface for coordinate dim, with the given
+ * side, at input[2..3] after one at input[0..1], and record it in c.
+ */
+void timeSurf(int dim, int side, worstCase *c) {
+    long iterations, capped;
+    double median;
+    int r;
+
+    ikBench_reset(&bench);
+    for (r = 0; r < repeats; r++) {
+        sink = ikSurf_eval(surf, dim, c->input, side);
+        iterations = ikSurf_getIterations(surf);
+        capped = ikSurf_getCapped(surf);
+        ikBench_start(&bench);
+        sink = ikSurf_eval(surf, dim, c->input + 2, side);
+        ikBench_stop(&bench);
+        c->iterations = ikSurf_getIterations(surf) - iterations;
+        c->capped = ikSurf_getCapped(surf) - capped;
+    }
+    ikBench_summarise(&bench);
+    ikBench_getOutput(&bench, &median, "median");
+    c->time = median;
+}
+
+/*
+ * Take c as the worst case if it is worse than it.
+ */
+void keepWorst(worstCase *worst, const worstCase *c) {
+    if ((c->iterations > worst->iterations)
+            || ((c->iterations == worst->iterations) && (c->time > worst->time))) {
+        *worst = *c;
+    }
+}
+
+/*
+ * Bounds of input k of an evaluation for coordinate dim, i.e. those of the
+ * other coordinate or of the value.
+ */
+void bounds(int dim, int k, double *a, double *b) {
+    int i = (2 == dim) ? k % 2 : ((k % 2) ? 2 : 1 - dim);
+    *a = lo[i];
+    *b = hi[i];
+}
+
+/*
+ * Random input, uniform over the bounds.
+ */
+void randomInput(int dim, worstCase *c) {
+    double a, b;
+    int k;
+    for (k = 0; k < 4; k++) {
+        bounds(dim, k, &a, &b);
+        c->input[k] = uniform(a, b);
+    }
+}
+
+/*
+ * Search the worst case of the evaluation of the surface for coordinate
+ * dim, with the given side.
+ */
+void searchSurf(int dim, int side, int evaluations, worstCase *worst) {
+    const double offsets[NSEEDS] = {0.0, 1e-9, -1e-9, 1e-6, -1e-6, 1e-3, -1e-3, 0.02};
+    worstCase c;
+    double vmax, vmin, a, b, scale;
+    int i, j, k, s, e;
+
+    worst->nInputs = 4;
+    worst->iterations = -1;
+    worst->time = 0.0;
+    c.nInputs = 4;
+
+    /*seeds */
+    e = 0;
+    if (2 > dim) {
+        /*on and around the maximum and the minimum along each line, coming from far away */
+        for (j = 0; j < ndata[1 - dim] && e < evaluations; j++) {
+            vmax = vmin = value(dim, 0, j);
+            for (i = 1; i < ndata[dim]; i++) {
+                if (value(dim, i, j) > vmax) vmax = value(dim, i, j);
+                if (value(dim, i, j) < vmin) vmin = value(dim, i, j);
+            }
+            for (s = 0; s < NSEEDS && e < evaluations; s++, e += 2) {
+                randomInput(dim, &c);
+                c.input[2] = coords[1 - dim][j];
+                c.input[3] = vmax + offsets[s] * (hi[2] - lo[2]);
+                timeSurf(dim, side, &c);
+                keepWorst(worst, &c);
+                c.input[3] = vmin - offsets[s] * (hi[2] - lo[2]);
+                timeSurf(dim, side, &c);
+                keepWorst(worst, &c);
+            }
+        }
+    } else {
+        /*on and beyond the corners, coming from the opposite ones */
+        for (k = 0; k < 4 && e < evaluations; k++) {
+            for (s = 0; s < NSEEDS && e < evaluations; s++, e++) {
+                c.input[0] = (k & 1) ? lo[0] : hi[0];
+                c.input[1] = (k & 2) ? lo[1] : hi[1];
+                c.input[2] = coords[0][(k & 1) ? ndata[0] - 1 : 0] + ((k & 1) ? 1.0 : -1.0) * fabs(offsets[s]) * (hi[0] - lo[0]);
+                c.input[3] = coords[1][(k & 2) ? ndata[1] - 1 : 0] + ((k & 2) ? 1.0 : -1.0) * fabs(offsets[s]) * (hi[1] - lo[1]);
+                timeSurf(dim, side, &c);
+                keepWorst(worst, &c);
+            }
+        }
+    }
+
+    /*random perturbation of the worst case so far, with random restarts */
+    for (; e < evaluations; e++) {
+        if (0 == e % 10) {
+            randomInput(dim, &c);
+        } else {
+            scale = 0.25 * pow(4e-6, (double) e / evaluations);
+            c = *worst;
+            for (k = 0; k < 4; k++) {
+                bounds(dim, k, &a, &b);
+                c.input[k] += normal(scale * (b - a));
+                if (c.input[k] < a) c.input[k] = a;
+                if (c.input[k] > b) c.input[k] = b;
+            }
+        }
+        timeSurf(dim, side, &c);
+        keepWorst(worst, &c);
+    }
+}
+
+/*
+ * Initialise the setpoint generator under test, with 4 zones, zone
+ * transitions spanning 5 steps and locked for 3, and rate limited control
+ * action limits.
+ */
+int setUpStpgen() {
+    ikStpgenParams params;
+    int i;
+
+    ikStpgen_initParams(&params);
+    params.nzones = 4;
+    for (i = 0; i < 4; i++) {
+        params.setpoints[0][i] = 1.0 * i;
+        params.setpoints[1][i] = 1.0 * i + 0.5;
+    }
+    for (i = 0; i < 3; i++) {
+        params.zoneTransitionHysteresis[i] = 0.05;
+        params.nZoneTransitionSteps[i] = 5;
+        params.nZoneTransitionLockSteps[i] = 3;
+    }
+    params.zoneTransitionPrelock = 0;
+    params.controlActionLimitRate = 0.1;
+
+    return ikStpgen_init(&stpgen, &params);
+}
+
+/*
+ * Random input of the setpoint generator: one of the zone limits, or a
+ * threshold, give or take a little, or a uniform value.
+ */
+double stpgenInput(double a, double b) {
+    const double levels[9] = {-1.0, 0.0, 0.5, 1.0, 1.5, 2.0, 2.5, 3.0, 3.5};
+    double hysteresis = (rand() % 2) ? 0.05 : 0.0;
+    if (0 == rand() % 4) return uniform(a, b);
+    return levels[rand() % 9] + ((rand() % 2) ? hysteresis : -hysteresis) + normal(1e-6);
+}
+
+/*
+ * Walk the state space of the setpoint generator, timing each step from
+ * the same state.
+ */
+void searchStpgen(int evaluations, worstCase *worst) {
+    ikStpgen state;
+    worstCase c;
+    double median;
+    int e, r;
+
+    worst->nInputs = 5;
+    worst->iterations = 0;
+    worst->capped = 0;
+    worst->time = 0.0;
+    c = *worst;
+
+    for (e = 0; e < evaluations; e++) {
+        c.input[0] = stpgenInput(-1.0, 5.0);
+        c.input[1] = stpgenInput(-1.0, 5.0);
+        c.input[2] = stpgenInput(-1.0, 5.0);
+        c.input[3] = stpgenInput(-1.0, 1.0);
+        c.input[4] = c.input[3] + fabs(stpgenInput(-1.0, 5.0));
+
+        /*time from the same state */
+        state = stpgen;
+        ikBench_reset(&bench);
+        for (r = 0; r < repeats; r++) {
+            stpgen = state;
+            ikBench_start(&bench);
+            sink = ikStpgen_step(&stpgen, c.input[0], c.input[1], c.input[2], c.input[3], c.input[4]);
+            ikBench_stop(&bench);
+        }
+        ikBench_summarise(&bench);
+        ikBench_getOutput(&bench, &median, "median");
+        c.time = median;
+        if (c.time > worst->time) *worst = c;
+    }
+}
+
+/*
+ * Report a worst case.
+ */
+void report(const char *name, int evaluations, const worstCase *c, double perUs) {
+    int k;
+
+    printf("%s,%d,%s,%ld,%.0f,%.3f,%ld,", name, evaluations, ikBench_getUnit(), c->iterations, c->time, c->time / perUs, c->capped);
+    for (k = 0; k < c->nInputs; k++) printf(k ? " %.17g" : "%.17g", c->input[k]);
+    printf("\n");
+}
+
+/*
+ * Measure the counter frequency, in counts per microsecond.
+ */
+double countsPerMicrosecond() {
+    struct timespec start, now;
+    uint64_t c0, c1;
+    double t;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    c0 = ikBench_now();
+    do {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        t = 1e6 * (now.tv_sec - start.tv_sec) + 1e-3 * (now.tv_nsec - start.tv_nsec);
+    } while (t < 100000.0);
+    c1 = ikBench_now();
+
+    return (c1 - c0) / t;
+}
+
+int main(int argc, char** argv) {
+    int evaluations = argc > 1 ? atoi(argv[1]) : 20000;
+    const char *fileName = argc > 4 ? argv[4] : "ikBench_wcet_main_cp.bin";
+    ikBenchParams params;
+    worstCase worst;
+    char name[64];
+    double perUs;
+    int dim, side;
+
+    repeats = argc > 2 ? atoi(argv[2]) : 15;
+    srand(argc > 3 ? atoi(argv[3]) : 1);
+    if ((0 >= evaluations) || (0 >= repeats) || (5 < argc)) {
+        fprintf(stderr, "usage: %s [evaluations [repeats [seed [surface file]]]]\n", argv[0]);
+        return (EXIT_FAILURE);
+    }
+
+    /*set up */
+    if ((5 > argc) && writeSurface(fileName)) {
+        fprintf(stderr, "could not write surface file\n");
+        return (EXIT_FAILURE);
+    }
+    if (readSurface(fileName) || strlen(ikSurf_newf(&surf, fileName))) {
+        fprintf(stderr, "could not read a 3-dimensional surface from %s\n", fileName);
+        return (EXIT_FAILURE);
+    }
+    if (setUpStpgen()) {
+        fprintf(stderr, "could not initialise ikStpgen\n");
+        return (EXIT_FAILURE);
+    }
+    ikBench_initParams(&params);
+    params.maxSamples = repeats;
+    if (ikBench_init(&bench, &params)) return (EXIT_FAILURE);
+    perUs = countsPerMicrosecond();
+    fprintf(stderr, "%.1f %s per us\n", perUs, ikBench_getUnit());
+#ifdef IKSURF_MAXITER
+    fprintf(stderr, "ikSurf searches capped at %d iterations\n", IKSURF_MAXITER);
+#endif
+
+    printf("name,evaluations,unit,iterations,worst,worst us,capped,input\n");
+    for (dim = 0; dim < 3; dim++) {
+        for (side = 0; side < 2; side++) {
+            searchSurf(dim, side, evaluations, &worst);
+            sprintf(name, "ikSurf_eval dim %d side %d", dim, side);
+            report(name, evaluations, &worst, perUs);
+        }
+    }
+    searchStpgen(evaluations, &worst);
+    report("ikStpgen_step", evaluations, &worst, perUs);
+
+    /*clean up */
+    ikBench_delete(&bench);
+    ikSurf_delete(surf);
+    free(coords[0]);
+    if (5 > argc) remove(fileName);
+
+    return (EXIT_SUCCESS);
+}
@@ -0,0 +1,213 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikCheckpoint.c
+ * 
+ * @brief Class ikCheckpoint implementation
+ */
+
+/* @cond */
+
+#include <stdint.h>
+#include <string.h>
+#include "ikCheckpoint.h"
+
+/**
+ * (Private) FNV-1a hash of a block of bytes
+ */
+uint32_t ikCheckpoint_hash(const unsigned char *data, size_t size) {
+    uint32_t h = 2166136261u;
+    size_t i;
+    for (i = 0; i < size; i++) {
+        h ^= data[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * (Private) copy a tag, padding it with zeros or truncating it
+ */
+void ikCheckpoint_copyTag(unsigned char *dst, const char *tag) {
+    int i;
+    for (i = 0; i < IKCHECKPOINT_TAGSIZE; i++) {
+        dst[i] = (unsigned char) *tag;
+        if ('\0' != *tag) tag++;
+    }
+}
+
+/**
+ * (Private) write bytes to the blob, or count them if it does not fit
+ */
+void ikCheckpoint_write(ikCheckpoint *self, const void *value, size_t size) {
+    if ((NULL != self->buffer) && (self->pos + size <= self->size)) memcpy(self->buffer + self->pos, value, size);
+    self->pos += size;
+}
+
+/**
+ * (Private) read bytes from the blob
+ * @return 0 if read, -1 if past the end of the blob
+ */
+int ikCheckpoint_read(ikCheckpoint *self, void *value, size_t size) {
+    if (self->pos + size > self->size) {
+        self->mismatch = 1;
+        return -1;
+    }
+    memcpy(value, self->blob + self->pos, size);
+    self->pos += size;
+    return 0;
+}
+
+void ikCheckpoint_initSave(ikCheckpoint *self, void *buffer, size_t size, const char *tag) {
+    unsigned char header[IKCHECKPOINT_HEADERSIZE];
+    uint16_t u16;
+    
+    self->buffer = (unsigned char *) buffer;
+    self->blob = NULL;
+    self->size = size;
+    self->pos = 0;
+    self->dryRun = 0;
+    self->mismatch = 0;
+    
+    /*write the header, leaving the length and the hash for later */
+    memset(header, 0, IKCHECKPOINT_HEADERSIZE);
+    memcpy(header, "IKCP", 4);
+    u16 = IKCHECKPOINT_VERSION;
+    memcpy(header + 4, &u16, 2);
+    u16 = 0x0102;
+    memcpy(header + 6, &u16, 2);
+    ikCheckpoint_copyTag(header + 8, tag);
+    ikCheckpoint_write(self, header, IKCHECKPOINT_HEADERSIZE);
+}
+
+int ikCheckpoint_initRestore(ikCheckpoint *self, const void *blob, size_t size, const char *tag, int dryRun) {
+    const unsigned char *header = (const unsigned char *) blob;
+    unsigned char tag_[IKCHECKPOINT_TAGSIZE];
+    uint16_t u16;
+    uint32_t length;
+    uint32_t hash;
+    
+    self->buffer = NULL;
+    self->blob = header;
+    self->size = 0;
+    self->pos = IKCHECKPOINT_HEADERSIZE;
+    self->dryRun = dryRun;
+    self->mismatch = 0;
+    
+    /*check the header */
+    if ((NULL == blob) || (IKCHECKPOINT_HEADERSIZE > size)) return -1;
+    memcpy(&u16, header + 6, 2);
+    if (memcmp(header, "IKCP", 4) || (0x0102 != u16)) return -2;
+    memcpy(&u16, header + 4, 2);
+    if (IKCHECKPOINT_VERSION != u16) return -3;
+    ikCheckpoint_copyTag(tag_, tag);
+    if (memcmp(header + 8, tag_, IKCHECKPOINT_TAGSIZE)) return -4;
+    memcpy(&length, header + 24, 4);
+    if (length > size - IKCHECKPOINT_HEADERSIZE) return -1;
+    memcpy(&hash, header + 28, 4);
+    if (hash != ikCheckpoint_hash(header + IKCHECKPOINT_HEADERSIZE, length)) return -5;
+    
+    /*read the payload only */
+    self->size = IKCHECKPOINT_HEADERSIZE + length;
+    return 0;
+}
+
+void ikCheckpoint_double(ikCheckpoint *self, double *value) {
+    double x;
+    if (NULL == self->blob) {
+        ikCheckpoint_write(self, value, sizeof(double));
+        return;
+    }
+    if (ikCheckpoint_read(self, &x, sizeof(double))) return;
+    if (!self->dryRun) *value = x;
+}
+
+void ikCheckpoint_int(ikCheckpoint *self, int *value) {
+    int32_t x;
+    if (NULL == self->blob) {
+        x = (int32_t) *value;
+        ikCheckpoint_write(self, &x, sizeof(int32_t));
+        return;
+    }
+    if (ikCheckpoint_read(self, &x, sizeof(int32_t))) return;
+    if (!self->dryRun) *value = (int) x;
+}
+
+void ikCheckpoint_intRange(ikCheckpoint *self, int *value, int min, int max) {
+    int32_t x;
+    if (NULL == self->blob) {
+        x = (int32_t) *value;
+        ikCheckpoint_write(self, &x, sizeof(int32_t));
+        return;
+    }
+    if (ikCheckpoint_read(self, &x, sizeof(int32_t))) return;
+    if ((x < min) || (x > max)) {
+        self->mismatch = 1;
+        return;
+    }
+    if (!self->dryRun) *value = (int) x;
+}
+
+void ikCheckpoint_long(ikCheckpoint *self, long *value) {
+    int64_t x;
+    if (NULL == self->blob) {
+        x = (int64_t) *value;
+        ikCheckpoint_write(self, &x, sizeof(int64_t));
+        return;
+    }
+    if (ikCheckpoint_read(self, &x, sizeof(int64_t))) return;
+    if (!self->dryRun) *value = (long) x;
+}
+
+void ikCheckpoint_check(ikCheckpoint *self, int value) {
+    int32_t x = (int32_t) value;
+    if (NULL == self->blob) {
+        ikCheckpoint_write(self, &x, sizeof(int32_t));
+        return;
+    }
+    if (ikCheckpoint_read(self, &x, sizeof(int32_t))) return;
+    if (x != (int32_t) value) self->mismatch = 1;
+}
+
+int ikCheckpoint_isRestoring(const ikCheckpoint *self) {
+    return (NULL != self->blob) && !self->dryRun && !self->mismatch;
+}
+
+int ikCheckpoint_finish(ikCheckpoint *self, size_t *length) {
+    uint32_t u32;
+    
+    if (NULL != length) *length = self->pos;
+    
+    /*when restoring, the whole payload must have been read */
+    if (NULL != self->blob) {
+        if (self->mismatch || (self->pos != self->size)) return -6;
+        return 0;
+    }
+    
+    /*when saving, complete the header */
+    if ((NULL == self->buffer) || (self->pos > self->size)) return -1;
+    u32 = (uint32_t) (self->pos - IKCHECKPOINT_HEADERSIZE);
+    memcpy(self->buffer + 24, &u32, 4);
+    u32 = ikCheckpoint_hash(self->buffer + IKCHECKPOINT_HEADERSIZE, self->pos - IKCHECKPOINT_HEADERSIZE);
+    memcpy(self->buffer + 28, &u32, 4);
+    return 0;
+}
+
+/* @endcond */
@@ -0,0 +1,201 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikCheckpoint.h
+ * 
+ * @brief Class ikCheckpoint interface
+ */
+
+#ifndef IKCHECKPOINT_H
+#define IKCHECKPOINT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+#define IKCHECKPOINT_VERSION 1
+#define IKCHECKPOINT_HEADERSIZE 32
+#define IKCHECKPOINT_TAGSIZE 16
+
+    /**
+     * @struct ikCheckpoint
+     * @brief Checkpoint blob writer and reader
+     * 
+     * Instances of this type save the runtime state of a controller to a
+     * compact binary blob, and restore it from one. The blob starts with a
+     * header of @link IKCHECKPOINT_HEADERSIZE @endlink bytes, with:
+     * @li the characters "IKCP"
+     * @li the format version, @link IKCHECKPOINT_VERSION @endlink, as a 16-bit integer
+     * @li a byte order mark, 0x0102 as a 16-bit integer
+     * @li the name of the class of the controller, padded with zeros to
+     * @link IKCHECKPOINT_TAGSIZE @endlink characters
+     * @li the length of the payload, in bytes, as a 32-bit integer
+     * @li the FNV-1a hash of the payload, as a 32-bit integer
+     * 
+     * followed by the payload, with ints as 32-bit integers, longs as 64-bit
+     * integers and doubles as 64-bit floating point numbers, all in the byte
+     * order of the machine that wrote the blob. Blobs of another byte order
+     * are rejected.
+     * 
+     * The payload is made up by the classes, each of which has a checkpoint
+     * method, e.g. @link ikSlti_checkpoint @endlink, that goes over its
+     * runtime state and that of its members, in a fixed order, passing each
+     * value to @link ikCheckpoint_double @endlink, @link ikCheckpoint_int @endlink,
+     * @link ikCheckpoint_intRange @endlink or @link ikCheckpoint_long @endlink.
+     * The same method serves to save and to restore, since these write the
+     * value to the blob when saving, and overwrite it with the one in the
+     * blob when restoring. The parameters, which are set on initialisation
+     * and do not change, are not included, but those which determine the
+     * layout of the payload, such as the number of zones of a setpoint
+     * generator, are passed to @link ikCheckpoint_check @endlink, so that a
+     * blob is only restored into an instance initialised with the same
+     * layout. Values used as indices, such as the current zone, are passed to
+     * @link ikCheckpoint_intRange @endlink, so that a blob with one out of
+     * range is rejected too.
+     * 
+     * Restoring is meant to be done in two passes, a dry run, which reads the
+     * whole blob and checks it without changing anything, and the real one,
+     * so that an instance is left untouched by a blob that cannot be restored.
+     * 
+     * @par Methods
+     * @li @link ikCheckpoint_initSave @endlink initialise an instance to save
+     * @li @link ikCheckpoint_initRestore @endlink initialise an instance to restore
+     * @li @link ikCheckpoint_double @endlink save or restore a double
+     * @li @link ikCheckpoint_int @endlink save or restore an int
+     * @li @link ikCheckpoint_intRange @endlink save or restore an int within a range
+     * @li @link ikCheckpoint_long @endlink save or restore a long
+     * @li @link ikCheckpoint_check @endlink save or check a layout value
+     * @li @link ikCheckpoint_isRestoring @endlink find out whether values are being restored
+     * @li @link ikCheckpoint_finish @endlink finish saving or restoring
+     */
+    typedef struct ikCheckpoint {
+        /**
+         * Private members
+         */
+        /* @cond */
+        unsigned char *buffer; /*blob being written, NULL when restoring */
+        const unsigned char *blob; /*blob being read, NULL when saving */
+        size_t size; /*size of the buffer or of the blob, in bytes */
+        size_t pos; /*position of the next value */
+        int dryRun; /*flag: read the blob without restoring the values */
+        int mismatch; /*flag: a layout value did not match */
+        /* @endcond */
+    } ikCheckpoint;
+
+    /**
+     * Initialise an instance to save runtime state to a buffer. If the buffer
+     * is too small, or NULL, the values are not written, but they are still
+     * counted, so that @link ikCheckpoint_finish @endlink gives the size
+     * needed.
+     * @param self instance
+     * @param buffer buffer for the blob
+     * @param size size of the buffer, in bytes
+     * @param tag name of the class of the controller
+     */
+    void ikCheckpoint_initSave(ikCheckpoint *self, void *buffer, size_t size, const char *tag);
+
+    /**
+     * Initialise an instance to restore runtime state from a blob
+     * @param self instance
+     * @param blob blob
+     * @param size size of the blob, in bytes
+     * @param tag name of the class of the controller
+     * @param dryRun flag: if non-zero, read and check the blob, but do not
+     * change the values passed to the instance
+     * @return error code:
+     * @li 0: no error
+     * @li -1: the blob is shorter than its header says
+     * @li -2: not a checkpoint blob, or one of another byte order
+     * @li -3: unsupported format version
+     * @li -4: checkpoint blob of another class
+     * @li -5: corrupt payload, the hash does not match
+     */
+    int ikCheckpoint_initRestore(ikCheckpoint *self, const void *blob, size_t size, const char *tag, int dryRun);
+
+    /**
+     * Save or restore a double
+     * @param self instance
+     * @param value value
+     */
+    void ikCheckpoint_double(ikCheckpoint *self, double *value);
+
+    /**
+     * Save or restore an int
+     * @param self instance
+     * @param value value
+     */
+    void ikCheckpoint_int(ikCheckpoint *self, int *value);
+
+    /**
+     * Save or restore an int which must be within a range, e.g. an index.
+     * When restoring, a value out of range is not restored, and the blob
+     * does not match the instance, so that it is rejected by the dry run.
+     * @param self instance
+     * @param value value
+     * @param min minimum value
+     * @param max maximum value
+     */
+    void ikCheckpoint_intRange(ikCheckpoint *self, int *value, int min, int max);
+
+    /**
+     * Save or restore a long
+     * @param self instance
+     * @param value value
+     */
+    void ikCheckpoint_long(ikCheckpoint *self, long *value);
+
+    /**
+     * Save a value which determines the layout of the payload, or check that
+     * it is the same as the one in the blob
+     * @param self instance
+     * @param value value
+     */
+    void ikCheckpoint_check(ikCheckpoint *self, int value);
+
+    /**
+     * Find out whether values are being restored, for state which is not
+     * restored by assignment, e.g. via set methods
+     * @param self instance
+     * @return flag: non-zero when restoring, other than in a dry run
+     */
+    int ikCheckpoint_isRestoring(const ikCheckpoint *self);
+
+    /**
+     * Finish saving or restoring. When saving, this completes the header.
+     * @param self instance
+     * @param length length of the blob, in bytes, or NULL. When saving to a
+     * buffer which is too small, this is the size needed.
+     * @return error code:
+     * @li 0: no error
+     * @li -1: the buffer is too small, when saving
+     * @li -6: the blob does not match the layout of the instance, or holds a
+     * value out of range, when restoring
+     */
+    int ikCheckpoint_finish(ikCheckpoint *self, size_t *length);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKCHECKPOINT_H */
+
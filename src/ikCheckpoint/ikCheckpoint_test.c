@@ -0,0 +1,218 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikCheckpoint_test.c
+ * 
+ * @brief Class ikCheckpoint unit tests
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ikCheckpoint.h"
+
+/*
+ * Simple C Test Suite for class ikCheckpoint
+ */
+
+/**
+ * Sample runtime state
+ */
+typedef struct testState {
+    int n;
+    double x[3];
+    long count;
+} testState;
+
+void testState_checkpoint(testState *self, int n, ikCheckpoint *cp) {
+    int i;
+    ikCheckpoint_check(cp, n);
+    ikCheckpoint_int(cp, &(self->n));
+    for (i = 0; i < 3; i++) ikCheckpoint_double(cp, &(self->x[i]));
+    ikCheckpoint_long(cp, &(self->count));
+}
+
+size_t testState_save(testState *self, unsigned char *buffer, size_t size, int *err) {
+    ikCheckpoint cp;
+    size_t length;
+    ikCheckpoint_initSave(&cp, buffer, size, "testState");
+    testState_checkpoint(self, 3, &cp);
+    *err = ikCheckpoint_finish(&cp, &length);
+    return length;
+}
+
+void testRoundTrip() {
+    testState state = {7, {1.5, -2.25, 1e300}, 123456789012L};
+    testState restored = {0, {0.0, 0.0, 0.0}, 0};
+    unsigned char buffer[256];
+    ikCheckpoint cp;
+    size_t length;
+    int err;
+
+    printf("ikCheckpoint_test testRoundTrip\n");
+
+    /*the length is known beforehand */
+    length = testState_save(&state, NULL, 0, &err);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testRoundTrip (ikCheckpoint_test) message=finish expected to return -1 without a buffer, but returned %d\n", err);
+    if (IKCHECKPOINT_HEADERSIZE + 4 + 4 + 3*8 + 8 != length) printf("%%TEST_FAILED%% time=0 testname=testRoundTrip (ikCheckpoint_test) message=length expected to be %d, but was %d\n", IKCHECKPOINT_HEADERSIZE + 40, (int) length);
+    testState_save(&state, buffer, length - 1, &err);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testRoundTrip (ikCheckpoint_test) message=finish expected to return -1 with a short buffer, but returned %d\n", err);
+    length = testState_save(&state, buffer, sizeof(buffer), &err);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testRoundTrip (ikCheckpoint_test) message=finish expected to return 0, but returned %d\n", err);
+    if (memcmp(buffer, "IKCP", 4)) printf("%%TEST_FAILED%% time=0 testname=testRoundTrip (ikCheckpoint_test) message=blob expected to start with IKCP\n");
+
+    /*a dry run reads all, but changes nothing */
+    err = ikCheckpoint_initRestore(&cp, buffer, length, "testState", 1);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testRoundTrip (ikCheckpoint_test) message=initRestore expected to return 0, but returned %d\n", err);
+    if (ikCheckpoint_isRestoring(&cp)) printf("%%TEST_FAILED%% time=0 testname=testRoundTrip (ikCheckpoint_test) message=isRestoring expected to be 0 on a dry run\n");
+    testState_checkpoint(&restored, 3, &cp);
+    err = ikCheckpoint_finish(&cp, NULL);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testRoundTrip (ikCheckpoint_test) message=finish expected to return 0 on a dry run, but returned %d\n", err);
+    if ((0 != restored.n) || (0.0 != restored.x[0]) || (0 != restored.count)) printf("%%TEST_FAILED%% time=0 testname=testRoundTrip (ikCheckpoint_test) message=the state expected to be unchanged by a dry run\n");
+
+    /*and the real one restores the values exactly */
+    ikCheckpoint_initRestore(&cp, buffer, length, "testState", 0);
+    if (!ikCheckpoint_isRestoring(&cp)) printf("%%TEST_FAILED%% time=0 testname=testRoundTrip (ikCheckpoint_test) message=isRestoring expected to be non-zero\n");
+    testState_checkpoint(&restored, 3, &cp);
+    err = ikCheckpoint_finish(&cp, NULL);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testRoundTrip (ikCheckpoint_test) message=finish expected to return 0, but returned %d\n", err);
+    if ((state.n != restored.n) || memcmp(state.x, restored.x, sizeof(state.x)) || (state.count != restored.count)) printf("%%TEST_FAILED%% time=0 testname=testRoundTrip (ikCheckpoint_test) message=the state expected to be restored exactly\n");
+}
+
+void testErrors() {
+    testState state = {7, {1.5, -2.25, 1e300}, 123456789012L};
+    unsigned char buffer[256];
+    unsigned char blob[256];
+    ikCheckpoint cp;
+    size_t length;
+    int err;
+
+    printf("ikCheckpoint_test testErrors\n");
+
+    length = testState_save(&state, buffer, sizeof(buffer), &err);
+
+    /*short blobs */
+    err = ikCheckpoint_initRestore(&cp, buffer, IKCHECKPOINT_HEADERSIZE - 1, "testState", 1);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testErrors (ikCheckpoint_test) message=initRestore expected to return -1 for a blob shorter than the header, but returned %d\n", err);
+    err = ikCheckpoint_initRestore(&cp, buffer, length - 1, "testState", 1);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testErrors (ikCheckpoint_test) message=initRestore expected to return -1 for a truncated blob, but returned %d\n", err);
+
+    /*not a blob */
+    memcpy(blob, buffer, length);
+    blob[0] = 'X';
+    err = ikCheckpoint_initRestore(&cp, blob, length, "testState", 1);
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=testErrors (ikCheckpoint_test) message=initRestore expected to return -2 for a bad magic, but returned %d\n", err);
+
+    /*other byte order */
+    memcpy(blob, buffer, length);
+    blob[6] = buffer[7];
+    blob[7] = buffer[6];
+    err = ikCheckpoint_initRestore(&cp, blob, length, "testState", 1);
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=testErrors (ikCheckpoint_test) message=initRestore expected to return -2 for another byte order, but returned %d\n", err);
+
+    /*other version */
+    memcpy(blob, buffer, length);
+    blob[4] ^= 0x80;
+    err = ikCheckpoint_initRestore(&cp, blob, length, "testState", 1);
+    if (-3 != err) printf("%%TEST_FAILED%% time=0 testname=testErrors (ikCheckpoint_test) message=initRestore expected to return -3 for another version, but returned %d\n", err);
+
+    /*other class */
+    err = ikCheckpoint_initRestore(&cp, buffer, length, "otherState", 1);
+    if (-4 != err) printf("%%TEST_FAILED%% time=0 testname=testErrors (ikCheckpoint_test) message=initRestore expected to return -4 for another class, but returned %d\n", err);
+
+    /*corrupt payload */
+    memcpy(blob, buffer, length);
+    blob[length - 1] ^= 1;
+    err = ikCheckpoint_initRestore(&cp, blob, length, "testState", 1);
+    if (-5 != err) printf("%%TEST_FAILED%% time=0 testname=testErrors (ikCheckpoint_test) message=initRestore expected to return -5 for a corrupt payload, but returned %d\n", err);
+
+    /*other layout */
+    ikCheckpoint_initRestore(&cp, buffer, length, "testState", 1);
+    testState_checkpoint(&state, 2, &cp);
+    err = ikCheckpoint_finish(&cp, NULL);
+    if (-6 != err) printf("%%TEST_FAILED%% time=0 testname=testErrors (ikCheckpoint_test) message=finish expected to return -6 for another layout, but returned %d\n", err);
+
+    /*reading too little or too much */
+    ikCheckpoint_initRestore(&cp, buffer, length, "testState", 1);
+    ikCheckpoint_check(&cp, 3);
+    err = ikCheckpoint_finish(&cp, NULL);
+    if (-6 != err) printf("%%TEST_FAILED%% time=0 testname=testErrors (ikCheckpoint_test) message=finish expected to return -6 for a partly read blob, but returned %d\n", err);
+    ikCheckpoint_initRestore(&cp, buffer, length, "testState", 0);
+    testState_checkpoint(&state, 3, &cp);
+    ikCheckpoint_long(&cp, &(state.count));
+    err = ikCheckpoint_finish(&cp, NULL);
+    if (-6 != err) printf("%%TEST_FAILED%% time=0 testname=testErrors (ikCheckpoint_test) message=finish expected to return -6 for reading past the end, but returned %d\n", err);
+    if (123456789012L != state.count) printf("%%TEST_FAILED%% time=0 testname=testErrors (ikCheckpoint_test) message=a value past the end expected to be left as it was\n");
+}
+
+void testRange() {
+    unsigned char buffer[256];
+    ikCheckpoint cp;
+    size_t length;
+    int err;
+    int value = 7;
+
+    printf("ikCheckpoint_test testRange\n");
+
+    ikCheckpoint_initSave(&cp, buffer, sizeof(buffer), "testState");
+    ikCheckpoint_intRange(&cp, &value, 0, 7);
+    err = ikCheckpoint_finish(&cp, &length);
+    if (err || (IKCHECKPOINT_HEADERSIZE + 4 != length)) printf("%%TEST_FAILED%% time=0 testname=testRange (ikCheckpoint_test) message=finish expected to return 0 and %d bytes, but returned %d and %d bytes\n", IKCHECKPOINT_HEADERSIZE + 4, err, (int) length);
+
+    /*in range, including the bounds */
+    value = 0;
+    ikCheckpoint_initRestore(&cp, buffer, length, "testState", 0);
+    ikCheckpoint_intRange(&cp, &value, 7, 8);
+    err = ikCheckpoint_finish(&cp, NULL);
+    if (err || (7 != value)) printf("%%TEST_FAILED%% time=0 testname=testRange (ikCheckpoint_test) message=expected 7 and 0 to be restored and returned, but got %d and %d\n", value, err);
+
+    /*out of range, in a dry run and in a real one */
+    value = 0;
+    ikCheckpoint_initRestore(&cp, buffer, length, "testState", 1);
+    ikCheckpoint_intRange(&cp, &value, 0, 6);
+    err = ikCheckpoint_finish(&cp, NULL);
+    if (-6 != err) printf("%%TEST_FAILED%% time=0 testname=testRange (ikCheckpoint_test) message=finish expected to return -6 for a value above the range in a dry run, but returned %d\n", err);
+    ikCheckpoint_initRestore(&cp, buffer, length, "testState", 0);
+    ikCheckpoint_intRange(&cp, &value, 8, 9);
+    err = ikCheckpoint_finish(&cp, NULL);
+    if (-6 != err) printf("%%TEST_FAILED%% time=0 testname=testRange (ikCheckpoint_test) message=finish expected to return -6 for a value below the range, but returned %d\n", err);
+    if (0 != value) printf("%%TEST_FAILED%% time=0 testname=testRange (ikCheckpoint_test) message=a value out of range expected to be left as it was, but it is %d\n", value);
+}
+
+int main(int argc, char** argv) {
+    printf("%%SUITE_STARTING%% ikCheckpoint_test\n");
+    printf("%%SUITE_STARTED%%\n");
+
+    printf("%%TEST_STARTED%% testRoundTrip (ikCheckpoint_test)\n");
+    testRoundTrip();
+    printf("%%TEST_FINISHED%% time=0 testRoundTrip (ikCheckpoint_test) \n");
+
+    printf("%%TEST_STARTED%% testErrors (ikCheckpoint_test)\n");
+    testErrors();
+    printf("%%TEST_FINISHED%% time=0 testErrors (ikCheckpoint_test) \n");
+
+    printf("%%TEST_STARTED%% testRange (ikCheckpoint_test)\n");
+    testRange();
+    printf("%%TEST_FINISHED%% time=0 testRange (ikCheckpoint_test) \n");
+
+    printf("%%SUITE_FINISHED%% time=0\n");
+
+    return (EXIT_SUCCESS);
+}
@@ -55,7 +55,7 @@ int ikConLoop_init(ikConLoop *self, const ikConLoopParams *params) {
     if (!err && err_) err = -3;
     err_ = ikLinCon_init(&(self->controlActionFilters), &(params->controlActionFilters));
     if (!err && err_) err = -4;
-    err_ = ikRegionSelector_init(&(self->regionSelector), &(params->regionSelector));
+    err_ = ikRegionSelector_initPolygons(&(self->regionSelector), &(params->regionSelector));
     if (!err && err_) err = -5;
 
 
@@ -66,6 +66,9 @@ int ikConLoop_init(ikConLoop *self, const ikConLoopParams *params) {
     self->selectedRegion = 0;
     self->x = 0.0;
     self->y = 0.0;
+#ifdef IKPROFILE
+    ikProfile_init(&(self->profile));
+#endif
 
     return err;
 }
@@ -74,7 +77,7 @@ void ikConLoop_initParams(ikConLoopParams *params) {
     int i;
     
     /* invoke component initialisation */
-    ikRegionSelector_initParams(&(params->regionSelector));
+    ikRegionSelector_initPolygonParams(&(params->regionSelector));
     ikLinCon_initParams(&(params->setpointFilters));
     ikLinCon_initParams(&(params->controlActionFilters));
     ikLinCon_initParams(&(params->linearController));
@@ -92,8 +95,13 @@ void ikConLoop_initParams(ikConLoopParams *params) {
 }
 
 double ikConLoop_step(ikConLoop *self, double maxSp, double feedback, double minCon, double maxCon) {
+    double setpoint;
+#ifdef IKPROFILE
+    ikProfile_start(&(self->profile));
+#endif
+
     /* take step with setpoint generator */
-    double setpoint = ikStpgen_step(&(self->stpgen), maxSp, feedback, self->controlAction, minCon, maxCon);
+    setpoint = ikStpgen_step(&(self->stpgen), maxSp, feedback, self->controlAction, minCon, maxCon);
 
     /* take step with setpoint and control action filters */
     self->x = ikLinCon_step(&(self->setpointFilters), setpoint, self->controlAction);
@@ -109,6 +117,13 @@ double ikConLoop_step(ikConLoop *self, double maxSp, double feedback, double min
     /* take step with linear controller */
     self->controlAction = ikLinCon_step(&(self->lincon), setpoint, feedback);
 
+#ifdef IKPROFILE
+    /* count saturation at the control action limits */
+    if ((self->minimumControlAction >= self->controlAction) || (self->maximumControlAction <= self->controlAction))
+        ikProfile_saturate(&(self->profile));
+    ikProfile_stop(&(self->profile));
+#endif
+
     return self->controlAction;
 }
 
@@ -162,6 +177,14 @@ int ikConLoop_getOutput(const ikConLoop *self, double *output, const char *name)
         return 0;
     }
 
+#ifdef IKPROFILE
+    /* pick up the profile counters */
+    if (!strncmp(name, "profile>", 8)) {
+        if (ikProfile_getOutput(&(self->profile), output, name + 8)) return -1;
+        return 0;
+    }
+#endif
+
     /* pick up the block names */
     sep = strstr(name, ">");
     if (NULL == sep) return -1;
@@ -189,4 +212,45 @@ int ikConLoop_getOutput(const ikConLoop *self, double *output, const char *name)
     return -2;
 }
 
+int ikConLoop_saveState(const ikConLoop *self, void *buffer, size_t size, size_t *length) {
+    ikCheckpoint cp;
+    
+    /* saving leaves the instance as it is */
+    ikCheckpoint_initSave(&cp, buffer, size, "ikConLoop");
+    ikConLoop_checkpoint((ikConLoop *) self, &cp);
+    return ikCheckpoint_finish(&cp, length);
+}
+
+int ikConLoop_restoreState(ikConLoop *self, const void *blob, size_t size) {
+    ikCheckpoint cp;
+    int err;
+    
+    /* check the whole blob with a dry run, then restore */
+    err = ikCheckpoint_initRestore(&cp, blob, size, "ikConLoop", 1);
+    if (err) return err;
+    ikConLoop_checkpoint(self, &cp);
+    err = ikCheckpoint_finish(&cp, NULL);
+    if (err) return err;
+    ikCheckpoint_initRestore(&cp, blob, size, "ikConLoop", 0);
+    ikConLoop_checkpoint(self, &cp);
+    return ikCheckpoint_finish(&cp, NULL);
+}
+
+void ikConLoop_checkpoint(ikConLoop *self, ikCheckpoint *cp) {
+    /* sub-blocks */
+    ikStpgen_checkpoint(&(self->stpgen), cp);
+    ikLinCon_checkpoint(&(self->setpointFilters), cp);
+    ikLinCon_checkpoint(&(self->controlActionFilters), cp);
+    ikRegionSelector_checkpoint(&(self->regionSelector), cp);
+    ikLinCon_checkpoint(&(self->lincon), cp);
+    
+    /* signals */
+    ikCheckpoint_intRange(cp, &(self->selectedRegion), 0, self->regionSelector.tables.regionN);
+    ikCheckpoint_double(cp, &(self->maximumControlAction));
+    ikCheckpoint_double(cp, &(self->minimumControlAction));
+    ikCheckpoint_double(cp, &(self->controlAction));
+    ikCheckpoint_double(cp, &(self->x));
+    ikCheckpoint_double(cp, &(self->y));
+}
+
 /* @endcond */
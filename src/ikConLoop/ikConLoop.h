@@ -33,6 +33,9 @@ extern "C" {
 #include "ikLinCon.h"
 #include "ikStpgen.h"
 #include "ikRegionSelector.h"
+#ifdef IKPROFILE
+#include "ikProfile.h"
+#endif
 
     /**
      * @struct ikConLoop
@@ -49,6 +52,13 @@ extern "C" {
      * @par Outputs
      * @li control action, returned by @link ikConLoop_step @endlink
      * 
+     * If IKPROFILE is defined at compile time, the steps are counted and
+     * timed, as are the steps in which the control action is at its limits,
+     * as saturations. The counters of @link ikProfile @endlink are
+     * accessible via @link ikConLoop_getOutput @endlink as "profile>calls",
+     * "profile>cycles", and so on, and those of the linear controllers as
+     * "linear controller>profile>calls", and so on.
+     * 
      * @par Unit block
      * 
      * @image html ikConLoop_unit_block.svg
@@ -62,6 +72,9 @@ extern "C" {
      * @li @link ikConLoop_init @endlink initialise an instance
      * @li @link ikConLoop_step @endlink execute preriodic calculations
      * @li @link ikConLoop_getOutput @endlink get output value
+     * @li @link ikConLoop_saveState @endlink save runtime state to a checkpoint blob
+     * @li @link ikConLoop_restoreState @endlink restore runtime state from a checkpoint blob
+     * @li @link ikConLoop_checkpoint @endlink save or restore runtime state
      */
     typedef struct ikConLoop {
         /**
@@ -79,6 +92,9 @@ extern "C" {
         double              controlAction;
         double              x;
         double              y;
+#ifdef IKPROFILE
+        ikProfile           profile;
+#endif
         /* @endcond */
     } ikConLoop;
     
@@ -95,7 +111,8 @@ extern "C" {
                                              of the enable setting and all other parameters
                                              will be respected.*/
         ikStpgenParams          setpointGenerator;   /**<setpoint generator initialisation parameters*/
-        ikRegionSelectorParams  regionSelector; /**<region selector initialisation parameters.*/
+        ikRegionSelectorPolygonParams regionSelector; /**<region selector initialisation parameters, with the
+                                             polygons held by the caller.*/
         ikLinConParams          setpointFilters; /**<setpoint filter initialisation parameters*/
         ikLinConParams          controlActionFilters; /**<control action filter initialisation parameters*/
     } ikConLoopParams;
@@ -147,6 +164,49 @@ extern "C" {
      */
     int ikConLoop_getOutput(const ikConLoop *self, double *output, const char *name);
 
+    /**
+     * Save runtime state to a checkpoint blob, as described in
+     * @link ikCheckpoint @endlink. The blob can be restored, via
+     * @link ikConLoop_restoreState @endlink, into this or any other instance
+     * initialised with the same parameters.
+     * @param self control loop instance
+     * @param buffer buffer for the blob, or NULL to find out its length
+     * @param size size of the buffer, in bytes
+     * @param length length of the blob, in bytes, or, if the buffer is too
+     * small, the size needed
+     * @return error code:
+     * @li 0: no error
+     * @li -1: the buffer is too small
+     */
+    int ikConLoop_saveState(const ikConLoop *self, void *buffer, size_t size, size_t *length);
+
+    /**
+     * Restore runtime state from a checkpoint blob written by
+     * @link ikConLoop_saveState @endlink. The blob is checked before anything
+     * is restored, so that the instance is left as it was on error.
+     * @param self control loop instance
+     * @param blob blob
+     * @param size size of the blob, in bytes
+     * @return error code:
+     * @li 0: no error
+     * @li -1: the blob is shorter than its header says
+     * @li -2: not a checkpoint blob, or one of another byte order
+     * @li -3: unsupported format version
+     * @li -4: checkpoint blob of another class
+     * @li -5: corrupt payload
+     * @li -6: the blob does not match the configuration of the instance
+     */
+    int ikConLoop_restoreState(ikConLoop *self, const void *blob, size_t size);
+
+    /**
+     * Save or restore runtime state, i.e. that of the setpoint generator, the filters, the region selector and the linear controller, and the latest signal values.
+     * Profiling counters are not included.
+     * @param self control loop instance
+     * @param cp checkpoint blob writer or reader
+     */
+    void ikConLoop_checkpoint(ikConLoop *self, ikCheckpoint *cp);
+
+
 
 #ifdef __cplusplus
 }
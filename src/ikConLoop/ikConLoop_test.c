@@ -322,6 +322,8 @@ void testPresetSelection() {
     ikConLoop loop;
     /* declare initialisation parameters */
     ikConLoopParams params;
+    ikRegionSelectorPoint points[3];
+    ikRegionSelectorPolygon region;
     
     /* initialise instance */
     ikConLoop_initParams(&params);
@@ -332,14 +334,16 @@ void testPresetSelection() {
     params.controlActionFilters.demandTfs.tfParams[0].enable = 1;
     params.controlActionFilters.demandTfs.tfParams[0].b[0] = -2.0;
     /* one triangular region around point {2.0, -4.0} */
+    points[0].x = 1.0;
+    points[0].y = -3.5;
+    points[1].x = 3.0;
+    points[1].y = -3.5;
+    points[2].x = 3.0;
+    points[2].y = -5.0;
+    region.nPoints = 3;
+    region.points = points;
     params.regionSelector.nRegions = 1;
-    params.regionSelector.regions[0].nPoints = 3;
-    params.regionSelector.regions[0].points[0].x = 1.0;
-    params.regionSelector.regions[0].points[0].y = -3.5;
-    params.regionSelector.regions[0].points[1].x = 3.0;
-    params.regionSelector.regions[0].points[1].y = -3.5;
-    params.regionSelector.regions[0].points[2].x = 3.0;
-    params.regionSelector.regions[0].points[2].y = -5.0;
+    params.regionSelector.polygons = &region;
     /* two presets, 0 for default, 1 for region 1 */
     /* one with gain 2, the other with gain -2 */
     params.linearController.configN = 2;
@@ -0,0 +1,457 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikFarm.c
+ * 
+ * @brief Class ikFarm implementation
+ */
+
+/* @cond */
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "ikFarm.h"
+
+#define IKFARM_NINPUTS 21
+#define IKFARM_NOUTPUTS 6
+#define IKFARM_CACHELINE 64
+
+/*range of turbines owned by a thread, padded to a cache line */
+typedef struct ikFarmRange {
+    atomic_int next; /*next turbine to be taken */
+    int end; /*end of the range, not included */
+    char pad[IKFARM_CACHELINE - sizeof(atomic_int) - sizeof(int)];
+} ikFarmRange;
+
+/*worker thread */
+typedef struct ikFarmWorker {
+    struct ikFarmPool *pool;
+    int id; /*thread id, the calling thread being thread 0 */
+    pthread_t thread;
+} ikFarmWorker;
+
+/*thread pool */
+typedef struct ikFarmPool {
+    ikFarm *farm;
+    ikFarmRange *ranges; /*one range per thread */
+    ikFarmWorker *workers; /*one worker per thread, the first one not being used */
+    int nStarted; /*number of worker threads started */
+    pthread_mutex_t mutex;
+    pthread_cond_t start; /*signalled when a new step starts */
+    pthread_cond_t done; /*signalled when the last worker thread finishes a step */
+    unsigned long generation; /*step counter */
+    int pending; /*number of worker threads still busy with the current step */
+    int stop; /*flag: worker threads should exit */
+} ikFarmPool;
+
+/**
+ * (Private) step one turbine
+ */
+void ikFarm_stepTurbine(ikFarm *self, int i) {
+    ikFarmTurbine *t = &(self->priv.turbines[i]);
+    double rotorSpeed;
+    double minimumPitch;
+    int j, k;
+
+    /*estimate tip-speed ratio */
+    self->out.tipSpeedRatio[i] = ikTsrEst_step(&(t->tsrEst), self->in.generatorSpeed[i], self->in.generatorTorque[i], self->in.collectivePitch[i]);
+    ikTsrEst_getOutput(&(t->tsrEst), &rotorSpeed, "rotor speed");
+    self->out.rotorSpeed[i] = rotorSpeed;
+
+    /*limit thrust */
+    self->out.minimumPitch[i] = ikThrustLim_step(&(t->thrustLim), self->out.tipSpeedRatio[i], rotorSpeed, self->in.maximumThrust[i]);
+    minimumPitch = self->in.minimumPitch[i];
+    if (self->out.minimumPitch[i] > minimumPitch) minimumPitch = self->out.minimumPitch[i];
+
+    /*run individual pitch control */
+    t->ipc.in.azimuth = self->in.azimuth[i];
+    t->ipc.in.collectivePitch = self->in.collectivePitch[i];
+    t->ipc.in.maximumPitch = self->in.maximumPitch[i];
+    t->ipc.in.minimumPitch = minimumPitch;
+    for (j = 0; j < 3; j++) {
+        for (k = 0; k < 3; k++) {
+            t->ipc.in.bladeRootMoments[j].c[k] = self->in.bladeRootMoments[j][k][i];
+        }
+    }
+    t->ipc.in.demandedMy = self->in.demandedMy[i];
+    t->ipc.in.demandedMz = self->in.demandedMz[i];
+    t->ipc.in.maximumIndividualPitch = self->in.maximumIndividualPitch[i];
+    t->ipc.in.externalPitchY = self->in.externalPitchY[i];
+    t->ipc.in.externalPitchZ = self->in.externalPitchZ[i];
+    ikIpc_step(&(t->ipc));
+    for (j = 0; j < 3; j++) {
+        self->out.pitch[j][i] = t->ipc.out.pitch[j];
+    }
+}
+
+/**
+ * (Private) step turbines from own range first, and then steal from the others
+ */
+void ikFarm_work(ikFarmPool *pool, int id) {
+    ikFarm *farm = pool->farm;
+    int nThreads = farm->priv.nThreads;
+    int chunkSize = farm->priv.chunkSize;
+    int k, i, start, end;
+    ikFarmRange *range;
+
+    for (k = 0; k < nThreads; k++) {
+        range = &(pool->ranges[(id + k) % nThreads]);
+        while ((start = atomic_fetch_add_explicit(&(range->next), chunkSize, memory_order_relaxed)) < range->end) {
+            end = start + chunkSize < range->end ? start + chunkSize : range->end;
+            for (i = start; i < end; i++) ikFarm_stepTurbine(farm, i);
+        }
+    }
+}
+
+/**
+ * (Private) worker thread main function
+ */
+void *ikFarm_worker(void *arg) {
+    ikFarmWorker *worker = (ikFarmWorker *) arg;
+    ikFarmPool *pool = worker->pool;
+    unsigned long seen = 0;
+
+    for (;;) {
+        /*wait for a new step */
+        pthread_mutex_lock(&(pool->mutex));
+        while ((seen == pool->generation) && !pool->stop) pthread_cond_wait(&(pool->start), &(pool->mutex));
+        if (pool->stop) {
+            pthread_mutex_unlock(&(pool->mutex));
+            break;
+        }
+        seen = pool->generation;
+        pthread_mutex_unlock(&(pool->mutex));
+
+        /*step turbines */
+        ikFarm_work(pool, worker->id);
+
+        /*report */
+        pthread_mutex_lock(&(pool->mutex));
+        if (0 == --(pool->pending)) pthread_cond_signal(&(pool->done));
+        pthread_mutex_unlock(&(pool->mutex));
+    }
+    return NULL;
+}
+
+/**
+ * (Private) stop the worker threads and free the thread pool
+ */
+void ikFarm_deletePool(ikFarmPool *pool) {
+    int i;
+
+    /*tell the worker threads to exit, and wait for them */
+    pthread_mutex_lock(&(pool->mutex));
+    pool->stop = 1;
+    pthread_cond_broadcast(&(pool->start));
+    pthread_mutex_unlock(&(pool->mutex));
+    for (i = 1; i <= pool->nStarted; i++) pthread_join(pool->workers[i].thread, NULL);
+
+    /*free memory */
+    pthread_cond_destroy(&(pool->done));
+    pthread_cond_destroy(&(pool->start));
+    pthread_mutex_destroy(&(pool->mutex));
+    free(pool->workers);
+    free(pool->ranges);
+    free(pool);
+}
+
+/**
+ * (Private) start the thread pool
+ * @return error code:
+ *  0: no error
+ * -1: could not allocate memory
+ * -2: could not start the threads
+ */
+int ikFarm_newPool(ikFarm *self) {
+    int nThreads = self->priv.nThreads;
+    int nTurbines = self->priv.nTurbines;
+    ikFarmPool *pool;
+    int i;
+    void *mem;
+
+    /*allocate memory */
+    pool = (ikFarmPool *) malloc(sizeof(ikFarmPool));
+    if (NULL == pool) return -1;
+    if (posix_memalign(&mem, IKFARM_CACHELINE, sizeof(ikFarmRange) * nThreads)) {
+        free(pool);
+        return -1;
+    }
+    pool->ranges = (ikFarmRange *) mem;
+    pool->workers = (ikFarmWorker *) malloc(sizeof(ikFarmWorker) * nThreads);
+    if (NULL == pool->workers) {
+        free(pool->ranges);
+        free(pool);
+        return -1;
+    }
+
+    /*split the turbines into equal ranges */
+    for (i = 0; i < nThreads; i++) {
+        atomic_init(&(pool->ranges[i].next), (int) ((long) nTurbines * i / nThreads));
+        pool->ranges[i].end = (int) ((long) nTurbines * (i + 1) / nThreads);
+    }
+
+    /*start the worker threads */
+    pool->farm = self;
+    pool->generation = 0;
+    pool->pending = 0;
+    pool->stop = 0;
+    pool->nStarted = 0;
+    pthread_mutex_init(&(pool->mutex), NULL);
+    pthread_cond_init(&(pool->start), NULL);
+    pthread_cond_init(&(pool->done), NULL);
+    self->priv.pool = pool;
+    for (i = 1; i < nThreads; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].id = i;
+        if (pthread_create(&(pool->workers[i].thread), NULL, ikFarm_worker, &(pool->workers[i]))) {
+            ikFarm_deletePool(pool);
+            self->priv.pool = NULL;
+            return -2;
+        }
+        pool->nStarted++;
+    }
+
+    return 0;
+}
+
+/**
+ * (Private) point the input and output arrays at the signal memory
+ */
+void ikFarm_mapSignals(ikFarm *self) {
+    int n = self->priv.nTurbines;
+    double *p = self->priv.signals;
+    int j, k;
+
+    /*inputs */
+    self->in.generatorSpeed = p; p += n;
+    self->in.generatorTorque = p; p += n;
+    self->in.maximumThrust = p; p += n;
+    self->in.azimuth = p; p += n;
+    self->in.collectivePitch = p; p += n;
+    self->in.maximumPitch = p; p += n;
+    self->in.minimumPitch = p; p += n;
+    for (j = 0; j < 3; j++) {
+        for (k = 0; k < 3; k++) {
+            self->in.bladeRootMoments[j][k] = p; p += n;
+        }
+    }
+    self->in.demandedMy = p; p += n;
+    self->in.demandedMz = p; p += n;
+    self->in.maximumIndividualPitch = p; p += n;
+    self->in.externalPitchY = p; p += n;
+    self->in.externalPitchZ = p; p += n;
+
+    /*outputs */
+    self->out.tipSpeedRatio = p; p += n;
+    self->out.rotorSpeed = p; p += n;
+    self->out.minimumPitch = p; p += n;
+    for (j = 0; j < 3; j++) {
+        self->out.pitch[j] = p; p += n;
+    }
+}
+
+int ikFarm_init(ikFarm *self, const ikFarmParams *params) {
+    int i;
+    int err;
+    size_t ipcBufferSize;
+    const ikFarmTurbineParams *tp;
+
+    /*check parameters */
+    if (1 > params->nTurbines) return -1;
+    if (1 > params->nThreads) return -2;
+    if (1 > params->chunkSize) return -3;
+    self->priv.nTurbines = params->nTurbines;
+    self->priv.nThreads = params->nThreads;
+    self->priv.chunkSize = params->chunkSize;
+    self->priv.pool = NULL;
+
+    /*allocate memory */
+    self->priv.signals = (double *) calloc((size_t) (IKFARM_NINPUTS + IKFARM_NOUTPUTS) * params->nTurbines, sizeof(double));
+    if (NULL == self->priv.signals) return -4;
+    self->priv.turbines = (ikFarmTurbine *) malloc(sizeof(ikFarmTurbine) * params->nTurbines);
+    if (NULL == self->priv.turbines) {
+        free(self->priv.signals);
+        return -4;
+    }
+    ikFarm_mapSignals(self);
+
+    /*initialise turbine controllers */
+    for (i = 0; i < params->nTurbines; i++) {
+        tp = (NULL == params->turbines) ? &(params->turbine) : &(params->turbines[i]);
+        err = ikTsrEst_init(&(self->priv.turbines[i].tsrEst), &(tp->tsrEst));
+        if (err) err = -5;
+        if (!err) {
+            err = ikThrustLim_init(&(self->priv.turbines[i].thrustLim), &(tp->thrustLim));
+            if (err) {
+                ikTsrEst_delete(&(self->priv.turbines[i].tsrEst));
+                err = -6;
+            }
+        }
+        if (!err) {
+            ipcBufferSize = ikIpc_getBufferSize(&(tp->ipc));
+            self->priv.turbines[i].ipcBuffer = ipcBufferSize ? malloc(ipcBufferSize) : NULL;
+            if (ipcBufferSize && NULL == self->priv.turbines[i].ipcBuffer) err = -4;
+            if (!err) err = ikIpc_initBuffer(&(self->priv.turbines[i].ipc), &(tp->ipc), self->priv.turbines[i].ipcBuffer, ipcBufferSize) ? -7 : 0;
+            if (3 != tp->ipc.nBlades) err = -7;
+            if (err) {
+                free(self->priv.turbines[i].ipcBuffer);
+                ikThrustLim_delete(&(self->priv.turbines[i].thrustLim));
+                ikTsrEst_delete(&(self->priv.turbines[i].tsrEst));
+            }
+        }
+        if (err) {
+            self->priv.nTurbines = i;
+            ikFarm_delete(self);
+            return err;
+        }
+    }
+
+    /*start threads */
+    if (1 < self->priv.nThreads) {
+        err = ikFarm_newPool(self);
+        if (err) {
+            ikFarm_delete(self);
+            return -1 == err ? -4 : -8;
+        }
+    }
+
+    return 0;
+}
+
+void ikFarm_initParams(ikFarmParams *params) {
+    /* set defaults */
+    params->nTurbines = 1;
+    params->nThreads = 1;
+    params->chunkSize = 4;
+    params->turbines = NULL;
+
+    /* initialise member parameters */
+    ikTsrEst_initParams(&(params->turbine.tsrEst));
+    ikThrustLim_initParams(&(params->turbine.thrustLim));
+    ikIpc_initParams(&(params->turbine.ipc));
+}
+
+void ikFarm_step(ikFarm *self) {
+    ikFarmPool *pool = self->priv.pool;
+    int i;
+
+    /*step serially if there is only one thread */
+    if (NULL == pool) {
+        for (i = 0; i < self->priv.nTurbines; i++) ikFarm_stepTurbine(self, i);
+        return;
+    }
+
+    /*reset the ranges */
+    for (i = 0; i < self->priv.nThreads; i++) {
+        atomic_store_explicit(&(pool->ranges[i].next), (int) ((long) self->priv.nTurbines * i / self->priv.nThreads), memory_order_relaxed);
+    }
+
+    /*start a new step */
+    pthread_mutex_lock(&(pool->mutex));
+    pool->pending = pool->nStarted;
+    pool->generation++;
+    pthread_cond_broadcast(&(pool->start));
+    pthread_mutex_unlock(&(pool->mutex));
+
+    /*step turbines as thread 0 */
+    ikFarm_work(pool, 0);
+
+    /*wait for the worker threads */
+    pthread_mutex_lock(&(pool->mutex));
+    while (pool->pending) pthread_cond_wait(&(pool->done), &(pool->mutex));
+    pthread_mutex_unlock(&(pool->mutex));
+}
+
+int ikFarm_getOutput(const ikFarm *self, double *output, int turbine, const char *name) {
+    int err;
+    const char *sep;
+    const ikFarmTurbine *t;
+
+    /* check the turbine index */
+    if ((0 > turbine) || (self->priv.nTurbines <= turbine)) return -3;
+    t = &(self->priv.turbines[turbine]);
+
+    /* pick up the block names */
+    sep = strstr(name, ">");
+    if (NULL == sep) return -1;
+    if (!strncmp(name, "tip-speed ratio estimator", strlen(name) - strlen(sep))) {
+        err = ikTsrEst_getOutput(&(t->tsrEst), output, sep + 1);
+        if (err) return -1;
+        else return 0;
+    }
+    if (!strncmp(name, "thrust limiter", strlen(name) - strlen(sep))) {
+        err = ikThrustLim_getOutput(&(t->thrustLim), output, sep + 1);
+        if (err) return -1;
+        else return 0;
+    }
+    if (!strncmp(name, "individual pitch control", strlen(name) - strlen(sep))) {
+        err = ikIpc_getOutput(&(t->ipc), output, sep + 1);
+        if (err) return -1;
+        else return 0;
+    }
+
+    return -2;
+}
+
+void ikFarm_checkpoint(ikFarm *self, ikCheckpoint *cp) {
+    int i, j;
+    ikFarmTurbine *t;
+
+    ikCheckpoint_check(cp, self->priv.nTurbines);
+    for (i = 0; i < self->priv.nTurbines; i++) {
+        /*controllers */
+        t = &(self->priv.turbines[i]);
+        ikTsrEst_checkpoint(&(t->tsrEst), cp);
+        ikThrustLim_checkpoint(&(t->thrustLim), cp);
+        ikIpc_checkpoint(&(t->ipc), cp);
+
+        /*outputs */
+        ikCheckpoint_double(cp, &(self->out.tipSpeedRatio[i]));
+        ikCheckpoint_double(cp, &(self->out.rotorSpeed[i]));
+        ikCheckpoint_double(cp, &(self->out.minimumPitch[i]));
+        for (j = 0; j < 3; j++) ikCheckpoint_double(cp, &(self->out.pitch[j][i]));
+    }
+}
+
+void ikFarm_delete(ikFarm *self) {
+    int i;
+
+    /*stop threads */
+    if (NULL != self->priv.pool) ikFarm_deletePool(self->priv.pool);
+    self->priv.pool = NULL;
+
+    /*delete turbine controllers */
+    for (i = 0; i < self->priv.nTurbines; i++) {
+        ikThrustLim_delete(&(self->priv.turbines[i].thrustLim));
+        ikTsrEst_delete(&(self->priv.turbines[i].tsrEst));
+        free(self->priv.turbines[i].ipcBuffer);
+    }
+    self->priv.nTurbines = 0;
+
+    /*free memory */
+    free(self->priv.turbines);
+    free(self->priv.signals);
+    self->priv.turbines = NULL;
+    self->priv.signals = NULL;
+}
+
+/* @endcond */
@@ -0,0 +1,249 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikFarm.h
+ * 
+ * @brief Class ikFarm interface
+ */
+
+#ifndef IKFARM_H
+#define IKFARM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ikTsrEst.h"
+#include "ikThrustLim.h"
+#include "ikIpc.h"
+
+    /**
+     * @struct ikFarmInputs
+     * @brief Wind farm inputs
+     * 
+     * Instances of ikFarm take inputs via a structure of this type:
+     * @link ikFarm.in @endlink. Each member points to an array with one
+     * value per turbine, allocated by @link ikFarm_init @endlink.
+     */
+    typedef struct ikFarmInputs {
+        double *generatorSpeed; /**<generator speed, in rad/s*/
+        double *generatorTorque; /**<generator torque, in kNm*/
+        double *maximumThrust; /**<maximum thrust, in kN*/
+        double *azimuth; /**<azimuth angle, in degrees, as in @link ikIpcInputs @endlink*/
+        double *collectivePitch; /**<collective pitch angle, in degrees*/
+        double *maximumPitch; /**<maximum pitch, in degrees*/
+        double *minimumPitch; /**<minimum pitch, in degrees, before thrust limitation*/
+        double *bladeRootMoments[3][3]; /**<blade root moments, in kNm, where bladeRootMoments[i][j]
+                                         * is the array of moments of blade i+1 around local axis j, as
+                                         * in @link ikIpcInputs @endlink*/
+        double *demandedMy; /**<demanded My, in kNm*/
+        double *demandedMz; /**<demanded Mz, in kNm*/
+        double *maximumIndividualPitch; /**<maximum individual pitch, in degrees*/
+        double *externalPitchY; /**<external pitch y, in degrees*/
+        double *externalPitchZ; /**<external pitch z, in degrees*/
+    } ikFarmInputs;
+
+    /**
+     * @struct ikFarmOutputs
+     * @brief Wind farm outputs
+     * 
+     * Instances of ikFarm make outputs available via a structure of this type:
+     * @link ikFarm.out @endlink. Each member points to an array with one
+     * value per turbine, allocated by @link ikFarm_init @endlink.
+     */
+    typedef struct ikFarmOutputs {
+        double *tipSpeedRatio; /**<estimated tip-speed ratio*/
+        double *rotorSpeed; /**<filtered rotor speed, in rad/s*/
+        double *minimumPitch; /**<minimum pitch from thrust limitation, in degrees*/
+        double *pitch[3]; /**<pitch angles, in degrees, where pitch[i] is the array of pitch angles of blade i+1*/
+    } ikFarmOutputs;
+
+    /* @cond */
+    typedef struct ikFarmTurbine {
+        ikTsrEst tsrEst;
+        ikThrustLim thrustLim;
+        ikIpc ipc;
+        void *ipcBuffer;
+    } ikFarmTurbine;
+
+    typedef struct ikFarmPrivate {
+        int nTurbines;
+        int nThreads;
+        int chunkSize;
+        ikFarmTurbine *turbines;
+        double *signals;
+        struct ikFarmPool *pool;
+    } ikFarmPrivate;
+    /* @endcond */
+
+    /**
+     * @struct ikFarm
+     * @brief Wind farm controller executor
+     * 
+     * Instances of this type own the controllers of a number of wind turbines,
+     * and step all of them at once. Each turbine is controlled by a tip-speed
+     * ratio estimator (@link ikTsrEst @endlink), a thrust limiter
+     * (@link ikThrustLim @endlink) and an individual pitch controller
+     * (@link ikIpc @endlink), connected as follows:
+     * @li the tip-speed ratio estimator takes the generator speed, the
+     * generator torque and the collective pitch angle
+     * @li the thrust limiter takes the estimated tip-speed ratio, the filtered
+     * rotor speed and the maximum thrust
+     * @li the individual pitch controller takes the rest of the inputs, with
+     * the minimum pitch raised to the output of the thrust limiter when needed
+     * 
+     * Inputs and outputs are exchanged through arrays with one value per
+     * turbine (structure of arrays), allocated once by @link ikFarm_init @endlink.
+     * 
+     * The turbines are stepped by a pool of threads, the calling thread being
+     * one of them. The turbines are split into equal ranges, one per thread,
+     * and each range into chunks. Each thread takes chunks from its own range
+     * first, and then from the ranges of the other threads, until there are
+     * none left. @link ikFarm_step @endlink returns when all turbines have
+     * been stepped. As the turbines are independent of each other, the
+     * results do not depend on the number of threads, or on which thread
+     * steps which turbine.
+     * 
+     * This class needs POSIX threads, and is meant for simulation, rather than
+     * for the turbine controllers themselves.
+     * 
+     * @par Inputs
+     * @li per turbine inputs, specify via @link in @endlink
+     * 
+     * @par Outputs
+     * @li per turbine outputs, get via @link out @endlink
+     * 
+     * @par Methods
+     * @li @link ikFarm_initParams @endlink initialise initialisation parameter structure
+     * @li @link ikFarm_init @endlink initialise an instance
+     * @li @link ikFarm_step @endlink execute periodic calculations
+     * @li @link ikFarm_getOutput @endlink get output value
+     * @li @link ikFarm_checkpoint @endlink save or restore runtime state
+     * @li @link ikFarm_delete @endlink delete instance
+     */
+    typedef struct ikFarm {
+        ikFarmInputs in; /**<inputs*/
+        ikFarmOutputs out; /**<outputs*/
+        /* @cond */
+        ikFarmPrivate priv;
+        /* @endcond */
+    } ikFarm;
+
+    /**
+     * @struct ikFarmTurbineParams
+     * @brief Wind farm turbine controller initialisation parameters
+     */
+    typedef struct ikFarmTurbineParams {
+        ikTsrEstParams tsrEst; /**<tip-speed ratio estimator initialisation parameters*/
+        ikThrustLimParams thrustLim; /**<thrust limiter initialisation parameters*/
+        ikIpcParams ipc; /**<individual pitch control initialisation parameters,
+                          for 3 blades, as the inputs and outputs of @link ikFarm @endlink*/
+    } ikFarmTurbineParams;
+
+    /**
+     * @struct ikFarmParams
+     * @brief Wind farm controller executor initialisation parameters
+     */
+    typedef struct ikFarmParams {
+        int nTurbines; /**<number of turbines. The default value is 1.*/
+        int nThreads; /**<number of threads, including the calling thread. The default value is 1.*/
+        int chunkSize; /**<number of turbines stepped at a time by a thread. The default value is 4.*/
+        ikFarmTurbineParams turbine; /**<initialisation parameters for all turbines, unless turbines is not NULL*/
+        const ikFarmTurbineParams *turbines; /**<array of nTurbines initialisation parameter structures, one per turbine,
+                                              * or NULL to use turbine for all turbines. The default value is NULL.*/
+    } ikFarmParams;
+
+    /**
+     * Initialise an instance
+     * 
+     * All inputs are set to 0.0.
+     * 
+     * @param self instance
+     * @param params initialisation parameters
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid number of turbines, must be positive
+     * @li -2: invalid number of threads, must be positive
+     * @li -3: invalid chunk size, must be positive
+     * @li -4: could not allocate memory
+     * @li -5: could not initialise a tip-speed ratio estimator
+     * @li -6: could not initialise a thrust limiter
+     * @li -7: could not initialise an individual pitch controller, or it is not for 3 blades
+     * @li -8: could not start the threads
+     */
+    int ikFarm_init(ikFarm *self, const ikFarmParams *params);
+
+    /**
+     * Initialise initialisation parameter structure
+     * @param params initialisation parameter structure
+     */
+    void ikFarm_initParams(ikFarmParams *params);
+
+    /**
+     * Execute periodic calculations for all turbines
+     * @param self wind farm controller executor instance
+     */
+    void ikFarm_step(ikFarm *self);
+
+    /**
+     * Get output value of a turbine by name. The signals of the controllers
+     * of each turbine are accessible with the controller name followed by a
+     * ">" character and the signal name, as in the controller getOutput method.
+     * The controller names are:
+     * @li "tip-speed ratio estimator", see @link ikTsrEst_getOutput @endlink
+     * @li "thrust limiter", see @link ikThrustLim_getOutput @endlink
+     * @li "individual pitch control", see @link ikIpc_getOutput @endlink
+     * 
+     * For example, to get the rotor speed of turbine 3 use turbine = 3 and
+     * name = "tip-speed ratio estimator>rotor speed".
+     * 
+     * @param self wind farm controller executor instance
+     * @param output output value
+     * @param turbine turbine index, starting at 0
+     * @param name output name
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid signal name
+     * @li -2: invalid block name
+     * @li -3: invalid turbine index
+     */
+    int ikFarm_getOutput(const ikFarm *self, double *output, int turbine, const char *name);
+
+    /**
+     * Save or restore runtime state, i.e. that of the controllers of all
+     * turbines, as in @link ikTsrEst_checkpoint @endlink,
+     * @link ikThrustLim_checkpoint @endlink and @link ikIpc_checkpoint @endlink,
+     * and the outputs. The inputs are not included.
+     * @param self wind farm controller executor instance
+     * @param cp checkpoint blob writer or reader
+     */
+    void ikFarm_checkpoint(ikFarm *self, ikCheckpoint *cp);
+
+    /**
+     * Delete instance, stopping its threads and freeing its memory
+     * @param self wind farm controller executor instance
+     */
+    void ikFarm_delete(ikFarm *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKFARM_H */
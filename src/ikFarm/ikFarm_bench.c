@@ -0,0 +1,139 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikFarm_bench.c
+ * 
+ * @brief Class ikFarm scaling benchmark
+ * 
+ * Steps a farm of identical turbines with 1, 2, 4, ... up to a maximum
+ * number of threads, and reports the time per step, the turbine steps per
+ * second and the speedup with respect to 1 thread. The outputs of every
+ * run are checked to be bit for bit equal to those of the run with 1 thread.
+ * 
+ * Usage: ikFarm_bench [turbines [steps [maximum threads [chunk size]]]]
+ * 
+ * The defaults are 512 turbines, 2000 steps, 64 threads and chunks of 4
+ * turbines.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "ikFarm.h"
+#include "ikTestUtil.h"
+
+/*
+ * Set the inputs of a farm for step k.
+ */
+void setInputs(ikFarm *farm, int nTurbines, int k) {
+    int i, j, l;
+    for (i = 0; i < nTurbines; i++) {
+        farm->in.generatorSpeed[i] = 120.0 + 10.0 * sin(0.01 * k + i);
+        farm->in.generatorTorque[i] = 40.0 + 5.0 * sin(0.03 * k + 2.0 * i);
+        farm->in.maximumThrust[i] = 500.0 + i;
+        farm->in.azimuth[i] = fmod(7.0 * k + 11.0 * i, 360.0);
+        farm->in.collectivePitch[i] = 2.0 + sin(0.02 * k - i);
+        farm->in.maximumPitch[i] = 90.0;
+        farm->in.minimumPitch[i] = 0.0;
+        farm->in.maximumIndividualPitch[i] = 5.0;
+        farm->in.externalPitchY[i] = 0.5 * cos(0.01 * k);
+        farm->in.externalPitchZ[i] = 0.5 * sin(0.01 * k);
+        for (j = 0; j < 3; j++) {
+            for (l = 0; l < 3; l++) {
+                farm->in.bladeRootMoments[j][l][i] = 100.0 * sin(0.05 * k + 0.3 * (3*j + l) + i);
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    int nTurbines = argc > 1 ? atoi(argv[1]) : 512;
+    int nSteps = argc > 2 ? atoi(argv[2]) : 2000;
+    int maxThreads = argc > 3 ? atoi(argv[3]) : 64;
+    int chunkSize = argc > 4 ? atoi(argv[4]) : 4;
+    double *reference;
+    double t1 = 0.0;
+    int nThreads, i, j, k, err;
+
+    if (ikTestUtil_writeSurfaces("ikFarm_bench_cp.bin", "ikFarm_bench_ct.bin")) {
+        printf("could not write surface files\n");
+        return (EXIT_FAILURE);
+    }
+    reference = (double *) malloc(sizeof(double) * 3 * nTurbines);
+    if (NULL == reference) return (EXIT_FAILURE);
+
+    printf("turbines=%d steps=%d chunk=%d\n", nTurbines, nSteps, chunkSize);
+    printf("%8s %14s %16s %8s %6s\n", "threads", "us/step", "turbine steps/s", "speedup", "equal");
+    for (nThreads = 1; nThreads <= maxThreads; nThreads *= 2) {
+        ikFarm farm;
+        ikFarmParams params;
+        struct timespec start, end;
+        double t;
+        int equal = 1;
+
+        /*set up farm */
+        ikFarm_initParams(&params);
+        params.nTurbines = nTurbines;
+        params.nThreads = nThreads;
+        params.chunkSize = chunkSize;
+        params.turbine.tsrEst.b = 97.0;
+        params.turbine.tsrEst.J = 4.0e6;
+        params.turbine.tsrEst.rho = 1.225;
+        params.turbine.tsrEst.R = 63.0;
+        params.turbine.tsrEst.cplambda3SurfaceFileName = "ikFarm_bench_cp.bin";
+        params.turbine.thrustLim.rho = 1.225;
+        params.turbine.thrustLim.R = 63.0;
+        params.turbine.thrustLim.ctlambda2SurfaceFileName = "ikFarm_bench_ct.bin";
+        err = ikFarm_init(&farm, &params);
+        if (err) {
+            printf("init returned %d\n", err);
+            break;
+        }
+
+        /*run, timing the steps only */
+        t = 0.0;
+        for (k = 0; k < nSteps; k++) {
+            setInputs(&farm, nTurbines, k);
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            ikFarm_step(&farm);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            t += (end.tv_sec - start.tv_sec) + 1e-9 * (end.tv_nsec - start.tv_nsec);
+        }
+
+        /*compare with 1 thread */
+        for (j = 0; j < 3; j++) {
+            for (i = 0; i < nTurbines; i++) {
+                if (1 == nThreads) reference[j*nTurbines + i] = farm.out.pitch[j][i];
+                else if (reference[j*nTurbines + i] != farm.out.pitch[j][i]) equal = 0;
+            }
+        }
+        if (1 == nThreads) t1 = t;
+
+        printf("%8d %14.2f %16.0f %8.2f %6s\n", nThreads, 1e6 * t / nSteps, (double) nTurbines * nSteps / t, t1 / t, equal ? "yes" : "NO");
+        ikFarm_delete(&farm);
+    }
+
+    free(reference);
+    remove("ikFarm_bench_cp.bin");
+    remove("ikFarm_bench_ct.bin");
+    return (EXIT_SUCCESS);
+}
@@ -0,0 +1,270 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikFarm_test.c
+ * 
+ * @brief Class ikFarm unit tests
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "ikFarm.h"
+#include "ikTestUtil.h"
+
+/*
+ * Simple C Test Suite for class ikFarm
+ */
+
+#define NTURBINES 37
+#define NSTEPS 300
+
+/**
+ * Set up turbine parameters.
+ */
+void initTurbineParams(ikFarmTurbineParams *params) {
+    ikTsrEst_initParams(&(params->tsrEst));
+    params->tsrEst.b = 97.0;
+    params->tsrEst.J = 4.0e6;
+    params->tsrEst.rho = 1.225;
+    params->tsrEst.R = 63.0;
+    params->tsrEst.T = 0.01;
+    params->tsrEst.cplambda3SurfaceFileName = "ikFarm_test_cp.bin";
+    ikThrustLim_initParams(&(params->thrustLim));
+    params->thrustLim.rho = 1.225;
+    params->thrustLim.R = 63.0;
+    params->thrustLim.ctlambda2SurfaceFileName = "ikFarm_test_ct.bin";
+    ikIpc_initParams(&(params->ipc));
+}
+
+/**
+ * Input value for signal s of turbine i at step k.
+ */
+double input(int s, int i, int k) {
+    switch (s) {
+        case 0: return 120.0 + 10.0 * sin(0.01 * k + i); /*generator speed */
+        case 1: return 40.0 + 5.0 * sin(0.03 * k + 2.0 * i); /*generator torque */
+        case 2: return 500.0 + 50.0 * i; /*maximum thrust */
+        case 3: return fmod(7.0 * k + 11.0 * i, 360.0); /*azimuth */
+        case 4: return 2.0 + sin(0.02 * k - i); /*collective pitch */
+        case 5: return 90.0; /*maximum pitch */
+        case 6: return 0.0; /*minimum pitch */
+        case 7: return 5.0; /*maximum individual pitch */
+        case 17: return 0.5 * cos(0.01 * k); /*external pitch y */
+        case 18: return 0.5 * sin(0.01 * k); /*external pitch z */
+        default: return 100.0 * sin(0.05 * k + 0.3 * s + i); /*moments */
+    }
+}
+
+/**
+ * Set the inputs of a farm.
+ */
+void setInputs(ikFarm *farm, int k) {
+    int i, j, l;
+    for (i = 0; i < NTURBINES; i++) {
+        farm->in.generatorSpeed[i] = input(0, i, k);
+        farm->in.generatorTorque[i] = input(1, i, k);
+        farm->in.maximumThrust[i] = input(2, i, k);
+        farm->in.azimuth[i] = input(3, i, k);
+        farm->in.collectivePitch[i] = input(4, i, k);
+        farm->in.maximumPitch[i] = input(5, i, k);
+        farm->in.minimumPitch[i] = input(6, i, k);
+        farm->in.maximumIndividualPitch[i] = input(7, i, k);
+        farm->in.externalPitchY[i] = input(17, i, k);
+        farm->in.externalPitchZ[i] = input(18, i, k);
+        for (j = 0; j < 3; j++) {
+            for (l = 0; l < 3; l++) {
+                farm->in.bladeRootMoments[j][l][i] = input(8 + 3*j + l, i, k);
+            }
+        }
+    }
+}
+
+/**
+ * Test that the farm does what separate controller instances do, with any
+ * number of threads, bit for bit.
+ */
+void testDeterminism() {
+    printf("ikFarm_test determinism\n");
+
+    /*reference controllers, stepped serially */
+    ikTsrEst tsrEst[NTURBINES];
+    ikThrustLim thrustLim[NTURBINES];
+    ikIpc ipc[NTURBINES];
+    double pitch[NSTEPS][NTURBINES][3];
+    ikFarmTurbineParams tp;
+    initTurbineParams(&tp);
+    int i, j, l, k;
+    for (i = 0; i < NTURBINES; i++) {
+        if (ikTsrEst_init(&(tsrEst[i]), &(tp.tsrEst))) printf("%%TEST_FAILED%% time=0 testname=determinism (ikFarm_test) message=could not initialise ikTsrEst\n");
+        if (ikThrustLim_init(&(thrustLim[i]), &(tp.thrustLim))) printf("%%TEST_FAILED%% time=0 testname=determinism (ikFarm_test) message=could not initialise ikThrustLim\n");
+        if (ikIpc_init(&(ipc[i]), &(tp.ipc))) printf("%%TEST_FAILED%% time=0 testname=determinism (ikFarm_test) message=could not initialise ikIpc\n");
+    }
+    for (k = 0; k < NSTEPS; k++) {
+        for (i = 0; i < NTURBINES; i++) {
+            double tsr = ikTsrEst_step(&(tsrEst[i]), input(0, i, k), input(1, i, k), input(4, i, k));
+            double rotorSpeed;
+            ikTsrEst_getOutput(&(tsrEst[i]), &rotorSpeed, "rotor speed");
+            double minPitch = ikThrustLim_step(&(thrustLim[i]), tsr, rotorSpeed, input(2, i, k));
+            ipc[i].in.azimuth = input(3, i, k);
+            ipc[i].in.collectivePitch = input(4, i, k);
+            ipc[i].in.maximumPitch = input(5, i, k);
+            ipc[i].in.minimumPitch = minPitch > input(6, i, k) ? minPitch : input(6, i, k);
+            ipc[i].in.maximumIndividualPitch = input(7, i, k);
+            ipc[i].in.externalPitchY = input(17, i, k);
+            ipc[i].in.externalPitchZ = input(18, i, k);
+            for (j = 0; j < 3; j++) {
+                for (l = 0; l < 3; l++) {
+                    ipc[i].in.bladeRootMoments[j].c[l] = input(8 + 3*j + l, i, k);
+                }
+            }
+            ikIpc_step(&(ipc[i]));
+            for (j = 0; j < 3; j++) pitch[k][i][j] = ipc[i].out.pitch[j];
+        }
+    }
+    for (i = 0; i < NTURBINES; i++) {
+        ikTsrEst_delete(&(tsrEst[i]));
+        ikThrustLim_delete(&(thrustLim[i]));
+    }
+
+    /*see that the farm gives the same results with any number of threads and chunk size */
+    const int nThreads[4] = {1, 2, 5, 8};
+    const int chunkSize[4] = {4, 1, 3, 16};
+    int n;
+    for (n = 0; n < 4; n++) {
+        ikFarm farm;
+        ikFarmParams params;
+        ikFarm_initParams(&params);
+        params.nTurbines = NTURBINES;
+        params.nThreads = nThreads[n];
+        params.chunkSize = chunkSize[n];
+        initTurbineParams(&(params.turbine));
+        int err = ikFarm_init(&farm, &params);
+        if (err) {
+            printf("%%TEST_FAILED%% time=0 testname=determinism (ikFarm_test) message=init expected to return 0, but returned %d\n", err);
+            continue;
+        }
+        int fails = 0;
+        for (k = 0; k < NSTEPS; k++) {
+            setInputs(&farm, k);
+            ikFarm_step(&farm);
+            for (i = 0; i < NTURBINES; i++) {
+                for (j = 0; j < 3; j++) {
+                    if ((pitch[k][i][j] != farm.out.pitch[j][i]) && (fails++ < 5)) printf("%%TEST_FAILED%% time=0 testname=determinism (ikFarm_test) message=with %d threads, pitch %d of turbine %d at step %d expected to be %.17g, but is %.17g\n", nThreads[n], j + 1, i, k, pitch[k][i][j], farm.out.pitch[j][i]);
+                }
+            }
+        }
+        ikFarm_delete(&farm);
+    }
+}
+
+/**
+ * Test that outputs of the turbine controllers are accessible.
+ */
+void testGetOutput() {
+    printf("ikFarm_test getOutput\n");
+    ikFarm farm;
+    ikFarmParams params;
+    ikFarm_initParams(&params);
+    params.nTurbines = NTURBINES;
+    params.nThreads = 3;
+    initTurbineParams(&(params.turbine));
+    int err = ikFarm_init(&farm, &params);
+    if (err) {
+        printf("%%TEST_FAILED%% time=0 testname=getOutput (ikFarm_test) message=init expected to return 0, but returned %d\n", err);
+        return;
+    }
+    setInputs(&farm, 0);
+    ikFarm_step(&farm);
+
+    /*see that the signals match the outputs */
+    double output;
+    err = ikFarm_getOutput(&farm, &output, 5, "tip-speed ratio estimator>tip-speed ratio");
+    if (err) printf("%%TEST_FAILED%% time=0 testname=getOutput (ikFarm_test) message=getOutput expected to return 0, but returned %d\n", err);
+    if (output != farm.out.tipSpeedRatio[5]) printf("%%TEST_FAILED%% time=0 testname=getOutput (ikFarm_test) message=tip-speed ratio expected to be %f, but is %f\n", farm.out.tipSpeedRatio[5], output);
+    err = ikFarm_getOutput(&farm, &output, 7, "thrust limiter>minimum pitch");
+    if (err) printf("%%TEST_FAILED%% time=0 testname=getOutput (ikFarm_test) message=getOutput expected to return 0, but returned %d\n", err);
+    if (output != farm.out.minimumPitch[7]) printf("%%TEST_FAILED%% time=0 testname=getOutput (ikFarm_test) message=minimum pitch expected to be %f, but is %f\n", farm.out.minimumPitch[7], output);
+    err = ikFarm_getOutput(&farm, &output, 11, "individual pitch control>pitch increment 1");
+    if (err) printf("%%TEST_FAILED%% time=0 testname=getOutput (ikFarm_test) message=getOutput expected to return 0, but returned %d\n", err);
+    if (fabs(farm.in.collectivePitch[11] + output - farm.out.pitch[0][11]) > 1e-9) printf("%%TEST_FAILED%% time=0 testname=getOutput (ikFarm_test) message=pitch increment 1 expected to be %f, but is %f\n", farm.out.pitch[0][11] - farm.in.collectivePitch[11], output);
+
+    /*see that errors are returned */
+    err = ikFarm_getOutput(&farm, &output, NTURBINES, "thrust limiter>minimum pitch");
+    if (-3 != err) printf("%%TEST_FAILED%% time=0 testname=getOutput (ikFarm_test) message=getOutput expected to return -3, but returned %d\n", err);
+    err = ikFarm_getOutput(&farm, &output, 0, "thrust limiter");
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=getOutput (ikFarm_test) message=getOutput expected to return -1, but returned %d\n", err);
+    err = ikFarm_getOutput(&farm, &output, 0, "thrust limiter>nonsense");
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=getOutput (ikFarm_test) message=getOutput expected to return -1, but returned %d\n", err);
+    err = ikFarm_getOutput(&farm, &output, 0, "nonsense>minimum pitch");
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=getOutput (ikFarm_test) message=getOutput expected to return -2, but returned %d\n", err);
+
+    ikFarm_delete(&farm);
+}
+
+/**
+ * Test that init returns the proper errors when passed bad parameters.
+ */
+void testInitErrors() {
+    printf("ikFarm_test init_errors\n");
+    ikFarm farm;
+    ikFarmParams params;
+    ikFarm_initParams(&params);
+    initTurbineParams(&(params.turbine));
+
+    params.nTurbines = 0;
+    int err = ikFarm_init(&farm, &params);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=init_errors (ikFarm_test) message=init expected to return -1, but returned %d\n", err);
+    params.nTurbines = 1;
+    params.nThreads = 0;
+    err = ikFarm_init(&farm, &params);
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=init_errors (ikFarm_test) message=init expected to return -2, but returned %d\n", err);
+    params.nThreads = 1;
+    params.chunkSize = 0;
+    err = ikFarm_init(&farm, &params);
+    if (-3 != err) printf("%%TEST_FAILED%% time=0 testname=init_errors (ikFarm_test) message=init expected to return -3, but returned %d\n", err);
+}
+
+int main(int argc, char** argv) {
+    printf("%%SUITE_STARTING%% ikFarm_test\n");
+    printf("%%SUITE_STARTED%%\n");
+
+    if (ikTestUtil_writeSurfaces("ikFarm_test_cp.bin", "ikFarm_test_ct.bin")) printf("%%TEST_FAILED%% time=0 testname=surfaces (ikFarm_test) message=could not write surface files\n");
+
+    printf("%%TEST_STARTED%% determinism (ikFarm_test)\n");
+    testDeterminism();
+    printf("%%TEST_FINISHED%% time=0 determinism (ikFarm_test) \n");
+
+    printf("%%TEST_STARTED%% getOutput (ikFarm_test)\n");
+    testGetOutput();
+    printf("%%TEST_FINISHED%% time=0 getOutput (ikFarm_test) \n");
+
+    printf("%%TEST_STARTED%% init_errors (ikFarm_test)\n");
+    testInitErrors();
+    printf("%%TEST_FINISHED%% time=0 init_errors (ikFarm_test) \n");
+
+    remove("ikFarm_test_cp.bin");
+    remove("ikFarm_test_ct.bin");
+
+    printf("%%SUITE_FINISHED%% time=0\n");
+
+    return (EXIT_SUCCESS);
+}
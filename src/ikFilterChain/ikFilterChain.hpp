@@ -0,0 +1,469 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikFilterChain.hpp
+ * 
+ * @brief Class template ikFilterChain interface, C++17, header only
+ */
+
+#ifndef IKFILTERCHAIN_HPP
+#define IKFILTERCHAIN_HPP
+
+#include <cstddef>
+#include <tuple>
+
+namespace ik {
+
+    /**
+     * @struct Coeffs
+     * @brief Transfer function parameters
+     * 
+     * Parameters of a discrete-time transfer function, as in
+     * @link ikSlti_setParam @endlink.
+     */
+    struct Coeffs {
+        double a[3]; /**<denominator parameters, a[0] must be non-zero*/
+        double b[3]; /**<numerator parameters*/
+    };
+
+    /**
+     * Get the parameters of a notch filter
+     * 
+     * Computes the same parameters as @link ikVfnotch_init @endlink, so that
+     * fixed notch filters can be declared as constant expressions.
+     * 
+     * @param dT sampling time
+     * @param freq frequency, in rad/s
+     * @param dampDen denominator damping coefficient
+     * @param dampNum numerator damping coefficient
+     * @return transfer function parameters
+     */
+    constexpr Coeffs notchCoeffs(double dT, double freq, double dampDen, double dampNum) {
+        return Coeffs{
+            {4 + 4 * dampDen * dT * freq + dT * dT * freq*freq,
+             -8 + 2 * dT * dT * freq*freq,
+             4 - 4 * dampDen * dT * freq + dT * dT * freq*freq},
+            {4 + 4 * dampNum * dT * freq + dT * dT * freq*freq,
+             -8 + 2 * dT * dT * freq*freq,
+             4 - 4 * dampNum * dT * freq + dT * dT * freq*freq}
+        };
+    }
+
+    /* @cond */
+
+    /*parameters as used by the step method, as computed by ikSlti_setParam */
+    struct NormCoeffs {
+        double an1;
+        double an2;
+        double bn0;
+        double bn1;
+        double bn2;
+        double suma;
+        double sumb;
+    };
+
+    constexpr NormCoeffs normalise(const Coeffs &c) {
+        return NormCoeffs{
+            c.a[1] / c.a[0],
+            c.a[2] / c.a[0],
+            c.b[0] / c.a[0],
+            c.b[1] / c.a[0],
+            c.b[2] / c.a[0],
+            0.0 + c.a[0] + c.a[1] + c.a[2],
+            0.0 + c.b[0] + c.b[1] + c.b[2]
+        };
+    }
+
+    /* @endcond */
+
+    /**
+     * @class FixedCoeffs
+     * @brief Parameter policy for parameters known at compile time
+     * 
+     * The parameters are those of the constant expression C, and are
+     * normalised at compile time.
+     */
+    template<const Coeffs &C>
+    class FixedCoeffs {
+        static_assert(0.0 != C.a[0], "a[0] must be non-zero");
+    protected:
+        /* @cond */
+        static constexpr NormCoeffs n = normalise(C);
+        /* @endcond */
+    };
+
+    /**
+     * @class RuntimeCoeffs
+     * @brief Parameter policy for parameters set at run time
+     * 
+     * The parameters are a static gain of 1 until they are set.
+     */
+    class RuntimeCoeffs {
+    protected:
+        /* @cond */
+        NormCoeffs n = {0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 1.0};
+        /* @endcond */
+    };
+
+    /**
+     * @class Slti
+     * @brief Saturating linear time invariant system
+     * 
+     * Instances of this type compute the same outputs as
+     * @link ikSlti @endlink, bit for bit, including input and output
+     * saturation and the reset of the buffers when the output saturates.
+     * The parameters are given by the policy P, @link FixedCoeffs @endlink or
+     * @link RuntimeCoeffs @endlink. With FixedCoeffs, the step method
+     * uses the parameters as constants, so that the compiler can fold them.
+     * 
+     * The saturation event counters of @link ikSlti @endlink are not kept.
+     * 
+     * Bit for bit equality requires both implementations to be compiled
+     * without contraction of floating-point operations, e.g. with
+     * -ffp-contract=off on targets with fused multiply-add instructions.
+     * 
+     * @par Methods
+     * @li @link setParam @endlink set parameters, with RuntimeCoeffs only
+     * @li @link setInSat @endlink set input saturation
+     * @li @link setOutSat @endlink set output saturation
+     * @li @link step @endlink execute periodic calculations
+     * @li @link getOutput @endlink get output value
+     */
+    template<class P>
+    class Slti : public P {
+    public:
+
+        /**
+         * set LTI system parameter values, as in @link ikSlti_setParam @endlink
+         * 
+         * Only available with @link RuntimeCoeffs @endlink.
+         * 
+         * @param a array of length 3 with denominator parameters, where a[0] must be non-zero
+         * @param b array of length 3 with numerator parameters
+         * @return error code:
+         * @li 0: no error
+         * @li -1: invalid value at a[0], must be non-zero
+         */
+        int setParam(const double a[], const double b[]) {
+            if (0.0 == a[0]) return -1;
+            this->n = normalise(Coeffs{{a[0], a[1], a[2]}, {b[0], b[1], b[2]}});
+            resetState();
+            return 0;
+        }
+
+        /**
+         * set input saturation limits, as in @link ikSlti_setInSat @endlink
+         * 
+         * @param enable flag: 0 to disable, -1 for the lower limit only, 1 for
+         * the upper limit only, 2 for both
+         * @param min lower saturation limit
+         * @param max upper saturation limit
+         * @return error code:
+         * @li 0: no error
+         * @li -1: invalid enable flag value, must be -1, 0, 1 or 2
+         * @li -2: invalid saturation limits, upper limit must be larger than or equal to lower limit
+         */
+        int setInSat(int enable, double min, double max) {
+            if ((-1 > enable) || (2 < enable)) return -1;
+            if ((2 == enable) && (min > max)) return -2;
+            inSat = enable;
+            inMin = min;
+            inMax = max;
+            return 0;
+        }
+
+        /**
+         * set output saturation limits, as in @link ikSlti_setOutSat @endlink
+         * 
+         * @param enable flag: 0 to disable, -1 for the lower limit only, 1 for
+         * the upper limit only, 2 for both
+         * @param min lower saturation limit
+         * @param max upper saturation limit
+         * @return error code:
+         * @li 0: no error
+         * @li -1: invalid enable flag value, must be -1, 0, 1 or 2
+         * @li -2: invalid saturation limits, upper limit must be larger than or equal to lower limit
+         */
+        int setOutSat(int enable, double min, double max) {
+            if ((-1 > enable) || (2 < enable)) return -1;
+            if ((2 == enable) && (min > max)) return -2;
+            outSat = enable;
+            outMin = min;
+            outMax = max;
+            return 0;
+        }
+
+        /**
+         * advance one sample interval and calculate new output of LTI system
+         * 
+         * @param input new input value
+         * @return new output value
+         */
+        double step(double input) {
+            int sat = 0;
+            double x = input;
+            double y;
+
+            /*apply input saturation */
+            if ((-1 == inSat) || (2 == inSat)) {
+                if (inMin > x) x = inMin;
+            }
+            if ((1 == inSat) || (2 == inSat)) {
+                if (inMax < x) x = inMax;
+            }
+
+            /*compute new output value */
+            y = this->n.bn0 * x + state[0];
+
+            /*apply output saturation */
+            if ((-1 == outSat) || (2 == outSat)) {
+                if (outMin > y) {
+                    y = outMin;
+                    sat = 1;
+                }
+            }
+            if ((1 == outSat) || (2 == outSat)) {
+                if (outMax < y) {
+                    y = outMax;
+                    sat = 1;
+                }
+            }
+
+            /*register new input and output */
+            x1 = x0;
+            x0 = x;
+            y1 = y0;
+            y0 = y;
+
+            if (sat) {
+                /*reset the buffers and the state to the saturation limit */
+                y1 = y;
+                if (0.0 != this->n.sumb) {
+                    x0 = y / this->n.sumb * this->n.suma;
+                    x1 = x0;
+                }
+                resetState();
+            } else {
+                /*update state */
+                state[0] = this->n.bn1 * x - this->n.an1 * y + state[1];
+                state[1] = this->n.bn2 * x - this->n.an2 * y;
+            }
+
+            /*return new output */
+            return y;
+        }
+
+        /**
+         * get LTI system output
+         * 
+         * @return LTI system output
+         */
+        double getOutput() const {
+            return y0;
+        }
+
+    private:
+        /* @cond */
+        double x0 = 0.0; /*latest input */
+        double x1 = 0.0; /*previous input */
+        double y0 = 0.0; /*latest output */
+        double y1 = 0.0; /*previous output */
+        double state[2] = {0.0, 0.0}; /*transposed direct form II state */
+        int inSat = 0;
+        int outSat = 0;
+        double inMin = 0.0;
+        double inMax = 0.0;
+        double outMin = 0.0;
+        double outMax = 0.0;
+
+        /*compute the state from the buffers, as ikSlti does */
+        void resetState() {
+            state[0] = this->n.bn1 * x0 - this->n.an1 * y0 + this->n.bn2 * x1 - this->n.an2 * y1;
+            state[1] = this->n.bn2 * x0 - this->n.an2 * y0;
+        }
+        /* @endcond */
+    };
+
+    /**
+     * Transfer function with parameters set at run time
+     */
+    using Tf = Slti<RuntimeCoeffs>;
+
+    /**
+     * Transfer function with the parameters of the constant expression C
+     */
+    template<const Coeffs &C>
+    using FixedTf = Slti<FixedCoeffs<C> >;
+
+    /**
+     * @class Notch
+     * @brief Variable frequency notch filter
+     * 
+     * Instances of this type compute the same outputs as
+     * @link ikVfnotch @endlink, bit for bit. For a notch filter of fixed
+     * frequency, use a @link FixedTf @endlink with the parameters given by
+     * @link notchCoeffs @endlink instead.
+     * 
+     * @par Methods
+     * @li @link init @endlink initialise an instance
+     * @li @link setFreq @endlink set frequency
+     * @li @link getFreq @endlink get frequency
+     */
+    class Notch : public Tf {
+    public:
+
+        /**
+         * Initialise instance, as in @link ikVfnotch_init @endlink
+         * 
+         * @param dT sampling time
+         * @param freq frequency, in rad/s
+         * @param dampDen denominator damping coefficient
+         * @param dampNum numerator damping coefficient
+         * @return error code:
+         * @li 0: no error
+         * @li -1: invalid sampling time, must be positive
+         * @li -2: invalid frequency, must be positive
+         */
+        int init(double dT, double freq, double dampDen, double dampNum) {
+            if (0 >= dT) return -1;
+            if (0 >= freq) return -2;
+            *this = Notch();
+            this->dT = dT;
+            this->dampDen = dampDen;
+            this->dampNum = dampNum;
+            return setFreq(freq);
+        }
+
+        /**
+         * set frequency, as in @link ikVfnotch_setFreq @endlink
+         * 
+         * @param freq frequency, in rad/s
+         * @return error code:
+         * @li 0: no error
+         * @li -2: invalid frequency, must be positive
+         */
+        int setFreq(double freq) {
+            if (0 >= freq) return -2;
+            Coeffs c = notchCoeffs(dT, freq, dampDen, dampNum);
+            setParam(c.a, c.b);
+            this->freq = freq;
+            return 0;
+        }
+
+        /**
+         * get frequency
+         * 
+         * @return frequency, in rad/s
+         */
+        double getFreq() const {
+            return freq;
+        }
+
+    private:
+        /* @cond */
+        double dT = 1.0;
+        double freq = 1.0;
+        double dampDen = 0.0;
+        double dampNum = 0.0;
+        /* @endcond */
+    };
+
+    /**
+     * @class Chain
+     * @brief Filter chain of fixed topology
+     * 
+     * Instances of this type apply a fixed series of stages, such as
+     * @link Tf @endlink, @link FixedTf @endlink, @link Notch @endlink or
+     * another Chain, to a signal. The stages are members of the instance,
+     * so that the compiler can inline the whole chain into its step method,
+     * with no loop and no indirection.
+     * 
+     * The stages are applied from the first to the last. An
+     * @link ikTfList @endlink or @link ikNotchList @endlink applies its
+     * enabled filters from the last to the first, so the equivalent chain
+     * lists them in reverse order, and leaves the disabled ones out.
+     * 
+     * @par Methods
+     * @li @link get @endlink get a stage
+     * @li @link step @endlink execute periodic calculations
+     * @li @link getOutput @endlink get output value
+     */
+    template<class... Stages>
+    class Chain {
+        static_assert(0 < sizeof...(Stages), "a chain must have at least one stage");
+    public:
+
+        /**
+         * number of stages
+         */
+        static constexpr std::size_t size = sizeof...(Stages);
+
+        /**
+         * get a stage
+         * 
+         * @return I-th stage, starting at 0
+         */
+        template<std::size_t I>
+        auto &get() {
+            return std::get<I>(stages);
+        }
+
+        /**
+         * get a stage
+         * 
+         * @return I-th stage, starting at 0
+         */
+        template<std::size_t I>
+        const auto &get() const {
+            return std::get<I>(stages);
+        }
+
+        /**
+         * advance one sample interval and calculate new output of the chain
+         * 
+         * @param input new input value
+         * @return new output value
+         */
+        double step(double input) {
+            return std::apply([input](Stages &... s) {
+                double output = input;
+                ((output = s.step(output)), ...);
+                return output;
+            }, stages);
+        }
+
+        /**
+         * get chain output
+         * 
+         * @return output of the last stage
+         */
+        double getOutput() const {
+            return std::get<sizeof...(Stages) - 1>(stages).getOutput();
+        }
+
+    private:
+        /* @cond */
+        std::tuple<Stages...> stages;
+        /* @endcond */
+    };
+
+}
+
+#endif /* IKFILTERCHAIN_HPP */
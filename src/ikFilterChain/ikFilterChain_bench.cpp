@@ -0,0 +1,191 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikFilterChain_bench.cpp
+ * 
+ * @brief Class template ikFilterChain benchmark
+ * 
+ * Runs the same cascade of two transfer functions and two notch filters as:
+ * @li C lists: an @link ikTfList @endlink and an @link ikNotchList @endlink
+ * @li C sized lists: an @link ikTfListN @endlink and an @link ikNotchListN @endlink, with buffers of 2 filters each
+ * @li C slti: four @link ikSlti @endlink instances, called one after the other
+ * @li C++ run-time: an ik::Chain of ik::Tf, with the parameters set at run time
+ * @li C++ fixed: an ik::Chain of ik::FixedTf, with the parameters fixed at compile time
+ * 
+ * Each sample times a block of steps with @link ikBench @endlink, and the
+ * minimum and median times per step are reported, in the unit given by
+ * @link ikBench_getUnit @endlink, together with the speedup of the median with
+ * respect to the C lists. The outputs of every implementation are checked
+ * to be bit for bit equal to those of the C lists, on the last block.
+ * 
+ * Usage: ikFilterChain_bench [steps per sample [samples]]
+ * 
+ * The defaults are 100 steps per sample and 10000 samples.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "ikFilterChain.hpp"
+#include "ikBench.h"
+#include "ikSlti.h"
+#include "ikTfList.h"
+#include "ikNotchList.h"
+
+/* cascade parameters */
+constexpr double dT = 0.01;
+constexpr ik::Coeffs lowPass = {{1.0, -1.6, 0.64}, {0.01, 0.02, 0.01}};
+constexpr ik::Coeffs lead = {{1.0, -0.5, 0.0}, {2.0, -1.5, 0.0}};
+constexpr ik::Coeffs notch1 = ik::notchCoeffs(dT, 20.0, 0.5, 0.05);
+constexpr ik::Coeffs notch2 = ik::notchCoeffs(dT, 35.0, 0.3, 0.02);
+
+/*
+ * Time the steps of an implementation, with step(k, input) taking the k-th step
+ */
+template<class F>
+void run(const char *name, ikBench *bench, int nSteps, int nSamples, const double inputs[], double outputs[], const double reference[], double *median1, F step) {
+    double min;
+    double median;
+    int equal = 1;
+    int i;
+    int k;
+
+    ikBench_reset(bench);
+    for (i = 0; i < nSamples; i++) {
+        ikBench_start(bench);
+        for (k = 0; k < nSteps; k++) outputs[k] = step(inputs[k]);
+        ikBench_stop(bench);
+    }
+    if (NULL != reference) {
+        for (k = 0; k < nSteps; k++) if (reference[k] != outputs[k]) equal = 0;
+    }
+    ikBench_summarise(bench);
+    ikBench_getOutput(bench, &min, "min");
+    ikBench_getOutput(bench, &median, "median");
+    if (NULL == reference) *median1 = median;
+
+    printf("%-14s %12.2f %12.2f %8.2f %6s\n", name, min / nSteps, median / nSteps, *median1 / median, equal ? "yes" : "NO");
+}
+
+int main(int argc, char** argv) {
+    int nSteps = argc > 1 ? atoi(argv[1]) : 100;
+    int nSamples = argc > 2 ? atoi(argv[2]) : 10000;
+    ikBench bench;
+    ikBenchParams benchParams;
+    ikTfList tfList;
+    ikTfListParams tfListParams;
+    ikNotchList notchList;
+    ikNotchListParams notchListParams;
+    ikTfListN sizedTfList;
+    ikTfListItem tfBuffer[2];
+    ikNotchListN sizedNotchList;
+    ikNotchListItem notchBuffer[2];
+    ikSlti slti[4];
+    ik::Chain<ik::Tf, ik::Tf, ik::Tf, ik::Tf> runtimeChain;
+    ik::Chain<ik::FixedTf<lead>, ik::FixedTf<lowPass>, ik::FixedTf<notch2>, ik::FixedTf<notch1> > fixedChain;
+    const ik::Coeffs *coeffs[4] = {&lead, &lowPass, &notch2, &notch1};
+    double *inputs;
+    double *outputs;
+    double *reference;
+    double median1 = 0.0;
+    int i;
+    int k;
+
+    if ((0 >= nSteps) || (0 >= nSamples)) {
+        printf("invalid arguments\n");
+        return (EXIT_FAILURE);
+    }
+
+    /* inputs, precomputed so that they do not add to the times */
+    inputs = (double *) malloc(sizeof(double) * nSteps);
+    outputs = (double *) malloc(sizeof(double) * nSteps);
+    reference = (double *) malloc(sizeof(double) * nSteps);
+    if ((NULL == inputs) || (NULL == outputs) || (NULL == reference)) return (EXIT_FAILURE);
+    for (k = 0; k < nSteps; k++) inputs[k] = sin(0.05 * k) + 0.3 * sin(1.3 * k);
+
+    /* C lists, with the filters at the end, so that they are applied first */
+    ikTfList_initParams(&tfListParams);
+    for (i = 0; i < 3; i++) {
+        tfListParams.tfParams[IKTFLIST_NMAX - 1].a[i] = lead.a[i];
+        tfListParams.tfParams[IKTFLIST_NMAX - 1].b[i] = lead.b[i];
+        tfListParams.tfParams[IKTFLIST_NMAX - 2].a[i] = lowPass.a[i];
+        tfListParams.tfParams[IKTFLIST_NMAX - 2].b[i] = lowPass.b[i];
+    }
+    tfListParams.tfParams[IKTFLIST_NMAX - 1].enable = 1;
+    tfListParams.tfParams[IKTFLIST_NMAX - 2].enable = 1;
+    ikTfList_init(&tfList, &tfListParams);
+    ikNotchList_initParams(&notchListParams);
+    notchListParams.dT = dT;
+    notchListParams.notchParams[IKNOTCHLIST_NMAX - 1].enable = 1;
+    notchListParams.notchParams[IKNOTCHLIST_NMAX - 1].freq = 35.0;
+    notchListParams.notchParams[IKNOTCHLIST_NMAX - 1].dampDen = 0.3;
+    notchListParams.notchParams[IKNOTCHLIST_NMAX - 1].dampNum = 0.02;
+    notchListParams.notchParams[IKNOTCHLIST_NMAX - 2].enable = 1;
+    notchListParams.notchParams[IKNOTCHLIST_NMAX - 2].freq = 20.0;
+    notchListParams.notchParams[IKNOTCHLIST_NMAX - 2].dampDen = 0.5;
+    notchListParams.notchParams[IKNOTCHLIST_NMAX - 2].dampNum = 0.05;
+    ikNotchList_init(&notchList, &notchListParams);
+
+    /* C sized lists, with the same filters */
+    ikTfListN_init(&sizedTfList, 2, tfListParams.tfParams + IKTFLIST_NMAX - 2, tfBuffer);
+    ikNotchListN_init(&sizedNotchList, dT, 2, notchListParams.notchParams + IKNOTCHLIST_NMAX - 2, notchBuffer);
+
+    /* C slti instances and C++ run-time chain */
+    for (i = 0; i < 4; i++) {
+        ikSlti_init(&(slti[i]));
+        ikSlti_setParam(&(slti[i]), coeffs[i]->a, coeffs[i]->b);
+    }
+    runtimeChain.get<0>().setParam(lead.a, lead.b);
+    runtimeChain.get<1>().setParam(lowPass.a, lowPass.b);
+    runtimeChain.get<2>().setParam(notch2.a, notch2.b);
+    runtimeChain.get<3>().setParam(notch1.a, notch1.b);
+
+    ikBench_initParams(&benchParams);
+    benchParams.maxSamples = nSamples;
+    if (ikBench_init(&bench, &benchParams)) return (EXIT_FAILURE);
+
+    printf("steps/sample=%d samples=%d unit=%s\n", nSteps, nSamples, ikBench_getUnit());
+    printf("%-14s %12s %12s %8s %6s\n", "implementation", "min/step", "median/step", "speedup", "equal");
+
+    /* each implementation runs through the same blocks of inputs, from the
+     same state, so the outputs of the last block are compared */
+    run("C lists", &bench, nSteps, nSamples, inputs, reference, NULL, &median1, [&](double x) {
+        return ikNotchList_step(&notchList, ikTfList_step(&tfList, x));
+    });
+    run("C sized lists", &bench, nSteps, nSamples, inputs, outputs, reference, &median1, [&](double x) {
+        return ikNotchListN_step(&sizedNotchList, ikTfListN_step(&sizedTfList, x));
+    });
+    run("C slti", &bench, nSteps, nSamples, inputs, outputs, reference, &median1, [&](double x) {
+        for (int j = 0; j < 4; j++) x = ikSlti_step(&(slti[j]), x);
+        return x;
+    });
+    run("C++ run-time", &bench, nSteps, nSamples, inputs, outputs, reference, &median1, [&](double x) {
+        return runtimeChain.step(x);
+    });
+    run("C++ fixed", &bench, nSteps, nSamples, inputs, outputs, reference, &median1, [&](double x) {
+        return fixedChain.step(x);
+    });
+
+    ikBench_delete(&bench);
+    free(inputs);
+    free(outputs);
+    free(reference);
+    return (EXIT_SUCCESS);
+}
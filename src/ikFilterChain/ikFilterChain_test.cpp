@@ -0,0 +1,261 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikFilterChain_test.cpp
+ * 
+ * @brief Class template ikFilterChain unit tests
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../ikFilterChain/ikFilterChain.hpp"
+#include "../ikSlti/ikSlti.h"
+#include "../ikVfnotch/ikVfnotch.h"
+#include "../ikTfList/ikTfList.h"
+#include "../ikNotchList/ikNotchList.h"
+
+/*
+ * Simple C Test Suite
+ */
+
+/* transfer function parameters for the tests */
+constexpr ik::Coeffs lowPass = {{1.0, -1.6, 0.64}, {0.01, 0.02, 0.01}};
+constexpr ik::Coeffs lead = {{1.0, -0.5, 0.0}, {2.0, -1.5, 0.0}};
+constexpr ik::Coeffs derivative = {{2.0, 0.0, 0.0}, {1.0, -1.0, 0.0}};
+constexpr ik::Coeffs notch = ik::notchCoeffs(0.01, 20.0, 0.5, 0.05);
+
+/* see that the parameters are computed at compile time */
+static_assert(notch.a[0] > notch.b[0], "notch parameters not computed at compile time");
+
+/*
+ * Input signal, with steps large enough to saturate the filters
+ */
+double input(int k) {
+    return 3.0 * sin(0.05 * k) + sin(1.3 * k + 0.2) + ((k / 300) % 2 ? 4.0 : -4.0);
+}
+
+/**
+ * Run fixed and run-time parameter transfer functions with saturation next to
+ * ikSlti instances and see that the outputs are equal, bit for bit.
+ */
+void testTf() {
+    printf("ikFilterChain_test testTf\n");
+    ikSlti sltiLowPass;
+    ikSlti sltiDerivative;
+    ik::FixedTf<lowPass> tfLowPass;
+    ik::Tf tfDerivative;
+    double expected;
+    double output;
+    int k;
+
+    /* low pass with input and output saturation */
+    ikSlti_init(&sltiLowPass);
+    ikSlti_setParam(&sltiLowPass, lowPass.a, lowPass.b);
+    ikSlti_setInSat(&sltiLowPass, -1, -3.0, 0.0);
+    ikSlti_setOutSat(&sltiLowPass, 2, -2.0, 2.5);
+    tfLowPass.setInSat(-1, -3.0, 0.0);
+    tfLowPass.setOutSat(2, -2.0, 2.5);
+
+    /* derivative, with zero static gain, and upper output saturation */
+    ikSlti_init(&sltiDerivative);
+    ikSlti_setParam(&sltiDerivative, derivative.a, derivative.b);
+    ikSlti_setOutSat(&sltiDerivative, 1, 0.0, 1.0);
+    tfDerivative.setParam(derivative.a, derivative.b);
+    tfDerivative.setOutSat(1, 0.0, 1.0);
+
+    for (k = 0; k < 2000; k++) {
+        expected = ikSlti_step(&sltiLowPass, input(k));
+        output = tfLowPass.step(input(k));
+        if ((expected != output) || (tfLowPass.getOutput() != output)) {
+            printf("%%TEST_FAILED%% time=0 testname=testTf (ikFilterChain_test) message=low pass output expected to be %.17g at step %d, but it is %.17g\n", expected, k, output);
+            break;
+        }
+    }
+    for (k = 0; k < 2000; k++) {
+        /* change the parameters as the filter runs */
+        if (1000 == k) {
+            ikSlti_setParam(&sltiDerivative, lead.a, lead.b);
+            tfDerivative.setParam(lead.a, lead.b);
+        }
+        expected = ikSlti_step(&sltiDerivative, input(k));
+        output = tfDerivative.step(input(k));
+        if (expected != output) {
+            printf("%%TEST_FAILED%% time=0 testname=testTf (ikFilterChain_test) message=run-time parameter output expected to be %.17g at step %d, but it is %.17g\n", expected, k, output);
+            break;
+        }
+    }
+}
+
+/**
+ * Run a notch filter with variable frequency next to an ikVfnotch instance
+ * and see that the outputs are equal, bit for bit.
+ */
+void testNotch() {
+    printf("ikFilterChain_test testNotch\n");
+    ikVfnotch vfnotch;
+    ik::Notch notch_;
+    double expected;
+    double output;
+    double freq;
+    int k;
+
+    ikVfnotch_init(&vfnotch, 0.01, 10.0, 0.5, 0.05);
+    notch_.init(0.01, 10.0, 0.5, 0.05);
+    for (k = 0; k < 2000; k++) {
+        freq = 15.0 + 5.0 * sin(0.01 * k);
+        ikVfnotch_setFreq(&vfnotch, freq);
+        notch_.setFreq(freq);
+        expected = ikVfnotch_step(&vfnotch, input(k));
+        output = notch_.step(input(k));
+        if (expected != output) {
+            printf("%%TEST_FAILED%% time=0 testname=testNotch (ikFilterChain_test) message=output expected to be %.17g at step %d, but it is %.17g\n", expected, k, output);
+            break;
+        }
+    }
+    if (freq != notch_.getFreq()) printf("%%TEST_FAILED%% time=0 testname=testNotch (ikFilterChain_test) message=frequency expected to be %f, but it is %f\n", freq, notch_.getFreq());
+}
+
+/**
+ * Run a chain next to the equivalent transfer function and notch filter lists
+ * and see that the outputs are equal, bit for bit.
+ */
+void testChain() {
+    printf("ikFilterChain_test testChain\n");
+    ikTfList tfList;
+    ikTfListParams tfListParams;
+    ikNotchList notchList;
+    ikNotchListParams notchListParams;
+    ik::Chain<ik::FixedTf<lead>, ik::FixedTf<lowPass>, ik::Notch, ik::FixedTf<notch> > chain;
+    ik::Chain<ik::Chain<ik::FixedTf<lead>, ik::FixedTf<lowPass> >, ik::Chain<ik::Notch, ik::FixedTf<notch> > > nested;
+    double minInput = -1.0;
+    double maxOutput = 2.0;
+    double freq = 10.0;
+    double expected;
+    double output;
+    int k;
+    int i;
+
+    /* transfer function list, with one disabled transfer function */
+    ikTfList_initParams(&tfListParams);
+    for (i = 0; i < 3; i++) {
+        tfListParams.tfParams[0].a[i] = lowPass.a[i];
+        tfListParams.tfParams[0].b[i] = lowPass.b[i];
+        tfListParams.tfParams[1].a[i] = derivative.a[i];
+        tfListParams.tfParams[1].b[i] = derivative.b[i];
+        tfListParams.tfParams[3].a[i] = lead.a[i];
+        tfListParams.tfParams[3].b[i] = lead.b[i];
+    }
+    tfListParams.tfParams[0].enable = 1;
+    tfListParams.tfParams[0].maxOutput = &maxOutput;
+    tfListParams.tfParams[3].enable = 1;
+    tfListParams.tfParams[3].minInput = &minInput;
+    ikTfList_init(&tfList, &tfListParams);
+
+    /* notch filter list, with one variable frequency notch filter */
+    ikNotchList_initParams(&notchListParams);
+    notchListParams.dT = 0.01;
+    notchListParams.notchParams[0].enable = 1;
+    notchListParams.notchParams[0].freq = 20.0;
+    notchListParams.notchParams[0].dampDen = 0.5;
+    notchListParams.notchParams[0].dampNum = 0.05;
+    notchListParams.notchParams[2].enable = 1;
+    notchListParams.notchParams[2].variableFreq = &freq;
+    notchListParams.notchParams[2].dampDen = 0.7;
+    notchListParams.notchParams[2].dampNum = 0.1;
+    ikNotchList_init(&notchList, &notchListParams);
+
+    /* equivalent chains, in reverse order */
+    chain.get<0>().setInSat(-1, minInput, 0.0);
+    chain.get<1>().setOutSat(1, 0.0, maxOutput);
+    chain.get<2>().init(0.01, freq, 0.7, 0.1);
+    nested.get<0>().get<0>().setInSat(-1, minInput, 0.0);
+    nested.get<0>().get<1>().setOutSat(1, 0.0, maxOutput);
+    nested.get<1>().get<0>().init(0.01, freq, 0.7, 0.1);
+
+    for (k = 0; k < 2000; k++) {
+        freq = 15.0 + 5.0 * sin(0.01 * k);
+        chain.get<2>().setFreq(freq);
+        nested.get<1>().get<0>().setFreq(freq);
+        expected = ikNotchList_step(&notchList, ikTfList_step(&tfList, input(k)));
+        output = chain.step(input(k));
+        if ((expected != output) || (chain.getOutput() != output)) {
+            printf("%%TEST_FAILED%% time=0 testname=testChain (ikFilterChain_test) message=output expected to be %.17g at step %d, but it is %.17g\n", expected, k, output);
+            break;
+        }
+        output = nested.step(input(k));
+        if (expected != output) {
+            printf("%%TEST_FAILED%% time=0 testname=testChain (ikFilterChain_test) message=nested chain output expected to be %.17g at step %d, but it is %.17g\n", expected, k, output);
+            break;
+        }
+    }
+}
+
+/**
+ * Pass bad arguments and see that the right error codes are returned.
+ */
+void testErrors() {
+    printf("ikFilterChain_test testErrors\n");
+    ik::Tf tf;
+    ik::Notch notch_;
+    double a[3] = {0.0, 1.0, 0.0};
+    double b[3] = {1.0, 0.0, 0.0};
+    int err;
+
+    err = tf.setParam(a, b);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testErrors (ikFilterChain_test) message=setParam expected to return -1, but it returned %d\n", err);
+    err = tf.setInSat(3, 0.0, 1.0);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testErrors (ikFilterChain_test) message=setInSat expected to return -1, but it returned %d\n", err);
+    err = tf.setOutSat(2, 1.0, 0.0);
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=testErrors (ikFilterChain_test) message=setOutSat expected to return -2, but it returned %d\n", err);
+    if (2.0 != tf.step(2.0)) printf("%%TEST_FAILED%% time=0 testname=testErrors (ikFilterChain_test) message=expected a static gain of 1\n");
+    err = notch_.init(0.0, 1.0, 0.5, 0.0);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testErrors (ikFilterChain_test) message=init expected to return -1, but it returned %d\n", err);
+    err = notch_.init(0.01, -1.0, 0.5, 0.0);
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=testErrors (ikFilterChain_test) message=init expected to return -2, but it returned %d\n", err);
+    notch_.init(0.01, 1.0, 0.5, 0.0);
+    err = notch_.setFreq(0.0);
+    if ((-2 != err) || (1.0 != notch_.getFreq())) printf("%%TEST_FAILED%% time=0 testname=testErrors (ikFilterChain_test) message=setFreq expected to return -2 and keep the frequency, but it returned %d\n", err);
+}
+
+int main(int argc, char** argv) {
+    printf("%%SUITE_STARTING%% ikFilterChain_test\n");
+    printf("%%SUITE_STARTED%%\n");
+
+    printf("%%TEST_STARTED%% testTf (ikFilterChain_test)\n");
+    testTf();
+    printf("%%TEST_FINISHED%% time=0 testTf (ikFilterChain_test) \n");
+
+    printf("%%TEST_STARTED%% testNotch (ikFilterChain_test)\n");
+    testNotch();
+    printf("%%TEST_FINISHED%% time=0 testNotch (ikFilterChain_test) \n");
+
+    printf("%%TEST_STARTED%% testChain (ikFilterChain_test)\n");
+    testChain();
+    printf("%%TEST_FINISHED%% time=0 testChain (ikFilterChain_test) \n");
+
+    printf("%%TEST_STARTED%% testErrors (ikFilterChain_test)\n");
+    testErrors();
+    printf("%%TEST_FINISHED%% time=0 testErrors (ikFilterChain_test) \n");
+
+    printf("%%SUITE_FINISHED%% time=0\n");
+
+    return (EXIT_SUCCESS);
+}
@@ -18,6 +18,7 @@ along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
  */
 
 #include <math.h>
+#include <stdlib.h>
 #include <string.h>
 #include "ikIpc.h"
 
@@ -30,13 +31,28 @@ along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
 /* @cond */
 
 int ikIpc_init(ikIpc *self, const ikIpcParams *params) {
+    return ikIpc_initBuffer(self, params, NULL, 0);
+}
+
+int ikIpc_initBuffer(ikIpc *self, const ikIpcParams *params, void *buffer, size_t bufferSize) {
     int i, j;
     int err;
     int err_ = 0;
+    double weightSum;
+    ikIpcHarmonic *harmonic;
+    
+    /* register the number of blades */
+    self->priv.nBlades = params->nBlades;
+    if ((2 > self->priv.nBlades) || (IKIPC_MAXBLADES < self->priv.nBlades)) {
+        self->priv.nBlades = 3;
+        err_ = -7;
+    }
     
-    /* Initialise inputs */
+    /* Initialise inputs and outputs */
     self->in.azimuth = 0.0;
-    for (i = 0; i < 3; i++) {
+    for (i = 0; i < IKIPC_MAXBLADES; i++) {
+        self->out.pitch[i] = 0.0;
+        self->priv.pitchDifferentials[i] = 0.0;
         for (j = 0; j < 3; j++) {
             self->in.bladeRootMoments[i].c[j] = 0.0;
         }
@@ -49,10 +65,16 @@ int ikIpc_init(ikIpc *self, const ikIpcParams *params) {
     self->in.maximumIndividualPitch = 0.0;
     self->in.maximumPitch = 0.0;
     self->in.minimumPitch = 0.0;
+    for (i = 0; i < IKIPC_MAXPREVIEW; i++) {
+        self->in.previewMy[i] = 0.0;
+        self->in.previewMz[i] = 0.0;
+    }
     
     /* Calculate azimuth offsets */
-    for (i = 0; i < 3; i++) {
-        self->priv.azimuthOffsets[i] = params->azimuthOffset/180.0*3.14159265358979 + params->bladeOrder * i * 2.0/3.0*3.14159265358979;
+    for (i = 0; i < self->priv.nBlades; i++) {
+        self->priv.azimuthOffsets[i] = params->azimuthOffset/180.0*3.14159265358979 + params->bladeOrder * i * 2.0/self->priv.nBlades*3.14159265358979;
+        self->priv.offsetCos[i] = cos(self->priv.azimuthOffsets[i]);
+        self->priv.offsetSin[i] = sin(self->priv.azimuthOffsets[i]);
     }
     
     /* Initialise control loops */
@@ -61,41 +83,154 @@ int ikIpc_init(ikIpc *self, const ikIpcParams *params) {
     
     err = ikConLoop_init(&(self->priv.conMz), &(params->controlMz));
     if (err && !err_) err_ = -2;
+    self->priv.pitchYcon = 0.0;
+    self->priv.pitchZcon = 0.0;
+    
+    /* Initialise higher harmonic control loops */
+    self->priv.nHarmonics = params->nHarmonics;
+    if ((0 > self->priv.nHarmonics) || (0 < self->priv.nHarmonics && NULL == params->harmonics)) {
+        self->priv.nHarmonics = 0;
+        if (!err_) err_ = -3;
+    }
+    if (ikIpc_getBufferSize(params) > bufferSize) {
+        self->priv.nHarmonics = 0;
+        if (!err_) err_ = -6;
+    }
+    self->priv.harmonics = (ikIpcHarmonic *) buffer;
+    self->priv.maxOrder = 1;
+    for (i = 0; i < self->priv.nHarmonics; i++) {
+        harmonic = &(self->priv.harmonics[i]);
+        harmonic->order = params->harmonics[i].order;
+        if ((2 > harmonic->order) || (IKIPC_MAXORDER < harmonic->order)) {
+            harmonic->order = 2;
+            if (!err_) err_ = -4;
+        }
+        if (self->priv.maxOrder < harmonic->order) self->priv.maxOrder = harmonic->order;
+        
+        err = ikConLoop_init(&(harmonic->conMy), &(params->harmonics[i].controlMy));
+        if (err && !err_) err_ = -5;
+        
+        err = ikConLoop_init(&(harmonic->conMz), &(params->harmonics[i].controlMz));
+        if (err && !err_) err_ = -5;
+        
+        harmonic->My = 0.0;
+        harmonic->Mz = 0.0;
+        harmonic->pitchYcon = 0.0;
+        harmonic->pitchZcon = 0.0;
+        harmonic->maxPitchIncrementMod = 0.0;
+        harmonic->maxPitchZ = 0.0;
+        harmonic->maxPitchY = 0.0;
+    }
+    
+    /* Calculate the preview feedforward taps, as the products of the */
+    /* normalised weights and the gains */
+    self->priv.previewHorizon = params->previewHorizon;
+    if ((0 > self->priv.previewHorizon) || (IKIPC_MAXPREVIEW < self->priv.previewHorizon)) {
+        self->priv.previewHorizon = 0;
+        if (!err_) err_ = -8;
+    }
+    weightSum = 0.0;
+    for (i = 0; i < self->priv.previewHorizon; i++) weightSum += params->previewWeights[i];
+    if ((0 < self->priv.previewHorizon) && (0.0 == weightSum)) {
+        self->priv.previewHorizon = 0;
+        if (!err_) err_ = -9;
+    }
+    for (i = 0; i < IKIPC_MAXPREVIEW; i++) {
+        self->priv.previewTapsMy[i] = 0.0;
+        self->priv.previewTapsMz[i] = 0.0;
+    }
+    for (i = 0; i < self->priv.previewHorizon; i++) {
+        self->priv.previewTapsMy[i] = params->feedforwardGainMy * params->previewWeights[i] / weightSum;
+        self->priv.previewTapsMz[i] = params->feedforwardGainMz * params->previewWeights[i] / weightSum;
+    }
+    self->priv.feedforwardPitchY = 0.0;
+    self->priv.feedforwardPitchZ = 0.0;
+#ifdef IKPROFILE
+    ikProfile_init(&(self->priv.profile));
+#endif
     
     return err_;
 }
 
 void ikIpc_initParams(ikIpcParams *params) {
+    int i;
     
     /* set defaults */
     params->azimuthOffset = 0.0;
+    params->nBlades = 3;
     params->bladeOrder = 1;
+    params->nHarmonics = 0;
+    params->harmonics = NULL;
+    params->previewHorizon = 0;
+    params->feedforwardGainMy = 0.0;
+    params->feedforwardGainMz = 0.0;
+    for (i = 0; i < IKIPC_MAXPREVIEW; i++) params->previewWeights[i] = 1.0;
     
     /* initialise member parameters */
     ikConLoop_initParams(&(params->controlMy));
     ikConLoop_initParams(&(params->controlMz));
 }
 
+void ikIpc_initHarmonicParams(ikIpcHarmonicParams *params) {
+    
+    /* set defaults */
+    params->order = 2;
+    
+    /* initialise member parameters */
+    ikConLoop_initParams(&(params->controlMy));
+    ikConLoop_initParams(&(params->controlMz));
+}
+
+size_t ikIpc_getBufferSize(const ikIpcParams *params) {
+    if (0 >= params->nHarmonics) return 0;
+    return sizeof(ikIpcHarmonic) * (size_t) params->nHarmonics;
+}
+
 void ikIpc_step(ikIpc *self) {
-    int i;
-    ikVector rotations[3];
-    ikVector pitchAxes[3];
+    const int nBlades = self->priv.nBlades;
+    int i, k, n;
+    double azimuth, c, s;
+    double cosines[IKIPC_MAXORDER][IKIPC_MAXBLADES], sines[IKIPC_MAXORDER][IKIPC_MAXBLADES];
+    const ikVector *moment;
     double pitchMarginUp, pitchMarginDown;
+    double module, norm;
+    double margin;
+    ikIpcHarmonic *harmonic;
+#ifdef IKPROFILE
+    ikProfile_start(&(self->priv.profile));
+#endif
+    
+    /* Calculate the cosine and sine of the azimuth of each blade, from those */
+    /* of the rotor azimuth and of the blade azimuth offsets, by angle addition. */
+    /* The azimuth is wrapped in degrees, exactly, so that full revolutions */
+    /* leave no rounding errors. */
+    azimuth = fmod(self->in.azimuth, 360.0)/180.0*3.14159265358979;
+    c = cos(azimuth);
+    s = sin(azimuth);
+    for (i = 0; i < nBlades; i++) {
+        cosines[0][i] = c*self->priv.offsetCos[i] - s*self->priv.offsetSin[i];
+        sines[0][i] = s*self->priv.offsetCos[i] + c*self->priv.offsetSin[i];
+    }
+    
+    /* Calculate those of the multiples of the blade azimuths needed by the */
+    /* higher harmonic control loops, by recurrence */
+    for (n = 1; n < self->priv.maxOrder; n++) {
+        for (i = 0; i < nBlades; i++) {
+            cosines[n][i] = 2.0*cosines[0][i]*cosines[n-1][i] - (1 < n ? cosines[n-2][i] : 1.0);
+            sines[n][i] = 2.0*cosines[0][i]*sines[n-1][i] - (1 < n ? sines[n-2][i] : 0.0);
+        }
+    }
     
-    /* Transform rotating frame blade root moments to non-rotating frame and add them up */
-    /* Also transform the rotating frame z axes to non-rotating frame*/
+    /* Transform rotating frame blade root moments to non-rotating frame, */
+    /* rotating them around x, and add them up */
     for (i = 0; i < 3; i++) {
         self->priv.staticMoment.c[i] = 0.0;
     }
-    for (i = 0; i < 3; i++) {
-        rotations[i].c[0] = fmod(self->in.azimuth/180.0*3.14159265358979 + self->priv.azimuthOffsets[i], 2.0*3.14159265358979);
-        rotations[i].c[1] = 0.0;
-        rotations[i].c[2] = 0.0;
-        self->priv.staticMoment = ikVector_add( self->priv.staticMoment, ikVector_rotate(self->in.bladeRootMoments[i], rotations[i]) );
-        pitchAxes[i].c[0] = 0.0;
-        pitchAxes[i].c[1] = 0.0;
-        pitchAxes[i].c[2] = 1.0;
-        pitchAxes[i] = ikVector_rotate(pitchAxes[i], rotations[i]);
+    for (i = 0; i < nBlades; i++) {
+        moment = &(self->in.bladeRootMoments[i]);
+        self->priv.staticMoment.c[0] += moment->c[0];
+        self->priv.staticMoment.c[1] += cosines[0][i]*moment->c[1] - sines[0][i]*moment->c[2];
+        self->priv.staticMoment.c[2] += cosines[0][i]*moment->c[2] + sines[0][i]*moment->c[1];
     }
     
     /* calculate maximum pitch increment module */
@@ -105,9 +240,29 @@ void ikIpc_step(ikIpc *self) {
     pitchMarginDown = pitchMarginDown < 0.0 ? pitchMarginDown : 0.0;
     self->priv.maxPitchIncrementMod = fabs(pitchMarginUp) < fabs(pitchMarginDown) ? fabs(pitchMarginUp) : fabs(pitchMarginDown);
     self->priv.maxPitchIncrementMod = self->priv.maxPitchIncrementMod < self->in.maximumIndividualPitch ? self->priv.maxPitchIncrementMod : self->in.maximumIndividualPitch;
+    module = self->priv.maxPitchIncrementMod;
+    
+    /* calculate the preview feedforward pitch angles, from the predicted */
+    /* moments and the precomputed taps, limit them to the maximum pitch */
+    /* increment module, and leave the rest of it to the control loops */
+    if (0 < self->priv.previewHorizon) {
+        self->priv.feedforwardPitchY = 0.0;
+        self->priv.feedforwardPitchZ = 0.0;
+        for (k = 0; k < self->priv.previewHorizon; k++) {
+            self->priv.feedforwardPitchZ += self->priv.previewTapsMy[k]*self->in.previewMy[k];
+            self->priv.feedforwardPitchY += self->priv.previewTapsMz[k]*self->in.previewMz[k];
+        }
+        norm = sqrt(self->priv.feedforwardPitchY*self->priv.feedforwardPitchY + self->priv.feedforwardPitchZ*self->priv.feedforwardPitchZ);
+        if (norm > module) {
+            self->priv.feedforwardPitchY *= module/norm;
+            self->priv.feedforwardPitchZ *= module/norm;
+            norm = module;
+        }
+        module -= norm;
+    }
     
     /* figure out the limits for the My control loop */
-    self->priv.maxPitchZ = self->priv.maxPitchIncrementMod*self->priv.maxPitchIncrementMod - self->priv.pitchYcon*self->priv.pitchYcon;
+    self->priv.maxPitchZ = module*module - self->priv.pitchYcon*self->priv.pitchYcon;
     self->priv.maxPitchZ  = self->priv.maxPitchZ > 0.0 ? self->priv.maxPitchZ : 0.0;
     self->priv.maxPitchZ  = sqrt(self->priv.maxPitchZ);
     
@@ -115,31 +270,144 @@ void ikIpc_step(ikIpc *self) {
     self->priv.pitchZcon = ikConLoop_step(&(self->priv.conMy), self->in.demandedMy, self->priv.staticMoment.c[1], -self->priv.maxPitchZ, self->priv.maxPitchZ);
     
     /* figure out the limits for the Mz control loop */
-    self->priv.maxPitchY = self->priv.maxPitchIncrementMod*self->priv.maxPitchIncrementMod - self->priv.pitchZcon*self->priv.pitchZcon;
+    self->priv.maxPitchY = module*module - self->priv.pitchZcon*self->priv.pitchZcon;
     self->priv.maxPitchY  = self->priv.maxPitchY > 0.0 ? self->priv.maxPitchY : 0.0;
     self->priv.maxPitchY  = sqrt(self->priv.maxPitchY);
     
     /* Run My and Mz control loops */
     self->priv.pitchYcon = ikConLoop_step(&(self->priv.conMz), self->in.demandedMz, self->priv.staticMoment.c[2], -self->priv.maxPitchY, self->priv.maxPitchY);
     
-    /* add the external pitch actions */
+    /* add the external and feedforward pitch actions */
     self->priv.staticPitch.c[0] = 0.0;
-    self->priv.staticPitch.c[2] = self->in.externalPitchZ + self->priv.pitchZcon;
-    self->priv.staticPitch.c[1] = self->in.externalPitchY - self->priv.pitchYcon;
+    self->priv.staticPitch.c[2] = self->in.externalPitchZ + self->priv.pitchZcon + self->priv.feedforwardPitchZ;
+    self->priv.staticPitch.c[1] = self->in.externalPitchY - self->priv.pitchYcon + self->priv.feedforwardPitchY;
+    
+    /* Run the higher harmonic control loops, in frames of reference rotated */
+    /* by multiples of the blade azimuths, within the pitch increment module */
+    /* left by the loops before */
+    margin = module - sqrt(self->priv.pitchYcon*self->priv.pitchYcon + self->priv.pitchZcon*self->priv.pitchZcon);
+    for (k = 0; k < self->priv.nHarmonics; k++) {
+        harmonic = &(self->priv.harmonics[k]);
+        n = harmonic->order - 1;
+        harmonic->My = 0.0;
+        harmonic->Mz = 0.0;
+        for (i = 0; i < nBlades; i++) {
+            moment = &(self->in.bladeRootMoments[i]);
+            harmonic->My += cosines[n][i]*moment->c[1] - sines[n][i]*moment->c[2];
+            harmonic->Mz += cosines[n][i]*moment->c[2] + sines[n][i]*moment->c[1];
+        }
+        harmonic->maxPitchIncrementMod = margin > 0.0 ? margin : 0.0;
+        
+        harmonic->maxPitchZ = harmonic->maxPitchIncrementMod*harmonic->maxPitchIncrementMod - harmonic->pitchYcon*harmonic->pitchYcon;
+        harmonic->maxPitchZ = harmonic->maxPitchZ > 0.0 ? harmonic->maxPitchZ : 0.0;
+        harmonic->maxPitchZ = sqrt(harmonic->maxPitchZ);
+        harmonic->pitchZcon = ikConLoop_step(&(harmonic->conMy), 0.0, harmonic->My, -harmonic->maxPitchZ, harmonic->maxPitchZ);
+        
+        harmonic->maxPitchY = harmonic->maxPitchIncrementMod*harmonic->maxPitchIncrementMod - harmonic->pitchZcon*harmonic->pitchZcon;
+        harmonic->maxPitchY = harmonic->maxPitchY > 0.0 ? harmonic->maxPitchY : 0.0;
+        harmonic->maxPitchY = sqrt(harmonic->maxPitchY);
+        harmonic->pitchYcon = ikConLoop_step(&(harmonic->conMz), 0.0, harmonic->Mz, -harmonic->maxPitchY, harmonic->maxPitchY);
+        
+        margin -= sqrt(harmonic->pitchYcon*harmonic->pitchYcon + harmonic->pitchZcon*harmonic->pitchZcon);
+    }
     
     /* Transform the non-rotating frame pitch angle to rotating frame, */
-    /* then add the indivitual pitch angles to the collective one, and */
-    /* saturate. */
-    for (i = 0; i < 3; i++) {
-        self->priv.pitchDifferentials[i] = ikVector_dot(self->priv.staticPitch, pitchAxes[i]);
+    /* projecting it on the z axes of the blades, as well as those of the */
+    /* higher harmonic control loops, then add the indivitual pitch angles */
+    /* to the collective one, and saturate. */
+    for (i = 0; i < nBlades; i++) {
+        self->priv.pitchDifferentials[i] = cosines[0][i]*self->priv.staticPitch.c[2] - sines[0][i]*self->priv.staticPitch.c[1];
+        for (k = 0; k < self->priv.nHarmonics; k++) {
+            n = self->priv.harmonics[k].order - 1;
+            self->priv.pitchDifferentials[i] += cosines[n][i]*self->priv.harmonics[k].pitchZcon - sines[n][i]*self->priv.harmonics[k].pitchYcon;
+        }
         self->out.pitch[i] = self->in.collectivePitch + self->priv.pitchDifferentials[i];
     }
+#ifdef IKPROFILE
+    
+    /* count saturation of the My or Mz control loops */
+    if ((fabs(self->priv.pitchZcon) >= self->priv.maxPitchZ) || (fabs(self->priv.pitchYcon) >= self->priv.maxPitchY))
+        ikProfile_saturate(&(self->priv.profile));
+    ikProfile_stop(&(self->priv.profile));
+#endif
+
+}
+
+/**
+ * (Private) get output value of a higher harmonic by name
+ * @param self instance
+ * @param output output value
+ * @param name output name, without the "harmonic " prefix
+ * @return error code:
+ *  0: no error
+ * -1: invalid signal name
+ * -2: invalid block name
+ */
+int ikIpc_getHarmonicOutput(const ikIpc *self, double *output, const char *name) {
+    int err;
+    const char *sep;
+    char *end;
+    long k;
+    const ikIpcHarmonic *harmonic;
+    
+    /* pick up the harmonic number */
+    k = strtol(name, &end, 10);
+    if ((end == name) || (' ' != *end) || (1 > k) || (self->priv.nHarmonics < k)) return NULL == strstr(name, ">") ? -1 : -2;
+    harmonic = &(self->priv.harmonics[k - 1]);
+    name = end + 1;
+    
+    /* pick up the signal names */
+    if (!strcmp(name, "My")) {
+        *output = harmonic->My;
+        return 0;
+    }
+    if (!strcmp(name, "Mz")) {
+        *output = harmonic->Mz;
+        return 0;
+    }
+    if (!strcmp(name, "pitch y from control")) {
+        *output = harmonic->pitchYcon;
+        return 0;
+    }
+    if (!strcmp(name, "pitch z from control")) {
+        *output = harmonic->pitchZcon;
+        return 0;
+    }
+    if (!strcmp(name, "maximum pitch increment module")) {
+        *output = harmonic->maxPitchIncrementMod;
+        return 0;
+    }
+    if (!strcmp(name, "maximum pitch y")) {
+        *output = harmonic->maxPitchY;
+        return 0;
+    }
+    if (!strcmp(name, "maximum pitch z")) {
+        *output = harmonic->maxPitchZ;
+        return 0;
+    }
 
+    /* pick up the block names */
+    sep = strstr(name, ">");
+    if (NULL == sep) return -1;
+    if (!strncmp(name, "My control", strlen(name) - strlen(sep))) {
+        err = ikConLoop_getOutput(&(harmonic->conMy), output, sep + 1);
+        if (err) return -1;
+        else return 0;
+    }
+    if (!strncmp(name, "Mz control", strlen(name) - strlen(sep))) {
+        err = ikConLoop_getOutput(&(harmonic->conMz), output, sep + 1);
+        if (err) return -1;
+        else return 0;
+    }
+
+    return -2;
 }
 
 int ikIpc_getOutput(const ikIpc *self, double *output, const char *name) {
     int err;
     const char *sep;
+    char *end;
+    long k;
     
     /* pick up the signal names */
     if (!strcmp(name, "My")) {
@@ -166,17 +434,12 @@ int ikIpc_getOutput(const ikIpc *self, double *output, const char *name) {
         *output = self->priv.staticPitch.c[2];
         return 0;
     }
-    if (!strcmp(name, "pitch increment 1")) {
-        *output = self->priv.pitchDifferentials[0];
-        return 0;
-    }
-    if (!strcmp(name, "pitch increment 2")) {
-        *output = self->priv.pitchDifferentials[1];
-        return 0;
-    }
-    if (!strcmp(name, "pitch increment 3")) {
-        *output = self->priv.pitchDifferentials[2];
-        return 0;
+    if (!strncmp(name, "pitch increment ", 16)) {
+        k = strtol(name + 16, &end, 10);
+        if ((end != name + 16) && ('\0' == *end) && (1 <= k) && (self->priv.nBlades >= k)) {
+            *output = self->priv.pitchDifferentials[k - 1];
+            return 0;
+        }
     }
     if (!strcmp(name, "maximum pitch increment module")) {
         *output = self->priv.maxPitchIncrementMod;
@@ -190,6 +453,25 @@ int ikIpc_getOutput(const ikIpc *self, double *output, const char *name) {
         *output = self->priv.maxPitchZ;
         return 0;
     }
+    if (!strcmp(name, "feedforward pitch y")) {
+        *output = self->priv.feedforwardPitchY;
+        return 0;
+    }
+    if (!strcmp(name, "feedforward pitch z")) {
+        *output = self->priv.feedforwardPitchZ;
+        return 0;
+    }
+
+    /* pick up the higher harmonic names */
+    if (!strncmp(name, "harmonic ", 9)) return ikIpc_getHarmonicOutput(self, output, name + 9);
+#ifdef IKPROFILE
+    
+    /* pick up the profile counters */
+    if (!strncmp(name, "profile>", 8)) {
+        if (ikProfile_getOutput(&(self->priv.profile), output, name + 8)) return -1;
+        return 0;
+    }
+#endif
 
     /* pick up the block names */
     sep = strstr(name, ">");
@@ -208,4 +490,73 @@ int ikIpc_getOutput(const ikIpc *self, double *output, const char *name) {
     return -2;
 }
 
+int ikIpc_saveState(const ikIpc *self, void *buffer, size_t size, size_t *length) {
+    ikCheckpoint cp;
+    
+    /* saving leaves the instance as it is */
+    ikCheckpoint_initSave(&cp, buffer, size, "ikIpc");
+    ikIpc_checkpoint((ikIpc *) self, &cp);
+    return ikCheckpoint_finish(&cp, length);
+}
+
+int ikIpc_restoreState(ikIpc *self, const void *blob, size_t size) {
+    ikCheckpoint cp;
+    int err;
+    
+    /* check the whole blob with a dry run, then restore */
+    err = ikCheckpoint_initRestore(&cp, blob, size, "ikIpc", 1);
+    if (err) return err;
+    ikIpc_checkpoint(self, &cp);
+    err = ikCheckpoint_finish(&cp, NULL);
+    if (err) return err;
+    ikCheckpoint_initRestore(&cp, blob, size, "ikIpc", 0);
+    ikIpc_checkpoint(self, &cp);
+    return ikCheckpoint_finish(&cp, NULL);
+}
+
+void ikIpc_checkpoint(ikIpc *self, ikCheckpoint *cp) {
+    int i, k;
+    ikIpcHarmonic *harmonic;
+    
+    /* My and Mz control loops */
+    ikCheckpoint_check(cp, self->priv.nBlades);
+    ikCheckpoint_check(cp, self->priv.nHarmonics);
+    ikConLoop_checkpoint(&(self->priv.conMy), cp);
+    ikConLoop_checkpoint(&(self->priv.conMz), cp);
+    
+    /* signals */
+    for (i = 0; i < 3; i++) {
+        ikCheckpoint_double(cp, &(self->priv.staticMoment.c[i]));
+        ikCheckpoint_double(cp, &(self->priv.staticPitch.c[i]));
+    }
+    ikCheckpoint_double(cp, &(self->priv.pitchYcon));
+    ikCheckpoint_double(cp, &(self->priv.pitchZcon));
+    ikCheckpoint_double(cp, &(self->priv.maxPitchIncrementMod));
+    ikCheckpoint_double(cp, &(self->priv.maxPitchZ));
+    ikCheckpoint_double(cp, &(self->priv.maxPitchY));
+    ikCheckpoint_double(cp, &(self->priv.feedforwardPitchY));
+    ikCheckpoint_double(cp, &(self->priv.feedforwardPitchZ));
+    
+    /* higher harmonic control loops */
+    for (k = 0; k < self->priv.nHarmonics; k++) {
+        harmonic = &(self->priv.harmonics[k]);
+        ikCheckpoint_check(cp, harmonic->order);
+        ikConLoop_checkpoint(&(harmonic->conMy), cp);
+        ikConLoop_checkpoint(&(harmonic->conMz), cp);
+        ikCheckpoint_double(cp, &(harmonic->My));
+        ikCheckpoint_double(cp, &(harmonic->Mz));
+        ikCheckpoint_double(cp, &(harmonic->pitchYcon));
+        ikCheckpoint_double(cp, &(harmonic->pitchZcon));
+        ikCheckpoint_double(cp, &(harmonic->maxPitchIncrementMod));
+        ikCheckpoint_double(cp, &(harmonic->maxPitchZ));
+        ikCheckpoint_double(cp, &(harmonic->maxPitchY));
+    }
+    
+    /* outputs */
+    for (i = 0; i < self->priv.nBlades; i++) {
+        ikCheckpoint_double(cp, &(self->priv.pitchDifferentials[i]));
+        ikCheckpoint_double(cp, &(self->out.pitch[i]));
+    }
+}
+
 /* @endcond */
@@ -30,8 +30,16 @@ along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
 extern "C" {
 #endif
 
+#include <stddef.h>
 #include "ikConLoop.h"
 #include "ikVector.h"
+#ifdef IKPROFILE
+#include "ikProfile.h"
+#endif
+
+#define IKIPC_MAXBLADES 6
+#define IKIPC_MAXORDER 6
+#define IKIPC_MAXPREVIEW 32
     
     /**
      * @struct ikIpcInputs
@@ -45,22 +53,29 @@ extern "C" {
         double collectivePitch; /**<collective pitch angle, in degrees.*/
         double maximumPitch; /**<maximum pitch, in degrees.*/
         double minimumPitch; /**<minimum pitch, in degrees.*/
-        ikVector bladeRootMoments[3]; /**<blade root moments, in kNm, expressed in coordinates
+        ikVector bladeRootMoments[IKIPC_MAXBLADES]; /**<blade root moments, in kNm, expressed in coordinates
                                        * of the corresponding rotating frames of reference
                                        * as defined in @link ikIpc @endlink. This is an array
-                                       * of 3 instances of @link ikVector @endlink, each
-                                       * with 3 coordinates. The coordinates in the first
+                                       * of instances of @link ikVector @endlink, each
+                                       * with 3 coordinates, of which the first
+                                       * @link ikIpcParams.nBlades @endlink are used.
+                                       * The coordinates in the first
                                        * @link ikVector @endlink correspond to blade 1
                                        * root moments around local axes \f$ x' \f$, 
                                        * \f$ y' \f$ and \f$ z' \f$, in that order.
-                                       * The second and third instance of @link ikVector @endlink
+                                       * The second, third and following instances of @link ikVector @endlink
                                        * have the homologous information regarding
-                                       * blades 2 and 3, respectively. */
+                                       * blades 2, 3 and so on, respectively. */
         double demandedMy; /**<demanded My, in kNm*/
         double demandedMz; /**<demanded Mz, in kNm*/
         double maximumIndividualPitch; /**<maximum individual pitch, in degrees*/
         double externalPitchY; /**<external pitch y, in degrees*/
         double externalPitchZ; /**<external pitch z, in degrees*/
+        double previewMy[IKIPC_MAXPREVIEW]; /**<predicted disturbance My, in kNm, where previewMy[k]
+                                             is the prediction for k sample intervals ahead. Only
+                                             the first @link ikIpcParams.previewHorizon @endlink
+                                             values are used.*/
+        double previewMz[IKIPC_MAXPREVIEW]; /**<predicted disturbance Mz, in kNm, as previewMy*/
     } ikIpcInputs;
     
     /**
@@ -70,13 +85,30 @@ extern "C" {
      * Instances of ikIpc make outputs available via a structure of this type: @link ikIpc.out @endlink.
      */
     typedef struct ikIpcOutputs {
-        double pitch[3]; /**<pitch angles, in degrees*/
+        double pitch[IKIPC_MAXBLADES]; /**<pitch angles, in degrees, of which the first
+                                        @link ikIpcParams.nBlades @endlink are set*/
     } ikIpcOutputs;
     
     /* @cond */
+    typedef struct ikIpcHarmonic {
+        int order;
+        ikConLoop conMz;
+        ikConLoop conMy;
+        double My;
+        double Mz;
+        double pitchYcon;
+        double pitchZcon;
+        double maxPitchIncrementMod;
+        double maxPitchZ;
+        double maxPitchY;
+    } ikIpcHarmonic;
+    
     typedef struct ikIpcPrivate {
-        double pitchDifferentials[3];
-        double azimuthOffsets[3];
+        int nBlades;
+        double pitchDifferentials[IKIPC_MAXBLADES];
+        double azimuthOffsets[IKIPC_MAXBLADES];
+        double offsetCos[IKIPC_MAXBLADES];
+        double offsetSin[IKIPC_MAXBLADES];
         ikConLoop conMz;
         ikConLoop conMy;
         ikVector staticMoment;
@@ -86,6 +118,17 @@ extern "C" {
         double maxPitchIncrementMod;
         double maxPitchZ;
         double maxPitchY;
+        int nHarmonics;
+        int maxOrder;
+        ikIpcHarmonic *harmonics;
+        int previewHorizon;
+        double previewTapsMy[IKIPC_MAXPREVIEW];
+        double previewTapsMz[IKIPC_MAXPREVIEW];
+        double feedforwardPitchY;
+        double feedforwardPitchZ;
+#ifdef IKPROFILE
+        ikProfile profile;
+#endif
     } ikIpcPrivate;
     /* @endcond */
     
@@ -106,6 +149,7 @@ extern "C" {
      * @li maximum individual pitch, specify via @link in @endlink
      * @li external pitch y, specify via @link in @endlink
      * @li external pitch z, specify via @link in @endlink
+     * @li preview My and Mz, specify via @link in @endlink
      * 
      * @par Outputs
      * @li pitch, get via @link out @endlink
@@ -144,6 +188,14 @@ extern "C" {
      * rotate in unison, and are permanently 120º from each other, as shown below.
      * Note that two arrangements are possible.
      * 
+     * Rotors with a number of blades \f$ N \f$ other than 3, up to
+     * @link IKIPC_MAXBLADES @endlink, may be specified via
+     * @link ikIpcParams.nBlades @endlink. The rotating frames of reference
+     * local to their blades are defined likewise, and are permanently
+     * \f$ 360º/N \f$ from each other, blade \f$ i+1 \f$ following blade
+     * \f$ i \f$ as blade 2 follows blade 1 below. The moments and pitch
+     * angles of the blades beyond the \f$ N \f$th are neither read nor set.
+     * 
      * To accommodate different turbine-specific idiosyncrasies, the azimuth angle
      * \f$ \theta \f$ is defined as the positive rotation around \f$ x \f$ necessary
      * to bring \f$ z \f$ to coincide with \f$ z' \f$, minus constant angle
@@ -154,11 +206,66 @@ extern "C" {
      * 
      * @image html ikIpc_coordinates.svg
      * 
+     * @par Higher harmonics
+     * 
+     * Additional pairs of My and Mz control loops may be enabled via
+     * @link ikIpcParams.nHarmonics @endlink and @link ikIpcParams.harmonics @endlink,
+     * each acting on a harmonic of order \f$ n \f$. These work as the loops
+     * above, in frames of reference rotated by \f$ n \f$ times the azimuth
+     * of each blade instead of once, so that the \f$ n \f$P blade loads
+     * appear as constant moments. The cosines and sines of the multiple
+     * angles are derived from those of the blade azimuths by recurrence, so
+     * the trigonometric functions are still evaluated once per step. The
+     * pitch angles of each harmonic are limited so that the amplitudes of all
+     * loops add up to no more than the maximum pitch increment module, the
+     * first loops taking precedence. Their signals are accessible via
+     * @link ikIpc_getOutput @endlink with the prefix "harmonic k ", where
+     * k is the position of the harmonic in @link ikIpcParams.harmonics @endlink,
+     * starting at 1, e.g. "harmonic 1 My" or "harmonic 2 Mz control>control action".
+     * Instances do not hold nor allocate the harmonic control loops: initialise
+     * them with @link ikIpc_initBuffer @endlink and a buffer of the size given by
+     * @link ikIpc_getBufferSize @endlink, which must outlive the instance.
+     * 
+     * @par Preview feedforward
+     * 
+     * When @link ikIpcParams.previewHorizon @endlink is positive, predicted
+     * disturbance moments My and Mz, e.g. from a nacelle LIDAR, may be
+     * specified via @link ikIpcInputs.previewMy @endlink and
+     * @link ikIpcInputs.previewMz @endlink for that many sample intervals
+     * ahead. A feedforward pitch z is then computed as a weighted sum of
+     * the predicted My values, and a feedforward pitch y as one of the
+     * predicted Mz values:
+     * 
+     * \f$ \theta_{ff,z} = K_y \sum_k w_k M_{y,k} / \sum_k w_k \f$,
+     * \f$ \theta_{ff,y} = K_z \sum_k w_k M_{z,k} / \sum_k w_k \f$
+     * 
+     * where the weights \f$ w_k \f$ and gains \f$ K_y \f$ and \f$ K_z \f$ are
+     * set via @link ikIpc_init @endlink, and the products of weights and gains
+     * are computed there, once. The gains must have the sign that opposes the
+     * moments. The feedforward pitch angles are added to those of the My and
+     * Mz control loops, and take precedence over them: they are limited to the
+     * maximum pitch increment module, and the control loops to what is left
+     * of it. They are accessible via @link ikIpc_getOutput @endlink as
+     * "feedforward pitch y" and "feedforward pitch z".
+     * 
+     * If IKPROFILE is defined at compile time, the steps are counted and
+     * timed, as are the steps in which the My or Mz control loop is at its
+     * limits, as saturations. The counters of @link ikProfile @endlink are
+     * accessible via @link ikIpc_getOutput @endlink as "profile>calls",
+     * "profile>cycles", and so on, and those of the control loops as
+     * "My control>profile>cycles", and so on.
+     * 
      * @par Methods
      * @li @link ikIpc_initParams @endlink initialise initialisation parameter structure
+     * @li @link ikIpc_initHarmonicParams @endlink initialise higher harmonic initialisation parameter structure
      * @li @link ikIpc_init @endlink initialise an instance
+     * @li @link ikIpc_initBuffer @endlink initialise an instance with higher harmonics
+     * @li @link ikIpc_getBufferSize @endlink get size of buffer needed for the higher harmonics
      * @li @link ikIpc_step @endlink execute preriodic calculations
      * @li @link ikIpc_getOutput @endlink get output value
+     * @li @link ikIpc_saveState @endlink save runtime state to a checkpoint blob
+     * @li @link ikIpc_restoreState @endlink restore runtime state from a checkpoint blob
+     * @li @link ikIpc_checkpoint @endlink save or restore runtime state
      */
     typedef struct ikIpc {
         ikIpcInputs in; /**<inputs*/
@@ -168,27 +275,71 @@ extern "C" {
         /* @endcond */
     } ikIpc;
     
+    /**
+     * @struct ikIpcHarmonicParams
+     * @brief individual pitch control higher harmonic initialisation parameters
+     */
+    typedef struct ikIpcHarmonicParams {
+        int order; /**<harmonic order \f$n\f$, between 2 and @link IKIPC_MAXORDER @endlink.
+                    The default value is 2.*/
+        ikConLoopParams controlMz; /**< Mz control initialisation parameters */
+        ikConLoopParams controlMy; /**< My control initialisation parameters */
+    } ikIpcHarmonicParams;
+    
     /**
      * @struct ikIpcParams
      * @brief individual pitch control initialisation parameters
      */
     typedef struct ikIpcParams {
+        int nBlades; /**<number of blades \f$N\f$, between 2 and @link IKIPC_MAXBLADES @endlink. The default value is 3.*/
         int bladeOrder; /**<parameter \f$s\f$ as defined in @link ikIpc @endlink. The default value is 1.*/
         double azimuthOffset; /**<parameter \f$\phi\f$ as defined in @link ikIpc @endlink. The default value is 0.0.*/
         ikConLoopParams controlMz; /**< Mz control initialisation parameters */
         ikConLoopParams controlMy; /**< My control initialisation parameters */
+        int nHarmonics; /**<number of higher harmonic control loop pairs enabled. The default value is 0.*/
+        const ikIpcHarmonicParams *harmonics; /**<array of nHarmonics higher harmonic initialisation
+                                               parameter structures. The default value is NULL.*/
+        int previewHorizon; /**<number of predicted moment values used by the preview feedforward, between
+                             0 and @link IKIPC_MAXPREVIEW @endlink. The default value is 0, which disables it.*/
+        double previewWeights[IKIPC_MAXPREVIEW]; /**<preview feedforward weights \f$ w_k \f$, only the first
+                                                  previewHorizon are used, and they must not add up to 0.
+                                                  The default values are 1.0.*/
+        double feedforwardGainMy; /**<preview feedforward gain \f$ K_y \f$, in degrees/kNm, from predicted My
+                                   to pitch z. The default value is 0.0.*/
+        double feedforwardGainMz; /**<preview feedforward gain \f$ K_z \f$, in degrees/kNm, from predicted Mz
+                                   to pitch y. The default value is 0.0.*/
     } ikIpcParams;
     
     /**
-     * Initialise an instance
+     * Initialise an instance without higher harmonics, see @link ikIpc_initBuffer @endlink
+     * @param self instance
+     * @param params initialisation parameters.
+     * @return error code, as for @link ikIpc_initBuffer @endlink, which returns -6
+     * if @link ikIpcParams.nHarmonics @endlink is positive
+     */
+    int ikIpc_init(ikIpc *self, const ikIpcParams *params);
+
+    /**
+     * Initialise an instance, with its higher harmonic control loops in a buffer
      * @param self instance
      * @param params initialisation parameters.
+     * @param buffer memory for the higher harmonic control loops, aligned as
+     * returned by malloc, which must outlive the instance. It may be NULL if
+     * @link ikIpcParams.nHarmonics @endlink is 0.
+     * @param bufferSize size of buffer, in bytes
      * @return error code:
      * @li 0: no error
      * @li -1: could not initialise My control
      * @li -2: could not initialise Mz control
+     * @li -3: invalid number of harmonics, it must not be negative, and there must be harmonic parameters if positive
+     * @li -4: invalid harmonic order, it must be between 2 and @link IKIPC_MAXORDER @endlink
+     * @li -5: could not initialise higher harmonic control
+     * @li -6: the buffer is too small, see @link ikIpc_getBufferSize @endlink. The instance is left without higher harmonics
+     * @li -7: invalid number of blades, it must be between 2 and @link IKIPC_MAXBLADES @endlink
+     * @li -8: invalid preview horizon, it must be between 0 and @link IKIPC_MAXPREVIEW @endlink
+     * @li -9: invalid preview weights, they must not add up to 0
      */
-    int ikIpc_init(ikIpc *self, const ikIpcParams *params);
+    int ikIpc_initBuffer(ikIpc *self, const ikIpcParams *params, void *buffer, size_t bufferSize);
 
     /**
      * Initialise initialisation parameter structure
@@ -196,6 +347,19 @@ extern "C" {
      */
     void ikIpc_initParams(ikIpcParams *params);
     
+    /**
+     * Initialise higher harmonic initialisation parameter structure
+     * @param params higher harmonic initialisation parameter structure
+     */
+    void ikIpc_initHarmonicParams(ikIpcHarmonicParams *params);
+    
+    /**
+     * Get size of buffer needed for the higher harmonic control loops
+     * @param params initialisation parameters
+     * @return size of the buffer to pass to @link ikIpc_initBuffer @endlink, in bytes
+     */
+    size_t ikIpc_getBufferSize(const ikIpcParams *params);
+    
     /**
      * Execute periodic calculations
      * @param self individual pitch control instance
@@ -218,6 +382,49 @@ extern "C" {
      */
     int ikIpc_getOutput(const ikIpc *self, double *output, const char *name);
 
+    /**
+     * Save runtime state to a checkpoint blob, as described in
+     * @link ikCheckpoint @endlink. The blob can be restored, via
+     * @link ikIpc_restoreState @endlink, into this or any other instance
+     * initialised with the same parameters.
+     * @param self individual pitch control instance
+     * @param buffer buffer for the blob, or NULL to find out its length
+     * @param size size of the buffer, in bytes
+     * @param length length of the blob, in bytes, or, if the buffer is too
+     * small, the size needed
+     * @return error code:
+     * @li 0: no error
+     * @li -1: the buffer is too small
+     */
+    int ikIpc_saveState(const ikIpc *self, void *buffer, size_t size, size_t *length);
+
+    /**
+     * Restore runtime state from a checkpoint blob written by
+     * @link ikIpc_saveState @endlink. The blob is checked before anything
+     * is restored, so that the instance is left as it was on error.
+     * @param self individual pitch control instance
+     * @param blob blob
+     * @param size size of the blob, in bytes
+     * @return error code:
+     * @li 0: no error
+     * @li -1: the blob is shorter than its header says
+     * @li -2: not a checkpoint blob, or one of another byte order
+     * @li -3: unsupported format version
+     * @li -4: checkpoint blob of another class
+     * @li -5: corrupt payload
+     * @li -6: the blob does not match the configuration of the instance
+     */
+    int ikIpc_restoreState(ikIpc *self, const void *blob, size_t size);
+
+    /**
+     * Save or restore runtime state, i.e. that of all the control loops, including the higher harmonic ones, the latest signal values and the outputs. The inputs are not included, since they are set before each step.
+     * Profiling counters are not included.
+     * @param self individual pitch control instance
+     * @param cp checkpoint blob writer or reader
+     */
+    void ikIpc_checkpoint(ikIpc *self, ikCheckpoint *cp);
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,842 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikIpc_test.c
+ * 
+ * @brief Class ikIpc unit tests
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../ikIpc/ikIpc.h"
+#include "../ikTestUtil/ikTestUtil.h"
+
+/*
+ * Reference implementation: transformation of the blade root moments to the
+ * non-rotating frame, and of the pitch angles to the rotating frames, with
+ * a general rotation of each blade's vectors by its azimuth
+ */
+ikVector referenceStaticMoment(const ikIpcInputs *in, double azimuthOffset, int bladeOrder, int nBlades) {
+    ikVector moment;
+    ikVector rotation;
+    int i;
+    for (i = 0; i < 3; i++) moment.c[i] = 0.0;
+    for (i = 0; i < nBlades; i++) {
+        rotation.c[0] = fmod(in->azimuth/180.0*3.14159265358979 + azimuthOffset/180.0*3.14159265358979 + bladeOrder * i * 2.0/nBlades*3.14159265358979, 2.0*3.14159265358979);
+        rotation.c[1] = 0.0;
+        rotation.c[2] = 0.0;
+        moment = ikVector_add(moment, ikVector_rotate(in->bladeRootMoments[i], rotation));
+    }
+    return moment;
+}
+
+double referencePitchIncrement(const ikIpcInputs *in, double azimuthOffset, int bladeOrder, int nBlades, int i, ikVector staticPitch) {
+    ikVector rotation;
+    ikVector pitchAxis;
+    rotation.c[0] = fmod(in->azimuth/180.0*3.14159265358979 + azimuthOffset/180.0*3.14159265358979 + bladeOrder * i * 2.0/nBlades*3.14159265358979, 2.0*3.14159265358979);
+    rotation.c[1] = 0.0;
+    rotation.c[2] = 0.0;
+    pitchAxis.c[0] = 0.0;
+    pitchAxis.c[1] = 0.0;
+    pitchAxis.c[2] = 1.0;
+    return ikVector_dot(staticPitch, ikVector_rotate(pitchAxis, rotation));
+}
+
+/*
+ * Simple C Test Suite
+ */
+
+/**
+ * Default initialisation results in the expected behaviour
+ */
+void testDefault() {
+    printf("ikIpc_test testDefault\n");
+    /* declare error code */
+    int err;
+    /* declare instance */
+    ikIpc ipc;
+    /* declare initialisation parameters */
+    ikIpcParams params;
+    int i;
+    
+    /* initialise instance */
+    ikIpc_initParams(&params);
+    err = ikIpc_init(&ipc, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testDefault (ikIpc_test) message=init expected to return 0, but it returned %d\n", err);
+    
+    /* see that the pitch angles equal the collective pitch with no moments */
+    ipc.in.azimuth = 30.0;
+    ipc.in.collectivePitch = 5.0;
+    ipc.in.maximumPitch = 90.0;
+    ipc.in.maximumIndividualPitch = 3.0;
+    ikIpc_step(&ipc);
+    for (i = 0; i < 3; i++) {
+        if (5.0 != ipc.out.pitch[i]) printf("%%TEST_FAILED%% time=0 testname=testDefault (ikIpc_test) message=expected pitch %d to be 5.0, but it is %f\n", i + 1, ipc.out.pitch[i]);
+    }
+    
+}
+
+/**
+ * The blade root moments are transformed to the non-rotating frame, and the
+ * pitch angles to the rotating frames, as with general rotations of each
+ * blade's vectors, for both blade orders and various azimuth offsets, to
+ * within 1e-12 of the magnitude of the inputs
+ */
+void testTransforms() {
+    printf("ikIpc_test testTransforms\n");
+    /* declare error code */
+    int err;
+    /* declare instance */
+    ikIpc ipc;
+    /* declare initialisation parameters */
+    ikIpcParams params;
+    const double offsets[4] = {0.0, 37.5, -90.0, 400.0};
+    ikVector moment;
+    ikVector staticPitch;
+    double output;
+    double expected;
+    double scale;
+    double maxError = 0.0;
+    int i;
+    int j;
+    int k;
+    int l;
+    
+    for (l = 0; l < 8; l++) {
+        /* initialise instance */
+        ikIpc_initParams(&params);
+        params.bladeOrder = l % 2 ? -1 : 1;
+        params.azimuthOffset = offsets[l / 2];
+        err = ikIpc_init(&ipc, &params);
+        if (err) printf("%%TEST_FAILED%% time=0 testname=testTransforms (ikIpc_test) message=init expected to return 0, but it returned %d\n", err);
+        ipc.in.collectivePitch = 10.0;
+        ipc.in.maximumPitch = 90.0;
+        ipc.in.minimumPitch = 0.0;
+        ipc.in.maximumIndividualPitch = 5.0;
+        
+        /* several revolutions, from negative azimuth angles on */
+        for (k = 0; k < 2000; k++) {
+            ipc.in.azimuth = 7.3 * k - 500.0;
+            for (i = 0; i < 3; i++) {
+                for (j = 0; j < 3; j++) ipc.in.bladeRootMoments[i].c[j] = ikTestUtil_rand(-5000.0, 5000.0);
+            }
+            ipc.in.demandedMy = ikTestUtil_rand(-5.0, 5.0);
+            ipc.in.demandedMz = ikTestUtil_rand(-5.0, 5.0);
+            ipc.in.externalPitchY = ikTestUtil_rand(-1.0, 1.0);
+            ipc.in.externalPitchZ = ikTestUtil_rand(-1.0, 1.0);
+            ikIpc_step(&ipc);
+            
+            /* static moments, relative to the magnitude of the blade root moments */
+            moment = referenceStaticMoment(&(ipc.in), params.azimuthOffset, params.bladeOrder, 3);
+            scale = 1.0;
+            for (i = 0; i < 3; i++) scale += fabs(ipc.in.bladeRootMoments[i].c[1]) + fabs(ipc.in.bladeRootMoments[i].c[2]);
+            ikIpc_getOutput(&ipc, &output, "My");
+            if (fabs(output - moment.c[1]) / scale > maxError) maxError = fabs(output - moment.c[1]) / scale;
+            ikIpc_getOutput(&ipc, &output, "Mz");
+            if (fabs(output - moment.c[2]) / scale > maxError) maxError = fabs(output - moment.c[2]) / scale;
+            
+            /* pitch angles */
+            staticPitch.c[0] = 0.0;
+            ikIpc_getOutput(&ipc, &(staticPitch.c[1]), "pitch y");
+            ikIpc_getOutput(&ipc, &(staticPitch.c[2]), "pitch z");
+            scale = 1.0 + fabs(ipc.in.collectivePitch) + fabs(staticPitch.c[1]) + fabs(staticPitch.c[2]);
+            for (i = 0; i < 3; i++) {
+                expected = ipc.in.collectivePitch + referencePitchIncrement(&(ipc.in), params.azimuthOffset, params.bladeOrder, 3, i, staticPitch);
+                if (fabs(ipc.out.pitch[i] - expected) / scale > maxError) maxError = fabs(ipc.out.pitch[i] - expected) / scale;
+            }
+        }
+    }
+    if (1e-12 < maxError) printf("%%TEST_FAILED%% time=0 testname=testTransforms (ikIpc_test) message=the outputs differ from the reference by up to %g, relative to the inputs\n", maxError);
+    
+}
+
+/**
+ * The higher harmonic control loops see the blade root moments in frames of
+ * reference rotated by multiples of the blade azimuths, add their pitch
+ * angles accordingly, and share the maximum pitch increment module
+ */
+void testHarmonics() {
+    printf("ikIpc_test testHarmonics\n");
+    /* declare error code */
+    int err;
+    /* declare instance */
+    ikIpc ipc;
+    /* declare initialisation parameters */
+    ikIpcParams params;
+    ikIpcHarmonicParams harmonics[2];
+    void *buffer;
+    double output;
+    double expected;
+    double angle;
+    double amplitude;
+    double pitchY[3];
+    double pitchZ[3];
+    double pitchYcon;
+    double pitchZcon;
+    double maxError = 0.0;
+    int nExceeded = 0;
+    int nActed[3] = {0, 0, 0};
+    int i;
+    int k;
+    int h;
+    char name[64];
+    
+    /* initialise instance with 2P and 3P loops */
+    ikIpc_initParams(&params);
+    params.azimuthOffset = 15.0;
+    for (h = 0; h < 2; h++) {
+        ikIpc_initHarmonicParams(&(harmonics[h]));
+        harmonics[h].order = h + 2;
+    }
+    params.nHarmonics = 2;
+    params.harmonics = harmonics;
+    buffer = malloc(ikIpc_getBufferSize(&params));
+    err = ikIpc_initBuffer(&ipc, &params, buffer, ikIpc_getBufferSize(&params));
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testHarmonics (ikIpc_test) message=init expected to return 0, but it returned %d\n", err);
+    ipc.in.collectivePitch = 10.0;
+    ipc.in.maximumPitch = 90.0;
+    ipc.in.minimumPitch = 0.0;
+    ipc.in.maximumIndividualPitch = 4.0;
+    
+    for (k = 0; k < 1000; k++) {
+        /* 2P and 3P flapwise moments, and external pitch */
+        ipc.in.azimuth = 3.7 * k;
+        ipc.in.externalPitchY = 0.5 * sin(0.01 * k);
+        ipc.in.externalPitchZ = 0.5 * cos(0.01 * k);
+        for (i = 0; i < 3; i++) {
+            angle = (ipc.in.azimuth + 15.0 + 120.0 * i) / 180.0 * 3.14159265358979;
+            ipc.in.bladeRootMoments[i].c[0] = 0.0;
+            ipc.in.bladeRootMoments[i].c[1] = cos(2.0 * angle) + 0.5 * sin(3.0 * angle);
+            ipc.in.bladeRootMoments[i].c[2] = 0.0;
+        }
+        ikIpc_step(&ipc);
+        
+        /* the 2P loads are seen as constant moments, and the 3P loads cancel out */
+        ikIpc_getOutput(&ipc, &output, "harmonic 1 My");
+        if (fabs(output - 1.5) > maxError) maxError = fabs(output - 1.5);
+        ikIpc_getOutput(&ipc, &output, "harmonic 1 Mz");
+        if (fabs(output) > maxError) maxError = fabs(output);
+        
+        /* the pitch angles of all loops add up */
+        ikIpc_getOutput(&ipc, &(pitchY[0]), "pitch y");
+        ikIpc_getOutput(&ipc, &(pitchZ[0]), "pitch z");
+        ikIpc_getOutput(&ipc, &pitchYcon, "pitch y from control");
+        ikIpc_getOutput(&ipc, &pitchZcon, "pitch z from control");
+        amplitude = sqrt(pitchYcon*pitchYcon + pitchZcon*pitchZcon);
+        for (h = 1; h < 3; h++) {
+            sprintf(name, "harmonic %d pitch y from control", h);
+            ikIpc_getOutput(&ipc, &(pitchY[h]), name);
+            sprintf(name, "harmonic %d pitch z from control", h);
+            ikIpc_getOutput(&ipc, &(pitchZ[h]), name);
+            amplitude += sqrt(pitchY[h]*pitchY[h] + pitchZ[h]*pitchZ[h]);
+            if (0.0 != pitchY[h] && 0.0 != pitchZ[h]) nActed[h]++;
+        }
+        if (amplitude > 4.0 + 1e-12) nExceeded++;
+        for (i = 0; i < 3; i++) {
+            angle = (ipc.in.azimuth + 15.0 + 120.0 * i) / 180.0 * 3.14159265358979;
+            expected = ipc.in.collectivePitch;
+            for (h = 0; h < 3; h++) expected += cos((h + 1) * angle) * pitchZ[h] - sin((h + 1) * angle) * pitchY[h];
+            if (fabs(ipc.out.pitch[i] - expected) > maxError) maxError = fabs(ipc.out.pitch[i] - expected);
+        }
+    }
+    if (1e-9 < maxError) printf("%%TEST_FAILED%% time=0 testname=testHarmonics (ikIpc_test) message=the outputs differ from the expected ones by up to %g\n", maxError);
+    if (nExceeded) printf("%%TEST_FAILED%% time=0 testname=testHarmonics (ikIpc_test) message=the pitch amplitudes exceeded the maximum individual pitch in %d steps\n", nExceeded);
+    
+    /* see that the 2P and 3P loops acted, and the signal and block names */
+    if (!nActed[1] || !nActed[2]) printf("%%TEST_FAILED%% time=0 testname=testHarmonics (ikIpc_test) message=expected the 2P and 3P loops to act\n");
+    err = ikIpc_getOutput(&ipc, &output, "harmonic 2 Mz control>control action");
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testHarmonics (ikIpc_test) message=getOutput expected to return 0, but it returned %d\n", err);
+    err = ikIpc_getOutput(&ipc, &output, "harmonic 3 My");
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testHarmonics (ikIpc_test) message=getOutput expected to return -1, but it returned %d\n", err);
+    err = ikIpc_getOutput(&ipc, &output, "harmonic 1 Mx");
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testHarmonics (ikIpc_test) message=getOutput expected to return -1, but it returned %d\n", err);
+    err = ikIpc_getOutput(&ipc, &output, "harmonic 3 My control>control action");
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=testHarmonics (ikIpc_test) message=getOutput expected to return -2, but it returned %d\n", err);
+    err = ikIpc_getOutput(&ipc, &output, "harmonic 1 Mx control>control action");
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=testHarmonics (ikIpc_test) message=getOutput expected to return -2, but it returned %d\n", err);
+    
+    /* see that invalid numbers of harmonics, orders and buffers are reported */
+    params.nHarmonics = -1;
+    err = ikIpc_initBuffer(&ipc, &params, buffer, ikIpc_getBufferSize(&params));
+    if (-3 != err) printf("%%TEST_FAILED%% time=0 testname=testHarmonics (ikIpc_test) message=init expected to return -3, but it returned %d\n", err);
+    params.nHarmonics = 1;
+    params.harmonics = NULL;
+    err = ikIpc_initBuffer(&ipc, &params, buffer, ikIpc_getBufferSize(&params));
+    if (-3 != err) printf("%%TEST_FAILED%% time=0 testname=testHarmonics (ikIpc_test) message=init expected to return -3, but it returned %d\n", err);
+    params.harmonics = harmonics;
+    harmonics[0].order = 1;
+    err = ikIpc_initBuffer(&ipc, &params, buffer, ikIpc_getBufferSize(&params));
+    if (-4 != err) printf("%%TEST_FAILED%% time=0 testname=testHarmonics (ikIpc_test) message=init expected to return -4, but it returned %d\n", err);
+    harmonics[0].order = IKIPC_MAXORDER + 1;
+    err = ikIpc_initBuffer(&ipc, &params, buffer, ikIpc_getBufferSize(&params));
+    if (-4 != err) printf("%%TEST_FAILED%% time=0 testname=testHarmonics (ikIpc_test) message=init expected to return -4, but it returned %d\n", err);
+    harmonics[0].order = 2;
+    err = ikIpc_initBuffer(&ipc, &params, buffer, ikIpc_getBufferSize(&params) - 1);
+    if (-6 != err) printf("%%TEST_FAILED%% time=0 testname=testHarmonics (ikIpc_test) message=init expected to return -6, but it returned %d\n", err);
+    err = ikIpc_init(&ipc, &params);
+    if (-6 != err) printf("%%TEST_FAILED%% time=0 testname=testHarmonics (ikIpc_test) message=init expected to return -6, but it returned %d\n", err);
+    err = ikIpc_getOutput(&ipc, &output, "harmonic 1 My");
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testHarmonics (ikIpc_test) message=getOutput expected to return -1 without harmonics, but it returned %d\n", err);
+    free(buffer);
+    
+}
+
+/**
+ * Rotors with other numbers of blades are transformed as the reference
+ */
+void testBlades() {
+    printf("ikIpc_test testBlades\n");
+    /* declare error code */
+    int err;
+    /* declare instance */
+    ikIpc ipc;
+    /* declare initialisation parameters */
+    ikIpcParams params;
+    ikVector moment;
+    ikVector staticPitch;
+    double output;
+    double expected;
+    double scale;
+    double maxError = 0.0;
+    double harmonicPitchY;
+    double harmonicPitchZ;
+    double angle;
+    char name[32];
+    int nBlades;
+    int i;
+    int j;
+    int k;
+    int l;
+    ikIpcHarmonicParams harmonic;
+    void *buffer;
+    
+    ikIpc_initHarmonicParams(&harmonic);
+    for (nBlades = 2; nBlades <= IKIPC_MAXBLADES; nBlades++) {
+        for (l = 0; l < 2; l++) {
+            /* initialise instance */
+            ikIpc_initParams(&params);
+            params.nBlades = nBlades;
+            params.bladeOrder = l ? -1 : 1;
+            params.azimuthOffset = 37.5;
+            harmonic.order = nBlades;
+            params.nHarmonics = 1;
+            params.harmonics = &harmonic;
+            buffer = malloc(ikIpc_getBufferSize(&params));
+            err = ikIpc_initBuffer(&ipc, &params, buffer, ikIpc_getBufferSize(&params));
+            if (err) printf("%%TEST_FAILED%% time=0 testname=testBlades (ikIpc_test) message=init expected to return 0 for %d blades, but it returned %d\n", nBlades, err);
+            ipc.in.collectivePitch = 10.0;
+            ipc.in.maximumPitch = 90.0;
+            ipc.in.minimumPitch = 0.0;
+            ipc.in.maximumIndividualPitch = 5.0;
+            
+            for (k = 0; k < 500; k++) {
+                ipc.in.azimuth = 7.3 * k - 500.0;
+                for (i = 0; i < IKIPC_MAXBLADES; i++) {
+                    for (j = 0; j < 3; j++) ipc.in.bladeRootMoments[i].c[j] = ikTestUtil_rand(-5000.0, 5000.0);
+                }
+                ipc.in.demandedMy = ikTestUtil_rand(-5.0, 5.0);
+                ipc.in.demandedMz = ikTestUtil_rand(-5.0, 5.0);
+                ipc.in.externalPitchY = ikTestUtil_rand(-1.0, 1.0);
+                ipc.in.externalPitchZ = ikTestUtil_rand(-1.0, 1.0);
+                ikIpc_step(&ipc);
+                
+                /* static moments, from the moments of the blades in use only */
+                moment = referenceStaticMoment(&(ipc.in), params.azimuthOffset, params.bladeOrder, nBlades);
+                scale = 1.0;
+                for (i = 0; i < nBlades; i++) scale += fabs(ipc.in.bladeRootMoments[i].c[1]) + fabs(ipc.in.bladeRootMoments[i].c[2]);
+                ikIpc_getOutput(&ipc, &output, "My");
+                if (fabs(output - moment.c[1]) / scale > maxError) maxError = fabs(output - moment.c[1]) / scale;
+                ikIpc_getOutput(&ipc, &output, "Mz");
+                if (fabs(output - moment.c[2]) / scale > maxError) maxError = fabs(output - moment.c[2]) / scale;
+                
+                /* pitch angles, with the harmonic loop acting as well */
+                staticPitch.c[0] = 0.0;
+                ikIpc_getOutput(&ipc, &(staticPitch.c[1]), "pitch y");
+                ikIpc_getOutput(&ipc, &(staticPitch.c[2]), "pitch z");
+                scale = 1.0 + fabs(ipc.in.collectivePitch) + fabs(staticPitch.c[1]) + fabs(staticPitch.c[2]);
+                ikIpc_getOutput(&ipc, &harmonicPitchY, "harmonic 1 pitch y from control");
+                ikIpc_getOutput(&ipc, &harmonicPitchZ, "harmonic 1 pitch z from control");
+                scale += fabs(harmonicPitchY) + fabs(harmonicPitchZ);
+                for (i = 0; i < nBlades; i++) {
+                    angle = nBlades * (ipc.in.azimuth/180.0*3.14159265358979 + params.azimuthOffset/180.0*3.14159265358979 + params.bladeOrder * i * 2.0/nBlades*3.14159265358979);
+                    expected = ipc.in.collectivePitch + referencePitchIncrement(&(ipc.in), params.azimuthOffset, params.bladeOrder, nBlades, i, staticPitch);
+                    expected += cos(angle)*harmonicPitchZ - sin(angle)*harmonicPitchY;
+                    if (fabs(ipc.out.pitch[i] - expected) / scale > maxError) maxError = fabs(ipc.out.pitch[i] - expected) / scale;
+                }
+                
+                /* pitch increments, as outputs */
+                for (i = 0; i < nBlades; i++) {
+                    sprintf(name, "pitch increment %d", i + 1);
+                    err = ikIpc_getOutput(&ipc, &output, name);
+                    if (err) printf("%%TEST_FAILED%% time=0 testname=testBlades (ikIpc_test) message=getOutput expected to return 0 for %s with %d blades, but it returned %d\n", name, nBlades, err);
+                    if (fabs(ipc.in.collectivePitch + output - ipc.out.pitch[i]) > 1e-9) printf("%%TEST_FAILED%% time=0 testname=testBlades (ikIpc_test) message=%s expected to be %f, but is %f\n", name, ipc.out.pitch[i] - ipc.in.collectivePitch, output);
+                }
+                
+                /* the blades beyond the last are left alone */
+                for (i = nBlades; i < IKIPC_MAXBLADES; i++) {
+                    if (0.0 != ipc.out.pitch[i]) printf("%%TEST_FAILED%% time=0 testname=testBlades (ikIpc_test) message=pitch %d expected to be 0 with %d blades, but is %f\n", i + 1, nBlades, ipc.out.pitch[i]);
+                }
+            }
+            sprintf(name, "pitch increment %d", nBlades + 1);
+            err = ikIpc_getOutput(&ipc, &output, name);
+            if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testBlades (ikIpc_test) message=getOutput expected to return -1 for %s with %d blades, but it returned %d\n", name, nBlades, err);
+            free(buffer);
+        }
+    }
+    if (1e-12 < maxError) printf("%%TEST_FAILED%% time=0 testname=testBlades (ikIpc_test) message=the outputs differ from the reference by up to %g, relative to the inputs\n", maxError);
+    
+    /* see that invalid numbers of blades are reported */
+    ikIpc_initParams(&params);
+    params.nBlades = 1;
+    err = ikIpc_init(&ipc, &params);
+    if (-7 != err) printf("%%TEST_FAILED%% time=0 testname=testBlades (ikIpc_test) message=init expected to return -7 for 1 blade, but it returned %d\n", err);
+    params.nBlades = IKIPC_MAXBLADES + 1;
+    err = ikIpc_init(&ipc, &params);
+    if (-7 != err) printf("%%TEST_FAILED%% time=0 testname=testBlades (ikIpc_test) message=init expected to return -7 for %d blades, but it returned %d\n", IKIPC_MAXBLADES + 1, err);
+    
+}
+
+/**
+ * Preview feedforward acts as specified, and not at all when disabled
+ */
+void testPreview() {
+    printf("ikIpc_test testPreview\n");
+    /* declare error code */
+    int err;
+    /* declare instances */
+    ikIpc ipc;
+    ikIpc ipcOff;
+    ikIpc ipcZero;
+    /* declare initialisation parameters */
+    ikIpcParams params;
+    const double weights[4] = {1.0, 2.0, 3.0, 4.0};
+    double output;
+    double expectedY;
+    double expectedZ;
+    double pitchY;
+    double pitchZ;
+    double pitchYcon;
+    double pitchZcon;
+    double maxPitch;
+    int i;
+    int j;
+    int k;
+    
+    /* initialise the instances: the default one, one with preview disabled */
+    /* but gains set, and one with preview enabled but no gains */
+    ikIpc_initParams(&params);
+    err = ikIpc_init(&ipc, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testPreview (ikIpc_test) message=init expected to return 0, but it returned %d\n", err);
+    params.feedforwardGainMy = -0.001;
+    params.feedforwardGainMz = 0.002;
+    err = ikIpc_init(&ipcOff, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testPreview (ikIpc_test) message=init expected to return 0, but it returned %d\n", err);
+    params.feedforwardGainMy = 0.0;
+    params.feedforwardGainMz = 0.0;
+    params.previewHorizon = IKIPC_MAXPREVIEW;
+    err = ikIpc_init(&ipcZero, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testPreview (ikIpc_test) message=init expected to return 0, but it returned %d\n", err);
+    
+    /* see that the pitch angles are the same, whatever the predictions */
+    for (k = 0; k < 200; k++) {
+        ipc.in.azimuth = 7.3 * k;
+        ipc.in.collectivePitch = 10.0;
+        ipc.in.maximumPitch = 90.0;
+        ipc.in.minimumPitch = 0.0;
+        ipc.in.maximumIndividualPitch = 5.0;
+        for (i = 0; i < 3; i++) {
+            for (j = 0; j < 3; j++) ipc.in.bladeRootMoments[i].c[j] = ikTestUtil_rand(-5000.0, 5000.0);
+        }
+        ipc.in.externalPitchY = ikTestUtil_rand(-1.0, 1.0);
+        ipc.in.externalPitchZ = ikTestUtil_rand(-1.0, 1.0);
+        for (i = 0; i < IKIPC_MAXPREVIEW; i++) {
+            ipc.in.previewMy[i] = ikTestUtil_rand(-5000.0, 5000.0);
+            ipc.in.previewMz[i] = ikTestUtil_rand(-5000.0, 5000.0);
+        }
+        ipcOff.in = ipc.in;
+        ipcZero.in = ipc.in;
+        for (i = 0; i < IKIPC_MAXPREVIEW; i++) {
+            ipc.in.previewMy[i] = 0.0;
+            ipc.in.previewMz[i] = 0.0;
+        }
+        ikIpc_step(&ipc);
+        ikIpc_step(&ipcOff);
+        ikIpc_step(&ipcZero);
+        for (i = 0; i < 3; i++) {
+            if (ipc.out.pitch[i] != ipcOff.out.pitch[i]) printf("%%TEST_FAILED%% time=0 testname=testPreview (ikIpc_test) message=pitch %d with preview disabled expected to be %.17g, but is %.17g\n", i + 1, ipc.out.pitch[i], ipcOff.out.pitch[i]);
+            if (ipc.out.pitch[i] != ipcZero.out.pitch[i]) printf("%%TEST_FAILED%% time=0 testname=testPreview (ikIpc_test) message=pitch %d with no feedforward gains expected to be %.17g, but is %.17g\n", i + 1, ipc.out.pitch[i], ipcZero.out.pitch[i]);
+        }
+    }
+    
+    /* see that the feedforward pitch angles are the weighted sums of the */
+    /* predictions within the horizon, and are added to those from control */
+    ikIpc_initParams(&params);
+    params.previewHorizon = 4;
+    for (i = 0; i < 4; i++) params.previewWeights[i] = weights[i];
+    params.feedforwardGainMy = -0.0001;
+    params.feedforwardGainMz = 0.0002;
+    err = ikIpc_init(&ipc, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testPreview (ikIpc_test) message=init expected to return 0, but it returned %d\n", err);
+    ipc.in.collectivePitch = 10.0;
+    ipc.in.maximumPitch = 90.0;
+    ipc.in.minimumPitch = 0.0;
+    ipc.in.maximumIndividualPitch = 5.0;
+    for (k = 0; k < 200; k++) {
+        ipc.in.azimuth = 7.3 * k;
+        for (i = 0; i < 3; i++) {
+            for (j = 0; j < 3; j++) ipc.in.bladeRootMoments[i].c[j] = ikTestUtil_rand(-500.0, 500.0);
+        }
+        expectedY = 0.0;
+        expectedZ = 0.0;
+        for (i = 0; i < IKIPC_MAXPREVIEW; i++) {
+            ipc.in.previewMy[i] = ikTestUtil_rand(-5000.0, 5000.0);
+            ipc.in.previewMz[i] = ikTestUtil_rand(-5000.0, 5000.0);
+            if (4 > i) {
+                expectedZ += -0.0001 * weights[i] / 10.0 * ipc.in.previewMy[i];
+                expectedY += 0.0002 * weights[i] / 10.0 * ipc.in.previewMz[i];
+            }
+        }
+        ikIpc_step(&ipc);
+        ikIpc_getOutput(&ipc, &output, "feedforward pitch y");
+        if (fabs(output - expectedY) > 1e-12) printf("%%TEST_FAILED%% time=0 testname=testPreview (ikIpc_test) message=feedforward pitch y expected to be %.17g, but is %.17g\n", expectedY, output);
+        ikIpc_getOutput(&ipc, &output, "feedforward pitch z");
+        if (fabs(output - expectedZ) > 1e-12) printf("%%TEST_FAILED%% time=0 testname=testPreview (ikIpc_test) message=feedforward pitch z expected to be %.17g, but is %.17g\n", expectedZ, output);
+        ikIpc_getOutput(&ipc, &pitchY, "pitch y");
+        ikIpc_getOutput(&ipc, &pitchZ, "pitch z");
+        ikIpc_getOutput(&ipc, &pitchYcon, "pitch y from control");
+        ikIpc_getOutput(&ipc, &pitchZcon, "pitch z from control");
+        if (fabs(pitchY - (-pitchYcon + expectedY)) > 1e-12) printf("%%TEST_FAILED%% time=0 testname=testPreview (ikIpc_test) message=pitch y expected to be %.17g, but is %.17g\n", -pitchYcon + expectedY, pitchY);
+        if (fabs(pitchZ - (pitchZcon + expectedZ)) > 1e-12) printf("%%TEST_FAILED%% time=0 testname=testPreview (ikIpc_test) message=pitch z expected to be %.17g, but is %.17g\n", pitchZcon + expectedZ, pitchZ);
+        
+        /* the control loops are left what the feedforward does not use */
+        ikIpc_getOutput(&ipc, &maxPitch, "maximum pitch z");
+        if (maxPitch > 5.0 - sqrt(expectedY*expectedY + expectedZ*expectedZ) + 1e-12) printf("%%TEST_FAILED%% time=0 testname=testPreview (ikIpc_test) message=maximum pitch z expected to be at most %.17g, but is %.17g\n", 5.0 - sqrt(expectedY*expectedY + expectedZ*expectedZ), maxPitch);
+    }
+    
+    /* see that large predictions saturate the feedforward to the maximum */
+    /* pitch increment module, in the same direction, leaving nothing to the */
+    /* control loops */
+    for (i = 0; i < IKIPC_MAXPREVIEW; i++) {
+        ipc.in.previewMy[i] = 1e6;
+        ipc.in.previewMz[i] = 1e6;
+    }
+    ikIpc_step(&ipc);
+    ikIpc_getOutput(&ipc, &pitchY, "feedforward pitch y");
+    ikIpc_getOutput(&ipc, &pitchZ, "feedforward pitch z");
+    if ((fabs(sqrt(pitchY*pitchY + pitchZ*pitchZ) - 5.0) > 1e-12) || (fabs(pitchY + 2.0 * pitchZ) > 1e-12)) printf("%%TEST_FAILED%% time=0 testname=testPreview (ikIpc_test) message=feedforward pitch y and z expected to be %f and %f, but are %f and %f\n", 2.0 * sqrt(5.0), -sqrt(5.0), pitchY, pitchZ);
+    ikIpc_getOutput(&ipc, &maxPitch, "maximum pitch z");
+    if (0.0 != maxPitch) printf("%%TEST_FAILED%% time=0 testname=testPreview (ikIpc_test) message=maximum pitch z expected to be 0, but is %f\n", maxPitch);
+    ikIpc_getOutput(&ipc, &maxPitch, "maximum pitch y");
+    if (0.0 != maxPitch) printf("%%TEST_FAILED%% time=0 testname=testPreview (ikIpc_test) message=maximum pitch y expected to be 0, but is %f\n", maxPitch);
+    
+    /* see that invalid preview parameters are reported */
+    ikIpc_initParams(&params);
+    params.previewHorizon = -1;
+    err = ikIpc_init(&ipc, &params);
+    if (-8 != err) printf("%%TEST_FAILED%% time=0 testname=testPreview (ikIpc_test) message=init expected to return -8, but it returned %d\n", err);
+    params.previewHorizon = IKIPC_MAXPREVIEW + 1;
+    err = ikIpc_init(&ipc, &params);
+    if (-8 != err) printf("%%TEST_FAILED%% time=0 testname=testPreview (ikIpc_test) message=init expected to return -8, but it returned %d\n", err);
+    params.previewHorizon = 2;
+    params.previewWeights[1] = -1.0;
+    err = ikIpc_init(&ipc, &params);
+    if (-9 != err) printf("%%TEST_FAILED%% time=0 testname=testPreview (ikIpc_test) message=init expected to return -9, but it returned %d\n", err);
+    
+}
+
+/**
+ * Get output returns the right error codes
+ */
+void testGetOutputErrors() {
+    printf("ikIpc_test testGetOutputErrors\n");
+    /* declare error code */
+    int err;
+    /* declare output */
+    double output;
+    /* declare instance */
+    ikIpc ipc;
+    /* declare initialisation parameters */
+    ikIpcParams params;
+    
+    /* initialise instance */
+    ikIpc_initParams(&params);
+    ikIpc_init(&ipc, &params);
+    
+    /* see that invalid signal and block names are reported */
+    err = ikIpc_getOutput(&ipc, &output, "My");
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testGetOutputErrors (ikIpc_test) message=getOutput expected to return 0, but it returned %d\n", err);
+    err = ikIpc_getOutput(&ipc, &output, "Mx");
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testGetOutputErrors (ikIpc_test) message=getOutput expected to return -1, but it returned %d\n", err);
+    err = ikIpc_getOutput(&ipc, &output, "My control>control action");
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testGetOutputErrors (ikIpc_test) message=getOutput expected to return 0, but it returned %d\n", err);
+    err = ikIpc_getOutput(&ipc, &output, "Mx control>control action");
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=testGetOutputErrors (ikIpc_test) message=getOutput expected to return -2, but it returned %d\n", err);
+    
+}
+
+void testProfile() {
+    printf("ikIpc_test testProfile\n");
+    /* declare error code */
+    int err;
+    /* declare output */
+    double output;
+    /* declare instance */
+    ikIpc ipc;
+    /* declare initialisation parameters */
+    ikIpcParams params;
+    int i;
+    int k;
+    
+    /* initialise instance */
+    ikIpc_initParams(&params);
+    ikIpc_init(&ipc, &params);
+    
+    /* take 10 steps with room for individual pitch, and 5 without */
+    for (k = 0; k < 15; k++) {
+        ipc.in.azimuth = 7.3 * k;
+        ipc.in.collectivePitch = 10.0;
+        ipc.in.maximumPitch = 90.0;
+        ipc.in.minimumPitch = 0.0;
+        ipc.in.maximumIndividualPitch = 10 > k ? 5.0 : 0.0;
+        for (i = 0; i < 3; i++) ipc.in.bladeRootMoments[i].c[1] = 1000.0 * i;
+        ikIpc_step(&ipc);
+    }
+    
+#ifdef IKPROFILE
+    /* see that the steps are counted and timed, down to the linear controllers */
+    err = ikIpc_getOutput(&ipc, &output, "profile>calls");
+    if (err || (15.0 != output)) printf("%%TEST_FAILED%% time=0 testname=testProfile (ikIpc_test) message=profile>calls expected to be 15, but it is %f, error %d\n", output, err);
+    err = ikIpc_getOutput(&ipc, &output, "My control>profile>calls");
+    if (err || (15.0 != output)) printf("%%TEST_FAILED%% time=0 testname=testProfile (ikIpc_test) message=My control>profile>calls expected to be 15, but it is %f, error %d\n", output, err);
+    err = ikIpc_getOutput(&ipc, &output, "Mz control>linear controller>profile>calls");
+    if (err || (15.0 != output)) printf("%%TEST_FAILED%% time=0 testname=testProfile (ikIpc_test) message=Mz control>linear controller>profile>calls expected to be 15, but it is %f, error %d\n", output, err);
+    err = ikIpc_getOutput(&ipc, &output, "My control>profile>cycles");
+    if (err || (0.0 >= output)) printf("%%TEST_FAILED%% time=0 testname=testProfile (ikIpc_test) message=My control>profile>cycles expected to be positive, but it is %f, error %d\n", output, err);
+    
+    /* see that the steps with no room for individual pitch are saturated */
+    err = ikIpc_getOutput(&ipc, &output, "profile>saturations");
+    if (err || (5.0 > output)) printf("%%TEST_FAILED%% time=0 testname=testProfile (ikIpc_test) message=profile>saturations expected to be at least 5, but it is %f, error %d\n", output, err);
+    err = ikIpc_getOutput(&ipc, &output, "My control>profile>saturations");
+    if (err || (5.0 > output)) printf("%%TEST_FAILED%% time=0 testname=testProfile (ikIpc_test) message=My control>profile>saturations expected to be at least 5, but it is %f, error %d\n", output, err);
+    err = ikIpc_getOutput(&ipc, &output, "profile>cycle");
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testProfile (ikIpc_test) message=getOutput expected to return -1, but it returned %d\n", err);
+#else
+    /* see that there are no profiles */
+    err = ikIpc_getOutput(&ipc, &output, "profile>calls");
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=testProfile (ikIpc_test) message=getOutput expected to return -2, but it returned %d\n", err);
+    err = ikIpc_getOutput(&ipc, &output, "My control>profile>calls");
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testProfile (ikIpc_test) message=getOutput expected to return -1, but it returned %d\n", err);
+#endif
+    
+}
+
+/**
+ * Set the inputs for a step of the checkpoint test
+ */
+void checkpointInputs(ikIpc *ipc, int k) {
+    int i;
+    double angle;
+    ipc->in.azimuth = 3.7 * k;
+    ipc->in.collectivePitch = 10.0;
+    ipc->in.maximumPitch = 90.0;
+    ipc->in.minimumPitch = 0.0;
+    ipc->in.maximumIndividualPitch = 4.0;
+    for (i = 0; i < 3; i++) {
+        angle = (ipc->in.azimuth + 120.0 * i) / 180.0 * 3.14159265358979;
+        ipc->in.bladeRootMoments[i].c[1] = 1000.0 * cos(angle) + 300.0 * cos(2.0 * angle) + 100.0 * sin(0.01 * k);
+        ipc->in.bladeRootMoments[i].c[2] = 200.0 * sin(angle);
+    }
+}
+
+/**
+ * Make a control loop an integrator, for the checkpoint test
+ */
+void checkpointIntegrator(ikConLoopParams *params) {
+    params->linearController.errorTfs.tfParams[0].enable = 1;
+    params->linearController.errorTfs.tfParams[0].a[0] = 1.0;
+    params->linearController.errorTfs.tfParams[0].a[1] = -1.0;
+    params->linearController.errorTfs.tfParams[0].b[0] = -1e-4;
+}
+
+/**
+ * Runtime state saved to a checkpoint blob is restored exactly
+ */
+void testCheckpoint() {
+    printf("ikIpc_test testCheckpoint\n");
+    /* declare error code */
+    int err;
+    /* declare instances */
+    ikIpc ipc;
+    ikIpc other;
+    ikConLoop con;
+    /* declare initialisation parameters */
+    ikIpcParams params;
+    ikIpcHarmonicParams harmonics[2];
+    ikConLoopParams conParams;
+    void *buffer;
+    void *otherBuffer;
+    unsigned char *blob;
+    size_t size;
+    size_t length;
+    double pitch[100][3];
+    int nDiffering = 0;
+    int i;
+    int k;
+    
+    /* initialise two instances with integral 1P and 2P loops, and take some */
+    /* steps with one */
+    ikIpc_initParams(&params);
+    checkpointIntegrator(&(params.controlMy));
+    checkpointIntegrator(&(params.controlMz));
+    for (i = 0; i < 2; i++) {
+        ikIpc_initHarmonicParams(&(harmonics[i]));
+        harmonics[i].order = i + 2;
+        checkpointIntegrator(&(harmonics[i].controlMy));
+        checkpointIntegrator(&(harmonics[i].controlMz));
+    }
+    params.nHarmonics = 2;
+    params.harmonics = harmonics;
+    buffer = malloc(ikIpc_getBufferSize(&params));
+    otherBuffer = malloc(ikIpc_getBufferSize(&params));
+    params.nHarmonics = 1;
+    ikIpc_initBuffer(&ipc, &params, buffer, ikIpc_getBufferSize(&params));
+    ikIpc_initBuffer(&other, &params, otherBuffer, ikIpc_getBufferSize(&params));
+    for (k = 0; k < 300; k++) {
+        checkpointInputs(&ipc, k);
+        ikIpc_step(&ipc);
+    }
+    
+    /* save its state, finding out the length first */
+    err = ikIpc_saveState(&ipc, NULL, 0, &size);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testCheckpoint (ikIpc_test) message=saveState expected to return -1 without a buffer, but it returned %d\n", err);
+    blob = (unsigned char *) malloc(size);
+    err = ikIpc_saveState(&ipc, blob, size, &length);
+    if (err || (size != length)) printf("%%TEST_FAILED%% time=0 testname=testCheckpoint (ikIpc_test) message=saveState expected to return 0 and %d bytes, but it returned %d and %d bytes\n", (int) size, err, (int) length);
+    
+    /* take some more steps */
+    for (k = 300; k < 400; k++) {
+        checkpointInputs(&ipc, k);
+        ikIpc_step(&ipc);
+        for (i = 0; i < 3; i++) pitch[k - 300][i] = ipc.out.pitch[i];
+    }
+    
+    /* see that the other instance, restored, takes exactly the same steps, */
+    /* and that it would not have without the restore */
+    err = ikIpc_restoreState(&other, blob, size);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testCheckpoint (ikIpc_test) message=restoreState expected to return 0, but it returned %d\n", err);
+    for (k = 300; k < 400; k++) {
+        checkpointInputs(&other, k);
+        ikIpc_step(&other);
+        for (i = 0; i < 3; i++) nDiffering += (pitch[k - 300][i] != other.out.pitch[i]);
+    }
+    if (nDiffering) printf("%%TEST_FAILED%% time=0 testname=testCheckpoint (ikIpc_test) message=expected the same pitch angles after restoring, but %d differed\n", nDiffering);
+    ikIpc_initBuffer(&other, &params, otherBuffer, ikIpc_getBufferSize(&params));
+    checkpointInputs(&other, 300);
+    ikIpc_step(&other);
+    if (pitch[0][0] == other.out.pitch[0]) printf("%%TEST_FAILED%% time=0 testname=testCheckpoint (ikIpc_test) message=expected different pitch angles without restoring\n");
+    
+    /* see that the first instance goes back too */
+    err = ikIpc_restoreState(&ipc, blob, size);
+    checkpointInputs(&ipc, 300);
+    ikIpc_step(&ipc);
+    if (err || (pitch[0][1] != ipc.out.pitch[1])) printf("%%TEST_FAILED%% time=0 testname=testCheckpoint (ikIpc_test) message=expected the same pitch angle after going back, but it was %f instead of %f, error %d\n", ipc.out.pitch[1], pitch[0][1], err);
+    
+    /* see that bad blobs are rejected, leaving the instance as it was */
+    err = ikIpc_restoreState(&ipc, blob, size - 1);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testCheckpoint (ikIpc_test) message=restoreState expected to return -1 for a truncated blob, but it returned %d\n", err);
+    blob[size - 1] ^= 1;
+    err = ikIpc_restoreState(&ipc, blob, size);
+    if (-5 != err) printf("%%TEST_FAILED%% time=0 testname=testCheckpoint (ikIpc_test) message=restoreState expected to return -5 for a corrupt blob, but it returned %d\n", err);
+    blob[size - 1] ^= 1;
+    ikConLoop_initParams(&conParams);
+    ikConLoop_init(&con, &conParams);
+    err = ikConLoop_restoreState(&con, blob, size);
+    if (-4 != err) printf("%%TEST_FAILED%% time=0 testname=testCheckpoint (ikIpc_test) message=ikConLoop_restoreState expected to return -4, but it returned %d\n", err);
+    params.nHarmonics = 2;
+    ikIpc_initBuffer(&other, &params, otherBuffer, ikIpc_getBufferSize(&params));
+    err = ikIpc_restoreState(&other, blob, size);
+    if (-6 != err) printf("%%TEST_FAILED%% time=0 testname=testCheckpoint (ikIpc_test) message=restoreState expected to return -6 for another number of harmonics, but it returned %d\n", err);
+    params.nHarmonics = 1;
+    ikIpc_initBuffer(&other, &params, otherBuffer, ikIpc_getBufferSize(&params));
+    other.priv.conMy.selectedRegion = other.priv.conMy.regionSelector.tables.regionN + 1;
+    ikIpc_saveState(&other, blob, size, &length);
+    err = ikIpc_restoreState(&ipc, blob, size);
+    if (-6 != err) printf("%%TEST_FAILED%% time=0 testname=testCheckpoint (ikIpc_test) message=restoreState expected to return -6 for a region out of range, but it returned %d\n", err);
+    ikIpc_initBuffer(&other, &params, otherBuffer, ikIpc_getBufferSize(&params));
+    other.priv.conMz.stpgen.phase = 3;
+    ikIpc_saveState(&other, blob, size, &length);
+    err = ikIpc_restoreState(&ipc, blob, size);
+    if (-6 != err) printf("%%TEST_FAILED%% time=0 testname=testCheckpoint (ikIpc_test) message=restoreState expected to return -6 for a phase out of range, but it returned %d\n", err);
+    ikIpc_initBuffer(&other, &params, otherBuffer, ikIpc_getBufferSize(&params));
+    other.priv.conMz.stpgen.zone = -1;
+    ikIpc_saveState(&other, blob, size, &length);
+    err = ikIpc_restoreState(&ipc, blob, size);
+    if (-6 != err) printf("%%TEST_FAILED%% time=0 testname=testCheckpoint (ikIpc_test) message=restoreState expected to return -6 for a zone out of range, but it returned %d\n", err);
+    checkpointInputs(&ipc, 301);
+    ikIpc_step(&ipc);
+    if (pitch[1][2] != ipc.out.pitch[2]) printf("%%TEST_FAILED%% time=0 testname=testCheckpoint (ikIpc_test) message=expected the instance to be left as it was by bad blobs\n");
+    
+    free(blob);
+    free(otherBuffer);
+    free(buffer);
+    
+}
+
+int main(int argc, char** argv) {
+    printf("%%SUITE_STARTING%% ikIpc_test\n");
+    printf("%%SUITE_STARTED%%\n");
+
+    printf("%%TEST_STARTED%% testDefault (ikIpc_test)\n");
+    testDefault();
+    printf("%%TEST_FINISHED%% time=0 testDefault (ikIpc_test) \n");
+
+    printf("%%TEST_STARTED%% testTransforms (ikIpc_test)\n");
+    testTransforms();
+    printf("%%TEST_FINISHED%% time=0 testTransforms (ikIpc_test) \n");
+
+    printf("%%TEST_STARTED%% testHarmonics (ikIpc_test)\n");
+    testHarmonics();
+    printf("%%TEST_FINISHED%% time=0 testHarmonics (ikIpc_test) \n");
+
+    printf("%%TEST_STARTED%% testBlades (ikIpc_test)\n");
+    testBlades();
+    printf("%%TEST_FINISHED%% time=0 testBlades (ikIpc_test) \n");
+
+    printf("%%TEST_STARTED%% testPreview (ikIpc_test)\n");
+    testPreview();
+    printf("%%TEST_FINISHED%% time=0 testPreview (ikIpc_test) \n");
+
+    printf("%%TEST_STARTED%% testGetOutputErrors (ikIpc_test)\n");
+    testGetOutputErrors();
+    printf("%%TEST_FINISHED%% time=0 testGetOutputErrors (ikIpc_test) \n");
+
+    printf("%%TEST_STARTED%% testProfile (ikIpc_test)\n");
+    testProfile();
+    printf("%%TEST_FINISHED%% time=0 testProfile (ikIpc_test) \n");
+
+    printf("%%TEST_STARTED%% testCheckpoint (ikIpc_test)\n");
+    testCheckpoint();
+    printf("%%TEST_FINISHED%% time=0 testCheckpoint (ikIpc_test) \n");
+
+    printf("%%SUITE_FINISHED%% time=0\n");
+
+    return (EXIT_SUCCESS);
+}
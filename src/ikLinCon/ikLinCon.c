@@ -29,6 +29,206 @@ along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
 #include <string.h>
 #include "../ikLinCon/ikLinCon.h"
 
+/**
+ * (Private) get a saturation event counter of a transfer function list
+ * @param tfList transfer function list
+ * @param output counter value
+ * @param separator part of the output name from the separator ">" on, or NULL
+ * @return error code:
+ *  0: no error
+ * -1: not a counter name
+ */
+int ikLinCon_getSatCount(const ikTfListN *tfList, double *output, const char *separator) {
+    ikSltiSatCounts counts;
+#ifdef IKSLTI_NSATHIST
+    int k;
+#endif
+
+    if (NULL == separator) return -1;
+    ikTfListN_getSatCounts(tfList, &counts);
+    if (!strcmp(separator, ">input saturations")) {
+        *output = (double) counts.inputSaturations;
+        return 0;
+    }
+    if (!strcmp(separator, ">output saturations")) {
+        *output = (double) counts.outputSaturations;
+        return 0;
+    }
+    if (!strcmp(separator, ">saturated steps")) {
+        *output = (double) counts.saturatedSteps;
+        return 0;
+    }
+#ifdef IKSLTI_NSATHIST
+    if (!strncmp(separator, ">saturation runs>", 17)) {
+        k = atoi(separator + 17);
+        if ((0 > k) || (IKSLTI_NSATHIST - 1 < k)) return -1;
+        *output = (double) counts.runs[k];
+        return 0;
+    }
+#endif
+
+    return -1;
+}
+
+/**
+ * (Private) get the number of transfer functions of a list up to the last one
+ * in use, i.e. enabled or with a variable enable flag
+ */
+int ikLinCon_nTfs(const ikTfParams params[], int n) {
+    while ((0 < n) && !(params[n - 1].enable) && (NULL == params[n - 1].variableEnable)) n--;
+    return n;
+}
+
+/**
+ * (Private) get the number of notch filters of a list up to the last one in
+ * use, i.e. enabled or with a variable enable flag
+ */
+int ikLinCon_nNotches(const ikNotchParams params[], int n) {
+    while ((0 < n) && !(params[n - 1].enable) && (NULL == params[n - 1].variableEnable)) n--;
+    return n;
+}
+
+/**
+ * (Private) copy the initialisation parameters of a transfer function list,
+ * from the caller arrays if given, or else from the fixed size field
+ * @return number of transfer functions
+ */
+int ikLinCon_copyTfParams(ikTfListParams *copy, const ikTfListParams *fixed, const ikLinConTfListParams *sized) {
+    int i;
+    
+    *copy = *fixed;
+    if (NULL == sized->items) return IKTFLIST_NMAX;
+    if ((0 > sized->n) || (IKTFLIST_NMAX < sized->n)) return sized->n;
+    for (i = 0; i < sized->n; i++) copy->tfParams[i] = sized->tfParams[i];
+    return sized->n;
+}
+
+/**
+ * (Private) copy the initialisation parameters of a notch filter list, as
+ * ikLinCon_copyTfParams
+ * @return number of notch filters
+ */
+int ikLinCon_copyNotchParams(ikNotchListParams *copy, const ikNotchListParams *fixed, const ikLinConNotchListParams *sized) {
+    int i;
+    
+    *copy = *fixed;
+    if (NULL == sized->items) return IKNOTCHLIST_NMAX;
+    copy->dT = sized->dT;
+    if ((0 > sized->n) || (IKNOTCHLIST_NMAX < sized->n)) return sized->n;
+    for (i = 0; i < sized->n; i++) copy->notchParams[i] = sized->notchParams[i];
+    return sized->n;
+}
+
+/**
+ * (Private) initialise a transfer function list, in the caller array if
+ * given, or else in the instance's own, checking all the transfer functions
+ * but only keeping those up to the last one in use
+ * @param list transfer function list
+ * @param n number of transfer functions
+ * @param params transfer function initialisation parameters
+ * @param items caller array, or NULL
+ * @param tfs array of the instance's own transfer functions
+ * @param used number of the instance's own transfer functions already taken
+ * @return error code:
+ *  0: no error
+ * -1: invalid number of transfer functions, or no room for them
+ * -x: could not initialise x-th transfer function (starting at 1)
+ */
+int ikLinCon_initTfList(ikTfListN *list, int n, const ikTfParams params[], ikTfListItem items[], ikTfListItem tfs[], int *used) {
+    ikTfListItem buffer[IKTFLIST_NMAX];
+    int err;
+    int m;
+    
+    /* check the number of transfer functions */
+    if ((0 > n) || (IKTFLIST_NMAX < n)) {
+        ikTfListN_init(list, 0, params, items);
+        return -1;
+    }
+    
+    /* in the caller array, all of them */
+    if (NULL != items) {
+        err = ikTfListN_init(list, n, params, items);
+        return (0 > err) ? err : 0;
+    }
+    
+    /* in the instance's own, only those up to the last one in use */
+    err = ikTfListN_init(list, n, params, buffer);
+    m = ikLinCon_nTfs(params, n);
+    if (IKLINCON_NTFS - *used < m) {
+        ikTfListN_init(list, 0, params, tfs);
+        return -1;
+    }
+    ikTfListN_init(list, m, params, tfs + *used);
+    *used += m;
+    return (0 > err) ? err : 0;
+}
+
+/**
+ * (Private) initialise a notch filter list, as ikLinCon_initTfList
+ * @return error code, as that of ikLinCon_initTfList, or 1: invalid sampling
+ * time
+ */
+int ikLinCon_initNotchList(ikNotchListN *list, double dT, int n, const ikNotchParams params[], ikNotchListItem items[], ikNotchListItem notches[], int *used) {
+    ikNotchListItem buffer[IKNOTCHLIST_NMAX];
+    int err;
+    int m;
+    
+    /* check the number of notch filters */
+    if ((0 > n) || (IKNOTCHLIST_NMAX < n)) {
+        ikNotchListN_init(list, dT, 0, params, items);
+        return -1;
+    }
+    
+    /* in the caller array, all of them */
+    if (NULL != items) {
+        err = ikNotchListN_init(list, dT, n, params, items);
+        return (2 == err) ? 0 : err;
+    }
+    
+    /* in the instance's own, only those up to the last one in use */
+    err = ikNotchListN_init(list, dT, n, params, buffer);
+    m = ikLinCon_nNotches(params, n);
+    if (IKLINCON_NNOTCHES - *used < m) {
+        ikNotchListN_init(list, dT, 0, params, notches);
+        return -1;
+    }
+    ikNotchListN_init(list, dT, m, params, notches + *used);
+    *used += m;
+    return (2 == err) ? 0 : err;
+}
+
+/**
+ * (Private) get the output of a transfer function of a list, where those not
+ * run pass the input of the list through
+ */
+double ikLinCon_getTfOutput(const ikTfListN *list, int index, double input) {
+    if ((0 < list->n) && (list->n > index)) return ikTfListN_getOutput(list, index);
+    return input;
+}
+
+/**
+ * (Private) get the output of a notch filter of a list, where those not run
+ * pass the input of the list through
+ */
+double ikLinCon_getNotchOutput(const ikNotchListN *list, int index, double input) {
+    if ((0 < list->n) && (list->n > index)) return ikNotchListN_getOutput(list, index);
+    return input;
+}
+
+/**
+ * (Private) get the signal out of a notch filter list, from the signal into
+ * it and the outputs of the enabled notch filters
+ */
+double ikLinCon_getNotchListSignal(const ikNotchListN *list, double input) {
+    double signal = input;
+    int i;
+    
+    for (i = list->n - 1; i >= 0; i--) {
+        if (list->items[i].enable) signal = ikVfnotch_getOutput(&(list->items[i].notch));
+    }
+    return signal;
+}
+
 int ikLinCon_init(ikLinCon *self, const ikLinConParams *params) {
     ikTfListParams demandTfs;
     ikTfListParams measurementTfs;
@@ -36,6 +236,14 @@ int ikLinCon_init(ikLinCon *self, const ikLinConParams *params) {
     ikTfListParams postGainTfs;
     ikNotchListParams demandNotches;
     ikNotchListParams measurementNotches;
+    int nDemandTfs;
+    int nMeasurementTfs;
+    int nErrorTfs;
+    int nPostGainTfs;
+    int nDemandNotches;
+    int nMeasurementNotches;
+    int tfsUsed = 0;
+    int notchesUsed = 0;
     int i;
     int j;
         
@@ -45,7 +253,9 @@ int ikLinCon_init(ikLinCon *self, const ikLinConParams *params) {
     
     /* initialise inputs */
     self->demand = 0.0;
+    self->filteredDemand = 0.0;
     self->measurement = 0.0;
+    self->filteredMeasurement = 0.0;
     self->gainSchedOutput = 0.0;
 
     /* register enable presets */
@@ -71,21 +281,25 @@ int ikLinCon_init(ikLinCon *self, const ikLinConParams *params) {
         }
     }
 
-    /* make copies of the list initialisation parameters */
-    demandTfs = params->demandTfs;
-    measurementTfs = params->measurementTfs;
-    errorTfs = params->errorTfs;
-    demandNotches = params->demandNotches;
-    measurementNotches = params->measurementNotches;
-    postGainTfs = params->postGainTfs;
+    /* make copies of the list initialisation parameters, from the caller */
+    /* arrays where given */
+    nDemandTfs = ikLinCon_copyTfParams(&demandTfs, &(params->demandTfs), &(params->demandTfList));
+    nMeasurementTfs = ikLinCon_copyTfParams(&measurementTfs, &(params->measurementTfs), &(params->measurementTfList));
+    nErrorTfs = ikLinCon_copyTfParams(&errorTfs, &(params->errorTfs), &(params->errorTfList));
+    nDemandNotches = ikLinCon_copyNotchParams(&demandNotches, &(params->demandNotches), &(params->demandNotchList));
+    nMeasurementNotches = ikLinCon_copyNotchParams(&measurementNotches, &(params->measurementNotches), &(params->measurementNotchList));
+    nPostGainTfs = ikLinCon_copyTfParams(&postGainTfs, &(params->postGainTfs), &(params->postGainTfList));
     
-    /* pass saturation limit pointers to post-gain transfer functions */
-    postGainTfs.tfParams[0].enable = 1;
-    postGainTfs.tfParams[0].maxOutput = params->maxControlAction;
-    postGainTfs.tfParams[0].minOutput = params->minControlAction;
-    postGainTfs.tfParams[IKTFLIST_NMAX-1].enable = 1;
-    postGainTfs.tfParams[IKTFLIST_NMAX-1].maxInput = params->maxPostGainValue;
-    postGainTfs.tfParams[IKTFLIST_NMAX-1].minInput = params->minPostGainValue;
+    /* pass saturation limit pointers to the first and last post-gain */
+    /* transfer functions */
+    if ((0 < nPostGainTfs) && (IKTFLIST_NMAX >= nPostGainTfs)) {
+        postGainTfs.tfParams[0].enable = 1;
+        postGainTfs.tfParams[0].maxOutput = params->maxControlAction;
+        postGainTfs.tfParams[0].minOutput = params->minControlAction;
+        postGainTfs.tfParams[nPostGainTfs-1].enable = 1;
+        postGainTfs.tfParams[nPostGainTfs-1].maxInput = params->maxPostGainValue;
+        postGainTfs.tfParams[nPostGainTfs-1].minInput = params->minPostGainValue;
+    }
 
     /* if a preset selector handle has been specified, make all the lists check */
     /* the current enable settings */
@@ -102,31 +316,56 @@ int ikLinCon_init(ikLinCon *self, const ikLinConParams *params) {
         }
     }
 
-    /* call ikTfList initialisation on all three lists */
-    err_ = ikTfList_init(&(self->demandTfList), &demandTfs);
+    /* initialise all the lists, in the caller arrays where given, or else */
+    /* in the instance's own, checking all the transfer functions and notch */
+    /* filters, but only keeping and running those up to the last one in use */
+    err_ = ikLinCon_initTfList(&(self->demandTfList), nDemandTfs, demandTfs.tfParams, params->demandTfList.items, self->tfs, &tfsUsed);
     if (!err && err_) err = -1;
-    err_ = ikTfList_init(&(self->measurementTfList), &measurementTfs);
+    err_ = ikLinCon_initTfList(&(self->measurementTfList), nMeasurementTfs, measurementTfs.tfParams, params->measurementTfList.items, self->tfs, &tfsUsed);
     if (!err && err_) err = -2;
-    err_ = ikTfList_init(&(self->errorTfList), &errorTfs);
+    err_ = ikLinCon_initTfList(&(self->errorTfList), nErrorTfs, errorTfs.tfParams, params->errorTfList.items, self->tfs, &tfsUsed);
     if (!err && err_) err = -3;
-
-    /* call ikNotchList initialisation on all three lists */
-    err_ = ikNotchList_init(&(self->demandNotchList), &demandNotches);
+    err_ = ikLinCon_initNotchList(&(self->demandNotchList), demandNotches.dT, nDemandNotches, demandNotches.notchParams, params->demandNotchList.items, self->notches, &notchesUsed);
     if (!err && err_) err = -4;
-    err_ = ikNotchList_init(&(self->measurementNotchList), &measurementNotches);
+    err_ = ikLinCon_initNotchList(&(self->measurementNotchList), measurementNotches.dT, nMeasurementNotches, measurementNotches.notchParams, params->measurementNotchList.items, self->notches, &notchesUsed);
     if (!err && err_) err = -5;
-    err_ = ikTfList_init(&(self->postGainTfList), &postGainTfs);
-    if (!err && err_) err = -6;
+    err_ = ikLinCon_initTfList(&(self->postGainTfList), nPostGainTfs, postGainTfs.tfParams, params->postGainTfList.items, self->tfs, &tfsUsed);
+    if (!err && (err_ || (0 == self->postGainTfList.n))) err = -6;
 
     /* initialise gain schedule */
     self->gainSchedX = params->gainShedXVal;
     ikLutbl_init(&(self->gainSched));
     err_ = ikLutbl_setPoints(&(self->gainSched), params->gainSchedN, params->gainSchedX, params->gainSchedY);
     if (!err && err_) err = -7;
+
+#ifdef IKPROFILE
+    ikProfile_init(&(self->profile));
+#endif
     
     return err;
 }
 
+/**
+ * (Private) initialise the parameters of a transfer function list held by
+ * the caller, so that the fixed size field is used instead
+ */
+void ikLinCon_initTfListParams(ikLinConTfListParams *params) {
+    params->n = 0;
+    params->tfParams = NULL;
+    params->items = NULL;
+}
+
+/**
+ * (Private) initialise the parameters of a notch filter list held by the
+ * caller, likewise
+ */
+void ikLinCon_initNotchListParams(ikLinConNotchListParams *params) {
+    params->dT = 1.0;
+    params->n = 0;
+    params->notchParams = NULL;
+    params->items = NULL;
+}
+
 void ikLinCon_initParams(ikLinConParams *params) {
     int i;
     int j;
@@ -174,6 +413,14 @@ void ikLinCon_initParams(ikLinConParams *params) {
     params->maxPostGainValue = NULL;
     params->minPostGainValue = NULL;
 
+    /* give the lists by the fixed size fields */
+    ikLinCon_initTfListParams(&(params->demandTfList));
+    ikLinCon_initTfListParams(&(params->measurementTfList));
+    ikLinCon_initTfListParams(&(params->errorTfList));
+    ikLinCon_initTfListParams(&(params->postGainTfList));
+    ikLinCon_initNotchListParams(&(params->demandNotchList));
+    ikLinCon_initNotchListParams(&(params->measurementNotchList));
+
 }
 
 double ikLinCon_step(ikLinCon *self, double demand, double measurement) {
@@ -181,6 +428,13 @@ double ikLinCon_step(ikLinCon *self, double demand, double measurement) {
     double demand_;
     double measurement_;
     double err;
+#ifdef IKPROFILE
+    int sat;
+    double minsat;
+    double maxsat;
+
+    ikProfile_start(&(self->profile));
+#endif
         
     /* register inputs */
     self->demand = demand;
@@ -204,28 +458,36 @@ double ikLinCon_step(ikLinCon *self, double demand, double measurement) {
 
     /* take step on demand path */
     demand_ = demand;
-    demand_ = ikNotchList_step(&(self->demandNotchList), demand_);
-    demand_ = ikTfList_step(&(self->demandTfList), demand_);
+    demand_ = ikNotchListN_step(&(self->demandNotchList), demand_);
+    demand_ = ikTfListN_step(&(self->demandTfList), demand_);
     self->filteredDemand = demand_;
 
     /* take step on measurement path */
     measurement_ = measurement;
-    measurement_ = ikNotchList_step(&(self->measurementNotchList), measurement_);
-    measurement_ = ikTfList_step(&(self->measurementTfList), measurement_);
+    measurement_ = ikNotchListN_step(&(self->measurementNotchList), measurement_);
+    measurement_ = ikTfListN_step(&(self->measurementTfList), measurement_);
     self->filteredMeasurement = measurement_;
 
     /* calculate error */
     err = demand_ - measurement_;
 
     /* take step on error path */
-    err = ikTfList_step(&(self->errorTfList), err);
+    err = ikTfListN_step(&(self->errorTfList), err);
 
     /* apply gain schedule */
     if (NULL != self->gainSchedX) err = err * ikLutbl_eval(&(self->gainSched), *(self->gainSchedX));
     self->gainSchedOutput = err;
     
     /* take step on post-gain path */
-    err = ikTfList_step(&(self->postGainTfList), err);
+    err = ikTfListN_step(&(self->postGainTfList), err);
+
+#ifdef IKPROFILE
+    /* count saturation at the control action limits */
+    sat = (0 < self->postGainTfList.n) ? ikSlti_getOutSat(&(self->postGainTfList.items[0].tf), &minsat, &maxsat) : 0;
+    if ((((-1 == sat) || (2 == sat)) && (minsat >= err))
+            || (((1 == sat) || (2 == sat)) && (maxsat <= err))) ikProfile_saturate(&(self->profile));
+    ikProfile_stop(&(self->profile));
+#endif
 
     return err;
 }
@@ -256,11 +518,12 @@ int ikLinCon_getOutput(const ikLinCon *self, double *output, const char *name) {
         return 0;
     }
     if (!strcmp(name, "error")) {
-        *output = ikTfList_getOutput(&(self->demandTfList), 0) - ikTfList_getOutput(&(self->measurementTfList), 0);
+        *output = ikLinCon_getTfOutput(&(self->demandTfList), 0, ikLinCon_getNotchListSignal(&(self->demandNotchList), self->demand))
+                - ikLinCon_getTfOutput(&(self->measurementTfList), 0, ikLinCon_getNotchListSignal(&(self->measurementNotchList), self->measurement));
         return 0;
     }
     if (!strcmp(name, "control action")) {
-        *output = ikTfList_getOutput(&(self->errorTfList), 0);
+        *output = ikLinCon_getTfOutput(&(self->errorTfList), 0, self->filteredDemand - self->filteredMeasurement);
         return 0;
     }
     if (!strcmp(name, "gain schedule")) {
@@ -272,6 +535,14 @@ int ikLinCon_getOutput(const ikLinCon *self, double *output, const char *name) {
         return 0;
     }
 
+#ifdef IKPROFILE
+    /* fetch profile counters */
+    if (!strncmp(name, "profile>", 8)) {
+        if (ikProfile_getOutput(&(self->profile), output, name + 8)) return -1;
+        return 0;
+    }
+#endif
+
     /* get block name length and index for block */
     blocklen = strlen(name);
     index = 0;
@@ -293,32 +564,36 @@ int ikLinCon_getOutput(const ikLinCon *self, double *output, const char *name) {
     /* fetch block values */
     if ((blocklen == strlen("post-gain transfer functions"))
             && !strncmp(name, "post-gain transfer functions", blocklen)) {
-        *output = ikTfList_getOutput(&(self->postGainTfList), index);
+        if (!ikLinCon_getSatCount(&(self->postGainTfList), output, separator)) return 0;
+        *output = ikLinCon_getTfOutput(&(self->postGainTfList), index, self->gainSchedOutput);
         return 0;
     }
     if ((blocklen == strlen("demand transfer functions"))
             && !strncmp(name, "demand transfer functions", blocklen)) {
-        *output = ikTfList_getOutput(&(self->demandTfList), index);
+        if (!ikLinCon_getSatCount(&(self->demandTfList), output, separator)) return 0;
+        *output = ikLinCon_getTfOutput(&(self->demandTfList), index, ikLinCon_getNotchListSignal(&(self->demandNotchList), self->demand));
         return 0;
     }
     if ((blocklen == strlen("measurement transfer functions"))
             && !strncmp(name, "measurement transfer functions", blocklen)) {
-        *output = ikTfList_getOutput(&(self->measurementTfList), index);
+        if (!ikLinCon_getSatCount(&(self->measurementTfList), output, separator)) return 0;
+        *output = ikLinCon_getTfOutput(&(self->measurementTfList), index, ikLinCon_getNotchListSignal(&(self->measurementNotchList), self->measurement));
         return 0;
     }
     if ((blocklen == strlen("error transfer functions"))
             && !strncmp(name, "error transfer functions", blocklen)) {
-        *output = ikTfList_getOutput(&(self->errorTfList), index);
+        if (!ikLinCon_getSatCount(&(self->errorTfList), output, separator)) return 0;
+        *output = ikLinCon_getTfOutput(&(self->errorTfList), index, self->filteredDemand - self->filteredMeasurement);
         return 0;
     }
     if ((blocklen == strlen("demand notch filters"))
             && !strncmp(name, "demand notch filters", blocklen)) {
-        *output = ikNotchList_getOutput(&(self->demandNotchList), index);
+        *output = ikLinCon_getNotchOutput(&(self->demandNotchList), index, self->demand);
         return 0;
     }
     if ((blocklen == strlen("measurement notch filters"))
             && !strncmp(name, "measurement notch filters", blocklen)) {
-        *output = ikNotchList_getOutput(&(self->measurementNotchList), index);
+        *output = ikLinCon_getNotchOutput(&(self->measurementNotchList), index, self->measurement);
         return 0;
     }
 
@@ -327,4 +602,110 @@ int ikLinCon_getOutput(const ikLinCon *self, double *output, const char *name) {
 }
 
 
+void ikLinCon_checkpoint(ikLinCon *self, ikCheckpoint *cp) {
+    int i;
+    
+    /* filter lists */
+    ikTfListN_checkpoint(&(self->postGainTfList), cp);
+    ikTfListN_checkpoint(&(self->errorTfList), cp);
+    ikTfListN_checkpoint(&(self->measurementTfList), cp);
+    ikTfListN_checkpoint(&(self->demandTfList), cp);
+    ikNotchListN_checkpoint(&(self->measurementNotchList), cp);
+    ikNotchListN_checkpoint(&(self->demandNotchList), cp);
+    
+    /* signals */
+    ikCheckpoint_double(cp, &(self->demand));
+    ikCheckpoint_double(cp, &(self->filteredDemand));
+    ikCheckpoint_double(cp, &(self->measurement));
+    ikCheckpoint_double(cp, &(self->filteredMeasurement));
+    ikCheckpoint_double(cp, &(self->gainSchedOutput));
+    
+    /* current enable settings */
+    for (i = 0; i < IKTFLIST_NMAX; i++) {
+        ikCheckpoint_int(cp, &(self->currentDemandTfsEnable[i]));
+        ikCheckpoint_int(cp, &(self->currentMeasurementTfsEnable[i]));
+        ikCheckpoint_int(cp, &(self->currentErrorTfsEnable[i]));
+    }
+    for (i = 0; i < IKNOTCHLIST_NMAX; i++) {
+        ikCheckpoint_int(cp, &(self->currentDemandNotchesEnable[i]));
+        ikCheckpoint_int(cp, &(self->currentMeasurementNotchesEnable[i]));
+    }
+}
+
+/**
+ * (Private) multiply by the frequency response of the enabled transfer
+ * functions of a list, with the given enable settings, or those of the list
+ * if NULL, at the given unit delays
+ */
+void ikLinCon_mulTfListFreqResp(const ikTfListN *list, const int enable[], int n, const double z[], double re[], double im[]) {
+    int i;
+    int enable_;
+
+    for (i = 0; i < list->n; i++) {
+        if (NULL != enable) enable_ = enable[i];
+        else enable_ = (NULL != list->items[i].varEnable) ? *(list->items[i].varEnable) : list->items[i].enable;
+        if (enable_) ikSlti_mulFreqRespDelays(&(list->items[i].tf), n, z, re, im);
+    }
+}
+
+/**
+ * (Private) multiply by the frequency response of the enabled notch filters
+ * of a list, with the given enable settings, or those of the list if NULL,
+ * at the given unit delays
+ */
+void ikLinCon_mulNotchListFreqResp(const ikNotchListN *list, const int enable[], int n, const double z[], double re[], double im[]) {
+    int i;
+    int enable_;
+
+    for (i = 0; i < list->n; i++) {
+        if (NULL != enable) enable_ = enable[i];
+        else enable_ = (NULL != list->items[i].variableEnable) ? *(list->items[i].variableEnable) : list->items[i].enable;
+        if (enable_) ikVfnotch_mulFreqRespDelays(&(list->items[i].notch), n, z, re, im);
+    }
+}
+
+int ikLinCon_freqResp(const ikLinCon *self, int config, double gainSchedX, int path, int n, const double w[], double re[], double im[]) {
+    const int *notchesEnable = NULL;
+    const int *tfsEnable = NULL;
+    const int *errorTfsEnable = NULL;
+    const ikNotchListN *notchList;
+    const ikTfListN *tfList;
+    double z[4*IKSLTI_FREQBLOCK];
+    double gain = 1.0;
+    int k;
+    int m;
+
+    /* check the path and the preset configuration */
+    if ((IKLINCON_DEMAND != path) && (IKLINCON_MEASUREMENT != path)) return -2;
+    if (NULL != self->config) {
+        if ((0 > config) || (self->configN <= config)) return -1;
+        notchesEnable = (IKLINCON_DEMAND == path) ? self->demandNotchesEnable[config] : self->measurementNotchesEnable[config];
+        tfsEnable = (IKLINCON_DEMAND == path) ? self->demandTfsEnable[config] : self->measurementTfsEnable[config];
+        errorTfsEnable = self->errorTfsEnable[config];
+    }
+
+    /* start from the gain schedule, with the sign of the error */
+    if (NULL != self->gainSchedX) gain = ikLutbl_eval(&(self->gainSched), gainSchedX);
+    if (IKLINCON_MEASUREMENT == path) gain = -gain;
+    for (k = 0; k < n; k++) {
+        re[k] = gain;
+        im[k] = 0.0;
+    }
+
+    /* multiply by the responses of the lists on the way, a block of */
+    /* frequencies at a time, sharing their unit delays */
+    notchList = (IKLINCON_DEMAND == path) ? &(self->demandNotchList) : &(self->measurementNotchList);
+    tfList = (IKLINCON_DEMAND == path) ? &(self->demandTfList) : &(self->measurementTfList);
+    for (k = 0; k < n; k += IKSLTI_FREQBLOCK) {
+        m = (n - k < IKSLTI_FREQBLOCK) ? n - k : IKSLTI_FREQBLOCK;
+        ikSlti_delays(m, w + k, z);
+        ikLinCon_mulNotchListFreqResp(notchList, notchesEnable, m, z, re + k, im + k);
+        ikLinCon_mulTfListFreqResp(tfList, tfsEnable, m, z, re + k, im + k);
+        ikLinCon_mulTfListFreqResp(&(self->errorTfList), errorTfsEnable, m, z, re + k, im + k);
+        ikLinCon_mulTfListFreqResp(&(self->postGainTfList), NULL, m, z, re + k, im + k);
+    }
+
+    return 0;
+}
+
 /* @endcond */
@@ -34,8 +34,34 @@ extern "C" {
 #include "ikNotchList.h"
 #include "ikLutbl.h"
 #include "ikSlti.h"
+#ifdef IKPROFILE
+#include "ikProfile.h"
+#endif
     
 #define IKLINCON_MAXNCONFIG 8
+#define IKLINCON_DEMAND 0
+#define IKLINCON_MEASUREMENT 1
+
+    /**
+     * Number of transfer functions held in each instance of
+     * @link ikLinCon @endlink, for the lists given by the fixed size fields of
+     * @link ikLinConParams @endlink, each of which takes those up to its last
+     * one in use. The default leaves room for four full lists. If all the
+     * lists are given in caller arrays, it may be defined at compile time as
+     * low as 1.
+     */
+#ifndef IKLINCON_NTFS
+#define IKLINCON_NTFS (4 * IKTFLIST_NMAX)
+#endif
+
+    /**
+     * Number of notch filters held in each instance of
+     * @link ikLinCon @endlink, as @link IKLINCON_NTFS @endlink. The default
+     * leaves room for two full lists.
+     */
+#ifndef IKLINCON_NNOTCHES
+#define IKLINCON_NNOTCHES (2 * IKNOTCHLIST_NMAX)
+#endif
 
     /**
      * @struct ikLinCon 
@@ -59,6 +85,21 @@ extern "C" {
      * @par Outputs
      * @li control action, get via @link ikLinCon_step @endlink
      * 
+     * Of each list of notch filters or transfer functions given by the fixed
+     * size fields of @link ikLinConParams @endlink, only those up to the last
+     * one in use, i.e. enabled or with a variable enable flag, are stored and
+     * run. Those after it would only pass their input through. The lists may
+     * also be given as arrays of parameters and of items of any length up to
+     * the maximum, held by the caller, via `demandTfList` and so on, in which
+     * case the instance stores none of their items.
+     * 
+     * If IKPROFILE is defined at compile time, the steps are counted and
+     * timed, as are the steps in which the control action is at the limits
+     * of the first post-gain transfer function, as saturations. The
+     * counters of @link ikProfile @endlink are accessible via
+     * @link ikLinCon_getOutput @endlink as "profile>calls", "profile>cycles",
+     * and so on.
+     * 
      * @par Unit block
      * 
      * @image html ikLinCon_unit_block.svg
@@ -71,6 +112,8 @@ extern "C" {
      * @li @link ikLinCon_init @endlink initialise an instance
      * @li @link ikLinCon_step @endlink execute periodic calculations
      * @li @link ikLinCon_getOutput @endlink get output value
+     * @li @link ikLinCon_checkpoint @endlink save or restore runtime state
+     * @li @link ikLinCon_freqResp @endlink get frequency response
      * 
      * @cond
      * The flow is as follows:
@@ -113,12 +156,14 @@ extern "C" {
          * Private members
          */
         /* @cond */
-        ikTfList    postGainTfList;
-        ikTfList    errorTfList;
-        ikTfList    measurementTfList;
-        ikTfList    demandTfList;
-        ikNotchList measurementNotchList;
-        ikNotchList demandNotchList;
+        ikTfListN       postGainTfList;
+        ikTfListN       errorTfList;
+        ikTfListN       measurementTfList;
+        ikTfListN       demandTfList;
+        ikNotchListN    measurementNotchList;
+        ikNotchListN    demandNotchList;
+        ikTfListItem    tfs                     [IKLINCON_NTFS];
+        ikNotchListItem notches                 [IKLINCON_NNOTCHES];
         ikLutbl     gainSched;
         double      *gainSchedX;
         double      demand;
@@ -138,9 +183,44 @@ extern "C" {
         int         currentErrorTfsEnable           [IKTFLIST_NMAX];
         int         currentDemandNotchesEnable      [IKNOTCHLIST_NMAX];
         int         currentMeasurementNotchesEnable [IKNOTCHLIST_NMAX];
+#ifdef IKPROFILE
+        ikProfile   profile;
+#endif
         /* @endcond */
     } ikLinCon;
     
+    /**
+     * @struct ikLinConTfListParams
+     * @brief Transfer function list of a given length, held by the caller
+     */
+    typedef struct ikLinConTfListParams {
+        int                 n;          /**<number of transfer functions, from 0 to @link IKTFLIST_NMAX @endlink.
+                                                The default value is 0.*/
+        const ikTfParams    *tfParams;  /**<array of n transfer function initialisation parameters, with the same
+                                                meaning as the elements of @link ikTfListParams::tfParams @endlink.
+                                                The default value is NULL.*/
+        ikTfListItem        *items;     /**<array of n elements to hold the transfer functions, which must persist for as
+                                                long as the instance is used. If NULL, the list is given by the fixed size field
+                                                instead. The default value is NULL.*/
+    } ikLinConTfListParams;
+
+    /**
+     * @struct ikLinConNotchListParams
+     * @brief Notch filter list of a given length, held by the caller
+     */
+    typedef struct ikLinConNotchListParams {
+        double              dT;             /**<sampling time, as in @link ikNotchListParams::dT @endlink.
+                                                    The default value is 1.0.*/
+        int                 n;              /**<number of notch filters, from 0 to @link IKNOTCHLIST_NMAX @endlink.
+                                                    The default value is 0.*/
+        const ikNotchParams *notchParams;   /**<array of n notch filter initialisation parameters, with the same
+                                                    meaning as the elements of @link ikNotchListParams::notchParams @endlink.
+                                                    The default value is NULL.*/
+        ikNotchListItem     *items;         /**<array of n elements to hold the notch filters, which must persist for as
+                                                    long as the instance is used. If NULL, the list is given by the fixed size field
+                                                    instead. The default value is NULL.*/
+    } ikLinConNotchListParams;
+
     /**
      * @struct ikLinConParams
      * @brief Linear controller initialisation parameters
@@ -189,6 +269,14 @@ extern "C" {
         int                 *config;                                        /**<pointer to a persistent memory address where the preset selection is maintained.
                                                                              A preset configuration will be selected according to the value stored in said address.
                                                                              Set to NULL to disable presets.*/
+        ikLinConTfListParams    demandTfList;                               /**<demand transfer functions in caller arrays, instead of demandTfs*/
+        ikLinConTfListParams    measurementTfList;                          /**<measurement transfer functions in caller arrays, instead of measurementTfs*/
+        ikLinConTfListParams    errorTfList;                                /**<error transfer functions in caller arrays, instead of errorTfs*/
+        ikLinConTfListParams    postGainTfList;                             /**<post-gain transfer functions in caller arrays, instead of postGainTfs.
+                                                                                     The control action limits are applied at the first one, and the post-gain
+                                                                                     value limits at the last one, so there must be at least one.*/
+        ikLinConNotchListParams demandNotchList;                            /**<demand notch filters in caller arrays, instead of demandNotches*/
+        ikLinConNotchListParams measurementNotchList;                       /**<measurement notch filters in caller arrays, instead of measurementNotches*/
         
     } ikLinConParams;
     
@@ -198,7 +286,8 @@ extern "C" {
      * @param params initialisation parameters
      * @return error code:
      * @li 0: no error
-     * @li -1: could not initialise demand transfer functions
+     * @li -1: could not initialise demand transfer functions, or they do not
+     * fit in @link IKLINCON_NTFS @endlink, and likewise for the other lists
      * @li -2: could not initialise measurement transfer functions
      * @li -3: could not initialise error transfer functions
      * @li -4: could not initialise demand notch filters
@@ -235,6 +324,15 @@ extern "C" {
      * @li to get the output of the gain schedule, use "gain schedule"
      * @li to get the output of the last notch filter to be applied on the demand
      * signal, use "demand notch filters>0" or "demand notch filters"
+     * @li to get the number of steps in which the output of an error transfer
+     * function saturated, resetting its buffers, use
+     * "error transfer functions>output saturations". The counters of
+     * @link ikSltiSatCounts @endlink, added up over the list, are accessible
+     * as "input saturations", "output saturations" and "saturated steps",
+     * and, if IKSLTI_NSATHIST is defined, the histogram bins as
+     * "saturation runs>k"
+     * @li to get the number of cycles spent in steps, if IKPROFILE is
+     * defined, use "profile>cycles"
      * 
      * @param self linear control instance
      * @param output output value
@@ -246,6 +344,51 @@ extern "C" {
      */
     int ikLinCon_getOutput(const ikLinCon *self, double *output, const char *name);
 
+    /**
+     * Save or restore runtime state, i.e. that of all the transfer function
+     * and notch filter lists, the current enable settings and the latest
+     * signal values
+     * @param self linear controller instance
+     * @param cp checkpoint blob writer or reader
+     */
+    void ikLinCon_checkpoint(ikLinCon *self, ikCheckpoint *cp);
+
+    /**
+     * Get frequency response from the demand or from the measurement to the
+     * control action, i.e. the product of those of the enabled notch filters
+     * and transfer functions on the way, as in @link ikSlti_freqResp @endlink,
+     * and the gain schedule. The response from the measurement includes the
+     * sign of the error, so that, with a plant of response @f$P@f$ from the
+     * control action to the measurement, the open loop response is
+     * @f$-P@f$ times the response from the measurement.
+     * 
+     * The notch filters are taken at their current frequencies, and the
+     * saturation limits are ignored.
+     * 
+     * @param self linear controller instance
+     * @param config preset configuration, from 0 to configN - 1, whose enable
+     * settings are used. If no preset selection has been specified in
+     * @link ikLinConParams @endlink, the current enable settings are used
+     * instead, and config is ignored.
+     * @param gainSchedX gain schedule key at which the gain is taken. If no
+     * gain schedule key has been specified in @link ikLinConParams @endlink,
+     * the gain is 1, as in @link ikLinCon_step @endlink, and gainSchedX is
+     * ignored.
+     * @param path @link IKLINCON_DEMAND @endlink for the response from the
+     * demand, or @link IKLINCON_MEASUREMENT @endlink for the response from
+     * the measurement
+     * @param n number of frequencies
+     * @param w array of n normalised angular frequencies, in rad per sample,
+     * i.e. angular frequencies in rad/s times the sampling time
+     * @param re array for the real parts of the response, one per frequency
+     * @param im array for the imaginary parts of the response, one per frequency
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid preset configuration
+     * @li -2: invalid path
+     */
+    int ikLinCon_freqResp(const ikLinCon *self, int config, double gainSchedX, int path, int n, const double w[], double re[], double im[]);
+
 
 #ifdef __cplusplus
 }
@@ -759,6 +759,328 @@ void testSaturation() {
         
 }
 
+void testSatCounts() {
+    printf("ikLinCon_test testSatCounts\n");
+    
+    /* allocate controller */
+    ikLinCon con;
+    
+    /* allocate initialisation parameters */
+    ikLinConParams param;
+    
+    /* allocate error code */
+    int err;
+    
+    /* allocate output value */
+    double output;
+    
+    /* allocate saturation limits */
+    double maxOut, minOut, maxIn, minIn;
+    
+    /* initialise controller with the default static gains of 1 and enabled saturated limits */
+    ikLinCon_initParams(&param);
+    param.maxControlAction = &maxOut;
+    param.minControlAction = &minOut;
+    param.maxPostGainValue = &maxIn;
+    param.minPostGainValue = &minIn;
+    err = ikLinCon_init(&con, &param);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testSatCounts (ikLinCon_test) message=init expected to return 0, but returned %d\n", err);
+    maxOut = 3.0;
+    minOut = -4.0;
+    maxIn = 5.0;
+    minIn = -6.0;
+    
+    /* see that the post-gain values and the control action saturate on 2 steps out of 3 */
+    ikLinCon_step(&con, 1100.0, 1000.0);
+    ikLinCon_step(&con, 1000.0, 1001.0);
+    ikLinCon_step(&con, 1000.0, 1100.0);
+    err = ikLinCon_getOutput(&con, &output, "post-gain transfer functions>output saturations");
+    if (err || (2.0 != output)) printf("%%TEST_FAILED%% time=0 testname=testSatCounts (ikLinCon_test) message=getOutput expected to fetch 2 for post-gain transfer functions>output saturations, but fetched %f, error %d\n", output, err);
+    err = ikLinCon_getOutput(&con, &output, "post-gain transfer functions>saturated steps");
+    if (err || (4.0 != output)) printf("%%TEST_FAILED%% time=0 testname=testSatCounts (ikLinCon_test) message=getOutput expected to fetch 4 for post-gain transfer functions>saturated steps, but fetched %f, error %d\n", output, err);
+    err = ikLinCon_getOutput(&con, &output, "post-gain transfer functions>input saturations");
+    if (err || (2.0 != output)) printf("%%TEST_FAILED%% time=0 testname=testSatCounts (ikLinCon_test) message=getOutput expected to fetch 2 for post-gain transfer functions>input saturations, but fetched %f, error %d\n", output, err);
+    err = ikLinCon_getOutput(&con, &output, "error transfer functions>output saturations");
+    if (err || (0.0 != output)) printf("%%TEST_FAILED%% time=0 testname=testSatCounts (ikLinCon_test) message=getOutput expected to fetch 0 for error transfer functions>output saturations, but fetched %f, error %d\n", output, err);
+#ifdef IKSLTI_NSATHIST
+    err = ikLinCon_getOutput(&con, &output, "post-gain transfer functions>saturation runs>0");
+    if (err || (2.0 != output)) printf("%%TEST_FAILED%% time=0 testname=testSatCounts (ikLinCon_test) message=getOutput expected to fetch 2 for post-gain transfer functions>saturation runs>0, but fetched %f, error %d\n", output, err);
+#endif
+    
+    /* see that the outputs are still accessible by index */
+    err = ikLinCon_getOutput(&con, &output, "post-gain transfer functions>1");
+    if (err || (fabs(-6.0 - output) > 1e-9)) printf("%%TEST_FAILED%% time=0 testname=testSatCounts (ikLinCon_test) message=getOutput expected to fetch -6.0 for post-gain transfer functions>1, but fetched %f, error %d\n", output, err);
+        
+}
+
+/**
+ * The frequency response is that of the filters on the way, with the
+ * enable settings of the chosen preset and the gain at the chosen point
+ */
+void testFreqResp() {
+    printf("ikLinCon_test testFreqResp\n");
+    /* declare error code */
+    int err;
+    /* declare instance */
+    ikLinCon con;
+    /* declare initialisation parameters */
+    ikLinConParams params;
+    /* declare preset selection and gain schedule key */
+    int config = 0;
+    double x = 0.0;
+    /* declare reference transfer functions */
+    ikSlti errorTf;
+    ikSlti measurementTf;
+    /* declare frequencies and responses */
+    double w[3] = {0.01, 0.5, 2.0};
+    double re[3];
+    double im[3];
+    double expectedRe[3];
+    double expectedIm[3];
+    int k;
+
+    /* prepare initialisation parameters, with 2 presets */
+    ikLinCon_initParams(&params);
+    params.configN = 2;
+    params.config = &config;
+    /* a low-pass filter on the error, in both presets */
+    params.errorTfsEnable[0][0] = 1;
+    params.errorTfsEnable[1][0] = 1;
+    params.errorTfs.tfParams[0].a[1] = -0.9;
+    params.errorTfs.tfParams[0].b[0] = 0.1;
+    /* a low-pass filter on the measurement, in preset 0 */
+    params.measurementTfsEnable[0][0] = 1;
+    params.measurementTfs.tfParams[0].a[1] = -0.5;
+    params.measurementTfs.tfParams[0].b[0] = 0.5;
+    /* a gain of 3 on the demand, in preset 1 */
+    params.demandTfsEnable[1][1] = 1;
+    params.demandTfs.tfParams[1].b[0] = 3.0;
+    /* a gain schedule from 1 to 3 */
+    params.gainSchedN = 2;
+    params.gainSchedX[0] = 0.0;
+    params.gainSchedX[1] = 10.0;
+    params.gainSchedY[0] = 1.0;
+    params.gainSchedY[1] = 3.0;
+    params.gainShedXVal = &x;
+    err = ikLinCon_init(&con, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testFreqResp (ikLinCon_test) message=init expected to return 0, but it returned %d\n", err);
+    ikSlti_init(&errorTf);
+    ikSlti_setParam(&errorTf, params.errorTfs.tfParams[0].a, params.errorTfs.tfParams[0].b);
+    ikSlti_init(&measurementTf);
+    ikSlti_setParam(&measurementTf, params.measurementTfs.tfParams[0].a, params.measurementTfs.tfParams[0].b);
+
+    /* from the measurement, in preset 0, with a gain of 2 */
+    err = ikLinCon_freqResp(&con, 0, 5.0, IKLINCON_MEASUREMENT, 3, w, re, im);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testFreqResp (ikLinCon_test) message=freqResp expected to return 0, but it returned %d\n", err);
+    for (k = 0; k < 3; k++) {
+        expectedRe[k] = -2.0;
+        expectedIm[k] = 0.0;
+    }
+    ikSlti_mulFreqResp(&measurementTf, 3, w, expectedRe, expectedIm);
+    ikSlti_mulFreqResp(&errorTf, 3, w, expectedRe, expectedIm);
+    for (k = 0; k < 3; k++) {
+        if ((fabs(expectedRe[k] - re[k]) > 1e-12) || (fabs(expectedIm[k] - im[k]) > 1e-12)) printf("%%TEST_FAILED%% time=0 testname=testFreqResp (ikLinCon_test) message=response from the measurement in preset 0 expected to be %f%+fj, but it is %f%+fj\n", expectedRe[k], expectedIm[k], re[k], im[k]);
+    }
+
+    /* from the measurement, in preset 1, with a gain of 2 */
+    ikLinCon_freqResp(&con, 1, 5.0, IKLINCON_MEASUREMENT, 3, w, re, im);
+    for (k = 0; k < 3; k++) {
+        expectedRe[k] = -2.0;
+        expectedIm[k] = 0.0;
+    }
+    ikSlti_mulFreqResp(&errorTf, 3, w, expectedRe, expectedIm);
+    for (k = 0; k < 3; k++) {
+        if ((fabs(expectedRe[k] - re[k]) > 1e-12) || (fabs(expectedIm[k] - im[k]) > 1e-12)) printf("%%TEST_FAILED%% time=0 testname=testFreqResp (ikLinCon_test) message=response from the measurement in preset 1 expected to be %f%+fj, but it is %f%+fj\n", expectedRe[k], expectedIm[k], re[k], im[k]);
+    }
+
+    /* from the demand, in preset 1, with a gain of 3 */
+    ikLinCon_freqResp(&con, 1, 10.0, IKLINCON_DEMAND, 3, w, re, im);
+    for (k = 0; k < 3; k++) {
+        expectedRe[k] = 9.0;
+        expectedIm[k] = 0.0;
+    }
+    ikSlti_mulFreqResp(&errorTf, 3, w, expectedRe, expectedIm);
+    for (k = 0; k < 3; k++) {
+        if ((fabs(expectedRe[k] - re[k]) > 1e-12) || (fabs(expectedIm[k] - im[k]) > 1e-12)) printf("%%TEST_FAILED%% time=0 testname=testFreqResp (ikLinCon_test) message=response from the demand in preset 1 expected to be %f%+fj, but it is %f%+fj\n", expectedRe[k], expectedIm[k], re[k], im[k]);
+    }
+
+    /* errors */
+    err = ikLinCon_freqResp(&con, 2, 5.0, IKLINCON_DEMAND, 3, w, re, im);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testFreqResp (ikLinCon_test) message=freqResp expected to return -1, but it returned %d\n", err);
+    err = ikLinCon_freqResp(&con, 0, 5.0, 2, 3, w, re, im);
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=testFreqResp (ikLinCon_test) message=freqResp expected to return -2, but it returned %d\n", err);
+}
+
+/**
+ * Filters after the last one in use in each list are not run, but their
+ * outputs are still those they would have, passing their input through
+ */
+void testUnusedFilters() {
+    printf("ikLinCon_test testUnusedFilters\n");
+    const char *blocks[6] = {"demand transfer functions", "measurement transfer functions", "error transfer functions",
+        "post-gain transfer functions", "demand notch filters", "measurement notch filters"};
+    char name[64];
+    int off = 0;
+    int err;
+    int i, j, k;
+    double output, expected;
+    ikLinCon con;
+    ikLinCon all;
+    ikLinConParams params;
+    ikCheckpoint cp;
+    size_t size, allSize;
+    
+    /* a few filters, the rest unused */
+    ikLinCon_initParams(&params);
+    params.demandTfs.tfParams[1].enable = 1;
+    params.demandTfs.tfParams[1].a[1] = -0.5;
+    params.demandTfs.tfParams[1].b[0] = 0.5;
+    params.errorTfs.tfParams[0].enable = 1;
+    params.errorTfs.tfParams[0].b[0] = 2.0;
+    params.measurementNotches.dT = 0.01;
+    params.measurementNotches.notchParams[2].enable = 1;
+    params.measurementNotches.notchParams[2].freq = 20.0;
+    params.measurementNotches.notchParams[2].dampDen = 0.5;
+    params.measurementNotches.notchParams[2].dampNum = 0.05;
+    params.demandNotches.dT = 0.01;
+    err = ikLinCon_init(&con, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testUnusedFilters (ikLinCon_test) message=init expected to return 0, but returned %d\n", err);
+    
+    /* the same, with the unused filters in use, but disabled */
+    for (i = 0; i < IKTFLIST_NMAX; i++) {
+        if (!params.demandTfs.tfParams[i].enable) params.demandTfs.tfParams[i].variableEnable = &off;
+        if (!params.measurementTfs.tfParams[i].enable) params.measurementTfs.tfParams[i].variableEnable = &off;
+        if (!params.errorTfs.tfParams[i].enable) params.errorTfs.tfParams[i].variableEnable = &off;
+        if (!params.postGainTfs.tfParams[i].enable) params.postGainTfs.tfParams[i].variableEnable = &off;
+    }
+    for (i = 0; i < IKNOTCHLIST_NMAX; i++) {
+        if (!params.demandNotches.notchParams[i].enable) params.demandNotches.notchParams[i].variableEnable = &off;
+        if (!params.measurementNotches.notchParams[i].enable) params.measurementNotches.notchParams[i].variableEnable = &off;
+    }
+    ikLinCon_init(&all, &params);
+    
+    /* same outputs, of the filters too */
+    for (k = 0; k < 50; k++) {
+        expected = ikLinCon_step(&all, sin(0.1 * k), cos(0.3 * k));
+        output = ikLinCon_step(&con, sin(0.1 * k), cos(0.3 * k));
+        if (expected != output) printf("%%TEST_FAILED%% time=0 testname=testUnusedFilters (ikLinCon_test) message=step expected to return %f at step %d, but returned %f\n", expected, k, output);
+    }
+    for (j = 0; j < 6; j++) {
+        for (i = 0; i < IKTFLIST_NMAX; i++) {
+            sprintf(name, "%s>%d", blocks[j], i);
+            ikLinCon_getOutput(&all, &expected, name);
+            ikLinCon_getOutput(&con, &output, name);
+            if (fabs(expected - output) > 1e-9) printf("%%TEST_FAILED%% time=0 testname=testUnusedFilters (ikLinCon_test) message=getOutput expected to fetch %f for %s, but fetched %f\n", expected, name, output);
+        }
+    }
+    ikLinCon_getOutput(&all, &expected, "error");
+    ikLinCon_getOutput(&con, &output, "error");
+    if (fabs(expected - output) > 1e-9) printf("%%TEST_FAILED%% time=0 testname=testUnusedFilters (ikLinCon_test) message=getOutput expected to fetch %f for error, but fetched %f\n", expected, output);
+    
+    /* and less state */
+    ikCheckpoint_initSave(&cp, NULL, 0, "ikLinCon");
+    ikLinCon_checkpoint(&all, &cp);
+    ikCheckpoint_finish(&cp, &allSize);
+    ikCheckpoint_initSave(&cp, NULL, 0, "ikLinCon");
+    ikLinCon_checkpoint(&con, &cp);
+    ikCheckpoint_finish(&cp, &size);
+    if (size >= allSize) printf("%%TEST_FAILED%% time=0 testname=testUnusedFilters (ikLinCon_test) message=expected a checkpoint smaller than %d bytes, but it is %d bytes\n", (int) allSize, (int) size);
+}
+
+void testSizedLists() {
+    printf("ikLinCon_test testSizedLists\n");
+    const char *blocks[6] = {"demand transfer functions", "measurement transfer functions", "error transfer functions",
+        "post-gain transfer functions", "demand notch filters", "measurement notch filters"};
+    char name[64];
+    double maxCon = 0.8;
+    int err;
+    int i, j, k;
+    double output, expected;
+    ikLinCon con;
+    ikLinCon fixed;
+    ikLinConParams params;
+    ikTfParams demandTfParams[2];
+    ikTfParams errorTfParams[1];
+    ikTfParams postGainTfParams[1];
+    ikNotchParams measurementNotchParams[3];
+    ikTfListItem demandTfs[2];
+    ikTfListItem errorTfs[1];
+    ikTfListItem postGainTfs[1];
+    ikNotchListItem measurementNotches[3];
+    ikNotchListItem demandNotches[1];
+    ikTfListItem measurementTfs[1];
+    
+    /* a few filters, in fixed size lists */
+    ikLinCon_initParams(&params);
+    params.demandTfs.tfParams[1].enable = 1;
+    params.demandTfs.tfParams[1].a[1] = -0.5;
+    params.demandTfs.tfParams[1].b[0] = 0.5;
+    params.errorTfs.tfParams[0].enable = 1;
+    params.errorTfs.tfParams[0].b[0] = 2.0;
+    params.measurementNotches.dT = 0.01;
+    params.measurementNotches.notchParams[2].enable = 1;
+    params.measurementNotches.notchParams[2].freq = 20.0;
+    params.measurementNotches.notchParams[2].dampDen = 0.5;
+    params.measurementNotches.notchParams[2].dampNum = 0.05;
+    params.maxControlAction = &maxCon;
+    err = ikLinCon_init(&fixed, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testSizedLists (ikLinCon_test) message=init expected to return 0, but returned %d\n", err);
+    
+    /* the same, in caller arrays of the lengths used */
+    ikTfList_initTfParams(demandTfParams, 2);
+    demandTfParams[1] = params.demandTfs.tfParams[1];
+    ikTfList_initTfParams(errorTfParams, 1);
+    errorTfParams[0] = params.errorTfs.tfParams[0];
+    ikTfList_initTfParams(postGainTfParams, 1);
+    ikNotchList_initNotchParams(measurementNotchParams, 3);
+    measurementNotchParams[2] = params.measurementNotches.notchParams[2];
+    ikLinCon_initParams(&params);
+    params.demandTfList.n = 2;
+    params.demandTfList.tfParams = demandTfParams;
+    params.demandTfList.items = demandTfs;
+    params.measurementTfList.items = measurementTfs;
+    params.errorTfList.n = 1;
+    params.errorTfList.tfParams = errorTfParams;
+    params.errorTfList.items = errorTfs;
+    params.postGainTfList.n = 1;
+    params.postGainTfList.tfParams = postGainTfParams;
+    params.postGainTfList.items = postGainTfs;
+    params.demandNotchList.items = demandNotches;
+    params.measurementNotchList.dT = 0.01;
+    params.measurementNotchList.n = 3;
+    params.measurementNotchList.notchParams = measurementNotchParams;
+    params.measurementNotchList.items = measurementNotches;
+    params.maxControlAction = &maxCon;
+    err = ikLinCon_init(&con, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testSizedLists (ikLinCon_test) message=init expected to return 0, but returned %d\n", err);
+    
+    /* same outputs, of the filters too */
+    for (k = 0; k < 50; k++) {
+        expected = ikLinCon_step(&fixed, sin(0.1 * k), cos(0.3 * k));
+        output = ikLinCon_step(&con, sin(0.1 * k), cos(0.3 * k));
+        if (expected != output) printf("%%TEST_FAILED%% time=0 testname=testSizedLists (ikLinCon_test) message=step expected to return %f at step %d, but returned %f\n", expected, k, output);
+    }
+    for (j = 0; j < 6; j++) {
+        for (i = 0; i < IKTFLIST_NMAX; i++) {
+            sprintf(name, "%s>%d", blocks[j], i);
+            ikLinCon_getOutput(&fixed, &expected, name);
+            ikLinCon_getOutput(&con, &output, name);
+            if (fabs(expected - output) > 1e-9) printf("%%TEST_FAILED%% time=0 testname=testSizedLists (ikLinCon_test) message=getOutput expected to fetch %f for %s, but fetched %f\n", expected, name, output);
+        }
+    }
+    
+    /* too many transfer functions */
+    params.errorTfList.n = IKTFLIST_NMAX + 1;
+    err = ikLinCon_init(&con, &params);
+    if (-3 != err) printf("%%TEST_FAILED%% time=0 testname=testSizedLists (ikLinCon_test) message=init expected to return -3, but returned %d\n", err);
+    
+    /* no post-gain transfer function for the limits */
+    params.errorTfList.n = 1;
+    params.postGainTfList.n = 0;
+    err = ikLinCon_init(&con, &params);
+    if (-6 != err) printf("%%TEST_FAILED%% time=0 testname=testSizedLists (ikLinCon_test) message=init expected to return -6, but returned %d\n", err);
+}
+
 int main(int argc, char** argv) {
     printf("%%SUITE_STARTING%% ikLinCon_test\n");
     printf("%%SUITE_STARTED%%\n");
@@ -787,6 +1109,22 @@ int main(int argc, char** argv) {
     testSaturation();
     printf("%%TEST_FINISHED%% time=0 testSaturation (ikLinCon_test) \n");
 
+    printf("%%TEST_STARTED%% testSatCounts (ikLinCon_test)\n");
+    testSatCounts();
+    printf("%%TEST_FINISHED%% time=0 testSatCounts (ikLinCon_test) \n");
+
+    printf("%%TEST_STARTED%% testFreqResp (ikLinCon_test)\n");
+    testFreqResp();
+    printf("%%TEST_FINISHED%% time=0 testFreqResp (ikLinCon_test) \n");
+
+    printf("%%TEST_STARTED%% testUnusedFilters (ikLinCon_test)\n");
+    testUnusedFilters();
+    printf("%%TEST_FINISHED%% time=0 testUnusedFilters (ikLinCon_test) \n");
+
+    printf("%%TEST_STARTED%% testSizedLists (ikLinCon_test)\n");
+    testSizedLists();
+    printf("%%TEST_FINISHED%% time=0 testSizedLists (ikLinCon_test) \n");
+
     printf("%%SUITE_FINISHED%% time=0\n");
 
     return (EXIT_SUCCESS);
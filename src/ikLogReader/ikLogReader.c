@@ -0,0 +1,187 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikLogReader.c
+ * 
+ * @brief Class ikLogReader implementation
+ */
+
+/* @cond */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ikLogWriter.h"
+#include "ikLogReader.h"
+
+/**
+ * (Private) check the header and register its contents
+ * @return error code:
+ *  0: no error
+ * -2: invalid header
+ * -3: could not allocate memory
+ */
+int ikLogReader_readHeader(ikLogReader *self) {
+    int32_t valueSize;
+    int32_t nChannels;
+    int32_t chunkLength;
+    int32_t headerSize;
+    int64_t nSamples;
+    size_t chunkSize;
+    long nChunks;
+    const char *p;
+    const char *end;
+    int i;
+
+    /*fixed part */
+    if (IKLOG_FIXEDHEADERSIZE > self->mapSize) return -2;
+    if (memcmp(self->map, IKLOG_MAGIC, IKLOG_MAGICSIZE)) return -2;
+    memcpy(&valueSize, self->map + 8, 4);
+    memcpy(&nChannels, self->map + 12, 4);
+    memcpy(&chunkLength, self->map + 16, 4);
+    memcpy(&headerSize, self->map + 20, 4);
+    memcpy(&nSamples, self->map + 24, 8);
+    if ((sizeof (float) != valueSize) && (sizeof (double) != valueSize)) return -2;
+    if ((0 >= nChannels) || (0 >= chunkLength) || (chunkLength % 16)) return -2;
+    if ((IKLOG_FIXEDHEADERSIZE > headerSize) || (headerSize % IKLOG_ALIGNMENT) || ((size_t) headerSize > self->mapSize)) return -2;
+    self->valueSize = valueSize;
+    self->nChannels = nChannels;
+    self->chunkLength = chunkLength;
+    self->headerSize = headerSize;
+
+    /*number of samples, limited to the full chunks if the file was not closed */
+    chunkSize = (size_t) nChannels * chunkLength * valueSize;
+    nChunks = (long) ((self->mapSize - self->headerSize) / chunkSize);
+    if ((0 > nSamples) || (nSamples > (int64_t) nChunks * chunkLength)) {
+        if (-1 != nSamples) return -2;
+        nSamples = (int64_t) nChunks * chunkLength;
+    }
+    self->nSamples = (long) nSamples;
+
+    /*channel names */
+    self->names = (const char **) malloc(sizeof (const char *) * nChannels);
+    if (NULL == self->names) return -3;
+    p = self->map + IKLOG_FIXEDHEADERSIZE;
+    end = self->map + self->headerSize;
+    for (i = 0; i < nChannels; i++) {
+        self->names[i] = p;
+        p = memchr(p, '\0', end - p);
+        if (NULL == p) {
+            free(self->names);
+            return -2;
+        }
+        p++;
+    }
+
+    return 0;
+}
+
+int ikLogReader_init(ikLogReader *self, const char *fileName) {
+    int fd;
+    struct stat st;
+    void *map;
+    int err;
+
+    /*map the file */
+    fd = open(fileName, O_RDONLY);
+    if (0 > fd) return -1;
+    if (fstat(fd, &st) || (0 >= st.st_size)) {
+        close(fd);
+        return -1;
+    }
+    map = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == map) return -1;
+    self->map = (const char *) map;
+    self->mapSize = (size_t) st.st_size;
+
+    /*read the header */
+    err = ikLogReader_readHeader(self);
+    if (err) {
+        munmap(map, self->mapSize);
+        return err;
+    }
+
+    return 0;
+}
+
+int ikLogReader_getNChannels(const ikLogReader *self) {
+    return self->nChannels;
+}
+
+long ikLogReader_getNSamples(const ikLogReader *self) {
+    return self->nSamples;
+}
+
+int ikLogReader_getValueSize(const ikLogReader *self) {
+    return self->valueSize;
+}
+
+int ikLogReader_getChunkLength(const ikLogReader *self) {
+    return self->chunkLength;
+}
+
+const char *ikLogReader_getName(const ikLogReader *self, int channel) {
+    if ((0 > channel) || (self->nChannels <= channel)) return NULL;
+    return self->names[channel];
+}
+
+int ikLogReader_findChannel(const ikLogReader *self, const char *name) {
+    int i;
+    for (i = 0; i < self->nChannels; i++) {
+        if (!strcmp(self->names[i], name)) return i;
+    }
+    return -1;
+}
+
+const void *ikLogReader_getColumn(const ikLogReader *self, int channel, long chunk, int *length) {
+    long remaining;
+
+    /*check the indices */
+    if ((0 > channel) || (self->nChannels <= channel)) return NULL;
+    remaining = self->nSamples - chunk * self->chunkLength;
+    if ((0 > chunk) || (0 >= remaining)) return NULL;
+
+    /*point into the mapping */
+    *length = remaining < self->chunkLength ? (int) remaining : self->chunkLength;
+    return self->map + self->headerSize + ((size_t) chunk * self->nChannels + channel) * self->chunkLength * self->valueSize;
+}
+
+double ikLogReader_getValue(const ikLogReader *self, int channel, long sample) {
+    int length;
+    const void *column;
+
+    column = ikLogReader_getColumn(self, channel, sample / self->chunkLength, &length);
+    if ((NULL == column) || (0 > sample)) return NAN;
+    if (sizeof (double) == self->valueSize) return ((const double *) column)[sample % self->chunkLength];
+    return ((const float *) column)[sample % self->chunkLength];
+}
+
+void ikLogReader_delete(ikLogReader *self) {
+    free(self->names);
+    munmap((void *) self->map, self->mapSize);
+}
+
+/* @endcond */
@@ -0,0 +1,172 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikLogReader.h
+ * 
+ * @brief Class ikLogReader interface
+ */
+
+#ifndef IKLOGREADER_H
+#define IKLOGREADER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+    /**
+     * @struct ikLogReader
+     * @brief Columnar binary log reader
+     * 
+     * Instances of this type give access to the contents of a log file
+     * written by @link ikLogWriter @endlink, in the format described there.
+     * The file is mapped into memory, rather than read, and the columns are
+     * exposed where they lie in the mapping, so there is no parsing or
+     * copying. The columns of each chunk are contiguous, and aligned for
+     * vectorised access.
+     * 
+     * If the file was not closed by its writer, only its full chunks are
+     * available.
+     * 
+     * This class needs POSIX memory mapping, and is meant for replays and
+     * analysis, rather than for the turbine controllers themselves.
+     * 
+     * @par Methods
+     * @li @link ikLogReader_init @endlink initialise an instance
+     * @li @link ikLogReader_getNChannels @endlink get number of channels
+     * @li @link ikLogReader_getNSamples @endlink get number of samples
+     * @li @link ikLogReader_getValueSize @endlink get value size
+     * @li @link ikLogReader_getChunkLength @endlink get chunk length
+     * @li @link ikLogReader_getName @endlink get channel name
+     * @li @link ikLogReader_findChannel @endlink find channel by name
+     * @li @link ikLogReader_getColumn @endlink get column of a chunk
+     * @li @link ikLogReader_getValue @endlink get single value
+     * @li @link ikLogReader_delete @endlink delete instance
+     */
+    typedef struct ikLogReader {
+        /**
+         * Private members
+         */
+        /* @cond */
+        const char *map; /*file mapping */
+        size_t mapSize; /*size of the file mapping */
+        int nChannels; /*number of channels */
+        int valueSize; /*size of values, 4 or 8 */
+        int chunkLength; /*number of samples per chunk */
+        size_t headerSize; /*size of the header, in bytes */
+        long nSamples; /*number of samples */
+        const char **names; /*channel names, in the mapping */
+        /* @endcond */
+    } ikLogReader;
+
+    /**
+     * Initialise an instance
+     * @param self instance
+     * @param fileName name of the log file
+     * @return error code:
+     * @li 0: no error
+     * @li -1: could not open or map the file
+     * @li -2: invalid header, or written with a different byte order
+     * @li -3: could not allocate memory
+     */
+    int ikLogReader_init(ikLogReader *self, const char *fileName);
+
+    /**
+     * Get number of channels
+     * @param self instance
+     * @return number of channels
+     */
+    int ikLogReader_getNChannels(const ikLogReader *self);
+
+    /**
+     * Get number of samples
+     * @param self instance
+     * @return number of samples
+     */
+    long ikLogReader_getNSamples(const ikLogReader *self);
+
+    /**
+     * Get value size
+     * @param self instance
+     * @return size of values, sizeof(float) or sizeof(double)
+     */
+    int ikLogReader_getValueSize(const ikLogReader *self);
+
+    /**
+     * Get chunk length
+     * @param self instance
+     * @return number of samples per chunk
+     */
+    int ikLogReader_getChunkLength(const ikLogReader *self);
+
+    /**
+     * Get channel name
+     * @param self instance
+     * @param channel channel index, from 0
+     * @return channel name, or NULL if the channel index is invalid
+     */
+    const char *ikLogReader_getName(const ikLogReader *self, int channel);
+
+    /**
+     * Find channel by name
+     * @param self instance
+     * @param name channel name, NULL terminated string
+     * @return channel index, from 0, or -1 if there is no such channel
+     */
+    int ikLogReader_findChannel(const ikLogReader *self, const char *name);
+
+    /**
+     * Get column of a chunk
+     * 
+     * The column lies in the file mapping, and is valid until the instance is
+     * deleted. Its values are of type float or double, as given by
+     * @link ikLogReader_getValueSize @endlink, and the value of sample
+     * k*chunkLength + j is at position j.
+     * 
+     * @param self instance
+     * @param channel channel index, from 0
+     * @param chunk chunk index, from 0
+     * @param length number of samples in the column, all but in the last chunk
+     * chunkLength
+     * @return column values, or NULL if the channel or chunk index is invalid
+     */
+    const void *ikLogReader_getColumn(const ikLogReader *self, int channel, long chunk, int *length);
+
+    /**
+     * Get single value
+     * @param self instance
+     * @param channel channel index, from 0
+     * @param sample sample index, from 0
+     * @return value, or NaN if the channel or sample index is invalid
+     */
+    double ikLogReader_getValue(const ikLogReader *self, int channel, long sample);
+
+    /**
+     * Delete instance
+     * @param self instance
+     */
+    void ikLogReader_delete(ikLogReader *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKLOGREADER_H */
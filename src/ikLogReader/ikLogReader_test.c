@@ -0,0 +1,224 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikLogReader_test.c
+ * 
+ * @brief Class ikLogReader unit tests
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "ikLogWriter.h"
+#include "ikLogReader.h"
+
+/*
+ * Simple C Test Suite for class ikLogReader
+ */
+
+#define NCHANNELS 4
+#define CHUNKLENGTH 32
+#define NSAMPLES 100
+
+const char *channels[NCHANNELS] = {"time", "tip-speed ratio", "pitch 1", "individual pitch control>My"};
+
+/**
+ * Value of channel i at sample k.
+ */
+double value(int i, int k) {
+    return sin(0.01 * k + i) * (i + 1) * 1e3;
+}
+
+/**
+ * Write a log of NSAMPLES samples.
+ */
+int writeLog(const char *fileName, int valueSize) {
+    ikLogWriter log;
+    ikLogWriterParams params;
+    double values[NCHANNELS];
+    int err, i, k;
+
+    ikLogWriter_initParams(&params);
+    params.fileName = fileName;
+    params.nChannels = NCHANNELS;
+    params.channels = channels;
+    params.valueSize = valueSize;
+    params.chunkLength = CHUNKLENGTH;
+    err = ikLogWriter_init(&log, &params);
+    if (err) return err;
+    for (k = 0; k < NSAMPLES; k++) {
+        for (i = 0; i < NCHANNELS; i++) values[i] = value(i, k);
+        ikLogWriter_write(&log, values);
+        ikLogWriter_flush(&log);
+    }
+    return ikLogWriter_delete(&log);
+}
+
+/**
+ * Read a log written by writeLog and check its contents.
+ */
+void checkLog(const char *testName, const char *fileName, int valueSize, long nSamples) {
+    ikLogReader log;
+    int err, i, k, j;
+    long chunk;
+
+    err = ikLogReader_init(&log, fileName);
+    if (err) {
+        printf("%%TEST_FAILED%% time=0 testname=%s (ikLogReader_test) message=init returned %d\n", testName, err);
+        return;
+    }
+
+    /*header */
+    if (NCHANNELS != ikLogReader_getNChannels(&log)) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogReader_test) message=number of channels is %d\n", testName, ikLogReader_getNChannels(&log));
+    if (nSamples != ikLogReader_getNSamples(&log)) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogReader_test) message=number of samples is %ld\n", testName, ikLogReader_getNSamples(&log));
+    if (valueSize != ikLogReader_getValueSize(&log)) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogReader_test) message=value size is %d\n", testName, ikLogReader_getValueSize(&log));
+    if (CHUNKLENGTH != ikLogReader_getChunkLength(&log)) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogReader_test) message=chunk length is %d\n", testName, ikLogReader_getChunkLength(&log));
+    for (i = 0; i < NCHANNELS; i++) {
+        if ((NULL == ikLogReader_getName(&log, i)) || strcmp(channels[i], ikLogReader_getName(&log, i))) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogReader_test) message=wrong name of channel %d\n", testName, i);
+        if (i != ikLogReader_findChannel(&log, channels[i])) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogReader_test) message=could not find channel %d\n", testName, i);
+    }
+    if (NULL != ikLogReader_getName(&log, NCHANNELS)) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogReader_test) message=name of invalid channel is not NULL\n", testName);
+    if (-1 != ikLogReader_findChannel(&log, "pitch")) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogReader_test) message=found invalid channel\n", testName);
+
+    /*columns */
+    for (chunk = 0; chunk * CHUNKLENGTH < nSamples; chunk++) {
+        for (i = 0; i < NCHANNELS; i++) {
+            int length = -1;
+            const void *column = ikLogReader_getColumn(&log, i, chunk, &length);
+            int expected = nSamples - chunk * CHUNKLENGTH < CHUNKLENGTH ? (int) (nSamples - chunk * CHUNKLENGTH) : CHUNKLENGTH;
+            if (NULL == column) {
+                printf("%%TEST_FAILED%% time=0 testname=%s (ikLogReader_test) message=no column %d in chunk %ld\n", testName, i, chunk);
+                continue;
+            }
+            if (expected != length) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogReader_test) message=column %d in chunk %ld has length %d\n", testName, i, chunk, length);
+            if ((uintptr_t) column % IKLOG_ALIGNMENT) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogReader_test) message=column %d in chunk %ld is not aligned\n", testName, i, chunk);
+            for (j = 0; j < length; j++) {
+                k = chunk * CHUNKLENGTH + j;
+                double v = sizeof (double) == valueSize ? ((const double *) column)[j] : ((const float *) column)[j];
+                double r = sizeof (double) == valueSize ? value(i, k) : (float) value(i, k);
+                if (r != v) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogReader_test) message=column %d in chunk %ld has %f at %d, expected %f\n", testName, i, chunk, v, j, r);
+                if (r != ikLogReader_getValue(&log, i, k)) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogReader_test) message=value of channel %d at sample %d is %f, expected %f\n", testName, i, k, ikLogReader_getValue(&log, i, k), r);
+            }
+        }
+    }
+
+    /*invalid indices */
+    if (NULL != ikLogReader_getColumn(&log, NCHANNELS, 0, &j)) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogReader_test) message=column of invalid channel is not NULL\n", testName);
+    if (NULL != ikLogReader_getColumn(&log, 0, chunk, &j)) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogReader_test) message=column of invalid chunk is not NULL\n", testName);
+    if (NULL != ikLogReader_getColumn(&log, 0, -1, &j)) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogReader_test) message=column of negative chunk is not NULL\n", testName);
+    if (!isnan(ikLogReader_getValue(&log, 0, nSamples))) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogReader_test) message=value of invalid sample is not NaN\n", testName);
+    if (!isnan(ikLogReader_getValue(&log, -1, 0))) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogReader_test) message=value of invalid channel is not NaN\n", testName);
+
+    ikLogReader_delete(&log);
+}
+
+void testDouble() {
+    printf("ikLogReader_test testDouble\n");
+    if (writeLog("ikLogReader_test.log", sizeof (double))) printf("%%TEST_FAILED%% time=0 testname=testDouble (ikLogReader_test) message=could not write the log\n");
+    checkLog("testDouble", "ikLogReader_test.log", sizeof (double), NSAMPLES);
+    remove("ikLogReader_test.log");
+}
+
+void testFloat() {
+    printf("ikLogReader_test testFloat\n");
+    if (writeLog("ikLogReader_test.log", sizeof (float))) printf("%%TEST_FAILED%% time=0 testname=testFloat (ikLogReader_test) message=could not write the log\n");
+    checkLog("testFloat", "ikLogReader_test.log", sizeof (float), NSAMPLES);
+    remove("ikLogReader_test.log");
+}
+
+/**
+ * Check that only the full chunks of a log which was not closed are read.
+ */
+void testUnclosed() {
+    printf("ikLogReader_test testUnclosed\n");
+    FILE *f;
+    char *data;
+    long size;
+    int64_t nSamples = -1;
+
+    /*write a log, and undo the closing: number of samples and last chunk */
+    if (writeLog("ikLogReader_test.log", sizeof (double))) printf("%%TEST_FAILED%% time=0 testname=testUnclosed (ikLogReader_test) message=could not write the log\n");
+    f = fopen("ikLogReader_test.log", "rb");
+    if (NULL == f) {
+        printf("%%TEST_FAILED%% time=0 testname=testUnclosed (ikLogReader_test) message=could not read the log\n");
+        return;
+    }
+    fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    data = (char *) malloc(size);
+    if (1 != fread(data, size, 1, f)) printf("%%TEST_FAILED%% time=0 testname=testUnclosed (ikLogReader_test) message=could not read the log\n");
+    fclose(f);
+    memcpy(data + 24, &nSamples, 8);
+    f = fopen("ikLogReader_test.log", "wb");
+    fwrite(data, size - NCHANNELS * CHUNKLENGTH * sizeof (double) / 2, 1, f);
+    fclose(f);
+    free(data);
+
+    checkLog("testUnclosed", "ikLogReader_test.log", sizeof (double), NSAMPLES / CHUNKLENGTH * CHUNKLENGTH);
+    remove("ikLogReader_test.log");
+}
+
+void testInitErrors() {
+    printf("ikLogReader_test testInitErrors\n");
+    ikLogReader log;
+    FILE *f;
+    int err;
+
+    /* -1 for a missing file */
+    err = ikLogReader_init(&log, "ikLogReader_test.log");
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikLogReader_test) message=init expected to return -1, but returned %d\n", err);
+
+    /* -2 for a file which is not a log */
+    f = fopen("ikLogReader_test.log", "w");
+    fprintf(f, "time,pitch 1\n0.0,1.0\n0.01,1.1\n0.02,1.2\n0.03,1.3\n");
+    fclose(f);
+    err = ikLogReader_init(&log, "ikLogReader_test.log");
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikLogReader_test) message=init expected to return -2, but returned %d\n", err);
+
+    remove("ikLogReader_test.log");
+}
+
+int main(int argc, char** argv) {
+    printf("%%SUITE_STARTING%% ikLogReader_test\n");
+    printf("%%SUITE_STARTED%%\n");
+
+    printf("%%TEST_STARTED%% testDouble (ikLogReader_test)\n");
+    testDouble();
+    printf("%%TEST_FINISHED%% time=0 testDouble (ikLogReader_test) \n");
+
+    printf("%%TEST_STARTED%% testFloat (ikLogReader_test)\n");
+    testFloat();
+    printf("%%TEST_FINISHED%% time=0 testFloat (ikLogReader_test) \n");
+
+    printf("%%TEST_STARTED%% testUnclosed (ikLogReader_test)\n");
+    testUnclosed();
+    printf("%%TEST_FINISHED%% time=0 testUnclosed (ikLogReader_test) \n");
+
+    printf("%%TEST_STARTED%% testInitErrors (ikLogReader_test)\n");
+    testInitErrors();
+    printf("%%TEST_FINISHED%% time=0 testInitErrors (ikLogReader_test) \n");
+
+    printf("%%SUITE_FINISHED%% time=0\n");
+
+    return (EXIT_SUCCESS);
+}
@@ -0,0 +1,222 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikLogWriter.c
+ * 
+ * @brief Class ikLogWriter implementation
+ */
+
+/* @cond */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <stdatomic.h>
+#include "ikLogWriter.h"
+
+/*chunk counters, shared by write and flush, which may run in different threads */
+typedef struct ikLogWriterCounters {
+    atomic_long filled; /*number of chunks filled, by write */
+    atomic_long flushed; /*number of chunks written to the file, by flush */
+} ikLogWriterCounters;
+
+/**
+ * (Private) write the header of the log file
+ * @return error code:
+ *  0: no error
+ * -1: could not write
+ */
+int ikLogWriter_writeHeader(ikLogWriter *self, const char *const *channels) {
+    char fixed[IKLOG_FIXEDHEADERSIZE];
+    int32_t valueSize = self->valueSize;
+    int32_t nChannels = self->nChannels;
+    int32_t chunkLength = self->chunkLength;
+    int32_t headerSize;
+    int64_t nSamples = -1;
+    size_t namesSize = 0;
+    size_t padding;
+    int i;
+
+    /*compute the header size */
+    for (i = 0; i < self->nChannels; i++) namesSize += strlen(channels[i]) + 1;
+    headerSize = (int32_t) ((IKLOG_FIXEDHEADERSIZE + namesSize + IKLOG_ALIGNMENT - 1) / IKLOG_ALIGNMENT * IKLOG_ALIGNMENT);
+    padding = headerSize - IKLOG_FIXEDHEADERSIZE - namesSize;
+
+    /*fixed part */
+    memcpy(fixed, IKLOG_MAGIC, IKLOG_MAGICSIZE);
+    memcpy(fixed + 8, &valueSize, 4);
+    memcpy(fixed + 12, &nChannels, 4);
+    memcpy(fixed + 16, &chunkLength, 4);
+    memcpy(fixed + 20, &headerSize, 4);
+    memcpy(fixed + 24, &nSamples, 8);
+    if (1 != fwrite(fixed, IKLOG_FIXEDHEADERSIZE, 1, self->file)) return -1;
+
+    /*channel names and padding */
+    for (i = 0; i < self->nChannels; i++) {
+        if (1 != fwrite(channels[i], strlen(channels[i]) + 1, 1, self->file)) return -1;
+    }
+    for (; padding > 0; padding--) {
+        if (EOF == fputc(0, self->file)) return -1;
+    }
+
+    return 0;
+}
+
+void ikLogWriter_initParams(ikLogWriterParams *params) {
+    params->fileName = NULL;
+    params->nChannels = 0;
+    params->channels = NULL;
+    params->valueSize = sizeof (double);
+    params->chunkLength = 1024;
+    params->nChunks = 4;
+}
+
+int ikLogWriter_init(ikLogWriter *self, const ikLogWriterParams *params) {
+    /*check parameters */
+    if (0 >= params->nChannels) return -1;
+    if ((sizeof (float) != params->valueSize) && (sizeof (double) != params->valueSize)) return -2;
+    if ((0 >= params->chunkLength) || (params->chunkLength % 16)) return -3;
+    if (1 > params->nChunks) return -4;
+
+    /*allocate the chunks */
+    self->nChannels = params->nChannels;
+    self->valueSize = params->valueSize;
+    self->chunkLength = params->chunkLength;
+    self->nChunks = params->nChunks;
+    self->chunkSize = (size_t) self->nChannels * self->chunkLength * self->valueSize;
+    self->chunks = (char *) malloc(self->chunkSize * self->nChunks);
+    self->counters = (ikLogWriterCounters *) malloc(sizeof (ikLogWriterCounters));
+    if ((NULL == self->chunks) || (NULL == self->counters)) {
+        free(self->chunks);
+        free(self->counters);
+        return -5;
+    }
+    atomic_init(&(self->counters->filled), 0);
+    atomic_init(&(self->counters->flushed), 0);
+    self->pos = 0;
+    self->nSamples = 0;
+    self->overruns = 0;
+
+    /*create the file */
+    self->file = (NULL != params->fileName) ? fopen(params->fileName, "wb") : NULL;
+    if ((NULL == self->file) || ikLogWriter_writeHeader(self, params->channels)) {
+        if (NULL != self->file) fclose(self->file);
+        free(self->chunks);
+        free(self->counters);
+        return -6;
+    }
+
+    return 0;
+}
+
+int ikLogWriter_write(ikLogWriter *self, const double values[]) {
+    long filled = atomic_load_explicit(&(self->counters->filled), memory_order_relaxed);
+    int i;
+    char *chunk;
+
+    /*drop the sample if the ring is full */
+    if (0 == self->pos) {
+        if (filled - atomic_load_explicit(&(self->counters->flushed), memory_order_acquire) >= self->nChunks) {
+            self->overruns++;
+            return -1;
+        }
+    }
+
+    /*copy the values into the current chunk */
+    chunk = self->chunks + (filled % self->nChunks) * self->chunkSize;
+    if (sizeof (double) == self->valueSize) {
+        double *column = (double *) chunk + self->pos;
+        for (i = 0; i < self->nChannels; i++) column[i * self->chunkLength] = values[i];
+    } else {
+        float *column = (float *) chunk + self->pos;
+        for (i = 0; i < self->nChannels; i++) column[i * self->chunkLength] = (float) values[i];
+    }
+    self->nSamples++;
+
+    /*hand the chunk over to flush when full */
+    if (self->chunkLength == ++(self->pos)) {
+        self->pos = 0;
+        atomic_store_explicit(&(self->counters->filled), filled + 1, memory_order_release);
+    }
+
+    return 0;
+}
+
+int ikLogWriter_flush(ikLogWriter *self) {
+    long filled = atomic_load_explicit(&(self->counters->filled), memory_order_acquire);
+    long flushed = atomic_load_explicit(&(self->counters->flushed), memory_order_relaxed);
+    int err = 0;
+
+    /*write the full chunks, in order */
+    while (flushed < filled) {
+        if (!err && (1 != fwrite(self->chunks + (flushed % self->nChunks) * self->chunkSize, self->chunkSize, 1, self->file))) err = -1;
+        atomic_store_explicit(&(self->counters->flushed), ++flushed, memory_order_release);
+    }
+    if (!err && fflush(self->file)) err = -1;
+
+    return err;
+}
+
+int ikLogWriter_getOutput(const ikLogWriter *self, double *output, const char *name) {
+
+    /* pick up the signals */
+    if (!strcmp(name, "samples")) {
+        *output = (double) self->nSamples;
+        return 0;
+    }
+    if (!strcmp(name, "overruns")) {
+        *output = (double) self->overruns;
+        return 0;
+    }
+
+    return -1;
+}
+
+int ikLogWriter_delete(ikLogWriter *self) {
+    int err = ikLogWriter_flush(self);
+    int64_t nSamples = self->nSamples;
+    int i, j;
+
+    /*pad and write the last chunk */
+    if (0 < self->pos) {
+        char *chunk = self->chunks + (atomic_load(&(self->counters->filled)) % self->nChunks) * self->chunkSize;
+        for (i = 0; i < self->nChannels; i++) {
+            for (j = self->pos; j < self->chunkLength; j++) {
+                if (sizeof (double) == self->valueSize) ((double *) chunk)[i * self->chunkLength + j] = NAN;
+                else ((float *) chunk)[i * self->chunkLength + j] = NAN;
+            }
+        }
+        if (!err && (1 != fwrite(chunk, self->chunkSize, 1, self->file))) err = -1;
+    }
+
+    /*register the number of samples in the header */
+    if (!err && fseek(self->file, 24, SEEK_SET)) err = -1;
+    if (!err && (1 != fwrite(&nSamples, 8, 1, self->file))) err = -1;
+
+    /*clean up */
+    if (fclose(self->file) && !err) err = -1;
+    free(self->chunks);
+    free(self->counters);
+
+    return err;
+}
+
+/* @endcond */
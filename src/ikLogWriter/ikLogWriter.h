@@ -0,0 +1,198 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikLogWriter.h
+ * 
+ * @brief Class ikLogWriter interface
+ */
+
+#ifndef IKLOGWRITER_H
+#define IKLOGWRITER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+
+#define IKLOG_MAGIC "ikLog v1"
+#define IKLOG_MAGICSIZE 8
+#define IKLOG_FIXEDHEADERSIZE 32
+#define IKLOG_ALIGNMENT 64
+
+    /**
+     * @struct ikLogWriter
+     * @brief Columnar binary log writer
+     * 
+     * Instances of this type record a number of named channels, one sample
+     * of all of them at a time, to a columnar binary log file, which can be
+     * read back with no parsing by @link ikLogReader @endlink. The channel
+     * names are free, but are meant to follow the naming of the getOutput
+     * methods, e.g. "individual pitch control>My".
+     * 
+     * The samples are kept in a ring of chunks, allocated once by
+     * @link ikLogWriter_init @endlink. @link ikLogWriter_write @endlink only
+     * copies values into the current chunk, so it may be called from the
+     * real-time loop, and @link ikLogWriter_flush @endlink writes the chunks
+     * which are full to the file. Both may be called from the same thread,
+     * e.g. flushing once per chunk, or flush may be called from a lower
+     * priority thread. When all chunks are full, samples are dropped and
+     * counted as overruns, rather than waiting for the file.
+     * 
+     * @par File format
+     * All values are in the native byte order of the writer. The file starts
+     * with a header of size headerSize, a multiple of
+     * @link IKLOG_ALIGNMENT @endlink bytes:
+     * @li bytes 0 to 7: @link IKLOG_MAGIC @endlink
+     * @li bytes 8 to 11: value size, int32, 4 for float or 8 for double
+     * @li bytes 12 to 15: number of channels, int32
+     * @li bytes 16 to 19: chunk length, in samples, int32
+     * @li bytes 20 to 23: headerSize, int32
+     * @li bytes 24 to 31: number of samples, int64, or -1 if the file was
+     * not closed
+     * @li from byte 32: the channel names, each terminated by '\\0', and
+     * zeros up to headerSize
+     * 
+     * The header is followed by chunks, each with one column of chunk length
+     * values per channel, in the order of the channels. Column i of chunk k
+     * starts at byte headerSize + (k*nChannels + i)*chunkLength*valueSize,
+     * and is aligned to @link IKLOG_ALIGNMENT @endlink bytes. The last chunk
+     * is padded with NaN.
+     * 
+     * @par Inputs
+     * @li samples: write via @link ikLogWriter_write @endlink
+     * 
+     * @par Outputs
+     * @li samples: number of samples recorded, get via @link ikLogWriter_getOutput @endlink
+     * @li overruns: number of samples dropped, get via @link ikLogWriter_getOutput @endlink
+     * 
+     * @par Methods
+     * @li @link ikLogWriter_initParams @endlink initialise initialisation parameter structure
+     * @li @link ikLogWriter_init @endlink initialise an instance
+     * @li @link ikLogWriter_write @endlink record a sample
+     * @li @link ikLogWriter_flush @endlink write full chunks to the file
+     * @li @link ikLogWriter_getOutput @endlink get output value
+     * @li @link ikLogWriter_delete @endlink close the file and delete instance
+     */
+    typedef struct ikLogWriter {
+        /**
+         * Private members
+         */
+        /* @cond */
+        FILE *file; /*log file */
+        int nChannels; /*number of channels */
+        int valueSize; /*size of values, 4 or 8 */
+        int chunkLength; /*number of samples per chunk */
+        int nChunks; /*number of chunks in the ring */
+        size_t chunkSize; /*size of a chunk, in bytes */
+        char *chunks; /*ring of chunks */
+        struct ikLogWriterCounters *counters; /*chunk counters, shared by write and flush */
+        int pos; /*position of the next sample in the current chunk */
+        long nSamples; /*number of samples recorded */
+        long overruns; /*number of samples dropped */
+        /* @endcond */
+    } ikLogWriter;
+
+    /**
+     * @struct ikLogWriterParams
+     * @brief Columnar binary log writer initialisation parameters
+     */
+    typedef struct ikLogWriterParams {
+        const char *fileName; /**<name of the log file. The default value is NULL.*/
+        int nChannels; /**<number of channels. The default value is 0.*/
+        const char *const *channels; /**<array of nChannels channel names. The default value is NULL.*/
+        int valueSize; /**<size of values, sizeof(float) or sizeof(double). The default value is sizeof(double).*/
+        int chunkLength; /**<number of samples per chunk, a positive multiple of 16. The default value is 1024.*/
+        int nChunks; /**<number of chunks in the ring, at least 1. The default value is 4.*/
+    } ikLogWriterParams;
+
+    /**
+     * Initialise an instance
+     * 
+     * The log file is created and its header written.
+     * 
+     * @param self instance
+     * @param params initialisation parameters
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid number of channels, must be positive
+     * @li -2: invalid value size, must be 4 or 8
+     * @li -3: invalid chunk length, must be a positive multiple of 16
+     * @li -4: invalid number of chunks, must be at least 1
+     * @li -5: could not allocate memory
+     * @li -6: could not create the file or write its header
+     */
+    int ikLogWriter_init(ikLogWriter *self, const ikLogWriterParams *params);
+
+    /**
+     * Initialise initialisation parameter structure
+     * @param params initialisation parameter structure
+     */
+    void ikLogWriter_initParams(ikLogWriterParams *params);
+
+    /**
+     * Record a sample, with no file access
+     * @param self instance
+     * @param values array with one value per channel
+     * @return error code:
+     * @li 0: no error
+     * @li -1: all chunks are full, the sample has been dropped
+     */
+    int ikLogWriter_write(ikLogWriter *self, const double values[]);
+
+    /**
+     * Write the chunks which are full to the file
+     * @param self instance
+     * @return error code:
+     * @li 0: no error
+     * @li -1: could not write to the file
+     */
+    int ikLogWriter_flush(ikLogWriter *self);
+
+    /**
+     * Get output value by name. All signals named in the class description
+     * are available.
+     * @param self instance
+     * @param output output value
+     * @param name output name, NULL terminated string
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid signal name
+     */
+    int ikLogWriter_getOutput(const ikLogWriter *self, double *output, const char *name);
+
+    /**
+     * Close the file and delete instance
+     * 
+     * The remaining samples are written, with the last chunk padded with
+     * NaN, and the number of samples is written to the header.
+     * 
+     * @param self instance
+     * @return error code:
+     * @li 0: no error
+     * @li -1: could not write to the file
+     */
+    int ikLogWriter_delete(ikLogWriter *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKLOGWRITER_H */
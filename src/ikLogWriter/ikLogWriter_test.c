@@ -0,0 +1,275 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikLogWriter_test.c
+ * 
+ * @brief Class ikLogWriter unit tests
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "ikLogWriter.h"
+
+/*
+ * Simple C Test Suite for class ikLogWriter
+ */
+
+#define NCHANNELS 3
+#define CHUNKLENGTH 16
+#define NSAMPLES 40
+
+const char *channels[NCHANNELS] = {"time", "individual pitch control>My", "pitch 1"};
+
+/**
+ * Value of channel i at sample k.
+ */
+double value(int i, int k) {
+    return 0.1 * k + 100.0 * i - 3.0;
+}
+
+/**
+ * Read a whole file.
+ */
+char *readFile(const char *fileName, long *size) {
+    FILE *f = fopen(fileName, "rb");
+    char *data;
+    if (NULL == f) return NULL;
+    fseek(f, 0, SEEK_END);
+    *size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    data = (char *) malloc(*size + 1);
+    if ((NULL != data) && (1 != fread(data, *size, 1, f)) && (0 < *size)) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    return data;
+}
+
+/**
+ * Write a log and check its contents against the documented format.
+ */
+void checkFormat(const char *testName, int valueSize) {
+    ikLogWriter log;
+    ikLogWriterParams params;
+    double values[NCHANNELS];
+    char *data;
+    long size;
+    int32_t i32;
+    int64_t i64;
+    int headerSize;
+    int err, i, k;
+
+    /*write the log, flushing now and then */
+    ikLogWriter_initParams(&params);
+    params.fileName = "ikLogWriter_test.log";
+    params.nChannels = NCHANNELS;
+    params.channels = channels;
+    params.valueSize = valueSize;
+    params.chunkLength = CHUNKLENGTH;
+    params.nChunks = 2;
+    err = ikLogWriter_init(&log, &params);
+    if (err) {
+        printf("%%TEST_FAILED%% time=0 testname=%s (ikLogWriter_test) message=init returned %d\n", testName, err);
+        return;
+    }
+    for (k = 0; k < NSAMPLES; k++) {
+        for (i = 0; i < NCHANNELS; i++) values[i] = value(i, k);
+        err = ikLogWriter_write(&log, values);
+        if (err) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogWriter_test) message=write returned %d at sample %d\n", testName, err, k);
+        if (7 == k % 8) ikLogWriter_flush(&log);
+    }
+    err = ikLogWriter_delete(&log);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogWriter_test) message=delete returned %d\n", testName, err);
+
+    /*check the header */
+    data = readFile("ikLogWriter_test.log", &size);
+    if (NULL == data) {
+        printf("%%TEST_FAILED%% time=0 testname=%s (ikLogWriter_test) message=could not read the log file\n", testName);
+        return;
+    }
+    if (memcmp(data, IKLOG_MAGIC, IKLOG_MAGICSIZE)) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogWriter_test) message=wrong magic\n", testName);
+    memcpy(&i32, data + 8, 4);
+    if (valueSize != i32) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogWriter_test) message=value size is %d\n", testName, (int) i32);
+    memcpy(&i32, data + 12, 4);
+    if (NCHANNELS != i32) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogWriter_test) message=number of channels is %d\n", testName, (int) i32);
+    memcpy(&i32, data + 16, 4);
+    if (CHUNKLENGTH != i32) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogWriter_test) message=chunk length is %d\n", testName, (int) i32);
+    memcpy(&i32, data + 20, 4);
+    headerSize = i32;
+    if ((128 != headerSize)) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogWriter_test) message=header size is %d\n", testName, headerSize);
+    memcpy(&i64, data + 24, 8);
+    if (NSAMPLES != i64) printf("%%TEST_FAILED%% time=0 testname=%s (ikLogWriter_test) message=number of samples is %ld\n", testName, (long) i64);
+    if (strcmp(data + 32, channels[0]) || strcmp(data + 37, channels[1]) || strcmp(data + 65, channels[2]) || (0 != data[73]) || (0 != data[127])) {
+        printf("%%TEST_FAILED%% time=0 testname=%s (ikLogWriter_test) message=wrong channel names\n", testName);
+    }
+
+    /*check the columns, with padding */
+    if (headerSize + 3 * NCHANNELS * CHUNKLENGTH * valueSize != size) {
+        printf("%%TEST_FAILED%% time=0 testname=%s (ikLogWriter_test) message=file size is %ld\n", testName, size);
+    } else {
+        for (k = 0; k < 3 * CHUNKLENGTH; k++) {
+            for (i = 0; i < NCHANNELS; i++) {
+                long offset = headerSize + (((long) (k / CHUNKLENGTH) * NCHANNELS + i) * CHUNKLENGTH + k % CHUNKLENGTH) * valueSize;
+                double v;
+                if (sizeof (double) == valueSize) {
+                    memcpy(&v, data + offset, sizeof (double));
+                } else {
+                    float f;
+                    memcpy(&f, data + offset, sizeof (float));
+                    v = f;
+                }
+                if ((NSAMPLES > k) && (v != (sizeof (double) == valueSize ? value(i, k) : (float) value(i, k)))) {
+                    printf("%%TEST_FAILED%% time=0 testname=%s (ikLogWriter_test) message=value of channel %d at sample %d is %f\n", testName, i, k, v);
+                }
+                if ((NSAMPLES <= k) && !isnan(v)) {
+                    printf("%%TEST_FAILED%% time=0 testname=%s (ikLogWriter_test) message=padding of channel %d at sample %d is %f\n", testName, i, k, v);
+                }
+            }
+        }
+    }
+
+    free(data);
+    remove("ikLogWriter_test.log");
+}
+
+void testDouble() {
+    printf("ikLogWriter_test testDouble\n");
+    checkFormat("testDouble", sizeof (double));
+}
+
+void testFloat() {
+    printf("ikLogWriter_test testFloat\n");
+    checkFormat("testFloat", sizeof (float));
+}
+
+void testOverrun() {
+    printf("ikLogWriter_test testOverrun\n");
+    ikLogWriter log;
+    ikLogWriterParams params;
+    double values[NCHANNELS] = {1.0, 2.0, 3.0};
+    double output;
+    int err, k;
+
+    ikLogWriter_initParams(&params);
+    params.fileName = "ikLogWriter_test.log";
+    params.nChannels = NCHANNELS;
+    params.channels = channels;
+    params.chunkLength = CHUNKLENGTH;
+    params.nChunks = 2;
+    err = ikLogWriter_init(&log, &params);
+    if (err) {
+        printf("%%TEST_FAILED%% time=0 testname=testOverrun (ikLogWriter_test) message=init returned %d\n", err);
+        return;
+    }
+
+    /*fill the ring without flushing, and see that the samples are dropped */
+    for (k = 0; k < 2 * CHUNKLENGTH + 5; k++) {
+        err = ikLogWriter_write(&log, values);
+        if ((2 * CHUNKLENGTH > k) && err) printf("%%TEST_FAILED%% time=0 testname=testOverrun (ikLogWriter_test) message=write returned %d at sample %d\n", err, k);
+        if ((2 * CHUNKLENGTH <= k) && (-1 != err)) printf("%%TEST_FAILED%% time=0 testname=testOverrun (ikLogWriter_test) message=write returned %d at sample %d, expected -1\n", err, k);
+    }
+    ikLogWriter_getOutput(&log, &output, "samples");
+    if (2 * CHUNKLENGTH != output) printf("%%TEST_FAILED%% time=0 testname=testOverrun (ikLogWriter_test) message=samples is %f\n", output);
+    ikLogWriter_getOutput(&log, &output, "overruns");
+    if (5 != output) printf("%%TEST_FAILED%% time=0 testname=testOverrun (ikLogWriter_test) message=overruns is %f\n", output);
+    if (-1 != ikLogWriter_getOutput(&log, &output, "bad name")) printf("%%TEST_FAILED%% time=0 testname=testOverrun (ikLogWriter_test) message=getOutput accepted a bad name\n");
+
+    /*flush, and see that there is room again */
+    err = ikLogWriter_flush(&log);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testOverrun (ikLogWriter_test) message=flush returned %d\n", err);
+    err = ikLogWriter_write(&log, values);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testOverrun (ikLogWriter_test) message=write returned %d after flush\n", err);
+
+    ikLogWriter_delete(&log);
+    remove("ikLogWriter_test.log");
+}
+
+void testInitErrors() {
+    printf("ikLogWriter_test testInitErrors\n");
+    ikLogWriter log;
+    ikLogWriterParams params;
+    int err;
+
+    /* -1 for bad number of channels */
+    ikLogWriter_initParams(&params);
+    params.fileName = "ikLogWriter_test.log";
+    params.channels = channels;
+    err = ikLogWriter_init(&log, &params);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikLogWriter_test) message=init expected to return -1, but returned %d\n", err);
+
+    /* -2 for bad value size */
+    params.nChannels = NCHANNELS;
+    params.valueSize = 2;
+    err = ikLogWriter_init(&log, &params);
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikLogWriter_test) message=init expected to return -2, but returned %d\n", err);
+
+    /* -3 for bad chunk length */
+    params.valueSize = sizeof (float);
+    params.chunkLength = 20;
+    err = ikLogWriter_init(&log, &params);
+    if (-3 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikLogWriter_test) message=init expected to return -3, but returned %d\n", err);
+
+    /* -4 for bad number of chunks */
+    params.chunkLength = 32;
+    params.nChunks = 0;
+    err = ikLogWriter_init(&log, &params);
+    if (-4 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikLogWriter_test) message=init expected to return -4, but returned %d\n", err);
+
+    /* -6 for a file which cannot be created */
+    params.nChunks = 1;
+    params.fileName = "no such directory/ikLogWriter_test.log";
+    err = ikLogWriter_init(&log, &params);
+    if (-6 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikLogWriter_test) message=init expected to return -6, but returned %d\n", err);
+
+    params.fileName = "ikLogWriter_test.log";
+    err = ikLogWriter_init(&log, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikLogWriter_test) message=init expected to return 0, but returned %d\n", err);
+    else ikLogWriter_delete(&log);
+    remove("ikLogWriter_test.log");
+}
+
+int main(int argc, char** argv) {
+    printf("%%SUITE_STARTING%% ikLogWriter_test\n");
+    printf("%%SUITE_STARTED%%\n");
+
+    printf("%%TEST_STARTED%% testDouble (ikLogWriter_test)\n");
+    testDouble();
+    printf("%%TEST_FINISHED%% time=0 testDouble (ikLogWriter_test) \n");
+
+    printf("%%TEST_STARTED%% testFloat (ikLogWriter_test)\n");
+    testFloat();
+    printf("%%TEST_FINISHED%% time=0 testFloat (ikLogWriter_test) \n");
+
+    printf("%%TEST_STARTED%% testOverrun (ikLogWriter_test)\n");
+    testOverrun();
+    printf("%%TEST_FINISHED%% time=0 testOverrun (ikLogWriter_test) \n");
+
+    printf("%%TEST_STARTED%% testInitErrors (ikLogWriter_test)\n");
+    testInitErrors();
+    printf("%%TEST_FINISHED%% time=0 testInitErrors (ikLogWriter_test) \n");
+
+    printf("%%SUITE_FINISHED%% time=0\n");
+
+    return (EXIT_SUCCESS);
+}
@@ -29,25 +29,56 @@ along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
 #include <stdlib.h>
 #include "../ikNotchList/ikNotchList.h"
 
+/**
+ * (Private) get a list of a given length over the notch filters of a list of
+ * IKNOTCHLIST_NMAX
+ */
+ikNotchListN ikNotchList_view(const ikNotchList *self) {
+    ikNotchListN list;
+    
+    list.n = IKNOTCHLIST_NMAX;
+    list.items = (ikNotchListItem *) self->items;
+    return list;
+}
+
 int ikNotchList_init(ikNotchList *self, const struct ikNotchListParams *params) {
+    ikNotchListN list;
+    
+    /* initialise all the notch filters, in the instance */
+    return ikNotchListN_init(&list, params->dT, IKNOTCHLIST_NMAX, params->notchParams, self->items);
+}
+
+int ikNotchListN_init(ikNotchListN *self, double dT, int n, const ikNotchParams params[], ikNotchListItem buffer[]) {
     /* declare error code */
     int err = 0;
     int err_;
-    /* repeat for all the notch filters */
     int i;
-    for (i = 0; i < IKNOTCHLIST_NMAX; i++) {
+    ikNotchListItem *item;
+    
+    /* check the number of notch filters */
+    if (1 > n) {
+        self->n = 0;
+        self->items = NULL;
+        return 2;
+    }
+    self->n = n;
+    self->items = buffer;
+    
+    /* repeat for all the notch filters */
+    for (i = 0; i < n; i++) {
+        item = &(self->items[i]);
         /* copy enable settings */
-        self->enable[i] = params->notchParams[i].enable;
-        self->variableEnable[i] = params->notchParams[i].variableEnable;
+        item->enable = params[i].enable;
+        item->variableEnable = params[i].variableEnable;
         /* copy frequency settings */
-        self->variableFreq[i] = params->notchParams[i].variableFreq;
+        item->variableFreq = params[i].variableFreq;
         /* initialise notch filter */
         err_ = ikVfnotch_init(
-                &(self->notches[i]),
-                params->dT,
-                params->notchParams[i].freq,
-                params->notchParams[i].dampDen,
-                params->notchParams[i].dampNum);
+                &(item->notch),
+                dT,
+                params[i].freq,
+                params[i].dampDen,
+                params[i].dampNum);
 
         /* register error code */
         if (-1 == err_) err = 1;
@@ -59,38 +90,51 @@ int ikNotchList_init(ikNotchList *self, const struct ikNotchListParams *params)
 }
 
 void ikNotchList_initParams(struct ikNotchListParams *params) {
-    int i;
-    
     /* set sampling time to 1 */
     params->dT = 1.0;
     /* repeat for all the notch filters */
-    for (i = 0; i < IKNOTCHLIST_NMAX; i++) {
+    ikNotchList_initNotchParams(params->notchParams, IKNOTCHLIST_NMAX);
+}
+
+void ikNotchList_initNotchParams(ikNotchParams params[], int n) {
+    int i;
+    
+    /* repeat for all the notch filters */
+    for (i = 0; i < n; i++) {
         /* permanently disable the notch filter */
-        params->notchParams[i].enable = 0;
-        params->notchParams[i].variableEnable = NULL;
+        params[i].enable = 0;
+        params[i].variableEnable = NULL;
         /* permanently set frequency to 1 */
-        params->notchParams[i].freq = 1.0;
-        params->notchParams[i].variableFreq = NULL;
+        params[i].freq = 1.0;
+        params[i].variableFreq = NULL;
         /* set damping to 1 */
-        params->notchParams[i].dampDen = 1.0;
-        params->notchParams[i].dampNum = 1.0;
+        params[i].dampDen = 1.0;
+        params[i].dampNum = 1.0;
     }
 }
 
 double ikNotchList_step(ikNotchList *self, double input) {
+    ikNotchListN list = ikNotchList_view(self);
+    
+    return ikNotchListN_step(&list, input);
+}
+
+double ikNotchListN_step(ikNotchListN *self, double input) {
     /* declare output */
     double output = input;
     double output_;
+    ikNotchListItem *item;
     /* repeat for every notch filter, backwards */
     int i;
-    for (i = IKNOTCHLIST_NMAX - 1; i >= 0; i--) {
+    for (i = self->n - 1; i >= 0; i--) {
+        item = &(self->items[i]);
         /* set frequency */
-        if (NULL != self->variableFreq[i]) ikVfnotch_setFreq(&(self->notches[i]), *(self->variableFreq[i]));
+        if (NULL != item->variableFreq) ikVfnotch_setFreq(&(item->notch), *(item->variableFreq));
         /* take a step */
-        output_ = ikVfnotch_step(&(self->notches[i]), output);
+        output_ = ikVfnotch_step(&(item->notch), output);
         /* if enabled, register output */
-        if (NULL != self->variableEnable[i]) self->enable[i] = *(self->variableEnable[i]);
-        if (self->enable[i]) output = output_;
+        if (NULL != item->variableEnable) item->enable = *(item->variableEnable);
+        if (item->enable) output = output_;
     }
 
     /* return output */
@@ -98,13 +142,68 @@ double ikNotchList_step(ikNotchList *self, double input) {
 }
 
 double ikNotchList_getOutput(const ikNotchList *self, int index) {
+    ikNotchListN list = ikNotchList_view(self);
+    
+    return ikNotchListN_getOutput(&list, index);
+}
+
+double ikNotchListN_getOutput(const ikNotchListN *self, int index) {
     /* saturate the index */
     int index_ = index;
+    if (0 == self->n) return 0.0;
     if (index_ < 0) index_ = 0;
-    if (index_ > IKNOTCHLIST_NMAX - 1) index_ = IKNOTCHLIST_NMAX - 1;
+    if (index_ > self->n - 1) index_ = self->n - 1;
     
     /* return the output of the corresponding notch filter */
-    return ikVfnotch_getOutput(&(self->notches[index_]));
+    return ikVfnotch_getOutput(&(self->items[index_].notch));
+}
+
+void ikNotchList_checkpoint(ikNotchList *self, ikCheckpoint *cp) {
+    ikNotchListN list = ikNotchList_view(self);
+    
+    ikNotchListN_checkpoint(&list, cp);
+}
+
+void ikNotchListN_checkpoint(ikNotchListN *self, ikCheckpoint *cp) {
+    int i;
+    
+    /* repeat for all the notch filters */
+    ikCheckpoint_check(cp, self->n);
+    for (i = 0; i < self->n; i++) {
+        ikVfnotch_checkpoint(&(self->items[i].notch), cp);
+        ikCheckpoint_int(cp, &(self->items[i].enable));
+    }
+}
+
+void ikNotchList_freqResp(const ikNotchList *self, int n, const double w[], double re[], double im[]) {
+    ikNotchListN list = ikNotchList_view(self);
+    
+    ikNotchListN_freqResp(&list, n, w, re, im);
+}
+
+void ikNotchListN_freqResp(const ikNotchListN *self, int n, const double w[], double re[], double im[]) {
+    double z[4*IKSLTI_FREQBLOCK];
+    int i;
+    int k;
+    int m;
+    int enable;
+
+    /*start from a gain of 1 */
+    for (k = 0; k < n; k++) {
+        re[k] = 1.0;
+        im[k] = 0.0;
+    }
+
+    /*multiply by the response of every enabled notch filter, a block of */
+    /*frequencies at a time, sharing their unit delays */
+    for (k = 0; k < n; k += IKSLTI_FREQBLOCK) {
+        m = (n - k < IKSLTI_FREQBLOCK) ? n - k : IKSLTI_FREQBLOCK;
+        ikSlti_delays(m, w + k, z);
+        for (i = 0; i < self->n; i++) {
+            enable = (NULL != self->items[i].variableEnable) ? *(self->items[i].variableEnable) : self->items[i].enable;
+            if (enable) ikVfnotch_mulFreqRespDelays(&(self->items[i].notch), m, z, re + k, im + k);
+        }
+    }
 }
 
 /* @endcond */
@@ -69,13 +69,66 @@ extern "C" {
         double         dT;                                  /**<sampling time, @f$T@f$ [s], as in @link ikVfnotch_init @endlink*/
         ikNotchParams  notchParams     [IKNOTCHLIST_NMAX];  /**<initialisation parameters for every individual notch filter*/
     } ikNotchListParams;
+    
+    /**
+     * @struct ikNotchListItem
+     * @brief Notch filter list storage for one notch filter
+     * 
+     * Arrays of this type are provided to @link ikNotchListN_init @endlink
+     * to hold the notch filters of a list.
+     */
+    typedef struct ikNotchListItem {
+        /**
+         * Private members
+         */
+        /* @cond */
+        ikVfnotch   notch;
+        double      *variableFreq;
+        int         enable;
+        int         *variableEnable;
+        /* @endcond */
+    } ikNotchListItem;
+
+    /**
+     * @struct ikNotchListN
+     * @brief Notch filter list of a given length
+     * 
+     * Instances of this type are lists of notch filters which are applied in
+     * series to a signal, as @link ikNotchList @endlink, but with as many notch
+     * filters as configured on initialisation, held in an array provided by
+     * the caller, so that only those are stored and run.
+     * 
+     * @par Inputs
+     * @li input: specify via @link ikNotchListN_step @endlink
+     * 
+     * @par Outputs
+     * @li output: returned by @link ikNotchListN_step @endlink
+     * 
+     * @par Methods
+     * @li @link ikNotchListN_init @endlink initialise an instance
+     * @li @link ikNotchListN_step @endlink execute periodic calculations
+     * @li @link ikNotchListN_getOutput @endlink get output value
+     * @li @link ikNotchListN_checkpoint @endlink save or restore runtime state
+     * @li @link ikNotchListN_freqResp @endlink get frequency response
+     */
+    typedef struct ikNotchListN {
+        /**
+         * Private members
+         */
+        /* @cond */
+        int             n;      /* number of notch filters */
+        ikNotchListItem *items; /* notch filters, in the caller's array */
+        /* @endcond */
+    } ikNotchListN;
 
     /**
      * @struct ikNotchList
      * @brief Notch filter list
      * 
-     * Instances of this type are lists of transfer functions which are applied
-     * in series to a signal.
+     * Instances of this type are lists of @link IKNOTCHLIST_NMAX @endlink
+     * notch filters which are applied in series to a signal, held in the
+     * instance itself. For lists of other lengths, see
+     * @link ikNotchListN @endlink.
      * 
      * @par Inputs
      * @li input: specify via @link ikNotchList_step @endlink
@@ -95,16 +148,15 @@ extern "C" {
      * @li @link ikNotchList_init @endlink initialise an instance
      * @li @link ikNotchList_step @endlink execute periodic calculations
      * @li @link ikNotchList_getOutput @endlink get output value
+     * @li @link ikNotchList_checkpoint @endlink save or restore runtime state
+     * @li @link ikNotchList_freqResp @endlink get frequency response
      */
     typedef struct ikNotchList {
         /**
          * Private members
          */
         /* @cond */
-        ikVfnotch   notches         [IKNOTCHLIST_NMAX];
-        double      *variableFreq   [IKNOTCHLIST_NMAX];
-        int         enable          [IKNOTCHLIST_NMAX];
-        int         *variableEnable [IKNOTCHLIST_NMAX];
+        ikNotchListItem items   [IKNOTCHLIST_NMAX];
         /* @endcond */
     } ikNotchList;
 
@@ -119,12 +171,41 @@ extern "C" {
      */
     int ikNotchList_init(ikNotchList *self, const struct ikNotchListParams *params);
     
+    /**
+     * Initialise instance, with n notch filters held in a buffer
+     * 
+     * The buffer must persist, and not be used by anything else, for as long as
+     * the instance is used.
+     * 
+     * @param self instance
+     * @param dT sampling time, as in @link ikNotchListParams::dT @endlink
+     * @param n number of notch filters
+     * @param params array of n notch filter initialisation parameters, with
+     * the same meaning as the elements of @link ikNotchListParams::notchParams @endlink
+     * @param buffer array of n elements to hold the notch filters
+     * @return error code:
+     * @li 0: no error
+     * @li 1: invalid sampling time
+     * @li 2: invalid number of notch filters, must be positive. The list is
+     * left empty, and passes its input through.
+     * @li -x: could not initialise x-th notch filter
+     */
+    int ikNotchListN_init(ikNotchListN *self, double dT, int n, const ikNotchParams params[], ikNotchListItem buffer[]);
+    
     /**
      * Initialise initialisation parameter structure with default values
      * @param params initialisation parameter structure
      */
     void ikNotchList_initParams(struct ikNotchListParams *params);
     
+    /**
+     * Initialise notch filter initialisation parameters with default values,
+     * as in @link ikNotchList_initParams @endlink
+     * @param params array of n notch filter initialisation parameters
+     * @param n number of notch filters
+     */
+    void ikNotchList_initNotchParams(ikNotchParams params[], int n);
+    
     /**
      * Execute periodic calculations
      * @param self notch filter lits instance
@@ -133,17 +214,72 @@ extern "C" {
      */
     double ikNotchList_step(ikNotchList *self, double input);
     
+    /**
+     * Execute periodic calculations, as in @link ikNotchList_step @endlink
+     * @param self instance
+     * @param input new input value
+     * @return new output value
+     */
+    double ikNotchListN_step(ikNotchListN *self, double input);
+    
     /**
      * Get output value
      * @param self notch filter list instance
      * @param index index of the notch filter whose output is to be returned,
      * with 0 for the last to be applied, 1 for the last but one to be applied,
-     * and so on. Values below 0 and above @link IKNOTCHLIST_NMAX @endlink - 1 are valid
-     * and equivalent to 0 and @link IKNOTCHLIST_NMAX @endlink - 1, respectively.
-     * @return output value
+     * and so on. Values below 0 and above the number of notch filters - 1 are valid
+     * and equivalent to 0 and the number of notch filters - 1, respectively.
+     * @return output value, or 0 if the list is empty
      */
     double ikNotchList_getOutput(const ikNotchList *self, int index);
     
+    /**
+     * Get output value, as in @link ikNotchList_getOutput @endlink
+     * @param self instance
+     * @param index index of the notch filter whose output is to be returned,
+     * with 0 for the last to be applied, saturated to the length of the list
+     * @return output value, or 0 if the list is empty
+     */
+    double ikNotchListN_getOutput(const ikNotchListN *self, int index);
+
+    /**
+     * Save or restore runtime state, i.e. that of all the notch filters, as
+     * in @link ikVfnotch_checkpoint @endlink, and the enable flags
+     * @param self instance
+     * @param cp checkpoint blob writer or reader
+     */
+    void ikNotchList_checkpoint(ikNotchList *self, ikCheckpoint *cp);
+    
+    /**
+     * Save or restore runtime state, as in @link ikNotchList_checkpoint @endlink
+     * @param self instance
+     * @param cp checkpoint blob writer or reader
+     */
+    void ikNotchListN_checkpoint(ikNotchListN *self, ikCheckpoint *cp);
+
+    /**
+     * Get frequency response of the list, i.e. the product of those of the
+     * enabled notch filters, as in @link ikVfnotch_freqResp @endlink, with
+     * the current enable flags and frequencies
+     * @param self instance
+     * @param n number of frequencies
+     * @param w array of n normalised angular frequencies, in rad per sample,
+     * i.e. angular frequencies in rad/s times the sampling time
+     * @param re array for the real parts of the response, one per frequency
+     * @param im array for the imaginary parts of the response, one per frequency
+     */
+    void ikNotchList_freqResp(const ikNotchList *self, int n, const double w[], double re[], double im[]);
+    
+    /**
+     * Get frequency response of the list, as in @link ikNotchList_freqResp @endlink
+     * @param self instance
+     * @param n number of frequencies
+     * @param w array of n normalised angular frequencies, in rad per sample
+     * @param re array for the real parts of the response, one per frequency
+     * @param im array for the imaginary parts of the response, one per frequency
+     */
+    void ikNotchListN_freqResp(const ikNotchListN *self, int n, const double w[], double re[], double im[]);
+    
 
 #ifdef __cplusplus
 }
@@ -276,6 +276,92 @@ void testGetOutput() {
     ;
 }
 
+/**
+ * The frequency response is the product of those of the enabled notch
+ * filters
+ */
+void testFreqResp() {
+    printf("ikNotchList_test testFreqResp\n");
+    ikNotchList list;
+    ikNotchListParams params;
+    double w[3];
+    double re[3];
+    double im[3];
+
+    ikNotchList_initParams(&params);
+    params.dT = 0.01;
+    params.notchParams[0].enable = 1;
+    params.notchParams[0].freq = 10.0;
+    params.notchParams[0].dampNum = 0.0;
+    params.notchParams[0].dampDen = 0.2;
+    params.notchParams[1].enable = 0;
+    params.notchParams[1].freq = 30.0;
+    params.notchParams[1].dampNum = 0.0;
+    params.notchParams[1].dampDen = 0.2;
+    ikNotchList_init(&list, &params);
+    w[0] = 0.0;
+    w[1] = 2.0 * atan(10.0 * 0.01 / 2.0);
+    w[2] = 2.0 * atan(30.0 * 0.01 / 2.0);
+    ikNotchList_freqResp(&list, 3, w, re, im);
+    if ((fabs(1.0 - re[0]) > 1e-12) || (fabs(im[0]) > 1e-12)) printf("%%TEST_FAILED%% time=0 testname=testFreqResp (ikNotchList_test) message=static gain expected to be 1, but it is %f%+fj\n", re[0], im[0]);
+    if (hypot(re[1], im[1]) > 1e-12) printf("%%TEST_FAILED%% time=0 testname=testFreqResp (ikNotchList_test) message=gain at the enabled notch expected to be 0, but it is %f%+fj\n", re[1], im[1]);
+    if (hypot(re[2], im[2]) < 0.5) printf("%%TEST_FAILED%% time=0 testname=testFreqResp (ikNotchList_test) message=gain at the disabled notch expected to be near 1, but it is %f%+fj\n", re[2], im[2]);
+}
+
+/**
+ * Initialise a list of more than IKNOTCHLIST_NMAX notch filters from a buffer
+ * and see that it behaves like the same notch filters in series.
+ */
+void testListN() {
+    printf("ikNotchList_test testListN\n");
+    int err;
+    int i;
+    int k;
+    double input;
+    double expected;
+    double output;
+    double freq = 3.0;
+    ikNotchListN list;
+    ikNotchParams params[IKNOTCHLIST_NMAX + 4];
+    ikNotchListItem buffer[IKNOTCHLIST_NMAX + 4];
+    ikVfnotch notches[IKNOTCHLIST_NMAX + 4];
+    
+    /* enabled notch filters at increasing frequencies, one of them variable */
+    ikNotchList_initNotchParams(params, IKNOTCHLIST_NMAX + 4);
+    for (i = 0; i < IKNOTCHLIST_NMAX + 4; i++) {
+        params[i].enable = 1;
+        params[i].freq = 1.0 + i;
+        params[i].dampDen = 0.5;
+        params[i].dampNum = 0.01;
+        ikVfnotch_init(&(notches[i]), 0.01, params[i].freq, params[i].dampDen, params[i].dampNum);
+    }
+    params[2].variableFreq = &freq;
+    err = ikNotchListN_init(&list, 0.01, IKNOTCHLIST_NMAX + 4, params, buffer);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testListN (ikNotchList_test) message=expected error code 0, but got %d\n", err);
+    
+    for (k = 0; k < 500; k++) {
+        input = sin(0.05 * k) + sin(0.1 * k);
+        freq = 3.0 + sin(0.01 * k);
+        ikVfnotch_setFreq(&(notches[2]), freq);
+        expected = input;
+        for (i = IKNOTCHLIST_NMAX + 3; i >= 0; i--) expected = ikVfnotch_step(&(notches[i]), expected);
+        output = ikNotchListN_step(&list, input);
+        if (expected != output) {
+            printf("%%TEST_FAILED%% time=0 testname=testListN (ikNotchList_test) message=output expected to be %f at step %d, but it is %f\n", expected, k, output);
+            break;
+        }
+    }
+    if (ikNotchListN_getOutput(&list, IKNOTCHLIST_NMAX + 3) != ikVfnotch_getOutput(&(notches[IKNOTCHLIST_NMAX + 3]))) printf("%%TEST_FAILED%% time=0 testname=testListN (ikNotchList_test) message=output of the first notch filter applied not as expected\n");
+    
+    /* invalid sampling time and length */
+    err = ikNotchListN_init(&list, 0.0, IKNOTCHLIST_NMAX + 4, params, buffer);
+    if (1 != err) printf("%%TEST_FAILED%% time=0 testname=testListN (ikNotchList_test) message=expected error code 1, but got %d\n", err);
+    err = ikNotchListN_init(&list, 0.01, -1, params, buffer);
+    if (2 != err) printf("%%TEST_FAILED%% time=0 testname=testListN (ikNotchList_test) message=expected error code 2, but got %d\n", err);
+    output = ikNotchListN_step(&list, 3.0);
+    if (3.0 != output) printf("%%TEST_FAILED%% time=0 testname=testListN (ikNotchList_test) message=expected an empty list to output 3.0, but got %f\n", output);
+}
+
 int main(int argc, char** argv) {
     printf("%%SUITE_STARTING%% ikNotchList_test\n");
     printf("%%SUITE_STARTED%%\n");
@@ -296,6 +382,14 @@ int main(int argc, char** argv) {
     testGetOutput();
     printf("%%TEST_FINISHED%% time=0 testGetOutput (ikNotchList_test) \n");
 
+    printf("%%TEST_STARTED%% testFreqResp (ikNotchList_test)\n");
+    testFreqResp();
+    printf("%%TEST_FINISHED%% time=0 testFreqResp (ikNotchList_test) \n");
+
+    printf("%%TEST_STARTED%% testListN (ikNotchList_test)\n");
+    testListN();
+    printf("%%TEST_FINISHED%% time=0 testListN (ikNotchList_test) \n");
+
     printf("%%SUITE_FINISHED%% time=0\n");
 
     return (EXIT_SUCCESS);
@@ -0,0 +1,78 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikProfile.c
+ * 
+ * @brief Class ikProfile implementation
+ */
+
+/* @cond */
+
+#include <string.h>
+#include "ikBench.h"
+#include "ikProfile.h"
+
+void ikProfile_init(ikProfile *self) {
+    self->calls = 0;
+    self->saturations = 0;
+    self->cycles = 0;
+    self->start = 0;
+    self->depth = 0;
+}
+
+void ikProfile_start(ikProfile *self) {
+    /*count and time the outermost call only */
+    if (0 < self->depth++) return;
+    self->calls++;
+    self->start = ikBench_now();
+}
+
+void ikProfile_stop(ikProfile *self) {
+    if (0 >= self->depth) return;
+    if (0 < --self->depth) return;
+    self->cycles += ikBench_now() - self->start;
+}
+
+void ikProfile_saturate(ikProfile *self) {
+    self->saturations++;
+}
+
+int ikProfile_getOutput(const ikProfile *self, double *output, const char *name) {
+    if (!strcmp(name, "calls")) {
+        *output = (double) self->calls;
+        return 0;
+    }
+    if (!strcmp(name, "cycles")) {
+        *output = (double) self->cycles;
+        return 0;
+    }
+    if (!strcmp(name, "cycles per call")) {
+        *output = self->calls ? (double) self->cycles / self->calls : 0.0;
+        return 0;
+    }
+    if (!strcmp(name, "saturations")) {
+        *output = (double) self->saturations;
+        return 0;
+    }
+
+    return -1;
+}
+
+/* @endcond */
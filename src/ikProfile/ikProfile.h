@@ -0,0 +1,121 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikProfile.h
+ * 
+ * @brief Class ikProfile interface
+ */
+
+#ifndef IKPROFILE_H
+#define IKPROFILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+    /**
+     * @struct ikProfile
+     * @brief Execution profile counters
+     * 
+     * Instances of this type count the calls to a periodic method, the time
+     * spent in them, and the saturation events in them. They are the
+     * building block of the built-in profiling of the controller classes,
+     * which is enabled by defining IKPROFILE at compile time. When it is
+     * not defined, the controller classes do not keep profiles, and this
+     * class is not used by them.
+     * 
+     * The periodic method calls @link ikProfile_start @endlink when it starts
+     * and @link ikProfile_stop @endlink before it returns. Nested calls, as
+     * in recursive methods, are counted and timed once, as part of the
+     * outermost call. The times are read with @link ikBench_now @endlink,
+     * and are given in the unit of @link ikBench_getUnit @endlink, usually
+     * cycles.
+     * 
+     * @par Outputs
+     * @li calls: number of calls, get via @link ikProfile_getOutput @endlink
+     * @li cycles: cumulative time of the calls, get via @link ikProfile_getOutput @endlink
+     * @li cycles per call: mean time of the calls, get via @link ikProfile_getOutput @endlink
+     * @li saturations: number of saturation events, get via @link ikProfile_getOutput @endlink
+     * 
+     * @par Methods
+     * @li @link ikProfile_init @endlink initialise an instance
+     * @li @link ikProfile_start @endlink start a call
+     * @li @link ikProfile_stop @endlink finish a call
+     * @li @link ikProfile_saturate @endlink count a saturation event
+     * @li @link ikProfile_getOutput @endlink get output value
+     */
+    typedef struct ikProfile {
+        /**
+         * Private members
+         */
+        /* @cond */
+        long calls; /*number of calls */
+        long saturations; /*number of saturation events */
+        uint64_t cycles; /*cumulative time of the calls */
+        uint64_t start; /*counter value at the start of the current call */
+        int depth; /*nesting depth of the current call */
+        /* @endcond */
+    } ikProfile;
+
+    /**
+     * Initialise an instance, with all counters at 0
+     * @param self instance
+     */
+    void ikProfile_init(ikProfile *self);
+
+    /**
+     * Start a call
+     * @param self instance
+     */
+    void ikProfile_start(ikProfile *self);
+
+    /**
+     * Finish a call
+     * @param self instance
+     */
+    void ikProfile_stop(ikProfile *self);
+
+    /**
+     * Count a saturation event
+     * @param self instance
+     */
+    void ikProfile_saturate(ikProfile *self);
+
+    /**
+     * Get output value by name. All signals named in the class description
+     * are available.
+     * @param self instance
+     * @param output output value
+     * @param name output name, NULL terminated string
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid signal name
+     */
+    int ikProfile_getOutput(const ikProfile *self, double *output, const char *name);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKPROFILE_H */
+
@@ -0,0 +1,156 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikProfile_test.c
+ * 
+ * @brief Class ikProfile unit tests
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "ikProfile.h"
+
+/*
+ * Simple C Test Suite for class ikProfile
+ */
+
+/**
+ * Busy loop, which the compiler cannot remove.
+ */
+void spin(long n) {
+    volatile long i;
+    for (i = 0; i < n; i++);
+}
+
+/**
+ * Get an output, reporting an error as a failure of the named test.
+ */
+double output(const ikProfile *profile, const char *name, const char *test) {
+    double value = 0.0;
+    int err = ikProfile_getOutput(profile, &value, name);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=%s (ikProfile_test) message=getOutput expected to return 0 for %s, but returned %d\n", test, name, err);
+    return value;
+}
+
+void testCounters() {
+    ikProfile profile;
+    double calls, cycles, saturations, cyclesPerCall;
+    double shortCycles;
+    int i;
+
+    printf("ikProfile_test testCounters\n");
+
+    /*nothing counted yet */
+    ikProfile_init(&profile);
+    calls = output(&profile, "calls", "testCounters");
+    cycles = output(&profile, "cycles", "testCounters");
+    cyclesPerCall = output(&profile, "cycles per call", "testCounters");
+    saturations = output(&profile, "saturations", "testCounters");
+    if ((0.0 != calls) || (0.0 != cycles) || (0.0 != cyclesPerCall) || (0.0 != saturations)) printf("%%TEST_FAILED%% time=0 testname=testCounters (ikProfile_test) message=counters expected to be 0 after init, but were %f, %f, %f and %f\n", calls, cycles, cyclesPerCall, saturations);
+
+    /*short calls */
+    for (i = 0; i < 10; i++) {
+        ikProfile_start(&profile);
+        spin(10);
+        ikProfile_stop(&profile);
+    }
+    calls = output(&profile, "calls", "testCounters");
+    shortCycles = output(&profile, "cycles", "testCounters");
+    if (10.0 != calls) printf("%%TEST_FAILED%% time=0 testname=testCounters (ikProfile_test) message=calls expected to be 10, but was %f\n", calls);
+    if (0.0 >= shortCycles) printf("%%TEST_FAILED%% time=0 testname=testCounters (ikProfile_test) message=cycles expected to be positive, but was %f\n", shortCycles);
+
+    /*a long call adds much more time */
+    ikProfile_start(&profile);
+    spin(10000000);
+    ikProfile_stop(&profile);
+    calls = output(&profile, "calls", "testCounters");
+    cycles = output(&profile, "cycles", "testCounters");
+    cyclesPerCall = output(&profile, "cycles per call", "testCounters");
+    if (11.0 != calls) printf("%%TEST_FAILED%% time=0 testname=testCounters (ikProfile_test) message=calls expected to be 11, but was %f\n", calls);
+    if (cycles < 10.0 * shortCycles) printf("%%TEST_FAILED%% time=0 testname=testCounters (ikProfile_test) message=cycles expected to grow tenfold from %f, but were %f\n", shortCycles, cycles);
+    if (1e-9 * cycles < fabs(cycles / 11.0 - cyclesPerCall)) printf("%%TEST_FAILED%% time=0 testname=testCounters (ikProfile_test) message=cycles per call expected to be %f, but was %f\n", cycles / 11.0, cyclesPerCall);
+
+    /*saturation events */
+    ikProfile_saturate(&profile);
+    ikProfile_saturate(&profile);
+    saturations = output(&profile, "saturations", "testCounters");
+    if (2.0 != saturations) printf("%%TEST_FAILED%% time=0 testname=testCounters (ikProfile_test) message=saturations expected to be 2, but was %f\n", saturations);
+}
+
+void testNesting() {
+    ikProfile profile;
+    double calls, cycles;
+
+    printf("ikProfile_test testNesting\n");
+
+    /*nested calls are part of the outermost one */
+    ikProfile_init(&profile);
+    ikProfile_start(&profile);
+    ikProfile_start(&profile);
+    ikProfile_stop(&profile);
+    calls = output(&profile, "calls", "testNesting");
+    cycles = output(&profile, "cycles", "testNesting");
+    if (1.0 != calls) printf("%%TEST_FAILED%% time=0 testname=testNesting (ikProfile_test) message=calls expected to be 1, but was %f\n", calls);
+    if (0.0 != cycles) printf("%%TEST_FAILED%% time=0 testname=testNesting (ikProfile_test) message=cycles expected to be 0 until the outermost call finishes, but were %f\n", cycles);
+    ikProfile_stop(&profile);
+    cycles = output(&profile, "cycles", "testNesting");
+    if (0.0 >= cycles) printf("%%TEST_FAILED%% time=0 testname=testNesting (ikProfile_test) message=cycles expected to be positive, but were %f\n", cycles);
+
+    /*unmatched stops are ignored */
+    ikProfile_stop(&profile);
+    ikProfile_start(&profile);
+    ikProfile_stop(&profile);
+    calls = output(&profile, "calls", "testNesting");
+    if (2.0 != calls) printf("%%TEST_FAILED%% time=0 testname=testNesting (ikProfile_test) message=calls expected to be 2, but was %f\n", calls);
+}
+
+void testGetOutputErrors() {
+    ikProfile profile;
+    double value;
+    int err;
+
+    printf("ikProfile_test testGetOutputErrors\n");
+
+    ikProfile_init(&profile);
+    err = ikProfile_getOutput(&profile, &value, "cycle");
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testGetOutputErrors (ikProfile_test) message=getOutput expected to return -1, but returned %d\n", err);
+}
+
+int main(int argc, char** argv) {
+    printf("%%SUITE_STARTING%% ikProfile_test\n");
+    printf("%%SUITE_STARTED%%\n");
+
+    printf("%%TEST_STARTED%% testCounters (ikProfile_test)\n");
+    testCounters();
+    printf("%%TEST_FINISHED%% time=0 testCounters (ikProfile_test) \n");
+
+    printf("%%TEST_STARTED%% testNesting (ikProfile_test)\n");
+    testNesting();
+    printf("%%TEST_FINISHED%% time=0 testNesting (ikProfile_test) \n");
+
+    printf("%%TEST_STARTED%% testGetOutputErrors (ikProfile_test)\n");
+    testGetOutputErrors();
+    printf("%%TEST_FINISHED%% time=0 testGetOutputErrors (ikProfile_test) \n");
+
+    printf("%%SUITE_FINISHED%% time=0\n");
+
+    return (EXIT_SUCCESS);
+}
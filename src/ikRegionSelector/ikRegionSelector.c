@@ -27,26 +27,540 @@ along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
 
 /* @cond */
 
+#include <math.h>
+
+/* number of edges tested together, the number of edges is padded to a multiple of it */
+#define IKREGIONSELECTOR_EDGEBLOCK 4
+
+/**
+ * (Private) get the points of a region
+ * @param params initialisation parameters
+ * @param i region index, starting at 0
+ * @param points points of the region
+ * @return number of points, -1 if it is invalid
+ */
+int ikRegionSelector_getPoints(const ikRegionSelectorPolygonParams *params, int i, const ikRegionSelectorPoint **points) {
+    int n = params->polygons[i].nPoints;
+    
+    *points = params->polygons[i].points;
+    if (0 > n || (0 < n && NULL == *points)) return -1;
+    
+    return n;
+}
+
+/**
+ * (Private) get the points of a region, taking those with an invalid number of points as empty
+ * @param params initialisation parameters
+ * @param i region index, starting at 0
+ * @param points points of the region
+ * @return number of points
+ */
+int ikRegionSelector_getValidPoints(const ikRegionSelectorPolygonParams *params, int i, const ikRegionSelectorPoint **points) {
+    int n = ikRegionSelector_getPoints(params, i, points);
+    return 0 > n ? 0 : n;
+}
+
+/**
+ * (Private) check whether an edge of a region spans a slab
+ * @param points points of the region
+ * @param nPoints number of points
+ * @param j edge index, the edge goes from point j to the next
+ * @param slab y boundaries of the slab, or NULL for all edges
+ * @return 1 if the edge spans the slab, 0 otherwise
+ */
+int ikRegionSelector_spans(const ikRegionSelectorPoint *points, int nPoints, int j, const double *slab) {
+    double y0 = points[j].y;
+    double y1 = points[j + 1 < nPoints ? j + 1 : 0].y;
+    
+    if (NULL == slab) return 1;
+    return (y0 <= slab[0] && y1 >= slab[1]) || (y1 <= slab[0] && y0 >= slab[1]);
+}
+
+/**
+ * (Private) count the edges of a region
+ * @param points points of the region
+ * @param nPoints number of points
+ * @param slab y boundaries of a slab to count only the edges spanning it, or NULL for all edges
+ * @return number of edges, padded to a multiple of the edge block if not 0
+ */
+int ikRegionSelector_countEdges(const ikRegionSelectorPoint *points, int nPoints, const double *slab) {
+    int j;
+    int n = 0;
+    
+    for (j = 0; j < nPoints; j++) n += ikRegionSelector_spans(points, nPoints, j, slab);
+    
+    return (n + IKREGIONSELECTOR_EDGEBLOCK - 1) / IKREGIONSELECTOR_EDGEBLOCK * IKREGIONSELECTOR_EDGEBLOCK;
+}
+
+/**
+ * (Private) point edges to their values in a table
+ * @param edges edges
+ * @param data values of the edges, 5 per edge
+ * @param n number of edges
+ */
+void ikRegionSelector_viewEdges(ikRegionSelectorEdges *edges, const double *data, int n) {
+    edges->n = n;
+    edges->x0 = data;
+    edges->y0 = data + n;
+    edges->y1 = data + 2*n;
+    edges->dx = data + 3*n;
+    edges->dy = data + 4*n;
+}
+
+/**
+ * (Private) set the edges of a region
+ * @param data values of the edges, 5 per edge after padding, as returned by ikRegionSelector_countEdges
+ * @param points points of the region
+ * @param nPoints number of points
+ * @param slab y boundaries of a slab to take only the edges spanning it, or NULL for all edges
+ * @return number of edges, after padding
+ */
+int ikRegionSelector_setEdges(double *data, const ikRegionSelectorPoint *points, int nPoints, const double *slab) {
+    int j;
+    int j1;
+    int k = 0;
+    int n = ikRegionSelector_countEdges(points, nPoints, slab);
+    double *x0 = data;
+    double *y0 = data + n;
+    double *y1 = data + 2*n;
+    double *dx = data + 3*n;
+    double *dy = data + 4*n;
+
+    /* precompute the edges, with the wrap-around resolved */
+    for (j = 0; j < nPoints; j++) {
+        if (!ikRegionSelector_spans(points, nPoints, j, slab)) continue;
+        j1 = j + 1;
+        if (j1 > nPoints - 1) j1 = 0;
+        x0[k] = points[j].x;
+        y0[k] = points[j].y;
+        y1[k] = points[j1].y;
+        dx[k] = points[j1].x - points[j].x;
+        dy[k] = points[j1].y - points[j].y;
+        k++;
+    }
+
+    /* pad with edges whose y coordinates are not numbers, so that they never cross */
+    for (; k < n; k++) {
+        x0[k] = 0.0;
+        y0[k] = NAN;
+        y1[k] = NAN;
+        dx[k] = 0.0;
+        dy[k] = 0.0;
+    }
+    
+    return n;
+}
+
+/**
+ * (Private) get the x limits of the edges of a region
+ * @param points points of the region
+ * @param nPoints number of points
+ * @param slab y boundaries of a slab to take only the edges spanning it, or NULL for all edges
+ * @param xMin lower limit, larger than xMax if there are no edges
+ * @param xMax upper limit
+ */
+void ikRegionSelector_getLimits(const ikRegionSelectorPoint *points, int nPoints, const double *slab, double *xMin, double *xMax) {
+    int j;
+    int j1;
+    int empty = 1;
+    
+    *xMin = 0.0;
+    *xMax = -1.0;
+    for (j = 0; j < nPoints; j++) {
+        if (!ikRegionSelector_spans(points, nPoints, j, slab)) continue;
+        j1 = j + 1;
+        if (j1 > nPoints - 1) j1 = 0;
+        if (empty || points[j].x < *xMin) *xMin = points[j].x;
+        if (empty || points[j].x > *xMax) *xMax = points[j].x;
+        if (points[j1].x < *xMin) *xMin = points[j1].x;
+        if (points[j1].x > *xMax) *xMax = points[j1].x;
+        empty = 0;
+    }
+}
+
+/**
+ * (Private) get the bounding box of a region
+ * @param points points of the region
+ * @param nPoints number of points
+ * @param box xMin, xMax, yMin and yMax, with the minima larger than the maxima if there are no points
+ */
+void ikRegionSelector_getBox(const ikRegionSelectorPoint *points, int nPoints, double box[]) {
+    int j;
+    
+    ikRegionSelector_getLimits(points, nPoints, NULL, box, box + 1);
+    box[2] = 0.0;
+    box[3] = -1.0;
+    for (j = 0; j < nPoints; j++) {
+        if (!j || points[j].y < box[2]) box[2] = points[j].y;
+        if (!j || points[j].y > box[3]) box[3] = points[j].y;
+    }
+}
+
+/**
+ * (Private) check whether two bounding boxes overlap
+ * @param a bounding box, xMin, xMax, yMin and yMax
+ * @param b bounding box, xMin, xMax, yMin and yMax
+ * @return 1 if they overlap, 0 otherwise
+ */
+int ikRegionSelector_overlap(const double a[], const double b[]) {
+    return a[0] <= b[1] && b[0] <= a[1] && a[2] <= b[3] && b[2] <= a[3];
+}
+
+/**
+ * (Private) get the next y boundary of the slabs
+ * @param params initialisation parameters
+ * @param nRegions number of regions
+ * @param first flag: 1 to get the first boundary, 0 to get the one after y
+ * @param y current boundary
+ * @param next next boundary, the lowest y coordinate of all points above y
+ * @return 1 if there is a next boundary, 0 otherwise
+ */
+int ikRegionSelector_nextY(const ikRegionSelectorPolygonParams *params, int nRegions, int first, double y, double *next) {
+    const ikRegionSelectorPoint *points;
+    int i;
+    int j;
+    int n;
+    int found = 0;
+    
+    for (i = 0; i < nRegions; i++) {
+        n = ikRegionSelector_getValidPoints(params, i, &points);
+        for (j = 0; j < n; j++) {
+            if (isnan(points[j].y) || (!first && !(points[j].y > y))) continue;
+            if (!found || points[j].y < *next) *next = points[j].y;
+            found = 1;
+        }
+    }
+    
+    return found;
+}
+
+/**
+ * (Private) find the last of a series of ascending values not above another
+ * @param values values in ascending order
+ * @param n number of values
+ * @param value value, not below values[0]
+ * @return index of the last value not above value
+ */
+int ikRegionSelector_search(const double values[], int n, double value) {
+    int lo = 0;
+    int hi = n;
+    int mid;
+    
+    /* keep values[lo] <= value < values[hi], with values[n] taken as infinite */
+    while (1 < hi - lo) {
+        mid = lo + (hi - lo) / 2;
+        if (values[mid] <= value) lo = mid;
+        else hi = mid;
+    }
+    
+    return lo;
+}
+
+/**
+ * (Private) lay out the tables of a set of regions
+ * @param tables tables, with the number of regions and the index flag set
+ * @param params initialisation parameters
+ */
+void ikRegionSelector_layOut(ikRegionSelectorTables *tables, const ikRegionSelectorPolygonParams *params) {
+    const ikRegionSelectorPoint *points;
+    const ikRegionSelectorPoint *pointsJ;
+    double box[4];
+    double boxJ[4];
+    double slab[2];
+    int i;
+    int j;
+    int n;
+    int c;
+    int nEdgeData = 0;
+    int nOverlaps = 0;
+    int nIndexData = 0;
+    
+    /* count the edges of the regions, and the earlier regions whose bounding boxes overlap each region's */
+    for (i = 0; i < tables->regionN; i++) {
+        n = ikRegionSelector_getValidPoints(params, i, &points);
+        nEdgeData += 5 * ikRegionSelector_countEdges(points, n, NULL);
+        ikRegionSelector_getBox(points, n, box);
+        for (j = 0; j < i; j++) {
+            ikRegionSelector_getBox(pointsJ, ikRegionSelector_getValidPoints(params, j, &pointsJ), boxJ);
+            nOverlaps += ikRegionSelector_overlap(box, boxJ);
+        }
+    }
+    
+    /* count the slabs, cut at the y coordinates of all points, and the regions with edges spanning each */
+    tables->nSlabs = 0;
+    tables->nEntries = 0;
+    if (tables->indexed && ikRegionSelector_nextY(params, tables->regionN, 1, 0.0, slab)) {
+        while (ikRegionSelector_nextY(params, tables->regionN, 0, slab[0], slab + 1)) {
+            for (i = 0; i < tables->regionN; i++) {
+                n = ikRegionSelector_getValidPoints(params, i, &points);
+                ikRegionSelector_getBox(points, n, box);
+                if (box[2] > slab[0] || box[3] < slab[1]) continue;
+                c = ikRegionSelector_countEdges(points, n, slab);
+                if (!c) continue;
+                tables->nEntries++;
+                nIndexData += 5 * c;
+            }
+            tables->nSlabs++;
+            slab[0] = slab[1];
+        }
+    }
+    
+    /* lay out the double values */
+    tables->nDoubles = 0;
+    tables->box = tables->nDoubles;
+    tables->nDoubles += 4 * tables->regionN + nEdgeData;
+    tables->slabY = tables->nDoubles;
+    tables->entryX = tables->nDoubles;
+    if (tables->indexed) {
+        tables->entryX += tables->nSlabs + 1;
+        tables->nDoubles += tables->nSlabs + 1 + 3 * tables->nEntries + nIndexData;
+    }
+    
+    /* and the int values */
+    tables->nInts = 0;
+    tables->regionEdges = tables->nInts;
+    tables->nInts += 2 * tables->regionN;
+    tables->overlapStart = tables->nInts;
+    tables->nInts += tables->regionN + 1;
+    tables->overlaps = tables->nInts;
+    tables->nInts += nOverlaps;
+    tables->slabEntries = tables->nInts;
+    tables->entries = tables->nInts;
+    if (tables->indexed) {
+        tables->entries += tables->nSlabs + 1;
+        tables->nInts += tables->nSlabs + 1 + 3 * tables->nEntries;
+    }
+}
+
+/**
+ * (Private) fill the tables of a set of regions
+ * @param tables tables, as laid out by ikRegionSelector_layOut
+ * @param params initialisation parameters
+ * @param d double values
+ * @param k int values
+ */
+void ikRegionSelector_fill(const ikRegionSelectorTables *tables, const ikRegionSelectorPolygonParams *params, double *d, int *k) {
+    const ikRegionSelectorPoint *points;
+    double *xMin = d + tables->box;
+    double *xMax = xMin + tables->regionN;
+    double *yMin = xMax + tables->regionN;
+    double *yMax = yMin + tables->regionN;
+    double *entryXMin = d + tables->entryX;
+    double *entryXMax = entryXMin + tables->nEntries;
+    double *entryReach = entryXMax + tables->nEntries;
+    double *slabY = d + tables->slabY;
+    int *entries = k + tables->entries;
+    int *slabEntries = k + tables->slabEntries;
+    double box[4];
+    double boxJ[4];
+    double slab[2];
+    double x;
+    int entry[3];
+    int nd;
+    int nk;
+    int i;
+    int j;
+    int n;
+    int e;
+    int s;
+    
+    /* compile the edges and bounding boxes of the regions */
+    nd = tables->box + 4 * tables->regionN;
+    for (i = 0; i < tables->regionN; i++) {
+        n = ikRegionSelector_getValidPoints(params, i, &points);
+        k[tables->regionEdges + 2*i] = nd;
+        k[tables->regionEdges + 2*i + 1] = ikRegionSelector_setEdges(d + nd, points, n, NULL);
+        nd += 5 * k[tables->regionEdges + 2*i + 1];
+        ikRegionSelector_getBox(points, n, box);
+        xMin[i] = box[0];
+        xMax[i] = box[1];
+        yMin[i] = box[2];
+        yMax[i] = box[3];
+    }
+    
+    /* list the earlier regions whose bounding boxes overlap each region's */
+    nk = tables->overlaps;
+    for (i = 0; i < tables->regionN; i++) {
+        k[tables->overlapStart + i] = nk - tables->overlaps;
+        box[0] = xMin[i];
+        box[1] = xMax[i];
+        box[2] = yMin[i];
+        box[3] = yMax[i];
+        for (j = 0; j < i; j++) {
+            boxJ[0] = xMin[j];
+            boxJ[1] = xMax[j];
+            boxJ[2] = yMin[j];
+            boxJ[3] = yMax[j];
+            if (ikRegionSelector_overlap(box, boxJ)) k[nk++] = j;
+        }
+    }
+    k[tables->overlapStart + tables->regionN] = nk - tables->overlaps;
+    
+    /* register the regions with edges spanning each slab as entries, */
+    /* with those edges, sorted by the lower x limit of the edges */
+    if (!tables->indexed) return;
+    nd = tables->entryX + 3 * tables->nEntries;
+    e = 0;
+    slabY[0] = 0.0;
+    if (tables->nSlabs) ikRegionSelector_nextY(params, tables->regionN, 1, 0.0, slab);
+    for (s = 0; s < tables->nSlabs; s++) {
+        ikRegionSelector_nextY(params, tables->regionN, 0, slab[0], slab + 1);
+        slabY[s] = slab[0];
+        slabY[s + 1] = slab[1];
+        slabEntries[s] = e;
+        for (i = 0; i < tables->regionN; i++) {
+            if (yMin[i] > slab[0] || yMax[i] < slab[1]) continue;
+            n = ikRegionSelector_getValidPoints(params, i, &points);
+            if (!ikRegionSelector_countEdges(points, n, slab)) continue;
+            entries[3*e] = i;
+            entries[3*e + 1] = nd;
+            entries[3*e + 2] = ikRegionSelector_setEdges(d + nd, points, n, slab);
+            nd += 5 * entries[3*e + 2];
+            ikRegionSelector_getLimits(points, n, slab, &(entryXMin[e]), &(entryXMax[e]));
+            
+            /* insert the entry in order */
+            for (j = e; j > slabEntries[s] && entryXMin[j - 1] > entryXMin[j]; j--) {
+                x = entryXMin[j]; entryXMin[j] = entryXMin[j - 1]; entryXMin[j - 1] = x;
+                x = entryXMax[j]; entryXMax[j] = entryXMax[j - 1]; entryXMax[j - 1] = x;
+                for (n = 0; n < 3; n++) entry[n] = entries[3*j + n];
+                for (n = 0; n < 3; n++) entries[3*j + n] = entries[3*(j - 1) + n];
+                for (n = 0; n < 3; n++) entries[3*(j - 1) + n] = entry[n];
+            }
+            e++;
+        }
+        
+        /* take the largest upper limit up to each entry */
+        for (j = slabEntries[s]; j < e; j++) {
+            entryReach[j] = j > slabEntries[s] && entryReach[j - 1] > entryXMax[j] ? entryReach[j - 1] : entryXMax[j];
+        }
+        slab[0] = slab[1];
+    }
+    slabEntries[tables->nSlabs] = e;
+}
+
+/**
+ * (Private) get the size of the tables of a set of regions
+ * @param tables tables, as laid out by ikRegionSelector_layOut
+ * @return size, in bytes
+ */
+size_t ikRegionSelector_getSize(const ikRegionSelectorTables *tables) {
+    return sizeof(double) * tables->nDoubles + sizeof(int) * tables->nInts;
+}
+
+/**
+ * (Private) get the tables of an instance
+ * @param self instance
+ * @param d double values
+ * @param k int values
+ */
+void ikRegionSelector_getTables(const ikRegionSelector *self, const double **d, const int **k) {
+    if (NULL == self->buffer) {
+        *d = self->doubles;
+        *k = self->ints;
+    } else {
+        *d = (const double *) self->buffer;
+        *k = (const int *) (*d + self->tables.nDoubles);
+    }
+}
+
+/**
+ * (Private) get the polygon initialisation parameters equivalent to a set of
+ * initialisation parameters
+ * @param params initialisation parameters
+ * @param polygons array of IKREGIONSELECTOR_MAXREG polygons, to point at the
+ * regions of params if it has no polygons of its own
+ * @param polygonParams equivalent polygon initialisation parameters
+ * @return error code:
+ *  0: no error
+ * -1: invalid number of regions, polygonParams is left with none
+ */
+int ikRegionSelector_getPolygonParams(const ikRegionSelectorParams *params, ikRegionSelectorPolygon polygons[], ikRegionSelectorPolygonParams *polygonParams) {
+    int i;
+    
+    polygonParams->nRegions = params->nRegions;
+    polygonParams->polygons = params->polygons;
+    polygonParams->index = params->index;
+    polygonParams->buffer = params->buffer;
+    polygonParams->bufferSize = params->bufferSize;
+    if ((0 > params->nRegions) || (NULL == params->polygons && IKREGIONSELECTOR_MAXREG < params->nRegions)) {
+        polygonParams->nRegions = 0;
+        return -1;
+    }
+    
+    /* point at the regions held in place, taking those with too many points as invalid */
+    if (NULL == params->polygons) {
+        for (i = 0; i < params->nRegions; i++) {
+            polygons[i].nPoints = IKREGIONSELECTOR_MAXPOINTS < params->regions[i].nPoints ? -1 : params->regions[i].nPoints;
+            polygons[i].points = params->regions[i].points;
+        }
+        polygonParams->polygons = polygons;
+    }
+    
+    return 0;
+}
+
 int ikRegionSelector_init(ikRegionSelector *self, const ikRegionSelectorParams *params) {
+    ikRegionSelectorPolygon polygons[IKREGIONSELECTOR_MAXREG];
+    ikRegionSelectorPolygonParams polygonParams;
+    int err;
+    int err_;
+    
+    /* initialise with the equivalent polygons */
+    err = ikRegionSelector_getPolygonParams(params, polygons, &polygonParams);
+    err_ = ikRegionSelector_initPolygons(self, &polygonParams);
+    
+    return err ? err : err_;
+}
+
+int ikRegionSelector_initPolygons(ikRegionSelector *self, const ikRegionSelectorPolygonParams *params) {
+    const ikRegionSelectorPoint *points;
+    double *d;
+    int *k;
     int i;
     
     /* declare error code */
     int err = 0;
     
     /* register parameter values */
-    self->regionN = params->nRegions;
-    if ((0 > self->regionN) || (IKREGIONSELECTOR_MAXREG < self->regionN)) {
-        self->regionN = 0;
+    self->tables.regionN = params->nRegions;
+    if ((0 > self->tables.regionN) || (0 < self->tables.regionN && NULL == params->polygons)) {
+        self->tables.regionN = 0;
         err = -1;
     }
-    for (i = 0; i < self->regionN; i++) {
-        self->regions[i] = params->regions[i];
-        if ((0 > self->regions[i].nPoints) ||(IKREGIONSELECTOR_MAXPOINTS < self->regions[i].nPoints)) {
-            self->regions[i].nPoints = 0;
-            if (!err) err = 2;
-        }
+    for (i = 0; i < self->tables.regionN; i++) {
+        if (0 > ikRegionSelector_getPoints(params, i, &points) && !err) err = 2;
+    }
+    self->tables.indexed = params->index;
+    if ((0 != self->tables.indexed) && (1 != self->tables.indexed)) {
+        self->tables.indexed = 0;
+        if (!err) err = -2;
     }
     
+    /* lay out the tables, and see that they fit in the buffer, or in the instance if there is none */
+    ikRegionSelector_layOut(&(self->tables), params);
+    self->buffer = params->buffer;
+    if ((NULL == self->buffer && (IKREGIONSELECTOR_NDOUBLES < self->tables.nDoubles || IKREGIONSELECTOR_NINTS < self->tables.nInts))
+            || (NULL != self->buffer && ikRegionSelector_getSize(&(self->tables)) > params->bufferSize)) {
+        self->tables.regionN = 0;
+        self->tables.indexed = 0;
+        ikRegionSelector_layOut(&(self->tables), params);
+        self->buffer = NULL;
+        err = -3;
+    }
+    
+    /* fill them */
+    if (NULL == self->buffer) {
+        d = self->doubles;
+        k = self->ints;
+    } else {
+        d = (double *) self->buffer;
+        k = (int *) (d + self->tables.nDoubles);
+    }
+    ikRegionSelector_fill(&(self->tables), params, d, k);
+    
+    /* no region selected yet */
+    self->lastRegion = 0;
+    
     /* return error code */
     return err;
 }
@@ -64,9 +578,53 @@ void ikRegionSelector_initParams(ikRegionSelectorParams *params) {
             params->regions[i].points[j].y = 0.0;
         }
     }
+    
+    /* regions taken from the array above, no index, and the memory in the instance */
+    params->polygons = NULL;
+    params->index = 0;
+    params->buffer = NULL;
+    params->bufferSize = 0;
 }
 
-int ikRegionSelector_isPointInRegion(const ikRegionSelectorRegion *region, const ikRegionSelectorPoint *point) {
+void ikRegionSelector_initPolygonParams(ikRegionSelectorPolygonParams *params) {
+    /* no regions, no index, and the memory in the instance */
+    params->nRegions = 0;
+    params->polygons = NULL;
+    params->index = 0;
+    params->buffer = NULL;
+    params->bufferSize = 0;
+}
+
+size_t ikRegionSelector_getBufferSize(const ikRegionSelectorParams *params) {
+    ikRegionSelectorPolygon polygons[IKREGIONSELECTOR_MAXREG];
+    ikRegionSelectorPolygonParams polygonParams;
+    
+    /* as for the equivalent polygons */
+    ikRegionSelector_getPolygonParams(params, polygons, &polygonParams);
+    
+    return ikRegionSelector_getPolygonBufferSize(&polygonParams);
+}
+
+size_t ikRegionSelector_getPolygonBufferSize(const ikRegionSelectorPolygonParams *params) {
+    ikRegionSelectorTables tables;
+    
+    /* lay out the tables as init would */
+    tables.regionN = params->nRegions;
+    if ((0 > tables.regionN) || (0 < tables.regionN && NULL == params->polygons)) tables.regionN = 0;
+    tables.indexed = 1 == params->index;
+    ikRegionSelector_layOut(&tables, params);
+    
+    return ikRegionSelector_getSize(&tables);
+}
+
+/**
+ * (Private) get the winding number of a point around a set of edges
+ * @param edges edges
+ * @param x coordinate x
+ * @param y coordinate y
+ * @return winding number
+ */
+int ikRegionSelector_windingNumber(const ikRegionSelectorEdges *edges, double x, double y) {
     /* This code is a modification of Dan Sunday's wn_PnPoly() */
     /* The following is a verbatim copy of the copyright notice on the original code: */
     /* */
@@ -81,46 +639,154 @@ int ikRegionSelector_isPointInRegion(const ikRegionSelectorRegion *region, const
     int wn = 0;
 
     /* loop over all edges of the polygon */
+    int j;
+    int up;
+    int down;
+    double isLeft;
+
+    for (j = 0; j < edges->n; j++) {
+        up = (edges->y0[j] <= y) & (edges->y1[j] > y); /* an upward crossing */
+        down = (edges->y0[j] > y) & (edges->y1[j] <= y); /* a downward crossing */
+        isLeft = edges->dx[j] * (y - edges->y0[j]) - edges->dy[j] * (x - edges->x0[j]);
+        wn += up * (2 * (isLeft > 0) - 1); /* count up if point left of edge, down otherwise */
+        wn += down * (1 - 2 * (isLeft < 0)); /* count down if point right of edge, up otherwise */
+    }
+
+    return wn;
+}
+
+/**
+ * (Private) get the winding number of a point around a region
+ * @param tables tables
+ * @param d double values
+ * @param k int values
+ * @param i region index, starting at 0
+ * @param x coordinate x
+ * @param y coordinate y
+ * @return winding number, 0 if the point is outside the region
+ */
+int ikRegionSelector_isPointInRegion(const ikRegionSelectorTables *tables, const double *d, const int *k, int i, double x, double y) {
+    const double *box = d + tables->box;
+    int n = tables->regionN;
+    ikRegionSelectorEdges edges;
+    
+    /* points outside the bounding box are not in the region */
+    if (x < box[i] || x > box[n + i] || y < box[2*n + i] || y > box[3*n + i]) return 0;
+
+    ikRegionSelector_viewEdges(&edges, d + k[tables->regionEdges + 2*i], k[tables->regionEdges + 2*i + 1]);
+    return ikRegionSelector_windingNumber(&edges, x, y);
+}
+
+/**
+ * (Private) get region number for coordinates with the slab index
+ * @param tables tables
+ * @param d double values
+ * @param k int values
+ * @param x coordinate x
+ * @param y coordinate y
+ * @return region number, 0 if none
+ */
+int ikRegionSelector_lookUp(const ikRegionSelectorTables *tables, const double *d, const int *k, double x, double y) {
+    const double *slabY = d + tables->slabY;
+    const double *entryXMin = d + tables->entryX;
+    const double *entryXMax = entryXMin + tables->nEntries;
+    const double *entryReach = entryXMax + tables->nEntries;
+    const int *slabEntries = k + tables->slabEntries;
+    const int *entries = k + tables->entries;
+    ikRegionSelectorEdges edges;
+    int s;
+    int e;
+    int e0;
+    int e1;
+    int region = 0;
+
+    /* points outside the slabs are not in any region */
+    if (!tables->nSlabs || !(y >= slabY[0] && y < slabY[tables->nSlabs])) return 0;
+    s = ikRegionSelector_search(slabY, tables->nSlabs + 1, y);
+
+    /* nor are points before the first entry of their slab */
+    e0 = slabEntries[s];
+    e1 = slabEntries[s + 1];
+    if (e0 == e1 || !(x >= entryXMin[e0])) return 0;
+    
+    /* check the entries starting at or before x, back to the last reaching it, */
+    /* and keep the first region containing the point */
+    for (e = e0 + ikRegionSelector_search(entryXMin + e0, e1 - e0, x); e >= e0 && entryReach[e] >= x; e--) {
+        if (x > entryXMax[e] || (region && region <= entries[3*e])) continue;
+        ikRegionSelector_viewEdges(&edges, d + entries[3*e + 1], entries[3*e + 2]);
+        if (ikRegionSelector_windingNumber(&edges, x, y)) region = entries[3*e] + 1;
+    }
+
+    return region;
+}
+
+/**
+ * (Private) get region number for coordinates
+ * @param self instance
+ * @param lastRegion region number selected last, updated with the one selected
+ * @param x coordinate x
+ * @param y coordinate y
+ * @return region number, 0 if none
+ */
+int ikRegionSelector_select(const ikRegionSelector *self, int *lastRegion, double x, double y) {
+    const ikRegionSelectorTables *tables = &(self->tables);
+    const double *d;
+    const int *k;
     int i;
-    int i1;
-    for (i = 0; i < region->nPoints; i++) {
-        i1 = i + 1;
-        if (i1 > region->nPoints - 1) i1 = 0;
-        if (region->points[i].y <= point->y) {
-            if (region->points[i1].y > point->y) /* an upward crossing */
-                if ((region->points[i1].x - region->points[i].x) * (point->y - region->points[i].y)
-                        - (region->points[i1].y - region->points[i].y) * (point->x - region->points[i].x)
-                        > 0) /* point left of edge */
-                    wn++; /* count up */
-                else
-                    wn--; /* count down */
-        } else {
-            if (region->points[i1].y <= point->y) /* a downward crossing */
-                if ((region->points[i1].x - region->points[i].x) * (point->y - region->points[i].y)
-                        - (region->points[i1].y - region->points[i].y) * (point->x - region->points[i].x)
-                        < 0) /* point right of edge */
-                    wn--; /* count down */
-                else
-                    wn++; /* count up */
+    int j;
+    int last = *lastRegion - 1;
+    
+    ikRegionSelector_getTables(self, &d, &k);
+
+    /* check the region selected last, if any, first */
+    if (0 <= last && ikRegionSelector_isPointInRegion(tables, d, k, last, x, y)) {
+        /* only earlier regions overlapping it could take precedence */
+        for (j = k[tables->overlapStart + last]; j < k[tables->overlapStart + last + 1]; j++) {
+            i = k[tables->overlaps + j];
+            if (ikRegionSelector_isPointInRegion(tables, d, k, i, x, y)) {
+                *lastRegion = i + 1;
+                return *lastRegion;
+            }
         }
+        return *lastRegion;
     }
 
-    return wn;
+    /* otherwise, look the point up with the slab index */
+    if (tables->indexed) {
+        *lastRegion = ikRegionSelector_lookUp(tables, d, k, x, y);
+        return *lastRegion;
+    }
+
+    /* or check every other region, in order */
+    *lastRegion = 0;
+    for (i = 0; i < tables->regionN; i++) {
+        if (i == last) continue;
+        if (ikRegionSelector_isPointInRegion(tables, d, k, i, x, y)) {
+            *lastRegion = i + 1;
+            return *lastRegion;
+        }
+    }
+
+    /* if the point is not in any of the regions, return 0 */
+    return *lastRegion;
 }
 
 int ikRegionSelector_getRegion(ikRegionSelector *self, double x, double y) {
-    /* check every region */
+    return ikRegionSelector_select(self, &(self->lastRegion), x, y);
+}
+
+void ikRegionSelector_getRegions(const ikRegionSelector *self, int n, const double x[], const double y[], int regions[]) {
     int i;
-    ikRegionSelectorPoint point;
-    point.x = x;
-    point.y = y;
-    for (i = 0; i < self->regionN; i++) {
-        if (ikRegionSelector_isPointInRegion(&(self->regions[i]), &point))
-            return i + 1;
+    int lastRegion = self->lastRegion;
+
+    for (i = 0; i < n; i++) {
+        regions[i] = ikRegionSelector_select(self, &lastRegion, x[i], y[i]);
     }
+}
 
-    /* if the point is not in any of the regions, return 0 */
-    return 0;
+void ikRegionSelector_checkpoint(ikRegionSelector *self, ikCheckpoint *cp) {
+    ikCheckpoint_check(cp, self->tables.regionN);
+    ikCheckpoint_intRange(cp, &(self->lastRegion), 0, self->tables.regionN);
 }
 
 /* @endcond */
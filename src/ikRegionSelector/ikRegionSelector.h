@@ -29,9 +29,23 @@ along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
 #ifdef __cplusplus
 extern "C" {
 #endif
+
+#include <stddef.h>
+#include "ikCheckpoint.h"
     
 #define IKREGIONSELECTOR_MAXREG 8
 #define IKREGIONSELECTOR_MAXPOINTS 16
+
+    /**
+     * Number of points of the regions whose tables always fit in the
+     * instance, for up to @link IKREGIONSELECTOR_MAXREG @endlink regions
+     * without the slab index. Larger sets of regions need a buffer. The
+     * default fits quadrilaterals. Define it at compile time to hold larger
+     * regions in the instance.
+     */
+#ifndef IKREGIONSELECTOR_INLINEPOINTS
+#define IKREGIONSELECTOR_INLINEPOINTS 4
+#endif
     
     /**
      * @struct ikRegionSelectorPoint
@@ -50,6 +64,52 @@ extern "C" {
         int                     nPoints;    /**<number of points defining the polygonal region*/
         ikRegionSelectorPoint   points  [IKREGIONSELECTOR_MAXPOINTS];   /**<points defining the polygonal region*/
     } ikRegionSelectorRegion;
+    
+    /**
+     * @struct ikRegionSelectorPolygon
+     * @brief region initialisation parameters, with any number of points
+     */
+    typedef struct ikRegionSelectorPolygon {
+        int                             nPoints;    /**<number of points defining the polygonal region*/
+        const ikRegionSelectorPoint    *points;     /**<array of nPoints points defining the polygonal region*/
+    } ikRegionSelectorPolygon;
+
+    /* @cond */
+    /* capacity of the tables held in the instance, enough for IKREGIONSELECTOR_MAXREG */
+    /* regions of IKREGIONSELECTOR_INLINEPOINTS points each without the slab index */
+#define IKREGIONSELECTOR_NDOUBLES (IKREGIONSELECTOR_MAXREG * (4 + 5 * ((IKREGIONSELECTOR_INLINEPOINTS + 3) / 4 * 4)))
+#define IKREGIONSELECTOR_NINTS (IKREGIONSELECTOR_MAXREG * (IKREGIONSELECTOR_MAXREG + 5) / 2 + 1)
+
+    typedef struct ikRegionSelectorEdges {
+        int n; /*number of edges, padded with edges which never cross any point */
+        const double *x0; /*x coordinates of the first points */
+        const double *y0; /*y coordinates of the first points */
+        const double *y1; /*y coordinates of the second points */
+        const double *dx; /*x coordinates of the second points minus those of the first */
+        const double *dy; /*y coordinates of the second points minus those of the first */
+    } ikRegionSelectorEdges;
+    
+    typedef struct ikRegionSelectorTables {
+        int regionN; /*number of regions */
+        int indexed; /*flag: build the slab index */
+        int nSlabs; /*number of horizontal slabs */
+        int nEntries; /*number of regions with edges spanning a slab, over all slabs */
+        int nDoubles; /*number of double values, which come first */
+        int nInts; /*number of int values, which come after the double values */
+        /* offsets of the tables of double values */
+        int box; /*bounding box of each region: xMin, xMax, yMin and yMax, regionN values each */
+        int slabY; /*y boundaries of the slabs, nSlabs + 1 values */
+        int entryX; /*lower and upper x limits of the edges of each entry, and the largest upper limit */
+                    /*of the entries of its slab up to it, nEntries values each */
+        /* offsets of the tables of int values */
+        int regionEdges; /*offset of the edges of each region in the double values, and their number */
+        int overlapStart; /*start of the earlier overlapping regions of each region in overlaps, regionN + 1 values */
+        int overlaps; /*indices of the earlier regions whose bounding boxes overlap each region's */
+        int slabEntries; /*start of the entries of each slab, nSlabs + 1 values, the entries */
+                         /*of each slab are sorted by the lower x limit of their edges */
+        int entries; /*region of each entry, offset of its edges spanning the slab in the double values, and their number */
+    } ikRegionSelectorTables;
+    /* @endcond */
 
     /**
      * @struct ikRegionSelector
@@ -59,6 +119,39 @@ extern "C" {
      * and select the one which corresponds to the coordinates passed via
      * @link ikRegionSelector_getRegion @endlink.
      * 
+     * The edges of the regions and their bounding boxes are computed at
+     * initialisation. The edges are stored as a structure of arrays, and
+     * the winding number is accumulated over them without branches, so that
+     * the compiler can test several edges per SIMD instruction when
+     * vectorisation is enabled, e.g. with SSE4.2 or AVX2. The region selected last is checked first, and
+     * regions whose bounding boxes do not contain the coordinates are
+     * discarded without checking their edges.
+     * 
+     * For large region sets, a slab index can be enabled via
+     * @link ikRegionSelectorParams.index @endlink. The plane is cut into
+     * horizontal slabs at the y coordinates of all points, so that no edge
+     * starts or ends inside a slab, and the regions with edges spanning
+     * each slab are sorted by the lower x limit of those edges. When the
+     * region selected last does not contain the coordinates, their slab
+     * and the last region in it starting at or before x are found by binary
+     * search, and only the regions up to it whose edges reach x are checked,
+     * against only their edges spanning the slab. None of this changes the
+     * region selected.
+     * 
+     * Instances do not allocate memory. The edges, bounding boxes and index
+     * are held in the instance itself when they fit, as they always do for
+     * up to @link IKREGIONSELECTOR_MAXREG @endlink regions of up to
+     * @link IKREGIONSELECTOR_INLINEPOINTS @endlink points without the index,
+     * or in a buffer passed via @link ikRegionSelectorParams.buffer @endlink,
+     * sized with @link ikRegionSelector_getBufferSize @endlink.
+     * 
+     * The regions may be given in @link ikRegionSelectorParams @endlink, of
+     * up to @link IKREGIONSELECTOR_MAXREG @endlink regions of up to
+     * @link IKREGIONSELECTOR_MAXPOINTS @endlink points held in place, or of
+     * polygons held by the caller, or in @link ikRegionSelectorPolygonParams @endlink,
+     * which only refers to polygons held by the caller, for structures which
+     * embed the initialisation parameters.
+     * 
      * @par Inputs
      * @li x, specify via @link ikRegionSelector_getRegion @endlink
      * @li y, specify via @link ikRegionSelector_getRegion @endlink
@@ -68,13 +161,22 @@ extern "C" {
      * 
      * @par Methods
      * @li @link ikRegionSelector_init @endlink initialise instance
+     * @li @link ikRegionSelector_initPolygons @endlink initialise instance, with polygons held by the caller
      * @li @link ikRegionSelector_initParams @endlink initialise initialisation parameter structure
+     * @li @link ikRegionSelector_initPolygonParams @endlink initialise polygon initialisation parameter structure
+     * @li @link ikRegionSelector_getBufferSize @endlink get size of buffer needed for a set of regions
+     * @li @link ikRegionSelector_getPolygonBufferSize @endlink get size of buffer needed for a set of polygons
      * @li @link ikRegionSelector_getRegion @endlink get region number corresponding a pair of corrdinates
+     * @li @link ikRegionSelector_getRegions @endlink get region numbers corresponding to a series of pairs of coordinates
+     * @li @link ikRegionSelector_checkpoint @endlink save or restore runtime state
      */
     typedef struct ikRegionSelector {
         /* @cond */
-        int                     regionN;
-        ikRegionSelectorRegion  regions     [IKREGIONSELECTOR_MAXREG];
+        ikRegionSelectorTables  tables;
+        int                     lastRegion;
+        void                   *buffer; /*memory holding the tables, NULL if they are held in the instance */
+        double                  doubles [IKREGIONSELECTOR_NDOUBLES];
+        int                     ints    [IKREGIONSELECTOR_NINTS];
         /* @endcond */
     } ikRegionSelector;
     
@@ -85,25 +187,90 @@ extern "C" {
     typedef struct ikRegionSelectorParams {
         int                     nRegions;   /**<number of regions.*/
         ikRegionSelectorRegion  regions     [IKREGIONSELECTOR_MAXREG]; /**<polygonal region specification*/
+        const ikRegionSelectorPolygon *polygons; /**<array of nRegions polygonal region specifications,
+                                             used instead of regions if not NULL. Any number of regions
+                                             and points is allowed, and the arrays need not be kept after
+                                             initialisation. The default is NULL.*/
+        int                     index;      /**<flag: 1 to build a slab index, 0 otherwise. The default is 0.*/
+        void                   *buffer;     /**<memory for the edges, bounding boxes and index, of at least
+                                             the size returned by @link ikRegionSelector_getBufferSize @endlink,
+                                             and aligned for double values, e.g. as returned by malloc.
+                                             It is written at initialisation and only read afterwards, and
+                                             must be kept as long as the instance is used. NULL to use the
+                                             memory in the instance. The default is NULL.*/
+        size_t                  bufferSize; /**<size of buffer, in bytes. The default is 0.*/
     }ikRegionSelectorParams;
     
+    /**
+     * @struct ikRegionSelectorPolygonParams
+     * @brief region selector initialisation parameters, with polygons held by the caller
+     */
+    typedef struct ikRegionSelectorPolygonParams {
+        int                             nRegions;   /**<number of regions. The default is 0.*/
+        const ikRegionSelectorPolygon  *polygons;   /**<array of nRegions polygonal region specifications, which
+                                                     need not be kept after initialisation. The default is NULL.*/
+        int                             index;      /**<flag: 1 to build a slab index, 0 otherwise. The default is 0.*/
+        void                           *buffer;     /**<memory for the edges, bounding boxes and index, as
+                                                     @link ikRegionSelectorParams.buffer @endlink. The default is NULL.*/
+        size_t                          bufferSize; /**<size of buffer, in bytes. The default is 0.*/
+    } ikRegionSelectorPolygonParams;
+    
     /**
      * Initialise instance
      * @param self instance
      * @param params initialisation parameters
      * @return error code:
      * @li 0: no error
-     * @li -1: invalid number of regions, it must be between 0 and @link IKREGIONSELECTOR_MAXREG @endlink
-     * @li x: invalid number of points in region x (starting at 1), it must be between 0 and @link IKREGIONSELECTOR_MAXPOINTS @endlink
+     * @li -1: invalid number of regions, it must be non-negative, and not larger than @link IKREGIONSELECTOR_MAXREG @endlink
+     * unless @link ikRegionSelectorParams.polygons @endlink is used
+     * @li -2: invalid index flag, it must be 0 or 1
+     * @li -3: the buffer is too small, or there is no buffer and the memory in the instance is too small,
+     * see @link ikRegionSelector_getBufferSize @endlink. The instance is left with no regions
+     * @li x: invalid number of points in region x (starting at 1), it must be between 0 and @link IKREGIONSELECTOR_MAXPOINTS @endlink,
+     * or non-negative and with a non-NULL array of points if @link ikRegionSelectorParams.polygons @endlink is used
      */
     int ikRegionSelector_init(ikRegionSelector *self, const ikRegionSelectorParams *params);
     
+    /**
+     * Initialise instance, with polygons held by the caller
+     * @param self instance
+     * @param params initialisation parameters
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid number of regions, it must be non-negative, and the polygons must not be NULL if it is positive
+     * @li -2: invalid index flag, it must be 0 or 1
+     * @li -3: the buffer is too small, or there is no buffer and the memory in the instance is too small,
+     * see @link ikRegionSelector_getPolygonBufferSize @endlink. The instance is left with no regions
+     * @li x: invalid number of points in region x (starting at 1), it must be non-negative, with a non-NULL array of points
+     */
+    int ikRegionSelector_initPolygons(ikRegionSelector *self, const ikRegionSelectorPolygonParams *params);
+    
     /**
      * Initialise initialisation parameter structure
      * @param params initialisation parameter structure
      */
     void ikRegionSelector_initParams(ikRegionSelectorParams *params);
     
+    /**
+     * Initialise polygon initialisation parameter structure
+     * @param params initialisation parameter structure
+     */
+    void ikRegionSelector_initPolygonParams(ikRegionSelectorPolygonParams *params);
+    
+    /**
+     * Get size of buffer needed for a set of regions
+     * @param params initialisation parameters
+     * @return size of the buffer to pass via @link ikRegionSelectorParams.buffer @endlink, in bytes
+     */
+    size_t ikRegionSelector_getBufferSize(const ikRegionSelectorParams *params);
+    
+    /**
+     * Get size of buffer needed for a set of polygons
+     * @param params initialisation parameters
+     * @return size of the buffer to pass via @link ikRegionSelectorPolygonParams.buffer @endlink, in bytes
+     */
+    size_t ikRegionSelector_getPolygonBufferSize(const ikRegionSelectorPolygonParams *params);
+    
     /**
      * Get region number for coordinates
      * @param self region selector instance
@@ -115,6 +282,27 @@ extern "C" {
      * returns 0.
      */
     int ikRegionSelector_getRegion(ikRegionSelector *self, double x, double y);
+    
+    /**
+     * Get region numbers for a series of coordinates, as
+     * @link ikRegionSelector_getRegion @endlink would if called for each
+     * pair of coordinates in turn. Meant for offline analysis of logged
+     * data, it does not change the region selected last by the instance.
+     * @param self region selector instance
+     * @param n number of pairs of coordinates
+     * @param x array of n x coordinates
+     * @param y array of n y coordinates
+     * @param regions array for the n region numbers
+     */
+    void ikRegionSelector_getRegions(const ikRegionSelector *self, int n, const double x[], const double y[], int regions[]);
+    
+    /**
+     * Save or restore runtime state, i.e. the region selected last
+     * @param self region selector instance
+     * @param cp checkpoint blob writer or reader
+     */
+    void ikRegionSelector_checkpoint(ikRegionSelector *self, ikCheckpoint *cp);
+    
 
 
 #ifdef __cplusplus
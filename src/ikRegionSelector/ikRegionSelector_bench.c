@@ -0,0 +1,154 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikRegionSelector_bench.c
+ * 
+ * @brief Class ikRegionSelector scaling benchmark
+ * 
+ * Partitions a square in n x n quadrilaterals with jittered corners, for n
+ * = 2, 4, 8, ... up to a maximum, and reports the time per region lookup
+ * with and without the slab index, for random points and for a random walk.
+ * The regions selected with the index are checked to be the same as those
+ * selected without it.
+ * 
+ * Usage: ikRegionSelector_bench [maximum n [points]]
+ * 
+ * The defaults are a maximum n of 32, i.e. 1024 regions, and 100000 points.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "ikRegionSelector.h"
+#include "ikTestUtil.h"
+
+/*
+ * Time the lookup of a series of points, in ns per point.
+ */
+double timeLookup(ikRegionSelector *rs, int nPoints, const double x[], const double y[], int regions[]) {
+    struct timespec start, end;
+    int i;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < nPoints; i++) regions[i] = ikRegionSelector_getRegion(rs, x[i], y[i]);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return (1e9 * (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec)) / nPoints;
+}
+
+int main(int argc, char** argv) {
+    int maxN = argc > 1 ? atoi(argv[1]) : 32;
+    int nPoints = argc > 2 ? atoi(argv[2]) : 100000;
+    double *x = (double *) malloc(sizeof(double) * nPoints);
+    double *y = (double *) malloc(sizeof(double) * nPoints);
+    int *regions = (int *) malloc(sizeof(int) * nPoints);
+    int *regionsIndex = (int *) malloc(sizeof(int) * nPoints);
+    int n, i, j, k, walk, err;
+
+    if (NULL == x || NULL == y || NULL == regions || NULL == regionsIndex) return (EXIT_FAILURE);
+
+    printf("points=%d\n", nPoints);
+    printf("%8s %6s %14s %14s %8s %6s\n", "regions", "walk", "ns/lookup", "ns/lookup idx", "speedup", "equal");
+    for (n = 2; n <= maxN; n *= 2) {
+        ikRegionSelector rs;
+        ikRegionSelector rsIndex;
+        ikRegionSelectorParams params;
+        ikRegionSelectorPolygon *polygons = (ikRegionSelectorPolygon *) malloc(sizeof(ikRegionSelectorPolygon) * n * n);
+        ikRegionSelectorPoint *corners = (ikRegionSelectorPoint *) malloc(sizeof(ikRegionSelectorPoint) * (n + 1) * (n + 1));
+        ikRegionSelectorPoint *points = (ikRegionSelectorPoint *) malloc(sizeof(ikRegionSelectorPoint) * 4 * n * n);
+        void *buffer;
+        void *bufferIndex;
+        if (NULL == polygons || NULL == corners || NULL == points) return (EXIT_FAILURE);
+
+        /*jitter the inner corners of a regular grid on the unit square */
+        for (i = 0; i <= n; i++) {
+            for (j = 0; j <= n; j++) {
+                corners[i*(n + 1) + j].x = (j + (0 < j && n > j ? ikTestUtil_rand(-0.3, 0.3) : 0.0)) / n;
+                corners[i*(n + 1) + j].y = (i + (0 < i && n > i ? ikTestUtil_rand(-0.3, 0.3) : 0.0)) / n;
+            }
+        }
+        for (i = 0; i < n; i++) {
+            for (j = 0; j < n; j++) {
+                k = i*n + j;
+                points[4*k] = corners[i*(n + 1) + j];
+                points[4*k + 1] = corners[i*(n + 1) + j + 1];
+                points[4*k + 2] = corners[(i + 1)*(n + 1) + j + 1];
+                points[4*k + 3] = corners[(i + 1)*(n + 1) + j];
+                polygons[k].nPoints = 4;
+                polygons[k].points = points + 4*k;
+            }
+        }
+
+        /*set up region selectors */
+        ikRegionSelector_initParams(&params);
+        params.nRegions = n * n;
+        params.polygons = polygons;
+        params.bufferSize = ikRegionSelector_getBufferSize(&params);
+        buffer = malloc(params.bufferSize);
+        params.buffer = buffer;
+        err = ikRegionSelector_init(&rs, &params);
+        params.index = 1;
+        params.bufferSize = ikRegionSelector_getBufferSize(&params);
+        bufferIndex = malloc(params.bufferSize);
+        params.buffer = bufferIndex;
+        if (!err) err = ikRegionSelector_init(&rsIndex, &params);
+        if (err) {
+            printf("init returned %d\n", err);
+            break;
+        }
+
+        for (walk = 0; walk < 2; walk++) {
+            double t, tIndex;
+            int equal = 1;
+
+            /*random points, or a random walk with steps shorter than the regions */
+            for (i = 0; i < nPoints; i++) {
+                if (!walk || !i) {
+                    x[i] = ikTestUtil_rand(0.0, 1.0);
+                    y[i] = ikTestUtil_rand(0.0, 1.0);
+                } else {
+                    x[i] = x[i-1] + ikTestUtil_rand(-0.1, 0.1) / n;
+                    y[i] = y[i-1] + ikTestUtil_rand(-0.1, 0.1) / n;
+                    if (0.0 > x[i] || 1.0 < x[i]) x[i] = 0.5;
+                    if (0.0 > y[i] || 1.0 < y[i]) y[i] = 0.5;
+                }
+            }
+
+            t = timeLookup(&rs, nPoints, x, y, regions);
+            tIndex = timeLookup(&rsIndex, nPoints, x, y, regionsIndex);
+            for (i = 0; i < nPoints; i++) {
+                if (regions[i] != regionsIndex[i]) equal = 0;
+            }
+            printf("%8d %6s %14.1f %14.1f %8.2f %6s\n", n * n, walk ? "yes" : "no", t, tIndex, t / tIndex, equal ? "yes" : "NO");
+        }
+
+        free(buffer);
+        free(bufferIndex);
+        free(polygons);
+        free(corners);
+        free(points);
+    }
+
+    free(x);
+    free(y);
+    free(regions);
+    free(regionsIndex);
+    return (EXIT_SUCCESS);
+}
@@ -25,7 +25,45 @@ along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
 #include "../ikRegionSelector/ikRegionSelector.h"
+#include "../ikTestUtil/ikTestUtil.h"
+
+/*
+ * Reference implementation: winding number of a point around a region,
+ * computed from the points as specified, and selection of the first region
+ * in the initialisation parameters containing the point
+ */
+int referenceWindingNumber(const ikRegionSelectorPoint *points, int nPoints, double x, double y) {
+    int wn = 0;
+    int i;
+    int i1;
+    double isLeft;
+    for (i = 0; i < nPoints; i++) {
+        i1 = i + 1;
+        if (i1 > nPoints - 1) i1 = 0;
+        isLeft = (points[i1].x - points[i].x) * (y - points[i].y)
+                - (points[i1].y - points[i].y) * (x - points[i].x);
+        if (points[i].y <= y) {
+            if (points[i1].y > y) wn += isLeft > 0 ? 1 : -1;
+        } else {
+            if (points[i1].y <= y) wn += isLeft < 0 ? -1 : 1;
+        }
+    }
+    return wn;
+}
+
+int referenceGetRegion(const ikRegionSelectorParams *params, double x, double y) {
+    int i;
+    for (i = 0; i < params->nRegions; i++) {
+        if (NULL == params->polygons) {
+            if (referenceWindingNumber(params->regions[i].points, params->regions[i].nPoints, x, y)) return i + 1;
+        } else {
+            if (referenceWindingNumber(params->polygons[i].points, params->polygons[i].nPoints, x, y)) return i + 1;
+        }
+    }
+    return 0;
+}
 
 /*
  * Simple C Test Suite
@@ -409,6 +447,450 @@ void testDefault() {
     
 }
 
+/**
+ * The region selected last is checked first, without taking precedence
+ * over earlier regions
+ */
+void testLastRegionFirst() {
+    printf("ikRegionSelector_test testLastRegionFirst\n");
+    /* declare error code */
+    int err;
+    /* declare output value */
+    int output;
+    /* declare instance */
+    ikRegionSelector rs;
+    /* declare initialisation parameters */
+    ikRegionSelectorParams params;
+    /* declare points and expected regions */
+    const double x[] = {2.1, 2.2, 1.9, 2.1, 3.6, 3.7, 2.1, 1.1, 0.0};
+    const double y[] = {2.1, 2.2, 1.9, 2.1, 3.6, 3.7, 2.1, 1.1, 0.0};
+    const int expected[] = {2, 2, 1, 2, 3, 3, 2, 1, 0};
+    int i;
+    
+    /* initialise instance, with regions 1 and 2 overlapping, and region 3 apart */
+    ikRegionSelector_initParams(&params);
+    params.nRegions = 3;
+    params.regions[0].nPoints = 4;
+    params.regions[0].points[0].x = 1.0;
+    params.regions[0].points[0].y = 1.0;
+    params.regions[0].points[1].x = 1.0;
+    params.regions[0].points[1].y = 2.0;
+    params.regions[0].points[2].x = 2.0;
+    params.regions[0].points[2].y = 2.0;
+    params.regions[0].points[3].x = 2.0;
+    params.regions[0].points[3].y = 1.0;
+    params.regions[1].nPoints = 4;
+    params.regions[1].points[0].x = 1.5;
+    params.regions[1].points[0].y = 1.5;
+    params.regions[1].points[1].x = 1.5;
+    params.regions[1].points[1].y = 2.5;
+    params.regions[1].points[2].x = 2.5;
+    params.regions[1].points[2].y = 2.5;
+    params.regions[1].points[3].x = 2.5;
+    params.regions[1].points[3].y = 1.5;
+    params.regions[2].nPoints = 3;
+    params.regions[2].points[0].x = 3.0;
+    params.regions[2].points[0].y = 3.0;
+    params.regions[2].points[1].x = 4.0;
+    params.regions[2].points[1].y = 4.0;
+    params.regions[2].points[2].x = 4.0;
+    params.regions[2].points[2].y = 3.0;
+    err = ikRegionSelector_init(&rs, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testLastRegionFirst (ikRegionSelector_test) message=expected init to return 0, but it returned %d\n", err);
+    
+    /* move the point around, see that the earlier region takes precedence where regions overlap */
+    for (i = 0; i < 9; i++) {
+        output = ikRegionSelector_getRegion(&rs, x[i], y[i]);
+        if (expected[i] != output) printf("%%TEST_FAILED%% time=0 testname=testLastRegionFirst (ikRegionSelector_test) message=expected getRegion to return %d for point {%f, %f}, but it returned %d\n", expected[i], x[i], y[i], output);
+    }
+    
+}
+
+/**
+ * The slab index does not change the region selected
+ */
+void testSlabIndex() {
+    printf("ikRegionSelector_test testSlabIndex\n");
+    /* declare error code */
+    int err;
+    /* declare output values */
+    int output;
+    int outputIndex;
+    int expected;
+    /* declare instances */
+    ikRegionSelector rs;
+    ikRegionSelector rsIndex;
+    /* declare initialisation parameters */
+    ikRegionSelectorParams params;
+    void *buffer;
+    int i;
+    int j;
+    int k;
+    int ndiff = 0;
+    double x;
+    double y;
+    double cx;
+    double cy;
+    double r;
+    double a;
+    
+    /* -2 for invalid index flags */
+    ikRegionSelector_initParams(&params);
+    params.index = -1;
+    err = ikRegionSelector_init(&rs, &params);
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=testSlabIndex (ikRegionSelector_test) message=expected init to return -2, but it returned %d\n", err);
+    params.index = 2;
+    err = ikRegionSelector_init(&rs, &params);
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=testSlabIndex (ikRegionSelector_test) message=expected init to return -2, but it returned %d\n", err);
+    
+    /* random star-shaped and self-overlapping regions, some of them overlapping each other */
+    for (k = 0; k < 20; k++) {
+        ikRegionSelector_initParams(&params);
+        params.nRegions = IKREGIONSELECTOR_MAXREG;
+        for (i = 0; i < params.nRegions; i++) {
+            params.regions[i].nPoints = 3 + (int) ikTestUtil_rand(0.0, IKREGIONSELECTOR_MAXPOINTS - 3);
+            cx = ikTestUtil_rand(0.0, 10.0);
+            cy = ikTestUtil_rand(0.0, 10.0);
+            for (j = 0; j < params.regions[i].nPoints; j++) {
+                r = ikTestUtil_rand(0.2, 2.0);
+                a = 6.283185307179586 * (j + (k % 2 ? ikTestUtil_rand(0.0, 3.0) : 0.0)) / params.regions[i].nPoints;
+                params.regions[i].points[j].x = cx + r * cos(a);
+                params.regions[i].points[j].y = cy + r * sin(a);
+            }
+        }
+        params.index = 0;
+        params.bufferSize = ikRegionSelector_getBufferSize(&params);
+        params.buffer = malloc(params.bufferSize);
+        buffer = params.buffer;
+        err = ikRegionSelector_init(&rs, &params);
+        if (err) printf("%%TEST_FAILED%% time=0 testname=testSlabIndex (ikRegionSelector_test) message=expected init to return 0, but it returned %d\n", err);
+        params.index = 1;
+        params.bufferSize = ikRegionSelector_getBufferSize(&params);
+        params.buffer = malloc(params.bufferSize);
+        err = ikRegionSelector_init(&rsIndex, &params);
+        if (err) printf("%%TEST_FAILED%% time=0 testname=testSlabIndex (ikRegionSelector_test) message=expected init to return 0, but it returned %d\n", err);
+        
+        /* random walk, so that the region selected last is often the right one */
+        x = 5.0;
+        y = 5.0;
+        for (j = 0; j < 5000; j++) {
+            x += ikTestUtil_rand(-0.3, 0.3);
+            y += ikTestUtil_rand(-0.3, 0.3);
+            if (0 == j % 500) {
+                x = params.regions[j / 500 % params.nRegions].points[0].x;
+                y = params.regions[j / 500 % params.nRegions].points[1].y;
+            }
+            expected = referenceGetRegion(&params, x, y);
+            output = ikRegionSelector_getRegion(&rs, x, y);
+            outputIndex = ikRegionSelector_getRegion(&rsIndex, x, y);
+            if (expected != output || expected != outputIndex) ndiff++;
+        }
+        free(buffer);
+        free(params.buffer);
+    }
+    if (ndiff) printf("%%TEST_FAILED%% time=0 testname=testSlabIndex (ikRegionSelector_test) message=getRegion returned a different region than the reference for %d points\n", ndiff);
+    
+}
+
+/**
+ * The batch method selects the same regions as the method for a single
+ * pair of coordinates
+ */
+void testGetRegions() {
+    printf("ikRegionSelector_test testGetRegions\n");
+    /* declare error code */
+    int err;
+    /* declare output values */
+    int output;
+    int outputs[1000];
+    /* declare instance */
+    ikRegionSelector rs;
+    /* declare initialisation parameters */
+    ikRegionSelectorParams params;
+    double x[1000];
+    double y[1000];
+    int i;
+    int j;
+    int ndiff = 0;
+    
+    /* initialise instance with three regions, the first two overlapping */
+    ikRegionSelector_initParams(&params);
+    params.nRegions = 3;
+    for (i = 0; i < 3; i++) {
+        params.regions[i].nPoints = 5;
+        for (j = 0; j < 5; j++) {
+            params.regions[i].points[j].x = 1.0 + 0.75 * i + cos(2.513274122871834 * j);
+            params.regions[i].points[j].y = 1.0 + sin(2.513274122871834 * j);
+        }
+    }
+    params.index = 1;
+    params.bufferSize = ikRegionSelector_getBufferSize(&params);
+    params.buffer = malloc(params.bufferSize);
+    err = ikRegionSelector_init(&rs, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testGetRegions (ikRegionSelector_test) message=expected init to return 0, but it returned %d\n", err);
+    
+    /* classify a log of random points */
+    for (i = 0; i < 1000; i++) {
+        x[i] = ikTestUtil_rand(-0.5, 4.0);
+        y[i] = ikTestUtil_rand(-0.5, 2.5);
+    }
+    ikRegionSelector_getRegions(&rs, 1000, x, y, outputs);
+    
+    /* see that the regions are those selected one by one */
+    for (i = 0; i < 1000; i++) {
+        output = ikRegionSelector_getRegion(&rs, x[i], y[i]);
+        if (output != outputs[i] || referenceGetRegion(&params, x[i], y[i]) != outputs[i]) ndiff++;
+    }
+    if (ndiff) printf("%%TEST_FAILED%% time=0 testname=testGetRegions (ikRegionSelector_test) message=getRegions returned a different region than getRegion for %d points\n", ndiff);
+    free(params.buffer);
+    
+}
+
+/**
+ * Hundreds of regions with any number of points can be specified as polygons,
+ * and are selected as the reference does, with and without the slab index
+ */
+void testManyRegions() {
+    printf("ikRegionSelector_test testManyRegions\n");
+    /* declare error code */
+    int err;
+    /* declare output values */
+    int output;
+    int outputIndex;
+    int expected;
+    int outputs[500];
+    /* declare instances */
+    ikRegionSelector rs;
+    ikRegionSelector rsIndex;
+    /* declare initialisation parameters */
+    ikRegionSelectorParams params;
+    ikRegionSelectorPolygon polygons[301];
+    void *buffer;
+    void *bufferIndex;
+    ikRegionSelectorPoint points[300 * 4 + 50];
+    double x[500];
+    double y[500];
+    int i;
+    int j;
+    int k;
+    int ndiff = 0;
+    
+    /* a partition of [0, 20]x[0, 15] in unit squares, some of them with */
+    /* jittered corners, and a self-overlapping star amid them */
+    k = 0;
+    for (i = 0; i < 301; i++) {
+        if (150 == i) {
+            polygons[i].nPoints = 50;
+            polygons[i].points = points + k;
+            for (j = 0; j < 50; j++) {
+                points[k].x = 10.0 + (j % 2 ? 4.0 : 12.0) * cos(6.283185307179586 * 3.0 * j / 50);
+                points[k].y = 7.5 + (j % 2 ? 4.0 : 10.0) * sin(6.283185307179586 * 3.0 * j / 50);
+                k++;
+            }
+            continue;
+        }
+        j = 150 > i ? i : i - 1;
+        polygons[i].nPoints = 4;
+        polygons[i].points = points + k;
+        points[k].x = j % 20; points[k].y = j / 20; k++;
+        points[k].x = j % 20 + 1; points[k].y = j / 20; k++;
+        points[k].x = j % 20 + 1; points[k].y = j / 20 + 1; k++;
+        points[k].x = j % 20; points[k].y = j / 20 + 1; k++;
+        if (j % 3) {
+            points[k - 4].x += ikTestUtil_rand(-0.1, 0.1);
+            points[k - 2].y += ikTestUtil_rand(-0.1, 0.1);
+        }
+    }
+    ikRegionSelector_initParams(&params);
+    params.nRegions = 301;
+    params.polygons = polygons;
+    params.bufferSize = ikRegionSelector_getBufferSize(&params);
+    buffer = malloc(params.bufferSize);
+    params.buffer = buffer;
+    err = ikRegionSelector_init(&rs, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testManyRegions (ikRegionSelector_test) message=expected init to return 0, but it returned %d\n", err);
+    params.index = 1;
+    params.bufferSize = ikRegionSelector_getBufferSize(&params);
+    bufferIndex = malloc(params.bufferSize);
+    params.buffer = bufferIndex;
+    err = ikRegionSelector_init(&rsIndex, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testManyRegions (ikRegionSelector_test) message=expected init to return 0, but it returned %d\n", err);
+    
+    /* random points, and points on the edges and corners of the squares */
+    for (i = 0; i < 20000; i++) {
+        x[0] = i % 2 ? ikTestUtil_rand(-3.0, 23.0) : (int) ikTestUtil_rand(-1.0, 22.0) * 0.5;
+        y[0] = i % 2 ? ikTestUtil_rand(-3.0, 18.0) : (int) ikTestUtil_rand(-1.0, 32.0) * 0.5;
+        expected = referenceGetRegion(&params, x[0], y[0]);
+        output = ikRegionSelector_getRegion(&rs, x[0], y[0]);
+        outputIndex = ikRegionSelector_getRegion(&rsIndex, x[0], y[0]);
+        if (expected != output || expected != outputIndex) ndiff++;
+    }
+    
+    /* the batch method selects the same regions with the index */
+    for (i = 0; i < 500; i++) {
+        x[i] = ikTestUtil_rand(-1.0, 21.0);
+        y[i] = ikTestUtil_rand(-1.0, 16.0);
+    }
+    ikRegionSelector_getRegions(&rsIndex, 500, x, y, outputs);
+    for (i = 0; i < 500; i++) {
+        if (referenceGetRegion(&params, x[i], y[i]) != outputs[i]) ndiff++;
+    }
+    if (ndiff) printf("%%TEST_FAILED%% time=0 testname=testManyRegions (ikRegionSelector_test) message=getRegion returned a different region than the reference for %d points\n", ndiff);
+    
+    /* x for a polygon without an array of points */
+    polygons[2].points = NULL;
+    err = ikRegionSelector_init(&rs, &params);
+    if (2 != err) printf("%%TEST_FAILED%% time=0 testname=testManyRegions (ikRegionSelector_test) message=expected init to return 2, but it returned %d\n", err);
+    
+    /* -1 for more than the maximum number of regions without polygons */
+    params.polygons = NULL;
+    err = ikRegionSelector_init(&rs, &params);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testManyRegions (ikRegionSelector_test) message=expected init to return -1, but it returned %d\n", err);
+    free(buffer);
+    free(bufferIndex);
+    
+}
+
+/**
+ * The tables are held in the instance when they fit, and in a buffer of the
+ * size returned by ikRegionSelector_getBufferSize otherwise, and copies of
+ * an instance select the same regions as the instance. Polygon
+ * initialisation parameters select the same regions as the others
+ */
+void testBuffer() {
+    printf("ikRegionSelector_test testBuffer\n");
+    /* declare error code */
+    int err;
+    /* declare output value */
+    int output;
+    /* declare instances */
+    ikRegionSelector rs;
+    ikRegionSelector rsCopy;
+    /* declare initialisation parameters */
+    ikRegionSelectorParams params;
+    ikRegionSelectorParams paramsCopy;
+    ikRegionSelectorPolygonParams polygonParams;
+    ikRegionSelectorPolygon polygons[64];
+    ikRegionSelectorPoint points[64][4];
+    double buffer[4096];
+    double x;
+    double y;
+    int i;
+    int j;
+    int ndiff = 0;
+    
+    /* the most regions of the most points need a buffer */
+    ikRegionSelector_initParams(&params);
+    params.nRegions = IKREGIONSELECTOR_MAXREG;
+    for (i = 0; i < params.nRegions; i++) {
+        params.regions[i].nPoints = IKREGIONSELECTOR_MAXPOINTS;
+        for (j = 0; j < IKREGIONSELECTOR_MAXPOINTS; j++) {
+            params.regions[i].points[j].x = 1.0 * i + cos(6.283185307179586 * j / IKREGIONSELECTOR_MAXPOINTS);
+            params.regions[i].points[j].y = sin(6.283185307179586 * j / IKREGIONSELECTOR_MAXPOINTS);
+        }
+    }
+    err = ikRegionSelector_init(&rs, &params);
+    if (-3 != err) printf("%%TEST_FAILED%% time=0 testname=testBuffer (ikRegionSelector_test) message=expected init to return -3 without a buffer, but it returned %d\n", err);
+    params.buffer = buffer;
+    params.bufferSize = sizeof(buffer);
+    err = ikRegionSelector_init(&rs, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testBuffer (ikRegionSelector_test) message=expected init to return 0, but it returned %d\n", err);
+    for (i = 0; i < 1000; i++) {
+        x = ikTestUtil_rand(-1.5, 8.5);
+        y = ikTestUtil_rand(-1.5, 1.5);
+        if (referenceGetRegion(&params, x, y) != ikRegionSelector_getRegion(&rs, x, y)) ndiff++;
+    }
+    
+    /* but the most regions of the points held in the instance fit in it */
+    ikRegionSelector_initParams(&params);
+    params.nRegions = IKREGIONSELECTOR_MAXREG;
+    for (i = 0; i < params.nRegions; i++) {
+        params.regions[i].nPoints = IKREGIONSELECTOR_INLINEPOINTS;
+        for (j = 0; j < IKREGIONSELECTOR_INLINEPOINTS; j++) {
+            params.regions[i].points[j].x = 1.0 * i + cos(6.283185307179586 * j / IKREGIONSELECTOR_INLINEPOINTS);
+            params.regions[i].points[j].y = sin(6.283185307179586 * j / IKREGIONSELECTOR_INLINEPOINTS);
+        }
+    }
+    err = ikRegionSelector_init(&rs, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testBuffer (ikRegionSelector_test) message=expected init to return 0, but it returned %d\n", err);
+    
+    /* a copy keeps selecting its regions after the instance is initialised again */
+    rsCopy = rs;
+    paramsCopy = params;
+    for (i = 0; i < params.nRegions; i++) {
+        for (j = 0; j < IKREGIONSELECTOR_INLINEPOINTS; j++) params.regions[i].points[j].y += 0.5;
+    }
+    err = ikRegionSelector_init(&rs, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testBuffer (ikRegionSelector_test) message=expected init to return 0, but it returned %d\n", err);
+    for (i = 0; i < 1000; i++) {
+        x = ikTestUtil_rand(-1.5, 8.5);
+        y = ikTestUtil_rand(-1.5, 2.0);
+        if (referenceGetRegion(&params, x, y) != ikRegionSelector_getRegion(&rs, x, y)) ndiff++;
+        if (referenceGetRegion(&paramsCopy, x, y) != ikRegionSelector_getRegion(&rsCopy, x, y)) ndiff++;
+    }
+    if (ndiff) printf("%%TEST_FAILED%% time=0 testname=testBuffer (ikRegionSelector_test) message=getRegion returned a different region than the reference for %d points\n", ndiff);
+    
+    /* more regions need a buffer, -3 and no regions without it */
+    for (i = 0; i < 64; i++) {
+        points[i][0].x = i;
+        points[i][0].y = 0.0;
+        points[i][1].x = i + 1.0;
+        points[i][1].y = 0.0;
+        points[i][2].x = i + 1.0;
+        points[i][2].y = 1.0;
+        points[i][3].x = i;
+        points[i][3].y = 1.0;
+        polygons[i].nPoints = 4;
+        polygons[i].points = points[i];
+    }
+    ikRegionSelector_initParams(&params);
+    params.nRegions = 64;
+    params.polygons = polygons;
+    for (params.index = 0; params.index < 2; params.index++) {
+        params.buffer = NULL;
+        params.bufferSize = 0;
+        err = ikRegionSelector_init(&rs, &params);
+        if (-3 != err) printf("%%TEST_FAILED%% time=0 testname=testBuffer (ikRegionSelector_test) message=expected init to return -3 without a buffer, but it returned %d\n", err);
+        output = ikRegionSelector_getRegion(&rs, 0.5, 0.5);
+        if (output) printf("%%TEST_FAILED%% time=0 testname=testBuffer (ikRegionSelector_test) message=expected getRegion to return 0 after init failed, but it returned %d\n", output);
+        
+        /* and with a buffer too small */
+        params.buffer = buffer;
+        params.bufferSize = ikRegionSelector_getBufferSize(&params) - 1;
+        if (sizeof(buffer) < params.bufferSize) printf("%%TEST_FAILED%% time=0 testname=testBuffer (ikRegionSelector_test) message=expected getBufferSize to return at most %d, but it returned %d\n", (int) sizeof(buffer), (int) params.bufferSize + 1);
+        err = ikRegionSelector_init(&rs, &params);
+        if (-3 != err) printf("%%TEST_FAILED%% time=0 testname=testBuffer (ikRegionSelector_test) message=expected init to return -3 with a buffer too small, but it returned %d\n", err);
+        
+        /* but not with a buffer of the size given */
+        params.bufferSize++;
+        err = ikRegionSelector_init(&rs, &params);
+        if (err) printf("%%TEST_FAILED%% time=0 testname=testBuffer (ikRegionSelector_test) message=expected init to return 0, but it returned %d\n", err);
+        for (i = 0; i < 64; i++) {
+            output = ikRegionSelector_getRegion(&rs, i + 0.5, 0.5);
+            if (i + 1 != output) printf("%%TEST_FAILED%% time=0 testname=testBuffer (ikRegionSelector_test) message=expected getRegion to return %d, but it returned %d\n", i + 1, output);
+        }
+    }
+    
+    /* the same with polygon initialisation parameters */
+    ikRegionSelector_initPolygonParams(&polygonParams);
+    polygonParams.nRegions = 64;
+    err = ikRegionSelector_initPolygons(&rs, &polygonParams);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testBuffer (ikRegionSelector_test) message=expected initPolygons to return -1 without polygons, but it returned %d\n", err);
+    polygonParams.polygons = polygons;
+    err = ikRegionSelector_initPolygons(&rs, &polygonParams);
+    if (-3 != err) printf("%%TEST_FAILED%% time=0 testname=testBuffer (ikRegionSelector_test) message=expected initPolygons to return -3 without a buffer, but it returned %d\n", err);
+    polygonParams.buffer = buffer;
+    polygonParams.bufferSize = ikRegionSelector_getPolygonBufferSize(&polygonParams);
+    if (ikRegionSelector_getBufferSize(&params) != polygonParams.bufferSize) printf("%%TEST_FAILED%% time=0 testname=testBuffer (ikRegionSelector_test) message=expected getPolygonBufferSize to return %d, but it returned %d\n", (int) ikRegionSelector_getBufferSize(&params), (int) polygonParams.bufferSize);
+    err = ikRegionSelector_initPolygons(&rs, &polygonParams);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testBuffer (ikRegionSelector_test) message=expected initPolygons to return 0, but it returned %d\n", err);
+    for (i = 0; i < 64; i++) {
+        output = ikRegionSelector_getRegion(&rs, i + 0.5, 0.5);
+        if (i + 1 != output) printf("%%TEST_FAILED%% time=0 testname=testBuffer (ikRegionSelector_test) message=expected getRegion to return %d, but it returned %d\n", i + 1, output);
+    }
+    
+}
+
 int main(int argc, char** argv) {
     printf("%%SUITE_STARTING%% ikRegionSelector_test\n");
     printf("%%SUITE_STARTED%%\n");
@@ -444,6 +926,26 @@ int main(int argc, char** argv) {
     printf("%%TEST_STARTED%% testDefault (ikRegionSelector_test)\n");
     testDefault();
     printf("%%TEST_FINISHED%% time=0 testDefault (ikRegionSelector_test) \n");
+
+    printf("%%TEST_STARTED%% testLastRegionFirst (ikRegionSelector_test)\n");
+    testLastRegionFirst();
+    printf("%%TEST_FINISHED%% time=0 testLastRegionFirst (ikRegionSelector_test) \n");
+
+    printf("%%TEST_STARTED%% testSlabIndex (ikRegionSelector_test)\n");
+    testSlabIndex();
+    printf("%%TEST_FINISHED%% time=0 testSlabIndex (ikRegionSelector_test) \n");
+
+    printf("%%TEST_STARTED%% testGetRegions (ikRegionSelector_test)\n");
+    testGetRegions();
+    printf("%%TEST_FINISHED%% time=0 testGetRegions (ikRegionSelector_test) \n");
+
+    printf("%%TEST_STARTED%% testManyRegions (ikRegionSelector_test)\n");
+    testManyRegions();
+    printf("%%TEST_FINISHED%% time=0 testManyRegions (ikRegionSelector_test) \n");
+
+    printf("%%TEST_STARTED%% testBuffer (ikRegionSelector_test)\n");
+    testBuffer();
+    printf("%%TEST_FINISHED%% time=0 testBuffer (ikRegionSelector_test) \n");
     
     printf("%%SUITE_FINISHED%% time=0\n");
 
@@ -0,0 +1,214 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikReplay.c
+ * 
+ * @brief Class ikReplay implementation
+ */
+
+/* @cond */
+
+#include <stdlib.h>
+#include <string.h>
+#include "ikReplay.h"
+
+#define IKREPLAY_NINPUTS 21
+
+/**
+ * (Private) get the input of the farm with a given name
+ * @return input array, or NULL if the name is not that of an input
+ */
+double *ikReplay_findInput(ikFarm *farm, const char *name) {
+    const char *names[IKREPLAY_NINPUTS] = {
+        "generator speed", "generator torque", "maximum thrust", "azimuth",
+        "collective pitch", "maximum pitch", "minimum pitch",
+        "blade root moment 1 x", "blade root moment 1 y", "blade root moment 1 z",
+        "blade root moment 2 x", "blade root moment 2 y", "blade root moment 2 z",
+        "blade root moment 3 x", "blade root moment 3 y", "blade root moment 3 z",
+        "demanded My", "demanded Mz", "maximum individual pitch",
+        "external pitch y", "external pitch z"
+    };
+    double *inputs[IKREPLAY_NINPUTS];
+    int i, j;
+
+    /*list the inputs in the same order as the names */
+    inputs[0] = farm->in.generatorSpeed;
+    inputs[1] = farm->in.generatorTorque;
+    inputs[2] = farm->in.maximumThrust;
+    inputs[3] = farm->in.azimuth;
+    inputs[4] = farm->in.collectivePitch;
+    inputs[5] = farm->in.maximumPitch;
+    inputs[6] = farm->in.minimumPitch;
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++) inputs[7 + 3*i + j] = farm->in.bladeRootMoments[i][j];
+    }
+    inputs[16] = farm->in.demandedMy;
+    inputs[17] = farm->in.demandedMz;
+    inputs[18] = farm->in.maximumIndividualPitch;
+    inputs[19] = farm->in.externalPitchY;
+    inputs[20] = farm->in.externalPitchZ;
+
+    for (i = 0; i < IKREPLAY_NINPUTS; i++) {
+        if (!strcmp(name, names[i])) return inputs[i];
+    }
+    return NULL;
+}
+
+/**
+ * (Private) get the output of the farm with a given name
+ * @return output array, or NULL if the name is not that of an output
+ */
+const double *ikReplay_findOutput(const ikFarm *farm, const char *name) {
+    if (!strcmp(name, "tip-speed ratio")) return farm->out.tipSpeedRatio;
+    if (!strcmp(name, "rotor speed")) return farm->out.rotorSpeed;
+    if (!strcmp(name, "minimum pitch")) return farm->out.minimumPitch;
+    if (!strcmp(name, "pitch 1")) return farm->out.pitch[0];
+    if (!strcmp(name, "pitch 2")) return farm->out.pitch[1];
+    if (!strcmp(name, "pitch 3")) return farm->out.pitch[2];
+    return NULL;
+}
+
+/**
+ * (Private) free the memory of an instance
+ */
+void ikReplay_free(ikReplay *self) {
+    int i;
+
+    if (NULL != self->outputNames) {
+        for (i = 0; i < self->nOutputs; i++) free(self->outputNames[i]);
+    }
+    free(self->outputNames);
+    free(self->outputs);
+    free(self->inputs);
+    self->outputNames = NULL;
+    self->outputs = NULL;
+    self->inputs = NULL;
+}
+
+int ikReplay_init(ikReplay *self, const ikReplayParams *params) {
+    ikFarmParams farmParams;
+    double output;
+    int i;
+
+    /*check parameters */
+    if ((0 > params->nChannels) || (0 > params->nOutputs)) return -1;
+    self->nChannels = params->nChannels;
+    self->nOutputs = params->nOutputs;
+
+    /*initialise turbine controllers */
+    ikFarm_initParams(&farmParams);
+    farmParams.turbine = params->turbine;
+    if (ikFarm_init(&(self->farm), &farmParams)) return -2;
+
+    /*allocate memory */
+    self->inputs = (double **) calloc((size_t) self->nChannels + 1, sizeof(double *));
+    self->outputs = (const double **) calloc((size_t) self->nOutputs + 1, sizeof(const double *));
+    self->outputNames = (char **) calloc((size_t) self->nOutputs + 1, sizeof(char *));
+    if ((NULL == self->inputs) || (NULL == self->outputs) || (NULL == self->outputNames)) {
+        ikReplay_free(self);
+        ikFarm_delete(&(self->farm));
+        return -3;
+    }
+
+    /*match the channels to the inputs */
+    for (i = 0; i < self->nChannels; i++) {
+        self->inputs[i] = ikReplay_findInput(&(self->farm), params->channels[i]);
+    }
+
+    /*match the outputs, checking the names of those not copied directly */
+    for (i = 0; i < self->nOutputs; i++) {
+        self->outputNames[i] = (char *) malloc(strlen(params->outputs[i]) + 1);
+        if (NULL == self->outputNames[i]) {
+            ikReplay_free(self);
+            ikFarm_delete(&(self->farm));
+            return -3;
+        }
+        strcpy(self->outputNames[i], params->outputs[i]);
+        self->outputs[i] = ikReplay_findOutput(&(self->farm), params->outputs[i]);
+        if ((NULL == self->outputs[i]) && ikFarm_getOutput(&(self->farm), &output, 0, params->outputs[i])) {
+            ikReplay_free(self);
+            ikFarm_delete(&(self->farm));
+            return -4;
+        }
+    }
+
+    return 0;
+}
+
+void ikReplay_initParams(ikReplayParams *params) {
+    ikFarmParams farmParams;
+
+    /*take the turbine defaults from the farm */
+    ikFarm_initParams(&farmParams);
+    params->turbine = farmParams.turbine;
+    params->nChannels = 0;
+    params->channels = NULL;
+    params->nOutputs = 0;
+    params->outputs = NULL;
+}
+
+void ikReplay_step(ikReplay *self, const double inputs[], double outputs[]) {
+    int i;
+
+    /*set inputs */
+    for (i = 0; i < self->nChannels; i++) {
+        if (NULL != self->inputs[i]) self->inputs[i][0] = inputs[i];
+    }
+
+    /*step */
+    ikFarm_step(&(self->farm));
+
+    /*get outputs */
+    for (i = 0; i < self->nOutputs; i++) {
+        if (NULL != self->outputs[i]) outputs[i] = self->outputs[i][0];
+        else ikFarm_getOutput(&(self->farm), &(outputs[i]), 0, self->outputNames[i]);
+    }
+}
+
+int ikReplay_saveState(const ikReplay *self, void *buffer, size_t size, size_t *length) {
+    ikCheckpoint cp;
+
+    /*saving leaves the instance as it is */
+    ikCheckpoint_initSave(&cp, buffer, size, "ikReplay");
+    ikFarm_checkpoint((ikFarm *) &(self->farm), &cp);
+    return ikCheckpoint_finish(&cp, length);
+}
+
+int ikReplay_restoreState(ikReplay *self, const void *blob, size_t size) {
+    ikCheckpoint cp;
+    int err;
+
+    /*check the whole blob with a dry run, then restore */
+    err = ikCheckpoint_initRestore(&cp, blob, size, "ikReplay", 1);
+    if (err) return err;
+    ikFarm_checkpoint(&(self->farm), &cp);
+    err = ikCheckpoint_finish(&cp, NULL);
+    if (err) return err;
+    ikCheckpoint_initRestore(&cp, blob, size, "ikReplay", 0);
+    ikFarm_checkpoint(&(self->farm), &cp);
+    return ikCheckpoint_finish(&cp, NULL);
+}
+
+void ikReplay_delete(ikReplay *self) {
+    ikReplay_free(self);
+    ikFarm_delete(&(self->farm));
+}
+
+/* @endcond */
@@ -0,0 +1,177 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikReplay.h
+ * 
+ * @brief Class ikReplay interface
+ */
+
+#ifndef IKREPLAY_H
+#define IKREPLAY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ikFarm.h"
+
+    /**
+     * @struct ikReplay
+     * @brief Controller replay
+     * 
+     * Instances of this type drive the controllers of a wind turbine, as
+     * connected in @link ikFarm @endlink, from recorded signals. The recorded
+     * signals are passed one sample at a time, as rows with one value per
+     * channel, and the channels are matched by name to the inputs of
+     * @link ikFarm @endlink, as named below. Channels with other names, e.g.
+     * "time", are ignored, and inputs with no channel are kept at 0.0.
+     * 
+     * The outputs to be recorded are also chosen by name. These may be the
+     * outputs of @link ikFarm @endlink, as named below, which are copied
+     * directly, or any name accepted by @link ikFarm_getOutput @endlink,
+     * e.g. "individual pitch control>My".
+     * 
+     * @par Inputs
+     * @li "generator speed", in rad/s
+     * @li "generator torque", in kNm
+     * @li "maximum thrust", in kN
+     * @li "azimuth", in degrees
+     * @li "collective pitch", in degrees
+     * @li "maximum pitch", in degrees
+     * @li "minimum pitch", in degrees
+     * @li "blade root moment i x", "blade root moment i y" and "blade root
+     * moment i z", in kNm, where i is the blade number, from 1 to 3
+     * @li "demanded My", in kNm
+     * @li "demanded Mz", in kNm
+     * @li "maximum individual pitch", in degrees
+     * @li "external pitch y", in degrees
+     * @li "external pitch z", in degrees
+     * 
+     * @par Outputs
+     * @li "tip-speed ratio"
+     * @li "rotor speed", in rad/s
+     * @li "minimum pitch", in degrees, from thrust limitation
+     * @li "pitch 1", "pitch 2" and "pitch 3", in degrees
+     * 
+     * Instances allocate memory, and must be deleted with
+     * @link ikReplay_delete @endlink before being initialised again or
+     * discarded.
+     * 
+     * @par Methods
+     * @li @link ikReplay_initParams @endlink initialise initialisation parameter structure
+     * @li @link ikReplay_init @endlink initialise an instance
+     * @li @link ikReplay_step @endlink execute periodic calculations
+     * @li @link ikReplay_saveState @endlink save runtime state to a checkpoint blob
+     * @li @link ikReplay_restoreState @endlink restore runtime state from a checkpoint blob
+     * @li @link ikReplay_delete @endlink delete instance
+     */
+    typedef struct ikReplay {
+        /* @cond */
+        ikFarm farm; /*turbine controllers */
+        int nChannels; /*number of input channels */
+        double **inputs; /*inputs matched by each channel, or NULL */
+        int nOutputs; /*number of outputs */
+        const double **outputs; /*outputs copied directly, or NULL */
+        char **outputNames; /*output names */
+        /* @endcond */
+    } ikReplay;
+
+    /**
+     * @struct ikReplayParams
+     * @brief Controller replay initialisation parameters
+     */
+    typedef struct ikReplayParams {
+        ikFarmTurbineParams turbine; /**<turbine controller initialisation parameters*/
+        int nChannels; /**<number of input channels. The default value is 0.*/
+        const char *const *channels; /**<array of nChannels input channel names. The default value is NULL.*/
+        int nOutputs; /**<number of outputs. The default value is 0.*/
+        const char *const *outputs; /**<array of nOutputs output names. The default value is NULL.*/
+    } ikReplayParams;
+
+    /**
+     * Initialise an instance
+     * 
+     * The names are copied, so they need not outlive the call.
+     * 
+     * @param self instance
+     * @param params initialisation parameters
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid number of channels or outputs, must be non-negative
+     * @li -2: could not initialise the turbine controllers
+     * @li -3: could not allocate memory
+     * @li -4: invalid output name
+     */
+    int ikReplay_init(ikReplay *self, const ikReplayParams *params);
+
+    /**
+     * Initialise initialisation parameter structure
+     * @param params initialisation parameter structure
+     */
+    void ikReplay_initParams(ikReplayParams *params);
+
+    /**
+     * Execute periodic calculations for one sample
+     * @param self instance
+     * @param inputs array with one value per input channel
+     * @param outputs array for one value per output
+     */
+    void ikReplay_step(ikReplay *self, const double inputs[], double outputs[]);
+
+    /**
+     * Save runtime state to a checkpoint blob, as described in
+     * @link ikCheckpoint @endlink, i.e. that of the turbine controllers, as
+     * in @link ikFarm_checkpoint @endlink. The blob can be restored, via
+     * @link ikReplay_restoreState @endlink, into this or any other instance
+     * initialised with the same turbine controller parameters, e.g. to
+     * resume a replay part way through a log.
+     * @param self instance
+     * @param buffer buffer for the blob, or NULL to find out its length
+     * @param size size of the buffer, in bytes
+     * @param length length of the blob, in bytes, or, if the buffer is too
+     * small, the size needed
+     * @return error code:
+     * @li 0: no error
+     * @li -1: the buffer is too small
+     */
+    int ikReplay_saveState(const ikReplay *self, void *buffer, size_t size, size_t *length);
+
+    /**
+     * Restore runtime state from a checkpoint blob written by
+     * @link ikReplay_saveState @endlink. The blob is checked before anything
+     * is restored, so that the instance is left as it was on error.
+     * @param self instance
+     * @param blob blob
+     * @param size size of the blob, in bytes
+     * @return error code, as in @link ikIpc_restoreState @endlink
+     */
+    int ikReplay_restoreState(ikReplay *self, const void *blob, size_t size);
+
+    /**
+     * Delete instance
+     * @param self instance
+     */
+    void ikReplay_delete(ikReplay *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKREPLAY_H */
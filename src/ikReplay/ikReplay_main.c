@@ -0,0 +1,750 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikReplay_main.c
+ * 
+ * @brief Controller replay executable
+ * 
+ * Drives the controllers of a wind turbine, as connected in ikFarm, from
+ * recorded signals, and records the chosen outputs. The recorded signals
+ * are read from a columnar binary log, as written by @link ikLogWriter @endlink,
+ * or from a CSV file with a header line with the channel names, as in
+ * @link ikReplay @endlink, and one line per sample. Binary logs are mapped
+ * into memory and read in place, and CSV files are read one line at a time,
+ * so that they may be of any length, or a pipe. The outputs are written in
+ * the format of the input, binary logs with the value size and chunk length
+ * of the input. When done, the number of samples and the throughput, in
+ * samples per second, are reported on the standard error.
+ * 
+ * Usage: ikReplay_main [options] input [output]
+ * 
+ * With "-" as input, or no output, the standard input or output are used,
+ * for CSV only.
+ * 
+ * Options:
+ * @li -o name: record output name, as in @link ikReplay @endlink, which may
+ * be repeated. The default is to record "pitch 1", "pitch 2" and "pitch 3".
+ * @li -cp file: Cp/lambda^3 surface file of the tip-speed ratio estimator
+ * @li -ct file: Ct/lambda^2 surface file of the thrust limiter
+ * @li -b, -J, -rho, -R, -T value: gearbox ratio, rotor moment of inertia,
+ * air density, rotor radius and time step, as in ikTsrEstParams and
+ * ikThrustLimParams
+ * @li -j threads: replay in segments, on this number of threads
+ * @li -n segments: number of segments, by default the number of threads
+ * @li -w samples: number of samples of the previous segment replayed to warm
+ * up the controllers at the start of each segment, when on more than one
+ * thread and with no saved state. The default is 0.
+ * @li -s file: save the state of the controllers at the end of each segment
+ * @li -l file: start each segment from the state saved at its first sample,
+ * if any, in a file written with -s
+ * 
+ * Segmented replay is for binary logs only. The log is split in segments of
+ * equal length, replayed in parallel, each one starting from scratch, after
+ * the warm-up, or from a saved state. A saved state gives the same outputs as
+ * a sequential replay, so a first replay on one thread with -s, e.g. of a
+ * nightly log, allows replaying it again on all cores, e.g. with other
+ * outputs, with exact results. For each segment with a warm-up, the
+ * largest difference between the warm-up outputs and those of the previous
+ * segment, over the warm-up and at its last sample, is reported on the
+ * standard error, to choose the warm-up length. The outputs of each segment
+ * are written as soon as it and those before it are done, with at most 2
+ * segments per thread replayed ahead of the writing, so that the memory
+ * taken by the outputs is bounded by the length of the segments, rather
+ * than by that of the log. Long logs are best split in more segments than
+ * threads, with -n.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "ikReplay.h"
+#include "ikLogWriter.h"
+#include "ikLogReader.h"
+
+#define MAXOUTPUTS 64
+
+/*
+ * Split a CSV line in place at the commas, dropping the line end.
+ * Returns the number of fields.
+ */
+int splitLine(char *line, char **fields, int maxFields) {
+    int n = 0;
+    char *p = line;
+
+    line[strcspn(line, "\r\n")] = '\0';
+    while (n < maxFields) {
+        fields[n++] = p;
+        p = strchr(p, ',');
+        if (NULL == p) break;
+        *p++ = '\0';
+    }
+    return n;
+}
+
+/*
+ * Parse the fields of a CSV line into values, with NaN for empty or
+ * invalid fields and for missing ones.
+ */
+void parseLine(char *line, double *values, int n) {
+    char *p = line;
+    char *end;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        values[i] = strtod(p, &end);
+        if ((end == p) || ((',' != *end) && ('\0' != *end) && ('\r' != *end) && ('\n' != *end))) {
+            values[i] = NAN;
+            end += strcspn(end, ",");
+        }
+        if (',' != *end) {
+            for (i++; i < n; i++) values[i] = NAN;
+            break;
+        }
+        p = end + 1;
+    }
+}
+
+/*
+ * Replay a CSV file. Returns the number of samples, or -1 on error.
+ */
+long replayCsv(ikReplayParams *params, FILE *in, FILE *out) {
+    ikReplay replay;
+    char *line = NULL;
+    size_t lineSize = 0;
+    char **channels;
+    int nChannels;
+    double *inputs;
+    double outputs[MAXOUTPUTS];
+    long nSamples = 0;
+    int err, i;
+
+    /*read the channel names */
+    if (0 > getline(&line, &lineSize, in)) {
+        fprintf(stderr, "no header in the input\n");
+        return -1;
+    }
+    nChannels = 1;
+    for (i = 0; '\0' != line[i]; i++) nChannels += (',' == line[i]);
+    channels = (char **) malloc(sizeof(char *) * nChannels);
+    inputs = (double *) malloc(sizeof(double) * nChannels);
+    if ((NULL == channels) || (NULL == inputs)) return -1;
+    nChannels = splitLine(line, channels, nChannels);
+
+    /*set up the controllers */
+    params->nChannels = nChannels;
+    params->channels = (const char *const *) channels;
+    err = ikReplay_init(&replay, params);
+    if (err) {
+        fprintf(stderr, "could not initialise the controllers, error %d\n", err);
+        return -1;
+    }
+
+    /*write the output names */
+    for (i = 0; i < params->nOutputs; i++) fprintf(out, i ? ",%s" : "%s", params->outputs[i]);
+    fprintf(out, "\n");
+
+    /*replay */
+    while (0 <= getline(&line, &lineSize, in)) {
+        if ('\0' == line[strspn(line, " \t\r\n")]) continue;
+        parseLine(line, inputs, nChannels);
+        ikReplay_step(&replay, inputs, outputs);
+        for (i = 0; i < params->nOutputs; i++) fprintf(out, i ? ",%.17g" : "%.17g", outputs[i]);
+        fprintf(out, "\n");
+        nSamples++;
+    }
+
+    /*clean up */
+    ikReplay_delete(&replay);
+    free(line);
+    free(channels);
+    free(inputs);
+
+    return nSamples;
+}
+
+/*
+ * Replay a binary log. Returns the number of samples, or -1 on error.
+ */
+long replayLog(ikReplayParams *params, ikLogReader *in, const char *outName) {
+    ikReplay replay;
+    ikLogWriter out;
+    ikLogWriterParams outParams;
+    const int nChannels = ikLogReader_getNChannels(in);
+    const int valueSize = ikLogReader_getValueSize(in);
+    const char **channels;
+    const void **columns;
+    double *inputs;
+    double outputs[MAXOUTPUTS];
+    long nSamples = 0;
+    long chunk;
+    int length;
+    int err, i, j;
+
+    /*set up the controllers */
+    channels = (const char **) malloc(sizeof(const char *) * nChannels);
+    columns = (const void **) malloc(sizeof(const void *) * nChannels);
+    inputs = (double *) malloc(sizeof(double) * nChannels);
+    if ((NULL == channels) || (NULL == columns) || (NULL == inputs)) return -1;
+    for (i = 0; i < nChannels; i++) channels[i] = ikLogReader_getName(in, i);
+    params->nChannels = nChannels;
+    params->channels = channels;
+    err = ikReplay_init(&replay, params);
+    if (err) {
+        fprintf(stderr, "could not initialise the controllers, error %d\n", err);
+        return -1;
+    }
+
+    /*create the output log */
+    ikLogWriter_initParams(&outParams);
+    outParams.fileName = outName;
+    outParams.nChannels = params->nOutputs;
+    outParams.channels = params->outputs;
+    outParams.valueSize = valueSize;
+    outParams.chunkLength = ikLogReader_getChunkLength(in);
+    outParams.nChunks = 1;
+    err = ikLogWriter_init(&out, &outParams);
+    if (err) {
+        fprintf(stderr, "could not create %s, error %d\n", outName, err);
+        return -1;
+    }
+
+    /*replay, one chunk at a time */
+    for (chunk = 0; nSamples < ikLogReader_getNSamples(in); chunk++) {
+        for (i = 0; i < nChannels; i++) columns[i] = ikLogReader_getColumn(in, i, chunk, &length);
+        for (j = 0; j < length; j++) {
+            if (sizeof(double) == valueSize) {
+                for (i = 0; i < nChannels; i++) inputs[i] = ((const double *) columns[i])[j];
+            } else {
+                for (i = 0; i < nChannels; i++) inputs[i] = ((const float *) columns[i])[j];
+            }
+            ikReplay_step(&replay, inputs, outputs);
+            ikLogWriter_write(&out, outputs);
+        }
+        nSamples += length;
+        if (ikLogWriter_flush(&out)) break;
+    }
+
+    /*clean up */
+    err = ikLogWriter_delete(&out);
+    if (err) fprintf(stderr, "could not write %s\n", outName);
+    ikReplay_delete(&replay);
+    free(channels);
+    free(columns);
+    free(inputs);
+
+    return err ? -1 : nSamples;
+}
+
+/*
+ * Segment of a segmented replay
+ */
+typedef struct replaySegment {
+    long start; /*first sample */
+    long end; /*sample after the last one */
+    long warmup; /*number of samples replayed before start to warm up the controllers */
+    const void *state; /*state at start, or NULL */
+    size_t stateSize; /*size of state */
+    double *outputs; /*outputs from start to end, one row per sample, while not written */
+    double *warmupOutputs; /*outputs of the warm-up samples, while not written */
+    void *endState; /*state at end, if saved, while not written */
+    size_t endStateSize; /*size of endState */
+    int done; /*flag: replayed, and ready to be written */
+} replaySegment;
+
+/*
+ * Queue of the segments of a segmented replay, shared by the workers, which
+ * take the segments in order, and the writer, which writes them in order as
+ * they are done. The workers go at most window segments ahead of the writer,
+ * so that the outputs held in memory are bounded.
+ */
+typedef struct replayQueue {
+    replaySegment *segments; /*all segments */
+    int nSegments; /*number of segments */
+    int next; /*next segment to replay */
+    int nWritten; /*number of segments written */
+    int window; /*maximum number of segments replayed ahead of the writer */
+    int err; /*flag: a worker or the writer failed, stop */
+    pthread_mutex_t mutex; /*mutex for the members above and the done flags */
+    pthread_cond_t cond; /*signalled when a segment is taken, done or written */
+} replayQueue;
+
+/*
+ * Worker replaying the segments it takes from the queue, on its own thread
+ */
+typedef struct replayWorker {
+    ikReplay replay; /*controllers */
+    const ikLogReader *in; /*input log */
+    int nOutputs; /*number of outputs */
+    void *initState; /*state just after initialisation */
+    size_t initStateSize; /*size of initState */
+    replayQueue *queue; /*segment queue */
+    int chained; /*flag: go on from the end of the previous segment */
+    int saveStates; /*flag: save the state at the end of each segment */
+    int err; /*error code */
+    pthread_t thread; /*thread */
+} replayWorker;
+
+/*
+ * Replay a segment. Returns an error code, as ikReplay_restoreState, or
+ * -7 if the outputs could not be allocated or the state at the end could
+ * not be saved.
+ */
+int replayOneSegment(replayWorker *w, replaySegment *s, double *inputs) {
+    const int nChannels = ikLogReader_getNChannels(w->in);
+    double *outputs;
+    long n;
+    int err = 0;
+    int i;
+
+    /*start from the saved state, from scratch or where the previous segment ended */
+    if (NULL != s->state) err = ikReplay_restoreState(&(w->replay), s->state, s->stateSize);
+    else if (!w->chained) err = ikReplay_restoreState(&(w->replay), w->initState, w->initStateSize);
+    if (err) return err;
+
+    /*warm up, then replay */
+    s->outputs = (double *) malloc(sizeof(double) * w->nOutputs * (s->end - s->start + 1));
+    s->warmupOutputs = (double *) malloc(sizeof(double) * w->nOutputs * (s->warmup + 1));
+    if ((NULL == s->outputs) || (NULL == s->warmupOutputs)) return -7;
+    for (n = s->start - s->warmup; n < s->end; n++) {
+        for (i = 0; i < nChannels; i++) inputs[i] = ikLogReader_getValue(w->in, i, n);
+        if (n < s->start) outputs = s->warmupOutputs + (n - s->start + s->warmup) * w->nOutputs;
+        else outputs = s->outputs + (n - s->start) * w->nOutputs;
+        ikReplay_step(&(w->replay), inputs, outputs);
+    }
+
+    /*save the state at the end */
+    if (w->saveStates) {
+        ikReplay_saveState(&(w->replay), NULL, 0, &(s->endStateSize));
+        s->endState = malloc(s->endStateSize);
+        if (NULL == s->endState) return -7;
+        if (ikReplay_saveState(&(w->replay), s->endState, s->endStateSize, &(s->endStateSize))) return -7;
+    }
+
+    return 0;
+}
+
+/*
+ * Worker thread: replay the segments taken from the queue, in order, while
+ * within the window
+ */
+void *replayWorkerThread(void *arg) {
+    replayWorker *w = (replayWorker *) arg;
+    replayQueue *q = w->queue;
+    double *inputs;
+    int k;
+
+    inputs = (double *) malloc(sizeof(double) * ikLogReader_getNChannels(w->in));
+    if (NULL == inputs) w->err = -7;
+    while (!w->err) {
+        /*take the next segment, once the writer has caught up */
+        pthread_mutex_lock(&(q->mutex));
+        while (!q->err && (q->next < q->nSegments) && (q->next >= q->nWritten + q->window)) {
+            pthread_cond_wait(&(q->cond), &(q->mutex));
+        }
+        k = (q->err || (q->next >= q->nSegments)) ? -1 : q->next++;
+        pthread_mutex_unlock(&(q->mutex));
+        if (0 > k) break;
+
+        /*replay it, and hand it over to the writer */
+        w->err = replayOneSegment(w, &(q->segments[k]), inputs);
+        if (w->err) fprintf(stderr, "could not replay segment %d, error %d\n", k, w->err);
+        pthread_mutex_lock(&(q->mutex));
+        if (w->err) q->err = 1;
+        else q->segments[k].done = 1;
+        pthread_cond_broadcast(&(q->cond));
+        pthread_mutex_unlock(&(q->mutex));
+    }
+    if (w->err) {
+        pthread_mutex_lock(&(q->mutex));
+        q->err = 1;
+        pthread_cond_broadcast(&(q->cond));
+        pthread_mutex_unlock(&(q->mutex));
+    }
+    free(inputs);
+
+    return NULL;
+}
+
+/*
+ * Read a state file, made up by records of the sample at which the state
+ * was saved, as int64, the size of the blob, as uint64, and the blob.
+ * Returns the contents of the file, or NULL on error.
+ */
+char *readStates(const char *fileName, size_t *size) {
+    FILE *file;
+    char *data;
+    long length;
+
+    file = fopen(fileName, "rb");
+    if (NULL == file) return NULL;
+    fseek(file, 0, SEEK_END);
+    length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    data = (char *) malloc(length > 0 ? length : 1);
+    if ((NULL != data) && (0 < length) && (1 != fread(data, length, 1, file))) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    *size = length > 0 ? length : 0;
+
+    return data;
+}
+
+/*
+ * Find the state saved at a sample in the contents of a state file.
+ * Returns the blob, or NULL if there is none.
+ */
+const void *findState(const char *data, size_t size, long sample, size_t *stateSize) {
+    size_t pos = 0;
+    int64_t at;
+    uint64_t length;
+
+    while (pos + sizeof(at) + sizeof(length) <= size) {
+        memcpy(&at, data + pos, sizeof(at));
+        memcpy(&length, data + pos + sizeof(at), sizeof(length));
+        pos += sizeof(at) + sizeof(length);
+        if (length > size - pos) break;
+        if (at == sample) {
+            *stateSize = length;
+            return data + pos;
+        }
+        pos += length;
+    }
+
+    return NULL;
+}
+
+/*
+ * Compare the warm-up outputs of a segment with those of the previous one,
+ * as the largest difference over the warm-up and at its last sample, and
+ * report them. Returns the largest difference.
+ */
+double reportWarmup(const replaySegment *s, const replaySegment *previous, int k, int nOutputs) {
+    double d, dmax = 0.0, dend = 0.0;
+    long n;
+    int i;
+
+    if (!s->warmup) {
+        fprintf(stderr, "segment %d: samples %ld to %ld, %s\n", k, s->start, s->end - 1,
+                NULL != s->state ? "from saved state" : "chained");
+        return 0.0;
+    }
+    for (n = 0; n < s->warmup; n++) {
+        dend = 0.0;
+        for (i = 0; i < nOutputs; i++) {
+            d = fabs(s->warmupOutputs[n * nOutputs + i]
+                    - previous->outputs[(s->start - s->warmup + n - previous->start) * nOutputs + i]);
+            if (d > dend) dend = d;
+        }
+        if (dend > dmax) dmax = dend;
+    }
+    fprintf(stderr, "segment %d: samples %ld to %ld, warm-up %ld, max divergence %g, at the boundary %g\n",
+            k, s->start, s->end - 1, s->warmup, dmax, dend);
+    return dmax;
+}
+
+/*
+ * Replay a binary log in segments, in parallel, writing the outputs of each
+ * segment, and its state at the end, as soon as it and those before it are
+ * done. Returns the number of samples, or -1 on error.
+ */
+long replaySegments(ikReplayParams *params, ikLogReader *in, const char *outName,
+        int nThreads, int nSegments, long warmup, const char *saveName, const char *loadName) {
+    const int nChannels = ikLogReader_getNChannels(in);
+    const long nSamples = ikLogReader_getNSamples(in);
+    const int nOutputs = params->nOutputs;
+    const char **channels;
+    replaySegment *segments;
+    replayWorker *workers;
+    replayQueue queue;
+    char *states = NULL;
+    size_t statesSize = 0;
+    ikLogWriter out;
+    ikLogWriterParams outParams;
+    FILE *file = NULL;
+    int64_t at;
+    uint64_t length;
+    double d, dall = 0.0;
+    long n;
+    int err = 0;
+    int i, k, t;
+
+    /*split the log, with each segment starting from its saved state, if any */
+    if (nSegments > nSamples) nSegments = nSamples > 0 ? nSamples : 1;
+    if (nThreads > nSegments) nThreads = nSegments;
+    if ((NULL != loadName) && (NULL == (states = readStates(loadName, &statesSize)))) {
+        fprintf(stderr, "could not read %s\n", loadName);
+        return -1;
+    }
+    segments = (replaySegment *) calloc(nSegments, sizeof(replaySegment));
+    workers = (replayWorker *) calloc(nThreads, sizeof(replayWorker));
+    if ((NULL == segments) || (NULL == workers)) return -1;
+    for (k = 0; k < nSegments; k++) {
+        segments[k].start = nSamples * k / nSegments;
+        segments[k].end = nSamples * (k + 1) / nSegments;
+        if (k && (NULL != states)) segments[k].state = findState(states, statesSize, segments[k].start, &(segments[k].stateSize));
+        if (k && (1 < nThreads) && (NULL == segments[k].state)) {
+            segments[k].warmup = warmup;
+            if (segments[k].warmup > segments[k - 1].end - segments[k - 1].start) {
+                segments[k].warmup = segments[k - 1].end - segments[k - 1].start;
+            }
+        }
+    }
+
+    /*create the output log, and the state file */
+    ikLogWriter_initParams(&outParams);
+    outParams.fileName = outName;
+    outParams.nChannels = nOutputs;
+    outParams.channels = params->outputs;
+    outParams.valueSize = ikLogReader_getValueSize(in);
+    outParams.chunkLength = ikLogReader_getChunkLength(in);
+    outParams.nChunks = 1;
+    err = ikLogWriter_init(&out, &outParams);
+    if (err) {
+        fprintf(stderr, "could not create %s, error %d\n", outName, err);
+        return -1;
+    }
+    if ((NULL != saveName) && (NULL == (file = fopen(saveName, "wb")))) {
+        fprintf(stderr, "could not create %s\n", saveName);
+        return -1;
+    }
+
+    /*set up the queue, and the controllers of each worker */
+    queue.segments = segments;
+    queue.nSegments = nSegments;
+    queue.next = 0;
+    queue.nWritten = 0;
+    queue.window = 2 * nThreads;
+    queue.err = 0;
+    pthread_mutex_init(&(queue.mutex), NULL);
+    pthread_cond_init(&(queue.cond), NULL);
+    channels = (const char **) malloc(sizeof(const char *) * nChannels);
+    if (NULL == channels) return -1;
+    for (i = 0; i < nChannels; i++) channels[i] = ikLogReader_getName(in, i);
+    params->nChannels = nChannels;
+    params->channels = channels;
+    for (t = 0; t < nThreads; t++) {
+        err = ikReplay_init(&(workers[t].replay), params);
+        if (err) {
+            fprintf(stderr, "could not initialise the controllers, error %d\n", err);
+            return -1;
+        }
+        ikReplay_saveState(&(workers[t].replay), NULL, 0, &(workers[t].initStateSize));
+        workers[t].initState = malloc(workers[t].initStateSize);
+        if (NULL == workers[t].initState) return -1;
+        ikReplay_saveState(&(workers[t].replay), workers[t].initState, workers[t].initStateSize, &(workers[t].initStateSize));
+        workers[t].in = in;
+        workers[t].nOutputs = nOutputs;
+        workers[t].queue = &queue;
+        workers[t].chained = (1 == nThreads);
+        workers[t].saveStates = (NULL != saveName);
+    }
+
+    /*replay, with each worker on its own thread */
+    for (t = 0; t < nThreads; t++) {
+        if (pthread_create(&(workers[t].thread), NULL, replayWorkerThread, &(workers[t]))) {
+            fprintf(stderr, "could not create thread %d\n", t);
+            pthread_mutex_lock(&(queue.mutex));
+            queue.err = 1;
+            pthread_mutex_unlock(&(queue.mutex));
+            break;
+        }
+    }
+
+    /*write each segment as soon as it is done, in order, reporting the */
+    /*divergence of its warm-up outputs from those of the previous one */
+    for (k = 0; k < nSegments; k++) {
+        pthread_mutex_lock(&(queue.mutex));
+        while (!queue.err && !segments[k].done) pthread_cond_wait(&(queue.cond), &(queue.mutex));
+        if (queue.err) err = -1;
+        pthread_mutex_unlock(&(queue.mutex));
+        if (err) break;
+
+        if (k) {
+            d = reportWarmup(&(segments[k]), &(segments[k - 1]), k, nOutputs);
+            if (d > dall) dall = d;
+        }
+        for (n = segments[k].start; (n < segments[k].end) && !err; n++) {
+            ikLogWriter_write(&out, segments[k].outputs + (n - segments[k].start) * nOutputs);
+            if (!((n + 1) % outParams.chunkLength) && ikLogWriter_flush(&out)) {
+                fprintf(stderr, "could not write %s\n", outName);
+                err = -1;
+            }
+        }
+        if ((NULL != file) && !err) {
+            at = segments[k].end;
+            length = segments[k].endStateSize;
+            if ((1 != fwrite(&at, sizeof(at), 1, file)) || (1 != fwrite(&length, sizeof(length), 1, file))
+                    || (1 != fwrite(segments[k].endState, length, 1, file))) {
+                fprintf(stderr, "could not write %s\n", saveName);
+                err = -1;
+            }
+        }
+
+        /*keep the outputs of this segment only for the warm-up of the next */
+        if (k) {
+            free(segments[k - 1].outputs);
+            segments[k - 1].outputs = NULL;
+        }
+        free(segments[k].warmupOutputs);
+        segments[k].warmupOutputs = NULL;
+        free(segments[k].endState);
+        segments[k].endState = NULL;
+        pthread_mutex_lock(&(queue.mutex));
+        if (err) queue.err = 1;
+        queue.nWritten = k + 1;
+        pthread_cond_broadcast(&(queue.cond));
+        pthread_mutex_unlock(&(queue.mutex));
+        if (err) break;
+    }
+    for (i = 0; i < t; i++) pthread_join(workers[i].thread, NULL);
+    if (!err && warmup && (1 < nThreads)) fprintf(stderr, "max warm-up divergence %g\n", dall);
+    if (ikLogWriter_delete(&out)) {
+        fprintf(stderr, "could not write %s\n", outName);
+        err = -1;
+    }
+    if ((NULL != file) && fclose(file)) {
+        fprintf(stderr, "could not write %s\n", saveName);
+        err = -1;
+    }
+
+    /*clean up */
+    for (t = 0; t < nThreads; t++) {
+        ikReplay_delete(&(workers[t].replay));
+        free(workers[t].initState);
+    }
+    for (k = 0; k < nSegments; k++) {
+        free(segments[k].outputs);
+        free(segments[k].warmupOutputs);
+        free(segments[k].endState);
+    }
+    pthread_cond_destroy(&(queue.cond));
+    pthread_mutex_destroy(&(queue.mutex));
+    free(workers);
+    free(segments);
+    free(channels);
+    free(states);
+
+    return err ? -1 : nSamples;
+}
+
+int main(int argc, char** argv) {
+    ikReplayParams params;
+    ikLogReader log;
+    const char *defaultOutputs[3] = {"pitch 1", "pitch 2", "pitch 3"};
+    const char *outputNames[MAXOUTPUTS];
+    int nOutputs = 0;
+    const char *inName = NULL;
+    const char *outName = NULL;
+    const char *saveName = NULL;
+    const char *loadName = NULL;
+    int nThreads = 1;
+    int nSegments = 0;
+    long warmup = 0;
+    int segmented = 0;
+    FILE *in;
+    FILE *out;
+    long nSamples;
+    struct timespec start, end;
+    double t;
+    int i;
+
+    /*set up parameters from the command line */
+    ikReplay_initParams(&params);
+    for (i = 1; i < argc; i++) {
+        if (('-' != argv[i][0]) || ('\0' == argv[i][1])) {
+            if (NULL == inName) inName = argv[i];
+            else if (NULL == outName) outName = argv[i];
+            else break;
+            continue;
+        }
+        if (i + 1 >= argc) break;
+        if (!strcmp(argv[i], "-o") && (MAXOUTPUTS > nOutputs)) outputNames[nOutputs++] = argv[++i];
+        else if (!strcmp(argv[i], "-cp")) params.turbine.tsrEst.cplambda3SurfaceFileName = argv[++i];
+        else if (!strcmp(argv[i], "-ct")) params.turbine.thrustLim.ctlambda2SurfaceFileName = argv[++i];
+        else if (!strcmp(argv[i], "-b")) params.turbine.tsrEst.b = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-J")) params.turbine.tsrEst.J = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-rho")) params.turbine.tsrEst.rho = params.turbine.thrustLim.rho = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-R")) params.turbine.tsrEst.R = params.turbine.thrustLim.R = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-T")) params.turbine.tsrEst.T = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-j") && (0 < (nThreads = atoi(argv[++i])))) segmented = 1;
+        else if (!strcmp(argv[i], "-n") && (0 < (nSegments = atoi(argv[++i])))) segmented = 1;
+        else if (!strcmp(argv[i], "-w") && (0 <= (warmup = atol(argv[++i])))) segmented = 1;
+        else if (!strcmp(argv[i], "-s")) segmented = 1, saveName = argv[++i];
+        else if (!strcmp(argv[i], "-l")) segmented = 1, loadName = argv[++i];
+        else break;
+    }
+    if ((i < argc) || (NULL == inName)) {
+        fprintf(stderr, "usage: %s [-o name]... [-cp file] [-ct file] [-b|-J|-rho|-R|-T value]... "
+                "[-j threads] [-n segments] [-w samples] [-s file] [-l file] input [output]\n", argv[0]);
+        return (EXIT_FAILURE);
+    }
+    if (!nOutputs) {
+        for (i = 0; i < 3; i++) outputNames[nOutputs++] = defaultOutputs[i];
+    }
+    params.nOutputs = nOutputs;
+    params.outputs = outputNames;
+
+    /*replay a binary log */
+    if (strcmp(inName, "-") && !ikLogReader_init(&log, inName)) {
+        if (NULL == outName) {
+            fprintf(stderr, "binary logs need an output file\n");
+            return (EXIT_FAILURE);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        if (segmented) nSamples = replaySegments(&params, &log, outName, nThreads, nSegments ? nSegments : nThreads, warmup, saveName, loadName);
+        else nSamples = replayLog(&params, &log, outName);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        ikLogReader_delete(&log);
+    } else {
+
+        /*or a CSV file */
+        if (segmented) {
+            fprintf(stderr, "segmented replay needs a binary log\n");
+            return (EXIT_FAILURE);
+        }
+        in = strcmp(inName, "-") ? fopen(inName, "r") : stdin;
+        if (NULL == in) {
+            fprintf(stderr, "could not open %s\n", inName);
+            return (EXIT_FAILURE);
+        }
+        out = (NULL != outName) ? fopen(outName, "w") : stdout;
+        if (NULL == out) {
+            fprintf(stderr, "could not open %s\n", outName);
+            return (EXIT_FAILURE);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        nSamples = replayCsv(&params, in, out);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        if (stdin != in) fclose(in);
+        if (stdout != out) fclose(out);
+    }
+    if (0 > nSamples) return (EXIT_FAILURE);
+
+    t = (end.tv_sec - start.tv_sec) + 1e-9 * (end.tv_nsec - start.tv_nsec);
+    fprintf(stderr, "%ld samples in %.3f s, %.0f samples/s\n", nSamples, t, t > 0.0 ? nSamples / t : 0.0);
+
+    return (EXIT_SUCCESS);
+}
@@ -0,0 +1,296 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikReplay_test.c
+ * 
+ * @brief Class ikReplay unit tests
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "ikReplay.h"
+#include "ikTestUtil.h"
+
+/*
+ * Simple C Test Suite for class ikReplay
+ */
+
+#define NSTEPS 300
+
+/**
+ * Set up turbine parameters.
+ */
+void initTurbineParams(ikFarmTurbineParams *params) {
+    ikTsrEst_initParams(&(params->tsrEst));
+    params->tsrEst.b = 97.0;
+    params->tsrEst.J = 4.0e6;
+    params->tsrEst.rho = 1.225;
+    params->tsrEst.R = 63.0;
+    params->tsrEst.T = 0.01;
+    params->tsrEst.cplambda3SurfaceFileName = "ikReplay_test_cp.bin";
+    ikThrustLim_initParams(&(params->thrustLim));
+    params->thrustLim.rho = 1.225;
+    params->thrustLim.R = 63.0;
+    params->thrustLim.ctlambda2SurfaceFileName = "ikReplay_test_ct.bin";
+    ikIpc_initParams(&(params->ipc));
+}
+
+/**
+ * Replay matches stepping a farm directly, whatever the channel order
+ */
+void testReplay() {
+    printf("ikReplay_test testReplay\n");
+    /* channels in no particular order, with an unknown one */
+    const char *channels[23] = {
+        "time", "azimuth", "generator torque", "generator speed",
+        "blade root moment 3 z", "blade root moment 3 y", "blade root moment 3 x",
+        "blade root moment 2 z", "blade root moment 2 y", "blade root moment 2 x",
+        "blade root moment 1 z", "blade root moment 1 y", "blade root moment 1 x",
+        "maximum thrust", "collective pitch", "maximum pitch", "minimum pitch",
+        "demanded My", "demanded Mz", "maximum individual pitch",
+        "external pitch y", "external pitch z", "unused"
+    };
+    const char *outputNames[6] = {
+        "pitch 3", "individual pitch control>My", "tip-speed ratio",
+        "rotor speed", "minimum pitch", "thrust limiter>minimum pitch"
+    };
+    ikReplay replay;
+    ikReplayParams params;
+    ikFarm farm;
+    ikFarmParams farmParams;
+    double inputs[23];
+    double outputs[6];
+    double expected[6];
+    int err;
+    int i;
+    int j;
+    int k;
+
+    ikReplay_initParams(&params);
+    initTurbineParams(&(params.turbine));
+    params.nChannels = 23;
+    params.channels = channels;
+    params.nOutputs = 6;
+    params.outputs = outputNames;
+    err = ikReplay_init(&replay, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testReplay (ikReplay_test) message=init expected to return 0, but returned %d\n", err);
+    ikFarm_initParams(&farmParams);
+    initTurbineParams(&(farmParams.turbine));
+    err = ikFarm_init(&farm, &farmParams);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testReplay (ikReplay_test) message=farm init expected to return 0, but returned %d\n", err);
+
+    for (k = 0; k < NSTEPS; k++) {
+        inputs[0] = 0.01 * k;
+        inputs[1] = fmod(7.0 * k, 360.0);
+        inputs[2] = 40.0 + 5.0 * sin(0.03 * k);
+        inputs[3] = 120.0 + 10.0 * sin(0.01 * k);
+        for (j = 4; j < 13; j++) inputs[j] = 100.0 * sin(0.05 * k + 0.3 * j);
+        inputs[13] = 500.0;
+        inputs[14] = 2.0 + sin(0.02 * k);
+        inputs[15] = 90.0;
+        inputs[16] = 0.0;
+        inputs[17] = 10.0 * sin(0.02 * k);
+        inputs[18] = 10.0 * cos(0.02 * k);
+        inputs[19] = 5.0;
+        inputs[20] = 0.5 * cos(0.01 * k);
+        inputs[21] = 0.5 * sin(0.01 * k);
+        inputs[22] = 1e9;
+        ikReplay_step(&replay, inputs, outputs);
+
+        farm.in.azimuth[0] = inputs[1];
+        farm.in.generatorTorque[0] = inputs[2];
+        farm.in.generatorSpeed[0] = inputs[3];
+        for (i = 0; i < 3; i++) {
+            for (j = 0; j < 3; j++) farm.in.bladeRootMoments[i][j][0] = inputs[12 - 3*i - j];
+        }
+        farm.in.maximumThrust[0] = inputs[13];
+        farm.in.collectivePitch[0] = inputs[14];
+        farm.in.maximumPitch[0] = inputs[15];
+        farm.in.minimumPitch[0] = inputs[16];
+        farm.in.demandedMy[0] = inputs[17];
+        farm.in.demandedMz[0] = inputs[18];
+        farm.in.maximumIndividualPitch[0] = inputs[19];
+        farm.in.externalPitchY[0] = inputs[20];
+        farm.in.externalPitchZ[0] = inputs[21];
+        ikFarm_step(&farm);
+        expected[0] = farm.out.pitch[2][0];
+        ikFarm_getOutput(&farm, &(expected[1]), 0, "individual pitch control>My");
+        expected[2] = farm.out.tipSpeedRatio[0];
+        expected[3] = farm.out.rotorSpeed[0];
+        expected[4] = farm.out.minimumPitch[0];
+        ikFarm_getOutput(&farm, &(expected[5]), 0, "thrust limiter>minimum pitch");
+
+        for (i = 0; i < 6; i++) {
+            if (outputs[i] != expected[i]) printf("%%TEST_FAILED%% time=0 testname=testReplay (ikReplay_test) message=%s at step %d expected to be %.17g, but is %.17g\n", outputNames[i], k, expected[i], outputs[i]);
+        }
+    }
+    ikReplay_delete(&replay);
+    ikFarm_delete(&farm);
+}
+
+/**
+ * bad parameters result in the right error codes
+ */
+void testInitErrors() {
+    printf("ikReplay_test testInitErrors\n");
+    const char *channels[1] = {"azimuth"};
+    const char *outputs[2] = {"pitch 1", "individual pitch control>Mx"};
+    ikReplay replay;
+    ikReplayParams params;
+    int err;
+
+    /* -1 for bad numbers of channels or outputs */
+    ikReplay_initParams(&params);
+    initTurbineParams(&(params.turbine));
+    params.nChannels = -1;
+    err = ikReplay_init(&replay, &params);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikReplay_test) message=init expected to return -1, but returned %d\n", err);
+    params.nChannels = 0;
+    params.nOutputs = -1;
+    err = ikReplay_init(&replay, &params);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikReplay_test) message=init expected to return -1, but returned %d\n", err);
+
+    /* -2 for bad controller parameters */
+    ikReplay_initParams(&params);
+    initTurbineParams(&(params.turbine));
+    params.turbine.ipc.nBlades = 2;
+    err = ikReplay_init(&replay, &params);
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikReplay_test) message=init expected to return -2, but returned %d\n", err);
+
+    /* -4 for bad output names */
+    ikReplay_initParams(&params);
+    initTurbineParams(&(params.turbine));
+    params.nChannels = 1;
+    params.channels = channels;
+    params.nOutputs = 2;
+    params.outputs = outputs;
+    err = ikReplay_init(&replay, &params);
+    if (-4 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikReplay_test) message=init expected to return -4, but returned %d\n", err);
+    params.nOutputs = 1;
+    err = ikReplay_init(&replay, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikReplay_test) message=init expected to return 0, but returned %d\n", err);
+    ikReplay_delete(&replay);
+}
+
+/**
+ * A replay resumed from a checkpoint continues exactly as the original
+ */
+void testCheckpoint() {
+    printf("ikReplay_test testCheckpoint\n");
+    const char *channels[6] = {
+        "azimuth", "generator torque", "generator speed", "blade root moment 1 y",
+        "collective pitch", "maximum individual pitch"
+    };
+    const char *outputNames[3] = {"pitch 1", "rotor speed", "individual pitch control>My"};
+    ikReplay replay;
+    ikReplay resumed;
+    ikReplayParams params;
+    double inputs[6];
+    double outputs[NSTEPS][3];
+    double output[3];
+    unsigned char *blob;
+    size_t size;
+    int nDiffering = 0;
+    int err;
+    int i;
+    int k;
+
+    ikReplay_initParams(&params);
+    initTurbineParams(&(params.turbine));
+    params.nChannels = 6;
+    params.channels = channels;
+    params.nOutputs = 3;
+    params.outputs = outputNames;
+    ikReplay_init(&replay, &params);
+    ikReplay_init(&resumed, &params);
+
+    /* replay the whole log, saving the state half way */
+    blob = NULL;
+    size = 0;
+    for (k = 0; k < NSTEPS; k++) {
+        if (NSTEPS/2 == k) {
+            ikReplay_saveState(&replay, NULL, 0, &size);
+            blob = (unsigned char *) malloc(size);
+            err = ikReplay_saveState(&replay, blob, size, &size);
+            if (err) printf("%%TEST_FAILED%% time=0 testname=testCheckpoint (ikReplay_test) message=saveState expected to return 0, but returned %d\n", err);
+        }
+        inputs[0] = fmod(7.0 * k, 360.0);
+        inputs[1] = 40.0 + 5.0 * sin(0.03 * k);
+        inputs[2] = 120.0 + 10.0 * sin(0.01 * k);
+        inputs[3] = 1000.0 * sin(0.05 * k);
+        inputs[4] = 2.0 + sin(0.02 * k);
+        inputs[5] = 5.0;
+        ikReplay_step(&replay, inputs, outputs[k]);
+    }
+
+    /* resume the second half in another instance */
+    err = ikReplay_restoreState(&resumed, blob, size);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testCheckpoint (ikReplay_test) message=restoreState expected to return 0, but returned %d\n", err);
+    for (k = NSTEPS/2; k < NSTEPS; k++) {
+        inputs[0] = fmod(7.0 * k, 360.0);
+        inputs[1] = 40.0 + 5.0 * sin(0.03 * k);
+        inputs[2] = 120.0 + 10.0 * sin(0.01 * k);
+        inputs[3] = 1000.0 * sin(0.05 * k);
+        inputs[4] = 2.0 + sin(0.02 * k);
+        inputs[5] = 5.0;
+        ikReplay_step(&resumed, inputs, output);
+        for (i = 0; i < 3; i++) nDiffering += (outputs[k][i] != output[i]);
+    }
+    if (nDiffering) printf("%%TEST_FAILED%% time=0 testname=testCheckpoint (ikReplay_test) message=expected the same outputs after resuming, but %d differed\n", nDiffering);
+
+    /* a blob of another class is rejected */
+    err = ikReplay_restoreState(&resumed, "IKCP", 4);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testCheckpoint (ikReplay_test) message=restoreState expected to return -1 for a short blob, but returned %d\n", err);
+    memcpy(blob + 8, "ikFarm", 7);
+    err = ikReplay_restoreState(&resumed, blob, size);
+    if (-4 != err) printf("%%TEST_FAILED%% time=0 testname=testCheckpoint (ikReplay_test) message=restoreState expected to return -4 for another class, but returned %d\n", err);
+
+    free(blob);
+    ikReplay_delete(&replay);
+    ikReplay_delete(&resumed);
+}
+
+int main(int argc, char** argv) {
+    printf("%%SUITE_STARTING%% ikReplay_test\n");
+    printf("%%SUITE_STARTED%%\n");
+
+    if (ikTestUtil_writeSurfaces("ikReplay_test_cp.bin", "ikReplay_test_ct.bin")) printf("%%TEST_FAILED%% time=0 testname=surfaces (ikReplay_test) message=could not write surface files\n");
+
+    printf("%%TEST_STARTED%% testReplay (ikReplay_test)\n");
+    testReplay();
+    printf("%%TEST_FINISHED%% time=0 testReplay (ikReplay_test) \n");
+
+    printf("%%TEST_STARTED%% testInitErrors (ikReplay_test)\n");
+    testInitErrors();
+    printf("%%TEST_FINISHED%% time=0 testInitErrors (ikReplay_test) \n");
+
+    printf("%%TEST_STARTED%% testCheckpoint (ikReplay_test)\n");
+    testCheckpoint();
+    printf("%%TEST_FINISHED%% time=0 testCheckpoint (ikReplay_test) \n");
+
+    remove("ikReplay_test_cp.bin");
+    remove("ikReplay_test_ct.bin");
+
+    printf("%%SUITE_FINISHED%% time=0\n");
+
+    return (EXIT_SUCCESS);
+}
@@ -31,10 +31,14 @@ along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
 #include "ikSensorDiagnoser.h"
 
 void ikSensorDiagnoser_initParams(ikSensorDiagnoserParams *params) {
+    int i;
     
     /* set default parameter values */
     params->nStepsToFault = 1;
     params->tolerance = 1.0;
+    params->nSignals = 3;
+    params->fusion = 0;
+    for (i = 0; i < IKSENSORDIAGNOSER_MAXSIGNALS; i++) params->weights[i] = 1.0;
 }
 
 int ikSensorDiagnoser_init(ikSensorDiagnoser *self, const ikSensorDiagnoserParams *params) {
@@ -54,44 +58,193 @@ int ikSensorDiagnoser_init(ikSensorDiagnoser *self, const ikSensorDiagnoserParam
         self->tol = 1.0;
         if (!err) err = -2;
     }
+    if ((2 <= params->nSignals) && (IKSENSORDIAGNOSER_MAXSIGNALS >= params->nSignals)) {
+        self->nSignals = params->nSignals;
+    } else {
+        self->nSignals = 3;
+        if (!err) err = -3;
+    }
+    if ((0 == params->fusion) || (1 == params->fusion)) {
+        self->fusion = params->fusion;
+    } else {
+        self->fusion = 0;
+        if (!err) err = -4;
+    }
+    for (i = 0; i < IKSENSORDIAGNOSER_MAXSIGNALS; i++) {
+        if (0.0 <= params->weights[i]) {
+            self->weights[i] = params->weights[i];
+        } else {
+            self->weights[i] = 1.0;
+            if (!err && (i < self->nSignals)) err = -5;
+        }
+    }
+    self->fused = 0.0;
     
     /* initilise fault states */
-    for (i = 0; i < 3; i++) self->ok[i] = self->n;
+    for (i = 0; i < IKSENSORDIAGNOSER_MAXSIGNALS; i++) self->ok[i] = self->n;
     
     return err;
 }
 
-void ikSensorDiagnoser_step(ikSensorDiagnoser *self, int ok[3], const double signals[3]) {
+/**
+ * (Private) check tolerances among any number of signals, by sorting those
+ * not yet deemed faulty and comparing each one with its neighbours, which
+ * are the closest to it
+ * @param self instance
+ * @param _ok output array: 1 for signals within tolerance of another one
+ * @param signals sensor signals
+ */
+void ikSensorDiagnoser_checkSorted(const ikSensorDiagnoser *self, int _ok[], const double signals[]) {
+    int i, j, k;
+    int n = 0;
+    int idx[IKSENSORDIAGNOSER_MAXSIGNALS];
+    
+    /* sort the indices of the signals not yet deemed faulty, by insertion, */
+    /* leaving out NaN values, which are never within tolerance */
+    for (i = 0; i < self->nSignals; i++) {
+        if (!self->ok[i] || (signals[i] != signals[i])) continue;
+        for (k = n; (k > 0) && (signals[idx[k-1]] > signals[i]); k--) idx[k] = idx[k-1];
+        idx[k] = i;
+        n++;
+    }
+    
+    /* compare neighbours */
+    for (k = 1; k < n; k++) {
+        i = idx[k-1];
+        j = idx[k];
+        if (self->tol > signals[j] - signals[i]) {
+            _ok[i] = 1;
+            _ok[j] = 1;
+        }
+    }
+}
+
+/**
+ * (Private) update the fault states
+ * @param self instance
+ * @param signals sensor signals
+ */
+void ikSensorDiagnoser_diagnose(ikSensorDiagnoser *self, const double signals[]) {
     int i,j;
-    int _ok[3] = {0,0,0};
+    int _ok[IKSENSORDIAGNOSER_MAXSIGNALS] = {0};
     
     /* check tolerances */
-    for(i = 0; i < 3; i++) {
-        j = i + 1;
-        if(j > 2) j = 0;
-        if(self->tol > fabs(signals[i] - signals[j])) {
-            if (self->ok[i] && self->ok[j]) {
-                _ok[i] = 1;
-                _ok[j] = 1;
+    switch (self->nSignals) {
+        case 3:
+            for(i = 0; i < 3; i++) {
+                j = i + 1;
+                if(j > 2) j = 0;
+                if(self->tol > fabs(signals[i] - signals[j])) {
+                    if (self->ok[i] && self->ok[j]) {
+                        _ok[i] = 1;
+                        _ok[j] = 1;
+                    }
+                }
             }
-        }
+            break;
+        case 2:
+            if ((self->tol > fabs(signals[0] - signals[1])) && self->ok[0] && self->ok[1]) {
+                _ok[0] = 1;
+                _ok[1] = 1;
+            }
+            break;
+        default:
+            ikSensorDiagnoser_checkSorted(self, _ok, signals);
     }
     
     /* compute steps left for fault detection */
-    for(i = 0; i < 3; i++) {
+    for(i = 0; i < self->nSignals; i++) {
         self->ok[i]--;
         self->ok[i] = self->ok[i] > 0 ? self->ok[i] : 0;
         if (_ok[i]) self->ok[i] = self->n;
     }
+}
+
+/**
+ * (Private) fuse the signals deemed sound, leaving out NaN values
+ * @param self instance
+ * @param signals sensor signals
+ */
+void ikSensorDiagnoser_fuse(ikSensorDiagnoser *self, const double signals[]) {
+    int i, k;
+    int n = 0;
+    double values[IKSENSORDIAGNOSER_MAXSIGNALS];
+    double sum = 0.0;
+    double weightSum = 0.0;
+    double lo, hi;
+    
+    /* weighted average */
+    if (1 == self->fusion) {
+        for (i = 0; i < self->nSignals; i++) {
+            if (!self->ok[i] || (signals[i] != signals[i])) continue;
+            sum += self->weights[i]*signals[i];
+            weightSum += self->weights[i];
+        }
+        if (0.0 < weightSum) self->fused = sum/weightSum;
+        return;
+    }
+    
+    /* mid-value selection, directly for up to 3 values, and by sorting them */
+    /* by insertion for more */
+    for (i = 0; i < self->nSignals; i++) {
+        if (!self->ok[i] || (signals[i] != signals[i])) continue;
+        values[n++] = signals[i];
+    }
+    switch (n) {
+        case 0:
+            break;
+        case 1:
+            self->fused = values[0];
+            break;
+        case 2:
+            self->fused = 0.5*(values[0] + values[1]);
+            break;
+        case 3:
+            lo = values[0] < values[1] ? values[0] : values[1];
+            hi = values[0] < values[1] ? values[1] : values[0];
+            hi = hi < values[2] ? hi : values[2];
+            self->fused = lo > hi ? lo : hi;
+            break;
+        default:
+            for (i = 1; i < n; i++) {
+                sum = values[i];
+                for (k = i; (k > 0) && (values[k-1] > sum); k--) values[k] = values[k-1];
+                values[k] = sum;
+            }
+            self->fused = n % 2 ? values[n/2] : 0.5*(values[n/2 - 1] + values[n/2]);
+    }
+}
+
+double ikSensorDiagnoser_step(ikSensorDiagnoser *self, int ok[], const double signals[]) {
+    
+    /* diagnose and fuse */
+    ikSensorDiagnoser_diagnose(self, signals);
+    ikSensorDiagnoser_fuse(self, signals);
     
     /* set outputs */
     ikSensorDiagnoser_getOutput(self, ok);
+    return self->fused;
+}
+
+void ikSensorDiagnoser_steps(ikSensorDiagnoser *self, int nSteps, int ok[], double fused[], const double signals[]) {
+    int k;
+    
+    for (k = 0; k < nSteps; k++) {
+        ikSensorDiagnoser_diagnose(self, signals + k*self->nSignals);
+        ikSensorDiagnoser_fuse(self, signals + k*self->nSignals);
+        if (NULL != ok) ikSensorDiagnoser_getOutput(self, ok + k*self->nSignals);
+        if (NULL != fused) fused[k] = self->fused;
+    }
 }
 
-void ikSensorDiagnoser_getOutput(const ikSensorDiagnoser *self, int ok[3]) {
+void ikSensorDiagnoser_getOutput(const ikSensorDiagnoser *self, int ok[]) {
     int i;
     
-    for(i = 0; i < 3; i++) ok[i] = self->ok[i] > 0;
+    for(i = 0; i < self->nSignals; i++) ok[i] = self->ok[i] > 0;
+}
+
+double ikSensorDiagnoser_getFusedOutput(const ikSensorDiagnoser *self) {
+    return self->fused;
 }
 
 /* @endcond */
@@ -30,6 +30,8 @@ along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
 extern "C" {
 #endif
 
+#define IKSENSORDIAGNOSER_MAXSIGNALS 16
+
     /**
      * @struct ikSensorDiagnoser
      * @brief Sensor diagnoser based on 3-way comparison
@@ -38,23 +40,54 @@ extern "C" {
      * They take 3 different sensor signals for a single physical quantity and
      * decide, based on their differences over time, which are sound.
      * 
+     * More generally, they take any number of redundant signals, between 2
+     * and @link IKSENSORDIAGNOSER_MAXSIGNALS @endlink, as set via
+     * @link ikSensorDiagnoserParams.nSignals @endlink. On each step, a signal
+     * is confirmed sound if it is within tolerance of any other signal, both
+     * of them not yet deemed faulty. A signal not confirmed sound for
+     * @link ikSensorDiagnoserParams.nStepsToFault @endlink steps in a row is
+     * deemed faulty, for good. For 3 signals, this amounts to the 3-way
+     * comparison. For 2 and 3 signals the pairs are compared directly, and
+     * for more the signals are sorted first, so that each one need only be
+     * compared with its neighbours.
+     * 
+     * The signals deemed sound are also fused into a single one, by one of
+     * two methods, as set via @link ikSensorDiagnoserParams.fusion @endlink:
+     * @li mid-value selection: the median of the sound signals, or the mean
+     * of the two middle ones if there is an even number of them
+     * @li weighted average: the average of the sound signals, weighted by
+     * @link ikSensorDiagnoserParams.weights @endlink
+     * 
+     * NaN values are left out. If no value is left, or their weights add up
+     * to 0, the fused signal keeps its last value, which is initially 0.
+     * 
+     * Time series of logged signals may be diagnosed and fused in one call
+     * to @link ikSensorDiagnoser_steps @endlink.
+     * 
      * @par Inputs
      * @li signals: sensor signals, specify via @link ikSensorDiagnoser_step @endlink
      * 
      * @par Outputs
      * @li diagnosis: 1 for sound sensors, 0 for faulty ones, get via @link ikSensorDiagnoser_step @endlink or @link ikSensorDiagnoser_getOutput @endlink
+     * @li fused signal: returned by @link ikSensorDiagnoser_step @endlink and @link ikSensorDiagnoser_getFusedOutput @endlink
      * 
      * @par Methods
      * @li @link ikSensorDiagnoser_initParams @endlink initialise initialisation parameter structure
      * @li @link ikSensorDiagnoser_init @endlink initialise an instance
      * @li @link ikSensorDiagnoser_step @endlink execute preriodic calculations
+     * @li @link ikSensorDiagnoser_steps @endlink execute periodic calculations for a time series
      * @li @link ikSensorDiagnoser_getOutput @endlink get last diagnosis
+     * @li @link ikSensorDiagnoser_getFusedOutput @endlink get last fused signal
      */
     typedef struct ikSensorDiagnoser {
         /* @cond */
-        int ok[3];
-        int n;
-        double tol;
+        int ok[IKSENSORDIAGNOSER_MAXSIGNALS]; /*steps left for fault detection */
+        int nSignals; /*number of signals */
+        int n; /*number of steps to fault */
+        double tol; /*tolerance */
+        int fusion; /*fusion method */
+        double weights[IKSENSORDIAGNOSER_MAXSIGNALS]; /*fusion weights */
+        double fused; /*fused signal */
         /* @endcond */
     } ikSensorDiagnoser;
     
@@ -65,6 +98,10 @@ extern "C" {
     typedef struct ikSensorDiagnoserParams {
         int nStepsToFault; /**<number of steps the difference between two signals must exceed tolerance to trigger a fault detection*/
         double tolerance; /**<tolerance*/
+        int nSignals; /**<number of signals, between 2 and @link IKSENSORDIAGNOSER_MAXSIGNALS @endlink. The default value is 3.*/
+        int fusion; /**<fusion method: 0 for mid-value selection, 1 for weighted average. The default value is 0.*/
+        double weights[IKSENSORDIAGNOSER_MAXSIGNALS]; /**<weights of the signals for the weighted average, non-negative.
+                                                       The default values are 1.0.*/
     } ikSensorDiagnoserParams;
     
     /**
@@ -81,23 +118,48 @@ extern "C" {
      * @li 0: no error
      * @li -1: invalid number of steps to fault, must be positive
      * @li -2: invalid tolerance, must be positive
+     * @li -3: invalid number of signals, must be between 2 and @link IKSENSORDIAGNOSER_MAXSIGNALS @endlink
+     * @li -4: invalid fusion method, must be 0 or 1
+     * @li -5: invalid weights, must be non-negative
      */
     int ikSensorDiagnoser_init(ikSensorDiagnoser *self, const ikSensorDiagnoserParams *params);
     
     /**
      * Execute periodic calculations
      * @param self instance
-     * @param ok output array: 1 for sound sensors, 0 for faulty ones
-     * @param signals sensor signals
+     * @param ok output array, of length nSignals: 1 for sound sensors, 0 for faulty ones
+     * @param signals sensor signals, array of length nSignals
+     * @return fused signal
      */
-    void ikSensorDiagnoser_step(ikSensorDiagnoser *self, int ok[3], const double signals[3]);
+    double ikSensorDiagnoser_step(ikSensorDiagnoser *self, int ok[], const double signals[]);
+    
+    /**
+     * Execute periodic calculations for a time series of signals, as
+     * @link ikSensorDiagnoser_step @endlink would if called for each step in
+     * turn. Meant for offline analysis of logged data.
+     * @param self instance
+     * @param nSteps number of steps
+     * @param ok output array, of length nSteps*nSignals, where ok[k*nSignals + i]
+     * is the diagnosis of sensor i at step k, or NULL
+     * @param fused output array, of length nSteps, for the fused signal at each step, or NULL
+     * @param signals sensor signals, array of length nSteps*nSignals, where
+     * signals[k*nSignals + i] is signal i at step k
+     */
+    void ikSensorDiagnoser_steps(ikSensorDiagnoser *self, int nSteps, int ok[], double fused[], const double signals[]);
     
     /**
      * Get last diagnosis
      * @param self instance
-     * @param ok output array: 1 for sound sensors, 0 for faulty ones
+     * @param ok output array, of length nSignals: 1 for sound sensors, 0 for faulty ones
+     */
+    void ikSensorDiagnoser_getOutput(const ikSensorDiagnoser *self, int ok[]);
+    
+    /**
+     * Get last fused signal
+     * @param self instance
+     * @return fused signal
      */
-    void ikSensorDiagnoser_getOutput(const ikSensorDiagnoser *self, int ok[3]);
+    double ikSensorDiagnoser_getFusedOutput(const ikSensorDiagnoser *self);
 
 
 #ifdef __cplusplus
@@ -25,7 +25,62 @@ along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
 #include "ikSensorDiagnoser.h"
+#include "ikTestUtil.h"
+
+/*
+ * Reference implementation: comparison of every pair of signals
+ */
+void referenceStep(int state[], int nSignals, int nStepsToFault, double tolerance, const double signals[]) {
+    int _ok[IKSENSORDIAGNOSER_MAXSIGNALS] = {0};
+    int i;
+    int j;
+    for (i = 0; i < nSignals; i++) {
+        for (j = i + 1; j < nSignals; j++) {
+            if ((tolerance > fabs(signals[i] - signals[j])) && state[i] && state[j]) {
+                _ok[i] = 1;
+                _ok[j] = 1;
+            }
+        }
+    }
+    for (i = 0; i < nSignals; i++) {
+        state[i] = state[i] > 1 ? state[i] - 1 : 0;
+        if (_ok[i]) state[i] = nStepsToFault;
+    }
+}
+
+/*
+ * Reference implementation: fusion of the sound signals, by sorting all of
+ * them or by weighting them
+ */
+double referenceFuse(double last, const int ok[], int nSignals, int fusion, const double weights[], const double signals[]) {
+    double values[IKSENSORDIAGNOSER_MAXSIGNALS];
+    double sum = 0.0;
+    double weightSum = 0.0;
+    double v;
+    int n = 0;
+    int i;
+    int j;
+    for (i = 0; i < nSignals; i++) {
+        if (!ok[i] || isnan(signals[i])) continue;
+        values[n++] = signals[i];
+        sum += weights[i] * signals[i];
+        weightSum += weights[i];
+    }
+    if (1 == fusion) return 0.0 < weightSum ? sum / weightSum : last;
+    if (!n) return last;
+    for (i = 0; i < n; i++) {
+        for (j = i + 1; j < n; j++) {
+            if (values[j] < values[i]) {
+                v = values[i];
+                values[i] = values[j];
+                values[j] = v;
+            }
+        }
+    }
+    return n % 2 ? values[n/2] : (values[n/2 - 1] + values[n/2]) / 2.0;
+}
 
 /*
  * Simple C Test Suite
@@ -344,6 +399,205 @@ void testGetOutput() {
     
 }
 
+/**
+ * any number of signals are diagnosed as by comparing every pair
+ */
+void testSignals() {
+    printf("ikSensorDiagnoser_test testSignals\n");
+    /* allocate instance */
+    ikSensorDiagnoser sd;
+    
+    /* allocate initialisation parameters */
+    ikSensorDiagnoserParams param;
+    
+    /* allocate error code */
+    int err;
+    
+    /* allocate inputs */
+    double signals[IKSENSORDIAGNOSER_MAXSIGNALS];
+    
+    /* allocate outputs */
+    int ok[IKSENSORDIAGNOSER_MAXSIGNALS + 1];
+    int state[IKSENSORDIAGNOSER_MAXSIGNALS];
+    
+    int nSignals;
+    int nFaulty;
+    int fails = 0;
+    int i;
+    int j;
+    int k;
+    
+    for (nSignals = 2; nSignals <= IKSENSORDIAGNOSER_MAXSIGNALS; nSignals++) {
+        for (j = 0; j < 20; j++) {
+            ikSensorDiagnoser_initParams(&param);
+            param.nSignals = nSignals;
+            param.nStepsToFault = 1 + j % 4;
+            err = ikSensorDiagnoser_init(&sd, &param);
+            if (err) printf("%%TEST_FAILED%% time=0 testname=testSignals (ikSensorDiagnoser_test) message=init expected to return 0 for %d signals, but returned %d\n", nSignals, err);
+            for (i = 0; i < nSignals; i++) state[i] = param.nStepsToFault;
+            
+            /* sensors drifting away from a common value, one at a time, */
+            /* with ties, duplicates and the odd NaN */
+            for (k = 0; k < 50; k++) {
+                for (i = 0; i < nSignals; i++) {
+                    signals[i] = floor(ikTestUtil_rand(0.0, 8.0)) * 0.25;
+                    if (i < k * nSignals / 40) signals[i] += ikTestUtil_rand(-10.0, 10.0);
+                }
+                if (0.05 > ikTestUtil_rand(0.0, 1.0)) signals[(int) ikTestUtil_rand(0.0, nSignals)] = sqrt(-1.0);
+                ok[nSignals] = -1;
+                ikSensorDiagnoser_step(&sd, ok, signals);
+                referenceStep(state, nSignals, param.nStepsToFault, param.tolerance, signals);
+                for (i = 0; i < nSignals; i++) {
+                    if ((ok[i] != (state[i] > 0)) && (fails++ < 5)) printf("%%TEST_FAILED%% time=0 testname=testSignals (ikSensorDiagnoser_test) message=step expected to return %d for sensor %d of %d at step %d, but returned %d\n", state[i] > 0, i, nSignals, k, ok[i]);
+                }
+                if (-1 != ok[nSignals]) printf("%%TEST_FAILED%% time=0 testname=testSignals (ikSensorDiagnoser_test) message=step expected to leave ok[%d] alone, but set it to %d\n", nSignals, ok[nSignals]);
+            }
+        }
+    }
+    
+    /* see that a single sound pair keeps 4 signals sound, and leaves the rest faulty */
+    ikSensorDiagnoser_initParams(&param);
+    param.nSignals = 4;
+    err = ikSensorDiagnoser_init(&sd, &param);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testSignals (ikSensorDiagnoser_test) message=init expected to return 0, but returned %d\n", err);
+    signals[0] = 3.0;
+    signals[1] = 0.0;
+    signals[2] = 6.0;
+    signals[3] = 0.5;
+    ikSensorDiagnoser_step(&sd, ok, signals);
+    nFaulty = 0;
+    for (i = 0; i < 4; i++) nFaulty += !ok[i];
+    if (!ok[1] || !ok[3] || (2 != nFaulty)) printf("%%TEST_FAILED%% time=0 testname=testSignals (ikSensorDiagnoser_test) message=step expected to return 0, 1, 0, 1, but returned %d, %d, %d, %d\n", ok[0], ok[1], ok[2], ok[3]);
+    
+}
+
+/**
+ * the sound signals are fused as specified
+ */
+void testFusion() {
+    printf("ikSensorDiagnoser_test testFusion\n");
+    /* allocate instance */
+    ikSensorDiagnoser sd;
+    
+    /* allocate initialisation parameters */
+    ikSensorDiagnoserParams param;
+    
+    /* allocate error code */
+    int err;
+    
+    /* allocate inputs */
+    double signals[IKSENSORDIAGNOSER_MAXSIGNALS];
+    
+    /* allocate outputs */
+    int ok[IKSENSORDIAGNOSER_MAXSIGNALS];
+    double fused;
+    double expected;
+    
+    int nSignals;
+    int fusion;
+    int fails = 0;
+    int i;
+    int j;
+    int k;
+    
+    for (nSignals = 2; nSignals <= IKSENSORDIAGNOSER_MAXSIGNALS; nSignals++) {
+        for (fusion = 0; fusion < 2; fusion++) {
+            for (j = 0; j < 10; j++) {
+                ikSensorDiagnoser_initParams(&param);
+                param.nSignals = nSignals;
+                param.nStepsToFault = 1 + j % 3;
+                param.fusion = fusion;
+                for (i = 0; i < nSignals; i++) param.weights[i] = floor(ikTestUtil_rand(0.0, 4.0));
+                err = ikSensorDiagnoser_init(&sd, &param);
+                if (err) printf("%%TEST_FAILED%% time=0 testname=testFusion (ikSensorDiagnoser_test) message=init expected to return 0, but returned %d\n", err);
+                expected = 0.0;
+                
+                /* sensors drifting away one at a time, with the odd NaN */
+                for (k = 0; k < 50; k++) {
+                    for (i = 0; i < nSignals; i++) {
+                        signals[i] = 5.0 + ikTestUtil_rand(-0.4, 0.4);
+                        if (i < k * nSignals / 40) signals[i] += ikTestUtil_rand(-10.0, 10.0);
+                    }
+                    if (0.1 > ikTestUtil_rand(0.0, 1.0)) signals[(int) ikTestUtil_rand(0.0, nSignals)] = sqrt(-1.0);
+                    fused = ikSensorDiagnoser_step(&sd, ok, signals);
+                    expected = referenceFuse(expected, ok, nSignals, fusion, param.weights, signals);
+                    if ((fabs(fused - expected) > 1e-12) && (fails++ < 5)) printf("%%TEST_FAILED%% time=0 testname=testFusion (ikSensorDiagnoser_test) message=step expected to return %.17g with %d signals, fusion %d, at step %d, but returned %.17g\n", expected, nSignals, fusion, k, fused);
+                    if (fused != ikSensorDiagnoser_getFusedOutput(&sd)) printf("%%TEST_FAILED%% time=0 testname=testFusion (ikSensorDiagnoser_test) message=getFusedOutput expected to return %.17g, but returned %.17g\n", fused, ikSensorDiagnoser_getFusedOutput(&sd));
+                }
+            }
+        }
+    }
+    
+    /* see that the mid value of 3 is selected, and held when all are faulty */
+    ikSensorDiagnoser_initParams(&param);
+    err = ikSensorDiagnoser_init(&sd, &param);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testFusion (ikSensorDiagnoser_test) message=init expected to return 0, but returned %d\n", err);
+    signals[0] = 5.2;
+    signals[1] = 5.0;
+    signals[2] = 5.1;
+    fused = ikSensorDiagnoser_step(&sd, ok, signals);
+    if (5.1 != fused) printf("%%TEST_FAILED%% time=0 testname=testFusion (ikSensorDiagnoser_test) message=step expected to return 5.1, but returned %f\n", fused);
+    signals[0] = 0.0;
+    signals[1] = 10.0;
+    signals[2] = 20.0;
+    fused = ikSensorDiagnoser_step(&sd, ok, signals);
+    if (5.1 != fused) printf("%%TEST_FAILED%% time=0 testname=testFusion (ikSensorDiagnoser_test) message=step expected to return 5.1, but returned %f\n", fused);
+    
+}
+
+/**
+ * time series are processed as step by step
+ */
+void testBatch() {
+    printf("ikSensorDiagnoser_test testBatch\n");
+    /* allocate instances */
+    ikSensorDiagnoser sd;
+    ikSensorDiagnoser sdBatch;
+    
+    /* allocate initialisation parameters */
+    ikSensorDiagnoserParams param;
+    
+    /* allocate error code */
+    int err;
+    
+    /* allocate inputs */
+    double signals[100*5];
+    
+    /* allocate outputs */
+    int ok[5];
+    int okBatch[100*5];
+    double fused;
+    double fusedBatch[100];
+    
+    int i;
+    int k;
+    
+    ikSensorDiagnoser_initParams(&param);
+    param.nSignals = 5;
+    param.nStepsToFault = 3;
+    err = ikSensorDiagnoser_init(&sd, &param);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testBatch (ikSensorDiagnoser_test) message=init expected to return 0, but returned %d\n", err);
+    err = ikSensorDiagnoser_init(&sdBatch, &param);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testBatch (ikSensorDiagnoser_test) message=init expected to return 0, but returned %d\n", err);
+    for (k = 0; k < 100; k++) {
+        for (i = 0; i < 5; i++) signals[k*5 + i] = 5.0 + ikTestUtil_rand(-0.6, 0.6) + (i < k / 20 ? 3.0 : 0.0);
+    }
+    
+    /* in two chunks, the first one without outputs */
+    ikSensorDiagnoser_steps(&sdBatch, 10, NULL, NULL, signals);
+    ikSensorDiagnoser_steps(&sdBatch, 90, okBatch + 10*5, fusedBatch + 10, signals + 10*5);
+    for (k = 0; k < 100; k++) {
+        fused = ikSensorDiagnoser_step(&sd, ok, signals + k*5);
+        if (10 > k) continue;
+        if (fused != fusedBatch[k]) printf("%%TEST_FAILED%% time=0 testname=testBatch (ikSensorDiagnoser_test) message=steps expected to return %.17g at step %d, but returned %.17g\n", fused, k, fusedBatch[k]);
+        for (i = 0; i < 5; i++) {
+            if (ok[i] != okBatch[k*5 + i]) printf("%%TEST_FAILED%% time=0 testname=testBatch (ikSensorDiagnoser_test) message=steps expected to return %d for sensor %d at step %d, but returned %d\n", ok[i], i, k, okBatch[k*5 + i]);
+        }
+    }
+    if (ikSensorDiagnoser_getFusedOutput(&sd) != ikSensorDiagnoser_getFusedOutput(&sdBatch)) printf("%%TEST_FAILED%% time=0 testname=testBatch (ikSensorDiagnoser_test) message=getFusedOutput expected to return %.17g, but returned %.17g\n", ikSensorDiagnoser_getFusedOutput(&sd), ikSensorDiagnoser_getFusedOutput(&sdBatch));
+    
+}
+
 /**
  * bad parameters result in the right error codes
  */
@@ -370,6 +624,27 @@ void testInitErrors() {
     err = ikSensorDiagnoser_init(&sd, &param);
     if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikSensorDiagnoser_test) message=init expected to return -2, but returned %d\n", err);
     
+    /* -3 for bad number of signals */
+    ikSensorDiagnoser_initParams(&param);
+    param.nSignals = 1;
+    err = ikSensorDiagnoser_init(&sd, &param);
+    if (-3 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikSensorDiagnoser_test) message=init expected to return -3, but returned %d\n", err);
+    param.nSignals = IKSENSORDIAGNOSER_MAXSIGNALS + 1;
+    err = ikSensorDiagnoser_init(&sd, &param);
+    if (-3 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikSensorDiagnoser_test) message=init expected to return -3, but returned %d\n", err);
+    
+    /* -4 for bad fusion method */
+    ikSensorDiagnoser_initParams(&param);
+    param.fusion = 2;
+    err = ikSensorDiagnoser_init(&sd, &param);
+    if (-4 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikSensorDiagnoser_test) message=init expected to return -4, but returned %d\n", err);
+    
+    /* -5 for bad weights */
+    ikSensorDiagnoser_initParams(&param);
+    param.weights[2] = -1.0;
+    err = ikSensorDiagnoser_init(&sd, &param);
+    if (-5 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikSensorDiagnoser_test) message=init expected to return -5, but returned %d\n", err);
+    
 }
 
 int main(int argc, char** argv) {
@@ -392,6 +667,18 @@ int main(int argc, char** argv) {
     testGetOutput();
     printf("%%TEST_FINISHED%% time=0 testGetOutput (ikSensorDiagnoser_test) \n");
 
+    printf("%%TEST_STARTED%% testSignals (ikSensorDiagnoser_test)\n");
+    testSignals();
+    printf("%%TEST_FINISHED%% time=0 testSignals (ikSensorDiagnoser_test) \n");
+
+    printf("%%TEST_STARTED%% testFusion (ikSensorDiagnoser_test)\n");
+    testFusion();
+    printf("%%TEST_FINISHED%% time=0 testFusion (ikSensorDiagnoser_test) \n");
+
+    printf("%%TEST_STARTED%% testBatch (ikSensorDiagnoser_test)\n");
+    testBatch();
+    printf("%%TEST_FINISHED%% time=0 testBatch (ikSensorDiagnoser_test) \n");
+
     printf("%%TEST_STARTED%% testInitErrors (ikSensorDiagnoser_test)\n");
     testInitErrors();
     printf("%%TEST_FINISHED%% time=0 testInitErrors (ikSensorDiagnoser_test) \n");
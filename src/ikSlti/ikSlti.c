@@ -28,17 +28,53 @@ along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
 #include <math.h>
 #include "ikSlti.h"
 
+/**
+ * (Private) compute the transposed direct form II state from the buffers
+ */
+void ikSlti_resetState(ikSlti *self) {
+    double x0 = self->inBuff[self->pos];
+    double y0 = self->outBuff[self->pos];
+    double x1 = self->inBuff[(self->pos + 1) % 3];
+    double y1 = self->outBuff[(self->pos + 1) % 3];
+    
+    self->state[0] = self->bn[1] * x0 - self->an[1] * y0 + self->bn[2] * x1 - self->an[2] * y1;
+    self->state[1] = self->bn[2] * x0 - self->an[2] * y0;
+}
+
+/**
+ * (Private) count a run of saturated steps which has just ended
+ */
+void ikSlti_countRun(ikSlti *self) {
+#ifdef IKSLTI_NSATHIST
+    int k = 0;
+    long n = self->satRun;
+    while ((1 < n) && (IKSLTI_NSATHIST - 1 > k)) {
+        n >>= 1;
+        k++;
+    }
+    self->satCounts.runs[k]++;
+#endif
+    self->satRun = 0;
+}
+
 void ikSlti_init(ikSlti *self) {    
     /*set member values */
     int i;
     for (i = 0; i < 3; i++) {
         self->a[i] = 0.0;
         self->b[i] = 0.0;
+        self->an[i] = 0.0;
+        self->bn[i] = 0.0;
         self->inBuff[i] = 0.0;
         self->outBuff[i] = 0.0;
     }
     self->a[0] = 1.0;
     self->b[0] = 1.0;
+    self->an[0] = 1.0;
+    self->bn[0] = 1.0;
+    self->pos = 0;
+    self->state[0] = 0.0;
+    self->state[1] = 0.0;
     self->suma = 1.0;
     self->sumb = 1.0;
     self->inSat = 0;
@@ -47,6 +83,13 @@ void ikSlti_init(ikSlti *self) {
     self->inMax = 0.0;
     self->outMin = 0.0;
     self->outMax = 0.0;
+    self->satCounts.inputSaturations = 0;
+    self->satCounts.outputSaturations = 0;
+    self->satCounts.saturatedSteps = 0;
+#ifdef IKSLTI_NSATHIST
+    for (i = 0; i < IKSLTI_NSATHIST; i++) self->satCounts.runs[i] = 0;
+#endif
+    self->satRun = 0;
 }
 
 int ikSlti_setParam(ikSlti *self, const double a[], const double b[]) {  
@@ -64,6 +107,15 @@ int ikSlti_setParam(ikSlti *self, const double a[], const double b[]) {
         self->suma += a[i];
         self->sumb += b[i];
     }
+    
+    /*normalise, so that a[0] == 1 and step does not divide */
+    for (i = 0; i < 3; i++) {
+        self->an[i] = a[i] / a[0];
+        self->bn[i] = b[i] / a[0];
+    }
+    
+    /*make the state consistent with the buffers and the new parameters */
+    ikSlti_resetState(self);
     return 0;
 }
 
@@ -74,6 +126,10 @@ void ikSlti_setBuff(ikSlti *self, const double inBuff[], const double outBuff[])
         self->inBuff[i] = inBuff[i];
         self->outBuff[i] = outBuff[i];
     }
+    self->pos = 0;
+    
+    /*make the state consistent with the buffers */
+    ikSlti_resetState(self);
 }
 
 void ikSlti_getParam(const ikSlti *self, double a[], double b[]) {
@@ -86,11 +142,11 @@ void ikSlti_getParam(const ikSlti *self, double a[], double b[]) {
 }
 
 void ikSlti_getBuff(const ikSlti *self, double inBuff[], double outBuff[]) {
-    /*copy self->inBuff and self-outBuff values */
+    /*copy self->inBuff and self-outBuff values, latest first */
     int i;
     for (i = 0; i < 3; i++) {
-        inBuff[i] = self->inBuff[i];
-        outBuff[i] = self->outBuff[i];
+        inBuff[i] = self->inBuff[(self->pos + i) % 3];
+        outBuff[i] = self->outBuff[(self->pos + i) % 3];
     }
 }
 
@@ -146,55 +202,169 @@ int ikSlti_getOutSat(const ikSlti *self, double *min, double *max) {
 
 double ikSlti_step(ikSlti *self, double input) {
     int i;
+    int sat = 0;
+    int inSat = 0;
+    double x = input;
+    double y;
     
-    /*move old values down the buffers */
-    for (i = 2; i > 0; i--) {
-        self->inBuff[i] = self->inBuff[i-1];
-        self->outBuff[i] =self->outBuff[i-1];
-    }
-    
-    /*register new input */
-    self->inBuff[0] = input;
+    /*move to the next position in the circular buffers */
+    self->pos = (0 == self->pos) ? 2 : self->pos - 1;
     
     /*apply input saturation */
-    if ((-1 == self->inSat) || (2 == self->inSat)) 
-        if (self->inMin > self->inBuff[0]) self->inBuff[0] = self->inMin;
-    if ((1 == self->inSat) || (2 == self->inSat))
-        if (self->inMax < self->inBuff[0]) self->inBuff[0] = self->inMax;
+    if ((-1 == self->inSat) || (2 == self->inSat)) {
+        if (self->inMin > x) {
+            x = self->inMin;
+            inSat = 1;
+        }
+    }
+    if ((1 == self->inSat) || (2 == self->inSat)) {
+        if (self->inMax < x) {
+            x = self->inMax;
+            inSat = 1;
+        }
+    }
+    if (inSat) self->satCounts.inputSaturations++;
     
     /*compute new output value */
-    self->outBuff[0] = self->b[0] * self->inBuff[0];
-    for (i = 1; i < 3; i++) {
-        self->outBuff[0] -= self->a[i] * self->outBuff[i];
-        self->outBuff[0] += self->b[i] * self->inBuff[i];
-    }
-    self->outBuff[0] = self->outBuff[0] / self->a[0];
+    y = self->bn[0] * x + self->state[0];
     
     /*apply output saturation */
     if ((-1 == self->outSat) || (2 == self->outSat)) {
-        if (self->outMin > self->outBuff[0]) {
-            for (i = 0; i < 3; i++) {
-                self->outBuff[i] = self->outMin;
-                if (0.0 != self->sumb) self->inBuff[i] = self->outMin/self->sumb*self->suma;
-            }
+        if (self->outMin > y) {
+            y = self->outMin;
+            sat = 1;
         }
     }
     if ((1 == self->outSat) || (2 == self->outSat)) {
-        if (self->outMax < self->outBuff[0]) {
-            for (i = 0; i < 3; i++) {
-                self->outBuff[i] = self->outMax;
-                if (0.0 != self->sumb) self->inBuff[i] = self->outMax/self->sumb*self->suma;
-	    }
-	}
+        if (self->outMax < y) {
+            y = self->outMax;
+            sat = 1;
+        }
+    }
+    
+    /*register new input and output */
+    self->inBuff[self->pos] = x;
+    self->outBuff[self->pos] = y;
+    
+    /*count saturated steps, and the runs of them */
+    if (sat || inSat) {
+        self->satCounts.saturatedSteps++;
+        self->satRun++;
+    } else if (self->satRun) {
+        ikSlti_countRun(self);
+    }
+    
+    if (sat) {
+        /*reset the buffers and the state to the saturation limit */
+        self->satCounts.outputSaturations++;
+        for (i = 0; i < 3; i++) {
+            self->outBuff[i] = y;
+            if (0.0 != self->sumb) self->inBuff[i] = y/self->sumb*self->suma;
+        }
+        ikSlti_resetState(self);
+    } else {
+        /*update state */
+        self->state[0] = self->bn[1] * x - self->an[1] * y + self->state[1];
+        self->state[1] = self->bn[2] * x - self->an[2] * y;
     }
     
     /*return new output */
-    return self->outBuff[0];
+    return y;
+}
+
+void ikSlti_getSatCounts(const ikSlti *self, ikSltiSatCounts *counts) {
+    *counts = self->satCounts;
 }
 
 double ikSlti_getOutput(const ikSlti *self) {
     /*return value */
-    return self->outBuff[0];
+    return self->outBuff[self->pos];
+}
+
+void ikSlti_checkpoint(ikSlti *self, ikCheckpoint *cp) {
+    int i;
+    double inBuff[3];
+    double outBuff[3];
+    
+    /*buffers, latest first, and state */
+    ikSlti_getBuff(self, inBuff, outBuff);
+    for (i = 0; i < 3; i++) {
+        ikCheckpoint_double(cp, &(inBuff[i]));
+        ikCheckpoint_double(cp, &(outBuff[i]));
+    }
+    if (ikCheckpoint_isRestoring(cp)) ikSlti_setBuff(self, inBuff, outBuff);
+    ikCheckpoint_double(cp, &(self->state[0]));
+    ikCheckpoint_double(cp, &(self->state[1]));
+    
+    /*saturation event counters */
+    ikCheckpoint_long(cp, &(self->satCounts.inputSaturations));
+    ikCheckpoint_long(cp, &(self->satCounts.outputSaturations));
+    ikCheckpoint_long(cp, &(self->satCounts.saturatedSteps));
+    ikCheckpoint_long(cp, &(self->satRun));
+#ifdef IKSLTI_NSATHIST
+    ikCheckpoint_check(cp, IKSLTI_NSATHIST);
+    for (i = 0; i < IKSLTI_NSATHIST; i++) ikCheckpoint_long(cp, &(self->satCounts.runs[i]));
+#else
+    ikCheckpoint_check(cp, 0);
+#endif
+}
+
+void ikSlti_freqResp(const ikSlti *self, int n, const double w[], double re[], double im[]) {
+    int k;
+    for (k = 0; k < n; k++) {
+        re[k] = 1.0;
+        im[k] = 0.0;
+    }
+    ikSlti_mulFreqResp(self, n, w, re, im);
+}
+
+void ikSlti_mulFreqResp(const ikSlti *self, int n, const double w[], double re[], double im[]) {
+    double z[4*IKSLTI_FREQBLOCK];
+    int k;
+    int m;
+
+    for (k = 0; k < n; k += IKSLTI_FREQBLOCK) {
+        m = (n - k < IKSLTI_FREQBLOCK) ? n - k : IKSLTI_FREQBLOCK;
+        ikSlti_delays(m, w + k, z);
+        ikSlti_mulFreqRespDelays(self, m, z, re + k, im + k);
+    }
+}
+
+void ikSlti_delays(int n, const double w[], double z[]) {
+    int k;
+    double c1, s1;
+
+    for (k = 0; k < n; k++) {
+        /*z^-1 and z^-2 on the unit circle */
+        c1 = cos(w[k]);
+        s1 = sin(w[k]);
+        z[4*k] = c1;
+        z[4*k + 1] = -s1;
+        z[4*k + 2] = c1*c1 - s1*s1;
+        z[4*k + 3] = -2.0*s1*c1;
+    }
+}
+
+void ikSlti_mulFreqRespDelays(const ikSlti *self, int n, const double z[], double re[], double im[]) {
+    int k;
+    double nr, ni, dr, di, d2;
+    double hr, hi, r;
+
+    for (k = 0; k < n; k++) {
+        /*numerator and denominator, with a[0] normalised to 1 */
+        nr = self->bn[0] + self->bn[1]*z[4*k] + self->bn[2]*z[4*k + 2];
+        ni = self->bn[1]*z[4*k + 1] + self->bn[2]*z[4*k + 3];
+        dr = 1.0 + self->an[1]*z[4*k] + self->an[2]*z[4*k + 2];
+        di = self->an[1]*z[4*k + 1] + self->an[2]*z[4*k + 3];
+        d2 = dr*dr + di*di;
+        hr = (nr*dr + ni*di) / d2;
+        hi = (ni*dr - nr*di) / d2;
+
+        /*multiply */
+        r = re[k];
+        re[k] = r*hr - im[k]*hi;
+        im[k] = r*hi + im[k]*hr;
+    }
 }
 
 /* @endcond */
@@ -30,6 +30,33 @@ along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
 extern "C" {
 #endif
 
+#include "ikCheckpoint.h"
+
+    /**
+     * Number of frequencies whose unit delays are worked out at a time, by
+     * @link ikSlti_delays @endlink, when getting the frequency response of a
+     * chain of systems
+     */
+#define IKSLTI_FREQBLOCK 64
+
+    /**
+     * @struct ikSltiSatCounts
+     * @brief Saturation event counters of a saturating linear time invariant system
+     * 
+     * If IKSLTI_NSATHIST is defined at compile time, the runs of consecutive
+     * saturated steps are also counted, by length, in a histogram of
+     * IKSLTI_NSATHIST bins.
+     */
+    typedef struct ikSltiSatCounts {
+        long inputSaturations; /**<number of steps with the input saturated*/
+        long outputSaturations; /**<number of steps with the output saturated, each of which resets the buffers to the saturation limit, as anti-windup*/
+        long saturatedSteps; /**<number of steps with the input or the output saturated*/
+#ifdef IKSLTI_NSATHIST
+        long runs[IKSLTI_NSATHIST]; /**<histogram of runs of saturated steps, once they have ended, with
+                                     those of 2^k to 2^(k+1)-1 steps in runs[k], and longer ones in the last bin*/
+#endif
+    } ikSltiSatCounts;
+
     /**
      * @struct ikSlti
      * @brief Saturating linear time invariant system
@@ -38,6 +65,12 @@ extern "C" {
      * linear time invariant single input single output systems with saturation
      * limits applied on input and output values.
      * 
+     * The parameters are normalised with respect to @f$a_0@f$ when they are
+     * set, and the system is implemented in transposed direct form II, with
+     * two state variables. The last 3 input and output values are also kept,
+     * in circular buffers, for @link ikSlti_getBuff @endlink and for the reset
+     * on output saturation.
+     * 
      * @par Inputs
      * @li input value: set via @link ikSlti_step @endlink
      * @li input saturation: set via @link ikSlti_setInSat @endlink
@@ -45,6 +78,7 @@ extern "C" {
      * 
      * @par Outputs
      * @li output value: returned by @link ikSlti_step @endlink and @link ikSlti_getOutput @endlink
+     * @li saturation event counters: get via @link ikSlti_getSatCounts @endlink
      * 
      * @par Unit block
      * 
@@ -66,16 +100,26 @@ extern "C" {
      * @li @link ikSlti_getOutSat @endlink get output saturation
      * @li @link ikSlti_step @endlink execute periodic calculations
      * @li @link ikSlti_getOutput @endlink get output value
+     * @li @link ikSlti_getSatCounts @endlink get saturation event counters
+     * @li @link ikSlti_freqResp @endlink get frequency response
+     * @li @link ikSlti_mulFreqResp @endlink multiply by frequency response
+     * @li @link ikSlti_delays @endlink get unit delays, for @link ikSlti_mulFreqRespDelays @endlink
+     * @li @link ikSlti_mulFreqRespDelays @endlink multiply by frequency response, at the given unit delays
+     * @li @link ikSlti_checkpoint @endlink save or restore runtime state
      */
     typedef struct ikSlti {
         /**
          * Private members
          */
         /* @cond */
-        double inBuff[3]; /*input buffer */
-        double outBuff[3]; /*output buffer */
-        double a[3]; /*denominator parameters */
-        double b[3]; /*numerator parameters */
+        double inBuff[3]; /*circular input buffer */
+        double outBuff[3]; /*circular output buffer */
+        int pos; /*position of the latest values in the buffers */
+        double state[2]; /*transposed direct form II state */
+        double a[3]; /*denominator parameters as set */
+        double b[3]; /*numerator parameters as set */
+        double an[3]; /*normalised denominator parameters */
+        double bn[3]; /*normalised numerator parameters */
         double suma; /*sum of a */
         double sumb; /*sum of b */
         int inSat; /*input saturation status flag */
@@ -84,6 +128,8 @@ extern "C" {
         double inMin; /*lower saturation limit for input */
         double outMax; /*upper saturation limit for output */
         double outMin; /*lower saturation limit for output */
+        ikSltiSatCounts satCounts; /*saturation event counters */
+        long satRun; /*number of consecutive saturated steps so far */
         /* @endcond */
     } ikSlti;
     
@@ -109,6 +155,8 @@ extern "C" {
      * @f]
      * 
      * This method sets the values of @f$a_i@f$ and @f$b_i@f$ of an instance.
+     * The buffers are kept, so the next output is calculated from the
+     * remembered input and output values with the new parameters.
      * 
      * @param self instance
      * @param a array of length 3 with denominator parameters, where @f$a_i@f$ = a[i] and a[0] must be non-zero
@@ -255,6 +303,92 @@ extern "C" {
      */
     double ikSlti_getOutput(const ikSlti *self);
 
+    /**
+     * get saturation event counters
+     * 
+     * The counters start at 0 on @link ikSlti_init @endlink, and are kept
+     * when the parameters, buffers or saturation limits are set.
+     * 
+     * @param self instance
+     * @param counts saturation event counters
+     */
+    void ikSlti_getSatCounts(const ikSlti *self, ikSltiSatCounts *counts);
+
+    /**
+     * save or restore runtime state
+     * 
+     * The runtime state is made up by the buffers, the state variables and
+     * the saturation event counters. The parameters and the saturation
+     * limits are not included.
+     * 
+     * @param self instance
+     * @param cp checkpoint blob writer or reader
+     */
+    void ikSlti_checkpoint(ikSlti *self, ikCheckpoint *cp);
+
+    /**
+     * get frequency response
+     * 
+     * The transfer function of the LTI system is evaluated at
+     * @f$z = e^{j \theta}@f$ for each normalised angular frequency
+     * @f$\theta = \omega T@f$, in rad per sample, where @f$\omega@f$ is
+     * the angular frequency, in rad/s, and @f$T@f$ the sampling time. The
+     * saturation limits are ignored.
+     * 
+     * @param self instance
+     * @param n number of frequencies
+     * @param w array of n normalised angular frequencies, @f$\theta@f$ [rad]
+     * @param re array for the real parts of the response, one per frequency
+     * @param im array for the imaginary parts of the response, one per frequency
+     */
+    void ikSlti_freqResp(const ikSlti *self, int n, const double w[], double re[], double im[]);
+
+    /**
+     * multiply by frequency response
+     * 
+     * As @link ikSlti_freqResp @endlink, but multiplying the complex values
+     * in re and im by the response, so that the response of a chain of
+     * systems is obtained by setting them to 1 and 0, and calling this
+     * method for each system in turn.
+     * 
+     * @param self instance
+     * @param n number of frequencies
+     * @param w array of n normalised angular frequencies, @f$\theta@f$ [rad]
+     * @param re array with the real parts of the values to multiply, one per frequency
+     * @param im array with the imaginary parts of the values to multiply, one per frequency
+     */
+    void ikSlti_mulFreqResp(const ikSlti *self, int n, const double w[], double re[], double im[]);
+
+    /**
+     * get unit delays
+     * 
+     * Evaluates @f$z^{-1}@f$ and @f$z^{-2}@f$ at @f$z = e^{j \theta}@f$ for
+     * each normalised angular frequency, so that the frequency response of a
+     * chain of systems can be obtained with
+     * @link ikSlti_mulFreqRespDelays @endlink without working out the same
+     * sines and cosines for every system.
+     * 
+     * @param n number of frequencies
+     * @param w array of n normalised angular frequencies, @f$\theta@f$ [rad]
+     * @param z array for 4n values: the real and imaginary parts of
+     * @f$z^{-1}@f$ and those of @f$z^{-2}@f$, for each frequency in turn
+     */
+    void ikSlti_delays(int n, const double w[], double z[]);
+
+    /**
+     * multiply by frequency response, at the given unit delays
+     * 
+     * As @link ikSlti_mulFreqResp @endlink, but with the frequencies given
+     * by their unit delays, as obtained from @link ikSlti_delays @endlink.
+     * 
+     * @param self instance
+     * @param n number of frequencies
+     * @param z array of 4n values, the unit delays at each frequency
+     * @param re array with the real parts of the values to multiply, one per frequency
+     * @param im array with the imaginary parts of the values to multiply, one per frequency
+     */
+    void ikSlti_mulFreqRespDelays(const ikSlti *self, int n, const double z[], double re[], double im[]);
+
 
 #ifdef __cplusplus
 }
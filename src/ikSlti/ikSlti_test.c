@@ -602,6 +602,197 @@ void testPropagation() {
 
 }
 
+/**
+ * Test that the instance matches a direct form I reference implementation,
+ * with non-normalised parameters, saturation, and buffers and parameters
+ * changed on the run.
+ */
+void testReference() {
+    printf("ikSlti_test reference\n");
+    /*declare instance */
+    ikSlti sys;
+    ikSlti_init(&sys);
+
+    /*non-normalised notch parameters, as given by ikVfnotch */
+    double a[3] = {4.1, -7.9, 3.9};
+    double b[3] = {4.05, -7.9, 3.95};
+    int err = ikSlti_setParam(&sys, a, b);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=reference (ikSlti_test) message=setParam expected to return 0, but returned %d\n", err);
+    ikSlti_setOutSat(&sys, 2, -3.0, 3.0);
+
+    /*reference buffers */
+    double x[3] = {0.0, 0.0, 0.0};
+    double y[3] = {0.0, 0.0, 0.0};
+    double inBuff[3], outBuff[3];
+    int k, i;
+    for (k = 0; k < 2000; k++) {
+        /*change the parameters and the buffers half way */
+        if (1000 == k) {
+            a[0] = 2.0; a[1] = -1.5; a[2] = 0.5;
+            b[0] = 0.5; b[1] = 0.25; b[2] = 0.25;
+            ikSlti_setParam(&sys, a, b);
+            x[1] = 0.5; y[1] = -1.0;
+            ikSlti_setBuff(&sys, x, y);
+        }
+
+        /*reference step */
+        double in = 4.0 * sin(0.01 * k) + sin(0.3 * k);
+        for (i = 2; i > 0; i--) {
+            x[i] = x[i-1];
+            y[i] = y[i-1];
+        }
+        x[0] = in;
+        y[0] = (b[0]*x[0] + b[1]*x[1] + b[2]*x[2] - a[1]*y[1] - a[2]*y[2]) / a[0];
+        if (-3.0 > y[0] || 3.0 < y[0]) {
+            double lim = (-3.0 > y[0]) ? -3.0 : 3.0;
+            for (i = 0; i < 3; i++) {
+                y[i] = lim;
+                x[i] = lim / (b[0]+b[1]+b[2]) * (a[0]+a[1]+a[2]);
+            }
+        }
+
+        /*see that the instance does the same */
+        double out = ikSlti_step(&sys, in);
+        if (fabs(y[0] - out) > 1e-9) {
+            printf("%%TEST_FAILED%% time=0 testname=reference (ikSlti_test) message=step %d expected to return %f, but returned %f\n", k, y[0], out);
+            break;
+        }
+        ikSlti_getBuff(&sys, inBuff, outBuff);
+        for (i = 0; i < 3; i++) {
+            if (fabs(x[i] - inBuff[i]) > 1e-9) printf("%%TEST_FAILED%% time=0 testname=reference (ikSlti_test) message=step %d expected inBuff[%d]==%f, but instead inBuff[%d]==%f\n", k, i, x[i], i, inBuff[i]);
+            if (fabs(y[i] - outBuff[i]) > 1e-9) printf("%%TEST_FAILED%% time=0 testname=reference (ikSlti_test) message=step %d expected outBuff[%d]==%f, but instead outBuff[%d]==%f\n", k, i, y[i], i, outBuff[i]);
+        }
+    }
+}
+
+void testSatCounts() {
+    printf("ikSlti_test saturation counts\n");
+    /*declare instance */
+    ikSlti sys;
+    /*declare counters */
+    ikSltiSatCounts counts;
+    int err;
+
+    /*initialise instance */
+    ikSlti_init(&sys);
+    ikSlti_getSatCounts(&sys, &counts);
+    if ((0 != counts.inputSaturations) || (0 != counts.outputSaturations) || (0 != counts.saturatedSteps)) printf("%%TEST_FAILED%% time=0 testname=saturation counts (ikSlti_test) message=counters expected to be 0 after init, but were %ld, %ld and %ld\n", counts.inputSaturations, counts.outputSaturations, counts.saturatedSteps);
+
+    /*see that input saturations are counted, in a run of 1 step and one of 2 */
+    err = ikSlti_setInSat(&sys, 2, 2.0, 4.0);
+    if (0 != err) printf("%%TEST_FAILED%% time=0 testname=saturation counts (ikSlti_test) message=setInSat was expected to return 0, but returned %d\n", err);
+    ikSlti_step(&sys, 1.0);
+    ikSlti_step(&sys, 3.0);
+    ikSlti_step(&sys, 8.0);
+    ikSlti_step(&sys, 8.0);
+    ikSlti_step(&sys, 3.0);
+    ikSlti_getSatCounts(&sys, &counts);
+    if (3 != counts.inputSaturations) printf("%%TEST_FAILED%% time=0 testname=saturation counts (ikSlti_test) message=inputSaturations expected to be 3, but was %ld\n", counts.inputSaturations);
+    if (0 != counts.outputSaturations) printf("%%TEST_FAILED%% time=0 testname=saturation counts (ikSlti_test) message=outputSaturations expected to be 0, but was %ld\n", counts.outputSaturations);
+    if (3 != counts.saturatedSteps) printf("%%TEST_FAILED%% time=0 testname=saturation counts (ikSlti_test) message=saturatedSteps expected to be 3, but was %ld\n", counts.saturatedSteps);
+#ifdef IKSLTI_NSATHIST
+#if 1 < IKSLTI_NSATHIST
+    if ((1 != counts.runs[0]) || (1 != counts.runs[1])) printf("%%TEST_FAILED%% time=0 testname=saturation counts (ikSlti_test) message=runs expected to be 1 of 1 step and 1 of 2 steps, but were %ld and %ld\n", counts.runs[0], counts.runs[1]);
+#else
+    if (2 != counts.runs[0]) printf("%%TEST_FAILED%% time=0 testname=saturation counts (ikSlti_test) message=runs expected to be 2, but were %ld\n", counts.runs[0]);
+#endif
+#endif
+
+    /*see that output saturations, i.e. buffer resets, are counted too */
+    ikSlti_setInSat(&sys, 0, 0.0, 0.0);
+    err = ikSlti_setOutSat(&sys, 2, -1.0, 1.0);
+    if (0 != err) printf("%%TEST_FAILED%% time=0 testname=saturation counts (ikSlti_test) message=setOutSat was expected to return 0, but returned %d\n", err);
+    ikSlti_step(&sys, 5.0);
+    ikSlti_step(&sys, -5.0);
+    ikSlti_step(&sys, 0.0);
+    ikSlti_getSatCounts(&sys, &counts);
+    if (3 != counts.inputSaturations) printf("%%TEST_FAILED%% time=0 testname=saturation counts (ikSlti_test) message=inputSaturations expected to be 3, but was %ld\n", counts.inputSaturations);
+    if (2 != counts.outputSaturations) printf("%%TEST_FAILED%% time=0 testname=saturation counts (ikSlti_test) message=outputSaturations expected to be 2, but was %ld\n", counts.outputSaturations);
+    if (5 != counts.saturatedSteps) printf("%%TEST_FAILED%% time=0 testname=saturation counts (ikSlti_test) message=saturatedSteps expected to be 5, but was %ld\n", counts.saturatedSteps);
+
+    /*see that NaN inputs are not counted as saturations */
+    ikSlti_setInSat(&sys, 2, 2.0, 4.0);
+    ikSlti_setOutSat(&sys, 0, 0.0, 0.0);
+    ikSlti_step(&sys, NAN);
+    ikSlti_getSatCounts(&sys, &counts);
+    if (3 != counts.inputSaturations) printf("%%TEST_FAILED%% time=0 testname=saturation counts (ikSlti_test) message=inputSaturations expected to be 3 after a NaN input, but was %ld\n", counts.inputSaturations);
+}
+
+/**
+ * The frequency response matches the steady-state response to sines
+ */
+void testFreqResp() {
+    printf("ikSlti_test testFreqResp\n");
+    const double a[3] = {1.0, -1.2, 0.5};
+    const double b[3] = {0.1, 0.1, 0.1};
+    double w[3] = {0.0, 3.14159265358979, 2.0 * 3.14159265358979 * 50 / 1000};
+    double re[3];
+    double im[3];
+    double y, sinPart = 0.0, cosPart = 0.0;
+    ikSlti tf;
+    int k;
+
+    ikSlti_init(&tf);
+    ikSlti_setParam(&tf, a, b);
+    ikSlti_freqResp(&tf, 3, w, re, im);
+
+    /* static gain, and gain at the Nyquist frequency */
+    if ((fabs(0.3/0.3 - re[0]) > 1e-12) || (fabs(im[0]) > 1e-12)) printf("%%TEST_FAILED%% time=0 testname=testFreqResp (ikSlti_test) message=static gain expected to be 1, but it is %f%+fj\n", re[0], im[0]);
+    if ((fabs(0.1/2.7 - re[1]) > 1e-12) || (fabs(im[1]) > 1e-12)) printf("%%TEST_FAILED%% time=0 testname=testFreqResp (ikSlti_test) message=gain at Nyquist expected to be %f, but it is %f%+fj\n", 0.1/2.7, re[1], im[1]);
+
+    /* steady-state response to a sine of 50 periods in 1000 steps */
+    for (k = 0; k < 2000; k++) {
+        y = ikSlti_step(&tf, sin(w[2] * k));
+        if (1000 > k) continue;
+        sinPart += 2.0 / 1000 * y * sin(w[2] * k);
+        cosPart += 2.0 / 1000 * y * cos(w[2] * k);
+    }
+    if ((fabs(sinPart - re[2]) > 1e-9) || (fabs(cosPart - im[2]) > 1e-9)) printf("%%TEST_FAILED%% time=0 testname=testFreqResp (ikSlti_test) message=response expected to be %f%+fj, but it is %f%+fj\n", sinPart, cosPart, re[2], im[2]);
+
+    /* multiplication into a value */
+    re[2] = 2.0;
+    im[2] = 1.0;
+    ikSlti_mulFreqResp(&tf, 3, w, re, im);
+    if ((fabs(2.0 * sinPart - cosPart - re[2]) > 1e-9) || (fabs(2.0 * cosPart + sinPart - im[2]) > 1e-9)) printf("%%TEST_FAILED%% time=0 testname=testFreqResp (ikSlti_test) message=product expected to be %f%+fj, but it is %f%+fj\n", 2.0 * sinPart - cosPart, 2.0 * cosPart + sinPart, re[2], im[2]);
+}
+
+/**
+ * The frequency response at the unit delays of a set of frequencies, and
+ * that over more than a block of frequencies, are those at each frequency
+ */
+void testFreqRespDelays() {
+    printf("ikSlti_test testFreqRespDelays\n");
+    const double a[3] = {1.0, -1.2, 0.5};
+    const double b[3] = {0.1, 0.1, 0.1};
+    double w[2*IKSLTI_FREQBLOCK + 3];
+    double z[4*(2*IKSLTI_FREQBLOCK + 3)];
+    double re[2*IKSLTI_FREQBLOCK + 3];
+    double im[2*IKSLTI_FREQBLOCK + 3];
+    double reDelays[2*IKSLTI_FREQBLOCK + 3];
+    double imDelays[2*IKSLTI_FREQBLOCK + 3];
+    double re1, im1;
+    const int n = 2*IKSLTI_FREQBLOCK + 3;
+    int nDiffering = 0;
+    ikSlti tf;
+    int k;
+
+    ikSlti_init(&tf);
+    ikSlti_setParam(&tf, a, b);
+    for (k = 0; k < n; k++) {
+        w[k] = 3.14159265358979 * k / n;
+        reDelays[k] = 1.0;
+        imDelays[k] = 0.0;
+    }
+    ikSlti_freqResp(&tf, n, w, re, im);
+    ikSlti_delays(n, w, z);
+    ikSlti_mulFreqRespDelays(&tf, n, z, reDelays, imDelays);
+    for (k = 0; k < n; k++) {
+        ikSlti_freqResp(&tf, 1, w + k, &re1, &im1);
+        nDiffering += (re1 != re[k]) || (im1 != im[k]) || (re1 != reDelays[k]) || (im1 != imDelays[k]);
+    }
+    if (nDiffering) printf("%%TEST_FAILED%% time=0 testname=testFreqRespDelays (ikSlti_test) message=expected the same response at each frequency, but %d differed\n", nDiffering);
+}
+
 int main(int argc, char** argv) {
     printf("%%SUITE_STARTING%% ikSlti_test\n");
     printf("%%SUITE_STARTED%%\n");
@@ -638,6 +829,22 @@ int main(int argc, char** argv) {
     testPropagation();
     printf("%%TEST_FINISHED%% time=0 propagation (ikSlti_test) \n");
 
+    printf("%%TEST_STARTED%% reference (ikSlti_test)\n");
+    testReference();
+    printf("%%TEST_FINISHED%% time=0 reference (ikSlti_test) \n");
+
+    printf("%%TEST_STARTED%% saturation counts (ikSlti_test)\n");
+    testSatCounts();
+    printf("%%TEST_FINISHED%% time=0 saturation counts (ikSlti_test) \n");
+
+    printf("%%TEST_STARTED%% frequency response (ikSlti_test)\n");
+    testFreqResp();
+    printf("%%TEST_FINISHED%% time=0 frequency response (ikSlti_test) \n");
+
+    printf("%%TEST_STARTED%% frequency response at unit delays (ikSlti_test)\n");
+    testFreqRespDelays();
+    printf("%%TEST_FINISHED%% time=0 frequency response at unit delays (ikSlti_test) \n");
+
     printf("%%SUITE_FINISHED%% time=0\n");
 
     return (EXIT_SUCCESS);
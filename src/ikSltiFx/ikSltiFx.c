@@ -0,0 +1,361 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikSltiFx.c
+ * 
+ * @brief class ikSltiFx implementation
+ */
+
+/* @cond */
+
+#include <math.h>
+#include "ikSltiFx.h"
+
+/**
+ * (Private) convert a value to a Q format
+ * @param value value
+ * @param fracBits number of fractional bits
+ * @param q converted value, saturated to the range of the Q format
+ * @return error code:
+ *  0: no error
+ * -1: value out of the range of the Q format
+ */
+int ikSltiFx_quantise(double value, int fracBits, int32_t *q) {
+    double scaled = floor(ldexp(value, fracBits) + 0.5);
+
+    /*saturate */
+    if (scaled > (double) INT32_MAX) {
+        *q = INT32_MAX;
+        return -1;
+    }
+    if (scaled < (double) INT32_MIN) {
+        *q = INT32_MIN;
+        return -1;
+    }
+
+    *q = (int32_t) scaled;
+    return 0;
+}
+
+/**
+ * (Private) add two 64-bit values, saturating instead of wrapping around
+ */
+int64_t ikSltiFx_addSat(int64_t x, int64_t y) {
+    if ((y > 0) && (x > INT64_MAX - y)) return INT64_MAX;
+    if ((y < 0) && (x < INT64_MIN - y)) return INT64_MIN;
+    return x + y;
+}
+
+/**
+ * (Private) shift an accumulator right, rounding to the nearest, and
+ * saturate it to 32 bits
+ */
+int32_t ikSltiFx_narrow(int64_t acc, int fracBits) {
+    if (0 < fracBits) {
+        acc = ikSltiFx_addSat(acc, ((int64_t) 1) << (fracBits - 1));
+        acc >>= fracBits;
+    }
+    if (acc > INT32_MAX) return INT32_MAX;
+    if (acc < INT32_MIN) return INT32_MIN;
+    return (int32_t) acc;
+}
+
+/**
+ * (Private) convert the parameters as set to the current parameter Q format
+ * @return error code:
+ *  0: no error
+ * -1: the normalised parameters cannot be represented
+ */
+int ikSltiFx_convertParam(ikSltiFx *self) {
+    int i;
+    int err = 0;
+    int32_t a[3];
+    int32_t b[3];
+
+    /*normalise and convert */
+    a[0] = 0;
+    for (i = 1; i < 3; i++) {
+        if (ikSltiFx_quantise(self->aParam[i] / self->aParam[0], self->coefFracBits, &(a[i]))) err = -1;
+    }
+    for (i = 0; i < 3; i++) {
+        if (ikSltiFx_quantise(self->bParam[i] / self->aParam[0], self->coefFracBits, &(b[i]))) err = -1;
+    }
+    if (err) return err;
+
+    /*register converted values */
+    for (i = 0; i < 3; i++) {
+        self->a[i] = a[i];
+        self->b[i] = b[i];
+    }
+    return 0;
+}
+
+/**
+ * (Private) convert the saturation limits as set to the current signal Q format,
+ * and compute the input buffer values to be used on output saturation
+ */
+void ikSltiFx_convertSat(ikSltiFx *self) {
+    int i;
+    double suma = 0.0;
+    double sumb = 0.0;
+
+    /*convert limits, clamping them to the range of the format */
+    ikSltiFx_quantise(self->inMinParam, self->sigFracBits, &(self->inMin));
+    ikSltiFx_quantise(self->inMaxParam, self->sigFracBits, &(self->inMax));
+    ikSltiFx_quantise(self->outMinParam, self->sigFracBits, &(self->outMin));
+    ikSltiFx_quantise(self->outMaxParam, self->sigFracBits, &(self->outMax));
+
+    /*compute the static gain inverse, as ikSlti does on output saturation */
+    for (i = 0; i < 3; i++) {
+        suma += self->aParam[i];
+        sumb += self->bParam[i];
+    }
+    self->resetIn = (0.0 != sumb);
+    self->inAtOutMin = 0;
+    self->inAtOutMax = 0;
+    if (self->resetIn) {
+        ikSltiFx_quantise(self->outMinParam/sumb*suma, self->sigFracBits, &(self->inAtOutMin));
+        ikSltiFx_quantise(self->outMaxParam/sumb*suma, self->sigFracBits, &(self->inAtOutMax));
+    }
+}
+
+void ikSltiFx_init(ikSltiFx *self) {
+    /*set member values */
+    int i;
+    for (i = 0; i < 3; i++) {
+        self->aParam[i] = 0.0;
+        self->bParam[i] = 0.0;
+        self->inBuff[i] = 0;
+        self->outBuff[i] = 0;
+    }
+    self->aParam[0] = 1.0;
+    self->bParam[0] = 1.0;
+    self->coefFracBits = IKSLTIFX_DEFAULTCOEFFRACBITS;
+    self->sigFracBits = IKSLTIFX_DEFAULTSIGFRACBITS;
+    self->inSat = 0;
+    self->outSat = 0;
+    self->inMinParam = 0.0;
+    self->inMaxParam = 0.0;
+    self->outMinParam = 0.0;
+    self->outMaxParam = 0.0;
+    ikSltiFx_convertParam(self);
+    ikSltiFx_convertSat(self);
+}
+
+int ikSltiFx_setFormat(ikSltiFx *self, int coefFracBits, int sigFracBits) {
+    int coefFracBits_;
+
+    /*check the numbers of fractional bits */
+    if ((0 > coefFracBits) || (IKSLTIFX_MAXFRACBITS < coefFracBits)) return -1;
+    if ((0 > sigFracBits) || (IKSLTIFX_MAXFRACBITS < sigFracBits)) return -2;
+
+    /*convert the parameters, going back if they don't fit */
+    coefFracBits_ = self->coefFracBits;
+    self->coefFracBits = coefFracBits;
+    if (ikSltiFx_convertParam(self)) {
+        self->coefFracBits = coefFracBits_;
+        return -3;
+    }
+
+    /*convert the saturation limits */
+    self->sigFracBits = sigFracBits;
+    ikSltiFx_convertSat(self);
+
+    return 0;
+}
+
+void ikSltiFx_getFormat(const ikSltiFx *self, int *coefFracBits, int *sigFracBits) {
+    *coefFracBits = self->coefFracBits;
+    *sigFracBits = self->sigFracBits;
+}
+
+int ikSltiFx_setParam(ikSltiFx *self, const double a[], const double b[]) {
+    int i;
+    double aParam[3];
+    double bParam[3];
+
+    /*check a[0] is non-zero */
+    if (0.0 == a[0]) return -1;
+
+    /*remember the previous values, in case the new ones don't fit */
+    for (i = 0; i < 3; i++) {
+        aParam[i] = self->aParam[i];
+        bParam[i] = self->bParam[i];
+        self->aParam[i] = a[i];
+        self->bParam[i] = b[i];
+    }
+
+    /*normalise and convert */
+    if (ikSltiFx_convertParam(self)) {
+        for (i = 0; i < 3; i++) {
+            self->aParam[i] = aParam[i];
+            self->bParam[i] = bParam[i];
+        }
+        return -2;
+    }
+    ikSltiFx_convertSat(self);
+
+    return 0;
+}
+
+void ikSltiFx_getParam(const ikSltiFx *self, double a[], double b[]) {
+    /*copy parameters as set */
+    int i;
+    for (i = 0; i < 3; i++) {
+        a[i] = self->aParam[i];
+        b[i] = self->bParam[i];
+    }
+}
+
+void ikSltiFx_setBuff(ikSltiFx *self, const int32_t inBuff[], const int32_t outBuff[]) {
+    /*copy inBuff and outBuff values */
+    int i;
+    for (i = 0; i < 3; i++) {
+        self->inBuff[i] = inBuff[i];
+        self->outBuff[i] = outBuff[i];
+    }
+}
+
+void ikSltiFx_getBuff(const ikSltiFx *self, int32_t inBuff[], int32_t outBuff[]) {
+    /*copy self->inBuff and self->outBuff values */
+    int i;
+    for (i = 0; i < 3; i++) {
+        inBuff[i] = self->inBuff[i];
+        outBuff[i] = self->outBuff[i];
+    }
+}
+
+int ikSltiFx_setInSat(ikSltiFx *self, int enable, double min, double max) {
+    /*check that enable is valid */
+    if ((-1 > enable) || (2 < enable)) return -1;
+
+    /*check that min and max make sense */
+    if ((2 == enable) && (min > max)) return -2;
+
+    /*register input values */
+    self->inSat = enable;
+    self->inMinParam = min;
+    self->inMaxParam = max;
+    ikSltiFx_convertSat(self);
+
+    /*return error code */
+    return 0;
+}
+
+int ikSltiFx_getInSat(const ikSltiFx *self, double *min, double *max) {
+    /*output values */
+    *min = self->inMinParam;
+    *max = self->inMaxParam;
+
+    /*return value */
+    return self->inSat;
+}
+
+int ikSltiFx_setOutSat(ikSltiFx *self, int enable, double min, double max) {
+    /*check that enable is valid */
+    if ((-1 > enable) || (2 < enable)) return -1;
+
+    /*check that min and max make sense */
+    if ((2 == enable) && (min > max)) return -2;
+
+    /*register input values */
+    self->outSat = enable;
+    self->outMinParam = min;
+    self->outMaxParam = max;
+    ikSltiFx_convertSat(self);
+
+    /*return error code */
+    return 0;
+}
+
+int ikSltiFx_getOutSat(const ikSltiFx *self, double *min, double *max) {
+    /*output values */
+    *min = self->outMinParam;
+    *max = self->outMaxParam;
+
+    /*return value */
+    return self->outSat;
+}
+
+int32_t ikSltiFx_step(ikSltiFx *self, int32_t input) {
+    int i;
+    int64_t acc;
+
+    /*move old values down the buffers */
+    for (i = 2; i > 0; i--) {
+        self->inBuff[i] = self->inBuff[i-1];
+        self->outBuff[i] = self->outBuff[i-1];
+    }
+
+    /*register new input */
+    self->inBuff[0] = input;
+
+    /*apply input saturation */
+    if ((-1 == self->inSat) || (2 == self->inSat))
+        if (self->inMin > self->inBuff[0]) self->inBuff[0] = self->inMin;
+    if ((1 == self->inSat) || (2 == self->inSat))
+        if (self->inMax < self->inBuff[0]) self->inBuff[0] = self->inMax;
+
+    /*compute new output value, with a[0] already normalised to 1 */
+    acc = (int64_t) self->b[0] * self->inBuff[0];
+    for (i = 1; i < 3; i++) {
+        acc = ikSltiFx_addSat(acc, -((int64_t) self->a[i] * self->outBuff[i]));
+        acc = ikSltiFx_addSat(acc, (int64_t) self->b[i] * self->inBuff[i]);
+    }
+    self->outBuff[0] = ikSltiFx_narrow(acc, self->coefFracBits);
+
+    /*apply output saturation */
+    if ((-1 == self->outSat) || (2 == self->outSat)) {
+        if (self->outMin > self->outBuff[0]) {
+            for (i = 0; i < 3; i++) {
+                self->outBuff[i] = self->outMin;
+                if (self->resetIn) self->inBuff[i] = self->inAtOutMin;
+            }
+        }
+    }
+    if ((1 == self->outSat) || (2 == self->outSat)) {
+        if (self->outMax < self->outBuff[0]) {
+            for (i = 0; i < 3; i++) {
+                self->outBuff[i] = self->outMax;
+                if (self->resetIn) self->inBuff[i] = self->inAtOutMax;
+            }
+        }
+    }
+
+    /*return new output */
+    return self->outBuff[0];
+}
+
+int32_t ikSltiFx_getOutput(const ikSltiFx *self) {
+    /*return value */
+    return self->outBuff[0];
+}
+
+int32_t ikSltiFx_fromDouble(const ikSltiFx *self, double value) {
+    int32_t q;
+    ikSltiFx_quantise(value, self->sigFracBits, &q);
+    return q;
+}
+
+double ikSltiFx_toDouble(const ikSltiFx *self, int32_t value) {
+    return ldexp((double) value, -self->sigFracBits);
+}
+
+/* @endcond */
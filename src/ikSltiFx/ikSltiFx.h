@@ -0,0 +1,320 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikSltiFx.h
+ *
+ * @brief Class ikSltiFx interface
+ */
+
+#ifndef IKSLTIFX_H
+#define IKSLTIFX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define IKSLTIFX_MAXFRACBITS 30
+#define IKSLTIFX_DEFAULTCOEFFRACBITS 28
+#define IKSLTIFX_DEFAULTSIGFRACBITS 16
+
+    /**
+     * @struct ikSltiFx
+     * @brief Fixed-point saturating linear time invariant system
+     *
+     * Instances of this type are fixed-point implementations of
+     * @link ikSlti @endlink, meant for targets without a floating-point unit.
+     * Signals and parameters are represented as 32-bit signed integers in
+     * Q format, with a configurable number of fractional bits for each. All
+     * arithmetic in @link ikSltiFx_step @endlink is integer arithmetic, with
+     * 64-bit accumulators and saturation instead of wrap-around on overflow.
+     *
+     * The parameters are normalised with respect to @f$a_0@f$ when they are
+     * set, so that @link ikSltiFx_step @endlink does not divide. Floating-point
+     * arithmetic is only used by the configuration methods, and by the
+     * conversion methods @link ikSltiFx_fromDouble @endlink and
+     * @link ikSltiFx_toDouble @endlink.
+     *
+     * The semantics of input and output saturation are those of
+     * @link ikSlti @endlink, including the reset of the buffers when the
+     * output saturates.
+     *
+     * @par Inputs
+     * @li input value: set via @link ikSltiFx_step @endlink
+     * @li input saturation: set via @link ikSltiFx_setInSat @endlink
+     * @li output saturation: set via @link ikSltiFx_setOutSat @endlink
+     *
+     * @par Outputs
+     * @li output value: returned by @link ikSltiFx_step @endlink and @link ikSltiFx_getOutput @endlink
+     *
+     * @par Methods
+     * @li @link ikSltiFx_init @endlink initialise an instance
+     * @li @link ikSltiFx_setFormat @endlink set Q formats
+     * @li @link ikSltiFx_getFormat @endlink get Q formats
+     * @li @link ikSltiFx_setParam @endlink set parameters
+     * @li @link ikSltiFx_getParam @endlink get parameters
+     * @li @link ikSltiFx_setBuff @endlink set buffers
+     * @li @link ikSltiFx_getBuff @endlink get buffers
+     * @li @link ikSltiFx_setInSat @endlink set input saturation
+     * @li @link ikSltiFx_getInSat @endlink get input saturation
+     * @li @link ikSltiFx_setOutSat @endlink set output saturation
+     * @li @link ikSltiFx_getOutSat @endlink get output saturation
+     * @li @link ikSltiFx_step @endlink execute periodic calculations
+     * @li @link ikSltiFx_getOutput @endlink get output value
+     * @li @link ikSltiFx_fromDouble @endlink convert a value to signal Q format
+     * @li @link ikSltiFx_toDouble @endlink convert a value from signal Q format
+     */
+    typedef struct ikSltiFx {
+        /**
+         * Private members
+         */
+        /* @cond */
+        int32_t inBuff[3]; /*input buffer */
+        int32_t outBuff[3]; /*output buffer */
+        int32_t a[3]; /*normalised denominator parameters, a[0] is not used */
+        int32_t b[3]; /*normalised numerator parameters */
+        double aParam[3]; /*denominator parameters as set */
+        double bParam[3]; /*numerator parameters as set */
+        int coefFracBits; /*number of fractional bits of the parameters */
+        int sigFracBits; /*number of fractional bits of the signals */
+        int inSat; /*input saturation status flag */
+        int outSat; /*output saturation status flag */
+        double inMaxParam; /*upper saturation limit for input as set */
+        double inMinParam; /*lower saturation limit for input as set */
+        double outMaxParam; /*upper saturation limit for output as set */
+        double outMinParam; /*lower saturation limit for output as set */
+        int32_t inMax; /*upper saturation limit for input */
+        int32_t inMin; /*lower saturation limit for input */
+        int32_t outMax; /*upper saturation limit for output */
+        int32_t outMin; /*lower saturation limit for output */
+        int resetIn; /*flag: reset input buffer on output saturation */
+        int32_t inAtOutMax; /*input buffer value on upper output saturation */
+        int32_t inAtOutMin; /*input buffer value on lower output saturation */
+        /* @endcond */
+    } ikSltiFx;
+
+    /**
+     * initialise instance
+     *
+     * The instance is initialised as a static gain of 1, with no saturation,
+     * @link IKSLTIFX_DEFAULTCOEFFRACBITS @endlink fractional bits for the
+     * parameters and @link IKSLTIFX_DEFAULTSIGFRACBITS @endlink fractional
+     * bits for the signals.
+     *
+     * @param self instance
+     */
+    void ikSltiFx_init(ikSltiFx *self);
+
+    /**
+     * set Q formats
+     *
+     * A value @f$v@f$ is represented in a format with @f$n@f$ fractional bits
+     * by the integer nearest to @f$v 2^n@f$. The parameters and saturation
+     * limits previously set are converted to the new formats. The buffers
+     * are not converted.
+     *
+     * @param self instance
+     * @param coefFracBits number of fractional bits of the parameters
+     * @param sigFracBits number of fractional bits of the input and output signals
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid number of fractional bits for the parameters, must be between 0 and @link IKSLTIFX_MAXFRACBITS @endlink
+     * @li -2: invalid number of fractional bits for the signals, must be between 0 and @link IKSLTIFX_MAXFRACBITS @endlink
+     * @li -3: the current parameters cannot be represented in the new format
+     */
+    int ikSltiFx_setFormat(ikSltiFx *self, int coefFracBits, int sigFracBits);
+
+    /**
+     * get Q formats
+     *
+     * @param self instance
+     * @param coefFracBits number of fractional bits of the parameters
+     * @param sigFracBits number of fractional bits of the input and output signals
+     */
+    void ikSltiFx_getFormat(const ikSltiFx *self, int *coefFracBits, int *sigFracBits);
+
+    /**
+     * set LTI system parameter values
+     *
+     * The LTI system is represented by the same discrete-time transfer
+     * function as in @link ikSlti_setParam @endlink. The parameters are
+     * divided by @f$a_0@f$ and converted to the parameter Q format.
+     *
+     * @param self instance
+     * @param a array of length 3 with denominator parameters, where @f$a_i@f$ = a[i] and a[0] must be non-zero
+     * @param b array of length 3 with numerator parameters, where @f$b_i@f$ = b[i]
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid value at a[0], must be non-zero
+     * @li -2: the normalised parameters cannot be represented in the parameter Q format
+     */
+    int ikSltiFx_setParam(ikSltiFx *self, const double a[], const double b[]);
+
+    /**
+     * get LTI system parameter values
+     *
+     * This method gets the values of @f$a_i@f$ and @f$b_i@f$ as they were
+     * passed to @link ikSltiFx_setParam @endlink.
+     *
+     * @param self instance
+     * @param a array of length 3 for denominator parameters, where a[i] = @f$a_i@f$
+     * @param b array of length 3 for numerator parameters, where b[i] = @f$b_i@f$
+     */
+    void ikSltiFx_getParam(const ikSltiFx *self, double a[], double b[]);
+
+    /**
+     * set buffer values
+     *
+     * As in @link ikSlti_setBuff @endlink, with values in signal Q format.
+     *
+     * @param self instance
+     * @param inBuff array with the input values, in chronological order, with
+     * inBuff[0] being the latest and inBuff[2] the oldest
+     * @param outBuff array with the output values, in chronological order, with
+     * outBuff[0] being the latest and outBuff[2] the oldest
+     */
+    void ikSltiFx_setBuff(ikSltiFx *self, const int32_t inBuff[], const int32_t outBuff[]);
+
+    /**
+     * get buffer values
+     *
+     * As in @link ikSlti_getBuff @endlink, with values in signal Q format.
+     *
+     * @param self instance
+     * @param inBuff array for the input values, in chronological order, with
+     * inBuff[0] being the latest and inBuff[2] the oldest
+     * @param outBuff array for the output values, in chronological order, with
+     * outBuff[0] being the latest and outBuff[2] the oldest
+     */
+    void ikSltiFx_getBuff(const ikSltiFx *self, int32_t inBuff[], int32_t outBuff[]);
+
+    /**
+     * set input saturation limits
+     *
+     * Limits beyond the range of the signal Q format are clamped to it.
+     *
+     * @param self instance
+     * @param enable flag:
+     * @li 0 to disable input saturation
+     * @li -1 to enable lower saturation limit only
+     * @li 1 to enable upper saturation limit only
+     * @li 2 to enable both
+     * @param min lower saturation limit
+     * @param max upper saturation limit
+     * @return error code
+     * @li 0: no error
+     * @li -1: invalid enable flag value, must be -1, 0, 1 or 2
+     * @li -2: invalid saturation limits, upper limit must be larger than or equal
+     * to lower limit
+     */
+    int ikSltiFx_setInSat(ikSltiFx *self, int enable, double min, double max);
+
+    /**
+     * get input saturation limits
+     *
+     * @param self instance
+     * @param min lower saturation limit
+     * @param max upper saturation limit
+     * @return flag:
+     * @li 0 if input saturation is disabled
+     * @li -1 if only the lower saturation limit is enabled
+     * @li 1 if only the upper saturation is enabled
+     * @li 2 if both are enabled
+     */
+    int ikSltiFx_getInSat(const ikSltiFx *self, double *min, double *max);
+
+    /**
+     * set output saturation limits
+     *
+     * Limits beyond the range of the signal Q format are clamped to it.
+     *
+     * @param self instance
+     * @param enable flag:
+     * @li 0 to disable output saturation
+     * @li -1 to enable lower saturation limit only
+     * @li 1 to enable upper saturation limit only
+     * @li 2 to enable both
+     * @param min lower saturation limit
+     * @param max upper saturation limit
+     * @return error code
+     * @li 0: no error
+     * @li -1: invalid enable flag value, must be -1, 0, 1 or 2
+     * @li -2: invalid saturation limits, upper limit must be larger than or equal
+     * to lower limit
+     */
+    int ikSltiFx_setOutSat(ikSltiFx *self, int enable, double min, double max);
+
+    /**
+     * get output saturation limits
+     *
+     * @param self instance
+     * @param min lower saturation limit
+     * @param max upper saturation limit
+     * @return flag:
+     * @li 0 if output saturation is disabled
+     * @li -1 if only the lower saturation limit is enabled
+     * @li 1 if only the upper saturation is enabled
+     * @li 2 if both are enabled
+     */
+    int ikSltiFx_getOutSat(const ikSltiFx *self, double *min, double *max);
+
+    /**
+     * advance one sample interval and calculate new output of LTI system
+     *
+     * @param self instance
+     * @param input new input value, in signal Q format
+     * @return new output value, in signal Q format
+     */
+    int32_t ikSltiFx_step(ikSltiFx *self, int32_t input);
+
+    /**
+     * get LTI system output
+     *
+     * @param self instance
+     * @return LTI system output, in signal Q format
+     */
+    int32_t ikSltiFx_getOutput(const ikSltiFx *self);
+
+    /**
+     * convert a value to signal Q format, rounding to the nearest
+     * representable value and saturating
+     *
+     * @param self instance
+     * @param value value
+     * @return value in signal Q format
+     */
+    int32_t ikSltiFx_fromDouble(const ikSltiFx *self, double value);
+
+    /**
+     * convert a value from signal Q format
+     *
+     * @param self instance
+     * @param value value in signal Q format
+     * @return value
+     */
+    double ikSltiFx_toDouble(const ikSltiFx *self, int32_t value);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKSLTIFX_H */
@@ -0,0 +1,476 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikSltiFx_test.c
+ * 
+ * @brief Class ikSltiFx unit tests
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "ikSltiFx.h"
+#include "ikSlti.h"
+
+/*
+ * Simple C Test Suite for class ikSltiFx
+ *
+ * The scenarios of ikSlti_test are run on both ikSlti and ikSltiFx, and the
+ * outputs and buffers of both are compared.
+ */
+
+/**
+ * Step both implementations and compare outputs and buffers.
+ */
+int stepBoth(ikSlti *sys, ikSltiFx *sysFx, double input, double tol, const char *testname) {
+    double out = ikSlti_step(sys, input);
+    double outFx = ikSltiFx_toDouble(sysFx, ikSltiFx_step(sysFx, ikSltiFx_fromDouble(sysFx, input)));
+    int fail = 0;
+    if (fabs(out - outFx) > tol) {
+        printf("%%TEST_FAILED%% time=0 testname=%s (ikSltiFx_test) message=step returned %f, but ikSlti returned %f\n", testname, outFx, out);
+        fail = 1;
+    }
+
+    double inBuff[3], outBuff[3];
+    int32_t inBuffFx[3], outBuffFx[3];
+    ikSlti_getBuff(sys, inBuff, outBuff);
+    ikSltiFx_getBuff(sysFx, inBuffFx, outBuffFx);
+    int i;
+    for (i = 0; i < 3; i++) {
+        if (fabs(inBuff[i] - ikSltiFx_toDouble(sysFx, inBuffFx[i])) > tol) {
+            printf("%%TEST_FAILED%% time=0 testname=%s (ikSltiFx_test) message=inBuff[%d]==%f, but ikSlti has %f\n", testname, i, ikSltiFx_toDouble(sysFx, inBuffFx[i]), inBuff[i]);
+            fail = 1;
+        }
+        if (fabs(outBuff[i] - ikSltiFx_toDouble(sysFx, outBuffFx[i])) > tol) {
+            printf("%%TEST_FAILED%% time=0 testname=%s (ikSltiFx_test) message=outBuff[%d]==%f, but ikSlti has %f\n", testname, i, ikSltiFx_toDouble(sysFx, outBuffFx[i]), outBuff[i]);
+            fail = 1;
+        }
+    }
+    return fail;
+}
+
+/**
+ * Set the same parameters on both implementations.
+ */
+void setParamBoth(ikSlti *sys, ikSltiFx *sysFx, const double a[], const double b[], const char *testname) {
+    int err = ikSlti_setParam(sys, a, b);
+    if (0 != err) printf("%%TEST_FAILED%% time=0 testname=%s (ikSltiFx_test) message=ikSlti_setParam expected to return 0, but returned %d\n", testname, err);
+    err = ikSltiFx_setParam(sysFx, a, b);
+    if (0 != err) printf("%%TEST_FAILED%% time=0 testname=%s (ikSltiFx_test) message=setParam expected to return 0, but returned %d\n", testname, err);
+}
+
+/**
+ * Test that the constructor returns a well-initialised instance.
+ */
+void testInit() {
+    printf("ikSltiFx_test init\n");
+    /*declare instance */
+    ikSltiFx sys;
+
+    /*initialise instance */
+    ikSltiFx_init(&sys);
+
+    /*see that a == [1 0 0] and b == [1 0 0] */
+    double a[3];
+    double b[3];
+    ikSltiFx_getParam(&sys, a, b);
+    if (fabs(1.0-a[0]) > 1e-9) printf("%%TEST_FAILED%% time=0 testname=init (ikSltiFx_test) message=expected a[0]==1.0, but instead a[0]==%f\n", a[0]);
+    if (fabs(1.0-b[0]) > 1e-9) printf("%%TEST_FAILED%% time=0 testname=init (ikSltiFx_test) message=expected b[0]==1.0, but instead b[0]==%f\n", b[0]);
+    int i;
+    for (i = 1; i < 3; i++) {
+        if (fabs(0.0-a[i]) > 1e-9) printf("%%TEST_FAILED%% time=0 testname=init (ikSltiFx_test) message=expected a[%d]==0.0, but instead a[%d]==%f\n", i, i, a[i]);
+        if (fabs(0.0-b[i]) > 1e-9) printf("%%TEST_FAILED%% time=0 testname=init (ikSltiFx_test) message=expected b[%d]==0.0, but instead b[%d]==%f\n", i, i, b[i]);
+    }
+
+    /*see that inBuff and outBuff are zero */
+    int32_t inBuff[3];
+    int32_t outBuff[3];
+    ikSltiFx_getBuff(&sys, inBuff, outBuff);
+    for (i = 0; i < 3; i++) {
+        if (0 != inBuff[i]) printf("%%TEST_FAILED%% time=0 testname=init (ikSltiFx_test) message=expected inBuff[%d]==0, but instead inBuff[%d]==%d\n", i, i, inBuff[i]);
+        if (0 != outBuff[i]) printf("%%TEST_FAILED%% time=0 testname=init (ikSltiFx_test) message=expected outBuff[%d]==0, but instead outBuff[%d]==%d\n", i, i, outBuff[i]);
+    }
+
+    /*see that the default formats are set */
+    int coefFracBits;
+    int sigFracBits;
+    ikSltiFx_getFormat(&sys, &coefFracBits, &sigFracBits);
+    if (IKSLTIFX_DEFAULTCOEFFRACBITS != coefFracBits) printf("%%TEST_FAILED%% time=0 testname=init (ikSltiFx_test) message=expected coefFracBits==%d, but instead coefFracBits==%d\n", IKSLTIFX_DEFAULTCOEFFRACBITS, coefFracBits);
+    if (IKSLTIFX_DEFAULTSIGFRACBITS != sigFracBits) printf("%%TEST_FAILED%% time=0 testname=init (ikSltiFx_test) message=expected sigFracBits==%d, but instead sigFracBits==%d\n", IKSLTIFX_DEFAULTSIGFRACBITS, sigFracBits);
+
+    /*see that saturation is disabled */
+    double min;
+    double max;
+    int enbl = ikSltiFx_getInSat(&sys, &min, &max);
+    if (0 != enbl) printf("%%TEST_FAILED%% time=0 testname=init (ikSltiFx_test) message=getInSat was expected to return 0, but returned %d\n", enbl);
+    enbl = ikSltiFx_getOutSat(&sys, &min, &max);
+    if (0 != enbl) printf("%%TEST_FAILED%% time=0 testname=init (ikSltiFx_test) message=getOutSat was expected to return 0, but returned %d\n", enbl);
+    int32_t output = ikSltiFx_getOutput(&sys);
+    if (0 != output) printf("%%TEST_FAILED%% time=0 testname=init (ikSltiFx_test) message=expected output==0, instead output==%d\n", output);
+
+}
+
+/**
+ * Run the parameter scenarios of ikSlti_test on both implementations.
+ */
+void testParameters() {
+    printf("ikSltiFx_test parameters\n");
+    /*declare instances */
+    ikSlti sys;
+    ikSltiFx sysFx;
+    double a[3], b[3];
+
+    /*simple gain of 1 */
+    ikSlti_init(&sys);
+    ikSltiFx_init(&sysFx);
+    stepBoth(&sys, &sysFx, 8.0, 1e-9, "parameters");
+
+    /*gain of 0.25 */
+    a[0] = 2.0; a[1] = 0.0; a[2] = 0.0;
+    b[0] = 0.5; b[1] = 0.0; b[2] = 0.0;
+    setParamBoth(&sys, &sysFx, a, b, "parameters");
+    stepBoth(&sys, &sysFx, 8.0, 1e-9, "parameters");
+    ikSltiFx_getParam(&sysFx, a, b);
+    if (fabs(2.0-a[0]) > 1e-9) printf("%%TEST_FAILED%% time=0 testname=parameters (ikSltiFx_test) message=expected a[0]==2.0, but instead a[0]==%f\n", a[0]);
+    if (fabs(0.5-b[0]) > 1e-9) printf("%%TEST_FAILED%% time=0 testname=parameters (ikSltiFx_test) message=expected b[0]==0.5, but instead b[0]==%f\n", b[0]);
+
+    /*some other parameters */
+    ikSlti_init(&sys);
+    ikSltiFx_init(&sysFx);
+    a[0] = 1.0; a[1] = 1.0; a[2] = 0.0;
+    b[0] = 1.0; b[1] = 1.0; b[2] = 0.0;
+    setParamBoth(&sys, &sysFx, a, b, "parameters");
+    int i;
+    for (i = 0; i < 3; i++) stepBoth(&sys, &sysFx, 2.0, 1e-9, "parameters");
+
+    /*an integrator */
+    ikSlti_init(&sys);
+    ikSltiFx_init(&sysFx);
+    a[0] = 0.5; a[1] = -0.5; a[2] = 0.0;
+    b[0] = 1.0; b[1] = 0.0; b[2] = 0.0;
+    setParamBoth(&sys, &sysFx, a, b, "parameters");
+    for (i = 0; i < 3; i++) stepBoth(&sys, &sysFx, 2.0, 1e-9, "parameters");
+
+    /*some other parameters */
+    ikSlti_init(&sys);
+    ikSltiFx_init(&sysFx);
+    a[0] = 1.0; a[1] = 1.0; a[2] = 1.0;
+    b[0] = 1.0; b[1] = 2.0; b[2] = 4.0;
+    setParamBoth(&sys, &sysFx, a, b, "parameters");
+    for (i = 0; i < 3; i++) stepBoth(&sys, &sysFx, -2.0, 1e-9, "parameters");
+}
+
+/**
+ * Run the buffer scenario of ikSlti_test on both implementations.
+ */
+void testBuffers() {
+    printf("ikSltiFx_test buffers\n");
+    /*declare instances */
+    ikSlti sys;
+    ikSltiFx sysFx;
+
+    /*initialise instances */
+    double a[3] = {1.0, 0.0, -1.0};
+    double b[3] = {0.0, 0.0, 1.0};
+    double inBuff[3] = {2.0, 4.0, 8.0};
+    double outBuff[3] = {16.0, 32.0, 64.0};
+    int32_t inBuffFx[3], outBuffFx[3];
+    ikSlti_init(&sys);
+    ikSltiFx_init(&sysFx);
+    setParamBoth(&sys, &sysFx, a, b, "buffers");
+    ikSlti_setBuff(&sys, inBuff, outBuff);
+    int i;
+    for (i = 0; i < 3; i++) {
+        inBuffFx[i] = ikSltiFx_fromDouble(&sysFx, inBuff[i]);
+        outBuffFx[i] = ikSltiFx_fromDouble(&sysFx, outBuff[i]);
+    }
+    ikSltiFx_setBuff(&sysFx, inBuffFx, outBuffFx);
+
+    /*see that we get the same outputs and buffers */
+    stepBoth(&sys, &sysFx, 0.5, 1e-9, "buffers");
+    int32_t out = ikSltiFx_getOutput(&sysFx);
+    if (ikSltiFx_fromDouble(&sysFx, 36.0) != out) printf("%%TEST_FAILED%% time=0 testname=buffers (ikSltiFx_test) message=getOutput expected to return 36.0, but returned %f\n", ikSltiFx_toDouble(&sysFx, out));
+}
+
+/**
+ * Run the saturation scenario of ikSlti_test on both implementations.
+ */
+void testSaturation() {
+    printf("ikSltiFx_test saturation\n");
+    /*declare instances */
+    ikSlti sys;
+    ikSltiFx sysFx;
+    ikSlti_init(&sys);
+    ikSltiFx_init(&sysFx);
+
+    /*input saturation, all flags */
+    const int flags[4] = {2, -1, 1, 0};
+    const double inputs[6] = {1.0, 1.0, 1.0, 8.0, 8.0, 8.0};
+    int i, j;
+    for (i = 0; i < 4; i++) {
+        ikSlti_setInSat(&sys, flags[i], 2.0, 4.0);
+        int err = ikSltiFx_setInSat(&sysFx, flags[i], 2.0, 4.0);
+        if (0 != err) printf("%%TEST_FAILED%% time=0 testname=saturation (ikSltiFx_test) message=setInSat was expected to return 0, but returned %d\n", err);
+        for (j = 0; j < 6; j++) stepBoth(&sys, &sysFx, inputs[j], 1e-9, "saturation");
+    }
+
+    /*output saturation, all flags */
+    const double outInputs[4][4] = {
+        {3.0, 3.0, 3.0, 1.0},
+        {3.0, 3.0, 3.0, 8.0},
+        {-1.0, 0.0, 1.0, 6.0},
+        {7.0, 8.0, 3.0, 8.0}
+    };
+    for (i = 0; i < 4; i++) {
+        ikSlti_setOutSat(&sys, flags[i], 2.0, 4.0);
+        int err = ikSltiFx_setOutSat(&sysFx, flags[i], 2.0, 4.0);
+        if (0 != err) printf("%%TEST_FAILED%% time=0 testname=saturation (ikSltiFx_test) message=setOutSat was expected to return 0, but returned %d\n", err);
+        for (j = 0; j < 16; j++) stepBoth(&sys, &sysFx, outInputs[j / 4][j % 4], 1e-9, "saturation");
+    }
+
+    /*see that limits as set are reported */
+    double min, max;
+    int enbl = ikSltiFx_getInSat(&sysFx, &min, &max);
+    if (0 != enbl) printf("%%TEST_FAILED%% time=0 testname=saturation (ikSltiFx_test) message=getInSat was expected to return 0, but returned %d\n", enbl);
+    if ((2.0 != min) || (4.0 != max)) printf("%%TEST_FAILED%% time=0 testname=saturation (ikSltiFx_test) message=expected limits 2.0 and 4.0, but got %f and %f\n", min, max);
+}
+
+/**
+ * Test that methods return the proper errors when passed bad arguments.
+ */
+void testErrors() {
+    printf("ikSltiFx_test errors\n");
+    /*declare instance */
+    ikSltiFx sys;
+    ikSltiFx_init(&sys);
+
+    /*see that setParam returns error code -1 when a[0] == 0 */
+    double a[3] = {0.0, 0.0, 0.0};
+    double b[3] = {1.0, 0.0, 0.0};
+    int err = ikSltiFx_setParam(&sys, a, b);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=errors (ikSltiFx_test) message=setParam expected to return -1, but returned %d\n", err);
+
+    /*see that setParam returns error code -2 when the parameters don't fit, and keeps the old ones */
+    a[0] = 0.5;
+    b[0] = 7.0;
+    err = ikSltiFx_setParam(&sys, a, b);
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=errors (ikSltiFx_test) message=setParam expected to return -2, but returned %d\n", err);
+    ikSltiFx_getParam(&sys, a, b);
+    if ((1.0 != a[0]) || (1.0 != b[0])) printf("%%TEST_FAILED%% time=0 testname=errors (ikSltiFx_test) message=expected a[0]==1.0 and b[0]==1.0, but instead a[0]==%f and b[0]==%f\n", a[0], b[0]);
+
+    /*see that setFormat returns the correct error codes */
+    err = ikSltiFx_setFormat(&sys, -1, 16);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=errors (ikSltiFx_test) message=setFormat expected to return -1, but returned %d\n", err);
+    err = ikSltiFx_setFormat(&sys, 28, IKSLTIFX_MAXFRACBITS + 1);
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=errors (ikSltiFx_test) message=setFormat expected to return -2, but returned %d\n", err);
+    b[0] = 6.0;
+    err = ikSltiFx_setParam(&sys, a, b);
+    if (0 != err) printf("%%TEST_FAILED%% time=0 testname=errors (ikSltiFx_test) message=setParam expected to return 0, but returned %d\n", err);
+    err = ikSltiFx_setFormat(&sys, 29, 16);
+    if (-3 != err) printf("%%TEST_FAILED%% time=0 testname=errors (ikSltiFx_test) message=setFormat expected to return -3, but returned %d\n", err);
+
+    /*see that saturation setters return the correct error codes */
+    err = ikSltiFx_setInSat(&sys, -2, 0.0, 0.0);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=errors (ikSltiFx_test) message=setInSat expected to return -1, but returned %d\n", err);
+    err = ikSltiFx_setInSat(&sys, 2, 1.0, -1.0);
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=errors (ikSltiFx_test) message=setInSat expected to return -2, but returned %d\n", err);
+    err = ikSltiFx_setOutSat(&sys, -2, 0.0, 0.0);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=errors (ikSltiFx_test) message=setOutSat expected to return -1, but returned %d\n", err);
+    err = ikSltiFx_setOutSat(&sys, 2, 1.0, -1.0);
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=errors (ikSltiFx_test) message=setOutSat expected to return -2, but returned %d\n", err);
+}
+
+/**
+ * Run the propagation scenarios of ikSlti_test on both implementations.
+ */
+void testPropagation() {
+    printf("ikSltiFx_test propagation\n");
+    /*declare instances */
+    ikSlti sys;
+    ikSltiFx sysFx;
+
+    /*scenarios: parameters, saturation flag and limits, input */
+    const double a[7][3] = {
+        {1.0, 0.0, 0.0},
+        {1.0, 0.0, 0.0},
+        {-1.0, 0.0, 0.0},
+        {-1.0, 0.0, 0.0},
+        {0.5, 0.2, 0.3},
+        {0.2, 0.3, 0.4},
+        {1.0, 0.0, 0.0}
+    };
+    const double b[7][3] = {
+        {2.0, 0.0, 0.0},
+        {2.0, 0.0, 0.0},
+        {2.0, 0.0, 0.0},
+        {2.0, 0.0, 0.0},
+        {7.0, 2.0, -4.0},
+        {4.0, 3.0, 2.0},
+        {2.0, -1.0, -1.0}
+    };
+    const int flag[7] = {1, -1, 1, -1, 1, -1, 1};
+    const double min[7] = {0.0, -100.0, 0.0, -100.0, 0.0, -100.0, 0.0};
+    const double max[7] = {100.0, 0.0, 100.0, 0.0, 100.0, 0.0, 100.0};
+    const double input[7] = {150.0, -150.0, -150.0, 150.0, 150.0, -150.0, 150.0};
+
+    int i;
+    for (i = 0; i < 7; i++) {
+        ikSlti_init(&sys);
+        ikSltiFx_init(&sysFx);
+
+        /*large normalised parameters need more integer bits */
+        int err = ikSltiFx_setFormat(&sysFx, 24, 16);
+        if (0 != err) printf("%%TEST_FAILED%% time=0 testname=propagation (ikSltiFx_test) message=setFormat expected to return 0, but returned %d\n", err);
+        setParamBoth(&sys, &sysFx, a[i], b[i], "propagation");
+        ikSlti_setOutSat(&sys, flag[i], min[i], max[i]);
+        err = ikSltiFx_setOutSat(&sysFx, flag[i], min[i], max[i]);
+        if (0 != err) printf("%%TEST_FAILED%% time=0 testname=propagation (ikSltiFx_test) message=setOutSat expected to return 0, but returned %d\n", err);
+        stepBoth(&sys, &sysFx, input[i], 1e-9, "propagation");
+    }
+}
+
+/**
+ * Test that a lightly damped notch filter, as used by ikNotchList, stays
+ * close to the floating-point implementation.
+ */
+void testAccuracy() {
+    printf("ikSltiFx_test accuracy\n");
+    /*declare instances */
+    ikSlti sys;
+    ikSltiFx sysFx;
+    ikSlti_init(&sys);
+    ikSltiFx_init(&sysFx);
+
+    /*notch at 0.5 Hz, sampled at 100 Hz, discretised with the bilinear transform */
+    const double T = 0.01;
+    const double w = 2.0 * 3.14159265358979 * 0.5;
+    const double dampDen = 0.5;
+    const double dampNum = 0.01;
+    double a[3], b[3];
+    a[0] = 4.0 + 4.0*dampDen*w*T + w*w*T*T;
+    a[1] = 2.0*w*w*T*T - 8.0;
+    a[2] = 4.0 - 4.0*dampDen*w*T + w*w*T*T;
+    b[0] = 4.0 + 4.0*dampNum*w*T + w*w*T*T;
+    b[1] = a[1];
+    b[2] = 4.0 - 4.0*dampNum*w*T + w*w*T*T;
+    setParamBoth(&sys, &sysFx, a, b, "accuracy");
+
+    /*feed a sum of sines, one at the notch frequency and one away from it */
+    double err2 = 0.0;
+    double ref2 = 0.0;
+    double maxErr = 0.0;
+    int k;
+    const int n = 20000;
+    for (k = 0; k < n; k++) {
+        double t = k * T;
+        double in = 10.0 * sin(w * t) + 5.0 * sin(2.0 * 3.14159265358979 * 3.0 * t);
+        double out = ikSlti_step(&sys, in);
+        double outFx = ikSltiFx_toDouble(&sysFx, ikSltiFx_step(&sysFx, ikSltiFx_fromDouble(&sysFx, in)));
+        err2 += (out - outFx) * (out - outFx);
+        ref2 += out * out;
+        if (fabs(out - outFx) > maxErr) maxErr = fabs(out - outFx);
+    }
+
+    /*see that the error is a small fraction of the output */
+    double rmsErr = sqrt(err2 / n);
+    double rmsRef = sqrt(ref2 / n);
+    if (rmsErr > 1e-3 * rmsRef) printf("%%TEST_FAILED%% time=0 testname=accuracy (ikSltiFx_test) message=RMS error %g too large compared with RMS output %g\n", rmsErr, rmsRef);
+    if (maxErr > 1e-2) printf("%%TEST_FAILED%% time=0 testname=accuracy (ikSltiFx_test) message=maximum error %g too large\n", maxErr);
+    printf("ikSltiFx_test accuracy: RMS error %g, maximum error %g, RMS output %g\n", rmsErr, maxErr, rmsRef);
+}
+
+/**
+ * Test that overflow saturates instead of wrapping around.
+ */
+void testOverflow() {
+    printf("ikSltiFx_test overflow\n");
+    /*declare instance */
+    ikSltiFx sys;
+    ikSltiFx_init(&sys);
+
+    /*an integrator, which will overflow */
+    double a[3] = {1.0, -1.0, 0.0};
+    double b[3] = {1.0, 0.0, 0.0};
+    int err = ikSltiFx_setParam(&sys, a, b);
+    if (0 != err) printf("%%TEST_FAILED%% time=0 testname=overflow (ikSltiFx_test) message=setParam expected to return 0, but returned %d\n", err);
+
+    /*see that the output sticks at the largest value */
+    int32_t out = 0;
+    int k;
+    for (k = 0; k < 10; k++) {
+        out = ikSltiFx_step(&sys, INT32_MAX);
+        if (out < 0) printf("%%TEST_FAILED%% time=0 testname=overflow (ikSltiFx_test) message=output wrapped around to %d at step %d\n", out, k);
+    }
+    if (INT32_MAX != out) printf("%%TEST_FAILED%% time=0 testname=overflow (ikSltiFx_test) message=output expected to be %d, but is %d\n", INT32_MAX, out);
+
+    /*and at the smallest */
+    for (k = 0; k < 10; k++) {
+        out = ikSltiFx_step(&sys, INT32_MIN);
+        if ((k > 1) && (out > 0)) printf("%%TEST_FAILED%% time=0 testname=overflow (ikSltiFx_test) message=output wrapped around to %d at step %d\n", out, k);
+    }
+    if (INT32_MIN != out) printf("%%TEST_FAILED%% time=0 testname=overflow (ikSltiFx_test) message=output expected to be %d, but is %d\n", INT32_MIN, out);
+
+    /*see that conversion saturates too */
+    out = ikSltiFx_fromDouble(&sys, 1e9);
+    if (INT32_MAX != out) printf("%%TEST_FAILED%% time=0 testname=overflow (ikSltiFx_test) message=fromDouble expected to return %d, but returned %d\n", INT32_MAX, out);
+    out = ikSltiFx_fromDouble(&sys, -1e9);
+    if (INT32_MIN != out) printf("%%TEST_FAILED%% time=0 testname=overflow (ikSltiFx_test) message=fromDouble expected to return %d, but returned %d\n", INT32_MIN, out);
+}
+
+int main(int argc, char** argv) {
+    printf("%%SUITE_STARTING%% ikSltiFx_test\n");
+    printf("%%SUITE_STARTED%%\n");
+
+    printf("%%TEST_STARTED%% init (ikSltiFx_test)\n");
+    testInit();
+    printf("%%TEST_FINISHED%% time=0 init (ikSltiFx_test) \n");
+
+    printf("%%TEST_STARTED%% parameters (ikSltiFx_test)\n");
+    testParameters();
+    printf("%%TEST_FINISHED%% time=0 parameters (ikSltiFx_test) \n");
+
+    printf("%%TEST_STARTED%% buffers (ikSltiFx_test)\n");
+    testBuffers();
+    printf("%%TEST_FINISHED%% time=0 buffers (ikSltiFx_test) \n");
+
+    printf("%%TEST_STARTED%% saturation (ikSltiFx_test)\n");
+    testSaturation();
+    printf("%%TEST_FINISHED%% time=0 saturation (ikSltiFx_test) \n");
+
+    printf("%%TEST_STARTED%% errors (ikSltiFx_test)\n");
+    testErrors();
+    printf("%%TEST_FINISHED%% time=0 errors (ikSltiFx_test) \n");
+
+    printf("%%TEST_STARTED%% propagation (ikSltiFx_test)\n");
+    testPropagation();
+    printf("%%TEST_FINISHED%% time=0 propagation (ikSltiFx_test) \n");
+
+    printf("%%TEST_STARTED%% accuracy (ikSltiFx_test)\n");
+    testAccuracy();
+    printf("%%TEST_FINISHED%% time=0 accuracy (ikSltiFx_test) \n");
+
+    printf("%%TEST_STARTED%% overflow (ikSltiFx_test)\n");
+    testOverflow();
+    printf("%%TEST_FINISHED%% time=0 overflow (ikSltiFx_test) \n");
+
+    printf("%%SUITE_FINISHED%% time=0\n");
+
+    return (EXIT_SUCCESS);
+}
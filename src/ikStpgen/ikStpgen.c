@@ -26,7 +26,6 @@ along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
 /* @cond */
 
 #include <string.h>
-#include <math.h>
 #include <stdlib.h>
 #include "../ikStpgen/ikStpgen.h"
 
@@ -37,7 +36,8 @@ int ikStpgen_init(ikStpgen *self, const ikStpgenParams *params) {
     int err = 0;
 
     /* initialise state machine */
-    self->state = 0;
+    self->zone = 0;
+    self->phase = 0;
 
     /* initialise inputs and outputs */
     self->r = 0.0;
@@ -86,6 +86,12 @@ int ikStpgen_init(ikStpgen *self, const ikStpgenParams *params) {
         self->setpoints[0][i] = params->setpoints[0][i];
         self->setpoints[1][i] = params->setpoints[1][i];
     }
+    for (i = 0; i < self->nzones; i++) {
+        self->setpointMid[i] = (self->setpoints[0][i] + self->setpoints[1][i]) / 2;
+    }
+    for (i = 0; i < self->nzones - 1; i++) {
+        self->zoneTransitionSpan[i] = self->setpoints[0][i + 1] - self->setpoints[1][i];
+    }
     
     /* register zone transition hysteresis values*/
     for (i = 0; i < params->nzones - 1; i++) {
@@ -180,8 +186,49 @@ void ikStpgen_initParams(ikStpgenParams *params) {
     params->controlActionLimitRate = 0.0;
 }
 
+/**
+ * (Private) state machine transition
+ */
+typedef struct ikStpgenTransition {
+    int increment; /*state increment, where the state is 4*zone + phase */
+    int hop; /*zone hop: -1 down, 1 up, 0 for transitions that are not zone hops */
+} ikStpgenTransition;
+
+/**
+ * (Private) state machine transition table
+ * 
+ * There is one row per phase. Each row is indexed by the transition
+ * conditions of the phase, as bits in order of priority, so that each
+ * entry is the transition with the highest priority among those whose
+ * conditions are met. Zone hops are only taken if their own conditions,
+ * which depend on the zone transition counters, are also met.
+ * 
+ * Phase 0 conditions:
+ *  bit 0: (zone > 0) && (maxSp < lower setpoint)
+ *  bit 1: (midpoint < feedback) && (maxSp > upper setpoint)
+ *  bit 2: ((lower setpoint + maxSp)/2 < feedback) && (maxSp > lower setpoint)
+ * Phase 1 conditions:
+ *  bit 0: maxSp > upper setpoint
+ *  bit 1: ((lower setpoint + maxSp)/2 > feedback) || (maxSp < lower setpoint)
+ * Phase 2 conditions:
+ *  bit 0: maxSp < upper setpoint
+ *  bit 1: midpoint > feedback
+ */
+const ikStpgenTransition ikStpgen_transitions[3][8] = {
+    {{-2, -1}, {-2, 0}, {2, 0}, {-2, 0}, {1, 0}, {-2, 0}, {2, 0}, {-2, 0}},
+    {{0, 0}, {1, 0}, {-1, 0}, {1, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+    {{2, 1}, {-1, 0}, {-2, 0}, {-1, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}}
+};
+
 double ikStpgen_step(ikStpgen *self, double maxSp, double feedback, double conAct, double minCon, double maxCon) {
     int zone;
+    int k;
+    int conditions;
+    int increment;
+    int state;
+    double lo;
+    double hi;
+    const ikStpgenTransition *t;
 
     /* register inputs */
     self->feedback = feedback;
@@ -205,140 +252,88 @@ double ikStpgen_step(ikStpgen *self, double maxSp, double feedback, double conAc
         return self->r;
     }
 
-    /* update state */
-    zone = (int) floor(self->state / 4 + 0.1);
-    switch (self->state - 4 * zone) {
+    /* evaluate the transition conditions of the current phase */
+    zone = self->zone;
+    lo = self->setpoints[0][zone];
+    hi = self->setpoints[1][zone];
+    switch (self->phase) {
         case 0:
-            if ((zone > 0) && (maxSp < self->setpoints[0][zone])) {
-                self->state -= 2;
-                break;
-            }
-
-            if (((self->setpoints[0][zone] + self->setpoints[1][zone]) / 2 < self->feedback) && (maxSp > self->setpoints[1][zone])) {
-                self->state += 2;
-                break;
-            }
-
-            if (((self->setpoints[0][zone] + maxSp) / 2 < self->feedback) && (maxSp > self->setpoints[0][zone])) {
-                self->state += 1;
-                break;
-            }
-
-            if ((zone > 0)
-                    &&
-                    ((self->controlAction - self->uopt)*self->olsign > self->zoneTransitionHysteresis[zone-1])
-                    &&
-                    (self->iZoneTransitionSteps[zone - 1] >= self->nZoneTransitionSteps[zone - 1])
-                    &&
-                    (0 >= self->iZoneTransitionLockSteps[zone - 1])) {
-                self->state -= 2;
-                self->iZoneTransitionLockSteps[zone - 1] = self->nZoneTransitionLockSteps[zone - 1];
-                break;
-            }
+            conditions = ((zone > 0) && (maxSp < lo))
+                    | (((self->setpointMid[zone] < feedback) && (maxSp > hi)) << 1)
+                    | ((((lo + maxSp) / 2 < feedback) && (maxSp > lo)) << 2);
             break;
-
         case 1:
-            if (maxSp > self->setpoints[1][zone]) {
-                self->state += 1;
-                break;
-            }
-
-            if (((self->setpoints[0][zone] + maxSp) / 2 > self->feedback) || (maxSp < self->setpoints[0][zone])) {
-                self->state -= 1;
-                break;
-            }
+            conditions = (maxSp > hi)
+                    | ((((lo + maxSp) / 2 > feedback) || (maxSp < lo)) << 1);
             break;
-
-        case 2:
-            if (maxSp < self->setpoints[1][zone]) {
-                self->state -= 1;
-                break;
-            }
-
-            if ((self->setpoints[0][zone] + self->setpoints[1][zone]) / 2 > self->feedback) {
-                self->state -= 2;
-                break;
-            }
-
-            if ((zone < self->nzones - 1)
-                    &&
-                    ((self->uopt - self->controlAction)*self->olsign > self->zoneTransitionHysteresis[zone])
-                    &&
-                    (0 >= self->iZoneTransitionSteps[zone])
-                    &&
-                    (!self->zoneTransitionLocked[zone] || (0 >= self->iZoneTransitionLockSteps[zone]))
-                    &&
-                    (maxSp > self->setpoints[0][zone+1])) {
-                self->state += 2;
-                self->iZoneTransitionLockSteps[zone] = self->nZoneTransitionLockSteps[zone];
-                self->zoneTransitionLocked[zone] = 1;
-                break;
-            }
+        default:
+            conditions = (maxSp < hi)
+                    | ((self->setpointMid[zone] > feedback) << 1);
             break;
     }
 
-    /* do what has to be done depending on the state */
-    zone = (int) floor(self->state / 4 + 0.1);
-    switch (self->state - 4 * zone) {
+    /* update state */
+    t = &(ikStpgen_transitions[self->phase][conditions]);
+    increment = t->increment;
+    if (0 > t->hop) {
+        k = zone - 1;
+        if ((zone > 0)
+                &&
+                ((self->controlAction - self->uopt)*self->olsign > self->zoneTransitionHysteresis[k])
+                &&
+                (self->iZoneTransitionSteps[k] >= self->nZoneTransitionSteps[k])
+                &&
+                (0 >= self->iZoneTransitionLockSteps[k])) {
+            self->iZoneTransitionLockSteps[k] = self->nZoneTransitionLockSteps[k];
+        } else {
+            increment = 0;
+        }
+    }
+    if (0 < t->hop) {
+        k = zone;
+        if ((k < self->nzones - 1)
+                &&
+                ((self->uopt - self->controlAction)*self->olsign > self->zoneTransitionHysteresis[k])
+                &&
+                (0 >= self->iZoneTransitionSteps[k])
+                &&
+                (!self->zoneTransitionLocked[k] || (0 >= self->iZoneTransitionLockSteps[k]))
+                &&
+                (maxSp > self->setpoints[0][k + 1])) {
+            self->iZoneTransitionLockSteps[k] = self->nZoneTransitionLockSteps[k];
+            self->zoneTransitionLocked[k] = 1;
+        } else {
+            increment = 0;
+        }
+    }
+    state = 4 * zone + self->phase + increment;
+    self->zone = state / 4;
+    self->phase = state % 4;
+
+    /* update zone transition counters and setpoint depending on the state */
+    zone = self->zone;
+    switch (self->phase) {
         case 0:
             if (0 < zone) {
-                if ((self->controlAction - self->uopt)*self->olsign > self->zoneTransitionHysteresis[zone-1]) {
-                    if ((self->iZoneTransitionSteps[zone - 1] >= self->nZoneTransitionSteps[zone - 1])
+                k = zone - 1;
+                if ((self->controlAction - self->uopt)*self->olsign > self->zoneTransitionHysteresis[k]) {
+                    if ((self->iZoneTransitionSteps[k] >= self->nZoneTransitionSteps[k])
                             &&
-                            (0 < self->iZoneTransitionLockSteps[zone - 1]))
-                        self->iZoneTransitionLockSteps[zone - 1]--;
+                            (0 < self->iZoneTransitionLockSteps[k]))
+                        self->iZoneTransitionLockSteps[k]--;
                 } else {
-                    self->iZoneTransitionLockSteps[zone - 1] = self->nZoneTransitionLockSteps[zone - 1];
+                    self->iZoneTransitionLockSteps[k] = self->nZoneTransitionLockSteps[k];
                 }
-                if (self->iZoneTransitionSteps[zone - 1] < self->nZoneTransitionSteps[zone - 1]) self->iZoneTransitionSteps[zone - 1]++;
+                if (self->iZoneTransitionSteps[k] < self->nZoneTransitionSteps[k]) self->iZoneTransitionSteps[k]++;
             }
             if (0 < zone && self->nZoneTransitionSteps[zone - 1] > 0) {
-                self->r = self->setpoints[1][zone - 1] + ((double)self->iZoneTransitionSteps[zone - 1]) / self->nZoneTransitionSteps[zone - 1] * (self->setpoints[0][zone] - self->setpoints[1][zone - 1]);
+                self->r = self->setpoints[1][zone - 1] + ((double)self->iZoneTransitionSteps[zone - 1]) / self->nZoneTransitionSteps[zone - 1] * self->zoneTransitionSpan[zone - 1];
             } else {
                 self->r = self->setpoints[0][zone];
             }
-            if (0 > self->olsign) {
-                self->maxCon = self->uopt;
-                if (0.0 < self->controlActionLimitRate) {
-                    self->maxCon = self->maxCon > conAct - self->controlActionLimitRate ? self->maxCon : conAct - self->controlActionLimitRate;
-                    self->maxCon = self->maxCon < conAct + self->controlActionLimitRate ? self->maxCon : conAct + self->controlActionLimitRate;
-                }
-                self->minCon = minCon;
-                self->maxCon = self->maxCon > self->minCon ? self->maxCon : self->minCon;
-            } else {
-                self->maxCon = maxCon;
-                self->minCon = self->uopt;
-                if (0.0 < self->controlActionLimitRate) {
-                    self->minCon = self->minCon < conAct + self->controlActionLimitRate ? self->minCon : conAct + self->controlActionLimitRate;
-                    self->minCon = self->minCon > conAct - self->controlActionLimitRate ? self->minCon : conAct - self->controlActionLimitRate;
-                }
-                self->minCon = self->minCon < self->maxCon ? self->minCon : self->maxCon;
-            }
-            if (0 >= zone && maxSp < self->setpoints[0][0]) {
-                self->r = maxSp;
-                self->maxCon = maxCon;
-                self->minCon = minCon;
-            }
             break;
         case 1:
             self->r = maxSp;
-            if (0 > self->olsign) {
-                self->maxCon = maxCon;
-                self->minCon = self->uopt;
-                if (0.0 < self->controlActionLimitRate) {
-                    self->minCon = self->minCon < conAct + self->controlActionLimitRate ? self->minCon : conAct + self->controlActionLimitRate;
-                    self->minCon = self->minCon > conAct - self->controlActionLimitRate ? self->minCon : conAct - self->controlActionLimitRate;
-                }
-                self->minCon = self->minCon < self->maxCon ? self->minCon : self->maxCon;
-            } else {
-                self->maxCon = self->uopt;
-                if (0.0 < self->controlActionLimitRate) {
-                    self->maxCon = self->maxCon > conAct - self->controlActionLimitRate ? self->maxCon : conAct - self->controlActionLimitRate;
-                    self->maxCon = self->maxCon < conAct + self->controlActionLimitRate ? self->maxCon : conAct + self->controlActionLimitRate;
-                }
-                self->minCon = minCon;
-                self->maxCon = self->maxCon > self->minCon ? self->maxCon : self->minCon;
-            }
             break;
         case 2:
             if (zone < self->nzones - 1) {
@@ -353,30 +348,41 @@ double ikStpgen_step(ikStpgen *self, double maxSp, double feedback, double conAc
                 if (0 < self->iZoneTransitionSteps[zone]) self->iZoneTransitionSteps[zone]--;
             }
             if (self->nzones - 1 > zone && self->nZoneTransitionSteps[zone] > 0) {
-                self->r = self->setpoints[1][zone] + ((double)self->iZoneTransitionSteps[zone]) / self->nZoneTransitionSteps[zone] * (self->setpoints[0][zone + 1] - self->setpoints[1][zone]);
+                self->r = self->setpoints[1][zone] + ((double)self->iZoneTransitionSteps[zone]) / self->nZoneTransitionSteps[zone] * self->zoneTransitionSpan[zone];
             } else {
                 self->r = self->setpoints[1][zone];
             }
-            if (0 > self->olsign) {
-                self->maxCon = maxCon;
-                self->minCon = self->uopt;
-                if (0.0 < self->controlActionLimitRate) {
-                    self->minCon = self->minCon < conAct + self->controlActionLimitRate ? self->minCon : conAct + self->controlActionLimitRate;
-                    self->minCon = self->minCon > conAct - self->controlActionLimitRate ? self->minCon : conAct - self->controlActionLimitRate;
-                }
-                self->minCon = self->minCon < self->maxCon ? self->minCon : self->maxCon;
-            } else {
-                self->maxCon = self->uopt;
-                if (0.0 < self->controlActionLimitRate) {
-                    self->maxCon = self->maxCon > conAct - self->controlActionLimitRate ? self->maxCon : conAct - self->controlActionLimitRate;
-                    self->maxCon = self->maxCon < conAct + self->controlActionLimitRate ? self->maxCon : conAct + self->controlActionLimitRate;
-                }
-                self->minCon = minCon;
-                self->maxCon = self->maxCon > self->minCon ? self->maxCon : self->minCon;
-            }
             break;
     }
 
+    /* set control action limits, with the preferred control action as maximum
+     in phase 0 for negative open loop gains and in phases 1 and 2 for positive ones,
+     and as minimum otherwise */
+    if ((0 == self->phase) == (0 > self->olsign)) {
+        self->maxCon = self->uopt;
+        if (0.0 < self->controlActionLimitRate) {
+            self->maxCon = self->maxCon > conAct - self->controlActionLimitRate ? self->maxCon : conAct - self->controlActionLimitRate;
+            self->maxCon = self->maxCon < conAct + self->controlActionLimitRate ? self->maxCon : conAct + self->controlActionLimitRate;
+        }
+        self->minCon = minCon;
+        self->maxCon = self->maxCon > self->minCon ? self->maxCon : self->minCon;
+    } else {
+        self->maxCon = maxCon;
+        self->minCon = self->uopt;
+        if (0.0 < self->controlActionLimitRate) {
+            self->minCon = self->minCon < conAct + self->controlActionLimitRate ? self->minCon : conAct + self->controlActionLimitRate;
+            self->minCon = self->minCon > conAct - self->controlActionLimitRate ? self->minCon : conAct - self->controlActionLimitRate;
+        }
+        self->minCon = self->minCon < self->maxCon ? self->minCon : self->maxCon;
+    }
+
+    /* below the lowest zone, wave the maximum setpoint through */
+    if (0 == self->phase && 0 >= zone && maxSp < self->setpoints[0][0]) {
+        self->r = maxSp;
+        self->maxCon = maxCon;
+        self->minCon = minCon;
+    }
+
     self->maxCon = self->maxCon < maxCon ? self->maxCon : maxCon;
     self->minCon = self->minCon > minCon ? self->minCon : minCon;
 
@@ -428,4 +434,31 @@ int ikStpgen_getOutput(const ikStpgen *self, double *output, const char *name) {
 }
 
 
+void ikStpgen_checkpoint(ikStpgen *self, ikCheckpoint *cp) {
+    int i;
+    
+    /* zone and phase */
+    ikCheckpoint_check(cp, self->nzones);
+    ikCheckpoint_intRange(cp, &(self->zone), 0, self->nzones > 1 ? self->nzones - 1 : 0);
+    ikCheckpoint_intRange(cp, &(self->phase), 0, 2);
+    
+    /* zone transition counters and locks */
+    for (i = 0; i < self->nzones - 1; i++) {
+        ikCheckpoint_int(cp, &(self->iZoneTransitionSteps[i]));
+        ikCheckpoint_int(cp, &(self->iZoneTransitionLockSteps[i]));
+        ikCheckpoint_int(cp, &(self->zoneTransitionLocked[i]));
+    }
+    
+    /* signals */
+    ikCheckpoint_double(cp, &(self->uopt));
+    ikCheckpoint_double(cp, &(self->r));
+    ikCheckpoint_double(cp, &(self->minCon));
+    ikCheckpoint_double(cp, &(self->maxCon));
+    ikCheckpoint_double(cp, &(self->feedback));
+    ikCheckpoint_double(cp, &(self->controlAction));
+    ikCheckpoint_double(cp, &(self->externalMaximumControlAction));
+    ikCheckpoint_double(cp, &(self->externalMinimumControlAction));
+    ikCheckpoint_double(cp, &(self->externalMaximumSetpoint));
+}
+
 /* @endcond */
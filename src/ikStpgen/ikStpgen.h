@@ -30,6 +30,8 @@ along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
 extern "C" {
 #endif
 
+#include "ikCheckpoint.h"
+
 #define IKSTPGEN_NZONEMAX 8
     
     /**
@@ -73,6 +75,7 @@ extern "C" {
      * @li @link ikStpgen_init @endlink initialise an instance
      * @li @link ikStpgen_step @endlink execute periodic calculations
      * @li @link ikStpgen_getOutput @endlink get output value
+     * @li @link ikStpgen_checkpoint @endlink save or restore runtime state
      */
     typedef struct ikStpgen {
         /**
@@ -81,11 +84,14 @@ extern "C" {
         /* @cond */
         double      *pUopt;
         double      uopt;
-        int         state;
+        int         zone;
+        int         phase;
         int         olsign;
         int         nzones;
         double      setpoints [2][IKSTPGEN_NZONEMAX];
+        double      setpointMid [IKSTPGEN_NZONEMAX];
         double      zoneTransitionHysteresis [IKSTPGEN_NZONEMAX - 1];
+        double      zoneTransitionSpan [IKSTPGEN_NZONEMAX - 1];
         int         nZoneTransitionSteps [IKSTPGEN_NZONEMAX - 1];
         int         iZoneTransitionSteps [IKSTPGEN_NZONEMAX - 1];
         int         nZoneTransitionLockSteps [IKSTPGEN_NZONEMAX - 1];
@@ -182,6 +188,14 @@ extern "C" {
      * @li -1: invalid signal name
      */
     int ikStpgen_getOutput(const ikStpgen *self, double *output, const char *name);
+    
+    /**
+     * Save or restore runtime state, i.e. the current zone and phase, the
+     * zone transition counters and locks, and the latest signal values
+     * @param self setpoint generator instance
+     * @param cp checkpoint blob writer or reader
+     */
+    void ikStpgen_checkpoint(ikStpgen *self, ikCheckpoint *cp);
 
 
 #ifdef __cplusplus
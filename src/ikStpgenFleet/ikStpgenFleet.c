@@ -0,0 +1,453 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikStpgenFleet.c
+ * 
+ * @brief Class ikStpgenFleet implementation
+ */
+
+/* @cond */
+
+#include <string.h>
+#include <stdlib.h>
+#include "ikStpgenFleet.h"
+
+/* number of double and int arrays with one row per setpoint generator */
+#define IKSTPGENFLEET_NDOUBLES (7 + 3 * IKSTPGEN_NZONEMAX + (IKSTPGEN_NZONEMAX - 1))
+#define IKSTPGENFLEET_NINTS (10 + 5 * (IKSTPGEN_NZONEMAX - 1))
+
+int ikStpgenFleet_init(ikStpgenFleet *self, int n) {
+    int i;
+    int err;
+    double *d;
+    int *k;
+    ikStpgenParams params;
+
+    /* check the number of setpoint generators */
+    if (1 > n) return -1;
+
+    /* allocate memory */
+    self->priv.doubles = calloc((size_t) n * IKSTPGENFLEET_NDOUBLES, sizeof (double));
+    self->priv.ints = calloc((size_t) n * IKSTPGENFLEET_NINTS, sizeof (int));
+    if (NULL == self->priv.doubles || NULL == self->priv.ints) {
+        free(self->priv.doubles);
+        free(self->priv.ints);
+        self->priv.doubles = NULL;
+        self->priv.ints = NULL;
+        return -2;
+    }
+    self->priv.n = n;
+
+    /* lay out the arrays */
+    d = self->priv.doubles;
+    self->in.maxSp = d; d += n;
+    self->in.feedback = d; d += n;
+    self->in.controlAction = d; d += n;
+    self->in.minCon = d; d += n;
+    self->in.maxCon = d; d += n;
+    self->in.preferredControlAction = d; d += n;
+    self->priv.controlActionLimitRate = d; d += n;
+    self->priv.setpointLo = d; d += n * IKSTPGEN_NZONEMAX;
+    self->priv.setpointHi = d; d += n * IKSTPGEN_NZONEMAX;
+    self->priv.setpointMid = d; d += n * IKSTPGEN_NZONEMAX;
+    self->priv.hysteresis = d; d += n * (IKSTPGEN_NZONEMAX - 1);
+    k = self->priv.ints;
+    self->priv.zone = k; k += n;
+    self->priv.phase = k; k += n;
+    self->priv.olsign = k; k += n;
+    self->priv.nzones = k; k += n;
+    self->priv.nSteps = k; k += n * (IKSTPGEN_NZONEMAX - 1);
+    self->priv.iSteps = k; k += n * (IKSTPGEN_NZONEMAX - 1);
+    self->priv.nLockSteps = k; k += n * (IKSTPGEN_NZONEMAX - 1);
+    self->priv.iLockSteps = k; k += n * (IKSTPGEN_NZONEMAX - 1);
+    self->priv.locked = k; k += n * (IKSTPGEN_NZONEMAX - 1);
+    self->priv.oldRow = k; k += n;
+    self->priv.oldRowILockSteps = k; k += n;
+    self->priv.oldRowLocked = k; k += n;
+    self->priv.newRow = k; k += n;
+    self->priv.newRowISteps = k; k += n;
+    self->priv.newRowILockSteps = k; k += n;
+
+    /* the outputs are not part of the state, allocate them separately */
+    self->out.setpoint = calloc((size_t) n * 3, sizeof (double));
+    if (NULL == self->out.setpoint) {
+        ikStpgenFleet_delete(self);
+        return -2;
+    }
+    self->out.maxCon = self->out.setpoint + n;
+    self->out.minCon = self->out.setpoint + 2 * n;
+
+    /* initialise all setpoint generators with default parameters */
+    ikStpgen_initParams(&params);
+    for (i = 0; i < n; i++) {
+        err = ikStpgenFleet_setParams(self, i, &params);
+        if (err) {
+            ikStpgenFleet_delete(self);
+            return -2;
+        }
+    }
+
+    return 0;
+}
+
+int ikStpgenFleet_setParams(ikStpgenFleet *self, int i, const ikStpgenParams *params) {
+    const int n = self->priv.n;
+    int z;
+    int err;
+    ikStpgen sg;
+
+    /* check the index */
+    if (0 > i || n <= i) return -1;
+
+    /* let the scalar setpoint generator check and register the parameters */
+    err = ikStpgen_init(&sg, params);
+
+    /* copy them over */
+    self->priv.zone[i] = 0;
+    self->priv.phase[i] = 0;
+    self->priv.olsign[i] = sg.olsign;
+    self->priv.nzones[i] = sg.nzones;
+    self->priv.controlActionLimitRate[i] = sg.controlActionLimitRate;
+    for (z = 0; z < IKSTPGEN_NZONEMAX; z++) {
+        self->priv.setpointLo[z * n + i] = z < sg.nzones ? sg.setpoints[0][z] : 0.0;
+        self->priv.setpointHi[z * n + i] = z < sg.nzones ? sg.setpoints[1][z] : 0.0;
+        self->priv.setpointMid[z * n + i] = (self->priv.setpointLo[z * n + i] + self->priv.setpointHi[z * n + i]) / 2;
+    }
+    for (z = 0; z < IKSTPGEN_NZONEMAX - 1; z++) {
+        self->priv.hysteresis[z * n + i] = z < sg.nzones - 1 ? sg.zoneTransitionHysteresis[z] : 0.0;
+        self->priv.nSteps[z * n + i] = z < sg.nzones - 1 ? sg.nZoneTransitionSteps[z] : 0;
+        self->priv.iSteps[z * n + i] = 0;
+        self->priv.nLockSteps[z * n + i] = z < sg.nzones - 1 ? sg.nZoneTransitionLockSteps[z] : 0;
+        self->priv.iLockSteps[z * n + i] = 0;
+        self->priv.locked[z * n + i] = z < sg.nzones - 1 ? sg.zoneTransitionLocked[z] : 0;
+    }
+
+    /* reset inputs and outputs */
+    self->in.maxSp[i] = 0.0;
+    self->in.feedback[i] = 0.0;
+    self->in.controlAction[i] = 0.0;
+    self->in.minCon[i] = 0.0;
+    self->in.maxCon[i] = 0.0;
+    self->in.preferredControlAction[i] = 0.0;
+    self->out.setpoint[i] = 0.0;
+    self->out.maxCon[i] = 0.0;
+    self->out.minCon[i] = 0.0;
+
+    return err;
+}
+
+/**
+ * (Private) step the state machines and compute the outputs
+ * 
+ * The arrays are passed as restrict-qualified parameters, so that the
+ * compiler may take the indexed loads out of order with the stores.
+ */
+void ikStpgenFleet_stepStates(int n,
+        const double *restrict inMaxSp, const double *restrict inFeedback,
+        const double *restrict inControlAction, const double *restrict inMinCon,
+        const double *restrict inMaxCon, const double *restrict inUopt,
+        double *restrict outSetpoint, double *restrict outMaxCon, double *restrict outMinCon,
+        int *restrict zones, int *restrict phases,
+        const int *restrict olsigns, const int *restrict nzoness, const double *restrict rates,
+        const double *restrict setpointLo, const double *restrict setpointHi,
+        const double *restrict setpointMid, const double *restrict hysteresis,
+        const int *restrict nSteps, const int *restrict iSteps,
+        const int *restrict nLockSteps, const int *restrict iLockSteps, const int *restrict locked,
+        int *restrict oldRow, int *restrict oldRowILockSteps, int *restrict oldRowLocked,
+        int *restrict newRow, int *restrict newRowISteps, int *restrict newRowILockSteps) {
+    int i;
+
+    for (i = 0; i < n; i++) {
+        /* register inputs */
+        const double maxSp = inMaxSp[i];
+        const double fb = inFeedback[i];
+        const double conAct = inControlAction[i];
+        const double minCon = inMinCon[i];
+        const double maxCon = inMaxCon[i];
+        const double uopt = inUopt[i];
+        const int nzones = nzoness[i];
+        const int olsign = olsigns[i];
+        const double rate = rates[i];
+        const double eDown = (conAct - uopt) * olsign;
+        const double eUp = (uopt - conAct) * olsign;
+        int zone = zones[i];
+        int phase = phases[i];
+        int hasDown;
+        int hasUp;
+        int kt;
+        int t0a, t0b, t0c, t0d, t1a, t1b, t2a, t2b, t2c;
+        int delta;
+        int fire;
+        int state;
+        int k;
+        int valid;
+        int iSt, nSt, iLk, nLk, lck, dec, iLkK, den;
+        double lo, hi, mid, loNext, hys, e;
+        double base, target;
+        int interp;
+        int lower, hold, upper;
+        double typeAMax, typeAMin, typeBMax, typeBMin;
+        double r, maxC, minC;
+        int typeA;
+        int wave;
+        int above;
+        int limited;
+
+        /* gather the zone values, with indices clamped so that every load is valid */
+        hasDown = zone > 0;
+        hasUp = zone < nzones - 1;
+        lo = setpointLo[zone * n + i];
+        hi = setpointHi[zone * n + i];
+        mid = setpointMid[zone * n + i];
+        loNext = setpointLo[(zone + hasUp) * n + i];
+        kt = 0 == phase ? zone - hasDown : zone * hasUp;
+        hys = hysteresis[kt * n + i];
+        iSt = iSteps[kt * n + i];
+        nSt = nSteps[kt * n + i];
+        iLk = iLockSteps[kt * n + i];
+        nLk = nLockSteps[kt * n + i];
+        lck = locked[kt * n + i];
+
+        /* evaluate all transition conditions, as masks */
+        t0a = hasDown & (maxSp < lo);
+        t0b = (mid < fb) & (maxSp > hi);
+        t0c = ((lo + maxSp) / 2 < fb) & (maxSp > lo);
+        t0d = hasDown & (eDown > hys) & (iSt >= nSt) & (0 >= iLk);
+        t1a = maxSp > hi;
+        t1b = ((lo + maxSp) / 2 > fb) | (maxSp < lo);
+        t2a = maxSp < hi;
+        t2b = mid > fb;
+        t2c = hasUp & (eUp > hys) & (0 >= iSt) & ((0 == lck) | (0 >= iLk)) & (maxSp > loNext);
+
+        /* select the transition, with the priorities of ikStpgen, as the */
+        /* sum of the zone and phase steps of the conditions which hold */
+        t0b = (0 == t0a) & t0b;
+        t0c = (0 == t0a) & (0 == t0b) & t0c;
+        t0d = (0 == t0a) & (0 == t0b) & (0 == t0c) & t0d;
+        t1b = (0 == t1a) & t1b;
+        t2b = (0 == t2a) & t2b;
+        t2c = (0 == t2a) & (0 == t2b) & t2c;
+        delta = (0 < nzones) * ((0 == phase) * (2 * t0b + t0c - 2 * (t0a + t0d))
+                + (1 == phase) * (t1a - t1b)
+                + (2 == phase) * (2 * (t2c - t2b) - t2a));
+        fire = (0 < nzones) & (((0 == phase) & t0d) | ((2 == phase) & t2c));
+
+        /* lock the transition taken, if any; the selections between */
+        /* loaded integers are made arithmetically, since the compiler */
+        /* would turn a conditional expression back into a conditional load */
+        oldRow[i] = kt;
+        iLk += fire * (nLk - iLk);
+        oldRowILockSteps[i] = iLk;
+        oldRowLocked[i] = lck | (fire & (2 == phase));
+
+        /* move to the new state */
+        state = 4 * zone + phase + delta;
+        zone = state >> 2;
+        phase = state & 3;
+        zones[i] = zone;
+        phases[i] = phase;
+
+        /* gather the values of the new state */
+        hasDown = zone > 0;
+        hasUp = zone < nzones - 1;
+        upper = phase >> 1;
+        hold = phase & 1;
+        lower = 1 - (upper | hold);
+        lo = setpointLo[zone * n + i];
+        valid = (0 < nzones) & ((lower & hasDown) | (upper & hasUp));
+        k = zone - hasDown + (1 - lower) * (hasDown - zone + zone * hasUp);
+        hys = hysteresis[k * n + i];
+        iLkK = iLockSteps[k * n + i];
+        iLkK += (k == kt) * (iLk - iLkK);
+        iSt = iSteps[k * n + i];
+        nSt = nSteps[k * n + i];
+        nLk = nLockSteps[k * n + i];
+
+        /* update the zone transition counters */
+        e = 0 == phase ? eDown : eUp;
+        above = e > hys;
+        dec = ((0 == phase) & (iSt >= nSt)) | ((0 != phase) & (0 >= iSt));
+        iLkK += valid * (above * -(dec & (0 < iLkK)) + (0 == above) * (nLk - iLkK));
+        iSt += valid * ((0 == phase) * (iSt < nSt) - (0 != phase) * (0 < iSt));
+        newRow[i] = valid ? k : -1;
+        newRowISteps[i] = iSt;
+        newRowILockSteps[i] = iLkK;
+
+        /* compute the setpoint, as the value of the phase, or the external */
+        /* maximum setpoint when waved through, less an interpolation term. */
+        /* The term is worked out whichever the case, between the upper */
+        /* setpoint of a zone and the lower one of the same zone, which */
+        /* makes it +0.0, or of the zone the transition goes to, so that */
+        /* the compiler cannot move the arithmetic into a branch. */
+        /* base - f * (base - target) is the same, bit for bit, as */
+        /* base + f * (target - base) in ikStpgen */
+        wave = (0 == phase) & (0 == hasDown) & (maxSp < lo);
+        interp = (0 < nzones) & (0 == wave) & (0 < nSt) & ((lower & hasDown & valid) | (upper & hasUp));
+        base = setpointHi[(zone - interp * lower) * n + i];
+        target = setpointLo[(zone + interp * upper) * n + i];
+        r = upper ? base : target;
+        r = hold ? maxSp : r;
+        r = (0 < nzones) & (0 == wave) ? r : maxSp;
+        r = interp ? base : r;
+        den = nSt + (1 > nSt) * (1 - nSt);
+        r = r - ((double) (interp * iSt)) / den * (base - target);
+
+        /* compute both kinds of control action limits */
+        limited = 0.0 < rate;
+        typeAMax = uopt > conAct - rate ? uopt : conAct - rate;
+        typeAMax = typeAMax < conAct + rate ? typeAMax : conAct + rate;
+        typeAMax = limited ? typeAMax : uopt;
+        typeAMin = minCon;
+        typeAMax = typeAMax > typeAMin ? typeAMax : typeAMin;
+        typeBMax = maxCon;
+        typeBMin = uopt < conAct + rate ? uopt : conAct + rate;
+        typeBMin = typeBMin > conAct - rate ? typeBMin : conAct - rate;
+        typeBMin = limited ? typeBMin : uopt;
+        typeBMin = typeBMin < typeBMax ? typeBMin : typeBMax;
+        typeA = (0 == phase) == (0 > olsign);
+        maxC = typeA ? typeAMax : typeBMax;
+        minC = typeA ? typeAMin : typeBMin;
+
+        /* below the lowest zone, wave the maximum setpoint through */
+        maxC = wave ? maxCon : maxC;
+        minC = wave ? minCon : minC;
+
+        /* apply the external control action limits */
+        maxC = maxC < maxCon ? maxC : maxCon;
+        minC = minC > minCon ? minC : minCon;
+
+        /* if there are no zones, wave the inputs through */
+        outSetpoint[i] = r;
+        outMaxCon[i] = 0 < nzones ? maxC : maxCon;
+        outMinCon[i] = 0 < nzones ? minC : minCon;
+    }
+}
+
+/**
+ * (Private) write the updated transition rows back
+ */
+void ikStpgenFleet_stepRows(int n, int *restrict iLockSteps, int *restrict iSteps, int *restrict locked,
+        const int *restrict oldRow, const int *restrict oldRowILockSteps, const int *restrict oldRowLocked,
+        const int *restrict newRow, const int *restrict newRowISteps, const int *restrict newRowILockSteps) {
+    const int nrows = IKSTPGEN_NZONEMAX - 1;
+    int i;
+    int z;
+
+    /* a row at a time */
+    for (z = 0; z < nrows; z++) {
+        int *iLockStepsRow = iLockSteps + z * n;
+        int *iStepsRow = iSteps + z * n;
+        int *lockedRow = locked + z * n;
+
+        for (i = 0; i < n; i++) {
+            const int iLkOld = oldRowILockSteps[i];
+            const int lckOld = oldRowLocked[i];
+            const int iLkNew = newRowILockSteps[i];
+            const int iStNew = newRowISteps[i];
+            int iLk = iLockStepsRow[i];
+            int iSt = iStepsRow[i];
+            int lck = lockedRow[i];
+
+            iLk = z == oldRow[i] ? iLkOld : iLk;
+            iLockStepsRow[i] = z == newRow[i] ? iLkNew : iLk;
+            iStepsRow[i] = z == newRow[i] ? iStNew : iSt;
+            lockedRow[i] = z == oldRow[i] ? lckOld : lck;
+        }
+    }
+}
+
+void ikStpgenFleet_step(ikStpgenFleet *self) {
+
+    /* step the state machines, reading the zone and transition rows with */
+    /* unconditional indexed loads, and leaving the updates of the */
+    /* transition rows for a second pass, since these would be scattered */
+    ikStpgenFleet_stepStates(self->priv.n, self->in.maxSp, self->in.feedback, self->in.controlAction,
+            self->in.minCon, self->in.maxCon, self->in.preferredControlAction,
+            self->out.setpoint, self->out.maxCon, self->out.minCon,
+            self->priv.zone, self->priv.phase,
+            self->priv.olsign, self->priv.nzones, self->priv.controlActionLimitRate,
+            self->priv.setpointLo, self->priv.setpointHi, self->priv.setpointMid, self->priv.hysteresis,
+            self->priv.nSteps, self->priv.iSteps, self->priv.nLockSteps, self->priv.iLockSteps, self->priv.locked,
+            self->priv.oldRow, self->priv.oldRowILockSteps, self->priv.oldRowLocked,
+            self->priv.newRow, self->priv.newRowISteps, self->priv.newRowILockSteps);
+
+    /* write the updated transition rows back */
+    ikStpgenFleet_stepRows(self->priv.n, self->priv.iLockSteps, self->priv.iSteps, self->priv.locked,
+            self->priv.oldRow, self->priv.oldRowILockSteps, self->priv.oldRowLocked,
+            self->priv.newRow, self->priv.newRowISteps, self->priv.newRowILockSteps);
+}
+
+int ikStpgenFleet_getOutput(const ikStpgenFleet *self, double *output, int i, const char *name) {
+
+    /* check the index */
+    if (0 > i || self->priv.n <= i) return -3;
+
+    /* pick up the signals */
+    if (!strcmp(name, "feedback")) {
+        *output = self->in.feedback[i];
+        return 0;
+    }
+    if (!strcmp(name, "control action")) {
+        *output = self->in.controlAction[i];
+        return 0;
+    }
+    if (!strcmp(name, "external maximum control action")) {
+        *output = self->in.maxCon[i];
+        return 0;
+    }
+    if (!strcmp(name, "external minimum control action")) {
+        *output = self->in.minCon[i];
+        return 0;
+    }
+    if (!strcmp(name, "external maximum setpoint")) {
+        *output = self->in.maxSp[i];
+        return 0;
+    }
+    if (!strcmp(name, "setpoint")) {
+        *output = self->out.setpoint[i];
+        return 0;
+    }
+    if (!strcmp(name, "maximum control action")) {
+        *output = self->out.maxCon[i];
+        return 0;
+    }
+    if (!strcmp(name, "minimum control action")) {
+        *output = self->out.minCon[i];
+        return 0;
+    }
+    if (!strcmp(name, "preferred control action")) {
+        *output = self->in.preferredControlAction[i];
+        return 0;
+    }
+
+    return -1;
+}
+
+void ikStpgenFleet_delete(ikStpgenFleet *self) {
+    free(self->priv.doubles);
+    free(self->priv.ints);
+    free(self->out.setpoint);
+    self->priv.doubles = NULL;
+    self->priv.ints = NULL;
+    self->out.setpoint = NULL;
+    self->priv.n = 0;
+}
+
+/* @endcond */
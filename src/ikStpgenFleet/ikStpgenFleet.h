@@ -0,0 +1,202 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikStpgenFleet.h
+ * 
+ * @brief Class ikStpgenFleet interface
+ */
+
+#ifndef IKSTPGENFLEET_H
+#define IKSTPGENFLEET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ikStpgen.h"
+
+    /**
+     * @struct ikStpgenFleetInputs
+     * @brief Setpoint generator fleet inputs
+     * 
+     * Instances of ikStpgenFleet take inputs via a structure of this type:
+     * @link ikStpgenFleet.in @endlink. Each member points to an array with
+     * one value per setpoint generator, allocated by
+     * @link ikStpgenFleet_init @endlink.
+     */
+    typedef struct ikStpgenFleetInputs {
+        double *maxSp; /**<external maximum setpoint*/
+        double *feedback; /**<feedback*/
+        double *controlAction; /**<control action*/
+        double *minCon; /**<external minimum control action*/
+        double *maxCon; /**<external maximum control action*/
+        double *preferredControlAction; /**<preferred control action, which takes the place of
+                                         * @link ikStpgenParams.preferredControlAction @endlink*/
+    } ikStpgenFleetInputs;
+
+    /**
+     * @struct ikStpgenFleetOutputs
+     * @brief Setpoint generator fleet outputs
+     * 
+     * Instances of ikStpgenFleet make outputs available via a structure of
+     * this type: @link ikStpgenFleet.out @endlink. Each member points to an
+     * array with one value per setpoint generator, allocated by
+     * @link ikStpgenFleet_init @endlink.
+     */
+    typedef struct ikStpgenFleetOutputs {
+        double *setpoint; /**<setpoint*/
+        double *maxCon; /**<maximum control action*/
+        double *minCon; /**<minimum control action*/
+    } ikStpgenFleetOutputs;
+
+    /* @cond */
+    typedef struct ikStpgenFleetPrivate {
+        int n; /*number of setpoint generators */
+        int *zone; /*zone, per setpoint generator */
+        int *phase; /*phase within the zone: 0 lower setpoint, 1 external maximum setpoint, 2 upper setpoint */
+        int *olsign; /*open loop gain sign */
+        int *nzones; /*number of zones */
+        double *controlActionLimitRate; /*control action limit rate */
+        double *setpointLo; /*lower setpoint of each zone, IKSTPGEN_NZONEMAX rows of n */
+        double *setpointHi; /*upper setpoint of each zone, IKSTPGEN_NZONEMAX rows of n */
+        double *setpointMid; /*midpoint of each zone, IKSTPGEN_NZONEMAX rows of n */
+        double *hysteresis; /*zone transition hysteresis, IKSTPGEN_NZONEMAX - 1 rows of n */
+        int *nSteps; /*zone transition step numbers, IKSTPGEN_NZONEMAX - 1 rows of n */
+        int *iSteps; /*zone transition step counters, IKSTPGEN_NZONEMAX - 1 rows of n */
+        int *nLockSteps; /*zone transition lock step numbers, IKSTPGEN_NZONEMAX - 1 rows of n */
+        int *iLockSteps; /*zone transition lock step counters, IKSTPGEN_NZONEMAX - 1 rows of n */
+        int *locked; /*zone transition lock flags, IKSTPGEN_NZONEMAX - 1 rows of n */
+        int *oldRow; /*transition row of the state before the step, scratch for the step */
+        int *oldRowILockSteps; /*lock step counter of that row after the step, scratch for the step */
+        int *oldRowLocked; /*lock flag of that row after the step, scratch for the step */
+        int *newRow; /*transition row of the state after the step, or -1 if its counters are not updated, scratch for the step */
+        int *newRowISteps; /*step counter of that row after the step, scratch for the step */
+        int *newRowILockSteps; /*lock step counter of that row after the step, scratch for the step */
+        double *doubles; /*memory for all double arrays */
+        int *ints; /*memory for all int arrays */
+    } ikStpgenFleetPrivate;
+    /* @endcond */
+
+    /**
+     * @struct ikStpgenFleet
+     * @brief Fleet of setpoint generators
+     * 
+     * Instances of this type hold a number of independent setpoint
+     * generators, each of them equivalent to an instance of
+     * @link ikStpgen @endlink, and step all of them in one pass.
+     * 
+     * The state of the setpoint generators is laid out as a structure of
+     * arrays, with one array element per setpoint generator, and one array
+     * row per zone or zone transition where applicable. The state machine is
+     * stepped with integer zone and phase arithmetic on 0/1 masks, the zone
+     * and transition rows being read with unconditional indexed loads, and
+     * every update is expressed as a selection between values rather than
+     * as a branch. The updated transition rows are written back in a second
+     * pass, a row at a time. With gcc -O3 on a target with gathers, such as
+     * -march=x86-64-v3, both loops are vectorised; ikStpgenFleet_vec.sh
+     * checks this.
+     * 
+     * The outputs of each setpoint generator are the same, bit for bit, as
+     * those of an instance of @link ikStpgen @endlink initialised with the
+     * same parameters and stepped with the same inputs.
+     * 
+     * @par Inputs
+     * @li per setpoint generator inputs, specify via @link in @endlink
+     * 
+     * @par Outputs
+     * @li per setpoint generator outputs, get via @link out @endlink
+     * 
+     * @par Methods
+     * @li @link ikStpgenFleet_init @endlink initialise an instance
+     * @li @link ikStpgenFleet_setParams @endlink initialise a setpoint generator
+     * @li @link ikStpgenFleet_step @endlink execute periodic calculations
+     * @li @link ikStpgenFleet_getOutput @endlink get output value
+     * @li @link ikStpgenFleet_delete @endlink delete instance
+     */
+    typedef struct ikStpgenFleet {
+        ikStpgenFleetInputs in; /**<inputs*/
+        ikStpgenFleetOutputs out; /**<outputs*/
+        /* @cond */
+        ikStpgenFleetPrivate priv;
+        /* @endcond */
+    } ikStpgenFleet;
+
+    /**
+     * Initialise an instance
+     * 
+     * All setpoint generators are initialised with the default parameters
+     * given by @link ikStpgen_initParams @endlink, and all inputs are set to
+     * 0.0.
+     * 
+     * @param self instance
+     * @param n number of setpoint generators
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid number of setpoint generators, must be positive
+     * @li -2: could not allocate memory
+     */
+    int ikStpgenFleet_init(ikStpgenFleet *self, int n);
+
+    /**
+     * Initialise a setpoint generator, as @link ikStpgen_init @endlink would.
+     * The preferred control action pointer in the parameters is not used.
+     * Set @link ikStpgenFleetInputs.preferredControlAction @endlink instead.
+     * 
+     * @param self instance
+     * @param i setpoint generator index, starting at 0
+     * @param params initialisation parameters
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid setpoint generator index
+     * @li others: see @link ikStpgen_init @endlink
+     */
+    int ikStpgenFleet_setParams(ikStpgenFleet *self, int i, const ikStpgenParams *params);
+
+    /**
+     * Execute periodic calculations for all setpoint generators
+     * @param self setpoint generator fleet instance
+     */
+    void ikStpgenFleet_step(ikStpgenFleet *self);
+
+    /**
+     * Get output value of a setpoint generator by name. The names are those
+     * of @link ikStpgen_getOutput @endlink.
+     * @param self setpoint generator fleet instance
+     * @param output output value
+     * @param i setpoint generator index, starting at 0
+     * @param name output name
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid signal name
+     * @li -3: invalid setpoint generator index
+     */
+    int ikStpgenFleet_getOutput(const ikStpgenFleet *self, double *output, int i, const char *name);
+
+    /**
+     * Delete instance
+     * @param self setpoint generator fleet instance
+     */
+    void ikStpgenFleet_delete(ikStpgenFleet *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKSTPGENFLEET_H */
@@ -0,0 +1,474 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikStpgenFleet_test.c
+ * 
+ * @brief Class ikStpgenFleet unit tests
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "ikStpgen.h"
+#include "ikStpgenFleet.h"
+#include "ikTestUtil.h"
+
+/*
+ * Initialise a setpoint generator, and the same member of a fleet, with the
+ * same parameters, the preferred control action of both being uopt
+ * @return 0 if both give the same error code, 1 otherwise
+ */
+int initBoth(ikStpgen *sg, ikStpgenFleet *fleet, int i, const ikStpgenParams *params, double *uopt) {
+    ikStpgenParams p = *params;
+
+    p.preferredControlAction = uopt;
+    return ikStpgen_init(sg, &p) != ikStpgenFleet_setParams(fleet, i, &p);
+}
+
+/*
+ * Step the setpoint generators with the fleet inputs, and the fleet, the
+ * preferred control actions being those the setpoint generators point to
+ * @return number of the n setpoint generators whose outputs differ in any bit
+ * from those of the fleet
+ */
+int stepBoth(ikStpgen sg[], ikStpgenFleet *fleet, int n, const double uopt[]) {
+    int i;
+    int ndiff = 0;
+    double r;
+
+    for (i = 0; i < n; i++) fleet->in.preferredControlAction[i] = uopt[i];
+    ikStpgenFleet_step(fleet);
+    for (i = 0; i < n; i++) {
+        r = ikStpgen_step(&(sg[i]), fleet->in.maxSp[i], fleet->in.feedback[i], fleet->in.controlAction[i], fleet->in.minCon[i], fleet->in.maxCon[i]);
+        if (memcmp(&r, &(fleet->out.setpoint[i]), sizeof (double))
+                || memcmp(&(sg[i].maxCon), &(fleet->out.maxCon[i]), sizeof (double))
+                || memcmp(&(sg[i].minCon), &(fleet->out.minCon[i]), sizeof (double))) ndiff++;
+    }
+    return ndiff;
+}
+
+/*
+ * Set three zones, with setpoints 1 to 2, 4 to 8 and 16 to 32
+ */
+void setThreeZones(ikStpgenParams *params) {
+    params->nzones = 3;
+    params->setpoints[0][0] = 1.0;
+    params->setpoints[1][0] = 2.0;
+    params->setpoints[0][1] = 4.0;
+    params->setpoints[1][1] = 8.0;
+    params->setpoints[0][2] = 16.0;
+    params->setpoints[1][2] = 32.0;
+    params->zoneTransitionHysteresis[0] = 0.1;
+    params->zoneTransitionHysteresis[1] = 0.1;
+}
+
+#define SCENARIO_SUITE "ikStpgenFleet_test"
+#include "ikStpgen_scenarios.h"
+
+/*
+ * One-element fleet the ikStpgen scenarios run on, and a setpoint generator
+ * run in lock step with it, whose outputs those of the fleet must match bit
+ * for bit
+ */
+ikStpgenFleet scenarioFleet;
+ikStpgen scenarioSg;
+const double *scenarioUopt = NULL;
+int scenarioSteps = 0;
+int scenarioDiffers = 0;
+
+/*
+ * Report the first difference between the fleet and the setpoint generator
+ * since initialisation
+ */
+void scenarioDiffer(const char *what) {
+    if (!scenarioDiffers) printf("%%TEST_FAILED%% time=0 testname=%s (ikStpgenFleet_test) message=%s differs from that of ikStpgen after %d steps\n", scenarioName, what, scenarioSteps);
+    scenarioDiffers = 1;
+}
+
+int scenarioInit(const ikStpgenParams *params) {
+    int err = ikStpgenFleet_setParams(&scenarioFleet, 0, params);
+
+    if (err != ikStpgen_init(&scenarioSg, params)) scenarioDiffer("setParams error code");
+    scenarioUopt = params->preferredControlAction;
+    scenarioSteps = 0;
+    scenarioDiffers = 0;
+    return err;
+}
+
+double scenarioStep(double maxSp, double feedback, double controlAction, double minCon, double maxCon) {
+    double r;
+
+    scenarioFleet.in.maxSp[0] = maxSp;
+    scenarioFleet.in.feedback[0] = feedback;
+    scenarioFleet.in.controlAction[0] = controlAction;
+    scenarioFleet.in.minCon[0] = minCon;
+    scenarioFleet.in.maxCon[0] = maxCon;
+    if (NULL != scenarioUopt) scenarioFleet.in.preferredControlAction[0] = *scenarioUopt;
+    ikStpgenFleet_step(&scenarioFleet);
+    r = ikStpgen_step(&scenarioSg, maxSp, feedback, controlAction, minCon, maxCon);
+    scenarioSteps++;
+    if (memcmp(&r, &(scenarioFleet.out.setpoint[0]), sizeof (double))) scenarioDiffer("setpoint");
+    if (memcmp(&(scenarioSg.maxCon), &(scenarioFleet.out.maxCon[0]), sizeof (double))) scenarioDiffer("maximum control action");
+    if (memcmp(&(scenarioSg.minCon), &(scenarioFleet.out.minCon[0]), sizeof (double))) scenarioDiffer("minimum control action");
+    return scenarioFleet.out.setpoint[0];
+}
+
+int scenarioGetOutput(double *output, const char *name) {
+    double r = 0.0;
+    int err = ikStpgenFleet_getOutput(&scenarioFleet, output, 0, name);
+
+    if (err != ikStpgen_getOutput(&scenarioSg, &r, name)) scenarioDiffer("getOutput error code");
+    else if (!err && memcmp(&r, output, sizeof (double))) scenarioDiffer(name);
+    return err;
+}
+
+/**
+ * setParams returns the same error codes as ikStpgen_init
+ */
+void testSetParamsErrors() {
+    printf("ikStpgenFleet_test testSetParamsErrors\n");
+    ikStpgenFleet fleet;
+    ikStpgen sg;
+    ikStpgenParams params[12];
+    int expected[12] = {0, -3, -4, -4, -5, -5, -6, -6, -7, -7, -8, -9};
+    double uopt = 0.0;
+    int err;
+    int i;
+
+    /* valid parameters, then the invalid ones ikStpgen_test checks */
+    for (i = 0; i < 12; i++) {
+        ikStpgen_initParams(&(params[i]));
+        setThreeZones(&(params[i]));
+    }
+    params[1].zoneTransitionHysteresis[0] = -0.1;
+    params[2].nzones = -1;
+    params[3].nzones = IKSTPGEN_NZONEMAX + 1;
+    params[4].setpoints[0][1] = 1.5;
+    params[5].setpoints[1][0] = 0.5;
+    params[6].nZoneTransitionSteps[0] = -1;
+    params[7].nZoneTransitionSteps[1] = -1;
+    params[8].nZoneTransitionLockSteps[0] = -1;
+    params[9].nZoneTransitionLockSteps[1] = -1;
+    params[10].controlActionLimitRate = -1.0;
+    params[11].zoneTransitionPrelock = 2;
+
+    err = ikStpgenFleet_init(&fleet, 1);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testSetParamsErrors (ikStpgenFleet_test) message=expected init to return 0, but it returned %d\n", err);
+    for (i = 0; i < 12; i++) {
+        if (initBoth(&sg, &fleet, 0, &(params[i]), &uopt)) printf("%%TEST_FAILED%% time=0 testname=testSetParamsErrors (ikStpgenFleet_test) message=setParams returned a different error code than ikStpgen_init for case %d\n", i);
+        err = ikStpgenFleet_setParams(&fleet, 0, &(params[i]));
+        if (expected[i] != err) printf("%%TEST_FAILED%% time=0 testname=testSetParamsErrors (ikStpgenFleet_test) message=expected setParams to return %d for case %d, but it returned %d\n", expected[i], i, err);
+    }
+    ikStpgenFleet_delete(&fleet);
+}
+
+/**
+ * With default parameters, the fleet waves the maximum setpoint and the
+ * external control action limits through, as ikStpgen does
+ */
+void testDefaultFleet() {
+    printf("ikStpgenFleet_test testDefaultFleet\n");
+    ikStpgenFleet fleet;
+    ikStpgen sg[2];
+    ikStpgenParams params;
+    double uopt[2] = {0.0, 0.0};
+    int ndiff = 0;
+    int i, k;
+
+    ikStpgenFleet_init(&fleet, 2);
+    ikStpgen_initParams(&params);
+    for (i = 0; i < 2; i++) initBoth(&(sg[i]), &fleet, i, &params, &(uopt[i]));
+    for (k = 0; k < 100; k++) {
+        for (i = 0; i < 2; i++) {
+            fleet.in.maxSp[i] = ikTestUtil_rand(-10.0, 10.0);
+            fleet.in.feedback[i] = ikTestUtil_rand(-10.0, 10.0);
+            fleet.in.controlAction[i] = ikTestUtil_rand(-10.0, 10.0);
+            fleet.in.minCon[i] = ikTestUtil_rand(-10.0, 0.0);
+            fleet.in.maxCon[i] = ikTestUtil_rand(0.0, 10.0);
+            uopt[i] = ikTestUtil_rand(-1.0, 1.0);
+        }
+        ndiff += stepBoth(sg, &fleet, 2, uopt);
+        if ((fleet.in.maxSp[0] != fleet.out.setpoint[0]) || (fleet.in.maxCon[1] != fleet.out.maxCon[1])
+                || (fleet.in.minCon[1] != fleet.out.minCon[1])) printf("%%TEST_FAILED%% time=0 testname=testDefaultFleet (ikStpgenFleet_test) message=expected the inputs to be waved through at step %d\n", k);
+    }
+    if (ndiff) printf("%%TEST_FAILED%% time=0 testname=testDefaultFleet (ikStpgenFleet_test) message=outputs differ from those of ikStpgen in %d steps\n", ndiff);
+    ikStpgenFleet_delete(&fleet);
+}
+
+/**
+ * In a closed loop driven across all zones and back, the fleet makes the same
+ * zone transitions as ikStpgen, with either open loop gain sign, with and
+ * without transition pre-lock, and with and without control action limit rates
+ */
+void testZoneTransitionsFleet() {
+    printf("ikStpgenFleet_test testZoneTransitionsFleet\n");
+    ikStpgenFleet fleet;
+    ikStpgen sg[8];
+    ikStpgenParams params;
+    double uopt[8];
+    double y[8];
+    double u[8];
+    int visited[8];
+    int ndiff = 0;
+    int i, k;
+    double d;
+
+    /* the members differ in gain sign, pre-lock and limit rate */
+    ikStpgenFleet_init(&fleet, 8);
+    for (i = 0; i < 8; i++) {
+        ikStpgen_initParams(&params);
+        setThreeZones(&params);
+        params.openLoopGainSign = i & 1 ? -1 : 1;
+        params.zoneTransitionPrelock = (i >> 1) & 1;
+        params.controlActionLimitRate = i & 4 ? 0.05 : 0.0;
+        params.nZoneTransitionSteps[0] = 20;
+        params.nZoneTransitionSteps[1] = 10;
+        params.nZoneTransitionLockSteps[0] = 50;
+        params.nZoneTransitionLockSteps[1] = 30;
+        uopt[i] = 0.0;
+        if (initBoth(&(sg[i]), &fleet, i, &params, &(uopt[i]))) printf("%%TEST_FAILED%% time=0 testname=testZoneTransitionsFleet (ikStpgenFleet_test) message=setParams returned a different error code than ikStpgen_init for member %d\n", i);
+        y[i] = 0.0;
+        u[i] = 0.0;
+        visited[i] = 0;
+    }
+
+    /* a first order plant with a disturbance sweeping the feedback up to */
+    /* the last zone and back, and an integral controller */
+    for (k = 0; k < 6000; k++) {
+        d = 40.0 * sin(3.14159265358979 * k / 3000.0);
+        for (i = 0; i < 8; i++) {
+            y[i] += 0.05 * (sg[i].olsign * 10.0 * u[i] + d - y[i]);
+            fleet.in.maxSp[i] = 40.0;
+            fleet.in.feedback[i] = y[i];
+            fleet.in.controlAction[i] = u[i];
+            fleet.in.minCon[i] = -5.0;
+            fleet.in.maxCon[i] = 5.0;
+        }
+        ndiff += stepBoth(sg, &fleet, 8, uopt);
+        for (i = 0; i < 8; i++) {
+            u[i] += 0.01 * sg[i].olsign * (fleet.out.setpoint[i] - y[i]);
+            if (u[i] > fleet.out.maxCon[i]) u[i] = fleet.out.maxCon[i];
+            if (u[i] < fleet.out.minCon[i]) u[i] = fleet.out.minCon[i];
+            visited[i] |= 1 << sg[i].zone;
+        }
+    }
+    if (ndiff) printf("%%TEST_FAILED%% time=0 testname=testZoneTransitionsFleet (ikStpgenFleet_test) message=outputs differ from those of ikStpgen in %d steps\n", ndiff);
+    for (i = 0; i < 8; i++) {
+        if (7 != visited[i]) printf("%%TEST_FAILED%% time=0 testname=testZoneTransitionsFleet (ikStpgenFleet_test) message=expected member %d to visit all zones, but it visited %x\n", i, visited[i]);
+    }
+    ikStpgenFleet_delete(&fleet);
+}
+
+/**
+ * With a small external maximum setpoint, a moving preferred control action
+ * and external control action limits closing in on it, the fleet gives the
+ * same outputs as ikStpgen
+ */
+void testExternalLimitsFleet() {
+    printf("ikStpgenFleet_test testExternalLimitsFleet\n");
+    ikStpgenFleet fleet;
+    ikStpgen sg[4];
+    ikStpgenParams params;
+    double uopt[4];
+    double y[4];
+    double u[4];
+    int ndiff = 0;
+    int i, k;
+    double w;
+
+    ikStpgenFleet_init(&fleet, 4);
+    for (i = 0; i < 4; i++) {
+        ikStpgen_initParams(&params);
+        setThreeZones(&params);
+        params.controlActionLimitRate = i & 1 ? 0.02 : 0.0;
+        params.zoneTransitionPrelock = (i >> 1) & 1;
+        uopt[i] = 0.0;
+        initBoth(&(sg[i]), &fleet, i, &params, &(uopt[i]));
+        y[i] = 0.0;
+        u[i] = 0.0;
+    }
+    for (k = 0; k < 4000; k++) {
+        w = 3.14159265358979 * k / 1000.0;
+        for (i = 0; i < 4; i++) {
+            /* the maximum setpoint dips below the first zone, and the */
+            /* external limits squeeze past the preferred control action */
+            uopt[i] = 2.0 * sin(0.7 * w + i);
+            y[i] += 0.05 * (10.0 * u[i] + 20.0 + 15.0 * sin(w) - y[i]);
+            fleet.in.maxSp[i] = 12.0 + 12.0 * cos(0.5 * w);
+            fleet.in.feedback[i] = y[i];
+            fleet.in.controlAction[i] = u[i];
+            fleet.in.minCon[i] = -5.0 + 4.0 * (1.0 + sin(0.3 * w));
+            fleet.in.maxCon[i] = 5.0 - 4.0 * (1.0 + cos(0.4 * w));
+        }
+        ndiff += stepBoth(sg, &fleet, 4, uopt);
+        for (i = 0; i < 4; i++) {
+            u[i] += 0.01 * (fleet.out.setpoint[i] - y[i]);
+            if (u[i] > fleet.out.maxCon[i]) u[i] = fleet.out.maxCon[i];
+            if (u[i] < fleet.out.minCon[i]) u[i] = fleet.out.minCon[i];
+        }
+    }
+    if (ndiff) printf("%%TEST_FAILED%% time=0 testname=testExternalLimitsFleet (ikStpgenFleet_test) message=outputs differ from those of ikStpgen in %d steps\n", ndiff);
+    ikStpgenFleet_delete(&fleet);
+}
+
+void testInitErrorsFleet() {
+    ikStpgenFleet fleet;
+    ikStpgenParams params;
+    int err;
+    double output;
+
+    err = ikStpgenFleet_init(&fleet, 0);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrorsFleet (ikStpgenFleet_test) message=expected init to return -1, but it returned %d\n", err);
+
+    err = ikStpgenFleet_init(&fleet, 3);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testInitErrorsFleet (ikStpgenFleet_test) message=expected init to return 0, but it returned %d\n", err);
+
+    ikStpgen_initParams(&params);
+    err = ikStpgenFleet_setParams(&fleet, 3, &params);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrorsFleet (ikStpgenFleet_test) message=expected setParams to return -1, but it returned %d\n", err);
+    err = ikStpgenFleet_setParams(&fleet, -1, &params);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrorsFleet (ikStpgenFleet_test) message=expected setParams to return -1, but it returned %d\n", err);
+
+    err = ikStpgenFleet_getOutput(&fleet, &output, 3, "setpoint");
+    if (-3 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrorsFleet (ikStpgenFleet_test) message=expected getOutput to return -3, but it returned %d\n", err);
+    err = ikStpgenFleet_getOutput(&fleet, &output, 2, "bogus");
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrorsFleet (ikStpgenFleet_test) message=expected getOutput to return -1, but it returned %d\n", err);
+
+    ikStpgenFleet_delete(&fleet);
+}
+
+void testHeterogeneousFleet() {
+    const int n = 301;
+    const int nsteps = 3000;
+    ikStpgenFleet fleet;
+    ikStpgen *sg;
+    ikStpgenParams params;
+    double *uopt;
+    double *spMax;
+    int i, j, z;
+    int err;
+    int nerr = 0;
+    int ndiff = 0;
+    double r;
+    double output;
+
+    sg = malloc(n * sizeof (ikStpgen));
+    uopt = malloc(n * sizeof (double));
+    spMax = malloc(n * sizeof (double));
+    err = ikStpgenFleet_init(&fleet, n);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testHeterogeneousFleet (ikStpgenFleet_test) message=expected init to return 0, but it returned %d\n", err);
+
+    /* give every setpoint generator its own parameters, a few of them invalid */
+    for (i = 0; i < n; i++) {
+        ikStpgen_initParams(&params);
+        params.openLoopGainSign = ikTestUtil_rand(0.0, 1.0) < 0.5 ? -1 : 1;
+        params.nzones = (int) ikTestUtil_rand(0.0, IKSTPGEN_NZONEMAX + 1.0);
+        uopt[i] = 0.0;
+        params.preferredControlAction = &(uopt[i]);
+        spMax[i] = 0.0;
+        for (z = 0; z < params.nzones; z++) {
+            params.setpoints[0][z] = spMax[i] + ikTestUtil_rand(0.1, 1.0);
+            params.setpoints[1][z] = params.setpoints[0][z] + ikTestUtil_rand(0.1, 1.0);
+            spMax[i] = params.setpoints[1][z];
+        }
+        for (z = 0; z < params.nzones - 1; z++) {
+            params.zoneTransitionHysteresis[z] = ikTestUtil_rand(0.0, 0.5);
+            params.nZoneTransitionSteps[z] = (int) ikTestUtil_rand(0.0, 20.0);
+            params.nZoneTransitionLockSteps[z] = (int) ikTestUtil_rand(0.0, 20.0);
+        }
+        params.zoneTransitionPrelock = ikTestUtil_rand(0.0, 1.0) < 0.5 ? 0 : 1;
+        params.controlActionLimitRate = ikTestUtil_rand(0.0, 1.0) < 0.5 ? 0.0 : ikTestUtil_rand(0.0, 0.2);
+        if (0 == i % 37) params.zoneTransitionHysteresis[0] = -1.0;
+
+        err = ikStpgen_init(&(sg[i]), &params);
+        if (err != ikStpgenFleet_setParams(&fleet, i, &params)) nerr++;
+    }
+    if (nerr) printf("%%TEST_FAILED%% time=0 testname=testHeterogeneousFleet (ikStpgenFleet_test) message=setParams returned a different error code than ikStpgen_init for %d setpoint generators\n", nerr);
+
+    /* step them all with random inputs */
+    for (j = 0; j < nsteps; j++) {
+        for (i = 0; i < n; i++) {
+            uopt[i] = ikTestUtil_rand(-1.0, 1.0);
+            fleet.in.preferredControlAction[i] = uopt[i];
+            fleet.in.maxSp[i] = ikTestUtil_rand(0.0, spMax[i] + 1.0);
+            fleet.in.feedback[i] = ikTestUtil_rand(0.0, spMax[i] + 1.0);
+            fleet.in.controlAction[i] = ikTestUtil_rand(-2.0, 2.0);
+            fleet.in.minCon[i] = ikTestUtil_rand(-3.0, 0.0);
+            fleet.in.maxCon[i] = ikTestUtil_rand(0.0, 3.0);
+        }
+        ikStpgenFleet_step(&fleet);
+        for (i = 0; i < n; i++) {
+            r = ikStpgen_step(&(sg[i]), fleet.in.maxSp[i], fleet.in.feedback[i], fleet.in.controlAction[i], fleet.in.minCon[i], fleet.in.maxCon[i]);
+            if (memcmp(&r, &(fleet.out.setpoint[i]), sizeof (double))
+                    || memcmp(&(sg[i].maxCon), &(fleet.out.maxCon[i]), sizeof (double))
+                    || memcmp(&(sg[i].minCon), &(fleet.out.minCon[i]), sizeof (double))) ndiff++;
+        }
+    }
+    if (ndiff) printf("%%TEST_FAILED%% time=0 testname=testHeterogeneousFleet (ikStpgenFleet_test) message=outputs differ from those of ikStpgen in %d steps\n", ndiff);
+
+    /* see that getOutput fetches the outputs */
+    err = ikStpgenFleet_getOutput(&fleet, &output, n - 1, "setpoint");
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testHeterogeneousFleet (ikStpgenFleet_test) message=expected getOutput to return 0, but it returned %d\n", err);
+    if (output != fleet.out.setpoint[n - 1]) printf("%%TEST_FAILED%% time=0 testname=testHeterogeneousFleet (ikStpgenFleet_test) message=getOutput expected to fetch %f for setpoint, but it fetched %f\n", fleet.out.setpoint[n - 1], output);
+
+    ikStpgenFleet_delete(&fleet);
+    free(sg);
+    free(uopt);
+    free(spMax);
+}
+
+int main(int argc, char** argv) {
+    printf("%%SUITE_STARTING%% ikStpgenFleet_test\n");
+    printf("%%SUITE_STARTED%%\n");
+
+    /* the ikStpgen scenarios, on a one-element fleet */
+    ikStpgenFleet_init(&scenarioFleet, 1);
+    runScenarios();
+    ikStpgenFleet_delete(&scenarioFleet);
+
+    printf("%%TEST_STARTED%% testSetParamsErrors (ikStpgenFleet_test)\n");
+    testSetParamsErrors();
+    printf("%%TEST_FINISHED%% time=0 testSetParamsErrors (ikStpgenFleet_test) \n");
+
+    printf("%%TEST_STARTED%% testDefaultFleet (ikStpgenFleet_test)\n");
+    testDefaultFleet();
+    printf("%%TEST_FINISHED%% time=0 testDefaultFleet (ikStpgenFleet_test) \n");
+
+    printf("%%TEST_STARTED%% testZoneTransitionsFleet (ikStpgenFleet_test)\n");
+    testZoneTransitionsFleet();
+    printf("%%TEST_FINISHED%% time=0 testZoneTransitionsFleet (ikStpgenFleet_test) \n");
+
+    printf("%%TEST_STARTED%% testExternalLimitsFleet (ikStpgenFleet_test)\n");
+    testExternalLimitsFleet();
+    printf("%%TEST_FINISHED%% time=0 testExternalLimitsFleet (ikStpgenFleet_test) \n");
+
+    printf("%%TEST_STARTED%% testInitErrorsFleet (ikStpgenFleet_test)\n");
+    testInitErrorsFleet();
+    printf("%%TEST_FINISHED%% time=0 testInitErrorsFleet (ikStpgenFleet_test) \n");
+
+    printf("%%TEST_STARTED%% testHeterogeneousFleet (ikStpgenFleet_test)\n");
+    testHeterogeneousFleet();
+    printf("%%TEST_FINISHED%% time=0 testHeterogeneousFleet (ikStpgenFleet_test) \n");
+
+    printf("%%SUITE_FINISHED%% time=0\n");
+
+    return (EXIT_SUCCESS);
+}
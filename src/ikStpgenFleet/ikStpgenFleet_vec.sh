@@ -0,0 +1,53 @@
+#!/bin/sh
+#
+# Copyright (C) 2015-2017 IK4-IKERLAN
+#
+# This file is part of OpenWitcon.
+#
+# OpenWitcon is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# OpenWitcon is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+#
+# Check that gcc vectorises the loops of ikStpgenFleet_step.
+#
+# Usage: ikStpgenFleet_vec.sh [gcc flags], run from the src directory.
+# The flags default to -O3 -march=x86-64-v3, the loop over the setpoint
+# generators needing gathers.
+
+src=ikStpgenFleet/ikStpgenFleet.c
+flags=${*:--O3 -march=x86-64-v3}
+inc=
+for d in */; do inc="$inc -I${d%/}"; done
+
+# line ranges of the private step functions
+states=$(grep -n "^void ikStpgenFleet_stepStates(" $src | cut -d: -f1)
+rows=$(grep -n "^void ikStpgenFleet_stepRows(" $src | cut -d: -f1)
+step=$(grep -n "^void ikStpgenFleet_step(" $src | cut -d: -f1)
+
+# lines of the vectorised loops
+vec=$(gcc $flags $inc -c $src -o /dev/null -fopt-info-vec-optimized 2>&1 \
+    | grep "loop vectorized" | cut -d: -f2 | sort -u)
+
+err=0
+check() {
+    for l in $vec; do
+        if [ "$l" -ge "$2" ] && [ "$l" -lt "$3" ]; then
+            echo "$1: vectorised"
+            return
+        fi
+    done
+    echo "$1: NOT vectorised"
+    err=1
+}
+check ikStpgenFleet_stepStates "$states" "$rows"
+check ikStpgenFleet_stepRows "$rows" "$step"
+exit $err
@@ -62,6 +62,12 @@ void ikSurf_initExclusive(ikSurf *self) {
   for (i = 0; i < self->dims; i++) self->idx[i][0] = 0;
   for (i = 0; i < self->dims; i++) self->idx[i][1] = self->ndata[i] - 1;
   for (i = 0; i < self->dims-1; i++) self->ext[i] = NULL;
+  /*no iterations yet*/
+  self->iterations = 0;
+  self->capped = 0;
+#ifdef IKPROFILE
+  ikProfile_init(&(self->profile));
+#endif
 }
 
 /*
@@ -424,6 +430,14 @@ int ikSurf_getDimensions(const ikSurf *self) {
   return self->dims;
 }
 
+long ikSurf_getIterations(const ikSurf *self) {
+  return self->iterations;
+}
+
+long ikSurf_getCapped(const ikSurf *self) {
+  return self->capped;
+}
+
 int ikSurf_getPointNumber(const ikSurf *self, int dim) {
   if (0 <= dim && dim < self->dims) {
     return self->ndata[dim];
@@ -506,26 +520,44 @@ int ikSurf_bisectCoord(ikSurf *self, int dim) {
   return 1;
 }
 
+/**
+ * "private method" to count an iteration of a search, and to check it against IKSURF_MAXITER
+ * n is the number of iterations of the search so far
+ * return 0 if the search must stop, else return 1
+ */
+int ikSurf_iterate(ikSurf *self, int *n) {
+#ifdef IKSURF_MAXITER
+  if (*n >= IKSURF_MAXITER) {
+    self->capped++;
+    return 0;
+  }
+#endif
+  (*n)++;
+  self->iterations++;
+  return 1;
+}
+
 /**
  * "private method" to minimize the range covered by idx[0]-idx[1], while containing x for dimension dim (hence "grasp" x with idx)
  */
 void ikSurf_grasp(ikSurf *self, int dim) {
+  int n = 0;
   /*uprange upwards until x is in range or we run out of points*/
-  while (self->x[dim] > self->coord[dim][self->idx[dim][1]]) {
+  while (self->x[dim] > self->coord[dim][self->idx[dim][1]] && ikSurf_iterate(self, &n)) {
     if (!ikSurf_upRange(self, dim, 1, 0)) {
-      while (ikSurf_downRange(self, dim, 1)) continue;
+      while (ikSurf_iterate(self, &n) && ikSurf_downRange(self, dim, 1)) continue;
       break;
     }
   }
   /*uprange downwards until x is in range or we run out of points*/
-  while (self->x[dim] < self->coord[dim][self->idx[dim][0]]) {
+  while (self->x[dim] < self->coord[dim][self->idx[dim][0]] && ikSurf_iterate(self, &n)) {
     if (!ikSurf_upRange(self, dim, -1, 0)) {
-      while (ikSurf_downRange(self, dim, -1)) continue;
+      while (ikSurf_iterate(self, &n) && ikSurf_downRange(self, dim, -1)) continue;
       break;
     }
   }
   /*bisect for as long as we can*/
-  while (ikSurf_bisectCoord(self, dim)) continue;
+  while (ikSurf_iterate(self, &n) && ikSurf_bisectCoord(self, dim)) continue;
 }
 
 /**
@@ -724,9 +756,17 @@ int ikSurf_setSide(ikSurf *self, int dim, int side) {
   return moved;
 }
 
-double ikSurf_eval(ikSurf *self, int dim, const double x[], int side) {
+/*with IKPROFILE, the evaluation is wrapped by a profiled ikSurf_eval, below*/
+#ifdef IKPROFILE
+#define IKSURF_EVAL ikSurf_evalUnprofiled
+#else
+#define IKSURF_EVAL ikSurf_eval
+#endif
+
+double IKSURF_EVAL(ikSurf *self, int dim, const double x[], int side) {
   double x0, y0, x1, y1, xeval, y;
   int s;
+  int n = 0;
   /*check dim*/
   if (dim < 0 || self->dims-1 < dim) return 0.0;
   if (dim < self->dims-1 && self->interpOnly) return 0.0;
@@ -744,22 +784,22 @@ double ikSurf_eval(ikSurf *self, int dim, const double x[], int side) {
   s = (self->interp[0] < self->interp[self->interpNumel/2]);
   /*uprange-interp until it's grasped*/
   /*uprange upwards until x is in range or we run out of points*/
-  while (x[self->dims-2] > self->interp[s*self->interpNumel/2]) {
+  while (x[self->dims-2] > self->interp[s*self->interpNumel/2] && ikSurf_iterate(self, &n)) {
     int ur;
     ur = ikSurf_upRange(self, dim, 2*s-1, side);
     ikSurf_interp(self, dim, x);
     if (!ur) {
-      while (ikSurf_downRange(self, dim, 2*s-1)) continue;
+      while (ikSurf_iterate(self, &n) && ikSurf_downRange(self, dim, 2*s-1)) continue;
       break;
     }
   }
   /*uprange downwards until x is in range or we run out of points*/
-  while (x[self->dims-2] < self->interp[(1-s)*self->interpNumel/2]) {
+  while (x[self->dims-2] < self->interp[(1-s)*self->interpNumel/2] && ikSurf_iterate(self, &n)) {
     int ur;
     ur = ikSurf_upRange(self, dim, 1-2*s, side);
     ikSurf_interp(self, dim, x);
     if (!ur) {
-      while (ikSurf_downRange(self, dim, 1-2*s)) continue;
+      while (ikSurf_iterate(self, &n) && ikSurf_downRange(self, dim, 1-2*s)) continue;
       break;
     }
   }
@@ -774,6 +814,7 @@ double ikSurf_eval(ikSurf *self, int dim, const double x[], int side) {
       ) {
     double opt, optval, subopt, suboptval;
     int i, j;
+    long iterations, capped;
     suboptval = self->interp[0];
     subopt = self->coord[dim][self->idx[dim][0]];
     if (fabs(x[self->dims-2] - self->interp[self->interpNumel/2]) < fabs(x[self->dims-2] - self->interp[0])) {
@@ -786,7 +827,12 @@ double ikSurf_eval(ikSurf *self, int dim, const double x[], int side) {
       self->xaux[j] = x[i];
       j++;
     }
+    /*count the iterations on the extreme surface as our own*/
+    iterations = self->ext[dim]->iterations;
+    capped = self->ext[dim]->capped;
     opt = ikSurf_eval(self->ext[dim], self->dims-2, x, 0);
+    self->iterations += self->ext[dim]->iterations - iterations;
+    self->capped += self->ext[dim]->capped - capped;
     self->xaux[dim] = opt;
     optval = ikSurf_eval(self, self->dims-1, self->xaux, 0);
     if (
@@ -802,7 +848,7 @@ double ikSurf_eval(ikSurf *self, int dim, const double x[], int side) {
     return subopt + (opt - subopt) * (x[self->dims-2] - suboptval) / (optval - suboptval);
   }
   /*bisect for as long as we can*/
-  while (ikSurf_bisectValue(self, dim, x)) continue;
+  while (ikSurf_iterate(self, &n) && ikSurf_bisectValue(self, dim, x)) continue;
   /*interp again*/
   ikSurf_interp(self, dim, x);
   /*do the last bit of intepolation*/
@@ -813,3 +859,26 @@ double ikSurf_eval(ikSurf *self, int dim, const double x[], int side) {
   xeval = x[self->dims-2];
   return y0 + (y1 - y0) * (xeval - x0) / (x1 - x0);
 }
+
+#ifdef IKPROFILE
+double ikSurf_eval(ikSurf *self, int dim, const double x[], int side) {
+  double y;
+  ikProfile_start(&(self->profile));
+  y = ikSurf_evalUnprofiled(self, dim, x, side);
+  ikProfile_stop(&(self->profile));
+  return y;
+}
+
+int ikSurf_getProfile(const ikSurf *self, double *output, const char *name) {
+  /*the searches are counted anyway*/
+  if (!strcmp(name, "iterations")) {
+    *output = (double) self->iterations;
+    return 0;
+  }
+  if (!strcmp(name, "saturations")) {
+    *output = (double) self->capped;
+    return 0;
+  }
+  return ikProfile_getOutput(&(self->profile), output, name);
+}
+#endif
@@ -24,6 +24,9 @@ along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
  */
 
 #include <stdlib.h>
+#ifdef IKPROFILE
+#include "ikProfile.h"
+#endif
 
 #ifndef IKSURF_H
 #define IKSURF_H
@@ -39,6 +42,18 @@ extern "C" {
      * Instances of this class are implementations of n-dimensional surfaces.
      * Linear interpolation and extrapolation are applied.
      *
+     * The brackets of the coordinates are searched for by widening and
+     * bisecting them, so the execution time of @link ikSurf_eval @endlink
+     * depends on the point of evaluation. The iterations of these searches are
+     * counted, see @link ikSurf_getIterations @endlink. If IKSURF_MAXITER is
+     * defined at compile time, each search stops after IKSURF_MAXITER
+     * iterations, and the evaluation goes on with the bracket reached so far,
+     * interpolating or extrapolating linearly over it. Searches stopped in
+     * this way are counted, see @link ikSurf_getCapped @endlink.
+     *
+     * If IKPROFILE is defined at compile time, the evaluations are also
+     * counted and timed, see @link ikSurf_getProfile @endlink.
+     *
      * @par Inputs
      * @li point of evaluation, specify via @link ikSurf_eval @endlink
      *
@@ -61,6 +76,9 @@ extern "C" {
      * @li @link ikSurf_getDimensions @endlink get number of dimensions
      * @li @link ikSurf_getPointNumber @endlink get number of data points per dimension
      * @li @link ikSurf_eval @endlink evaluate surface coordinate
+     * @li @link ikSurf_getIterations @endlink get number of search iterations
+     * @li @link ikSurf_getCapped @endlink get number of searches stopped at IKSURF_MAXITER
+     * @li @link ikSurf_getProfile @endlink get profile counters, if IKPROFILE is defined
      */
     typedef struct ikSurf ikSurf;
     struct ikSurf {
@@ -84,6 +102,11 @@ extern "C" {
         double * x; /*evaluation coordinates*/
         double * xaux; /*auxiliary evaluation coordinates*/
         int interpOnly; /*flag indicating that eval should only return non-zero for last dimension*/
+        long iterations; /*number of search iterations so far*/
+        long capped; /*number of searches stopped at IKSURF_MAXITER so far*/
+#ifdef IKPROFILE
+        ikProfile profile; /*evaluation profile*/
+#endif
         /* @endcond */
     };
 
@@ -168,6 +191,33 @@ extern "C" {
      */
     double ikSurf_eval(ikSurf *self, int dim, const double x[], int side);
 
+    /**
+     * get number of search iterations
+     * @param self instance
+     * @return number of search iterations of all evaluations so far, including those on extreme surfaces
+     */
+    long ikSurf_getIterations(const ikSurf *self);
+
+    /**
+     * get number of searches stopped at IKSURF_MAXITER
+     * @param self instance
+     * @return number of searches of all evaluations so far stopped after IKSURF_MAXITER iterations (always 0 if IKSURF_MAXITER is not defined)
+     */
+    long ikSurf_getCapped(const ikSurf *self);
+
+#ifdef IKPROFILE
+    /**
+     * get profile counters, only if IKPROFILE is defined
+     * @param self instance
+     * @param output output value
+     * @param name counter name, as in @link ikProfile @endlink, or "iterations" for @link ikSurf_getIterations @endlink. Saturations are searches stopped at IKSURF_MAXITER, as in @link ikSurf_getCapped @endlink.
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid counter name
+     */
+    int ikSurf_getProfile(const ikSurf *self, double *output, const char *name);
+#endif
+
 
 #ifdef __cplusplus
 }
@@ -2174,6 +2174,86 @@ void testBugCoordinateBisection() {
     surf = NULL;
 }
 
+void testIterations() {
+    /*declare instance reference*/
+    ikSurf *surf = NULL;
+
+    /*declare dims, ndata and data */
+    int dims;
+    int *ndata = NULL;
+    double *data = NULL;
+
+    /*declare error message, eval coordinates, other return values*/
+    const char *err = NULL;
+    double *x = NULL;
+    double evalRet;
+    long iterations;
+    long getIterationsRet;
+    long getCappedRet;
+    int i;
+
+    /*start test*/
+    printf("ikSurf_test iterations\n");
+
+    /*straight line through 65 points*/
+    printf("new\n");
+    dims = 2;
+    ndata = (int *) malloc(sizeof(int));
+    ndata[0] = 65;
+    data = (double*) malloc(sizeof(double)*130);
+    for (i = 0; i < 65; i++) {
+        data[i] = (double) i;
+        data[65 + i] = 2.0*i;
+    }
+    err = ikSurf_new(&surf, dims, ndata, data, 1);
+    free(ndata);
+    ndata = NULL;
+    free(data);
+    data = NULL;
+    if (strcmp(err, "")) printf("%%TEST_FAILED%% time=0 testname=iterations (ikSurf_test) message=init was expected to return \"\", but returned \"%s\"\n", err);
+
+    /*the iterations grow with every evaluation away from the last bracket*/
+    printf("eval\n");
+    x = (double *) malloc(sizeof(double));
+    x[0] = 32.5;
+    iterations = ikSurf_getIterations(surf);
+    evalRet = ikSurf_eval(surf, 1, x, 0);
+    if (fabs(65.0 - evalRet) > 1.0E-9) printf("%%TEST_FAILED%% time=0 testname=iterations (ikSurf_test) message=eval was expected to return 65.0 for dimension 1 at 32.5, but returned %f\n", evalRet);
+    getIterationsRet = ikSurf_getIterations(surf);
+    if (iterations >= getIterationsRet) printf("%%TEST_FAILED%% time=0 testname=iterations (ikSurf_test) message=getIterations was expected to return more than %ld after evaluating at 32.5, but returned %ld\n", iterations, getIterationsRet);
+    iterations = getIterationsRet;
+    x[0] = 0.5;
+    ikSurf_eval(surf, 1, x, 0);
+    getIterationsRet = ikSurf_getIterations(surf);
+    if (iterations >= getIterationsRet) printf("%%TEST_FAILED%% time=0 testname=iterations (ikSurf_test) message=getIterations was expected to return more than %ld after evaluating at 0.5, but returned %ld\n", iterations, getIterationsRet);
+
+    /*searches are only capped if IKSURF_MAXITER is defined*/
+    printf("getCapped\n");
+    x[0] = 1000.0;
+    evalRet = ikSurf_eval(surf, 1, x, 0);
+    getCappedRet = ikSurf_getCapped(surf);
+#ifndef IKSURF_MAXITER
+    if (fabs(2000.0 - evalRet) > 1.0E-9) printf("%%TEST_FAILED%% time=0 testname=iterations (ikSurf_test) message=eval was expected to return 2000.0 for dimension 1 at 1000.0, but returned %f\n", evalRet);
+    if (0 != getCappedRet) printf("%%TEST_FAILED%% time=0 testname=iterations (ikSurf_test) message=getCapped was expected to return 0, but returned %ld\n", getCappedRet);
+#else
+    /*on a straight line, the fallback extrapolation is exact*/
+    if (fabs(2000.0 - evalRet) > 1.0E-6) printf("%%TEST_FAILED%% time=0 testname=iterations (ikSurf_test) message=eval was expected to return 2000.0 for dimension 1 at 1000.0, but returned %f\n", evalRet);
+    if (0 > getCappedRet) printf("%%TEST_FAILED%% time=0 testname=iterations (ikSurf_test) message=getCapped was expected to return a non-negative number, but returned %ld\n", getCappedRet);
+    iterations = ikSurf_getIterations(surf);
+    x[0] = -1000.0;
+    ikSurf_eval(surf, 1, x, 0);
+    getIterationsRet = ikSurf_getIterations(surf);
+    if (getIterationsRet - iterations > 8*IKSURF_MAXITER) printf("%%TEST_FAILED%% time=0 testname=iterations (ikSurf_test) message=eval was expected to take at most %d iterations, but took %ld\n", 8*IKSURF_MAXITER, getIterationsRet - iterations);
+#endif
+    free(x);
+    x = NULL;
+
+    /*release the memory*/
+    printf("delete\n");
+    ikSurf_delete(surf);
+    surf = NULL;
+}
+
 int main(int argc, char** argv) {
     printf("%%SUITE_STARTING%% ikSurf_test\n");
     printf("%%SUITE_STARTED%%\n");
@@ -2246,6 +2326,10 @@ int main(int argc, char** argv) {
     testBugCoordinateBisection();
     printf("%%TEST_FINISHED%% time=0 bug in coordinate bisection (ikSurf_test) \n");
 
+    printf("%%TEST_STARTED%% iterations (ikSurf_test)\n");
+    testIterations();
+    printf("%%TEST_FINISHED%% time=0 iterations (ikSurf_test) \n");
+
     printf("%%SUITE_FINISHED%% time=0\n");
 
     return (EXIT_SUCCESS);
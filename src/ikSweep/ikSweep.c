@@ -0,0 +1,400 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikSweep.c
+ * 
+ * @brief Class ikSweep implementation
+ */
+
+/* @cond */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "ikSweep.h"
+
+#define IKSWEEP_NACC 5
+
+/*worker thread */
+typedef struct ikSweepWorker {
+    ikSweep *sweep;
+    atomic_int *next; /*next variant to be taken, shared by all workers */
+    int failed; /*number of variants whose control loop could not be initialised */
+    double *values; /*values of the swept parameters of the current variant */
+    double *acc; /*metric accumulators of the current variant */
+    const double **signals; /*signal of each metric in the control loop, or NULL if got by name */
+    const double *minCon; /*minimum control action in the control loop */
+    const double *maxCon; /*maximum control action in the control loop */
+    ikConLoopParams params; /*parameters of the current variant */
+    ikConLoop loop; /*control loop of the current variant */
+    void *buffer; /*region selector buffer of the control loop, if the base parameters give one */
+    size_t bufferSize; /*size of buffer, in bytes */
+    pthread_t thread;
+} ikSweepWorker;
+
+/**
+ * (Private) mix the bits of a 64-bit value, as in splitmix64
+ */
+uint64_t ikSweep_mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * (Private) uniform random number between 0 and 1, depending on the seed,
+ * the variant and the parameter only
+ */
+double ikSweep_random(unsigned long seed, int variant, int param) {
+    uint64_t z;
+
+    z = ikSweep_mix((uint64_t) seed + 0x9E3779B97F4A7C15ull * ((uint64_t) variant + 1));
+    z = ikSweep_mix(z + 0x9E3779B97F4A7C15ull * ((uint64_t) param + 1));
+    return (z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * (Private) get the values of the swept parameters of a variant
+ */
+void ikSweep_values(const ikSweep *self, int variant, double values[]) {
+    const ikSweepPrivate *p = &(self->priv);
+    int i;
+    int k = variant;
+
+    /*the last parameter changes fastest over a grid */
+    for (i = p->nParams - 1; i >= 0; i--) {
+        if (p->nRandom) {
+            values[i] = p->params[i].min + (p->params[i].max - p->params[i].min) * ikSweep_random(p->seed, variant, i);
+        } else {
+            values[i] = p->params[i].values[k % p->params[i].nValues];
+            k /= p->params[i].nValues;
+        }
+    }
+}
+
+/**
+ * (Private) get a signal of a linear controller held in one of its members
+ * @return signal, or NULL if the name is not that of such a signal
+ */
+const double *ikSweep_findLinConSignal(const ikLinCon *lincon, const char *name) {
+    if (!strcmp(name, "demand")) return &(lincon->demand);
+    if (!strcmp(name, "filtered demand")) return &(lincon->filteredDemand);
+    if (!strcmp(name, "measurement")) return &(lincon->measurement);
+    if (!strcmp(name, "filtered measurement")) return &(lincon->filteredMeasurement);
+    if (!strcmp(name, "gain schedule")) return &(lincon->gainSchedOutput);
+    if (!strcmp(name, "post-gain value")) return &(lincon->gainSchedOutput);
+    return NULL;
+}
+
+/**
+ * (Private) get a signal of a control loop held in one of its members, as
+ * named in ikConLoop_getOutput
+ * @return signal, or NULL if the name is not that of such a signal, e.g.
+ * because it is computed on request
+ */
+const double *ikSweep_findSignal(const ikConLoop *loop, const char *name) {
+    if (!strcmp(name, "control action")) return &(loop->controlAction);
+    if (!strcmp(name, "x")) return &(loop->x);
+    if (!strcmp(name, "y")) return &(loop->y);
+    if (!strcmp(name, "setpoint")) return &(loop->stpgen.r);
+    if (!strcmp(name, "minimum control action")) return &(loop->stpgen.minCon);
+    if (!strcmp(name, "maximum control action")) return &(loop->stpgen.maxCon);
+    if (!strcmp(name, "external minimum control action")) return &(loop->stpgen.externalMinimumControlAction);
+    if (!strcmp(name, "external maximum control action")) return &(loop->stpgen.externalMaximumControlAction);
+    if (!strcmp(name, "maximum setpoint")) return &(loop->stpgen.externalMaximumSetpoint);
+    if (!strcmp(name, "feedback")) return &(loop->stpgen.feedback);
+    if (!strncmp(name, "linear controller>", 18)) return ikSweep_findLinConSignal(&(loop->lincon), name + 18);
+    if (!strncmp(name, "setpoint filters>", 17)) return ikSweep_findLinConSignal(&(loop->setpointFilters), name + 17);
+    if (!strncmp(name, "control action filters>", 23)) return ikSweep_findLinConSignal(&(loop->controlActionFilters), name + 23);
+    return NULL;
+}
+
+/**
+ * (Private) run a variant, accumulating its metrics
+ * @return error code of ikConLoop_init
+ */
+int ikSweep_runVariant(ikSweep *self, ikSweepWorker *w, int variant) {
+    const ikSweepPrivate *p = &(self->priv);
+    double *acc;
+    double *results = p->results + (size_t) variant * p->nMetrics;
+    double u, x, d;
+    size_t size;
+    int err;
+    int i, j;
+
+    /*set up the control loop, with a region selector buffer of its own */
+    w->params = p->loop;
+    ikSweep_values(self, variant, w->values);
+    for (i = 0; i < p->nParams; i++) memcpy((char *) &(w->params) + p->params[i].offset, &(w->values[i]), sizeof(double));
+    if (NULL != w->params.regionSelector.buffer) {
+        size = ikRegionSelector_getPolygonBufferSize(&(w->params.regionSelector));
+        if (w->bufferSize < size) {
+            free(w->buffer);
+            w->buffer = malloc(size);
+            w->bufferSize = NULL == w->buffer ? 0 : size;
+        }
+        w->params.regionSelector.buffer = w->buffer;
+        w->params.regionSelector.bufferSize = w->bufferSize;
+    }
+    err = ikConLoop_init(&(w->loop), &(w->params));
+    if (err) return err;
+
+    /*find the signals, so that only those computed on request are got by name */
+    for (j = 0; j < p->nMetrics; j++) {
+        w->signals[j] = IKSWEEP_SATURATION == p->metrics[j].type ? NULL : ikSweep_findSignal(&(w->loop), p->metrics[j].signal);
+    }
+    w->minCon = ikSweep_findSignal(&(w->loop), "minimum control action");
+    w->maxCon = ikSweep_findSignal(&(w->loop), "maximum control action");
+
+    /*run, with the mean, the sum of squared deviations, the sum of squares,
+     and the minimum and maximum of each signal, or the saturated steps */
+    for (j = 0; j < p->nMetrics; j++) {
+        acc = w->acc + IKSWEEP_NACC * j;
+        acc[0] = 0.0;
+        acc[1] = 0.0;
+        acc[2] = 0.0;
+        acc[3] = INFINITY;
+        acc[4] = -INFINITY;
+    }
+    for (i = 0; i < p->nSteps; i++) {
+        u = ikConLoop_step(&(w->loop), p->maxSp[i], p->feedback[i], p->minCon[i], p->maxCon[i]);
+        for (j = 0; j < p->nMetrics; j++) {
+            acc = w->acc + IKSWEEP_NACC * j;
+            if (IKSWEEP_SATURATION == p->metrics[j].type) {
+                if ((*(w->minCon) >= u) || (*(w->maxCon) <= u)) acc[0] += 1.0;
+                continue;
+            }
+            if (NULL != w->signals[j]) x = *(w->signals[j]);
+            else ikConLoop_getOutput(&(w->loop), &x, p->metrics[j].signal);
+            d = x - acc[0];
+            acc[0] += d / (i + 1);
+            acc[1] += d * (x - acc[0]);
+            acc[2] += x * x;
+            if (x < acc[3]) acc[3] = x;
+            if (x > acc[4]) acc[4] = x;
+        }
+    }
+
+    /*register the metrics */
+    for (j = 0; j < p->nMetrics; j++) {
+        acc = w->acc + IKSWEEP_NACC * j;
+        switch (p->metrics[j].type) {
+            case IKSWEEP_MEAN: results[j] = acc[0];
+                break;
+            case IKSWEEP_RMS: results[j] = sqrt(acc[2] / p->nSteps);
+                break;
+            case IKSWEEP_VARIANCE: results[j] = acc[1] / p->nSteps;
+                break;
+            case IKSWEEP_MIN: results[j] = acc[3];
+                break;
+            case IKSWEEP_MAX: results[j] = acc[4];
+                break;
+            case IKSWEEP_SATURATION: results[j] = acc[0] / p->nSteps;
+                break;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * (Private) run the variants not taken yet by other workers
+ */
+void ikSweep_work(ikSweepWorker *w) {
+    ikSweep *self = w->sweep;
+    int variant;
+
+    while (self->priv.nVariants > (variant = atomic_fetch_add(w->next, 1))) {
+        self->priv.errors[variant] = ikSweep_runVariant(self, w, variant);
+        if (self->priv.errors[variant]) w->failed++;
+    }
+}
+
+/**
+ * (Private) worker thread
+ */
+void *ikSweep_worker(void *arg) {
+    ikSweep_work((ikSweepWorker *) arg);
+    return NULL;
+}
+
+int ikSweep_init(ikSweep *self, const ikSweepParams *params) {
+    ikSweepPrivate *p = &(self->priv);
+    ikConLoop loop;
+    double output;
+    long nVariants = 1;
+    int err;
+    int i;
+
+    /*check the swept parameters */
+    if (0 > params->nParams) return -1;
+    if ((params->nParams) && (NULL == params->params)) return -2;
+    for (i = 0; i < params->nParams; i++) {
+        if (sizeof(ikConLoopParams) < params->params[i].offset + sizeof(double)) return -2;
+        if (params->params[i].offset % _Alignof(double)) return -2;
+        if (params->nRandom) continue;
+        if ((0 >= params->params[i].nValues) || (NULL == params->params[i].values)) return -2;
+        nVariants *= params->params[i].nValues;
+        if (INT_MAX < nVariants) return -8;
+    }
+    if (0 > params->nRandom) return -3;
+    if (params->nRandom) nVariants = params->nRandom;
+
+    /*check the input trace and the number of threads */
+    if ((0 >= params->nSteps) || (NULL == params->maxSp) || (NULL == params->feedback)
+            || (NULL == params->minCon) || (NULL == params->maxCon)) return -5;
+    if (0 >= params->nThreads) return -6;
+
+    /*check the metrics, and the base parameters, with a control loop */
+    if ((0 > params->nMetrics) || (params->nMetrics && (NULL == params->metrics))) return -4;
+    err = ikConLoop_init(&loop, &(params->loop));
+    for (i = 0; (i < params->nMetrics) && !err; i++) {
+        if ((IKSWEEP_MEAN > params->metrics[i].type) || (IKSWEEP_SATURATION < params->metrics[i].type)) err = -4;
+        else if ((IKSWEEP_SATURATION != params->metrics[i].type)
+                && ((NULL == params->metrics[i].signal) || ikConLoop_getOutput(&loop, &output, params->metrics[i].signal))) err = -4;
+    }
+    if (-4 == err) return -4;
+    if (err) return -7;
+
+    /*register the parameters */
+    p->loop = params->loop;
+    p->nParams = params->nParams;
+    p->nRandom = params->nRandom;
+    p->seed = params->seed;
+    p->nMetrics = params->nMetrics;
+    p->nSteps = params->nSteps;
+    p->maxSp = params->maxSp;
+    p->feedback = params->feedback;
+    p->minCon = params->minCon;
+    p->maxCon = params->maxCon;
+    p->nThreads = params->nThreads;
+    p->nVariants = (int) nVariants;
+
+    /*copy the swept parameters and the metrics, and allocate the results */
+    p->params = (ikSweepParam *) malloc(sizeof(ikSweepParam) * (p->nParams + 1));
+    p->metrics = (ikSweepMetric *) malloc(sizeof(ikSweepMetric) * (p->nMetrics + 1));
+    p->results = (double *) malloc(sizeof(double) * ((size_t) p->nVariants * p->nMetrics + 1));
+    p->errors = (int *) malloc(sizeof(int) * p->nVariants);
+    if ((NULL == p->params) || (NULL == p->metrics) || (NULL == p->results) || (NULL == p->errors)) {
+        ikSweep_delete(self);
+        return -8;
+    }
+    if (p->nParams) memcpy(p->params, params->params, sizeof(ikSweepParam) * p->nParams);
+    if (p->nMetrics) memcpy(p->metrics, params->metrics, sizeof(ikSweepMetric) * p->nMetrics);
+    for (i = 0; i < p->nVariants * p->nMetrics; i++) p->results[i] = NAN;
+    for (i = 0; i < p->nVariants; i++) p->errors[i] = 0;
+
+    return 0;
+}
+
+void ikSweep_initParams(ikSweepParams *params) {
+    ikConLoop_initParams(&(params->loop));
+    params->nParams = 0;
+    params->params = NULL;
+    params->nRandom = 0;
+    params->seed = 1;
+    params->nMetrics = 0;
+    params->metrics = NULL;
+    params->nSteps = 0;
+    params->maxSp = NULL;
+    params->feedback = NULL;
+    params->minCon = NULL;
+    params->maxCon = NULL;
+    params->nThreads = 1;
+}
+
+int ikSweep_run(ikSweep *self) {
+    ikSweepPrivate *p = &(self->priv);
+    ikSweepWorker *workers;
+    atomic_int next;
+    int nThreads = p->nThreads < p->nVariants ? p->nThreads : p->nVariants;
+    int nStarted;
+    int failed = 0;
+    int err = 0;
+    int i;
+
+    /*set up the workers, one per thread */
+    workers = (ikSweepWorker *) calloc(nThreads, sizeof(ikSweepWorker));
+    if (NULL == workers) return -1;
+    atomic_init(&next, 0);
+    for (i = 0; i < nThreads; i++) {
+        workers[i].sweep = self;
+        workers[i].next = &next;
+        workers[i].values = (double *) malloc(sizeof(double) * (p->nParams + 1));
+        workers[i].acc = (double *) malloc(sizeof(double) * IKSWEEP_NACC * (p->nMetrics + 1));
+        workers[i].signals = (const double **) malloc(sizeof(const double *) * (p->nMetrics + 1));
+        if ((NULL == workers[i].values) || (NULL == workers[i].acc) || (NULL == workers[i].signals)) err = -1;
+    }
+
+    /*run, with the calling thread as worker 0, and as many other threads as
+     can be started, as the variants are taken as the workers go */
+    for (nStarted = 1; (nStarted < nThreads) && !err; nStarted++) {
+        if (pthread_create(&(workers[nStarted].thread), NULL, ikSweep_worker, &(workers[nStarted]))) break;
+    }
+    if (!err) ikSweep_work(&(workers[0]));
+    for (i = 1; (i < nStarted) && !err; i++) pthread_join(workers[i].thread, NULL);
+
+    /*count the failed variants, and clean up */
+    for (i = 0; i < nThreads; i++) {
+        failed += workers[i].failed;
+        free(workers[i].values);
+        free(workers[i].acc);
+        free(workers[i].signals);
+        free(workers[i].buffer);
+    }
+    free(workers);
+
+    return err ? err : failed;
+}
+
+int ikSweep_getNVariants(const ikSweep *self) {
+    return self->priv.nVariants;
+}
+
+int ikSweep_getVariant(const ikSweep *self, int variant, double values[]) {
+    if ((0 > variant) || (self->priv.nVariants <= variant)) return -1;
+    ikSweep_values(self, variant, values);
+    return 0;
+}
+
+int ikSweep_getMetrics(const ikSweep *self, int variant, double metrics[]) {
+    int j;
+
+    if ((0 > variant) || (self->priv.nVariants <= variant)) return -1;
+    for (j = 0; j < self->priv.nMetrics; j++) metrics[j] = self->priv.results[(size_t) variant * self->priv.nMetrics + j];
+    return self->priv.errors[variant] ? -2 : 0;
+}
+
+void ikSweep_delete(ikSweep *self) {
+    free(self->priv.params);
+    free(self->priv.metrics);
+    free(self->priv.results);
+    free(self->priv.errors);
+    self->priv.params = NULL;
+    self->priv.metrics = NULL;
+    self->priv.results = NULL;
+    self->priv.errors = NULL;
+}
+
+/* @endcond */
@@ -0,0 +1,249 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikSweep.h
+ * 
+ * @brief Class ikSweep interface
+ */
+
+#ifndef IKSWEEP_H
+#define IKSWEEP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "ikConLoop.h"
+
+#define IKSWEEP_MEAN 0
+#define IKSWEEP_RMS 1
+#define IKSWEEP_VARIANCE 2
+#define IKSWEEP_MIN 3
+#define IKSWEEP_MAX 4
+#define IKSWEEP_SATURATION 5
+
+    /**
+     * @struct ikSweepParam
+     * @brief Swept control loop parameter
+     * 
+     * A swept parameter is a double member of @link ikConLoopParams @endlink,
+     * given by its offset, as taken with offsetof on that member, e.g.
+     * offsetof(ikConLoopParams, linearController.gainSchedY[1]) or
+     * offsetof(ikConLoopParams, linearController.measurementNotches.notchParams[0].freq).
+     * The offset must therefore be a multiple of the alignment of double.
+     */
+    typedef struct ikSweepParam {
+        size_t offset; /**<offset of the parameter in ikConLoopParams, in bytes*/
+        int nValues; /**<number of values, for a grid sweep*/
+        const double *values; /**<array of nValues values, for a grid sweep*/
+        double min; /**<lower bound, for a random sweep*/
+        double max; /**<upper bound, for a random sweep*/
+    } ikSweepParam;
+
+    /**
+     * @struct ikSweepMetric
+     * @brief Control loop performance metric
+     * 
+     * Metrics are computed over all steps of the input trace, as the
+     * variants are run, with no outputs stored. The signals are looked up
+     * once per variant, and those held by the control loop, e.g.
+     * "control action", "setpoint" or "linear controller>measurement", are
+     * then read directly at each step. Those computed on request, e.g.
+     * "linear controller>error", are got by name at each step instead, which
+     * takes longer. The metric types are:
+     * @li @link IKSWEEP_MEAN @endlink: mean of the signal
+     * @li @link IKSWEEP_RMS @endlink: root mean square of the signal
+     * @li @link IKSWEEP_VARIANCE @endlink: variance of the signal
+     * @li @link IKSWEEP_MIN @endlink: minimum of the signal
+     * @li @link IKSWEEP_MAX @endlink: maximum of the signal
+     * @li @link IKSWEEP_SATURATION @endlink: fraction of steps with the
+     * control action at or beyond its limits, with no signal
+     */
+    typedef struct ikSweepMetric {
+        int type; /**<metric type*/
+        const char *signal; /**<signal name, as in @link ikConLoop_getOutput @endlink, e.g. "linear controller>error"*/
+    } ikSweepMetric;
+
+    /* @cond */
+    typedef struct ikSweepPrivate {
+        ikConLoopParams loop;
+        int nParams;
+        ikSweepParam *params;
+        int nRandom;
+        unsigned long seed;
+        int nMetrics;
+        ikSweepMetric *metrics;
+        int nSteps;
+        const double *maxSp;
+        const double *feedback;
+        const double *minCon;
+        const double *maxCon;
+        int nThreads;
+        int nVariants;
+        double *results;
+        int *errors;
+    } ikSweepPrivate;
+    /* @endcond */
+
+    /**
+     * @struct ikSweep
+     * @brief Control loop parameter sweep
+     * 
+     * Instances of this type run the same input trace through a number of
+     * variants of a control loop (@link ikConLoop @endlink), and compute a
+     * number of metrics for each variant. The variants are made from a base
+     * set of initialisation parameters, with some of its members swept:
+     * @li over a grid, with all combinations of the values of the swept
+     * parameters, the last one changing fastest, or
+     * @li over random samples, each parameter taken from a uniform
+     * distribution between its bounds. The samples depend on the seed and
+     * the variant index only.
+     * 
+     * The variants are run by a number of threads, the calling thread being
+     * one of them, each thread taking the next variant not taken yet until
+     * there are none left. All threads read the same input trace, which is
+     * not copied. Pointers in the base parameters, e.g. to a preferred
+     * control action, are shared by all variants, so what they point to
+     * should not change during the sweep. The exception is the region
+     * selector buffer: if the base parameters give one, each thread runs
+     * its variants with a buffer of its own. The results do not depend on
+     * the number of threads.
+     * 
+     * This class needs POSIX threads, and is meant for tuning, rather than
+     * for the turbine controllers themselves.
+     * 
+     * @par Methods
+     * @li @link ikSweep_initParams @endlink initialise initialisation parameter structure
+     * @li @link ikSweep_init @endlink initialise an instance
+     * @li @link ikSweep_run @endlink run all variants
+     * @li @link ikSweep_getNVariants @endlink get number of variants
+     * @li @link ikSweep_getVariant @endlink get parameter values of a variant
+     * @li @link ikSweep_getMetrics @endlink get metrics of a variant
+     * @li @link ikSweep_delete @endlink delete instance
+     */
+    typedef struct ikSweep {
+        /* @cond */
+        ikSweepPrivate priv;
+        /* @endcond */
+    } ikSweep;
+
+    /**
+     * @struct ikSweepParams
+     * @brief Control loop parameter sweep initialisation parameters
+     */
+    typedef struct ikSweepParams {
+        ikConLoopParams loop; /**<base control loop initialisation parameters*/
+        int nParams; /**<number of swept parameters. The default value is 0.*/
+        const ikSweepParam *params; /**<array of nParams swept parameters. The default value is NULL.*/
+        int nRandom; /**<number of random variants, or 0 for a grid sweep. The default value is 0.*/
+        unsigned long seed; /**<seed of the random variants. The default value is 1.*/
+        int nMetrics; /**<number of metrics. The default value is 0.*/
+        const ikSweepMetric *metrics; /**<array of nMetrics metrics. The default value is NULL.*/
+        int nSteps; /**<number of steps of the input trace. The default value is 0.*/
+        const double *maxSp; /**<array of nSteps maximum setpoint values, as in @link ikConLoop_step @endlink. The default value is NULL.*/
+        const double *feedback; /**<array of nSteps feedback values. The default value is NULL.*/
+        const double *minCon; /**<array of nSteps external minimum control action values. The default value is NULL.*/
+        const double *maxCon; /**<array of nSteps external maximum control action values. The default value is NULL.*/
+        int nThreads; /**<number of threads, including the calling thread. The default value is 1.*/
+    } ikSweepParams;
+
+    /**
+     * Initialise an instance
+     * 
+     * The swept parameters, the metrics and the base parameters are checked,
+     * the latter by initialising a control loop with them, and all metrics
+     * are set to NaN.
+     * 
+     * @param self instance
+     * @param params initialisation parameters
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid number of swept parameters, must not be negative
+     * @li -2: invalid swept parameter, with an offset out of ikConLoopParams
+     * or not aligned as a double, or no values for a grid sweep
+     * @li -3: invalid number of random variants, must not be negative
+     * @li -4: invalid metric type or signal name
+     * @li -5: invalid input trace, with no steps or a NULL array
+     * @li -6: invalid number of threads, must be positive
+     * @li -7: could not initialise a control loop with the base parameters
+     * @li -8: too many variants, or could not allocate memory
+     */
+    int ikSweep_init(ikSweep *self, const ikSweepParams *params);
+
+    /**
+     * Initialise initialisation parameter structure
+     * @param params initialisation parameter structure
+     */
+    void ikSweep_initParams(ikSweepParams *params);
+
+    /**
+     * Run all variants
+     * @param self instance
+     * @return number of variants with which the control loop could not be
+     * initialised, whose metrics are left as NaN, or -1 if memory could
+     * not be allocated
+     */
+    int ikSweep_run(ikSweep *self);
+
+    /**
+     * Get number of variants
+     * @param self instance
+     * @return number of variants
+     */
+    int ikSweep_getNVariants(const ikSweep *self);
+
+    /**
+     * Get the values of the swept parameters of a variant
+     * @param self instance
+     * @param variant variant index, starting at 0
+     * @param values array of one value per swept parameter, in the order of
+     * @link ikSweepParams.params @endlink
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid variant index
+     */
+    int ikSweep_getVariant(const ikSweep *self, int variant, double values[]);
+
+    /**
+     * Get the metrics of a variant, once run
+     * @param self instance
+     * @param variant variant index, starting at 0
+     * @param metrics array of one value per metric, in the order of
+     * @link ikSweepParams.metrics @endlink
+     * @return error code:
+     * @li 0: no error
+     * @li -1: invalid variant index
+     * @li -2: the control loop could not be initialised with the parameters
+     * of the variant
+     */
+    int ikSweep_getMetrics(const ikSweep *self, int variant, double metrics[]);
+
+    /**
+     * Delete instance
+     * @param self instance
+     */
+    void ikSweep_delete(ikSweep *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKSWEEP_H */
@@ -0,0 +1,445 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikSweep_test.c
+ * 
+ * @brief Class ikSweep unit tests
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <math.h>
+#include "ikSweep.h"
+
+/*
+ * Simple C Test Suite for class ikSweep
+ */
+
+#define NSTEPS 500
+
+double maxSp[NSTEPS];
+double feedback[NSTEPS];
+double minCon[NSTEPS];
+double maxCon[NSTEPS];
+
+const ikSweepMetric metrics[6] = {
+    {IKSWEEP_MEAN, "control action"},
+    {IKSWEEP_RMS, "control action"},
+    {IKSWEEP_VARIANCE, "control action"},
+    {IKSWEEP_MIN, "linear controller>error"},
+    {IKSWEEP_MAX, "linear controller>error"},
+    {IKSWEEP_SATURATION, NULL}
+};
+
+/**
+ * Set up the input trace.
+ */
+void initTrace() {
+    int i;
+    for (i = 0; i < NSTEPS; i++) {
+        maxSp[i] = 1.0 + 0.5 * sin(0.05 * i);
+        feedback[i] = sin(0.13 * i);
+        minCon[i] = -1.5;
+        maxCon[i] = 1.5;
+    }
+}
+
+/**
+ * Set up sweep parameters, with a proportional controller as base.
+ */
+void initSweepParams(ikSweepParams *params) {
+    ikSweep_initParams(params);
+    params->loop.linearController.errorTfs.tfParams[0].enable = 1;
+    params->loop.linearController.errorTfs.tfParams[0].b[0] = 1.0;
+    params->nMetrics = 6;
+    params->metrics = metrics;
+    params->nSteps = NSTEPS;
+    params->maxSp = maxSp;
+    params->feedback = feedback;
+    params->minCon = minCon;
+    params->maxCon = maxCon;
+}
+
+/**
+ * Compute the metrics of a control loop by running it directly, over all
+ * steps, keeping the signals.
+ */
+void runReference(const ikConLoopParams *params, double results[6]) {
+    ikConLoop loop;
+    double u[NSTEPS];
+    double e[NSTEPS];
+    double min, max;
+    double sum = 0.0;
+    double sumsq = 0.0;
+    double var = 0.0;
+    int sat = 0;
+    int i;
+
+    ikConLoop_init(&loop, params);
+    for (i = 0; i < NSTEPS; i++) {
+        u[i] = ikConLoop_step(&loop, maxSp[i], feedback[i], minCon[i], maxCon[i]);
+        ikConLoop_getOutput(&loop, &(e[i]), "linear controller>error");
+        ikConLoop_getOutput(&loop, &min, "minimum control action");
+        ikConLoop_getOutput(&loop, &max, "maximum control action");
+        if ((min >= u[i]) || (max <= u[i])) sat++;
+        sum += u[i];
+        sumsq += u[i] * u[i];
+    }
+    for (i = 0; i < NSTEPS; i++) var += (u[i] - sum / NSTEPS) * (u[i] - sum / NSTEPS);
+    results[0] = sum / NSTEPS;
+    results[1] = sqrt(sumsq / NSTEPS);
+    results[2] = var / NSTEPS;
+    results[3] = e[0];
+    results[4] = e[0];
+    for (i = 1; i < NSTEPS; i++) {
+        if (e[i] < results[3]) results[3] = e[i];
+        if (e[i] > results[4]) results[4] = e[i];
+    }
+    results[5] = (double) sat / NSTEPS;
+}
+
+/**
+ * A grid sweep runs all combinations of values, with the metrics of
+ * running each variant directly
+ */
+void testGrid() {
+    printf("ikSweep_test testGrid\n");
+    const double gains[3] = {1.0, 2.0, 4.0};
+    const double b1[2] = {0.0, -0.5};
+    ikSweepParam swept[2];
+    ikSweepParams params;
+    ikSweep sweep;
+    ikConLoopParams loopParams;
+    double values[2];
+    double results[6];
+    double expected[6];
+    double saturation = 0.0;
+    int err;
+    int v;
+    int j;
+
+    initTrace();
+    initSweepParams(&params);
+    swept[0].offset = offsetof(ikConLoopParams, linearController.errorTfs.tfParams[0].b[0]);
+    swept[0].nValues = 3;
+    swept[0].values = gains;
+    swept[1].offset = offsetof(ikConLoopParams, linearController.errorTfs.tfParams[0].b[1]);
+    swept[1].nValues = 2;
+    swept[1].values = b1;
+    params.nParams = 2;
+    params.params = swept;
+    params.nThreads = 3;
+    err = ikSweep_init(&sweep, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testGrid (ikSweep_test) message=init expected to return 0, but it returned %d\n", err);
+    if (6 != ikSweep_getNVariants(&sweep)) printf("%%TEST_FAILED%% time=0 testname=testGrid (ikSweep_test) message=expected 6 variants, but there are %d\n", ikSweep_getNVariants(&sweep));
+
+    /* the last parameter changes fastest */
+    ikSweep_getVariant(&sweep, 3, values);
+    if ((2.0 != values[0]) || (-0.5 != values[1])) printf("%%TEST_FAILED%% time=0 testname=testGrid (ikSweep_test) message=variant 3 expected to be {2.0, -0.5}, but it is {%f, %f}\n", values[0], values[1]);
+
+    /* metrics are NaN until run */
+    ikSweep_getMetrics(&sweep, 0, results);
+    if (!isnan(results[0])) printf("%%TEST_FAILED%% time=0 testname=testGrid (ikSweep_test) message=metrics expected to be NaN before running\n");
+
+    err = ikSweep_run(&sweep);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testGrid (ikSweep_test) message=run expected to return 0, but it returned %d\n", err);
+    for (v = 0; v < 6; v++) {
+        ikSweep_getVariant(&sweep, v, values);
+        loopParams = params.loop;
+        loopParams.linearController.errorTfs.tfParams[0].b[0] = values[0];
+        loopParams.linearController.errorTfs.tfParams[0].b[1] = values[1];
+        runReference(&loopParams, expected);
+        err = ikSweep_getMetrics(&sweep, v, results);
+        if (err) printf("%%TEST_FAILED%% time=0 testname=testGrid (ikSweep_test) message=getMetrics expected to return 0, but it returned %d\n", err);
+        for (j = 0; j < 6; j++) {
+            if (fabs(expected[j] - results[j]) > 1e-9 * (1.0 + fabs(expected[j]))) printf("%%TEST_FAILED%% time=0 testname=testGrid (ikSweep_test) message=metric %d of variant %d expected to be %f, but it is %f\n", j, v, expected[j], results[j]);
+        }
+        if (saturation < results[5]) saturation = results[5];
+    }
+
+    /* the trace saturates the largest gains */
+    if (0.0 >= saturation) printf("%%TEST_FAILED%% time=0 testname=testGrid (ikSweep_test) message=expected some saturation\n");
+
+    /* invalid variant indices */
+    err = ikSweep_getVariant(&sweep, 6, values);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testGrid (ikSweep_test) message=getVariant expected to return -1, but it returned %d\n", err);
+    err = ikSweep_getMetrics(&sweep, -1, results);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testGrid (ikSweep_test) message=getMetrics expected to return -1, but it returned %d\n", err);
+
+    ikSweep_delete(&sweep);
+}
+
+/**
+ * A random sweep gives the same variants and metrics whatever the number
+ * of threads, within the bounds, and other variants with another seed
+ */
+void testRandom() {
+    printf("ikSweep_test testRandom\n");
+    ikSweepParam swept[2];
+    ikSweepParams params;
+    ikSweep sweep1;
+    ikSweep sweep4;
+    ikSweep sweepSeed;
+    double values1[2];
+    double values4[2];
+    double results1[6];
+    double results4[6];
+    int same = 1;
+    int v;
+    int j;
+
+    initTrace();
+    initSweepParams(&params);
+    swept[0].offset = offsetof(ikConLoopParams, linearController.errorTfs.tfParams[0].b[0]);
+    swept[0].min = 0.5;
+    swept[0].max = 5.0;
+    swept[1].offset = offsetof(ikConLoopParams, linearController.errorTfs.tfParams[0].b[1]);
+    swept[1].min = -0.4;
+    swept[1].max = 0.0;
+    params.nParams = 2;
+    params.params = swept;
+    params.nRandom = 40;
+    params.seed = 7;
+    params.nThreads = 1;
+    ikSweep_init(&sweep1, &params);
+    params.nThreads = 4;
+    ikSweep_init(&sweep4, &params);
+    params.seed = 8;
+    ikSweep_init(&sweepSeed, &params);
+    if (40 != ikSweep_getNVariants(&sweep4)) printf("%%TEST_FAILED%% time=0 testname=testRandom (ikSweep_test) message=expected 40 variants, but there are %d\n", ikSweep_getNVariants(&sweep4));
+    ikSweep_run(&sweep1);
+    ikSweep_run(&sweep4);
+
+    for (v = 0; v < 40; v++) {
+        ikSweep_getVariant(&sweep1, v, values1);
+        ikSweep_getVariant(&sweep4, v, values4);
+        if ((values1[0] != values4[0]) || (values1[1] != values4[1])) printf("%%TEST_FAILED%% time=0 testname=testRandom (ikSweep_test) message=variant %d differs with 4 threads\n", v);
+        if ((0.5 > values1[0]) || (5.0 < values1[0]) || (-0.4 > values1[1]) || (0.0 < values1[1])) printf("%%TEST_FAILED%% time=0 testname=testRandom (ikSweep_test) message=variant %d out of bounds\n", v);
+        ikSweep_getMetrics(&sweep1, v, results1);
+        ikSweep_getMetrics(&sweep4, v, results4);
+        for (j = 0; j < 6; j++) {
+            if (results1[j] != results4[j]) printf("%%TEST_FAILED%% time=0 testname=testRandom (ikSweep_test) message=metric %d of variant %d differs with 4 threads\n", j, v);
+        }
+        ikSweep_getVariant(&sweepSeed, v, values4);
+        if (values1[0] != values4[0]) same = 0;
+    }
+    if (same) printf("%%TEST_FAILED%% time=0 testname=testRandom (ikSweep_test) message=variants expected to change with the seed\n");
+
+    ikSweep_delete(&sweep1);
+    ikSweep_delete(&sweep4);
+    ikSweep_delete(&sweepSeed);
+}
+
+/**
+ * Variants which cannot be initialised are counted, and have NaN metrics
+ */
+void testFailedVariants() {
+    printf("ikSweep_test testFailedVariants\n");
+    const double a0[3] = {1.0, 0.0, 2.0};
+    ikSweepParam swept;
+    ikSweepParams params;
+    ikSweep sweep;
+    double results[6];
+    int err;
+
+    initTrace();
+    initSweepParams(&params);
+    swept.offset = offsetof(ikConLoopParams, linearController.errorTfs.tfParams[0].a[0]);
+    swept.nValues = 3;
+    swept.values = a0;
+    params.nParams = 1;
+    params.params = &swept;
+    params.nThreads = 2;
+    ikSweep_init(&sweep, &params);
+    err = ikSweep_run(&sweep);
+    if (1 != err) printf("%%TEST_FAILED%% time=0 testname=testFailedVariants (ikSweep_test) message=run expected to return 1, but it returned %d\n", err);
+    err = ikSweep_getMetrics(&sweep, 1, results);
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=testFailedVariants (ikSweep_test) message=getMetrics expected to return -2, but it returned %d\n", err);
+    if (!isnan(results[1])) printf("%%TEST_FAILED%% time=0 testname=testFailedVariants (ikSweep_test) message=metrics of a failed variant expected to be NaN, but got %f\n", results[1]);
+    err = ikSweep_getMetrics(&sweep, 2, results);
+    if (err || isnan(results[1])) printf("%%TEST_FAILED%% time=0 testname=testFailedVariants (ikSweep_test) message=variant 2 expected to run\n");
+    ikSweep_delete(&sweep);
+}
+
+/**
+ * The signals read directly from the control loop match those got by name
+ */
+void testSignals() {
+    printf("ikSweep_test testSignals\n");
+    const char *names[12] = {"setpoint", "feedback", "maximum setpoint", "minimum control action",
+        "maximum control action", "external minimum control action", "external maximum control action",
+        "x", "y", "linear controller>measurement", "linear controller>filtered demand", "linear controller>post-gain value"};
+    ikSweepMetric signalMetrics[24];
+    ikSweepParams params;
+    ikSweep sweep;
+    ikConLoop loop;
+    double results[24];
+    double expected[24];
+    double x;
+    int err;
+    int i, j;
+
+    /* the minimum and maximum of each signal */
+    initTrace();
+    initSweepParams(&params);
+    params.loop.linearController.demandTfs.tfParams[0].enable = 1;
+    params.loop.linearController.demandTfs.tfParams[0].b[0] = 0.5;
+    params.loop.linearController.demandTfs.tfParams[0].a[1] = -0.5;
+    for (j = 0; j < 12; j++) {
+        signalMetrics[2 * j].type = IKSWEEP_MIN;
+        signalMetrics[2 * j].signal = names[j];
+        signalMetrics[2 * j + 1].type = IKSWEEP_MAX;
+        signalMetrics[2 * j + 1].signal = names[j];
+        expected[2 * j] = INFINITY;
+        expected[2 * j + 1] = -INFINITY;
+    }
+    params.nMetrics = 24;
+    params.metrics = signalMetrics;
+    err = ikSweep_init(&sweep, &params);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testSignals (ikSweep_test) message=init expected to return 0, but it returned %d\n", err);
+    ikSweep_run(&sweep);
+    ikSweep_getMetrics(&sweep, 0, results);
+
+    /* compared with the signals got by name */
+    ikConLoop_init(&loop, &(params.loop));
+    for (i = 0; i < NSTEPS; i++) {
+        ikConLoop_step(&loop, maxSp[i], feedback[i], minCon[i], maxCon[i]);
+        for (j = 0; j < 12; j++) {
+            ikConLoop_getOutput(&loop, &x, names[j]);
+            if (x < expected[2 * j]) expected[2 * j] = x;
+            if (x > expected[2 * j + 1]) expected[2 * j + 1] = x;
+        }
+    }
+    for (j = 0; j < 24; j++) {
+        if (expected[j] != results[j]) printf("%%TEST_FAILED%% time=0 testname=testSignals (ikSweep_test) message=metric %d of %s expected to be %f, but it is %f\n", j, names[j / 2], expected[j], results[j]);
+    }
+    ikSweep_delete(&sweep);
+}
+
+/**
+ * Init returns the right error codes when passed bad initialisation parameters
+ */
+void testInitErrors() {
+    printf("ikSweep_test testInitErrors\n");
+    const double values[2] = {1.0, 2.0};
+    ikSweepParam swept;
+    ikSweepMetric metric;
+    ikSweepParams params;
+    ikSweep sweep;
+    int err;
+
+    initTrace();
+    swept.offset = offsetof(ikConLoopParams, linearController.errorTfs.tfParams[0].b[0]);
+    swept.nValues = 2;
+    swept.values = values;
+
+    /* -1 for a negative number of swept parameters */
+    initSweepParams(&params);
+    params.nParams = -1;
+    err = ikSweep_init(&sweep, &params);
+    if (-1 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikSweep_test) message=init expected to return -1, but it returned %d\n", err);
+
+    /* -2 for an offset out of the parameters, or no values */
+    initSweepParams(&params);
+    params.nParams = 1;
+    params.params = &swept;
+    swept.offset = sizeof(ikConLoopParams);
+    err = ikSweep_init(&sweep, &params);
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikSweep_test) message=init expected to return -2, but it returned %d\n", err);
+    swept.offset = offsetof(ikConLoopParams, linearController.errorTfs.tfParams[0].b[0]) + 1;
+    err = ikSweep_init(&sweep, &params);
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikSweep_test) message=init expected to return -2 for a misaligned offset, but it returned %d\n", err);
+    swept.offset = offsetof(ikConLoopParams, linearController.errorTfs.tfParams[0].b[0]);
+    swept.nValues = 0;
+    err = ikSweep_init(&sweep, &params);
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikSweep_test) message=init expected to return -2, but it returned %d\n", err);
+    swept.nValues = 2;
+
+    /* -3 for a negative number of random variants */
+    initSweepParams(&params);
+    params.nRandom = -1;
+    err = ikSweep_init(&sweep, &params);
+    if (-3 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikSweep_test) message=init expected to return -3, but it returned %d\n", err);
+
+    /* -4 for an invalid metric type or signal name */
+    initSweepParams(&params);
+    metric.type = 6;
+    metric.signal = "control action";
+    params.nMetrics = 1;
+    params.metrics = &metric;
+    err = ikSweep_init(&sweep, &params);
+    if (-4 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikSweep_test) message=init expected to return -4, but it returned %d\n", err);
+    metric.type = IKSWEEP_RMS;
+    metric.signal = "linear controller>nothing";
+    err = ikSweep_init(&sweep, &params);
+    if (-4 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikSweep_test) message=init expected to return -4, but it returned %d\n", err);
+
+    /* -5 for no input trace */
+    initSweepParams(&params);
+    params.nSteps = 0;
+    err = ikSweep_init(&sweep, &params);
+    if (-5 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikSweep_test) message=init expected to return -5, but it returned %d\n", err);
+    initSweepParams(&params);
+    params.feedback = NULL;
+    err = ikSweep_init(&sweep, &params);
+    if (-5 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikSweep_test) message=init expected to return -5, but it returned %d\n", err);
+
+    /* -6 for no threads */
+    initSweepParams(&params);
+    params.nThreads = 0;
+    err = ikSweep_init(&sweep, &params);
+    if (-6 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikSweep_test) message=init expected to return -6, but it returned %d\n", err);
+
+    /* -7 for bad base parameters */
+    initSweepParams(&params);
+    params.loop.linearController.gainSchedN = -1;
+    err = ikSweep_init(&sweep, &params);
+    if (-7 != err) printf("%%TEST_FAILED%% time=0 testname=testInitErrors (ikSweep_test) message=init expected to return -7, but it returned %d\n", err);
+}
+
+int main(int argc, char** argv) {
+    printf("%%SUITE_STARTING%% ikSweep_test\n");
+    printf("%%SUITE_STARTED%%\n");
+
+    printf("%%TEST_STARTED%% grid (ikSweep_test)\n");
+    testGrid();
+    printf("%%TEST_FINISHED%% time=0 grid (ikSweep_test) \n");
+
+    printf("%%TEST_STARTED%% random (ikSweep_test)\n");
+    testRandom();
+    printf("%%TEST_FINISHED%% time=0 random (ikSweep_test) \n");
+
+    printf("%%TEST_STARTED%% failed_variants (ikSweep_test)\n");
+    testFailedVariants();
+    printf("%%TEST_FINISHED%% time=0 failed_variants (ikSweep_test) \n");
+
+    printf("%%TEST_STARTED%% signals (ikSweep_test)\n");
+    testSignals();
+    printf("%%TEST_FINISHED%% time=0 signals (ikSweep_test) \n");
+
+    printf("%%TEST_STARTED%% init_errors (ikSweep_test)\n");
+    testInitErrors();
+    printf("%%TEST_FINISHED%% time=0 init_errors (ikSweep_test) \n");
+
+    printf("%%SUITE_FINISHED%% time=0\n");
+
+    return (EXIT_SUCCESS);
+}
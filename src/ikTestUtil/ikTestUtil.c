@@ -0,0 +1,85 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikTestUtil.c
+ * 
+ * @brief Fixtures shared by the unit tests and the benchmarks
+ */
+
+/* @cond */
+
+#include <stdio.h>
+#include <math.h>
+#include "ikTestUtil.h"
+
+/**
+ * (Private) state of the pseudo-random number generator
+ */
+unsigned long ikTestUtil_seed = 1;
+
+double ikTestUtil_rand(double min, double max) {
+    ikTestUtil_seed = (1103515245UL * ikTestUtil_seed + 12345UL) % 2147483648UL;
+    return min + (max - min) * ((double) ikTestUtil_seed / 2147483648.0);
+}
+
+/**
+ * (Private) write a surface file of 2 dimensions
+ */
+int ikTestUtil_writeSurface(const char *fileName, const int ndata[], const double data[]) {
+    int dims = 3;
+    FILE *f;
+
+    f = fopen(fileName, "wb");
+    if (NULL == f) return -1;
+    fwrite(&dims, sizeof(int), 1, f);
+    fwrite(ndata, sizeof(int), 2, f);
+    fwrite(data, sizeof(double), ndata[0] + ndata[1] + ndata[0]*ndata[1], f);
+    return fclose(f) ? -1 : 0;
+}
+
+int ikTestUtil_writeSurfaces(const char *cpFileName, const char *ctFileName) {
+    int ndata[2] = {13, 7};
+    double data[13 + 7 + 13*7];
+    int i, j;
+
+    /*tip-speed ratio and pitch angle coordinates */
+    for (i = 0; i < 13; i++) data[i] = 2.0 + i;
+    for (j = 0; j < 7; j++) data[13 + j] = 5.0 * j;
+
+    /*Cp/lambda^3 */
+    for (i = 0; i < 13; i++) {
+        for (j = 0; j < 7; j++) {
+            data[20 + 7*i + j] = 0.5 * exp(-data[13 + j] / 15.0) / (data[i]*data[i]*data[i]);
+        }
+    }
+    if (ikTestUtil_writeSurface(cpFileName, ndata, data)) return -1;
+
+    /*Ct/lambda^2 */
+    for (i = 0; i < 13; i++) {
+        for (j = 0; j < 7; j++) {
+            data[20 + 7*i + j] = (1.2 - data[13 + j] / 30.0) / (data[i]*data[i]);
+        }
+    }
+    if (ikTestUtil_writeSurface(ctFileName, ndata, data)) return -1;
+
+    return 0;
+}
+
+/* @endcond */
@@ -0,0 +1,65 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikTestUtil.h
+ * 
+ * @brief Fixtures shared by the unit tests and the benchmarks
+ * 
+ * These functions are not part of the controllers. They set up the inputs
+ * that several of the unit tests and benchmarks need, so that each of them
+ * does not have a copy of its own.
+ */
+
+#ifndef IKTESTUTIL_H
+#define IKTESTUTIL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**
+     * Draw a pseudo-random number, from a simple linear congruential
+     * generator, so that the results do not depend on the C library. Each
+     * program draws the same sequence, from a seed of 1.
+     * @param min minimum value
+     * @param max maximum value
+     * @return number uniformly distributed between min and max
+     */
+    double ikTestUtil_rand(double min, double max);
+
+    /**
+     * Write a pair of surface files, as read by @link ikSurf_newf @endlink,
+     * for tip-speed ratio estimators and thrust limiters: one with the power
+     * coefficient over the cube of the tip-speed ratio, and one with the
+     * thrust coefficient over its square, both as functions of the tip-speed
+     * ratio and the pitch angle, for a simple rotor.
+     * @param cpFileName name of the power coefficient surface file
+     * @param ctFileName name of the thrust coefficient surface file
+     * @return error code:
+     * @li 0: no error
+     * @li -1: could not write one of the files
+     */
+    int ikTestUtil_writeSurfaces(const char *cpFileName, const char *ctFileName);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IKTESTUTIL_H */
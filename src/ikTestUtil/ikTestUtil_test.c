@@ -0,0 +1,103 @@
+/*
+Copyright (C) 2015-2017 IK4-IKERLAN
+
+This file is part of OpenWitcon.
+ 
+OpenWitcon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+ 
+OpenWitcon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+ 
+You should have received a copy of the GNU General Public License
+along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ikTestUtil_test.c
+ * 
+ * @brief Shared test fixtures unit tests
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "ikSurf.h"
+#include "ikTestUtil.h"
+
+/*
+ * Simple C Test Suite for the shared test fixtures
+ */
+
+/**
+ * The pseudo-random numbers are within range, and the same on every
+ * platform
+ */
+void testRand() {
+    printf("ikTestUtil_test testRand\n");
+    double x;
+    double mean = 0.0;
+    int nOut = 0;
+    int i;
+
+    /*the first value follows from the seed of 1 */
+    x = ikTestUtil_rand(0.0, 2147483648.0);
+    if (1103527590.0 != x) printf("%%TEST_FAILED%% time=0 testname=testRand (ikTestUtil_test) message=first value expected to be 1103527590, but it is %f\n", x);
+
+    for (i = 0; i < 10000; i++) {
+        x = ikTestUtil_rand(-3.0, 5.0);
+        nOut += (-3.0 > x) || (5.0 <= x);
+        mean += x / 10000;
+    }
+    if (nOut) printf("%%TEST_FAILED%% time=0 testname=testRand (ikTestUtil_test) message=expected all values within range, but %d were not\n", nOut);
+    if (0.1 < fabs(1.0 - mean)) printf("%%TEST_FAILED%% time=0 testname=testRand (ikTestUtil_test) message=mean expected to be about 1, but it is %f\n", mean);
+}
+
+/**
+ * The surface files can be read back
+ */
+void testWriteSurfaces() {
+    printf("ikTestUtil_test testWriteSurfaces\n");
+    const char *fileNames[2] = {"ikTestUtil_test_cp.bin", "ikTestUtil_test_ct.bin"};
+    ikSurf *surf;
+    const char *err;
+    int i;
+
+    if (ikTestUtil_writeSurfaces(fileNames[0], fileNames[1])) printf("%%TEST_FAILED%% time=0 testname=testWriteSurfaces (ikTestUtil_test) message=could not write surface files\n");
+    for (i = 0; i < 2; i++) {
+        err = ikSurf_newf(&surf, fileNames[i]);
+        if (strcmp("", err)) {
+            printf("%%TEST_FAILED%% time=0 testname=testWriteSurfaces (ikTestUtil_test) message=ikSurf_newf expected to return \"\" for %s, but it returned \"%s\"\n", fileNames[i], err);
+            continue;
+        }
+        if ((3 != ikSurf_getDimensions(surf)) || (13 != ikSurf_getPointNumber(surf, 0)) || (7 != ikSurf_getPointNumber(surf, 1))) printf("%%TEST_FAILED%% time=0 testname=testWriteSurfaces (ikTestUtil_test) message=expected 3 dimensions, with 13 by 7 points, in %s\n", fileNames[i]);
+        ikSurf_delete(surf);
+        remove(fileNames[i]);
+    }
+
+    /*unwritable files */
+    if (-1 != ikTestUtil_writeSurfaces("ikTestUtil_test_none/cp.bin", fileNames[1])) printf("%%TEST_FAILED%% time=0 testname=testWriteSurfaces (ikTestUtil_test) message=expected -1 for a file in a directory that does not exist\n");
+    remove(fileNames[1]);
+}
+
+int main(int argc, char** argv) {
+    printf("%%SUITE_STARTING%% ikTestUtil_test\n");
+    printf("%%SUITE_STARTED%%\n");
+
+    printf("%%TEST_STARTED%% testRand (ikTestUtil_test)\n");
+    testRand();
+    printf("%%TEST_FINISHED%% time=0 testRand (ikTestUtil_test) \n");
+
+    printf("%%TEST_STARTED%% testWriteSurfaces (ikTestUtil_test)\n");
+    testWriteSurfaces();
+    printf("%%TEST_FINISHED%% time=0 testWriteSurfaces (ikTestUtil_test) \n");
+
+    printf("%%SUITE_FINISHED%% time=0\n");
+
+    return (EXIT_SUCCESS);
+}
@@ -28,60 +28,91 @@ along with OpenWitcon. If not, see <http://www.gnu.org/licenses/>.
 #include <stdlib.h>
 #include "../ikTfList/ikTfList.h"
 
+/**
+ * (Private) get a list of a given length over the transfer functions of a
+ * list of IKTFLIST_NMAX
+ */
+ikTfListN ikTfList_view(const ikTfList *self) {
+    ikTfListN list;
+    
+    list.n = IKTFLIST_NMAX;
+    list.items = (ikTfListItem *) self->items;
+    return list;
+}
+
 int ikTfList_init(ikTfList *self, const ikTfListParams *params) {
+    ikTfListN list;
+    
+    /* initialise all the transfer functions, in the instance */
+    return ikTfListN_init(&list, IKTFLIST_NMAX, params->tfParams, self->items);
+}
+
+int ikTfListN_init(ikTfListN *self, int n, const ikTfParams params[], ikTfListItem buffer[]) {
     /* initialise error code */
     int err = 0;
     int err_;
-    /* initialise all transfer functions */
     int i;
-    for (i = 0; i < IKTFLIST_NMAX; i++) {
+    ikTfListItem *item;
+    
+    /* check the number of transfer functions */
+    if (1 > n) {
+        self->n = 0;
+        self->items = NULL;
+        return 1;
+    }
+    self->n = n;
+    self->items = buffer;
+    
+    /* initialise all transfer functions */
+    for (i = 0; i < n; i++) {
+        item = &(self->items[i]);
         /* default initialisation */
-        ikSlti_init(&(self->tfs[i]));
-        self->enable[i] = 0;
-        self->varEnable[i] = NULL;
-        self->minInput[i] = NULL;
-        self->maxInput[i] = NULL;
-        self->minOutput[i] = NULL;
-        self->maxOutput[i] = NULL;
+        ikSlti_init(&(item->tf));
+        item->enable = 0;
+        item->varEnable = NULL;
+        item->minInput = NULL;
+        item->maxInput = NULL;
+        item->minOutput = NULL;
+        item->maxOutput = NULL;
         /* if not to be used, leave at that */
-        if (!(params->tfParams[i].enable) && (NULL == params->tfParams[i].variableEnable)) continue;
+        if (!(params[i].enable) && (NULL == params[i].variableEnable)) continue;
         /* copy enable settings */
-        self->enable[i] = params->tfParams[i].enable;
-        self->varEnable[i] = params->tfParams[i].variableEnable;
+        item->enable = params[i].enable;
+        item->varEnable = params[i].variableEnable;
         /* configure saturation */
-        if (NULL == params->tfParams[i].minInput) {
-            if (NULL == params->tfParams[i].maxInput) {
-                ikSlti_setInSat(&(self->tfs[i]), 0, 0.0, 0.0);
+        if (NULL == params[i].minInput) {
+            if (NULL == params[i].maxInput) {
+                ikSlti_setInSat(&(item->tf), 0, 0.0, 0.0);
             } else {
-                ikSlti_setInSat(&(self->tfs[i]), 1, 0.0, 0.0);
+                ikSlti_setInSat(&(item->tf), 1, 0.0, 0.0);
             }
         } else {
-            if (NULL == params->tfParams[i].maxInput) {
-                ikSlti_setInSat(&(self->tfs[i]), -1, 0.0, 0.0);
+            if (NULL == params[i].maxInput) {
+                ikSlti_setInSat(&(item->tf), -1, 0.0, 0.0);
             } else {
-                ikSlti_setInSat(&(self->tfs[i]), 2, 0.0, 0.0);
+                ikSlti_setInSat(&(item->tf), 2, 0.0, 0.0);
             }
         }
-        if (NULL == params->tfParams[i].minOutput) {
-            if (NULL == params->tfParams[i].maxOutput) {
-                ikSlti_setOutSat(&(self->tfs[i]), 0, 0.0, 0.0);
+        if (NULL == params[i].minOutput) {
+            if (NULL == params[i].maxOutput) {
+                ikSlti_setOutSat(&(item->tf), 0, 0.0, 0.0);
             } else {
-                ikSlti_setOutSat(&(self->tfs[i]), 1, 0.0, 0.0);
+                ikSlti_setOutSat(&(item->tf), 1, 0.0, 0.0);
             }
         } else {
-            if (NULL == params->tfParams[i].maxOutput) {
-                ikSlti_setOutSat(&(self->tfs[i]), -1, 0.0, 0.0);
+            if (NULL == params[i].maxOutput) {
+                ikSlti_setOutSat(&(item->tf), -1, 0.0, 0.0);
             } else {
-                ikSlti_setOutSat(&(self->tfs[i]), 2, 0.0, 0.0);
+                ikSlti_setOutSat(&(item->tf), 2, 0.0, 0.0);
             }
         }
         /* copy addresses of saturation limits */
-        self->minInput[i] = params->tfParams[i].minInput;
-        self->maxInput[i] = params->tfParams[i].maxInput;
-        self->minOutput[i] = params->tfParams[i].minOutput;
-        self->maxOutput[i] = params->tfParams[i].maxOutput;
+        item->minInput = params[i].minInput;
+        item->maxInput = params[i].maxInput;
+        item->minOutput = params[i].minOutput;
+        item->maxOutput = params[i].maxOutput;
         /* set transfer function parameters */
-        err_ = ikSlti_setParam(&(self->tfs[i]), params->tfParams[i].a, params->tfParams[i].b);
+        err_ = ikSlti_setParam(&(item->tf), params[i].a, params[i].b);
         if (!err && err_) err = -(i + 1);   
     }
     
@@ -90,55 +121,68 @@ int ikTfList_init(ikTfList *self, const ikTfListParams *params) {
 }
 
 void ikTfList_initParams(ikTfListParams *params) {
+    /* go through all the transfer functions */
+    ikTfList_initTfParams(params->tfParams, IKTFLIST_NMAX);
+}
+
+void ikTfList_initTfParams(ikTfParams params[], int n) {
     int j;
         
     /* go through all the transfer functions */
     int i;
-    for (i = 0; i < IKTFLIST_NMAX; i++) {
+    for (i = 0; i < n; i++) {
         /* set transfer function parameters to static gain of 1 */
-        params->tfParams[i].a[0] = 1.0;
-        params->tfParams[i].b[0] = 1.0;
+        params[i].a[0] = 1.0;
+        params[i].b[0] = 1.0;
         for (j = 1; j < 3; j++) {
-            params->tfParams[i].a[j] = 0.0;
-            params->tfParams[i].b[j] = 0.0;
+            params[i].a[j] = 0.0;
+            params[i].b[j] = 0.0;
         }
         /* permanently disable the transfer function */
-        params->tfParams[i].enable = 0;
-        params->tfParams[i].variableEnable = NULL;
+        params[i].enable = 0;
+        params[i].variableEnable = NULL;
         /* disable saturation */
-        params->tfParams[i].minInput = NULL;
-        params->tfParams[i].maxInput = NULL;
-        params->tfParams[i].minOutput = NULL;
-        params->tfParams[i].maxOutput = NULL;
+        params[i].minInput = NULL;
+        params[i].maxInput = NULL;
+        params[i].minOutput = NULL;
+        params[i].maxOutput = NULL;
     }
 }
 
-double ikTfList_step(ikTfList *self, double input) { 
+double ikTfList_step(ikTfList *self, double input) {
+    ikTfListN list = ikTfList_view(self);
+    
+    return ikTfListN_step(&list, input);
+}
+
+double ikTfListN_step(ikTfListN *self, double input) {
     /* declare output and intermediate signals */
     double output = input;
     double output_;
+    ikTfListItem *item;
     /* repeat for all the transfer functions */
     int i;
-    for (i = IKTFLIST_NMAX - 1; i >= 0; i--) {
+    for (i = self->n - 1; i >= 0; i--) {
         /* pick up the saturation limits */
         int sat;
         double minsat;
         double maxsat;
-        sat = ikSlti_getInSat(&(self->tfs[i]), &minsat, &maxsat);
-        if (NULL != self->minInput[i]) minsat = *(self->minInput[i]);
-        if (NULL != self->maxInput[i]) maxsat = *(self->maxInput[i]);
-        ikSlti_setInSat(&(self->tfs[i]), sat, minsat, maxsat);
-        sat = ikSlti_getOutSat(&(self->tfs[i]), &minsat, &maxsat);
-        if (NULL != self->minOutput[i]) minsat = *(self->minOutput[i]);
-        if (NULL != self->maxOutput[i]) maxsat = *(self->maxOutput[i]);
-        ikSlti_setOutSat(&(self->tfs[i]), sat, minsat, maxsat);
+        item = &(self->items[i]);
+        sat = ikSlti_getInSat(&(item->tf), &minsat, &maxsat);
+        if (NULL != item->minInput) minsat = *(item->minInput);
+        if (NULL != item->maxInput) maxsat = *(item->maxInput);
+        ikSlti_setInSat(&(item->tf), sat, minsat, maxsat);
+        sat = ikSlti_getOutSat(&(item->tf), &minsat, &maxsat);
+        if (NULL != item->minOutput) minsat = *(item->minOutput);
+        if (NULL != item->maxOutput) maxsat = *(item->maxOutput);
+        ikSlti_setOutSat(&(item->tf), sat, minsat, maxsat);
         
         /* run a step */
-        output_ = ikSlti_step(&(self->tfs[i]), output);
+        output_ = ikSlti_step(&(item->tf), output);
         
         /* if enabled, pick up output */
-        if (NULL != self->varEnable[i]) self->enable[i] = *(self->varEnable[i]);
-        if (self->enable[i]) output = output_;
+        if (NULL != item->varEnable) item->enable = *(item->varEnable);
+        if (item->enable) output = output_;
     }
     
     /* return output */
@@ -146,15 +190,102 @@ double ikTfList_step(ikTfList *self, double input) {
 }
 
 double ikTfList_getOutput(const ikTfList *self, int index) {
+    ikTfListN list = ikTfList_view(self);
+    
+    return ikTfListN_getOutput(&list, index);
+}
+
+double ikTfListN_getOutput(const ikTfListN *self, int index) {
     /* saturate index */
     int index_ = index;
+    if (0 == self->n) return 0.0;
     if (0 > index_) index_ = 0;
-    if (IKTFLIST_NMAX - 1 < index_) index_ = IKTFLIST_NMAX - 1;
+    if (self->n - 1 < index_) index_ = self->n - 1;
     
     /* return corresponding output */
-    return ikSlti_getOutput(&(self->tfs[index_]));
+    return ikSlti_getOutput(&(self->items[index_].tf));
 }
 
 
+void ikTfList_getSatCounts(const ikTfList *self, ikSltiSatCounts *counts) {
+    ikTfListN list = ikTfList_view(self);
+    
+    ikTfListN_getSatCounts(&list, counts);
+}
+
+void ikTfListN_getSatCounts(const ikTfListN *self, ikSltiSatCounts *counts) {
+    ikSltiSatCounts counts_;
+    int i;
+#ifdef IKSLTI_NSATHIST
+    int k;
+#endif
+    
+    /* add up the counters of all the transfer functions */
+    counts->inputSaturations = 0;
+    counts->outputSaturations = 0;
+    counts->saturatedSteps = 0;
+#ifdef IKSLTI_NSATHIST
+    for (k = 0; k < IKSLTI_NSATHIST; k++) counts->runs[k] = 0;
+#endif
+    for (i = 0; i < self->n; i++) {
+        ikSlti_getSatCounts(&(self->items[i].tf), &counts_);
+        counts->inputSaturations += counts_.inputSaturations;
+        counts->outputSaturations += counts_.outputSaturations;
+        counts->saturatedSteps += counts_.saturatedSteps;
+#ifdef IKSLTI_NSATHIST
+        for (k = 0; k < IKSLTI_NSATHIST; k++) counts->runs[k] += counts_.runs[k];
+#endif
+    }
+}
+
+
+
+void ikTfList_checkpoint(ikTfList *self, ikCheckpoint *cp) {
+    ikTfListN list = ikTfList_view(self);
+    
+    ikTfListN_checkpoint(&list, cp);
+}
+
+void ikTfListN_checkpoint(ikTfListN *self, ikCheckpoint *cp) {
+    int i;
+    
+    /* repeat for all the transfer functions */
+    ikCheckpoint_check(cp, self->n);
+    for (i = 0; i < self->n; i++) {
+        ikSlti_checkpoint(&(self->items[i].tf), cp);
+        ikCheckpoint_int(cp, &(self->items[i].enable));
+    }
+}
+
+void ikTfList_freqResp(const ikTfList *self, int n, const double w[], double re[], double im[]) {
+    ikTfListN list = ikTfList_view(self);
+    
+    ikTfListN_freqResp(&list, n, w, re, im);
+}
+
+void ikTfListN_freqResp(const ikTfListN *self, int n, const double w[], double re[], double im[]) {
+    double z[4*IKSLTI_FREQBLOCK];
+    int i;
+    int k;
+    int m;
+    int enable;
+
+    /*start from a gain of 1 */
+    for (k = 0; k < n; k++) {
+        re[k] = 1.0;
+        im[k] = 0.0;
+    }
+
+    /*multiply by the response of every enabled transfer function, a block of */
+    /*frequencies at a time, sharing their unit delays */
+    for (k = 0; k < n; k += IKSLTI_FREQBLOCK) {
+        m = (n - k < IKSLTI_FREQBLOCK) ? n - k : IKSLTI_FREQBLOCK;
+        ikSlti_delays(m, w + k, z);
+        for (i = 0; i < self->n; i++) {
+            enable = (NULL != self->items[i].varEnable) ? *(self->items[i].varEnable) : self->items[i].enable;
+            if (enable) ikSlti_mulFreqRespDelays(&(self->items[i].tf), m, z, re + k, im + k);
+        }
+    }
+}
 
 /* @endcond */
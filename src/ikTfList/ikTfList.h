@@ -82,18 +82,76 @@ extern "C" {
         ikTfParams tfParams [IKTFLIST_NMAX];    /**<initialisation parameters for each individual transfer function*/
     } ikTfListParams;
     
+    /**
+     * @struct ikTfListItem
+     * @brief transfer function list storage for one transfer function
+     * 
+     * Arrays of this type are provided to @link ikTfListN_init @endlink
+     * to hold the transfer functions of a list.
+     */
+    typedef struct ikTfListItem {
+        /**
+         * Private members
+         */
+        /* @cond */
+        ikSlti  tf;
+        int     enable;
+        int     *varEnable;
+        double  *maxInput;
+        double  *minInput;
+        double  *maxOutput;
+        double  *minOutput;
+        /* @endcond */
+    } ikTfListItem;
+    
+    /**
+     * @struct ikTfListN
+     * @brief Transfer function list of a given length
+     * 
+     * Instances of this type are lists of transfer functions to be applied in
+     * series to a signal, as @link ikTfList @endlink, but with as many transfer
+     * functions as configured on initialisation, held in an array provided by
+     * the caller, so that only those are stored and run.
+     * 
+     * @par Inputs
+     * @li input: specify via @link ikTfListN_step @endlink
+     * 
+     * @par Outputs
+     * @li output: returned by @link ikTfListN_step @endlink
+     * @li saturation event counters: get via @link ikTfListN_getSatCounts @endlink
+     * 
+     * @par Methods
+     * @li @link ikTfListN_init @endlink initialise an instance
+     * @li @link ikTfListN_step @endlink execute periodic calculations
+     * @li @link ikTfListN_getOutput @endlink get output value
+     * @li @link ikTfListN_getSatCounts @endlink get saturation event counters
+     * @li @link ikTfListN_checkpoint @endlink save or restore runtime state
+     * @li @link ikTfListN_freqResp @endlink get frequency response
+     */
+    typedef struct ikTfListN {
+        /**
+         * Private members
+         */
+        /* @cond */
+        int             n;      /* number of transfer functions */
+        ikTfListItem    *items; /* transfer functions, in the caller's array */
+        /* @endcond */
+    } ikTfListN;
+    
     /**
      * @struct ikTfList
      * @brief Transfer function list
      * 
-     * Instances of this type are lists of transfer functions to be applied in
-     * series to a signal.
+     * Instances of this type are lists of @link IKTFLIST_NMAX @endlink
+     * transfer functions to be applied in series to a signal, held in the
+     * instance itself. For lists of other lengths, see @link ikTfListN @endlink.
      * 
      * @par Inputs
      * @li input: specify via @link ikTfList_step @endlink
      * 
      * @par Outputs
      * @li output: returned by @link ikTfList_step @endlink
+     * @li saturation event counters: get via @link ikTfList_getSatCounts @endlink
      * 
      * @par Unit block
      * 
@@ -107,19 +165,16 @@ extern "C" {
      * @li @link ikTfList_init @endlink initialise an instance
      * @li @link ikTfList_step @endlink execute periodic calculations
      * @li @link ikTfList_getOutput @endlink get output value
+     * @li @link ikTfList_getSatCounts @endlink get saturation event counters
+     * @li @link ikTfList_checkpoint @endlink save or restore runtime state
+     * @li @link ikTfList_freqResp @endlink get frequency response
      */
     typedef struct ikTfList {
         /**
          * Private members
          */
         /* @cond */
-        ikSlti  tfs          [IKTFLIST_NMAX];
-        int     enable       [IKTFLIST_NMAX];
-        int     *varEnable   [IKTFLIST_NMAX];
-        double  *maxInput    [IKTFLIST_NMAX];
-        double  *minInput    [IKTFLIST_NMAX];
-        double  *maxOutput   [IKTFLIST_NMAX];
-        double  *minOutput   [IKTFLIST_NMAX];
+        ikTfListItem    items   [IKTFLIST_NMAX];
         /* @endcond */
     } ikTfList;
 
@@ -133,12 +188,39 @@ extern "C" {
      */
     int ikTfList_init(ikTfList *self, const ikTfListParams *params);
     
+    /**
+     * Initialise instance, with n transfer functions held in a buffer
+     * 
+     * The buffer must persist, and not be used by anything else, for as long as
+     * the instance is used.
+     * 
+     * @param self instance
+     * @param n number of transfer functions
+     * @param params array of n transfer function initialisation parameters,
+     * with the same meaning as the elements of @link ikTfListParams::tfParams @endlink
+     * @param buffer array of n elements to hold the transfer functions
+     * @return error code:
+     * @li 0: no error
+     * @li 1: invalid number of transfer functions, must be positive. The list
+     * is left empty, and passes its input through.
+     * @li -x: could not initialise x-th transfer function (starting at 1)
+     */
+    int ikTfListN_init(ikTfListN *self, int n, const ikTfParams params[], ikTfListItem buffer[]);
+    
     /**
      * Initialise initialisation parameter structure with default values
      * @param params initialisation parameter structure
      */
     void ikTfList_initParams(ikTfListParams *params);
     
+    /**
+     * Initialise transfer function initialisation parameters with default
+     * values, as in @link ikTfList_initParams @endlink
+     * @param params array of n transfer function initialisation parameters
+     * @param n number of transfer functions
+     */
+    void ikTfList_initTfParams(ikTfParams params[], int n);
+    
     /**
      * Execute periodic calculations
      * @param self transfer function list instance
@@ -147,16 +229,88 @@ extern "C" {
      */
     double ikTfList_step(ikTfList *self, double input);
     
+    /**
+     * Execute periodic calculations, as in @link ikTfList_step @endlink
+     * @param self instance
+     * @param input new input value
+     * @return new output value
+     */
+    double ikTfListN_step(ikTfListN *self, double input);
+    
     /**
      * Get output value
      * @param self transfer function list instance
      * @param index index of the transfer function whose output is to be returned,
      * with 0 for the last to be applied, 1 for the last but one to be applied,
-     * and so on. Values below 0 and above @link IKTFLIST_NMAX @endlink - 1 are valid
-     * and equivalent to 0 and @link IKTFLIST_NMAX @endlink - 1, respectively.
-     * @return output value
+     * and so on. Values below 0 and above the number of transfer functions - 1 are valid
+     * and equivalent to 0 and the number of transfer functions - 1, respectively.
+     * @return output value, or 0 if the list is empty
      */
     double ikTfList_getOutput(const ikTfList *self, int index);
+    
+    /**
+     * Get output value, as in @link ikTfList_getOutput @endlink
+     * @param self instance
+     * @param index index of the transfer function whose output is to be
+     * returned, with 0 for the last to be applied, saturated to the length of
+     * the list
+     * @return output value, or 0 if the list is empty
+     */
+    double ikTfListN_getOutput(const ikTfListN *self, int index);
+    
+    /**
+     * Get saturation event counters, added up over all the transfer
+     * functions, as in @link ikSlti_getSatCounts @endlink. Transfer functions
+     * which are disabled, but run, are counted too.
+     * @param self transfer function list instance
+     * @param counts saturation event counters
+     */
+    void ikTfList_getSatCounts(const ikTfList *self, ikSltiSatCounts *counts);
+    
+    /**
+     * Get saturation event counters, as in @link ikTfList_getSatCounts @endlink
+     * @param self instance
+     * @param counts saturation event counters
+     */
+    void ikTfListN_getSatCounts(const ikTfListN *self, ikSltiSatCounts *counts);
+
+    /**
+     * Save or restore runtime state, i.e. that of all the transfer functions,
+     * as in @link ikSlti_checkpoint @endlink, and the enable flags
+     * @param self instance
+     * @param cp checkpoint blob writer or reader
+     */
+    void ikTfList_checkpoint(ikTfList *self, ikCheckpoint *cp);
+    
+    /**
+     * Save or restore runtime state, as in @link ikTfList_checkpoint @endlink
+     * @param self instance
+     * @param cp checkpoint blob writer or reader
+     */
+    void ikTfListN_checkpoint(ikTfListN *self, ikCheckpoint *cp);
+
+    /**
+     * Get frequency response of the list, i.e. the product of those of the
+     * enabled transfer functions, as in @link ikSlti_freqResp @endlink,
+     * with the current enable flags
+     * @param self instance
+     * @param n number of frequencies
+     * @param w array of n normalised angular frequencies, in rad per sample,
+     * i.e. angular frequencies in rad/s times the sampling time
+     * @param re array for the real parts of the response, one per frequency
+     * @param im array for the imaginary parts of the response, one per frequency
+     */
+    void ikTfList_freqResp(const ikTfList *self, int n, const double w[], double re[], double im[]);
+    
+    /**
+     * Get frequency response of the list, as in @link ikTfList_freqResp @endlink
+     * @param self instance
+     * @param n number of frequencies
+     * @param w array of n normalised angular frequencies, in rad per sample
+     * @param re array for the real parts of the response, one per frequency
+     * @param im array for the imaginary parts of the response, one per frequency
+     */
+    void ikTfListN_freqResp(const ikTfListN *self, int n, const double w[], double re[], double im[]);
 
 #ifdef __cplusplus
 }
@@ -229,6 +229,127 @@ void testBadSaturation() {
     
 }
 
+/**
+ * The frequency response is the product of those of the enabled transfer
+ * functions
+ */
+void testFreqResp() {
+    printf("ikTfList_test testFreqResp\n");
+    ikTfList list;
+    ikTfListParams params;
+    ikSlti tf;
+    double w[4] = {0.0, 0.1, 1.0, 3.0};
+    double re[4];
+    double im[4];
+    double expectedRe[4] = {1.0, 1.0, 1.0, 1.0};
+    double expectedIm[4] = {0.0, 0.0, 0.0, 0.0};
+    int k;
+
+    ikTfList_initParams(&params);
+    params.tfParams[0].enable = 1;
+    params.tfParams[0].a[1] = -0.8;
+    params.tfParams[0].b[0] = 0.2;
+    params.tfParams[1].b[0] = 100.0;
+    params.tfParams[2].enable = 1;
+    params.tfParams[2].b[0] = 2.0;
+    params.tfParams[2].b[1] = -1.0;
+    ikTfList_init(&list, &params);
+    ikTfList_freqResp(&list, 4, w, re, im);
+
+    ikSlti_init(&tf);
+    ikSlti_setParam(&tf, params.tfParams[0].a, params.tfParams[0].b);
+    ikSlti_mulFreqResp(&tf, 4, w, expectedRe, expectedIm);
+    ikSlti_setParam(&tf, params.tfParams[2].a, params.tfParams[2].b);
+    ikSlti_mulFreqResp(&tf, 4, w, expectedRe, expectedIm);
+    for (k = 0; k < 4; k++) {
+        if ((fabs(expectedRe[k] - re[k]) > 1e-12) || (fabs(expectedIm[k] - im[k]) > 1e-12)) printf("%%TEST_FAILED%% time=0 testname=testFreqResp (ikTfList_test) message=response expected to be %f%+fj, but it is %f%+fj\n", expectedRe[k], expectedIm[k], re[k], im[k]);
+    }
+}
+
+/**
+ * Initialise a list of a given length from a buffer and see that it behaves
+ * like a list of fixed length with the same transfer functions, and that the
+ * right error codes are returned.
+ */
+void testListN() {
+    printf("ikTfList_test testListN\n");
+    int err;
+    int i;
+    int k;
+    double input;
+    double expected;
+    double output;
+    double maxOutput = 0.5;
+    ikTfListN list;
+    ikTfList fixedList;
+    ikTfList copy;
+    ikTfListParams fixedParams;
+    ikTfParams params[3];
+    ikTfListItem buffer[3];
+    ikCheckpoint cp;
+    size_t size;
+    size_t fixedSize;
+    
+    /* a gain, a low pass filter with output saturation and a disabled gain */
+    ikTfList_initTfParams(params, 3);
+    params[0].enable = 1;
+    params[0].b[0] = 2.0;
+    params[1].enable = 1;
+    params[1].a[1] = -0.9;
+    params[1].b[0] = 0.1;
+    params[1].maxOutput = &maxOutput;
+    params[2].b[0] = 10.0;
+    err = ikTfListN_init(&list, 3, params, buffer);
+    if (err) printf("%%TEST_FAILED%% time=0 testname=testListN (ikTfList_test) message=expected error code 0, but got %d\n", err);
+    
+    /* the same in the first 3 positions of a fixed list */
+    ikTfList_initParams(&fixedParams);
+    for (i = 0; i < 3; i++) fixedParams.tfParams[i] = params[i];
+    ikTfList_init(&fixedList, &fixedParams);
+    
+    for (k = 0; k < 100; k++) {
+        input = sin(0.1 * k);
+        expected = ikTfList_step(&fixedList, input);
+        output = ikTfListN_step(&list, input);
+        if (expected != output) {
+            printf("%%TEST_FAILED%% time=0 testname=testListN (ikTfList_test) message=output expected to be %f at step %d, but it is %f\n", expected, k, output);
+            break;
+        }
+    }
+    for (i = 0; i < 3; i++) {
+        if (ikTfList_getOutput(&fixedList, i) != ikTfListN_getOutput(&list, i)) printf("%%TEST_FAILED%% time=0 testname=testListN (ikTfList_test) message=output of transfer function %d not as in a fixed list\n", i);
+    }
+    if (ikTfListN_getOutput(&list, 2) != ikTfListN_getOutput(&list, 3)) printf("%%TEST_FAILED%% time=0 testname=testListN (ikTfList_test) message=expected getOutput to return the same with indices 2 and 3, but it did not\n");
+    
+    /* a copy of the fixed list carries on on its own */
+    copy = fixedList;
+    for (k = 0; k < 10; k++) {
+        expected = ikTfList_step(&fixedList, 1.0);
+        output = ikTfList_step(&copy, 1.0);
+        if (expected != output) printf("%%TEST_FAILED%% time=0 testname=testListN (ikTfList_test) message=output of a copy expected to be %f at step %d, but it is %f\n", expected, k, output);
+    }
+    
+    /* see that the checkpoint only holds the transfer functions in the buffer */
+    ikCheckpoint_initSave(&cp, NULL, 0, "ikTfList");
+    ikTfList_checkpoint(&fixedList, &cp);
+    ikCheckpoint_finish(&cp, &fixedSize);
+    ikCheckpoint_initSave(&cp, NULL, 0, "ikTfList");
+    ikTfListN_checkpoint(&list, &cp);
+    ikCheckpoint_finish(&cp, &size);
+    if (size >= fixedSize) printf("%%TEST_FAILED%% time=0 testname=testListN (ikTfList_test) message=expected a checkpoint smaller than %d bytes, but it is %d bytes\n", (int) fixedSize, (int) size);
+    
+    /* invalid parameters in the second transfer function */
+    params[1].a[0] = 0.0;
+    err = ikTfListN_init(&list, 3, params, buffer);
+    if (-2 != err) printf("%%TEST_FAILED%% time=0 testname=testListN (ikTfList_test) message=expected error code -2, but got %d\n", err);
+    
+    /* invalid length, leaving the list empty */
+    err = ikTfListN_init(&list, 0, params, buffer);
+    if (1 != err) printf("%%TEST_FAILED%% time=0 testname=testListN (ikTfList_test) message=expected error code 1, but got %d\n", err);
+    output = ikTfListN_step(&list, 3.0);
+    if (3.0 != output) printf("%%TEST_FAILED%% time=0 testname=testListN (ikTfList_test) message=expected an empty list to output 3.0, but got %f\n", output);
+}
+
 int main(int argc, char** argv) {
     printf("%%SUITE_STARTING%% ikTfList_test\n");
     printf("%%SUITE_STARTED%%\n");
@@ -245,6 +366,14 @@ int main(int argc, char** argv) {
     testBadSaturation();
     printf("%%TEST_FINISHED%% time=0 testBadSaturation (ikTfList_test) \n");
 
+    printf("%%TEST_STARTED%% testFreqResp (ikTfList_test)\n");
+    testFreqResp();
+    printf("%%TEST_FINISHED%% time=0 testFreqResp (ikTfList_test) \n");
+
+    printf("%%TEST_STARTED%% testListN (ikTfList_test)\n");
+    testListN();
+    printf("%%TEST_FINISHED%% time=0 testListN (ikTfList_test) \n");
+
     printf("%%SUITE_FINISHED%% time=0\n");
 
     return (EXIT_SUCCESS);
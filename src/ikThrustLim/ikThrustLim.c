@@ -85,6 +85,14 @@ int ikThrustLim_getOutput(const ikThrustLim *self, double *output, const char *n
     return -1;
 }
 
+void ikThrustLim_checkpoint(ikThrustLim *self, ikCheckpoint *cp) {
+    ikCheckpoint_double(cp, &(self->rotorSpeed));
+    ikCheckpoint_double(cp, &(self->maximumThrust));
+    ikCheckpoint_double(cp, &(self->tipSpeedRatio));
+    ikCheckpoint_double(cp, &(self->ctlambda2));
+    ikCheckpoint_double(cp, &(self->minimumPitch));
+}
+
 void ikThrustLim_delete(ikThrustLim *self) {
     ikSurf_delete(self->surfCtlambda2);
 }
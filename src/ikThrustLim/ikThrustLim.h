@@ -31,6 +31,7 @@ extern "C" {
 #endif
 
 #include "ikSurf.h"
+#include "ikCheckpoint.h"
 
     /**
      * @struct ikThrustLim
@@ -59,6 +60,7 @@ extern "C" {
      * @par Methods
      * @li @link ikThrustLim_new @endlink construct new instance
      * @li @link ikThrustLim_eval @endlink evaluate minimum pitch
+     * @li @link ikThrustLim_checkpoint @endlink save or restore runtime state
      * @li @link ikThrustLim_delete @endlink delete instance
      */
     typedef struct ikThrustLim {
@@ -125,6 +127,14 @@ extern "C" {
      * @li -1: invalid signal name
      */
     int ikThrustLim_getOutput(const ikThrustLim *self, double *output, const char *name);
+    
+    /**
+     * Save or restore runtime state, i.e. the latest signal values. The
+     * surface is not included.
+     * @param self thrust limiter instance
+     * @param cp checkpoint blob writer or reader
+     */
+    void ikThrustLim_checkpoint(ikThrustLim *self, ikCheckpoint *cp);
 
     /**
      * Delete instance
@@ -77,6 +77,9 @@ int ikTsrEst_init(ikTsrEst *self, const ikTsrEstParams *params) {
     /*construct cp/lambda^3 surface*/
     errStr = ikSurf_newf(&(self->surfCplambda3), params->cplambda3SurfaceFileName);
     if (strlen(errStr)) return -8;
+#ifdef IKPROFILE
+    ikProfile_init(&(self->profile));
+#endif
 	
     return 0;
 }
@@ -96,6 +99,10 @@ void ikTsrEst_initParams(ikTsrEstParams *params) {
 double ikTsrEst_step(ikTsrEst *self, double generatorSpeed, double generatorTorque, double pitchAngle) {
     double aux;
     double x[2];
+#ifdef IKPROFILE
+    long capped = ikSurf_getCapped(self->surfCplambda3);
+    ikProfile_start(&(self->profile));
+#endif
     
     self->unfilteredRotorSpeed = generatorSpeed / self->b;
     self->pitchAngle = pitchAngle;
@@ -111,6 +118,10 @@ double ikTsrEst_step(ikTsrEst *self, double generatorSpeed, double generatorTorq
     x[0] = self->filteredPitchAngle;
     x[1] = self->cplambda3;
     self->tipSpeedRatio = ikSurf_eval(self->surfCplambda3, 0, x, 1);
+#ifdef IKPROFILE
+    if (ikSurf_getCapped(self->surfCplambda3) > capped) ikProfile_saturate(&(self->profile));
+    ikProfile_stop(&(self->profile));
+#endif
     return self->tipSpeedRatio;
 }
 
@@ -166,6 +177,22 @@ int ikTsrEst_getOutput(const ikTsrEst *self, double *output, const char *name) {
         return 0;
     }
 
+#ifdef IKPROFILE
+    /* pick up the profile counters */
+    if (!strcmp(name, "profile>iterations")) {
+        *output = (double) ikSurf_getIterations(self->surfCplambda3);
+        return 0;
+    }
+    if (!strncmp(name, "profile>", 8)) {
+        if (ikProfile_getOutput(&(self->profile), output, name + 8)) return -1;
+        return 0;
+    }
+    if (!strncmp(name, "Cp/lambda^3 surface>profile>", 28)) {
+        if (ikSurf_getProfile(self->surfCplambda3, output, name + 28)) return -1;
+        return 0;
+    }
+#endif
+
     /* pick up the block names */
     separator = strstr(name, ">");
     if (NULL == separator) return -1;
@@ -227,6 +254,54 @@ int ikTsrEst_getOutput(const ikTsrEst *self, double *output, const char *name) {
     return -2;
 }
 
+int ikTsrEst_saveState(const ikTsrEst *self, void *buffer, size_t size, size_t *length) {
+    ikCheckpoint cp;
+    
+    /* saving leaves the instance as it is */
+    ikCheckpoint_initSave(&cp, buffer, size, "ikTsrEst");
+    ikTsrEst_checkpoint((ikTsrEst *) self, &cp);
+    return ikCheckpoint_finish(&cp, length);
+}
+
+int ikTsrEst_restoreState(ikTsrEst *self, const void *blob, size_t size) {
+    ikCheckpoint cp;
+    int err;
+    
+    /* check the whole blob with a dry run, then restore */
+    err = ikCheckpoint_initRestore(&cp, blob, size, "ikTsrEst", 1);
+    if (err) return err;
+    ikTsrEst_checkpoint(self, &cp);
+    err = ikCheckpoint_finish(&cp, NULL);
+    if (err) return err;
+    ikCheckpoint_initRestore(&cp, blob, size, "ikTsrEst", 0);
+    ikTsrEst_checkpoint(self, &cp);
+    return ikCheckpoint_finish(&cp, NULL);
+}
+
+void ikTsrEst_checkpoint(ikTsrEst *self, ikCheckpoint *cp) {
+    /* filters */
+    ikNotchList_checkpoint(&(self->rotorSpeedNotchFilters), cp);
+    ikNotchList_checkpoint(&(self->generatorTorqueNotchFilters), cp);
+    ikNotchList_checkpoint(&(self->pitchAngleNotchFilters), cp);
+    ikTfList_checkpoint(&(self->rotorSpeedLowPassFilter), cp);
+    ikTfList_checkpoint(&(self->generatorTorqueLowPassFilter), cp);
+    ikTfList_checkpoint(&(self->pitchAngleLowPassFilter), cp);
+    ikTfList_checkpoint(&(self->rotorSpeedDerivation), cp);
+    
+    /* signals */
+    ikCheckpoint_double(cp, &(self->unfilteredRotorSpeed));
+    ikCheckpoint_double(cp, &(self->generatorSpeed));
+    ikCheckpoint_double(cp, &(self->generatorTorque));
+    ikCheckpoint_double(cp, &(self->rotorAcceleration));
+    ikCheckpoint_double(cp, &(self->rotorSpeed));
+    ikCheckpoint_double(cp, &(self->filteredGeneratorTorque));
+    ikCheckpoint_double(cp, &(self->pitchAngle));
+    ikCheckpoint_double(cp, &(self->filteredPitchAngle));
+    ikCheckpoint_double(cp, &(self->aerodynamicTorque));
+    ikCheckpoint_double(cp, &(self->cplambda3));
+    ikCheckpoint_double(cp, &(self->tipSpeedRatio));
+}
+
 void ikTsrEst_delete(ikTsrEst *self) {
     ikSurf_delete(self->surfCplambda3);
 }
@@ -33,6 +33,9 @@ extern "C" {
 #include "ikSurf.h"
 #include "ikNotchList.h"
 #include "ikTfList.h"
+#ifdef IKPROFILE
+#include "ikProfile.h"
+#endif
 
     /**
      * @struct ikTsrEst
@@ -52,6 +55,16 @@ extern "C" {
      * @li tip-speed ratio
      * @li rotor speed in rad/s
      * 
+     * If IKPROFILE is defined at compile time, the steps are counted and
+     * timed, as are the steps in which the search of the Cp/lambda^3 surface
+     * is stopped at IKSURF_MAXITER, as saturations. The counters of
+     * @link ikProfile @endlink are accessible via
+     * @link ikTsrEst_getOutput @endlink as "profile>calls", "profile>cycles",
+     * and so on, along with the search iterations of the surface, as
+     * "profile>iterations". The counters of the surface itself, as in
+     * @link ikSurf_getProfile @endlink, are accessible as
+     * "Cp/lambda^3 surface>profile>cycles", and so on.
+     * 
      * @par Unit block
      * 
      * @image html ikTsrEst_unit_block.svg
@@ -65,6 +78,9 @@ extern "C" {
      * @li @link ikTsrEst_init @endlink initialise an instance
      * @li @link ikTsrEst_step @endlink execute periodic calculations
      * @li @link ikTsrEst_getOutput @endlink get output value
+     * @li @link ikTsrEst_saveState @endlink save runtime state to a checkpoint blob
+     * @li @link ikTsrEst_restoreState @endlink restore runtime state from a checkpoint blob
+     * @li @link ikTsrEst_checkpoint @endlink save or restore runtime state
      * @li @link ikTsrEst_delete @endlink delete instance
      */
     typedef struct ikTsrEst {
@@ -95,6 +111,9 @@ extern "C" {
 	ikTfList generatorTorqueLowPassFilter;
 	ikTfList pitchAngleLowPassFilter;
 	ikTfList rotorSpeedDerivation;
+#ifdef IKPROFILE
+	ikProfile profile;
+#endif
         /* @endcond */
     } ikTsrEst;
     
@@ -165,6 +184,48 @@ extern "C" {
      */
     int ikTsrEst_getOutput(const ikTsrEst *self, double *output, const char *name);
 
+    /**
+     * Save runtime state to a checkpoint blob, as described in
+     * @link ikCheckpoint @endlink. The blob can be restored, via
+     * @link ikTsrEst_restoreState @endlink, into this or any other instance
+     * initialised with the same parameters.
+     * @param self tip-speed ratio estimator instance
+     * @param buffer buffer for the blob, or NULL to find out its length
+     * @param size size of the buffer, in bytes
+     * @param length length of the blob, in bytes, or, if the buffer is too
+     * small, the size needed
+     * @return error code:
+     * @li 0: no error
+     * @li -1: the buffer is too small
+     */
+    int ikTsrEst_saveState(const ikTsrEst *self, void *buffer, size_t size, size_t *length);
+
+    /**
+     * Restore runtime state from a checkpoint blob written by
+     * @link ikTsrEst_saveState @endlink. The blob is checked before anything
+     * is restored, so that the instance is left as it was on error.
+     * @param self tip-speed ratio estimator instance
+     * @param blob blob
+     * @param size size of the blob, in bytes
+     * @return error code:
+     * @li 0: no error
+     * @li -1: the blob is shorter than its header says
+     * @li -2: not a checkpoint blob, or one of another byte order
+     * @li -3: unsupported format version
+     * @li -4: checkpoint blob of another class
+     * @li -5: corrupt payload
+     * @li -6: the blob does not match the configuration of the instance
+     */
+    int ikTsrEst_restoreState(ikTsrEst *self, const void *blob, size_t size);
+
+    /**
+     * Save or restore runtime state, i.e. that of the notch and low pass filters and of the derivation, and the latest signal values. The surface is not included.
+     * Profiling counters are not included.
+     * @param self tip-speed ratio estimator instance
+     * @param cp checkpoint blob writer or reader
+     */
+    void ikTsrEst_checkpoint(ikTsrEst *self, ikCheckpoint *cp);
+
     /**
      * Delete instance
      * @param self tip-speed ratio estimator instance
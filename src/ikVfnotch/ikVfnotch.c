@@ -176,4 +176,27 @@ double ikVfnotch_getOutput(const ikVfnotch *self) {
     return ikSlti_getOutput(&(self->filter));
 }
 
+void ikVfnotch_checkpoint(ikVfnotch *self, ikCheckpoint *cp) {
+    /*re-discretise for the restored frequency, then restore the buffers */
+    double freq = self->freq;
+    ikCheckpoint_double(cp, &freq);
+    if (ikCheckpoint_isRestoring(cp) && (freq != self->freq)) ikVfnotch_setFreq(self, freq);
+    ikSlti_checkpoint(&(self->filter), cp);
+}
+
+void ikVfnotch_freqResp(const ikVfnotch *self, int n, const double w[], double re[], double im[]) {
+    /*invoke filter's freqResp method */
+    ikSlti_freqResp(&(self->filter), n, w, re, im);
+}
+
+void ikVfnotch_mulFreqResp(const ikVfnotch *self, int n, const double w[], double re[], double im[]) {
+    /*invoke filter's mulFreqResp method */
+    ikSlti_mulFreqResp(&(self->filter), n, w, re, im);
+}
+
+void ikVfnotch_mulFreqRespDelays(const ikVfnotch *self, int n, const double z[], double re[], double im[]) {
+    /*invoke filter's mulFreqRespDelays method */
+    ikSlti_mulFreqRespDelays(&(self->filter), n, z, re, im);
+}
+
 /* @endcond */
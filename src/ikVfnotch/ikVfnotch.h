@@ -63,6 +63,10 @@ extern "C" {
      * @li @link ikVfnotch_getDamp @endlink
      * @li @link ikVfnotch_step @endlink
      * @li @link ikVfnotch_getOutput @endlink
+     * @li @link ikVfnotch_checkpoint @endlink
+     * @li @link ikVfnotch_freqResp @endlink
+     * @li @link ikVfnotch_mulFreqResp @endlink
+     * @li @link ikVfnotch_mulFreqRespDelays @endlink
      */
     typedef struct ikVfnotch {
         /**
@@ -181,6 +185,50 @@ extern "C" {
      * @return output value
      */
     double ikVfnotch_getOutput(const ikVfnotch *self);
+    
+    /**
+     * Save or restore runtime state, i.e. the frequency, which may vary, and
+     * the state of the filter, as in @link ikSlti_checkpoint @endlink
+     * @param self instance
+     * @param cp checkpoint blob writer or reader
+     */
+    void ikVfnotch_checkpoint(ikVfnotch *self, ikCheckpoint *cp);
+
+    /**
+     * Get frequency response, at the current frequency, as in
+     * @link ikSlti_freqResp @endlink. The normalised angular frequencies
+     * are in rad per sample, i.e. angular frequencies in rad/s times the
+     * sampling time.
+     * @param self instance
+     * @param n number of frequencies
+     * @param w array of n normalised angular frequencies [rad]
+     * @param re array for the real parts of the response, one per frequency
+     * @param im array for the imaginary parts of the response, one per frequency
+     */
+    void ikVfnotch_freqResp(const ikVfnotch *self, int n, const double w[], double re[], double im[]);
+    
+    /**
+     * Multiply by frequency response, at the current frequency, as in
+     * @link ikSlti_mulFreqResp @endlink
+     * @param self instance
+     * @param n number of frequencies
+     * @param w array of n normalised angular frequencies [rad]
+     * @param re array with the real parts of the values to multiply, one per frequency
+     * @param im array with the imaginary parts of the values to multiply, one per frequency
+     */
+    void ikVfnotch_mulFreqResp(const ikVfnotch *self, int n, const double w[], double re[], double im[]);
+    
+    /**
+     * Multiply by frequency response, at the current frequency, as in
+     * @link ikSlti_mulFreqRespDelays @endlink
+     * @param self instance
+     * @param n number of frequencies
+     * @param z array of 4n values, the unit delays at each frequency, as
+     * obtained from @link ikSlti_delays @endlink
+     * @param re array with the real parts of the values to multiply, one per frequency
+     * @param im array with the imaginary parts of the values to multiply, one per frequency
+     */
+    void ikVfnotch_mulFreqRespDelays(const ikVfnotch *self, int n, const double z[], double re[], double im[]);
 
 
 #ifdef __cplusplus
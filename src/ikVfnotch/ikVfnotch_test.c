@@ -307,6 +307,30 @@ void testSetFrequencyErrors() {
     
 }
 
+/**
+ * The frequency response has a zero at the notch frequency, as warped by
+ * Tustin's approximation, and a static gain of 1
+ */
+void testFreqResp() {
+    printf("ikVfnotch_test testFreqResp\n");
+    ikVfnotch notch;
+    double w[2];
+    double re[2];
+    double im[2];
+
+    ikVfnotch_init(&notch, 0.01, 20.0, 0.1, 0.0);
+    w[0] = 0.0;
+    w[1] = 2.0 * atan(20.0 * 0.01 / 2.0);
+    ikVfnotch_freqResp(&notch, 2, w, re, im);
+    if ((fabs(1.0 - re[0]) > 1e-12) || (fabs(im[0]) > 1e-12)) printf("%%TEST_FAILED%% time=0 testname=testFreqResp (ikVfnotch_test) message=static gain expected to be 1, but it is %f%+fj\n", re[0], im[0]);
+    if (hypot(re[1], im[1]) > 1e-12) printf("%%TEST_FAILED%% time=0 testname=testFreqResp (ikVfnotch_test) message=gain at the notch frequency expected to be 0, but it is %f%+fj\n", re[1], im[1]);
+
+    /* the response follows frequency changes */
+    ikVfnotch_setFreq(&notch, 10.0);
+    ikVfnotch_freqResp(&notch, 2, w, re, im);
+    if (hypot(re[1], im[1]) < 0.5) printf("%%TEST_FAILED%% time=0 testname=testFreqResp (ikVfnotch_test) message=gain at the old notch frequency expected to be near 1, but it is %f%+fj\n", re[1], im[1]);
+}
+
 int main(int argc, char** argv) {
     printf("%%SUITE_STARTING%% ikVfnotch_test\n");
     printf("%%SUITE_STARTED%%\n");
@@ -339,6 +363,10 @@ int main(int argc, char** argv) {
     testSetFrequencyErrors();
     printf("%%TEST_FINISHED%% time=0 setFrequency_errors (ikVfnotch_test) \n");
 
+    printf("%%TEST_STARTED%% frequency_response (ikVfnotch_test)\n");
+    testFreqResp();
+    printf("%%TEST_FINISHED%% time=0 frequency_response (ikVfnotch_test) \n");
+
     printf("%%SUITE_FINISHED%% time=0\n");
 
     return (EXIT_SUCCESS);